@@ -215,6 +215,7 @@ bool Config::Reload(std::filesystem::path iniPath)
             LogSingleFile.set_from_config(readBool("Log", "SingleFile"));
             LogAsync.set_from_config(readBool("Log", "LogAsync"));
             LogAsyncThreads.set_from_config(readInt("Log", "LogAsyncThreads"));
+            LogStartupTrace.set_from_config(readBool("Log", "StartupTrace"));
 
             {
                 auto setting = readString("Log", "LogFile", false);
@@ -284,6 +285,9 @@ bool Config::Reload(std::filesystem::path iniPath)
             if (auto setting = readFloat("Menu", "FpsScale"); setting.has_value())
                 FpsScale.set_from_config(std::clamp(setting.value(), 0.5f, 2.0f));
 
+            if (auto setting = readInt("Menu", "FpsOverlayRefreshRate"); setting.has_value())
+                FpsOverlayRefreshRate.set_from_config(std::clamp(setting.value(), 0, 240));
+
             TTFFontPath.set_from_config(readWString("Menu", "TTFFontPath"));
         }
 
@@ -323,6 +327,7 @@ bool Config::Reload(std::filesystem::path iniPath)
             OutputScalingEnabled.set_from_config(readBool("OutputScaling", "Enabled"));
             OutputScalingUseFsr.set_from_config(readBool("OutputScaling", "UseFsr"));
             OutputScalingDownscaler.set_from_config(readInt("OutputScaling", "Downscaler"));
+            OutputScalingFused.set_from_config(readBool("OutputScaling", "Fused"));
 
             if (auto setting = readFloat("OutputScaling", "Multiplier"); setting.has_value())
                 OutputScalingMultiplier.set_from_config(std::clamp(setting.value(), 0.5f, 3.0f));
@@ -397,6 +402,7 @@ bool Config::Reload(std::filesystem::path iniPath)
             PreferFirstDedicatedGpu.set_from_config(readBool("Hotfix", "PreferFirstDedicatedGpu"));
             SkipFirstFrames.set_from_config(readInt("Hotfix", "SkipFirstFrames"));
             UsePrecompiledShaders.set_from_config(readBool("Hotfix", "UsePrecompiledShaders"));
+            UseShaderCache.set_from_config(readBool("Hotfix", "UseShaderCache"));
             ColorResourceBarrier.set_from_config(readInt("Hotfix", "ColorResourceBarrier"));
             MVResourceBarrier.set_from_config(readInt("Hotfix", "MotionVectorResourceBarrier"));
             DepthResourceBarrier.set_from_config(readInt("Hotfix", "DepthResourceBarrier"));
@@ -711,6 +717,7 @@ bool Config::SaveIni()
         ini.SetValue("OutputScaling", "UseFsr",
                      GetBoolValue(Instance()->OutputScalingUseFsr.value_for_config()).c_str());
         ini.SetValue("OutputScaling", "Downscaler", GetIntValue(Instance()->OutputScalingDownscaler).c_str());
+        ini.SetValue("OutputScaling", "Fused", GetBoolValue(Instance()->OutputScalingFused.value_for_config()).c_str());
     }
 
     // FSR common
@@ -829,6 +836,8 @@ bool Config::SaveIni()
                      GetBoolValue(Instance()->FpsOverlayHorizontal.value_for_config()).c_str());
         ini.SetValue("Menu", "FpsOverlayAlpha", GetFloatValue(Instance()->FpsOverlayAlpha.value_for_config()).c_str());
         ini.SetValue("Menu", "FpsScale", GetFloatValue(Instance()->FpsScale.value_for_config()).c_str());
+        ini.SetValue("Menu", "FpsOverlayRefreshRate",
+                     GetIntValue(Instance()->FpsOverlayRefreshRate.value_for_config()).c_str());
         ini.SetValue("Menu", "TTFFontPath",
                      wstring_to_string(Instance()->TTFFontPath.value_for_config_or(L"auto")).c_str());
     }
@@ -931,6 +940,7 @@ bool Config::SaveIni()
 
         ini.SetValue("Hotfix", "UsePrecompiledShaders",
                      GetBoolValue(Instance()->UsePrecompiledShaders.value_for_config()).c_str());
+        ini.SetValue("Hotfix", "UseShaderCache", GetBoolValue(Instance()->UseShaderCache.value_for_config()).c_str());
         ini.SetValue("Hotfix", "PreferDedicatedGpu",
                      GetBoolValue(Instance()->PreferDedicatedGpu.value_for_config()).c_str());
         ini.SetValue("Hotfix", "PreferFirstDedicatedGpu",
@@ -973,6 +983,7 @@ bool Config::SaveIni()
         ini.SetValue("Log", "SingleFile", GetBoolValue(Instance()->LogSingleFile.value_for_config()).c_str());
         ini.SetValue("Log", "LogAsync", GetBoolValue(Instance()->LogAsync.value_for_config()).c_str());
         ini.SetValue("Log", "LogAsyncThreads", GetIntValue(Instance()->LogAsyncThreads.value_for_config()).c_str());
+        ini.SetValue("Log", "StartupTrace", GetBoolValue(Instance()->LogStartupTrace.value_for_config()).c_str());
     }
 
     // NvApi
@@ -1,149 +1,12 @@
 #pragma once
 #include "pch.h"
 #include "State.h"
+#include "CustomOptional.h"
+#include <atomic>
 #include <optional>
 #include <filesystem>
 #include <SimpleIni.h>
 
-enum HasDefaultValue
-{
-    WithDefault,
-    NoDefault,
-    SoftDefault // Change always gets saved to the config
-};
-
-template <class T, HasDefaultValue defaultState = WithDefault> class CustomOptional : public std::optional<T>
-{
-  private:
-    T _defaultValue;
-    std::optional<T> _configIni;
-    bool _volatile;
-
-  public:
-    CustomOptional(T defaultValue)
-        requires(defaultState != NoDefault)
-        : std::optional<T>(), _defaultValue(std::move(defaultValue)), _configIni(std::nullopt), _volatile(false)
-    {
-    }
-
-    CustomOptional()
-        requires(defaultState == NoDefault)
-        : std::optional<T>(), _defaultValue(T {}), _configIni(std::nullopt), _volatile(false)
-    {
-    }
-
-    // Prevents a change from being saved to ini
-    constexpr void set_volatile_value(const T& value)
-    {
-        if (!_volatile)
-        { // make sure the previously set value is saved
-            if (this->has_value())
-                _configIni = this->value();
-            else
-                _configIni = std::nullopt;
-        }
-        _volatile = true;
-        std::optional<T>::operator=(value);
-    }
-
-    // Use this when first setting a CustomOptional
-    constexpr void set_from_config(const std::optional<T>& opt)
-    {
-        if (!this->has_value())
-        {
-            _configIni = opt;
-            std::optional<T>::operator=(opt);
-        }
-    }
-
-    constexpr CustomOptional& operator=(const T& value)
-    {
-        _volatile = false;
-        std::optional<T>::operator=(value);
-        return *this;
-    }
-
-    constexpr CustomOptional& operator=(T&& value)
-    {
-        _volatile = false;
-        std::optional<T>::operator=(std::move(value));
-        return *this;
-    }
-
-    constexpr CustomOptional& operator=(const std::optional<T>& opt)
-    {
-        _volatile = false;
-        std::optional<T>::operator=(opt);
-        return *this;
-    }
-
-    constexpr CustomOptional& operator=(std::optional<T>&& opt)
-    {
-        _volatile = false;
-        std::optional<T>::operator=(std::move(opt));
-        return *this;
-    }
-
-    // Needed for string literals for some reason
-    constexpr CustomOptional& operator=(const char* value)
-        requires std::same_as<T, std::string>
-    {
-        _volatile = false;
-        std::optional<T>::operator=(T(value));
-        return *this;
-    }
-
-    constexpr T value_or_default() const&
-        requires(defaultState != NoDefault)
-    {
-        return this->has_value() ? this->value() : _defaultValue;
-    }
-
-    constexpr T value_or_default() &&
-        requires(defaultState != NoDefault) {
-            return this->has_value() ? std::move(this->value()) : std::move(_defaultValue);
-        }
-
-        constexpr std::optional<T> value_for_config()
-            requires(defaultState == WithDefault)
-    {
-        if (_volatile)
-        {
-            if (_configIni != _defaultValue)
-                return _configIni;
-
-            return std::nullopt;
-        }
-
-        if (!this->has_value() || *this == _defaultValue)
-            return std::nullopt;
-
-        return this->value();
-    }
-
-    constexpr std::optional<T> value_for_config()
-        requires(defaultState != WithDefault)
-    {
-        if (_volatile)
-            return _configIni;
-
-        if (this->has_value())
-            return this->value();
-
-        return std::nullopt;
-    }
-
-    constexpr T value_for_config_or(T other)
-    {
-        auto option = value_for_config();
-
-        if (option.has_value())
-            return option.value();
-        else
-            return other;
-    }
-};
-
 constexpr int UnboundKey = -1;
 
 class Config
@@ -171,6 +34,7 @@ class Config
     CustomOptional<bool> LogSingleFile { true };
     CustomOptional<bool> LogAsync { false };
     CustomOptional<int> LogAsyncThreads { 4 };
+    CustomOptional<bool> LogStartupTrace { false };
 
     // XeSS
     CustomOptional<bool> BuildPipelines { true };
@@ -230,6 +94,7 @@ class Config
     CustomOptional<bool> FpsOverlayHorizontal { false };
     CustomOptional<float> FpsOverlayAlpha { 0.4f };
     CustomOptional<float, NoDefault> FpsScale; // No value means same as MenuScale
+    CustomOptional<int> FpsOverlayRefreshRate { 10 }; // Rebuilds per second, 0 rebuilds on every present
     CustomOptional<bool> UseHQFont { true };
     CustomOptional<bool> DisableSplash { false };
     CustomOptional<std::wstring, NoDefault> TTFFontPath;
@@ -270,6 +135,7 @@ class Config
     CustomOptional<int, NoDefault> SkipFirstFrames; // disabled by default
 
     CustomOptional<bool> UsePrecompiledShaders { true };
+    CustomOptional<bool> UseShaderCache { true };
 
     CustomOptional<bool> UseGenericAppIdWithDlss { false };
     CustomOptional<bool> PreferDedicatedGpu { false };
@@ -292,6 +158,7 @@ class Config
     CustomOptional<float> OutputScalingMultiplier { 1.5f };
     CustomOptional<bool> OutputScalingUseFsr { true };
     CustomOptional<uint32_t> OutputScalingDownscaler { 0 }; // 0 = Bicubic | 1 = Lanczos | 2 = Catmull-Rom | 3 = MAGC
+    CustomOptional<bool> OutputScalingFused { true };
 
     // FSR
     CustomOptional<bool> FsrDebugView { false };
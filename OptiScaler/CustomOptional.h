@@ -0,0 +1,179 @@
+#pragma once
+
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+
+enum HasDefaultValue
+{
+    WithDefault,
+    NoDefault,
+    SoftDefault // Change always gets saved to the config
+};
+
+// Incremented on every change of a config value, used by FrameConfig to detect changes
+class ConfigVersion
+{
+  public:
+    static uint32_t Get() { return _version.load(std::memory_order_acquire); }
+    static void Bump() { _version.fetch_add(1, std::memory_order_release); }
+
+  private:
+    inline static std::atomic<uint32_t> _version { 1 };
+};
+
+template <class T, HasDefaultValue defaultState = WithDefault> class CustomOptional : public std::optional<T>
+{
+  private:
+    T _defaultValue;
+    std::optional<T> _configIni;
+    bool _volatile;
+
+    // Writing the value it already has (menu widgets do it every frame) must not rebuild FrameConfig
+    template <typename U> void Store(U&& value)
+    {
+        const std::optional<T>& current = *this;
+        bool changed = !(current == value);
+
+        std::optional<T>::operator=(std::forward<U>(value));
+
+        if (changed)
+            ConfigVersion::Bump();
+    }
+
+  public:
+    CustomOptional(T defaultValue)
+        requires(defaultState != NoDefault)
+        : std::optional<T>(), _defaultValue(std::move(defaultValue)), _configIni(std::nullopt), _volatile(false)
+    {
+    }
+
+    CustomOptional()
+        requires(defaultState == NoDefault)
+        : std::optional<T>(), _defaultValue(T {}), _configIni(std::nullopt), _volatile(false)
+    {
+    }
+
+    // Prevents a change from being saved to ini
+    void set_volatile_value(const T& value)
+    {
+        if (!_volatile)
+        { // make sure the previously set value is saved
+            if (this->has_value())
+                _configIni = this->value();
+            else
+                _configIni = std::nullopt;
+        }
+        _volatile = true;
+        Store(value);
+    }
+
+    // Use this when first setting a CustomOptional
+    void set_from_config(const std::optional<T>& opt)
+    {
+        if (!this->has_value())
+        {
+            _configIni = opt;
+            Store(opt);
+        }
+    }
+
+    CustomOptional& operator=(const T& value)
+    {
+        _volatile = false;
+        Store(value);
+        return *this;
+    }
+
+    CustomOptional& operator=(T&& value)
+    {
+        _volatile = false;
+        Store(std::move(value));
+        return *this;
+    }
+
+    CustomOptional& operator=(const std::optional<T>& opt)
+    {
+        _volatile = false;
+        Store(opt);
+        return *this;
+    }
+
+    CustomOptional& operator=(std::optional<T>&& opt)
+    {
+        _volatile = false;
+        Store(std::move(opt));
+        return *this;
+    }
+
+    void reset() noexcept
+    {
+        if (!this->has_value())
+            return;
+
+        std::optional<T>::reset();
+        ConfigVersion::Bump();
+    }
+
+    // Needed for string literals for some reason
+    CustomOptional& operator=(const char* value)
+        requires std::same_as<T, std::string>
+    {
+        _volatile = false;
+        Store(T(value));
+        return *this;
+    }
+
+    constexpr T value_or_default() const&
+        requires(defaultState != NoDefault)
+    {
+        return this->has_value() ? this->value() : _defaultValue;
+    }
+
+    constexpr T value_or_default() &&
+        requires(defaultState != NoDefault) {
+            return this->has_value() ? std::move(this->value()) : std::move(_defaultValue);
+        }
+
+        constexpr std::optional<T> value_for_config()
+            requires(defaultState == WithDefault)
+    {
+        if (_volatile)
+        {
+            if (_configIni != _defaultValue)
+                return _configIni;
+
+            return std::nullopt;
+        }
+
+        if (!this->has_value() || *this == _defaultValue)
+            return std::nullopt;
+
+        return this->value();
+    }
+
+    constexpr std::optional<T> value_for_config()
+        requires(defaultState != WithDefault)
+    {
+        if (_volatile)
+            return _configIni;
+
+        if (this->has_value())
+            return this->value();
+
+        return std::nullopt;
+    }
+
+    constexpr T value_for_config_or(T other)
+    {
+        auto option = value_for_config();
+
+        if (option.has_value())
+            return option.value();
+        else
+            return other;
+    }
+};
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Names of the dlls we hook or watch for and their compile time classifier, api independent
+
+// Bit per group of dll names, a name can belong to more than one group (overlay & blockOverlay)
+namespace DllCategory
+{
+constexpr uint32_t None = 0;
+constexpr uint32_t Dx11 = 1u << 0;
+constexpr uint32_t Dx12 = 1u << 1;
+constexpr uint32_t Dxgi = 1u << 2;
+constexpr uint32_t Vulkan = 1u << 3;
+constexpr uint32_t Nvngx = 1u << 4;
+constexpr uint32_t NvngxDlss = 1u << 5;
+constexpr uint32_t Nvapi = 1u << 6;
+constexpr uint32_t SlInterposer = 1u << 7;
+constexpr uint32_t SlDlss = 1u << 8;
+constexpr uint32_t SlDlssg = 1u << 9;
+constexpr uint32_t SlReflex = 1u << 10;
+constexpr uint32_t SlCommon = 1u << 11;
+constexpr uint32_t Xess = 1u << 12;
+constexpr uint32_t XessDx11 = 1u << 13;
+constexpr uint32_t Fsr2 = 1u << 14;
+constexpr uint32_t Fsr2BE = 1u << 15;
+constexpr uint32_t Fsr3 = 1u << 16;
+constexpr uint32_t Fsr3BE = 1u << 17;
+constexpr uint32_t FfxDx12 = 1u << 18;
+constexpr uint32_t FfxVk = 1u << 19;
+constexpr uint32_t Overlay = 1u << 20;
+constexpr uint32_t BlockOverlay = 1u << 21;
+} // namespace DllCategory
+
+template <typename CharT>
+inline std::vector<std::basic_string<CharT>> MakeDllNameVector(std::span<const std::string_view> libs)
+{
+    constexpr std::string_view extension = ".dll";
+    std::vector<std::basic_string<CharT>> v;
+
+    for (auto lib : libs)
+    {
+        std::basic_string<CharT> name(lib.begin(), lib.end());
+        v.emplace_back(name).append(extension.begin(), extension.end());
+        v.emplace_back(name);
+    }
+
+    return v;
+}
+
+// Defines varNameLibs (base names without extension) and the varNameNames / varNameNamesW lists
+// which contain every base name with and without .dll
+#define DEFINE_NAME_VECTORS(varName, ...)                                                                              \
+    inline constexpr std::string_view varName##Libs[] = { __VA_ARGS__ };                                              \
+    inline std::vector<std::string> varName##Names = MakeDllNameVector<char>(varName##Libs);                           \
+    inline std::vector<std::wstring> varName##NamesW = MakeDllNameVector<wchar_t>(varName##Libs);
+
+inline std::vector<std::string> dllNames;
+inline std::vector<std::wstring> dllNamesW;
+
+//"rtsshooks64", "rtsshooks",
+
+DEFINE_NAME_VECTORS(overlay, "eosovh-win32-shipping", "eosovh-win64-shipping", // Epic
+                    "gameoverlayrenderer64", "gameoverlayrenderer",            // Steam
+                    "socialclubd3d12renderer",                                 // Rockstar
+                    "owutils",                                                 // Overwolf
+                    "galaxy", "galaxy64",                                      // GOG Galaxy
+                    "discordoverlay", "discordoverlay64",                      // Discord
+                    "overlay64", "overlay");                                   // Ubisoft
+
+DEFINE_NAME_VECTORS(blockOverlay, "eosovh-win32-shipping", "eosovh-win64-shipping", "gameoverlayrenderer64",
+                    "gameoverlayrenderer", "owclient", "galaxy", "galaxy64", "discordoverlay", "discordoverlay64",
+                    "overlay64", "overlay");
+
+DEFINE_NAME_VECTORS(dx11, "d3d11");
+DEFINE_NAME_VECTORS(dx12, "d3d12");
+DEFINE_NAME_VECTORS(dxgi, "dxgi");
+DEFINE_NAME_VECTORS(vk, "vulkan-1");
+
+DEFINE_NAME_VECTORS(nvngx, "nvngx", "_nvngx");
+DEFINE_NAME_VECTORS(nvngxDlss, "nvngx_dlss");
+DEFINE_NAME_VECTORS(nvapi, "nvapi64");
+DEFINE_NAME_VECTORS(slInterposer, "sl.interposer");
+DEFINE_NAME_VECTORS(slDlss, "sl.dlss");
+DEFINE_NAME_VECTORS(slDlssg, "sl.dlss_g");
+DEFINE_NAME_VECTORS(slReflex, "sl.reflex");
+DEFINE_NAME_VECTORS(slCommon, "sl.common");
+
+DEFINE_NAME_VECTORS(xess, "libxess");
+DEFINE_NAME_VECTORS(xessDx11, "libxess_dx11");
+
+DEFINE_NAME_VECTORS(fsr2, "ffx_fsr2_api_x64");
+DEFINE_NAME_VECTORS(fsr2BE, "ffx_fsr2_api_dx12_x64");
+
+DEFINE_NAME_VECTORS(fsr3, "ffx_fsr3upscaler_x64");
+DEFINE_NAME_VECTORS(fsr3BE, "ffx_backend_dx12_x64");
+
+DEFINE_NAME_VECTORS(ffxDx12, "amd_fidelityfx_dx12", "amd_fidelityfx_loader_dx12");
+DEFINE_NAME_VECTORS(ffxVk, "amd_fidelityfx_vk");
+
+// Suffix trie over every name list above, built at compile time.
+// Names are inserted reversed (with and without .dll) so a lookup walks the lowercase library
+// name from its end and collects the categories of every list entry which is a suffix of it.
+// Same result as calling CheckDllName for each list, but a single walk of at most the longest name.
+class DllNameClassifier
+{
+  public:
+    struct NameSet
+    {
+        uint32_t category;
+        std::span<const std::string_view> libs;
+    };
+
+  private:
+    static constexpr size_t MaxNodes = 1024;
+
+    char _char[MaxNodes] {};
+    uint16_t _firstChild[MaxNodes] {};
+    uint16_t _nextSibling[MaxNodes] {};
+    uint32_t _mask[MaxNodes] {};
+    uint16_t _count = 1; // 0 is root, also used as "no node"
+
+    constexpr uint16_t Child(uint16_t node, char c) const
+    {
+        for (auto child = _firstChild[node]; child != 0; child = _nextSibling[child])
+        {
+            if (_char[child] == c)
+                return child;
+        }
+
+        return 0;
+    }
+
+    constexpr void Insert(std::string_view lib, std::string_view extension, uint32_t category)
+    {
+        uint16_t node = 0;
+
+        for (size_t i = lib.size() + extension.size(); i > 0; i--)
+        {
+            auto c = i > lib.size() ? extension[i - 1 - lib.size()] : lib[i - 1];
+            auto child = Child(node, c);
+
+            if (child == 0)
+            {
+                if (_count >= MaxNodes)
+                    throw "DllNameClassifier::MaxNodes is too small";
+
+                child = _count++;
+                _char[child] = c;
+                _nextSibling[child] = _firstChild[node];
+                _firstChild[node] = child;
+            }
+
+            node = child;
+        }
+
+        _mask[node] |= category;
+    }
+
+  public:
+    consteval DllNameClassifier(std::initializer_list<NameSet> sets)
+    {
+        for (auto& set : sets)
+        {
+            for (auto lib : set.libs)
+            {
+                Insert(lib, ".dll", set.category);
+                Insert(lib, "", set.category);
+            }
+        }
+    }
+
+    // lcaseName must be lowercase, returns DllCategory bits
+    template <typename CharT> constexpr uint32_t Classify(std::basic_string_view<CharT> lcaseName) const
+    {
+        uint32_t result = DllCategory::None;
+        uint16_t node = 0;
+
+        for (size_t i = lcaseName.size(); i > 0; i--)
+        {
+            auto c = static_cast<std::make_unsigned_t<CharT>>(lcaseName[i - 1]);
+
+            if (c > 0x7F)
+                break;
+
+            node = Child(node, (char) c);
+
+            if (node == 0)
+                break;
+
+            result |= _mask[node];
+        }
+
+        return result;
+    }
+};
+
+inline constexpr DllNameClassifier dllNameClassifier = {
+    { DllCategory::Dx11, dx11Libs },
+    { DllCategory::Dx12, dx12Libs },
+    { DllCategory::Dxgi, dxgiLibs },
+    { DllCategory::Vulkan, vkLibs },
+    { DllCategory::Nvngx, nvngxLibs },
+    { DllCategory::NvngxDlss, nvngxDlssLibs },
+    { DllCategory::Nvapi, nvapiLibs },
+    { DllCategory::SlInterposer, slInterposerLibs },
+    { DllCategory::SlDlss, slDlssLibs },
+    { DllCategory::SlDlssg, slDlssgLibs },
+    { DllCategory::SlReflex, slReflexLibs },
+    { DllCategory::SlCommon, slCommonLibs },
+    { DllCategory::Xess, xessLibs },
+    { DllCategory::XessDx11, xessDx11Libs },
+    { DllCategory::Fsr2, fsr2Libs },
+    { DllCategory::Fsr2BE, fsr2BELibs },
+    { DllCategory::Fsr3, fsr3Libs },
+    { DllCategory::Fsr3BE, fsr3BELibs },
+    { DllCategory::FfxDx12, ffxDx12Libs },
+    { DllCategory::FfxVk, ffxVkLibs },
+    { DllCategory::Overlay, overlayLibs },
+    { DllCategory::BlockOverlay, blockOverlayLibs },
+};
+
+inline static uint32_t ClassifyDllName(std::string_view lcaseName) { return dllNameClassifier.Classify(lcaseName); }
+inline static uint32_t ClassifyDllName(std::wstring_view lcaseName) { return dllNameClassifier.Classify(lcaseName); }
+
+// Only used for lists filled at runtime (dllNames), everything else goes through ClassifyDllName
+inline static bool CheckDllName(const std::string* dllName, const std::vector<std::string>* namesList)
+{
+    for (auto& name : *namesList)
+    {
+        if (dllName->ends_with(name))
+            return true;
+    }
+
+    return false;
+}
+
+inline static bool CheckDllNameW(const std::wstring* dllName, const std::vector<std::wstring>* namesList)
+{
+    for (auto& name : *namesList)
+    {
+        if (dllName->ends_with(name))
+            return true;
+    }
+
+    return false;
+}
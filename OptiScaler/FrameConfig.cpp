@@ -0,0 +1,44 @@
+#include "FrameConfig.h"
+
+void FrameConfig::Fill(FrameConfig& frameConfig)
+{
+    LOG_TRACE("FrameConfig rebuilt, version: {}", ConfigVersion::Get());
+
+    auto config = Config::Instance();
+
+    frameConfig.DLSSEnabled = config->DLSSEnabled.value_or_default();
+    frameConfig.MakeDepthCopy = config->MakeDepthCopy.value_or_default();
+    frameConfig.RcasEnabled = config->RcasEnabled.value_or_default();
+    frameConfig.MotionSharpnessEnabled = config->MotionSharpnessEnabled.value_or_default();
+    frameConfig.OverrideSharpness = config->OverrideSharpness.value_or_default();
+    frameConfig.OutputScalingEnabled = config->OutputScalingEnabled.value_or_default();
+    frameConfig.RestoreComputeSignature = config->RestoreComputeSignature.value_or_default();
+    frameConfig.RestoreGraphicSignature = config->RestoreGraphicSignature.value_or_default();
+    frameConfig.OverlayMenu = config->OverlayMenu.value_or_default();
+
+    frameConfig.FsrUseFsrInputValues = config->FsrUseFsrInputValues.value_or_default();
+    frameConfig.FsrVerticalFovSet = config->FsrVerticalFov.has_value();
+
+    frameConfig.FGEnabled = config->FGEnabled.value_or_default();
+    frameConfig.FGHUDFix = config->FGHUDFix.value_or_default();
+    frameConfig.FGEnableDepthScale = config->FGEnableDepthScale.value_or_default();
+    frameConfig.FGUseMutexForSwapchain = config->FGUseMutexForSwapchain.value_or_default();
+
+    frameConfig.DlssReactiveMaskBias = config->DlssReactiveMaskBias.value_or_default();
+    frameConfig.MotionSharpness = config->MotionSharpness.value_or_default();
+    frameConfig.Sharpness = config->Sharpness.value_or_default();
+    frameConfig.OutputScalingMultiplier = config->OutputScalingMultiplier.value_or_default();
+    frameConfig.FsrCameraNear = config->FsrCameraNear.value_or_default();
+    frameConfig.FsrCameraFar = config->FsrCameraFar.value_or_default();
+    frameConfig.FsrVerticalFov = config->FsrVerticalFov.value_or_default();
+    frameConfig.FsrHorizontalFov = config->FsrHorizontalFov.value_or_default();
+
+    frameConfig.SkipFirstFrames = config->SkipFirstFrames;
+
+    frameConfig.ColorResourceBarrier = config->ColorResourceBarrier;
+    frameConfig.MVResourceBarrier = config->MVResourceBarrier;
+    frameConfig.DepthResourceBarrier = config->DepthResourceBarrier;
+    frameConfig.ExposureResourceBarrier = config->ExposureResourceBarrier;
+    frameConfig.MaskResourceBarrier = config->MaskResourceBarrier;
+    frameConfig.OutputResourceBarrier = config->OutputResourceBarrier;
+}
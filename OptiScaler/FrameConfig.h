@@ -0,0 +1,62 @@
+#pragma once
+
+#include "pch.h"
+#include "Config.h"
+
+#include <misc/VersionedSnapshot.h>
+
+// Immutable copy of the config values which are read on every evaluate & present.
+// Snapshot is only rebuilt when ConfigVersion changes (menu, ini reload or code changing an option)
+// so hot paths do a version check and plain loads instead of CustomOptional lookups & copies.
+// The returned snapshot stays valid while it's held, even if other threads change the config.
+struct FrameConfig
+{
+    using Snapshot = VersionedSnapshot<FrameConfig>::Snapshot;
+
+    // Upscaler
+    bool DLSSEnabled;
+    bool MakeDepthCopy;
+    bool RcasEnabled;
+    bool MotionSharpnessEnabled;
+    bool OverrideSharpness;
+    bool OutputScalingEnabled;
+    bool RestoreComputeSignature;
+    bool RestoreGraphicSignature;
+    bool OverlayMenu;
+
+    // FSR inputs
+    bool FsrUseFsrInputValues;
+    bool FsrVerticalFovSet;
+
+    // OptiFG
+    bool FGEnabled;
+    bool FGHUDFix;
+    bool FGEnableDepthScale;
+    bool FGUseMutexForSwapchain;
+
+    float DlssReactiveMaskBias;
+    float MotionSharpness;
+    float Sharpness;
+    float OutputScalingMultiplier;
+    float FsrCameraNear;
+    float FsrCameraFar;
+    float FsrVerticalFov;
+    float FsrHorizontalFov;
+
+    std::optional<int> SkipFirstFrames;
+
+    std::optional<int32_t> ColorResourceBarrier;
+    std::optional<int32_t> MVResourceBarrier;
+    std::optional<int32_t> DepthResourceBarrier;
+    std::optional<int32_t> ExposureResourceBarrier;
+    std::optional<int32_t> MaskResourceBarrier;
+    std::optional<int32_t> OutputResourceBarrier;
+
+    // Returns the snapshot of current config values, rebuilds it first if config changed since last call
+    static Snapshot Get() { return _snapshots.Get(ConfigVersion::Get(), Fill); }
+
+  private:
+    inline static VersionedSnapshot<FrameConfig> _snapshots;
+
+    static void Fill(FrameConfig& frameConfig);
+};
@@ -9,6 +9,13 @@
 
 #include "Util.h"
 
+// Records of LOG_DEBUG_DEFERRED are written with the time they were logged at
+static void DeferredLogSink(int level, DeferredLog::Clock::time_point time, std::string_view message)
+{
+    if (auto logger = spdlog::default_logger_raw(); logger != nullptr)
+        logger->log(time, spdlog::source_loc {}, (spdlog::level::level_enum) level, message);
+}
+
 static bool InitializeConsole()
 {
     // Allocate a console for this app
@@ -146,6 +153,8 @@ void PrepareLogger()
             shared_logger->flush_on(spdlog::level::trace);
 
             spdlog::set_default_logger(shared_logger);
+
+            DeferredLog::Start(DeferredLogSink);
         }
     }
     catch (const spdlog::spdlog_ex& ex)
@@ -161,6 +170,7 @@ void PrepareLogger()
 
 void CloseLogger()
 {
+    DeferredLog::Stop();
     spdlog::default_logger()->flush();
     spdlog::shutdown();
 }
@@ -2,6 +2,7 @@
 #include "pch.h"
 #include "Config.h"
 #include "DLSSG_Mod.h"
+#include "NVNGX_ParameterKeys.h"
 
 #include <ankerl/unordered_dense.h>
 
@@ -479,122 +480,120 @@ inline static void InitNGXParameters(NVSDK_NGX_Parameter* InParams)
     }
 }
 
+enum class ParameterType : uint8_t
+{
+    None,
+    Float,
+    Double,
+    Int,
+    UInt,
+    ULongLong,
+    VoidPtr,
+    D3D11Resource,
+    D3D12Resource,
+};
+
 struct Parameter
 {
     template <typename T> void operator=(T value)
     {
-        key = typeid(T).hash_code();
         if constexpr (std::is_same<T, float>::value)
+        {
+            type = ParameterType::Float;
             values.f = value;
+        }
         else if constexpr (std::is_same<T, int>::value)
+        {
+            type = ParameterType::Int;
             values.i = value;
+        }
         else if constexpr (std::is_same<T, unsigned int>::value)
+        {
+            type = ParameterType::UInt;
             values.ui = value;
+        }
         else if constexpr (std::is_same<T, double>::value)
+        {
+            type = ParameterType::Double;
             values.d = value;
+        }
         else if constexpr (std::is_same<T, unsigned long long>::value)
+        {
+            type = ParameterType::ULongLong;
             values.ull = value;
+        }
         else if constexpr (std::is_same<T, void*>::value)
+        {
+            type = ParameterType::VoidPtr;
             values.vp = value;
+        }
         else if constexpr (std::is_same<T, ID3D11Resource*>::value)
+        {
+            type = ParameterType::D3D11Resource;
             values.d11r = value;
+        }
         else if constexpr (std::is_same<T, ID3D12Resource*>::value)
+        {
+            type = ParameterType::D3D12Resource;
             values.d12r = value;
+        }
     }
 
     template <typename T> operator T() const
     {
         T v = {};
-        if constexpr (std::is_same<T, float>::value)
-        {
-            if (key == typeid(unsigned long long).hash_code())
-                v = (T) values.ull;
-            else if (key == typeid(float).hash_code())
-                v = (T) values.f;
-            else if (key == typeid(double).hash_code())
-                v = (T) values.d;
-            else if (key == typeid(unsigned int).hash_code())
-                v = (T) values.ui;
-            else if (key == typeid(int).hash_code())
-                v = (T) values.i;
-        }
-        else if constexpr (std::is_same<T, int>::value)
-        {
-            if (key == typeid(unsigned long long).hash_code())
-                v = (T) values.ull;
-            else if (key == typeid(float).hash_code())
-                v = (T) values.f;
-            else if (key == typeid(double).hash_code())
-                v = (T) values.d;
-            else if (key == typeid(int).hash_code())
-                v = (T) values.i;
-            else if (key == typeid(unsigned int).hash_code())
-                v = (T) values.ui;
-        }
-        else if constexpr (std::is_same<T, unsigned int>::value)
-        {
-            if (key == typeid(unsigned long long).hash_code())
-                v = (T) values.ull;
-            else if (key == typeid(float).hash_code())
-                v = (T) values.f;
-            else if (key == typeid(double).hash_code())
-                v = (T) values.d;
-            else if (key == typeid(int).hash_code())
-                v = (T) values.i;
-            else if (key == typeid(unsigned int).hash_code())
-                v = (T) values.ui;
-        }
-        else if constexpr (std::is_same<T, double>::value)
-        {
-            if (key == typeid(unsigned long long).hash_code())
-                v = (T) values.ull;
-            else if (key == typeid(float).hash_code())
-                v = (T) values.f;
-            else if (key == typeid(double).hash_code())
-                v = (T) values.d;
-            else if (key == typeid(int).hash_code())
-                v = (T) values.i;
-            else if (key == typeid(unsigned int).hash_code())
-                v = (T) values.ui;
-        }
-        else if constexpr (std::is_same<T, unsigned long long>::value)
+        if constexpr (std::is_arithmetic<T>::value)
         {
-            if (key == typeid(unsigned long long).hash_code())
+            switch (type)
+            {
+            case ParameterType::ULongLong:
                 v = (T) values.ull;
-            else if (key == typeid(float).hash_code())
+                break;
+            case ParameterType::Float:
                 v = (T) values.f;
-            else if (key == typeid(double).hash_code())
+                break;
+            case ParameterType::Double:
                 v = (T) values.d;
-            else if (key == typeid(int).hash_code())
+                break;
+            case ParameterType::Int:
                 v = (T) values.i;
-            else if (key == typeid(unsigned int).hash_code())
+                break;
+            case ParameterType::UInt:
                 v = (T) values.ui;
-            else if (key == typeid(void*).hash_code())
-                v = (T) values.vp;
+                break;
+            case ParameterType::VoidPtr:
+                if constexpr (std::is_same<T, unsigned long long>::value)
+                    v = (T) values.vp;
+                break;
+            default:
+                break;
+            }
         }
         else if constexpr (std::is_same<T, void*>::value)
         {
-            if (key == typeid(void*).hash_code())
+            if (type == ParameterType::VoidPtr)
                 v = values.vp;
         }
         else if constexpr (std::is_same<T, ID3D11Resource*>::value)
         {
-            if (key == typeid(ID3D11Resource*).hash_code())
+            if (type == ParameterType::D3D11Resource)
                 v = values.d11r;
-            else if (key == typeid(void*).hash_code())
+            else if (type == ParameterType::VoidPtr)
                 v = (T) values.vp;
         }
         else if constexpr (std::is_same<T, ID3D12Resource*>::value)
         {
-            if (key == typeid(ID3D12Resource*).hash_code())
+            if (type == ParameterType::D3D12Resource)
                 v = values.d12r;
-            else if (key == typeid(void*).hash_code())
+            else if (type == ParameterType::VoidPtr)
                 v = (T) values.vp;
         }
 
         return v;
     }
 
+    bool IsSet() const { return type != ParameterType::None; }
+
     union
     {
         float f;
@@ -605,9 +604,9 @@ struct Parameter
         void* vp;
         ID3D11Resource* d11r;
         ID3D12Resource* d12r;
-    } values;
+    } values {};
 
-    size_t key = 0;
+    ParameterType type = ParameterType::None;
 };
 
 struct NVNGX_Parameters : public NVSDK_NGX_Parameter
@@ -659,6 +658,13 @@ struct NVNGX_Parameters : public NVSDK_NGX_Parameter
         setT(key, value);
     }
 
+    // Known key resolved at compile time, Set<NVSDK_NGX_Parameter_Width>(width) skips the key lookup
+    template <NVNGXParameterKeys::Slot S, typename T> void Set(T value)
+    {
+        LOG_PARAM("known('{0}')", NVNGXParameterKeys::Known[S.index]);
+        setSlot(S.index, value);
+    }
+
     NVSDK_NGX_Result Get(const char* key, unsigned long long* value) const override
     {
         auto result = getT(key, value);
@@ -877,8 +883,14 @@ struct NVNGX_Parameters : public NVSDK_NGX_Parameter
 
     void Reset() override
     {
-        if (!m_values.empty())
-            m_values.clear();
+        {
+            const std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_known.fill({});
+
+            if (!m_values.empty())
+                m_values.clear();
+        }
 
         LOG_DEBUG("Start");
 
@@ -890,6 +902,12 @@ struct NVNGX_Parameters : public NVSDK_NGX_Parameter
     std::vector<std::string> enumerate() const
     {
         std::vector<std::string> keys;
+        for (size_t i = 0; i < m_known.size(); i++)
+        {
+            if (m_known[i].IsSet())
+                keys.push_back(NVNGXParameterKeys::Known[i]);
+        }
+
         for (auto& value : m_values)
         {
             keys.push_back(value.first);
@@ -898,18 +916,61 @@ struct NVNGX_Parameters : public NVSDK_NGX_Parameter
     }
 
   private:
+    // Well known keys live in fixed slots, everything else goes to m_values
+    std::array<Parameter, NVNGXParameterKeys::Count> m_known {};
     ankerl::unordered_dense::map<std::string, Parameter> m_values;
     mutable std::mutex m_mutex;
 
+    // Same overloads as Set, so a value gets the type it would get through the string keyed one
+    void setSlot(int slot, unsigned long long value) { setSlotT(slot, value); }
+    void setSlot(int slot, float value) { setSlotT(slot, value); }
+    void setSlot(int slot, double value) { setSlotT(slot, value); }
+    void setSlot(int slot, unsigned int value) { setSlotT(slot, value); }
+    void setSlot(int slot, int value) { setSlotT(slot, value); }
+    void setSlot(int slot, void* value) { setSlotT(slot, value); }
+    void setSlot(int slot, ID3D11Resource* value) { setSlotT(slot, value); }
+    void setSlot(int slot, ID3D12Resource* value) { setSlotT(slot, value); }
+
+    template <typename T> void setSlotT(int slot, T& value)
+    {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_known[slot] = value;
+    }
+
     template <typename T> void setT(const char* key, T& value)
     {
+        auto slot = NVNGXParameterKeys::Find(key);
+
+        if (slot >= 0)
+        {
+            setSlotT(slot, value);
+            return;
+        }
+
         const std::lock_guard<std::mutex> lock(m_mutex);
         m_values[key] = value;
     }
 
     template <typename T> NVSDK_NGX_Result getT(const char* key, T* value) const
     {
+        auto slot = NVNGXParameterKeys::Find(key);
+
         const std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (slot >= 0)
+        {
+            const Parameter& p = m_known[slot];
+
+            if (!p.IsSet())
+            {
+                LOG_TRACE("('{0}', FAIL)", key);
+                return NVSDK_NGX_Result_Fail;
+            }
+
+            *value = p;
+            return NVSDK_NGX_Result_Success;
+        }
+
         auto k = m_values.find(key);
 
         if (k == m_values.end())
@@ -925,6 +986,33 @@ struct NVNGX_Parameters : public NVSDK_NGX_Parameter
     }
 };
 
+// Per frame inputs of the translators. Their parameters can come from the NGX runtime too, known keys
+// only go straight to their slot when the parameters are OptiScaler's own.
+struct NVNGX_ParameterWriter
+{
+    NVSDK_NGX_Parameter* params = nullptr;
+    NVNGX_Parameters* optiParams = nullptr;
+
+    template <NVNGXParameterKeys::Slot S, typename T> void Set(T value)
+    {
+        if (optiParams != nullptr)
+            optiParams->Set<S>(value);
+        else
+            params->Set(NVNGXParameterKeys::Known[S.index], value);
+    }
+};
+
+// Returns params when they were created by GetNGXParameters, nullptr otherwise
+inline static NVNGX_Parameters* GetOptiParameters(NVSDK_NGX_Parameter* params)
+{
+    int optiParam = 0;
+
+    if (params != nullptr && params->Get("OptiScaler", &optiParam) == NVSDK_NGX_Result_Success && optiParam == 1)
+        return static_cast<NVNGX_Parameters*>(params);
+
+    return nullptr;
+}
+
 inline static NVNGX_Parameters* GetNGXParameters(std::string InName)
 {
     auto params = new NVNGX_Parameters();
@@ -0,0 +1,381 @@
+#pragma once
+
+#include <nvsdk_ngx_defs.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+// Keys of the parameters which are exchanged every frame between games, input translators and upscaler
+// backends. They are mapped to dense slots by a table built at compile time, NVNGX_Parameters stores
+// them in a flat array and only falls back to its string keyed map for unknown keys.
+namespace NVNGXParameterKeys
+{
+inline constexpr const char* Known[] = {
+    // NGX SDK
+    NVSDK_NGX_Parameter_OptLevel,
+    NVSDK_NGX_Parameter_IsDevSnippetBranch,
+    NVSDK_NGX_Parameter_SuperSampling_ScaleFactor,
+    NVSDK_NGX_Parameter_ImageSignalProcessing_ScaleFactor,
+    NVSDK_NGX_Parameter_SuperSampling_Available,
+    NVSDK_NGX_Parameter_InPainting_Available,
+    NVSDK_NGX_Parameter_ImageSuperResolution_Available,
+    NVSDK_NGX_Parameter_SlowMotion_Available,
+    NVSDK_NGX_Parameter_VideoSuperResolution_Available,
+    NVSDK_NGX_Parameter_ImageSignalProcessing_Available,
+    NVSDK_NGX_Parameter_DeepResolve_Available,
+    NVSDK_NGX_Parameter_SuperSampling_NeedsUpdatedDriver,
+    NVSDK_NGX_Parameter_InPainting_NeedsUpdatedDriver,
+    NVSDK_NGX_Parameter_ImageSuperResolution_NeedsUpdatedDriver,
+    NVSDK_NGX_Parameter_SlowMotion_NeedsUpdatedDriver,
+    NVSDK_NGX_Parameter_VideoSuperResolution_NeedsUpdatedDriver,
+    NVSDK_NGX_Parameter_ImageSignalProcessing_NeedsUpdatedDriver,
+    NVSDK_NGX_Parameter_DeepResolve_NeedsUpdatedDriver,
+    NVSDK_NGX_Parameter_FrameInterpolation_NeedsUpdatedDriver,
+    NVSDK_NGX_Parameter_SuperSampling_MinDriverVersionMajor,
+    NVSDK_NGX_Parameter_InPainting_MinDriverVersionMajor,
+    NVSDK_NGX_Parameter_ImageSuperResolution_MinDriverVersionMajor,
+    NVSDK_NGX_Parameter_SlowMotion_MinDriverVersionMajor,
+    NVSDK_NGX_Parameter_VideoSuperResolution_MinDriverVersionMajor,
+    NVSDK_NGX_Parameter_ImageSignalProcessing_MinDriverVersionMajor,
+    NVSDK_NGX_Parameter_DeepResolve_MinDriverVersionMajor,
+    NVSDK_NGX_Parameter_FrameInterpolation_MinDriverVersionMajor,
+    NVSDK_NGX_Parameter_SuperSampling_MinDriverVersionMinor,
+    NVSDK_NGX_Parameter_InPainting_MinDriverVersionMinor,
+    NVSDK_NGX_Parameter_ImageSuperResolution_MinDriverVersionMinor,
+    NVSDK_NGX_Parameter_SlowMotion_MinDriverVersionMinor,
+    NVSDK_NGX_Parameter_VideoSuperResolution_MinDriverVersionMinor,
+    NVSDK_NGX_Parameter_ImageSignalProcessing_MinDriverVersionMinor,
+    NVSDK_NGX_Parameter_DeepResolve_MinDriverVersionMinor,
+    NVSDK_NGX_Parameter_SuperSampling_FeatureInitResult,
+    NVSDK_NGX_Parameter_InPainting_FeatureInitResult,
+    NVSDK_NGX_Parameter_ImageSuperResolution_FeatureInitResult,
+    NVSDK_NGX_Parameter_SlowMotion_FeatureInitResult,
+    NVSDK_NGX_Parameter_VideoSuperResolution_FeatureInitResult,
+    NVSDK_NGX_Parameter_ImageSignalProcessing_FeatureInitResult,
+    NVSDK_NGX_Parameter_DeepResolve_FeatureInitResult,
+    NVSDK_NGX_Parameter_FrameInterpolation_FeatureInitResult,
+    NVSDK_NGX_Parameter_ImageSuperResolution_ScaleFactor_2_1,
+    NVSDK_NGX_Parameter_ImageSuperResolution_ScaleFactor_3_1,
+    NVSDK_NGX_Parameter_ImageSuperResolution_ScaleFactor_3_2,
+    NVSDK_NGX_Parameter_ImageSuperResolution_ScaleFactor_4_3,
+    NVSDK_NGX_Parameter_NumFrames,
+    NVSDK_NGX_Parameter_Scale,
+    NVSDK_NGX_Parameter_Width,
+    NVSDK_NGX_Parameter_Height,
+    NVSDK_NGX_Parameter_OutWidth,
+    NVSDK_NGX_Parameter_OutHeight,
+    NVSDK_NGX_Parameter_Sharpness,
+    NVSDK_NGX_Parameter_Scratch,
+    NVSDK_NGX_Parameter_Scratch_SizeInBytes,
+    NVSDK_NGX_Parameter_Input1,
+    NVSDK_NGX_Parameter_Input1_Format,
+    NVSDK_NGX_Parameter_Input1_SizeInBytes,
+    NVSDK_NGX_Parameter_Input2,
+    NVSDK_NGX_Parameter_Input2_Format,
+    NVSDK_NGX_Parameter_Input2_SizeInBytes,
+    NVSDK_NGX_Parameter_Color,
+    NVSDK_NGX_Parameter_Color_Format,
+    NVSDK_NGX_Parameter_Color_SizeInBytes,
+    NVSDK_NGX_Parameter_FI_Color1,
+    NVSDK_NGX_Parameter_FI_Color2,
+    NVSDK_NGX_Parameter_Albedo,
+    NVSDK_NGX_Parameter_Output,
+    NVSDK_NGX_Parameter_Output_Format,
+    NVSDK_NGX_Parameter_Output_SizeInBytes,
+    NVSDK_NGX_Parameter_FI_Output1,
+    NVSDK_NGX_Parameter_FI_Output2,
+    NVSDK_NGX_Parameter_FI_Output3,
+    NVSDK_NGX_Parameter_Reset,
+    NVSDK_NGX_Parameter_BlendFactor,
+    NVSDK_NGX_Parameter_MotionVectors,
+    NVSDK_NGX_Parameter_FI_MotionVectors1,
+    NVSDK_NGX_Parameter_FI_MotionVectors2,
+    NVSDK_NGX_Parameter_Rect_X,
+    NVSDK_NGX_Parameter_Rect_Y,
+    NVSDK_NGX_Parameter_Rect_W,
+    NVSDK_NGX_Parameter_Rect_H,
+    NVSDK_NGX_Parameter_OutRect_X,
+    NVSDK_NGX_Parameter_OutRect_Y,
+    NVSDK_NGX_Parameter_OutRect_W,
+    NVSDK_NGX_Parameter_OutRect_H,
+    NVSDK_NGX_Parameter_MV_Scale_X,
+    NVSDK_NGX_Parameter_MV_Scale_Y,
+    NVSDK_NGX_Parameter_Model,
+    NVSDK_NGX_Parameter_Format,
+    NVSDK_NGX_Parameter_SizeInBytes,
+    NVSDK_NGX_Parameter_ResourceAllocCallback,
+    NVSDK_NGX_Parameter_BufferAllocCallback,
+    NVSDK_NGX_Parameter_Tex2DAllocCallback,
+    NVSDK_NGX_Parameter_ResourceReleaseCallback,
+    NVSDK_NGX_Parameter_CreationNodeMask,
+    NVSDK_NGX_Parameter_VisibilityNodeMask,
+    NVSDK_NGX_Parameter_MV_Offset_X,
+    NVSDK_NGX_Parameter_MV_Offset_Y,
+    NVSDK_NGX_Parameter_Hint_UseFireflySwatter,
+    NVSDK_NGX_Parameter_Resource_Width,
+    NVSDK_NGX_Parameter_Resource_Height,
+    NVSDK_NGX_Parameter_Resource_OutWidth,
+    NVSDK_NGX_Parameter_Resource_OutHeight,
+    NVSDK_NGX_Parameter_Depth,
+    NVSDK_NGX_Parameter_FI_Depth1,
+    NVSDK_NGX_Parameter_FI_Depth2,
+    NVSDK_NGX_Parameter_DLSSOptimalSettingsCallback,
+    NVSDK_NGX_Parameter_DLSSGetStatsCallback,
+    NVSDK_NGX_Parameter_PerfQualityValue,
+    NVSDK_NGX_Parameter_RTXValue,
+    NVSDK_NGX_Parameter_DLSSMode,
+    NVSDK_NGX_Parameter_FI_Mode,
+    NVSDK_NGX_Parameter_FI_OF_Preset,
+    NVSDK_NGX_Parameter_FI_OF_GridSize,
+    NVSDK_NGX_Parameter_Jitter_Offset_X,
+    NVSDK_NGX_Parameter_Jitter_Offset_Y,
+    NVSDK_NGX_Parameter_Denoise,
+    NVSDK_NGX_Parameter_TransparencyMask,
+    NVSDK_NGX_Parameter_ExposureTexture,
+    NVSDK_NGX_Parameter_DLSS_Feature_Create_Flags,
+    NVSDK_NGX_Parameter_DLSS_Checkerboard_Jitter_Hack,
+    NVSDK_NGX_Parameter_GBuffer_Normals,
+    NVSDK_NGX_Parameter_GBuffer_Albedo,
+    NVSDK_NGX_Parameter_GBuffer_Roughness,
+    NVSDK_NGX_Parameter_GBuffer_DiffuseAlbedo,
+    NVSDK_NGX_Parameter_GBuffer_SpecularAlbedo,
+    NVSDK_NGX_Parameter_GBuffer_IndirectAlbedo,
+    NVSDK_NGX_Parameter_GBuffer_SpecularMvec,
+    NVSDK_NGX_Parameter_GBuffer_DisocclusionMask,
+    NVSDK_NGX_Parameter_GBuffer_Metallic,
+    NVSDK_NGX_Parameter_GBuffer_Specular,
+    NVSDK_NGX_Parameter_GBuffer_Subsurface,
+    NVSDK_NGX_Parameter_GBuffer_ShadingModelId,
+    NVSDK_NGX_Parameter_GBuffer_MaterialId,
+    NVSDK_NGX_Parameter_GBuffer_Atrrib_8,
+    NVSDK_NGX_Parameter_GBuffer_Atrrib_9,
+    NVSDK_NGX_Parameter_GBuffer_Atrrib_10,
+    NVSDK_NGX_Parameter_GBuffer_Atrrib_11,
+    NVSDK_NGX_Parameter_GBuffer_Atrrib_12,
+    NVSDK_NGX_Parameter_GBuffer_Atrrib_13,
+    NVSDK_NGX_Parameter_GBuffer_Atrrib_14,
+    NVSDK_NGX_Parameter_GBuffer_Atrrib_15,
+    NVSDK_NGX_Parameter_TonemapperType,
+    NVSDK_NGX_Parameter_FreeMemOnReleaseFeature,
+    NVSDK_NGX_Parameter_MotionVectors3D,
+    NVSDK_NGX_Parameter_IsParticleMask,
+    NVSDK_NGX_Parameter_AnimatedTextureMask,
+    NVSDK_NGX_Parameter_DepthHighRes,
+    NVSDK_NGX_Parameter_Position_ViewSpace,
+    NVSDK_NGX_Parameter_FrameTimeDeltaInMsec,
+    NVSDK_NGX_Parameter_RayTracingHitDistance,
+    NVSDK_NGX_Parameter_MotionVectorsReflection,
+    NVSDK_NGX_Parameter_DLSS_Enable_Output_Subrects,
+    NVSDK_NGX_Parameter_DLSS_Input_Color_Subrect_Base_X,
+    NVSDK_NGX_Parameter_DLSS_Input_Color_Subrect_Base_Y,
+    NVSDK_NGX_Parameter_DLSS_Input_Depth_Subrect_Base_X,
+    NVSDK_NGX_Parameter_DLSS_Input_Depth_Subrect_Base_Y,
+    NVSDK_NGX_Parameter_DLSS_Input_MV_SubrectBase_X,
+    NVSDK_NGX_Parameter_DLSS_Input_MV_SubrectBase_Y,
+    NVSDK_NGX_Parameter_DLSS_Input_Translucency_SubrectBase_X,
+    NVSDK_NGX_Parameter_DLSS_Input_Translucency_SubrectBase_Y,
+    NVSDK_NGX_Parameter_DLSS_Output_Subrect_Base_X,
+    NVSDK_NGX_Parameter_DLSS_Output_Subrect_Base_Y,
+    NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width,
+    NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height,
+    NVSDK_NGX_Parameter_DLSS_Pre_Exposure,
+    NVSDK_NGX_Parameter_DLSS_Exposure_Scale,
+    NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask,
+    NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_SubrectBase_X,
+    NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_SubrectBase_Y,
+    NVSDK_NGX_Parameter_DLSS_Indicator_Invert_Y_Axis,
+    NVSDK_NGX_Parameter_DLSS_Indicator_Invert_X_Axis,
+    NVSDK_NGX_Parameter_DLSS_INV_VIEW_PROJECTION_MATRIX,
+    NVSDK_NGX_Parameter_DLSS_CLIP_TO_PREV_CLIP_MATRIX,
+    NVSDK_NGX_Parameter_DLSS_TransparencyLayer,
+    NVSDK_NGX_Parameter_DLSS_TransparencyLayer_Subrect_Base_X,
+    NVSDK_NGX_Parameter_DLSS_TransparencyLayer_Subrect_Base_Y,
+    NVSDK_NGX_Parameter_DLSS_TransparencyLayerOpacity,
+    NVSDK_NGX_Parameter_DLSS_TransparencyLayerOpacity_Subrect_Base_X,
+    NVSDK_NGX_Parameter_DLSS_TransparencyLayerOpacity_Subrect_Base_Y,
+    NVSDK_NGX_Parameter_DLSS_TransparencyLayerMvecs,
+    NVSDK_NGX_Parameter_DLSS_TransparencyLayerMvecs_Subrect_Base_X,
+    NVSDK_NGX_Parameter_DLSS_TransparencyLayerMvecs_Subrect_Base_Y,
+    NVSDK_NGX_Parameter_DLSS_DisocclusionMask,
+    NVSDK_NGX_Parameter_DLSS_DisocclusionMask_Subrect_Base_X,
+    NVSDK_NGX_Parameter_DLSS_DisocclusionMask_Subrect_Base_Y,
+    NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Max_Render_Width,
+    NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Max_Render_Height,
+    NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Min_Render_Width,
+    NVSDK_NGX_Parameter_DLSS_Get_Dynamic_Min_Render_Height,
+    NVSDK_NGX_Parameter_DLSS_Hint_Render_Preset_DLAA,
+    NVSDK_NGX_Parameter_DLSS_Hint_Render_Preset_Quality,
+    NVSDK_NGX_Parameter_DLSS_Hint_Render_Preset_Balanced,
+    NVSDK_NGX_Parameter_DLSS_Hint_Render_Preset_Performance,
+    NVSDK_NGX_Parameter_DLSS_Hint_Render_Preset_UltraPerformance,
+    NVSDK_NGX_Parameter_DLSS_Hint_Render_Preset_UltraQuality,
+
+    // Legacy enum keys which are set by OptiScaler
+    NVSDK_NGX_EParameter_SuperSampling_Available,
+    NVSDK_NGX_EParameter_Scale,
+    NVSDK_NGX_EParameter_OutWidth,
+    NVSDK_NGX_EParameter_OutHeight,
+    NVSDK_NGX_EParameter_Sharpness,
+    NVSDK_NGX_EParameter_MV_Scale_X,
+    NVSDK_NGX_EParameter_MV_Scale_Y,
+    NVSDK_NGX_EParameter_SizeInBytes,
+    NVSDK_NGX_EParameter_MV_Offset_X,
+    NVSDK_NGX_EParameter_MV_Offset_Y,
+    NVSDK_NGX_EParameter_DLSSOptimalSettingsCallback,
+    NVSDK_NGX_EParameter_DLSSMode,
+    NVSDK_NGX_EParameter_OptLevel,
+    NVSDK_NGX_EParameter_IsDevSnippetBranch,
+
+    // OptiScaler, FSR, XeSS and DLSSG inputs
+    "OptiScaler",
+    "OptiScaler.SupportsUpscaleSize",
+    "DLSSDOptimalSettingsCallback",
+    "FSR.cameraNear",
+    "FSR.cameraFar",
+    "FSR.cameraFovAngleVertical",
+    "FSR.frameTimeDelta",
+    "FSR.viewSpaceToMetersFactor",
+    "FSR.transparencyAndComposition",
+    "FSR.reactive",
+    "FSR.upscaleSize.width",
+    "FSR.upscaleSize.height",
+    "XeSS.ResponsivePixelMask",
+    "XeSS.ExposureScaleTexture",
+    "DLSSG.CameraNear",
+    "DLSSG.CameraFar",
+    "DLSSG.Depth",
+    "DLSSG.DepthInverted",
+    "DLSSG.MVecsSubrectWidth",
+    "DLSSG.MVecsSubrectHeight",
+    "DLSSG.run_lowres_mvec_pass",
+    "DLSS.Use.HW.Depth",
+    "DLSS.Denoise.Mode",
+    "DLSS.Roughness.Mode",
+    "RayReconstruction.Hint.Render.Preset.DLAA",
+    "RayReconstruction.Hint.Render.Preset.UltraQuality",
+    "RayReconstruction.Hint.Render.Preset.Quality",
+    "RayReconstruction.Hint.Render.Preset.Balanced",
+    "RayReconstruction.Hint.Render.Preset.Performance",
+    "RayReconstruction.Hint.Render.Preset.UltraPerformance",
+    "FrameGeneration.Available",
+    "FrameInterpolation.Available",
+    "FramerateLimit",
+    "DFG.Available",
+    "DFG.Enabled",
+    "DLSSEnabler.Available",
+    "DLSSEnabler.Dx12Backend",
+    "DLSSEnabler.VkBackend",
+    "DLSSEnabler.Logging",
+};
+
+inline constexpr size_t Count = std::size(Known);
+inline constexpr size_t TableSize = 1024;
+
+static_assert(Count <= TableSize / 2, "Lookup table is too small for known keys");
+
+constexpr uint32_t Hash(const char* key)
+{
+    uint32_t hash = 2166136261u;
+
+    while (*key != 0)
+    {
+        hash ^= (uint8_t) *key++;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+constexpr bool Equals(const char* a, const char* b)
+{
+    while (*a != 0 && *a == *b)
+    {
+        a++;
+        b++;
+    }
+
+    return *a == *b;
+}
+
+struct LookupTable
+{
+    std::array<int16_t, TableSize> slots {};
+    size_t maxProbe = 0;
+};
+
+constexpr LookupTable BuildLookupTable()
+{
+    LookupTable table {};
+    table.slots.fill(-1);
+
+    for (size_t i = 0; i < Count; i++)
+    {
+        size_t pos = Hash(Known[i]) & (TableSize - 1);
+        size_t probe = 0;
+        bool duplicate = false;
+
+        while (table.slots[pos] != -1)
+        {
+            if (Equals(Known[table.slots[pos]], Known[i]))
+            {
+                duplicate = true;
+                break;
+            }
+
+            pos = (pos + 1) & (TableSize - 1);
+            probe++;
+        }
+
+        if (!duplicate)
+            table.slots[pos] = (int16_t) i;
+
+        if (probe > table.maxProbe)
+            table.maxProbe = probe;
+    }
+
+    return table;
+}
+
+inline constexpr LookupTable Lookup = BuildLookupTable();
+
+static_assert(Lookup.maxProbe < 8, "Too many collisions in known key table");
+
+// Returns slot index of key or -1 when key is not a known one
+constexpr int Find(const char* key)
+{
+    if (key == nullptr)
+        return -1;
+
+    size_t pos = Hash(key) & (TableSize - 1);
+
+    for (size_t probe = 0; probe <= Lookup.maxProbe; probe++)
+    {
+        auto slot = Lookup.slots[pos];
+
+        if (slot == -1)
+            return -1;
+
+        if (Equals(Known[slot], key))
+            return slot;
+
+        pos = (pos + 1) & (TableSize - 1);
+    }
+
+    return -1;
+}
+
+// Slot of a known key resolved at compile time, used as a template argument so hot paths don't hash the
+// key on every call. Unknown keys fail to compile.
+struct Slot
+{
+    int index;
+
+    consteval Slot(const char* key) : index(Find(key))
+    {
+        if (index < 0)
+            throw "Not a known parameter key";
+    }
+};
+} // namespace NVNGXParameterKeys
@@ -4,11 +4,15 @@
 #include "upscalers/IFeature.h"
 #include "framegen/IFGFeature_Dx12.h"
 #include "misc/Quirks.h"
+#include "misc/FrameTimeRing.h"
+#include "misc/ThreadFlag.h"
 
-#include <deque>
 #include <vulkan/vulkan.h>
 #include <ankerl/unordered_dense.h>
 
+struct SkipHeapCaptureTag;
+struct SkipSpoofingTag;
+
 typedef enum API
 {
     NotSelected = 0,
@@ -24,6 +28,8 @@ typedef enum FGType : uint32_t
     Nukems
 } FGType;
 
+struct SwapchainContext_Dx;
+
 typedef struct CapturedHudlessInfo
 {
     UINT64 usageCount = 1;
@@ -70,7 +76,9 @@ class State
     bool FGonlyGenerated = false;
     bool FGchanged = false;
     bool SCchanged = false;
-    bool skipHeapCapture = false;
+
+    // Per thread, set while OptiScaler creates its own heaps
+    ThreadFlag<SkipHeapCaptureTag> skipHeapCapture;
 
     bool FGcaptureResources = false;
     bool FGHudlessCompare = false;
@@ -80,7 +88,9 @@ class State
 
     bool FSRFGFTPchanged = false;
 
+    // Hudfix, resource release hook and menu all touch the list, every access must hold CapturedHudlessesMutex
     ankerl::unordered_dense::map<void*, CapturedHudlessInfo> CapturedHudlesses;
+    std::mutex CapturedHudlessesMutex;
     bool ClearCapturedHudlesses = false;
 
     // NVNGX init parameters
@@ -125,8 +135,8 @@ class State
     bool dlssPresetsOverriddenExternally = false;
     bool dlssdPresetsOverriddenExternally = false;
 
-    // Spoofing
-    bool skipSpoofing = false;
+    // Spoofing, per thread like skipHeapCapture
+    ThreadFlag<SkipSpoofingTag> skipSpoofing;
     // For DXVK, it calls DXGI which cause softlock
     bool skipDxgiLoadChecks = false;
 
@@ -149,10 +159,10 @@ class State
     VkInstance VulkanInstance = nullptr;
 
     // Framegraph
-    std::deque<double> upscaleTimes;
-    std::deque<double> frameTimes;
+    FrameTimeRing<300> upscaleTimes;
+    FrameTimeRing<300> frameTimes;
+    FrameTimeRing<300> overlayTimes; // Cpu time of the overlay per present while the menu is closed
     double lastFrameTime = 0.0;
-    std::mutex frameTimeMutex;
 
     // Swapchain info
     float screenWidth = 800.0;
@@ -180,6 +190,7 @@ class State
 
     IFGFeature_Dx12* currentFG = nullptr;
     IDXGISwapChain* currentSwapchain = nullptr;
+    const SwapchainContext_Dx* currentSwapchainContext = nullptr; // Null when currentSwapchain is not wrapped
     ID3D12Device* currentD3D12Device = nullptr;
     ID3D11Device* currentD3D11Device = nullptr;
     ID3D12CommandQueue* currentCommandQueue = nullptr;
@@ -3,8 +3,15 @@
 #include "Util.h"
 #include "Config.h"
 
+#include <misc/FileIndex.h>
+
 #include <shlobj.h>
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 typedef LONG(WINAPI* RtlGetVersionPtr)(PRTL_OSVERSIONINFOW);
 typedef DWORD (*PFN_GetFileVersionInfoSizeW)(LPCWSTR lptstrFilename, LPDWORD lpdwHandle);
 typedef BOOL (*PFN_GetFileVersionInfoW)(LPCWSTR lptstrFilename, DWORD dwHandle, DWORD dwLen, LPVOID lpData);
@@ -352,51 +359,123 @@ bool Util::GetDLLVersion(std::wstring dllPath, xess_version_t* xessVersionOut)
     return result;
 }
 
-std::optional<std::filesystem::path> Util::FindFilePath(const std::filesystem::path& startDir,
-                                                        const std::filesystem::path fileName)
+// UE games keep the dll in <Project>/Binaries/Win64, files can be anywhere below the folder of the project
+static std::optional<std::filesystem::path> UnrealRoot(const std::filesystem::path& startDir)
 {
-    // 1) Direct check in startDir
-    std::filesystem::path candidate = startDir / fileName;
-    if (std::filesystem::exists(candidate) && std::filesystem::is_regular_file(candidate))
+    std::filesystem::path parent = startDir.parent_path().parent_path();
+    for (const char* folder : { "Win64", "WinGDK", "Win64MasterMasterSteamPGO" })
     {
-        LOG_INFO("{} found at {}", fileName.string(), candidate.parent_path().string());
-        return candidate;
+        if (std::filesystem::exists(parent / folder) && std::filesystem::is_directory(parent / folder))
+        {
+            // Move up two more levels from 'parent' to reach UE project root
+            return parent.parent_path().parent_path();
+        }
     }
 
-    // 2) Recursive search under startDir
+    return std::nullopt;
+}
+
+static std::optional<std::filesystem::path> WalkForFile(const std::filesystem::path& startDir,
+                                                        const std::filesystem::path& fileName)
+{
+    // Recursive search under startDir
     for (auto& entry : std::filesystem::recursive_directory_iterator(
              startDir, std::filesystem::directory_options::skip_permission_denied))
     {
         if (!entry.is_directory() && entry.path().filename() == fileName)
-        {
-            LOG_INFO("{} found at {}", fileName.string(), entry.path().parent_path().string());
             return entry.path();
-        }
     }
 
-    // 3) Unreal-Engine/WinGDK fallback: check for Win64 or WinGDK in parent
-    std::filesystem::path parent = startDir.parent_path().parent_path();
-    for (const char* folder : { "Win64", "WinGDK", "Win64MasterMasterSteamPGO" })
+    // Unreal-Engine/WinGDK fallback
+    if (auto ueRoot = UnrealRoot(startDir); ueRoot.has_value())
     {
-        if (std::filesystem::exists(parent / folder) && std::filesystem::is_directory(parent / folder))
+        for (auto& entry : std::filesystem::recursive_directory_iterator(
+                 ueRoot.value(), std::filesystem::directory_options::skip_permission_denied))
         {
-            // Move up two more levels from 'parent' to reach UE project root
-            std::filesystem::path ueRoot = parent.parent_path().parent_path();
-            for (auto& entry : std::filesystem::recursive_directory_iterator(
-                     ueRoot, std::filesystem::directory_options::skip_permission_denied))
-            {
-                if (!entry.is_directory() && entry.path().filename() == fileName)
-                {
-                    LOG_INFO("{} found at {}", fileName.string(), entry.path().parent_path().string());
-                    return entry.path();
-                }
-            }
-
-            // If not found under this folder, break to avoid double-search
-            break;
+            if (!entry.is_directory() && entry.path().filename() == fileName)
+                return entry.path();
         }
     }
 
     // Not found anywhere
     return std::nullopt;
 }
+
+static std::optional<FileIndex> fileIndex;
+static std::filesystem::path fileIndexStartDir;
+static std::atomic<bool> fileIndexReady = false;
+
+// Builds the index of startDir or loads it from the cache, runs once on the prefetch thread
+static void BuildFileIndex(const std::filesystem::path& startDir)
+{
+    // Logs and caches are written next to the dll, its time changes on every start
+    auto folder = startDir.has_filename() ? startDir : startDir.parent_path();
+    auto root = UnrealRoot(startDir).value_or(folder);
+    auto cachePath = Util::DllPath().parent_path() / "OptiScaler.fileindex";
+    auto start = Util::MillisecondsNow();
+
+    FileIndex index;
+
+    if (index.LoadFile(cachePath) && index.Root() == root && index.IsCurrent({ folder }))
+    {
+        LOG_INFO("File index loaded, directories: {}, files: {}, {:.2f} ms", index.DirectoryCount(),
+                 index.FileCount(), Util::MillisecondsNow() - start);
+    }
+    else
+    {
+        auto helpers = std::clamp(std::thread::hardware_concurrency(), 1u, 8u) - 1;
+        index = FileIndex::Build(root, { ".dll" }, helpers);
+
+        LOG_INFO("File index built, directories: {}, files: {}, {:.2f} ms", index.DirectoryCount(),
+                 index.FileCount(), Util::MillisecondsNow() - start);
+
+        if (!index.SaveFile(cachePath))
+            LOG_DEBUG("Can't write file index: {}", cachePath.string());
+    }
+
+    fileIndex = std::move(index);
+    fileIndexStartDir = startDir;
+    fileIndexReady.store(true, std::memory_order_release);
+}
+
+// Index of startDir when the prefetch has finished, it's not changed after that
+static const FileIndex* ReadyFileIndex(const std::filesystem::path& startDir)
+{
+    if (!fileIndexReady.load(std::memory_order_acquire))
+        return nullptr;
+
+    return fileIndexStartDir == startDir ? &fileIndex.value() : nullptr;
+}
+
+void Util::PrefetchFileIndex()
+{
+    // Starts running after DllMain released the loader lock, lookups until then walk the disk
+    static std::once_flag started;
+    std::call_once(started, [] { std::thread([] { BuildFileIndex(Util::DllPath().remove_filename()); }).detach(); });
+}
+
+std::optional<std::filesystem::path> Util::FindFilePath(const std::filesystem::path& startDir,
+                                                        const std::filesystem::path fileName)
+{
+    // 1) Direct check in startDir
+    std::filesystem::path candidate = startDir / fileName;
+    if (std::filesystem::exists(candidate) && std::filesystem::is_regular_file(candidate))
+    {
+        LOG_INFO("{} found at {}", fileName.string(), candidate.parent_path().string());
+        return candidate;
+    }
+
+    // 2) Index of the dll folder (or the UE project) once it's ready. Before that (the working mode
+    // checks in DllMain) and for other files and folders the disk is walked until the first match
+    std::optional<std::filesystem::path> result;
+
+    if (auto index = fileName.extension() == ".dll" ? ReadyFileIndex(startDir) : nullptr; index != nullptr)
+        result = index->FindFirst(startDir, fileName);
+    else
+        result = WalkForFile(startDir, fileName);
+
+    if (result.has_value())
+        LOG_INFO("{} found at {}", fileName.string(), result.value().parent_path().string());
+
+    return result;
+}
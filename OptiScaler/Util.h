@@ -27,8 +27,13 @@ bool GetRealWindowsVersion(OSVERSIONINFOW& osInfo);
 std::string GetWindowsName(const OSVERSIONINFOW& os);
 std::wstring GetExeProductName();
 std::wstring GetWindowTitle(HWND hwnd);
+
+// Dlls are found through an index of the game folder once PrefetchFileIndex built it (or loaded its cache),
+// until then the folder is walked
 std::optional<std::filesystem::path> FindFilePath(const std::filesystem::path& startDir,
                                                   const std::filesystem::path fileName);
+void PrefetchFileIndex();
+
 std::string WhoIsTheCaller(void* returnAddress);
 }; // namespace Util
 
@@ -34,6 +34,9 @@
 
 #include <nvapi/NvApiHooks.h>
 
+#include <misc/ShaderCache_Dx12.h>
+#include <misc/StartupTrace.h>
+
 #include <cwctype>
 
 static std::vector<HMODULE> _asiHandles;
@@ -86,6 +89,7 @@ static inline void* ManualGetProcAddress(HMODULE hModule, const char* functionNa
 
 static bool IsRunningOnWine()
 {
+    StartupTrace::Scope trace("IsRunningOnWine");
     LOG_FUNC();
 
     HMODULE ntdll = GetModuleHandle(L"ntdll.dll");
@@ -118,6 +122,8 @@ const char8_t* customD3D12SDKPath = u8".\\D3D12_Optiscaler\\"; // Hardcoded for
 
 static void RunAgilityUpgrade(HMODULE dx12Module)
 {
+    StartupTrace::Scope trace("RunAgilityUpgrade");
+
     typedef HRESULT (*PFN_IsDeveloperModeEnabled)(BOOL* isEnabled);
     PFN_IsDeveloperModeEnabled o_IsDeveloperModeEnabled =
         (PFN_IsDeveloperModeEnabled) GetProcAddress(GetModuleHandle(L"kernelbase.dll"), "IsDeveloperModeEnabled");
@@ -171,6 +177,8 @@ static void RunAgilityUpgrade(HMODULE dx12Module)
 
 void LoadAsiPlugins()
 {
+    StartupTrace::Scope trace("LoadAsiPlugins");
+
     std::filesystem::path pluginPath(Config::Instance()->PluginPath.value_or_default());
     auto folderPath = pluginPath.wstring();
 
@@ -234,10 +242,12 @@ void LoadAsiPlugins()
 
 static void CheckWorkingMode()
 {
+    StartupTrace::Scope trace("CheckWorkingMode");
     LOG_FUNC();
 
     if (Config::Instance()->EarlyHooking.value_or_default())
     {
+        StartupTrace::Scope hookTrace("EarlyHooks");
 
         NtdllHooks::Hook();
         KernelHooks::Hook();
@@ -255,6 +265,8 @@ static void CheckWorkingMode()
     for (size_t i = 0; i < lCaseFilename.size(); i++)
         lCaseFilename[i] = std::tolower(lCaseFilename[i]);
 
+    auto proxyTrace = StartupTrace::Begin("LoadOriginalDll");
+
     do
     {
         if (lCaseFilename == "nvngx.dll" || lCaseFilename == "_nvngx.dll" ||
@@ -646,9 +658,14 @@ static void CheckWorkingMode()
 
     } while (false);
 
+    StartupTrace::End(proxyTrace);
+
     if (modeFound)
     {
-        Config::Instance()->CheckUpscalerFiles();
+        {
+            StartupTrace::Scope filesTrace("CheckUpscalerFiles");
+            Config::Instance()->CheckUpscalerFiles();
+        }
 
         if (!State::Instance().isWorkingAsNvngx || State::Instance().enablerAvailable)
         {
@@ -657,6 +674,8 @@ static void CheckWorkingMode()
                 Config::Instance()->OverlayMenu.value_or_default());
 
             // DXGI
+            auto hookTrace = StartupTrace::Begin("HookDxgi");
+
             if (DxgiProxy::Module() == nullptr)
             {
                 LOG_DEBUG("Check for dxgi");
@@ -690,7 +709,11 @@ static void CheckWorkingMode()
                     HooksDx::HookDxgi();
             }
 
+            StartupTrace::End(hookTrace);
+
             // DirectX 12
+            hookTrace = StartupTrace::Begin("HookDx12");
+
             if (D3d12Proxy::Module() == nullptr)
             {
                 // Moved here to cover agility sdk
@@ -718,7 +741,10 @@ static void CheckWorkingMode()
                 D3d12Proxy::Init();
             }
 
+            StartupTrace::End(hookTrace);
+
             // DirectX 11
+            hookTrace = StartupTrace::Begin("HookDx11");
             d3d11Module = GetDllNameWModule(&dx11NamesW);
             if (Config::Instance()->OverlayMenu.value() && d3d11Module != nullptr)
             {
@@ -726,7 +752,10 @@ static void CheckWorkingMode()
                 HooksDx::HookDx11(d3d11Module);
             }
 
+            StartupTrace::End(hookTrace);
+
             // Vulkan
+            hookTrace = StartupTrace::Begin("HookVulkan");
             vulkanModule = GetDllNameWModule(&vkNamesW);
             if ((State::Instance().isRunningOnDXVK || State::Instance().isRunningOnLinux) && vulkanModule == nullptr)
                 vulkanModule = KernelBaseProxy::LoadLibraryExW_()(vkNamesW[0].c_str(), NULL, 0);
@@ -745,7 +774,10 @@ static void CheckWorkingMode()
                 HooksVk::HookVk(vulkanModule);
             }
 
+            StartupTrace::End(hookTrace);
+
             // NVAPI
+            hookTrace = StartupTrace::Begin("HookNvApi");
             HMODULE nvapi64 = nullptr;
             nvapi64 = GetDllNameWModule(&nvapiNamesW);
             if (nvapi64 != nullptr)
@@ -756,7 +788,10 @@ static void CheckWorkingMode()
                 NvApiHooks::Hook(nvapi64);
             }
 
+            StartupTrace::End(hookTrace);
+
             // GDI32
+            hookTrace = StartupTrace::Begin("HookSystemDlls");
             hookGdi32();
 
             // Wintrust
@@ -770,7 +805,10 @@ static void CheckWorkingMode()
                 Config::Instance()->StreamlineSpoofing.value_or_default())
                 hookAdvapi32();
 
+            StartupTrace::End(hookTrace);
+
             // hook streamline right away if it's already loaded
+            hookTrace = StartupTrace::Begin("HookStreamline");
             HMODULE slModule = nullptr;
             slModule = GetDllNameWModule(&slInterposerNamesW);
             if (slModule != nullptr)
@@ -811,7 +849,10 @@ static void CheckWorkingMode()
                 StreamlineHooks::hookCommon(slCommon);
             }
 
+            StartupTrace::End(hookTrace);
+
             // XeSS
+            hookTrace = StartupTrace::Begin("HookUpscalerDlls");
             HMODULE xessModule = nullptr;
             xessModule = GetDllNameWModule(&xessNamesW);
             if (xessModule != nullptr)
@@ -855,12 +896,15 @@ static void CheckWorkingMode()
                 FfxApiProxy::InitFfxVk(ffxVkModule);
             }
 
+            StartupTrace::End(hookTrace);
+
             // SpecialK
             if (!State::Instance().enablerAvailable &&
                 (Config::Instance()->FGType.value_or_default() != FGType::OptiFG ||
                  !Config::Instance()->OverlayMenu.value_or_default()) &&
                 skModule == nullptr && Config::Instance()->LoadSpecialK.value_or_default())
             {
+                StartupTrace::Scope loadTrace("LoadSpecialK");
                 auto skFile = Util::DllPath().parent_path() / L"SpecialK64.dll";
                 SetEnvironmentVariableW(L"RESHADE_DISABLE_GRAPHICS_HOOK", L"1");
 
@@ -875,6 +919,7 @@ static void CheckWorkingMode()
             if (!State::Instance().enablerAvailable && reshadeModule == nullptr &&
                 Config::Instance()->LoadReShade.value_or_default())
             {
+                StartupTrace::Scope loadTrace("LoadReShade");
                 auto rsFile = Util::DllPath().parent_path() / L"ReShade64.dll";
                 SetEnvironmentVariableW(L"RESHADE_DISABLE_LOADING_CHECK", L"1");
 
@@ -891,6 +936,7 @@ static void CheckWorkingMode()
             // Hook kernel32 methods
             if (!Config::Instance()->EarlyHooking.value_or_default())
             {
+                StartupTrace::Scope kernelTrace("HookKernel");
                 NtdllHooks::Hook();
                 KernelHooks::Hook();
             }
@@ -904,6 +950,7 @@ static void CheckWorkingMode()
             // Intel Extension Framework
             if (Config::Instance()->UESpoofIntelAtomics64.value_or_default())
             {
+                StartupTrace::Scope igdextTrace("LoadIntelExtensions");
                 HMODULE igdext = KernelBaseProxy::LoadLibraryW_()(L"igdext64.dll");
 
                 if (igdext == nullptr)
@@ -943,6 +990,8 @@ static void CheckWorkingMode()
 
 static void CheckQuirks()
 {
+    StartupTrace::Scope trace("CheckQuirks");
+
     auto exePathFilename = Util::ExePath().filename().string();
 
     State::Instance().GameExe = exePathFilename;
@@ -1018,6 +1067,8 @@ static void CheckQuirks()
 
 bool isNvidia()
 {
+    StartupTrace::Scope trace("IsNvidia");
+
     bool nvidiaDetected = false;
     bool loadedHere = false;
     auto nvapiModule = GetDllNameWModule(&nvapiNamesW);
@@ -1088,14 +1139,34 @@ bool isNvidia()
     return nvidiaDetected;
 }
 
+// Ends the span of DllMain, trace is only written when LogStartupTrace is enabled
+static void SaveStartupTrace(const SpanRecorder::Token& initTrace)
+{
+    StartupTrace::End(initTrace);
+    LOG_INFO("Startup took {:.3f} ms", (SpanRecorder::Now() - initTrace.start) / 1000000.0);
+
+    if (!Config::Instance()->LogStartupTrace.value_or_default())
+        return;
+
+    auto path = Util::DllPath().parent_path() / L"OptiScaler.startup.json";
+
+    if (StartupTrace::Recorder().SaveChromeTrace(path, (uint32_t) processId))
+        LOG_INFO("Startup trace saved to {}", path.string());
+    else
+        LOG_WARN("Can't write startup trace: {}", path.string());
+}
+
 BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserved)
 {
     HMODULE handle = nullptr;
     OSVERSIONINFOW winVer { 0 };
+    SpanRecorder::Token initTrace {};
+    SpanRecorder::Token phaseTrace {};
 
     switch (ul_reason_for_call)
     {
     case DLL_PROCESS_ATTACH:
+        initTrace = StartupTrace::Begin("DllMain");
         DisableThreadLibraryCalls(hModule);
 
         dllModule = hModule;
@@ -1111,7 +1182,9 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
             Config::Instance()->LogLevel.set_volatile_value(1);
 #endif
 
+        phaseTrace = StartupTrace::Begin("PrepareLogger");
         PrepareLogger();
+        StartupTrace::End(phaseTrace);
 
         spdlog::warn("{0} loaded", VER_PRODUCT_NAME);
         spdlog::warn("---------------------------------");
@@ -1142,12 +1215,16 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
             SetEnvironmentVariable(L"SteamNoOverlayUIDrawing", L"1");
 
         // Init Kernel proxies
+        phaseTrace = StartupTrace::Begin("KernelProxies");
         KernelBaseProxy::Init();
         Kernel32Proxy::Init();
+        StartupTrace::End(phaseTrace);
 
         // Hook FSR4 stuff as early as possible
         spdlog::info("");
+        phaseTrace = StartupTrace::Begin("InitFSR4Update");
         InitFSR4Update();
+        StartupTrace::End(phaseTrace);
 
         // Check for Wine
         spdlog::info("");
@@ -1191,6 +1268,9 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
             Config::Instance()->OverrideNvapiDll.set_volatile_value(!State::Instance().isRunningOnNvidia);
         }
 
+        // Index the dlls of the game folder in background, lookups after DllMain use it
+        Util::PrefetchFileIndex();
+
         // Check for working mode and attach hooks
         spdlog::info("");
         CheckWorkingMode();
@@ -1213,6 +1293,8 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
             }
         }
 
+        phaseTrace = StartupTrace::Begin("HookInputs");
+
         if (Config::Instance()->EnableFsr2Inputs.value_or_default())
         {
 
@@ -1243,14 +1325,15 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserv
         }
         // HookFfxExeInputs();
 
+        StartupTrace::End(phaseTrace);
+
         // Initial state of FSR-FG
         State::Instance().activeFgType = Config::Instance()->FGType.value_or_default();
 
-        for (size_t i = 0; i < 300; i++)
-        {
-            State::Instance().frameTimes.push_back(0.0f);
-            State::Instance().upscaleTimes.push_back(0.0f);
-        }
+        // Read the shader cache while the game is still loading
+        ShaderCache_Dx12::Prefetch();
+
+        SaveStartupTrace(initTrace);
 
         spdlog::info("");
         spdlog::info("Init done");
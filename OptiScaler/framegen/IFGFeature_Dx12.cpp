@@ -2,6 +2,7 @@
 
 #include <State.h>
 #include <Config.h>
+#include <misc/DeferredRelease_Dx12.h>
 
 bool IFGFeature_Dx12::CreateBufferResourceWithSize(ID3D12Device* device, ID3D12Resource* source,
                                                    D3D12_RESOURCE_STATES state, ID3D12Resource** target, UINT width,
@@ -25,7 +26,8 @@ bool IFGFeature_Dx12::CreateBufferResourceWithSize(ID3D12Device* device, ID3D12R
         if (bufDesc.Width != width || bufDesc.Height != height || bufDesc.Format != inDesc.Format ||
             bufDesc.Flags != inDesc.Flags)
         {
-            (*target)->Release();
+            // Previous frames might still use it
+            DeferredRelease_Dx12::Release(*target, "FG resource");
             (*target) = nullptr;
         }
         else
@@ -82,7 +84,8 @@ bool IFGFeature_Dx12::CreateBufferResource(ID3D12Device* device, ID3D12Resource*
         if (bufDesc.Width != inDesc.Width || bufDesc.Height != inDesc.Height || bufDesc.Format != inDesc.Format ||
             bufDesc.Flags != inDesc.Flags)
         {
-            (*target)->Release();
+            // Previous frames might still use it
+            DeferredRelease_Dx12::Release(*target, "FG resource");
             (*target) = nullptr;
         }
         else
@@ -115,33 +118,22 @@ bool IFGFeature_Dx12::CreateBufferResource(ID3D12Device* device, ID3D12Resource*
     return true;
 }
 
-void IFGFeature_Dx12::ResourceBarrier(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* resource,
-                                      D3D12_RESOURCE_STATES beforeState, D3D12_RESOURCE_STATES afterState)
-{
-    D3D12_RESOURCE_BARRIER barrier = {};
-    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    barrier.Transition.pResource = resource;
-    barrier.Transition.StateBefore = beforeState;
-    barrier.Transition.StateAfter = afterState;
-    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-    cmdList->ResourceBarrier(1, &barrier);
-}
-
 bool IFGFeature_Dx12::CopyResource(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* source, ID3D12Resource** target,
                                    D3D12_RESOURCE_STATES sourceState)
 {
-    auto result = true;
+    if (!CreateBufferResource(State::Instance().currentD3D12Device, source, D3D12_RESOURCE_STATE_COPY_DEST, target))
+        return false;
 
-    ResourceBarrier(cmdList, source, sourceState, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    _barriers.Begin(cmdList);
+    _barriers.Require(source, sourceState, D3D12_RESOURCE_STATE_COPY_SOURCE);
+    _barriers.Flush();
 
-    if (CreateBufferResource(State::Instance().currentD3D12Device, source, D3D12_RESOURCE_STATE_COPY_DEST, target))
-        cmdList->CopyResource(*target, source);
-    else
-        result = false;
+    cmdList->CopyResource(*target, source);
 
-    ResourceBarrier(cmdList, source, D3D12_RESOURCE_STATE_COPY_SOURCE, sourceState);
+    // Source goes back with the next flush, together with the transitions of the next input
+    _barriers.Require(source, D3D12_RESOURCE_STATE_COPY_SOURCE, sourceState);
 
-    return result;
+    return true;
 }
 
 void IFGFeature_Dx12::SetVelocity(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* velocity,
@@ -166,16 +158,18 @@ void IFGFeature_Dx12::SetVelocity(ID3D12GraphicsCommandList* cmdList, ID3D12Reso
 
         if (_mvFlip->IsInit())
         {
-            ResourceBarrier(cmdList, _paramVelocityCopy[index], D3D12_RESOURCE_STATE_COPY_DEST,
-                            D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+            _barriers.Begin(cmdList);
+            _barriers.Require(_paramVelocityCopy[index], D3D12_RESOURCE_STATE_COPY_DEST,
+                              D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+            _barriers.Flush();
 
             auto feature = State::Instance().currentFeature;
             UINT width = feature->LowResMV() ? feature->RenderWidth() : feature->DisplayWidth();
             UINT height = feature->LowResMV() ? feature->RenderHeight() : feature->DisplayHeight();
             auto result = _mvFlip->Dispatch(_device, cmdList, velocity, _paramVelocityCopy[index], width, height, true);
 
-            ResourceBarrier(cmdList, _paramVelocityCopy[index], D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
-                            D3D12_RESOURCE_STATE_COPY_DEST);
+            _barriers.Require(_paramVelocityCopy[index], D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+                              D3D12_RESOURCE_STATE_COPY_DEST);
 
             if (result)
             {
@@ -218,15 +212,17 @@ void IFGFeature_Dx12::SetDepth(ID3D12GraphicsCommandList* cmdList, ID3D12Resourc
 
         if (_depthFlip->IsInit())
         {
-            ResourceBarrier(cmdList, _paramDepthCopy[index], D3D12_RESOURCE_STATE_COPY_DEST,
-                            D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+            _barriers.Begin(cmdList);
+            _barriers.Require(_paramDepthCopy[index], D3D12_RESOURCE_STATE_COPY_DEST,
+                              D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+            _barriers.Flush();
 
             auto feature = State::Instance().currentFeature;
             auto result = _depthFlip->Dispatch(_device, cmdList, depth, _paramDepthCopy[index], feature->RenderWidth(),
                                                feature->RenderHeight(), false);
 
-            ResourceBarrier(cmdList, _paramDepthCopy[index], D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
-                            D3D12_RESOURCE_STATE_COPY_DEST);
+            _barriers.Require(_paramDepthCopy[index], D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+                              D3D12_RESOURCE_STATE_COPY_DEST);
 
             if (result)
             {
@@ -270,8 +266,13 @@ void IFGFeature_Dx12::SetHudless(ID3D12GraphicsCommandList* cmdList, ID3D12Resou
         _paramHudlessState[index] = state;
         _paramHudless[index] = hudless;
     }
+
+    // Hudless is set from its own pass, nothing to batch it with
+    _barriers.Finish();
 }
 
+void IFGFeature_Dx12::FlushBarriers() { _barriers.Finish(); }
+
 void IFGFeature_Dx12::CreateObjects(ID3D12Device* InDevice)
 {
     _device = InDevice;
@@ -4,6 +4,8 @@
 
 #include <upscalers/IFeature.h>
 
+#include <misc/BarrierBatch_Dx12.h>
+
 #include <shaders/resource_flip/RF_Dx12.h>
 #include <shaders/hudless_compare/HC_Dx12.h>
 
@@ -18,6 +20,9 @@ class IFGFeature_Dx12 : public virtual IFGFeature
     std::unique_ptr<HC_Dx12> _hudlessCompare;
     ID3D12Device* _device = nullptr;
 
+    // Transitions of the input copies, restoring the game's states is deferred to the next flush
+    BarrierBatch_Dx12 _barriers;
+
   protected:
     IDXGISwapChain* _swapChain = nullptr;
     ID3D12CommandQueue* _gameCommandQueue = nullptr;
@@ -38,8 +43,6 @@ class IFGFeature_Dx12 : public virtual IFGFeature
                               ID3D12Resource** OutResource, bool UAV = false, bool depth = false);
     bool CreateBufferResourceWithSize(ID3D12Device* device, ID3D12Resource* source, D3D12_RESOURCE_STATES state,
                                       ID3D12Resource** target, UINT width, UINT height, bool UAV, bool depth);
-    void ResourceBarrier(ID3D12GraphicsCommandList* InCommandList, ID3D12Resource* InResource,
-                         D3D12_RESOURCE_STATES InBeforeState, D3D12_RESOURCE_STATES InAfterState);
     bool CopyResource(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* source, ID3D12Resource** target,
                       D3D12_RESOURCE_STATES sourceState);
 
@@ -67,6 +70,9 @@ class IFGFeature_Dx12 : public virtual IFGFeature
     void SetHudless(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* hudless, D3D12_RESOURCE_STATES state,
                     bool makeCopy = false);
 
+    // Gives the velocity and depth back to the game, called after the last input was set
+    void FlushBarriers();
+
     bool ExecuteCommandList();
     ID3D12CommandList* GetCommandList();
     void Compare();
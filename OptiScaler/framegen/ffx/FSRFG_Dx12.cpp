@@ -4,6 +4,7 @@
 
 #include <upscalers/IFeature.h>
 #include <menu/menu_overlay_dx.h>
+#include <misc/GpuTimer_Dx12.h>
 #include <future>
 
 // #define USE_QUEUE_FOR_FG
@@ -215,7 +216,10 @@ bool FSRFG_Dx12::Dispatch()
         dfgPrepare.frameTimeDelta = _ftDelta;
         dfgPrepare.viewSpaceToMetersFactor = _meterFactor;
 
+        auto prepareTimer = GpuTimer_Dx12::Begin(_commandList[fIndex], GpuPass::FGDispatch);
         retCode = FfxApiProxy::D3D12_Dispatch()(&_fgContext, &dfgPrepare.header);
+        GpuTimer_Dx12::End(prepareTimer);
+
         LOG_DEBUG("D3D12_Dispatch result: {0}, frame: {1}, fIndex: {2}, commandList: {3:X}", retCode, _frameCount,
                   fIndex, (size_t) dfgPrepare.commandList);
 
@@ -261,7 +265,10 @@ ffxReturnCode_t FSRFG_Dx12::DispatchCallback(ffxDispatchDescFrameGeneration* par
         params->numGeneratedFrames = 0;
     }
 
+    auto dispatchTimer = GpuTimer_Dx12::Begin((ID3D12GraphicsCommandList*) params->commandList, GpuPass::FGDispatch);
     dispatchResult = FfxApiProxy::D3D12_Dispatch()(&_fgContext, &params->header);
+    GpuTimer_Dx12::End(dispatchTimer);
+
     LOG_DEBUG("D3D12_Dispatch result: {}, fIndex: {}", (UINT) dispatchResult, fIndex);
 
     _lastUpscaledFrameId = params->frameID;
@@ -2,11 +2,17 @@
 
 #include <Util.h>
 #include <Config.h>
+#include <FrameConfig.h>
 
 #include "wrapped_swapchain.h"
 
 #include <hudfix/Hudfix_Dx12.h>
 #include <menu/menu_overlay_dx.h>
+#include <misc/GpuTimer_Dx12.h>
+#include <misc/DeferredRelease_Dx12.h>
+#include <misc/DescriptorRing_Dx12.h>
+#include <misc/TransientPool_Dx12.h>
+#include <misc/ShaderCache_Dx12.h>
 #include <framegen/ffx/FSRFG_Dx12.h>
 #include <resource_tracking/ResTrack_Dx12.h>
 
@@ -211,54 +217,26 @@ static HRESULT hkFGPresent(void* This, UINT SyncInterval, UINT Flags)
         _lastFrameTime = now;
         State::Instance().lastFrameTime = ftDelta;
 
-        LOG_DEBUG("_frameCounter: {}, flags: {:X}, Frametime: {}", _frameCounter, Flags, ftDelta);
+        LOG_DEBUG_DEFERRED("_frameCounter: {}, flags: {:X}, Frametime: {}", _frameCounter, Flags, ftDelta);
     }
 
     IFGFeature_Dx12* fg = State::Instance().currentFG;
 
-    if (willPresent)
+    // Pass GPU time collection
+    if (willPresent && State::Instance().activeFgType == OptiFG)
     {
-        if (State::Instance().activeFgType == OptiFG && HooksDx::dx12UpscaleTrig &&
-            HooksDx::readbackBuffer != nullptr && HooksDx::queryHeap != nullptr &&
-            State::Instance().currentCommandQueue != nullptr)
-        {
-            UINT64* timestampData;
-            HooksDx::readbackBuffer->Map(0, nullptr, reinterpret_cast<void**>(&timestampData));
-
-            if (timestampData != nullptr)
-            {
-                // Get the GPU timestamp frequency (ticks per second)
-                UINT64 gpuFrequency;
-                State::Instance().currentCommandQueue->GetTimestampFrequency(&gpuFrequency);
-
-                // Calculate elapsed time in milliseconds
-                UINT64 startTime = timestampData[0];
-                UINT64 endTime = timestampData[1];
-                double elapsedTimeMs = (endTime - startTime) / static_cast<double>(gpuFrequency) * 1000.0;
-
-                // filter out posibly wrong measured high values
-                if (elapsedTimeMs < 100.0)
-                {
-                    State::Instance().frameTimeMutex.lock();
-                    State::Instance().upscaleTimes.push_back(elapsedTimeMs);
-                    State::Instance().upscaleTimes.pop_front();
-                    State::Instance().frameTimeMutex.unlock();
-                }
-            }
-            else
-            {
-                LOG_WARN("timestampData is null!");
-            }
-
-            // Unmap the buffer
-            HooksDx::readbackBuffer->Unmap(0, nullptr);
-            HooksDx::dx12UpscaleTrig = false;
-        }
+        GpuTimer_Dx12::EndFrame(State::Instance().currentCommandQueue);
+        DeferredRelease_Dx12::EndFrame(State::Instance().currentCommandQueue);
+        DeferredRelease_Dx12::Collect();
+        DescriptorRing_Dx12::EndFrame();
+        TransientPool_Dx12::EndFrame();
+        ResTrack_Dx12::EndFrame();
+        ShaderCache_Dx12::EndFrame();
     }
 
     bool mutexUsed = false;
-    if (willPresent && fg != nullptr && fg->IsActive() &&
-        Config::Instance()->FGUseMutexForSwapchain.value_or_default() && fg->Mutex.getOwner() != 2)
+    if (willPresent && fg != nullptr && fg->IsActive() && FrameConfig::Get()->FGUseMutexForSwapchain &&
+        fg->Mutex.getOwner() != 2)
     {
         LOG_TRACE("Waiting FG->Mutex 2, current: {}", fg->Mutex.getOwner());
         fg->Mutex.lock(2);
@@ -294,7 +272,7 @@ static HRESULT hkFGPresent(void* This, UINT SyncInterval, UINT Flags)
 
     HRESULT result;
     result = o_FGSCPresent(This, SyncInterval, Flags);
-    LOG_DEBUG("Result: {:X}", result);
+    LOG_DEBUG_DEFERRED("Result: {:X}", result);
 
     Hudfix_Dx12::PresentEnd();
 
@@ -308,7 +286,8 @@ static HRESULT hkFGPresent(void* This, UINT SyncInterval, UINT Flags)
 }
 
 static HRESULT hkPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Flags,
-                         const DXGI_PRESENT_PARAMETERS* pPresentParameters, IUnknown* pDevice, HWND hWnd, bool isUWP)
+                         const DXGI_PRESENT_PARAMETERS* pPresentParameters, const SwapchainContext_Dx* pContext,
+                         HWND hWnd, bool isUWP)
 {
     if (State::Instance().isShuttingDown)
     {
@@ -318,7 +297,7 @@ static HRESULT hkPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Fla
             return ((IDXGISwapChain1*) pSwapChain)->Present1(SyncInterval, Flags, pPresentParameters);
     }
 
-    LOG_DEBUG("{}", _frameCounter);
+    LOG_DEBUG_DEFERRED("{}", _frameCounter);
 
     HRESULT presentResult;
 
@@ -335,15 +314,15 @@ static HRESULT hkPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Fla
 
         _lastFrameTime = now;
         State::Instance().lastFrameTime = ftDelta;
-        LOG_DEBUG("Frametime: {:0.3f} ms", ftDelta);
+        LOG_DEBUG_DEFERRED("Frametime: {:0.3f} ms", ftDelta);
     }
 
-    ID3D11Device* device = nullptr;
-    ID3D12Device* device12 = nullptr;
-    ID3D12CommandQueue* cq = nullptr;
+    // Resolved by the swapchain when it was created, owned by its context
+    ID3D11Device* device = pContext->device11;
+    ID3D12Device* device12 = pContext->device12;
+    ID3D12CommandQueue* cq = pContext->queue;
 
-    // try to obtain directx objects and find the path
-    if (pDevice->QueryInterface(IID_PPV_ARGS(&device)) == S_OK)
+    if (device != nullptr)
     {
         if (!_dx11Device)
             LOG_DEBUG("D3D11Device captured");
@@ -400,7 +379,7 @@ static HRESULT hkPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Fla
                 dxgiDevice->Release();
         }
     }
-    else if (pDevice->QueryInterface(IID_PPV_ARGS(&cq)) == S_OK)
+    else if (cq != nullptr)
     {
         if (!_dx12Device)
             LOG_DEBUG("D3D12CommandQueue captured");
@@ -408,7 +387,7 @@ static HRESULT hkPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Fla
         State::Instance().swapchainApi = DX12;
         State::Instance().currentCommandQueue = cq;
 
-        if (cq->GetDevice(IID_PPV_ARGS(&device12)) == S_OK)
+        if (device12 != nullptr)
         {
             if (!_dx12Device)
                 LOG_DEBUG("D3D12Device captured");
@@ -429,41 +408,16 @@ static HRESULT hkPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Fla
         ReflexHooks::update(false, false);
 
     // Upscaler GPU time computation
-    if (State::Instance().activeFgType != OptiFG && HooksDx::dx12UpscaleTrig && HooksDx::readbackBuffer != nullptr &&
-        HooksDx::queryHeap != nullptr && cq != nullptr)
+    if (State::Instance().activeFgType != OptiFG && cq != nullptr)
     {
-        UINT64* timestampData;
-        HooksDx::readbackBuffer->Map(0, nullptr, reinterpret_cast<void**>(&timestampData));
-
-        if (timestampData != nullptr)
-        {
-            // Get the GPU timestamp frequency (ticks per second)
-            UINT64 gpuFrequency;
-            cq->GetTimestampFrequency(&gpuFrequency);
-
-            // Calculate elapsed time in milliseconds
-            UINT64 startTime = timestampData[0];
-            UINT64 endTime = timestampData[1];
-            double elapsedTimeMs = (endTime - startTime) / static_cast<double>(gpuFrequency) * 1000.0;
-
-            // filter out posibly wrong measured high values
-            if (elapsedTimeMs < 100.0)
-            {
-                State::Instance().frameTimeMutex.lock();
-                State::Instance().upscaleTimes.push_back(elapsedTimeMs);
-                State::Instance().upscaleTimes.pop_front();
-                State::Instance().frameTimeMutex.unlock();
-            }
-        }
-        else
-        {
-            LOG_WARN("timestampData is null!");
-        }
-
-        // Unmap the buffer
-        HooksDx::readbackBuffer->Unmap(0, nullptr);
-
-        HooksDx::dx12UpscaleTrig = false;
+        // Results are collected a few frames later by the timestamp ring
+        GpuTimer_Dx12::EndFrame(cq);
+        DeferredRelease_Dx12::EndFrame(cq);
+        DeferredRelease_Dx12::Collect();
+        DescriptorRing_Dx12::EndFrame();
+        TransientPool_Dx12::EndFrame();
+        ResTrack_Dx12::EndFrame();
+        ShaderCache_Dx12::EndFrame();
     }
     else if (HooksDx::dx11UpscaleTrig[HooksDx::currentFrameIndex] && device != nullptr &&
              HooksDx::disjointQueries[0] != nullptr && HooksDx::startQueries[0] != nullptr &&
@@ -490,10 +444,7 @@ static HRESULT hkPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Fla
                     // filter out posibly wrong measured high values
                     if (elapsedTimeMs < 100.0)
                     {
-                        State::Instance().frameTimeMutex.lock();
-                        State::Instance().upscaleTimes.push_back(elapsedTimeMs);
-                        State::Instance().upscaleTimes.pop_front();
-                        State::Instance().frameTimeMutex.unlock();
+                        State::Instance().upscaleTimes.Push(elapsedTimeMs);
                     }
                 }
             }
@@ -506,15 +457,6 @@ static HRESULT hkPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Fla
     // DXVK check, it's here because of upscaler time calculations
     if (State::Instance().isRunningOnDXVK)
     {
-        if (cq != nullptr)
-            cq->Release();
-
-        if (device != nullptr)
-            device->Release();
-
-        if (device12 != nullptr)
-            device12->Release();
-
         if (pPresentParameters == nullptr)
             presentResult = pSwapChain->Present(SyncInterval, Flags);
         else
@@ -533,7 +475,7 @@ static HRESULT hkPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Fla
         currentFeature->TickFrozenCheck();
 
     // Draw overlay
-    MenuOverlayDx::Present(pSwapChain, SyncInterval, Flags, pPresentParameters, pDevice, hWnd, isUWP);
+    MenuOverlayDx::Present(pSwapChain, SyncInterval, Flags, pPresentParameters, pContext, hWnd, isUWP);
 
     if (State::Instance().activeFgType == OptiFG)
     {
@@ -548,22 +490,12 @@ static HRESULT hkPresent(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Fla
     else
         presentResult = ((IDXGISwapChain1*) pSwapChain)->Present1(SyncInterval, Flags, pPresentParameters);
 
-    // release used objects
-    if (cq != nullptr)
-        cq->Release();
-
-    if (device != nullptr)
-        device->Release();
-
-    if (device12 != nullptr)
-        device12->Release();
-
     if (presentResult == S_OK)
         LOG_TRACE("4 {}, Present result: {:X}", _frameCounter, (UINT) presentResult);
     else
         LOG_ERROR("4 {:X}", (UINT) presentResult);
 
-    LOG_DEBUG("Done");
+    LOG_DEBUG_DEFERRED("Done");
 
     return presentResult;
 }
@@ -687,7 +619,11 @@ static HRESULT hkCreateSwapChainForCoreWindow(IDXGIFactory2* pFactory, IUnknown*
                                        MenuOverlayDx::CleanupRenderTarget, HooksDx::ReleaseDx12SwapChain, true);
 
         if (!_skipFGSwapChainCreation)
+        {
             State::Instance().currentSwapchain = *ppSwapChain;
+            State::Instance().currentSwapchainContext = &((WrappedIDXGISwapChain4*) *ppSwapChain)->Context;
+            Hudfix_Dx12::RefreshCandidateFilter();
+        }
 
         LOG_DEBUG("Created new WrappedIDXGISwapChain4: {0:X}, pDevice: {1:X}", (UINT64) *ppSwapChain, (UINT64) pDevice);
 
@@ -930,6 +866,8 @@ static HRESULT hkCreateSwapChain(IDXGIFactory* pFactory, IUnknown* pDevice, DXGI
             }
 
             State::Instance().currentSwapchain = (*ppSwapChain);
+            State::Instance().currentSwapchainContext = nullptr;
+            Hudfix_Dx12::RefreshCandidateFilter();
 
             LOG_DEBUG("Created FSR-FG swapchain");
             return S_OK;
@@ -980,7 +918,11 @@ static HRESULT hkCreateSwapChain(IDXGIFactory* pFactory, IUnknown* pDevice, DXGI
                                        MenuOverlayDx::CleanupRenderTarget, HooksDx::ReleaseDx12SwapChain, false);
 
         if (!_skipFGSwapChainCreation)
+        {
             State::Instance().currentSwapchain = *ppSwapChain;
+            State::Instance().currentSwapchainContext = &((WrappedIDXGISwapChain4*) *ppSwapChain)->Context;
+            Hudfix_Dx12::RefreshCandidateFilter();
+        }
 
         LOG_DEBUG("Created new WrappedIDXGISwapChain4: {0:X}, pDevice: {1:X}", (UINT64) *ppSwapChain, (UINT64) pDevice);
 
@@ -1212,6 +1154,8 @@ static HRESULT hkCreateSwapChainForHwnd(IDXGIFactory* This, IUnknown* pDevice, H
             }
 
             State::Instance().currentSwapchain = (*ppSwapChain);
+            State::Instance().currentSwapchainContext = nullptr;
+            Hudfix_Dx12::RefreshCandidateFilter();
 
             LOG_DEBUG("Created FSR-FG swapchain");
             return S_OK;
@@ -1262,7 +1206,11 @@ static HRESULT hkCreateSwapChainForHwnd(IDXGIFactory* This, IUnknown* pDevice, H
         LOG_DEBUG("Created new WrappedIDXGISwapChain4: {0:X}, pDevice: {1:X}", (UINT64) *ppSwapChain, (UINT64) pDevice);
 
         if (!_skipFGSwapChainCreation)
+        {
             State::Instance().currentSwapchain = *ppSwapChain;
+            State::Instance().currentSwapchainContext = &((WrappedIDXGISwapChain4*) *ppSwapChain)->Context;
+            Hudfix_Dx12::RefreshCandidateFilter();
+        }
 
         if (Config::Instance()->ForceHDR.value_or_default())
         {
@@ -1847,7 +1795,11 @@ static HRESULT hkD3D11CreateDeviceAndSwapChain(IDXGIAdapter* pAdapter, D3D_DRIVE
                                        MenuOverlayDx::CleanupRenderTarget, HooksDx::ReleaseDx12SwapChain, false);
 
         if (!_skipFGSwapChainCreation)
+        {
             State::Instance().currentSwapchain = *ppSwapChain;
+            State::Instance().currentSwapchainContext = &((WrappedIDXGISwapChain4*) *ppSwapChain)->Context;
+            Hudfix_Dx12::RefreshCandidateFilter();
+        }
 
         LOG_DEBUG("Created new WrappedIDXGISwapChain4: {0:X}, pDevice: {1:X}", (UINT64) *ppSwapChain,
                   (UINT64) *ppDevice);
@@ -2597,6 +2549,7 @@ void HooksDx::HookDxgi()
 void HooksDx::ReleaseDx12SwapChain(HWND hwnd)
 {
     State::Instance().currentSwapchain = nullptr;
+    State::Instance().currentSwapchainContext = nullptr;
 
     IFGFeature_Dx12* fg = State::Instance().currentFG;
     if (fg == nullptr)
@@ -2616,7 +2569,7 @@ DXGI_FORMAT HooksDx::CurrentSwapchainFormat()
         return DXGI_FORMAT_UNKNOWN;
 
     DXGI_SWAP_CHAIN_DESC scDesc {};
-    if (State::Instance().currentSwapchain->GetDesc(&scDesc) != S_OK)
+    if (!SwapchainContext_Dx::CurrentDesc(&scDesc))
         return DXGI_FORMAT_UNKNOWN;
 
     return scDesc.BufferDesc.Format;
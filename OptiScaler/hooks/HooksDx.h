@@ -25,10 +25,6 @@
 
 namespace HooksDx
 {
-inline ID3D12QueryHeap* queryHeap = nullptr;
-inline ID3D12Resource* readbackBuffer = nullptr;
-inline bool dx12UpscaleTrig = false;
-
 inline const int QUERY_BUFFER_COUNT = 3;
 inline ID3D11Query* disjointQueries[QUERY_BUFFER_COUNT] = { nullptr, nullptr, nullptr };
 inline ID3D11Query* startQueries[QUERY_BUFFER_COUNT] = { nullptr, nullptr, nullptr };
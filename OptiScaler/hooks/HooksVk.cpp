@@ -230,10 +230,7 @@ static VkResult hkvkQueuePresentKHR(VkQueue queue, VkPresentInfoKHR* pPresentInf
 
         if (elapsedTimeMs > 0.0 && elapsedTimeMs < 5000.0)
         {
-            State::Instance().frameTimeMutex.lock();
-            State::Instance().upscaleTimes.push_back(elapsedTimeMs);
-            State::Instance().upscaleTimes.pop_front();
-            State::Instance().frameTimeMutex.unlock();
+            State::Instance().upscaleTimes.Push(elapsedTimeMs);
         }
 
         HooksVk::vkUpscaleTrig = false;
@@ -65,10 +65,12 @@ class KernelHooks
 
     inline static bool _overlayMethodsCalled = false;
 
-    inline static HMODULE LoadLibraryCheck(std::string lcaseLibName, LPCSTR lpLibFullPath)
+    inline static HMODULE LoadLibraryCheck(const std::string& lcaseLibName, LPCSTR lpLibFullPath)
     {
         LOG_TRACE("{}", lcaseLibName);
 
+        auto dllCategory = ClassifyDllName(lcaseLibName);
+
         // If Opti is not loading as nvngx.dll
         // if (!State::Instance().enablerAvailable && !State::Instance().isWorkingAsNvngx)
         //{
@@ -108,7 +110,7 @@ class KernelHooks
         }
 
         // NvApi64.dll
-        if (CheckDllName(&lcaseLibName, &nvapiNames))
+        if (dllCategory & DllCategory::Nvapi)
         {
             if (!State::Instance().enablerAvailable && Config::Instance()->OverrideNvapiDll.value_or_default())
             {
@@ -142,7 +144,7 @@ class KernelHooks
         }
 
         // sl.interposer.dll
-        if (CheckDllName(&lcaseLibName, &slInterposerNames))
+        if (dllCategory & DllCategory::SlInterposer)
         {
             auto streamlineModule = KernelBaseProxy::LoadLibraryExA_()(lpLibFullPath, NULL, 0);
 
@@ -159,7 +161,7 @@ class KernelHooks
         }
 
         // sl.dlss.dll
-        if (CheckDllName(&lcaseLibName, &slDlssNames))
+        if (dllCategory & DllCategory::SlDlss)
         {
             auto dlssModule = KernelBaseProxy::LoadLibraryExA_()(lpLibFullPath, NULL, 0);
 
@@ -176,7 +178,7 @@ class KernelHooks
         }
 
         // sl.dlss_g.dll
-        if (CheckDllName(&lcaseLibName, &slDlssgNames))
+        if (dllCategory & DllCategory::SlDlssg)
         {
             auto dlssgModule = KernelBaseProxy::LoadLibraryExA_()(lpLibFullPath, NULL, 0);
 
@@ -193,7 +195,7 @@ class KernelHooks
         }
 
         // sl.reflex.dll
-        if (CheckDllName(&lcaseLibName, &slReflexNames))
+        if (dllCategory & DllCategory::SlReflex)
         {
             auto reflexModule = KernelBaseProxy::LoadLibraryExA_()(lpLibFullPath, NULL, 0);
 
@@ -210,7 +212,7 @@ class KernelHooks
         }
 
         // sl.common.dll
-        if (CheckDllName(&lcaseLibName, &slCommonNames))
+        if (dllCategory & DllCategory::SlCommon)
         {
             auto commonModule = KernelBaseProxy::LoadLibraryExA_()(lpLibFullPath, NULL, 0);
 
@@ -228,7 +230,7 @@ class KernelHooks
 
         // nvngx_dlss
         if (Config::Instance()->DLSSEnabled.value_or_default() && Config::Instance()->NVNGX_DLSS_Library.has_value() &&
-            CheckDllName(&lcaseLibName, &nvngxDlssNames))
+            (dllCategory & DllCategory::NvngxDlss))
         {
             auto nvngxDlss = LoadNvngxDlss(string_to_wstring(lcaseLibName));
 
@@ -261,12 +263,12 @@ class KernelHooks
         }
 
         // Overlay
-        if (Config::Instance()->DisableOverlays.value_or_default() && CheckDllName(&lcaseLibName, &blockOverlayNames))
+        if (Config::Instance()->DisableOverlays.value_or_default() && (dllCategory & DllCategory::BlockOverlay))
         {
             LOG_DEBUG("Blocking overlay dll: {}", lcaseLibName);
             return (HMODULE) 1;
         }
-        else if (CheckDllName(&lcaseLibName, &overlayNames))
+        else if (dllCategory & DllCategory::Overlay)
         {
             LOG_DEBUG("Overlay dll: {}", lcaseLibName);
 
@@ -310,7 +312,7 @@ class KernelHooks
         }
 
         // Hooks
-        if (CheckDllName(&lcaseLibName, &dx11Names) && Config::Instance()->OverlayMenu.value_or_default())
+        if ((dllCategory & DllCategory::Dx11) && Config::Instance()->OverlayMenu.value_or_default())
         {
             auto module = KernelBaseProxy::LoadLibraryExA_()(lcaseLibName.c_str(), NULL, 0);
 
@@ -322,7 +324,7 @@ class KernelHooks
             return module;
         }
 
-        if (CheckDllName(&lcaseLibName, &dx12Names) && Config::Instance()->OverlayMenu.value_or_default())
+        if ((dllCategory & DllCategory::Dx12) && Config::Instance()->OverlayMenu.value_or_default())
         {
             auto module = KernelBaseProxy::LoadLibraryExA_()(lcaseLibName.c_str(), NULL, 0);
 
@@ -339,7 +341,7 @@ class KernelHooks
             return module;
         }
 
-        if (CheckDllName(&lcaseLibName, &vkNames))
+        if (dllCategory & DllCategory::Vulkan)
         {
             auto module = KernelBaseProxy::LoadLibraryExA_()(lcaseLibName.c_str(), NULL, 0);
 
@@ -362,7 +364,7 @@ class KernelHooks
             return module;
         }
 
-        if (!State::Instance().skipDxgiLoadChecks && CheckDllName(&lcaseLibName, &dxgiNames))
+        if (!State::Instance().skipDxgiLoadChecks && (dllCategory & DllCategory::Dxgi))
         {
             auto module = KernelBaseProxy::LoadLibraryExA_()(lcaseLibName.c_str(), NULL, LOAD_LIBRARY_SEARCH_SYSTEM32);
 
@@ -386,7 +388,7 @@ class KernelHooks
             return module;
         }
 
-        if (Config::Instance()->EnableFsr2Inputs.value_or_default() && CheckDllName(&lcaseLibName, &fsr2Names))
+        if (Config::Instance()->EnableFsr2Inputs.value_or_default() && (dllCategory & DllCategory::Fsr2))
         {
             auto module = KernelBaseProxy::LoadLibraryExA_()(lcaseLibName.c_str(), NULL, 0);
 
@@ -398,7 +400,7 @@ class KernelHooks
             return module;
         }
 
-        if (Config::Instance()->EnableFsr2Inputs.value_or_default() && CheckDllName(&lcaseLibName, &fsr2BENames))
+        if (Config::Instance()->EnableFsr2Inputs.value_or_default() && (dllCategory & DllCategory::Fsr2BE))
         {
             auto module = KernelBaseProxy::LoadLibraryExA_()(lcaseLibName.c_str(), NULL, 0);
 
@@ -410,7 +412,7 @@ class KernelHooks
             return module;
         }
 
-        if (Config::Instance()->EnableFsr3Inputs.value_or_default() && CheckDllName(&lcaseLibName, &fsr3Names))
+        if (Config::Instance()->EnableFsr3Inputs.value_or_default() && (dllCategory & DllCategory::Fsr3))
         {
             auto module = KernelBaseProxy::LoadLibraryExA_()(lcaseLibName.c_str(), NULL, 0);
 
@@ -420,7 +422,7 @@ class KernelHooks
             return module;
         }
 
-        if (Config::Instance()->EnableFsr3Inputs.value_or_default() && CheckDllName(&lcaseLibName, &fsr3BENames))
+        if (Config::Instance()->EnableFsr3Inputs.value_or_default() && (dllCategory & DllCategory::Fsr3BE))
         {
             auto module = KernelBaseProxy::LoadLibraryExA_()(lcaseLibName.c_str(), NULL, 0);
 
@@ -432,7 +434,7 @@ class KernelHooks
             return module;
         }
 
-        if (CheckDllName(&lcaseLibName, &xessNames))
+        if (dllCategory & DllCategory::Xess)
         {
             auto module = LoadLibxess(string_to_wstring(lcaseLibName));
 
@@ -444,7 +446,7 @@ class KernelHooks
             return module;
         }
 
-        if (CheckDllName(&lcaseLibName, &xessDx11Names))
+        if (dllCategory & DllCategory::XessDx11)
         {
             auto module = LoadLibxessDx11(
                 string_to_wstring(lcaseLibName)); // KernelBaseProxy::LoadLibraryExA_()(lcaseLibName.c_str(), NULL, 0);
@@ -457,7 +459,7 @@ class KernelHooks
             return module;
         }
 
-        if (CheckDllName(&lcaseLibName, &ffxDx12Names))
+        if (dllCategory & DllCategory::FfxDx12)
         {
             auto module = LoadFfxapiDx12(
                 string_to_wstring(lcaseLibName)); // KernelBaseProxy::LoadLibraryExA_()(lcaseLibName.c_str(), NULL, 0);
@@ -470,7 +472,7 @@ class KernelHooks
             return module;
         }
 
-        if (CheckDllName(&lcaseLibName, &ffxVkNames))
+        if (dllCategory & DllCategory::FfxVk)
         {
             auto module = LoadFfxapiVk(
                 string_to_wstring(lcaseLibName)); // KernelBaseProxy::LoadLibraryExA_()(lcaseLibName.c_str(), NULL, 0);
@@ -486,11 +488,13 @@ class KernelHooks
         return nullptr;
     }
 
-    inline static HMODULE LoadLibraryCheckW(std::wstring lcaseLibName, LPCWSTR lpLibFullPath)
+    inline static HMODULE LoadLibraryCheckW(const std::wstring& lcaseLibName, LPCWSTR lpLibFullPath)
     {
         auto lcaseLibNameA = wstring_to_string(lcaseLibName);
         LOG_TRACE("{}", lcaseLibNameA);
 
+        auto dllCategory = ClassifyDllName(lcaseLibName);
+
         // If Opti is not loading as nvngx.dll
         // if (!State::Instance().enablerAvailable && !State::Instance().isWorkingAsNvngx)
         //{
@@ -534,7 +538,7 @@ class KernelHooks
 
         // nvngx_dlss
         if (Config::Instance()->DLSSEnabled.value_or_default() && Config::Instance()->NVNGX_DLSS_Library.has_value() &&
-            CheckDllNameW(&lcaseLibName, &nvngxDlssNamesW))
+            (dllCategory & DllCategory::NvngxDlss))
         {
             auto nvngxDlss = LoadNvngxDlss(lcaseLibName);
 
@@ -567,7 +571,7 @@ class KernelHooks
         }
 
         // NvApi64.dll
-        if (CheckDllNameW(&lcaseLibName, &nvapiNamesW))
+        if (dllCategory & DllCategory::Nvapi)
         {
             if (!State::Instance().enablerAvailable && Config::Instance()->OverrideNvapiDll.value_or_default())
             {
@@ -601,7 +605,7 @@ class KernelHooks
         }
 
         // sl.interposer.dll
-        if (CheckDllNameW(&lcaseLibName, &slInterposerNamesW))
+        if (dllCategory & DllCategory::SlInterposer)
         {
             auto streamlineModule = KernelBaseProxy::LoadLibraryExW_()(lpLibFullPath, NULL, 0);
 
@@ -620,7 +624,7 @@ class KernelHooks
         // sl.dlss.dll
         // Try to catch something like this:
         // C:\ProgramData/NVIDIA/NGX/models/sl_dlss_0/versions/133120/files/190_E658703.dll
-        if (CheckDllNameW(&lcaseLibName, &slDlssNamesW) ||
+        if ((dllCategory & DllCategory::SlDlss) ||
             (lcaseLibName.contains(L"/versions/") && lcaseLibName.contains(L"/sl_dlss_")))
         {
             auto dlssModule = KernelBaseProxy::LoadLibraryExW_()(lpLibFullPath, NULL, 0);
@@ -638,7 +642,7 @@ class KernelHooks
         }
 
         // sl.dlss_g.dll
-        if (CheckDllNameW(&lcaseLibName, &slDlssgNamesW) ||
+        if ((dllCategory & DllCategory::SlDlssg) ||
             (lcaseLibName.contains(L"/versions/") && lcaseLibName.contains(L"/sl_dlss_g_")))
         {
             auto dlssgModule = KernelBaseProxy::LoadLibraryExW_()(lpLibFullPath, NULL, 0);
@@ -656,7 +660,7 @@ class KernelHooks
         }
 
         // sl.reflex.dll
-        if (CheckDllNameW(&lcaseLibName, &slReflexNamesW) ||
+        if ((dllCategory & DllCategory::SlReflex) ||
             (lcaseLibName.contains(L"/versions/") && lcaseLibName.contains(L"/sl_reflex_")))
         {
             auto reflexModule = KernelBaseProxy::LoadLibraryExW_()(lpLibFullPath, NULL, 0);
@@ -674,7 +678,7 @@ class KernelHooks
         }
 
         // sl.common.dll
-        if (CheckDllNameW(&lcaseLibName, &slCommonNamesW) ||
+        if ((dllCategory & DllCategory::SlCommon) ||
             (lcaseLibName.contains(L"/versions/") && lcaseLibName.contains(L"/sl_common_")))
         {
             auto commonModule = KernelBaseProxy::LoadLibraryExW_()(lpLibFullPath, NULL, 0);
@@ -691,12 +695,12 @@ class KernelHooks
             return commonModule;
         }
 
-        if (Config::Instance()->DisableOverlays.value_or_default() && CheckDllNameW(&lcaseLibName, &blockOverlayNamesW))
+        if (Config::Instance()->DisableOverlays.value_or_default() && (dllCategory & DllCategory::BlockOverlay))
         {
             LOG_DEBUG("Blocking overlay dll: {}", wstring_to_string(lcaseLibName));
             return (HMODULE) 1;
         }
-        else if (CheckDllNameW(&lcaseLibName, &overlayNamesW))
+        else if (dllCategory & DllCategory::Overlay)
         {
             LOG_DEBUG("Overlay dll: {}", wstring_to_string(lcaseLibName));
 
@@ -749,7 +753,7 @@ class KernelHooks
         }
 
         // Hooks
-        if (CheckDllNameW(&lcaseLibName, &dx11NamesW) && Config::Instance()->OverlayMenu.value_or_default())
+        if ((dllCategory & DllCategory::Dx11) && Config::Instance()->OverlayMenu.value_or_default())
         {
             auto module = KernelBaseProxy::LoadLibraryExW_()(lcaseLibName.c_str(), NULL, 0);
 
@@ -759,7 +763,7 @@ class KernelHooks
             return module;
         }
 
-        if (CheckDllNameW(&lcaseLibName, &dx12NamesW) && Config::Instance()->OverlayMenu.value_or_default())
+        if ((dllCategory & DllCategory::Dx12) && Config::Instance()->OverlayMenu.value_or_default())
         {
             auto module = KernelBaseProxy::LoadLibraryExW_()(lcaseLibName.c_str(), NULL, 0);
 
@@ -772,7 +776,7 @@ class KernelHooks
             return module;
         }
 
-        if (CheckDllNameW(&lcaseLibName, &vkNamesW))
+        if (dllCategory & DllCategory::Vulkan)
         {
             auto module = KernelBaseProxy::LoadLibraryExW_()(lcaseLibName.c_str(), NULL, 0);
 
@@ -791,7 +795,7 @@ class KernelHooks
             return module;
         }
 
-        if (!State::Instance().skipDxgiLoadChecks && CheckDllNameW(&lcaseLibName, &dxgiNamesW))
+        if (!State::Instance().skipDxgiLoadChecks && (dllCategory & DllCategory::Dxgi))
         {
             auto module = KernelBaseProxy::LoadLibraryExW_()(lcaseLibName.c_str(), NULL, LOAD_LIBRARY_SEARCH_SYSTEM32);
 
@@ -809,7 +813,7 @@ class KernelHooks
             }
         }
 
-        if (CheckDllNameW(&lcaseLibName, &fsr2NamesW))
+        if (dllCategory & DllCategory::Fsr2)
         {
             auto module = KernelBaseProxy::LoadLibraryExW_()(lcaseLibName.c_str(), NULL, 0);
 
@@ -819,7 +823,7 @@ class KernelHooks
             return module;
         }
 
-        if (CheckDllNameW(&lcaseLibName, &fsr2BENamesW))
+        if (dllCategory & DllCategory::Fsr2BE)
         {
             auto module = KernelBaseProxy::LoadLibraryExW_()(lcaseLibName.c_str(), NULL, 0);
 
@@ -829,7 +833,7 @@ class KernelHooks
             return module;
         }
 
-        if (CheckDllNameW(&lcaseLibName, &fsr3NamesW))
+        if (dllCategory & DllCategory::Fsr3)
         {
             auto module = KernelBaseProxy::LoadLibraryExW_()(lcaseLibName.c_str(), NULL, 0);
 
@@ -839,7 +843,7 @@ class KernelHooks
             return module;
         }
 
-        if (CheckDllNameW(&lcaseLibName, &fsr3BENamesW))
+        if (dllCategory & DllCategory::Fsr3BE)
         {
             auto module = KernelBaseProxy::LoadLibraryExW_()(lcaseLibName.c_str(), NULL, 0);
 
@@ -849,7 +853,7 @@ class KernelHooks
             return module;
         }
 
-        if (CheckDllNameW(&lcaseLibName, &xessNamesW))
+        if (dllCategory & DllCategory::Xess)
         {
             auto module =
                 LoadLibxess(lcaseLibName); // KernelBaseProxy::LoadLibraryExW_()(lcaseLibName.c_str(), NULL, 0);
@@ -860,7 +864,7 @@ class KernelHooks
             return module;
         }
 
-        if (CheckDllNameW(&lcaseLibName, &xessDx11NamesW))
+        if (dllCategory & DllCategory::XessDx11)
         {
             auto module =
                 LoadLibxessDx11(lcaseLibName); // KernelBaseProxy::LoadLibraryExA_()(lcaseLibName.c_str(), NULL, 0);
@@ -873,7 +877,7 @@ class KernelHooks
             return module;
         }
 
-        if (CheckDllNameW(&lcaseLibName, &ffxDx12NamesW))
+        if (dllCategory & DllCategory::FfxDx12)
         {
             auto module =
                 LoadFfxapiDx12(lcaseLibName); // KernelBaseProxy::LoadLibraryExW_()(lcaseLibName.c_str(), NULL, 0);
@@ -884,7 +888,7 @@ class KernelHooks
             return module;
         }
 
-        if (CheckDllNameW(&lcaseLibName, &ffxVkNamesW))
+        if (dllCategory & DllCategory::FfxVk)
         {
             auto module =
                 LoadFfxapiVk(lcaseLibName); // KernelBaseProxy::LoadLibraryExW_()(lcaseLibName.c_str(), NULL, 0);
@@ -35,12 +35,11 @@ class NtdllHooks
 
     inline static bool _overlayMethodsCalled = false;
 
-    inline static HMODULE LoadLibraryCheckW(std::wstring lcaseLibName)
+    inline static HMODULE LoadLibraryCheckW(const std::wstring& lcaseLibName)
     {
-        auto lcaseLibNameA = wstring_to_string(lcaseLibName);
-
         // If Opti is not loading as nvngx.dll
-        if (!State::Instance().enablerAvailable && !State::Instance().isWorkingAsNvngx)
+        if (!State::Instance().enablerAvailable && !State::Instance().isWorkingAsNvngx &&
+            (ClassifyDllName(lcaseLibName) & DllCategory::Nvngx))
         {
             // exe path
             auto exePath = Util::ExePath().parent_path().wstring();
@@ -50,10 +49,10 @@ class NtdllHooks
 
             auto pos = lcaseLibName.rfind(exePath);
 
-            if (Config::Instance()->EnableDlssInputs.value_or_default() && CheckDllNameW(&lcaseLibName, &nvngxNamesW) &&
+            if (Config::Instance()->EnableDlssInputs.value_or_default() &&
                 (!Config::Instance()->HookOriginalNvngxOnly.value_or_default() || pos == std::string::npos))
             {
-                LOG_INFO("nvngx call: {0}, returning this dll!", lcaseLibNameA);
+                LOG_INFO("nvngx call: {0}, returning this dll!", wstring_to_string(lcaseLibName));
 
                 return dllModule;
             }
@@ -0,0 +1,99 @@
+#include "SwapchainContext_Dx.h"
+
+#include <hudfix/Hudfix_Dx12.h>
+
+void SwapchainContext_Dx::Init(IDXGISwapChain* swapchain, IUnknown* pDevice)
+{
+    Release();
+
+    if (pDevice != nullptr)
+    {
+        if (pDevice->QueryInterface(IID_PPV_ARGS(&device11)) == S_OK)
+        {
+            api = DX11;
+        }
+        else if (pDevice->QueryInterface(IID_PPV_ARGS(&queue)) == S_OK)
+        {
+            api = DX12;
+
+            if (queue->GetDevice(IID_PPV_ARGS(&device12)) != S_OK)
+            {
+                LOG_WARN("Can't get device of queue: {:X}", (size_t) queue);
+                device12 = nullptr;
+            }
+        }
+        else
+        {
+            LOG_WARN("Unknown swapchain device: {:X}", (size_t) pDevice);
+        }
+    }
+
+    Refresh(swapchain);
+}
+
+void SwapchainContext_Dx::Refresh(IDXGISwapChain* swapchain)
+{
+    Description description {};
+    description.valid = swapchain != nullptr && swapchain->GetDesc(&description.desc) == S_OK;
+
+    if (!description.valid)
+    {
+        LOG_WARN("Can't get swapchain desc!");
+        _desc.Store({});
+        return;
+    }
+
+    _desc.Store(description);
+
+    // Hudfix compares candidates against the back buffers of the current swapchain
+    if (State::Instance().currentSwapchainContext == this)
+        Hudfix_Dx12::RefreshCandidateFilter();
+
+    auto& desc = description.desc;
+    LOG_DEBUG("BufferCount: {}, Width: {}, Height: {}, Format: {}", desc.BufferCount, desc.BufferDesc.Width,
+              desc.BufferDesc.Height, (UINT) desc.BufferDesc.Format);
+}
+
+void SwapchainContext_Dx::Release()
+{
+    if (device11 != nullptr)
+    {
+        device11->Release();
+        device11 = nullptr;
+    }
+
+    if (device12 != nullptr)
+    {
+        device12->Release();
+        device12 = nullptr;
+    }
+
+    if (queue != nullptr)
+    {
+        queue->Release();
+        queue = nullptr;
+    }
+
+    api = NotSelected;
+    _desc.Store({});
+}
+
+bool SwapchainContext_Dx::Desc(DXGI_SWAP_CHAIN_DESC* pDesc) const
+{
+    auto description = _desc.Load();
+
+    if (!description.valid)
+        return false;
+
+    *pDesc = description.desc;
+    return true;
+}
+
+bool SwapchainContext_Dx::CurrentDesc(DXGI_SWAP_CHAIN_DESC* pDesc)
+{
+    if (auto context = State::Instance().currentSwapchainContext; context != nullptr && context->Desc(pDesc))
+        return true;
+
+    auto swapchain = State::Instance().currentSwapchain;
+    return swapchain != nullptr && swapchain->GetDesc(pDesc) == S_OK;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <pch.h>
+#include <State.h>
+
+#include <misc/SeqLock.h>
+
+#include <d3d11.h>
+#include <d3d12.h>
+#include <dxgi1_6.h>
+
+// Device objects and description of one DXGI swapchain.
+//
+// The wrapped swapchain builds it when it's created and refreshes the description after resizes
+// and fullscreen changes, present hooks and the passes which compare resources against the back
+// buffers read these fields instead of querying the device and calling GetDesc on every call.
+// Device objects are referenced until Release, the swapchain keeps them alive anyway. The description
+// is rewritten by ResizeBuffers/SetFullscreenState while hooks on other threads read it, it's published
+// through a SeqLock and readers get a copy.
+struct SwapchainContext_Dx
+{
+    API api = NotSelected;
+
+    // Streamline proxies are already resolved by the swapchain creation hooks
+    ID3D11Device* device11 = nullptr;
+    ID3D12CommandQueue* queue = nullptr;
+    ID3D12Device* device12 = nullptr;
+
+    // pDevice is the object the swapchain was created with, a D3D11 device or a D3D12 command queue
+    void Init(IDXGISwapChain* swapchain, IUnknown* pDevice);
+
+    // Called after anything which can change the buffers or the window state
+    void Refresh(IDXGISwapChain* swapchain);
+
+    void Release();
+
+    // Copy of the last description, false when GetDesc failed
+    bool Desc(DXGI_SWAP_CHAIN_DESC* pDesc) const;
+
+    // Description of State::currentSwapchain, from its context when it's one of our wrapped swapchains
+    static bool CurrentDesc(DXGI_SWAP_CHAIN_DESC* pDesc);
+
+  private:
+    struct Description
+    {
+        DXGI_SWAP_CHAIN_DESC desc {};
+        bool valid = false;
+    };
+
+    SeqLock<Description> _desc;
+};
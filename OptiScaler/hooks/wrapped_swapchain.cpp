@@ -41,6 +41,7 @@ WrappedIDXGISwapChain4::WrappedIDXGISwapChain4(IDXGISwapChain* real, IUnknown* p
     auto refCount = m_pReal->Release();
 
     Device2 = Device;
+    Context.Init(m_pReal, Device);
 
     LOG_INFO("{} created, real: {:X}, refCount: {}", id, (UINT64) real, refCount);
 }
@@ -166,6 +167,7 @@ ULONG STDMETHODCALLTYPE WrappedIDXGISwapChain4::Release()
         if (ReleaseTrig != nullptr)
             ReleaseTrig(Handle);
 
+        Context.Release();
         auto refCount = m_pReal->Release();
 
         delete this;
@@ -215,7 +217,7 @@ HRESULT STDMETHODCALLTYPE WrappedIDXGISwapChain4::Present(UINT SyncInterval, UIN
 
     if (!(Flags & DXGI_PRESENT_TEST || Flags & DXGI_PRESENT_RESTART) && RenderTrig != nullptr)
     {
-        result = RenderTrig(m_pReal, SyncInterval, Flags, nullptr, Device, Handle, UWP);
+        result = RenderTrig(m_pReal, SyncInterval, Flags, nullptr, &Context, Handle, UWP);
 
         // When Reflex can't be used to limit, sleep in present
         if (!State::Instance().reflexLimitsFps)
@@ -275,6 +277,8 @@ HRESULT STDMETHODCALLTYPE WrappedIDXGISwapChain4::SetFullscreenState(BOOL Fullsc
             LOG_ERROR("result: {:X}", (UINT) result);
         else
             LOG_DEBUG("result: {:X}", result);
+
+        Context.Refresh(m_pReal);
     }
 
     if (ffxLock)
@@ -398,6 +402,8 @@ HRESULT STDMETHODCALLTYPE WrappedIDXGISwapChain4::ResizeBuffers(UINT BufferCount
         } while (false);
     }
 
+    Context.Refresh(m_pReal);
+
     State::Instance().SCbuffers.clear();
     UINT bc = BufferCount;
     if (bc == 0 && m_pReal1 != nullptr)
@@ -432,7 +438,12 @@ HRESULT STDMETHODCALLTYPE WrappedIDXGISwapChain4::ResizeBuffers(UINT BufferCount
 
 HRESULT STDMETHODCALLTYPE WrappedIDXGISwapChain4::ResizeTarget(const DXGI_MODE_DESC* pNewTargetParameters)
 {
-    return m_pReal->ResizeTarget(pNewTargetParameters);
+    auto result = m_pReal->ResizeTarget(pNewTargetParameters);
+
+    if (result == S_OK)
+        Context.Refresh(m_pReal);
+
+    return result;
 }
 
 HRESULT STDMETHODCALLTYPE WrappedIDXGISwapChain4::GetContainingOutput(IDXGIOutput** ppOutput)
@@ -481,7 +492,7 @@ HRESULT STDMETHODCALLTYPE WrappedIDXGISwapChain4::Present1(UINT SyncInterval, UI
     HRESULT result;
 
     if (!(Flags & DXGI_PRESENT_TEST || Flags & DXGI_PRESENT_RESTART) && RenderTrig != nullptr)
-        result = RenderTrig(m_pReal1, SyncInterval, Flags, pPresentParameters, Device, Handle, UWP);
+        result = RenderTrig(m_pReal1, SyncInterval, Flags, pPresentParameters, &Context, Handle, UWP);
     else
         result = m_pReal1->Present1(SyncInterval, Flags, pPresentParameters);
 
@@ -680,6 +691,8 @@ HRESULT STDMETHODCALLTYPE WrappedIDXGISwapChain4::ResizeBuffers1(UINT BufferCoun
         } while (false);
     }
 
+    Context.Refresh(m_pReal);
+
     State::Instance().SCbuffers.clear();
     UINT bc = BufferCount;
     if (bc == 0 && m_pReal1 != nullptr)
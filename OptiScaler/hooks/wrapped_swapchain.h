@@ -4,12 +4,15 @@
 #include <OwnedMutex.h>
 #include <Config.h>
 
+#include "SwapchainContext_Dx.h"
+
 #include "dxgi1_6.h"
 #include "d3d12.h"
 
 #define USE_LOCAL_MUTEX
 
-typedef HRESULT (*PFN_SC_Present)(IDXGISwapChain*, UINT, UINT, const DXGI_PRESENT_PARAMETERS*, IUnknown*, HWND, bool);
+typedef HRESULT (*PFN_SC_Present)(IDXGISwapChain*, UINT, UINT, const DXGI_PRESENT_PARAMETERS*,
+                                  const SwapchainContext_Dx*, HWND, bool);
 typedef void (*PFN_SC_Clean)(bool, HWND);
 typedef void (*PFN_SC_Release)(HWND);
 
@@ -86,6 +89,7 @@ struct DECLSPEC_UUID("3af622a3-82d0-49cd-994f-cce05122c222") WrappedIDXGISwapCha
 
     IUnknown* Device = nullptr;
     IUnknown* Device2 = nullptr;
+    SwapchainContext_Dx Context;
 
     IDXGISwapChain1* m_pReal1 = nullptr;
     IDXGISwapChain2* m_pReal2 = nullptr;
@@ -3,8 +3,13 @@
 #include <Util.h>
 #include <State.h>
 #include <Config.h>
+#include <FrameConfig.h>
 
 #include <framegen/IFGFeature_Dx12.h>
+#include <hooks/SwapchainContext_Dx.h>
+#include <misc/BarrierBatch_Dx12.h>
+#include <misc/DeferredRelease_Dx12.h>
+#include <misc/GpuTimer_Dx12.h>
 
 bool Hudfix_Dx12::CreateObjects()
 {
@@ -88,7 +93,7 @@ bool Hudfix_Dx12::CreateBufferResource(ID3D12Device* InDevice, ResourceInfo* InS
         if (bufDesc.Width != (UINT64) (InSource->width) || bufDesc.Height != (UINT) (InSource->height) ||
             bufDesc.Format != InSource->format)
         {
-            (*OutResource)->Release();
+            DeferredRelease_Dx12::Release(*OutResource, "Hudless copy");
             (*OutResource) = nullptr;
             LOG_WARN("Release {}x{}, new one: {}x{}", bufDesc.Width, bufDesc.Height, InSource->width, InSource->height);
         }
@@ -137,7 +142,7 @@ bool Hudfix_Dx12::CreateBufferResourceWithSize(ID3D12Device* InDevice, ResourceI
 
         if (bufDesc.Width != (UINT64) InWidth || bufDesc.Height != InHeight || bufDesc.Format != InSource->format)
         {
-            (*OutResource)->Release();
+            DeferredRelease_Dx12::Release(*OutResource, "Hudless copy");
             (*OutResource) = nullptr;
             LOG_WARN("Release {}x{}, new one: {}x{}", bufDesc.Width, bufDesc.Height, InWidth, InHeight);
         }
@@ -176,18 +181,6 @@ bool Hudfix_Dx12::CreateBufferResourceWithSize(ID3D12Device* InDevice, ResourceI
     return true;
 }
 
-void Hudfix_Dx12::ResourceBarrier(ID3D12GraphicsCommandList* InCommandList, ID3D12Resource* InResource,
-                                  D3D12_RESOURCE_STATES InBeforeState, D3D12_RESOURCE_STATES InAfterState)
-{
-    D3D12_RESOURCE_BARRIER barrier = {};
-    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    barrier.Transition.pResource = InResource;
-    barrier.Transition.StateBefore = InBeforeState;
-    barrier.Transition.StateAfter = InAfterState;
-    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-    InCommandList->ResourceBarrier(1, &barrier);
-}
-
 bool Hudfix_Dx12::CheckCapture()
 {
     auto fIndex = GetIndex();
@@ -214,6 +207,57 @@ bool Hudfix_Dx12::CheckCapture()
     return true;
 }
 
+void Hudfix_Dx12::RefreshCandidateFilter()
+{
+    HudlessFilter filter {};
+
+    DXGI_SWAP_CHAIN_DESC scDesc {};
+    if (SwapchainContext_Dx::CurrentDesc(&scDesc))
+    {
+        filter.width = scDesc.BufferDesc.Width;
+        filter.height = scDesc.BufferDesc.Height;
+        filter.format = scDesc.BufferDesc.Format;
+        filter.relaxedResolution = Config::Instance()->FGRelaxedResolutionCheck.value_or_default();
+        filter.extended = Config::Instance()->FGHUDFixExtended.value_or_default();
+        filter.convertibleTarget = IsConvertibleFormat(scDesc.BufferDesc.Format);
+        filter.valid = true;
+    }
+    else
+    {
+        LOG_WARN("Can't get swapchain desc!");
+    }
+
+    _candidateFilter.store(HudlessFilter::Pack(filter), std::memory_order_release);
+}
+
+bool Hudfix_Dx12::IsConvertibleFormat(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+    case DXGI_FORMAT_R10G10B10A2_UNORM:
+    case DXGI_FORMAT_R10G10B10A2_TYPELESS:
+    case DXGI_FORMAT_R16G16B16A16_FLOAT:
+    case DXGI_FORMAT_R16G16B16A16_TYPELESS:
+    case DXGI_FORMAT_R11G11B10_FLOAT:
+    case DXGI_FORMAT_R32G32B32A32_FLOAT:
+    case DXGI_FORMAT_R32G32B32A32_TYPELESS:
+    case DXGI_FORMAT_R32G32B32_FLOAT:
+    case DXGI_FORMAT_R32G32B32_TYPELESS:
+    case DXGI_FORMAT_R8G8B8A8_TYPELESS:
+    case DXGI_FORMAT_R8G8B8A8_UNORM:
+    case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+    case DXGI_FORMAT_B8G8R8A8_TYPELESS:
+    case DXGI_FORMAT_B8G8R8A8_UNORM:
+    case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+// Called for every candidate from draw/dispatch hooks, must stay cheap.
+// Only uses values cached in ResourceInfo and the per frame filter, no locks or allocations.
 bool Hudfix_Dx12::CheckResource(ResourceInfo* resource)
 {
     if (resource == nullptr || resource->buffer == nullptr || State::Instance().isShuttingDown)
@@ -225,97 +269,39 @@ bool Hudfix_Dx12::CheckResource(ResourceInfo* resource)
         return true;
     }
 
-    DXGI_SWAP_CHAIN_DESC scDesc {};
-    if (State::Instance().currentSwapchain->GetDesc(&scDesc) != S_OK)
-    {
-        LOG_WARN("Can't get swapchain desc!");
-        return false;
-    }
-
-    // There are all these chacks because looks like ResTracker is still missing some resources
-    // Need check more docs about D3D12 resource/heap usage
+    auto filter = HudlessFilter::Unpack(_candidateFilter.load(std::memory_order_acquire));
 
-    // Compare aganist stored info first
-    if (resource->width == 0 || resource->height == 0 || resource->buffer == nullptr)
+    if (!filter.valid)
         return false;
 
-    // Get resource info
-    auto resDesc = resource->buffer->GetDesc();
+    // Resource tracker fills these from resource desc
+    if (resource->width == 0 || resource->height == 0)
+        return false;
 
-    // dimensions not match
-    if (resDesc.Height != scDesc.BufferDesc.Height || resDesc.Width != scDesc.BufferDesc.Width)
-    {
-        // Extended size check
-        if (!(Config::Instance()->FGRelaxedResolutionCheck.value_or_default() &&
-              resDesc.Height >= scDesc.BufferDesc.Height - 32 && resDesc.Height <= scDesc.BufferDesc.Height + 32 &&
-              resDesc.Width >= scDesc.BufferDesc.Width - 32 && resDesc.Width <= scDesc.BufferDesc.Width + 32))
-        {
-            return false;
-        }
+    bool sizeExtended = false;
+    if (!filter.MatchesSize(resource->width, resource->height, &sizeExtended))
+        return false;
 
+    if (sizeExtended)
         resource->extended = true;
-    }
 
     // check for resource flags
-    if ((resDesc.Flags & (D3D12_RESOURCE_FLAG_RAYTRACING_ACCELERATION_STRUCTURE |
-                          D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL | D3D12_RESOURCE_FLAG_VIDEO_DECODE_REFERENCE_ONLY |
-                          D3D12_RESOURCE_FLAG_DENY_SHADER_RESOURCE | D3D12_RESOURCE_FLAG_VIDEO_ENCODE_REFERENCE_ONLY)) >
-        0)
+    if ((resource->flags &
+         (D3D12_RESOURCE_FLAG_RAYTRACING_ACCELERATION_STRUCTURE | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL |
+          D3D12_RESOURCE_FLAG_VIDEO_DECODE_REFERENCE_ONLY | D3D12_RESOURCE_FLAG_DENY_SHADER_RESOURCE |
+          D3D12_RESOURCE_FLAG_VIDEO_ENCODE_REFERENCE_ONLY)) > 0)
     {
         return false;
     }
 
-    // format match
-    if (resDesc.Format == scDesc.BufferDesc.Format)
-    {
-        LOG_DEBUG("Width: {}/{}, Height: {}/{}, Format: {}/{}, Resource: {:X}, convertFormat: {} -> TRUE",
-                  resDesc.Width, scDesc.BufferDesc.Width, resDesc.Height, scDesc.BufferDesc.Height,
-                  (UINT) resDesc.Format, (UINT) scDesc.BufferDesc.Format, (size_t) resource->buffer,
-                  Config::Instance()->FGHUDFixExtended.value_or_default());
-
-        return true;
-    }
-
-    // extended not active
-    if (!Config::Instance()->FGHUDFixExtended.value_or_default())
-    {
+    if (!filter.MatchesFormat(resource->format, IsConvertibleFormat(resource->format)))
         return false;
-    }
 
-    // resource and target formats are supported by converter
-    if ((resDesc.Format == DXGI_FORMAT_R10G10B10A2_UNORM || resDesc.Format == DXGI_FORMAT_R10G10B10A2_TYPELESS ||
-         resDesc.Format == DXGI_FORMAT_R16G16B16A16_FLOAT || resDesc.Format == DXGI_FORMAT_R16G16B16A16_TYPELESS ||
-         resDesc.Format == DXGI_FORMAT_R11G11B10_FLOAT || resDesc.Format == DXGI_FORMAT_R32G32B32A32_FLOAT ||
-         resDesc.Format == DXGI_FORMAT_R32G32B32A32_TYPELESS || resDesc.Format == DXGI_FORMAT_R32G32B32_FLOAT ||
-         resDesc.Format == DXGI_FORMAT_R32G32B32_TYPELESS || resDesc.Format == DXGI_FORMAT_R8G8B8A8_TYPELESS ||
-         resDesc.Format == DXGI_FORMAT_R8G8B8A8_UNORM || resDesc.Format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB ||
-         resDesc.Format == DXGI_FORMAT_B8G8R8A8_TYPELESS || resDesc.Format == DXGI_FORMAT_B8G8R8A8_UNORM ||
-         resDesc.Format == DXGI_FORMAT_B8G8R8A8_UNORM_SRGB) &&
-        (scDesc.BufferDesc.Format == DXGI_FORMAT_R10G10B10A2_UNORM ||
-         scDesc.BufferDesc.Format == DXGI_FORMAT_R10G10B10A2_TYPELESS ||
-         scDesc.BufferDesc.Format == DXGI_FORMAT_R16G16B16A16_FLOAT ||
-         scDesc.BufferDesc.Format == DXGI_FORMAT_R16G16B16A16_TYPELESS ||
-         scDesc.BufferDesc.Format == DXGI_FORMAT_R11G11B10_FLOAT ||
-         scDesc.BufferDesc.Format == DXGI_FORMAT_R32G32B32A32_FLOAT ||
-         scDesc.BufferDesc.Format == DXGI_FORMAT_R32G32B32A32_TYPELESS ||
-         scDesc.BufferDesc.Format == DXGI_FORMAT_R32G32B32_FLOAT ||
-         scDesc.BufferDesc.Format == DXGI_FORMAT_R32G32B32_TYPELESS ||
-         scDesc.BufferDesc.Format == DXGI_FORMAT_R8G8B8A8_TYPELESS ||
-         scDesc.BufferDesc.Format == DXGI_FORMAT_R8G8B8A8_UNORM ||
-         scDesc.BufferDesc.Format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB ||
-         scDesc.BufferDesc.Format == DXGI_FORMAT_B8G8R8A8_TYPELESS ||
-         scDesc.BufferDesc.Format == DXGI_FORMAT_B8G8R8A8_UNORM ||
-         scDesc.BufferDesc.Format == DXGI_FORMAT_B8G8R8A8_UNORM_SRGB))
-    {
-        LOG_DEBUG("Width: {}/{}, Height: {}/{}, Format: {}/{}, Resource: {:X}, convertFormat: {} -> TRUE",
-                  resDesc.Width, scDesc.BufferDesc.Width, resDesc.Height, scDesc.BufferDesc.Height,
-                  (UINT) resDesc.Format, (UINT) scDesc.BufferDesc.Format, (size_t) resource->buffer,
-                  Config::Instance()->FGHUDFixExtended.value_or_default());
+    LOG_DEBUG("Width: {}/{}, Height: {}/{}, Format: {}/{}, Resource: {:X}, convertFormat: {} -> TRUE",
+              resource->width, filter.width, resource->height, filter.height, (UINT) resource->format,
+              (UINT) filter.format, (size_t) resource->buffer, filter.extended);
 
-        return true;
-    }
-
-    return false;
+    return true;
 }
 
 int Hudfix_Dx12::GetIndex() { return _upscaleCounter % BUFFER_COUNT; }
@@ -381,6 +367,8 @@ void Hudfix_Dx12::UpscaleStart()
     if (State::Instance().ClearCapturedHudlesses)
     {
         State::Instance().ClearCapturedHudlesses = false;
+
+        std::lock_guard<std::mutex> lock(State::Instance().CapturedHudlessesMutex);
         State::Instance().CapturedHudlesses.clear();
     }
 }
@@ -395,6 +383,8 @@ void Hudfix_Dx12::UpscaleEnd(UINT64 frameId, float lastFrameTime)
     // Get new index and clear resources
     auto index = GetIndex();
     _captureCounter[index] = 0;
+
+    RefreshCandidateFilter();
 }
 
 void Hudfix_Dx12::PresentStart() { return; }
@@ -413,7 +403,8 @@ bool Hudfix_Dx12::IsResourceCheckActive()
     if (_upscaleCounter <= _fgCounter)
         return false;
 
-    if (!Config::Instance()->FGEnabled.value_or_default() || !Config::Instance()->FGHUDFix.value_or_default())
+    auto frameConfig = FrameConfig::Get();
+    if (!frameConfig->FGEnabled || !frameConfig->FGHUDFix)
         return false;
 
     if (State::Instance().currentFeature == nullptr || State::Instance().currentFG == nullptr)
@@ -431,8 +422,8 @@ bool Hudfix_Dx12::IsResourceCheckActive()
 
 bool Hudfix_Dx12::SkipHudlessChecks() { return _skipHudlessChecks; }
 
-bool Hudfix_Dx12::CheckForHudless(std::string callerName, ID3D12GraphicsCommandList* cmdList, ResourceInfo* resource,
-                                  D3D12_RESOURCE_STATES state, bool ignoreBlocked)
+bool Hudfix_Dx12::CheckForHudless(std::string_view callerName, ID3D12GraphicsCommandList* cmdList,
+                                  ResourceInfo* resource, D3D12_RESOURCE_STATES state, bool ignoreBlocked)
 {
     if (State::Instance().currentFG == nullptr)
         return false;
@@ -445,8 +436,21 @@ bool Hudfix_Dx12::CheckForHudless(std::string callerName, ID3D12GraphicsCommandL
         if (!CheckResource(resource))
             break;
 
-        CapturedHudlessInfo* capturedHudlessInfo = &State::Instance().CapturedHudlesses[resource->buffer];
-        if (capturedHudlessInfo != nullptr && !capturedHudlessInfo->enabled)
+        // Disabled entries are skipped before waiting for _checkMutex. Only captured resources are added to
+        // the list, lookup must not create entries. Entry can be erased by the release hook at any time,
+        // don't keep a pointer to it.
+        bool capturedDisabled = false;
+        {
+            std::lock_guard<std::mutex> capturedLock(State::Instance().CapturedHudlessesMutex);
+
+            if (auto it = State::Instance().CapturedHudlesses.find(resource->buffer);
+                it != State::Instance().CapturedHudlesses.end())
+            {
+                capturedDisabled = !it->second.enabled;
+            }
+        }
+
+        if (capturedDisabled)
         {
             LOG_DEBUG("Skipping {:X}, disabled from captured hudless list!", (size_t) resource->buffer);
             break;
@@ -555,7 +559,7 @@ bool Hudfix_Dx12::CheckForHudless(std::string callerName, ID3D12GraphicsCommandL
         auto fIndex = GetIndex();
 
         DXGI_SWAP_CHAIN_DESC scDesc {};
-        if (State::Instance().currentSwapchain->GetDesc(&scDesc) != S_OK)
+        if (!SwapchainContext_Dx::CurrentDesc(&scDesc))
         {
             LOG_WARN("Can't get swapchain desc!");
             _captureCounter[fIndex]--;
@@ -571,6 +575,9 @@ bool Hudfix_Dx12::CheckForHudless(std::string callerName, ID3D12GraphicsCommandL
             return false;
         }
 
+        // Resource goes back to the game's state together with the format transfer barriers
+        BarrierBatch_Dx12 barriers(cmdList);
+
         // Make a copy of resource to capture current state
         if (!resource->extended)
         {
@@ -581,13 +588,19 @@ bool Hudfix_Dx12::CheckForHudless(std::string callerName, ID3D12GraphicsCommandL
 
                 // Using state D3D12_RESOURCE_STATE_VIDEO_ENCODE_WRITE as skip flag
                 if (state != D3D12_RESOURCE_STATE_VIDEO_ENCODE_WRITE)
-                    ResourceBarrier(cmdList, resource->buffer, state, D3D12_RESOURCE_STATE_COPY_SOURCE);
+                {
+                    barriers.Require(resource->buffer, state, D3D12_RESOURCE_STATE_COPY_SOURCE);
+                    barriers.Flush();
+                }
 
-                cmdList->CopyResource(_captureBuffer[fIndex], resource->buffer);
+                {
+                    GpuTimer_Dx12::Scope timer(cmdList, GpuPass::HudfixCopy);
+                    cmdList->CopyResource(_captureBuffer[fIndex], resource->buffer);
+                }
 
                 // Using state D3D12_RESOURCE_STATE_VIDEO_ENCODE_WRITE as skip flag
                 if (state != D3D12_RESOURCE_STATE_VIDEO_ENCODE_WRITE)
-                    ResourceBarrier(cmdList, resource->buffer, D3D12_RESOURCE_STATE_COPY_SOURCE, state);
+                    barriers.Require(resource->buffer, D3D12_RESOURCE_STATE_COPY_SOURCE, state);
 
                 LOG_DEBUG("Copy created");
             }
@@ -601,7 +614,7 @@ bool Hudfix_Dx12::CheckForHudless(std::string callerName, ID3D12GraphicsCommandL
         else
         {
             DXGI_SWAP_CHAIN_DESC scDesc {};
-            if (State::Instance().currentSwapchain->GetDesc(&scDesc) != S_OK)
+            if (!SwapchainContext_Dx::CurrentDesc(&scDesc))
             {
                 LOG_WARN("Can't get swapchain desc!");
                 break;
@@ -615,7 +628,10 @@ bool Hudfix_Dx12::CheckForHudless(std::string callerName, ID3D12GraphicsCommandL
 
                 // Using state D3D12_RESOURCE_STATE_VIDEO_ENCODE_WRITE as skip flag
                 if (state != D3D12_RESOURCE_STATE_VIDEO_ENCODE_WRITE)
-                    ResourceBarrier(cmdList, resource->buffer, state, D3D12_RESOURCE_STATE_COPY_SOURCE);
+                {
+                    barriers.Require(resource->buffer, state, D3D12_RESOURCE_STATE_COPY_SOURCE);
+                    barriers.Flush();
+                }
 
                 D3D12_TEXTURE_COPY_LOCATION srcLocation;
                 ZeroMemory(&srcLocation, sizeof(srcLocation));
@@ -654,7 +670,7 @@ bool Hudfix_Dx12::CheckForHudless(std::string callerName, ID3D12GraphicsCommandL
 
                 // Using state D3D12_RESOURCE_STATE_VIDEO_ENCODE_WRITE as skip flag
                 if (state != D3D12_RESOURCE_STATE_VIDEO_ENCODE_WRITE)
-                    ResourceBarrier(cmdList, resource->buffer, D3D12_RESOURCE_STATE_COPY_SOURCE, state);
+                    barriers.Require(resource->buffer, D3D12_RESOURCE_STATE_COPY_SOURCE, state);
 
                 LOG_DEBUG("Copy created");
             }
@@ -692,12 +708,14 @@ bool Hudfix_Dx12::CheckForHudless(std::string callerName, ID3D12GraphicsCommandL
                 // Will reset after FG dispatch
                 _skipHudlessChecks = true;
 
-                ResourceBarrier(cmdList, _captureBuffer[fIndex], D3D12_RESOURCE_STATE_COPY_DEST,
-                                D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+                barriers.Require(_captureBuffer[fIndex], D3D12_RESOURCE_STATE_COPY_DEST,
+                                 D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+                barriers.Flush();
                 _formatTransfer[fIndex]->Dispatch(State::Instance().currentD3D12Device, cmdList, _captureBuffer[fIndex],
                                                   _formatTransfer[fIndex]->Buffer());
-                ResourceBarrier(cmdList, _captureBuffer[fIndex], D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE,
-                                D3D12_RESOURCE_STATE_COPY_DEST);
+                barriers.Require(_captureBuffer[fIndex], D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE,
+                                 D3D12_RESOURCE_STATE_COPY_DEST);
+                barriers.Finish();
 
                 LOG_TRACE("Using _formatTransfer->Buffer()");
 
@@ -720,6 +738,8 @@ bool Hudfix_Dx12::CheckForHudless(std::string callerName, ID3D12GraphicsCommandL
             // Will reset after FG dispatch
             _skipHudlessChecks = true;
             LOG_DEBUG("Using _captureBuffer");
+            barriers.Finish();
+
             auto fg = reinterpret_cast<IFGFeature_Dx12*>(State::Instance().currentFG);
 
             if (fg != nullptr)
@@ -740,10 +760,19 @@ bool Hudfix_Dx12::CheckForHudless(std::string callerName, ID3D12GraphicsCommandL
         _skipHudlessChecks = true;
         HudlessFound(cmdList);
 
-        if (capturedHudlessInfo != nullptr)
-            capturedHudlessInfo->usageCount++;
-        else
-            State::Instance().CapturedHudlesses[resource->buffer] = {};
+        {
+            std::lock_guard<std::mutex> capturedLock(State::Instance().CapturedHudlessesMutex);
+
+            if (auto it = State::Instance().CapturedHudlesses.find(resource->buffer);
+                it != State::Instance().CapturedHudlesses.end())
+            {
+                it->second.usageCount++;
+            }
+            else
+            {
+                State::Instance().CapturedHudlesses[resource->buffer] = {};
+            }
+        }
 
         return true;
 
@@ -769,5 +798,7 @@ void Hudfix_Dx12::ResetCounters()
     _captureCounter[2] = 0;
     _captureCounter[3] = 0;
 
+    RefreshCandidateFilter();
+
     LOG_DEBUG("_hudlessList: {}", _hudlessList.size());
 }
@@ -3,9 +3,13 @@
 
 #include <shaders/format_transfer/FT_Dx12.h>
 
+#include "HudlessFilter.h"
+
 #include <ankerl/unordered_dense.h>
 
 #include <set>
+#include <atomic>
+#include <string_view>
 #include <dxgi.h>
 #include <d3d12.h>
 #include <shared_mutex>
@@ -45,6 +49,10 @@ typedef struct HudlessInfo
 class Hudfix_Dx12
 {
   private:
+    // Packed HudlessFilter, refreshed once per frame in UpscaleEnd and when the swapchain changes.
+    // Single atomic so draw/dispatch hooks get a consistent copy without locking.
+    inline static std::atomic<uint64_t> _candidateFilter = 0;
+
     // Last upscaled frame
     inline static UINT64 _upscaleCounter = 0;
 
@@ -85,12 +93,13 @@ class Hudfix_Dx12
     static bool CreateBufferResourceWithSize(ID3D12Device* InDevice, ResourceInfo* InSource,
                                              D3D12_RESOURCE_STATES InState, ID3D12Resource** OutResource, UINT InWidth,
                                              UINT InHeight);
-    static void ResourceBarrier(ID3D12GraphicsCommandList* InCommandList, ID3D12Resource* InResource,
-                                D3D12_RESOURCE_STATES InBeforeState, D3D12_RESOURCE_STATES InAfterState);
 
     // Check _captureCounter for current frame
     static bool CheckCapture();
 
+    // Formats supported by format transfer
+    static bool IsConvertibleFormat(DXGI_FORMAT format);
+
     static void HudlessFound(ID3D12GraphicsCommandList* cmdList);
 
     static int GetIndex();
@@ -121,10 +130,13 @@ class Hudfix_Dx12
     static bool SkipHudlessChecks();
 
     // Check resource for hudless
-    static bool CheckForHudless(std::string callerName, ID3D12GraphicsCommandList* cmdList, ResourceInfo* resource,
-                                D3D12_RESOURCE_STATES state, bool ignoreBlocked = false);
+    static bool CheckForHudless(std::string_view callerName, ID3D12GraphicsCommandList* cmdList,
+                                ResourceInfo* resource, D3D12_RESOURCE_STATES state, bool ignoreBlocked = false);
     static bool CheckResource(ResourceInfo* resource);
 
     // Reset frame counters
     static void ResetCounters();
+
+    // Rebuilds the candidate filter from the current swapchain, after it's resized or recreated
+    static void RefreshCandidateFilter();
 };
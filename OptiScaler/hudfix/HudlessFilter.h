@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+
+// Swapchain properties and options which are needed to reject hudless candidates, api independent.
+//
+// Packs into one 64 bit word, Hudfix keeps it in a single atomic so draw/dispatch hooks on any
+// thread get a consistent copy without locking. Formats are DXGI_FORMAT values.
+struct HudlessFilter
+{
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t format = 0;
+    bool valid = false;
+    bool relaxedResolution = false;
+    bool extended = false;
+    bool convertibleTarget = false;
+
+    // Relaxed resolution check accepts this much difference on each axis
+    static constexpr int64_t RelaxedMargin = 32;
+
+    // Invalid filter packs to 0
+    static uint64_t Pack(const HudlessFilter& filter)
+    {
+        if (!filter.valid)
+            return 0;
+
+        // width: 0-23, height: 24-47, format: 48-55, flags: 56-59
+        return ((uint64_t) (filter.width & 0xFFFFFF)) | ((uint64_t) (filter.height & 0xFFFFFF) << 24) |
+               ((uint64_t) (filter.format & 0xFF) << 48) | (1ull << 56) |
+               ((uint64_t) filter.relaxedResolution << 57) | ((uint64_t) filter.extended << 58) |
+               ((uint64_t) filter.convertibleTarget << 59);
+    }
+
+    static HudlessFilter Unpack(uint64_t packed)
+    {
+        HudlessFilter filter {};
+        filter.width = (uint32_t) (packed & 0xFFFFFF);
+        filter.height = (uint32_t) ((packed >> 24) & 0xFFFFFF);
+        filter.format = (uint32_t) ((packed >> 48) & 0xFF);
+        filter.valid = (packed & (1ull << 56)) != 0;
+        filter.relaxedResolution = (packed & (1ull << 57)) != 0;
+        filter.extended = (packed & (1ull << 58)) != 0;
+        filter.convertibleTarget = (packed & (1ull << 59)) != 0;
+        return filter;
+    }
+
+    // Exact size, or within RelaxedMargin when relaxed resolution is enabled. Sets sizeExtended when
+    // the size only matched with the margin.
+    bool MatchesSize(uint32_t candidateWidth, uint32_t candidateHeight, bool* sizeExtended) const
+    {
+        if (candidateWidth == width && candidateHeight == height)
+            return true;
+
+        if (!relaxedResolution || (int64_t) candidateHeight < (int64_t) height - RelaxedMargin ||
+            candidateHeight > height + RelaxedMargin || (int64_t) candidateWidth < (int64_t) width - RelaxedMargin ||
+            candidateWidth > width + RelaxedMargin)
+        {
+            return false;
+        }
+
+        *sizeExtended = true;
+        return true;
+    }
+
+    // Same format, or both formats can be converted when extended checks are enabled
+    bool MatchesFormat(uint32_t candidateFormat, bool candidateConvertible) const
+    {
+        if (candidateFormat == format)
+            return true;
+
+        return extended && convertibleTarget && candidateConvertible;
+    }
+};
@@ -5,6 +5,8 @@
 #include "resource.h"
 #include "NVNGX_Parameter.h"
 
+#include <misc/ContextRegistry.h>
+
 #include <proxies/KernelBase_Proxy.h>
 
 #include "scanner/scanner.h"
@@ -109,9 +111,17 @@ static PFN_ffxFsr2GetRenderResolutionFromQualityMode o_ffxFsr2GetRenderResolutio
 static PFN_ffxGetResourceFromDX12Resource_Dx12 o_ffxGetResourceFromDX12Resource_Dx12 = nullptr;
 static PFN_ffxFsr2GetInterfaceDX12 o_ffxFsr2GetInterfaceDX12 = nullptr;
 
-static std::map<Fsr212::FfxFsr2Context*, Fsr212::FfxFsr2ContextDescription> _initParams;
-static std::map<Fsr212::FfxFsr2Context*, NVSDK_NGX_Parameter*> _nvParams;
-static std::map<Fsr212::FfxFsr2Context*, NVSDK_NGX_Handle*> _contexts;
+struct Fsr2InputContext
+{
+    Fsr212::FfxFsr2ContextDescription initParams {};
+    NVSDK_NGX_Parameter* nvParams = nullptr;
+    NVNGX_Parameters* optiParams = nullptr;
+
+    // Created on first dispatch
+    NVSDK_NGX_Handle* nvHandle = nullptr;
+};
+
+static ContextRegistry<Fsr212::FfxFsr2Context*, Fsr2InputContext> _contexts;
 static ID3D12Device* _d3d12Device = nullptr;
 static bool _nvnxgInited = false;
 static bool _skipCreate = false;
@@ -119,16 +129,16 @@ static bool _skipDispatch = false;
 static bool _skipDestroy = false;
 static float qualityRatios[] = { 1.0, 1.5, 1.7, 2.0, 3.0 };
 
-static bool CreateDLSSContext(Fsr212::FfxFsr2Context* handle, const Fsr212::FfxFsr2DispatchDescription* pExecParams)
+static bool CreateDLSSContext(Fsr2InputContext* record, const Fsr212::FfxFsr2DispatchDescription* pExecParams)
 {
     LOG_DEBUG("");
 
-    if (!_nvParams.contains(handle))
+    if (record->nvParams == nullptr)
         return false;
 
     NVSDK_NGX_Handle* nvHandle = nullptr;
-    auto params = _nvParams[handle];
-    auto initParams = &_initParams[handle];
+    auto params = record->nvParams;
+    auto initParams = &record->initParams;
     auto commandList = (ID3D12GraphicsCommandList*) pExecParams->commandList;
 
     UINT initFlags = 0;
@@ -174,21 +184,21 @@ static bool CreateDLSSContext(Fsr212::FfxFsr2Context* handle, const Fsr212::FfxF
         NVSDK_NGX_Result_Success)
         return false;
 
-    _contexts[handle] = nvHandle;
+    record->nvHandle = nvHandle;
 
     return true;
 }
 
-static bool CreateDLSSContext20(Fsr212::FfxFsr2Context* handle, const FfxFsr20DispatchDescription* pExecParams)
+static bool CreateDLSSContext20(Fsr2InputContext* record, const FfxFsr20DispatchDescription* pExecParams)
 {
     LOG_DEBUG("");
 
-    if (!_nvParams.contains(handle))
+    if (record->nvParams == nullptr)
         return false;
 
     NVSDK_NGX_Handle* nvHandle = nullptr;
-    auto params = _nvParams[handle];
-    auto initParams = &_initParams[handle];
+    auto params = record->nvParams;
+    auto initParams = &record->initParams;
     auto commandList = (ID3D12GraphicsCommandList*) pExecParams->commandList;
 
     UINT initFlags = 0;
@@ -234,22 +244,22 @@ static bool CreateDLSSContext20(Fsr212::FfxFsr2Context* handle, const FfxFsr20Di
         NVSDK_NGX_Result_Success)
         return false;
 
-    _contexts[handle] = nvHandle;
+    record->nvHandle = nvHandle;
 
     return true;
 }
 
 // Tiny Tina's Wonderland
-static bool CreateDLSSContextTiny(Fsr212::FfxFsr2Context* handle, const FfxFsr2TinyDispatchDescription* pExecParams)
+static bool CreateDLSSContextTiny(Fsr2InputContext* record, const FfxFsr2TinyDispatchDescription* pExecParams)
 {
     LOG_DEBUG("");
 
-    if (!_nvParams.contains(handle))
+    if (record->nvParams == nullptr)
         return false;
 
     NVSDK_NGX_Handle* nvHandle = nullptr;
-    auto params = _nvParams[handle];
-    auto initParams = &_initParams[handle];
+    auto params = record->nvParams;
+    auto initParams = &record->initParams;
     auto commandList = (ID3D12GraphicsCommandList*) pExecParams->commandList;
 
     UINT initFlags = 0;
@@ -295,7 +305,7 @@ static bool CreateDLSSContextTiny(Fsr212::FfxFsr2Context* handle, const FfxFsr2T
         NVSDK_NGX_Result_Success)
         return false;
 
-    _contexts[handle] = nvHandle;
+    record->nvHandle = nvHandle;
 
     return true;
 }
@@ -449,13 +459,15 @@ static Fsr212::FfxErrorCode ffxFsr2ContextCreate_Dx12(Fsr212::FfxFsr2Context* co
     if (NVSDK_NGX_D3D12_GetCapabilityParameters(&params) != NVSDK_NGX_Result_Success)
         return Fsr212::FFX_ERROR_BACKEND_API_ERROR;
 
-    _nvParams[context] = params;
+    auto& record = _contexts.Add(context);
+    record.nvParams = params;
+    record.optiParams = GetOptiParameters(params);
 
     Fsr212::FfxFsr2ContextDescription ccd {};
     ccd.flags = contextDescription->flags;
     ccd.maxRenderSize = contextDescription->maxRenderSize;
     ccd.displaySize = contextDescription->displaySize;
-    _initParams[context] = ccd;
+    record.initParams = ccd;
 
     LOG_INFO("context created: {:X}", (size_t) context);
 
@@ -558,13 +570,15 @@ static Fsr212::FfxErrorCode ffxFsr2ContextCreate_Pattern_Dx12(Fsr212::FfxFsr2Con
     if (NVSDK_NGX_D3D12_GetCapabilityParameters(&params) != NVSDK_NGX_Result_Success)
         return Fsr212::FFX_ERROR_BACKEND_API_ERROR;
 
-    _nvParams[context] = params;
+    auto& record = _contexts.Add(context);
+    record.nvParams = params;
+    record.optiParams = GetOptiParameters(params);
 
     Fsr212::FfxFsr2ContextDescription ccd {};
     ccd.flags = contextDescription->flags;
     ccd.maxRenderSize = contextDescription->maxRenderSize;
     ccd.displaySize = contextDescription->displaySize;
-    _initParams[context] = ccd;
+    record.initParams = ccd;
 
     LOG_INFO("context created: {:X}", (size_t) context);
 
@@ -600,38 +614,42 @@ static Fsr212::FfxErrorCode ffxFsr2ContextDispatch_Dx12(Fsr212::FfxFsr2Context*
     if (dispatchDescription == nullptr || context == nullptr || dispatchDescription->commandList == nullptr)
         return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
 
-    // If not in contexts list create and add context
-    if (!_contexts.contains(context) && _initParams.contains(context) &&
-        !CreateDLSSContext(context, dispatchDescription))
+    auto record = _contexts.Find(context);
+
+    if (record == nullptr)
+        return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
+
+    // Create DLSS feature on first dispatch
+    if (record->nvHandle == nullptr && !CreateDLSSContext(record, dispatchDescription))
         return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
 
-    NVSDK_NGX_Parameter* params = _nvParams[context];
-    NVSDK_NGX_Handle* handle = _contexts[context];
-
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, dispatchDescription->jitterOffset.x);
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, dispatchDescription->jitterOffset.y);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_X, dispatchDescription->motionVectorScale.x);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, dispatchDescription->motionVectorScale.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, 1.0);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Pre_Exposure, dispatchDescription->preExposure);
-    params->Set(NVSDK_NGX_Parameter_Reset, dispatchDescription->reset ? 1 : 0);
-    params->Set(NVSDK_NGX_Parameter_Width, dispatchDescription->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_Height, dispatchDescription->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width, dispatchDescription->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height, dispatchDescription->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_Depth, dispatchDescription->depth.resource);
-    params->Set(NVSDK_NGX_Parameter_ExposureTexture, dispatchDescription->exposure.resource);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask, dispatchDescription->reactive.resource);
-    params->Set(NVSDK_NGX_Parameter_Color, dispatchDescription->color.resource);
-    params->Set(NVSDK_NGX_Parameter_MotionVectors, dispatchDescription->motionVectors.resource);
-    params->Set(NVSDK_NGX_Parameter_Output, dispatchDescription->output.resource);
-    params->Set("FSR.cameraNear", dispatchDescription->cameraNear);
-    params->Set("FSR.cameraFar", dispatchDescription->cameraFar);
-    params->Set("FSR.cameraFovAngleVertical", dispatchDescription->cameraFovAngleVertical);
-    params->Set("FSR.frameTimeDelta", dispatchDescription->frameTimeDelta);
-    params->Set("FSR.transparencyAndComposition", dispatchDescription->transparencyAndComposition.resource);
-    params->Set("FSR.reactive", dispatchDescription->reactive.resource);
-    params->Set(NVSDK_NGX_Parameter_Sharpness, dispatchDescription->sharpness);
+    NVNGX_ParameterWriter params { record->nvParams, record->optiParams };
+    NVSDK_NGX_Handle* handle = record->nvHandle;
+
+    params.Set<NVSDK_NGX_Parameter_Jitter_Offset_X>(dispatchDescription->jitterOffset.x);
+    params.Set<NVSDK_NGX_Parameter_Jitter_Offset_Y>(dispatchDescription->jitterOffset.y);
+    params.Set<NVSDK_NGX_Parameter_MV_Scale_X>(dispatchDescription->motionVectorScale.x);
+    params.Set<NVSDK_NGX_Parameter_MV_Scale_Y>(dispatchDescription->motionVectorScale.y);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Exposure_Scale>(1.0);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Pre_Exposure>(dispatchDescription->preExposure);
+    params.Set<NVSDK_NGX_Parameter_Reset>(dispatchDescription->reset ? 1 : 0);
+    params.Set<NVSDK_NGX_Parameter_Width>(dispatchDescription->renderSize.width);
+    params.Set<NVSDK_NGX_Parameter_Height>(dispatchDescription->renderSize.height);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width>(dispatchDescription->renderSize.width);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height>(dispatchDescription->renderSize.height);
+    params.Set<NVSDK_NGX_Parameter_Depth>(dispatchDescription->depth.resource);
+    params.Set<NVSDK_NGX_Parameter_ExposureTexture>(dispatchDescription->exposure.resource);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask>(dispatchDescription->reactive.resource);
+    params.Set<NVSDK_NGX_Parameter_Color>(dispatchDescription->color.resource);
+    params.Set<NVSDK_NGX_Parameter_MotionVectors>(dispatchDescription->motionVectors.resource);
+    params.Set<NVSDK_NGX_Parameter_Output>(dispatchDescription->output.resource);
+    params.Set<"FSR.cameraNear">(dispatchDescription->cameraNear);
+    params.Set<"FSR.cameraFar">(dispatchDescription->cameraFar);
+    params.Set<"FSR.cameraFovAngleVertical">(dispatchDescription->cameraFovAngleVertical);
+    params.Set<"FSR.frameTimeDelta">(dispatchDescription->frameTimeDelta);
+    params.Set<"FSR.transparencyAndComposition">(dispatchDescription->transparencyAndComposition.resource);
+    params.Set<"FSR.reactive">(dispatchDescription->reactive.resource);
+    params.Set<NVSDK_NGX_Parameter_Sharpness>(dispatchDescription->sharpness);
 
     LOG_DEBUG("handle: {:X}, internalResolution: {}x{}", handle->Id, dispatchDescription->renderSize.width,
               dispatchDescription->renderSize.height);
@@ -639,7 +657,7 @@ static Fsr212::FfxErrorCode ffxFsr2ContextDispatch_Dx12(Fsr212::FfxFsr2Context*
     State::Instance().setInputApiName = "FSR2.X-DX12";
 
     auto evalResult = NVSDK_NGX_D3D12_EvaluateFeature((ID3D12GraphicsCommandList*) dispatchDescription->commandList,
-                                                      handle, params, nullptr);
+                                                      handle, record->nvParams, nullptr);
 
     if (evalResult == NVSDK_NGX_Result_Success)
         return Fsr212::FFX_OK;
@@ -664,38 +682,42 @@ ffxFsr2ContextDispatch_Pattern_Dx12(Fsr212::FfxFsr2Context* context,
     if (dispatchDescription == nullptr || context == nullptr || dispatchDescription->commandList == nullptr)
         return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
 
-    // If not in contexts list create and add context
-    if (!_contexts.contains(context) && _initParams.contains(context) &&
-        !CreateDLSSContext(context, dispatchDescription))
+    auto record = _contexts.Find(context);
+
+    if (record == nullptr)
+        return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
+
+    // Create DLSS feature on first dispatch
+    if (record->nvHandle == nullptr && !CreateDLSSContext(record, dispatchDescription))
         return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
 
-    NVSDK_NGX_Parameter* params = _nvParams[context];
-    NVSDK_NGX_Handle* handle = _contexts[context];
-
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, dispatchDescription->jitterOffset.x);
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, dispatchDescription->jitterOffset.y);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_X, dispatchDescription->motionVectorScale.x);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, dispatchDescription->motionVectorScale.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, 1.0);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Pre_Exposure, dispatchDescription->preExposure);
-    params->Set(NVSDK_NGX_Parameter_Reset, dispatchDescription->reset ? 1 : 0);
-    params->Set(NVSDK_NGX_Parameter_Width, dispatchDescription->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_Height, dispatchDescription->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width, dispatchDescription->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height, dispatchDescription->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_Depth, dispatchDescription->depth.resource);
-    params->Set(NVSDK_NGX_Parameter_ExposureTexture, dispatchDescription->exposure.resource);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask, dispatchDescription->reactive.resource);
-    params->Set(NVSDK_NGX_Parameter_Color, dispatchDescription->color.resource);
-    params->Set(NVSDK_NGX_Parameter_MotionVectors, dispatchDescription->motionVectors.resource);
-    params->Set(NVSDK_NGX_Parameter_Output, dispatchDescription->output.resource);
-    params->Set("FSR.cameraNear", dispatchDescription->cameraNear);
-    params->Set("FSR.cameraFar", dispatchDescription->cameraFar);
-    params->Set("FSR.cameraFovAngleVertical", dispatchDescription->cameraFovAngleVertical);
-    params->Set("FSR.frameTimeDelta", dispatchDescription->frameTimeDelta);
-    params->Set("FSR.transparencyAndComposition", dispatchDescription->transparencyAndComposition.resource);
-    params->Set("FSR.reactive", dispatchDescription->reactive.resource);
-    params->Set(NVSDK_NGX_Parameter_Sharpness, dispatchDescription->sharpness);
+    NVNGX_ParameterWriter params { record->nvParams, record->optiParams };
+    NVSDK_NGX_Handle* handle = record->nvHandle;
+
+    params.Set<NVSDK_NGX_Parameter_Jitter_Offset_X>(dispatchDescription->jitterOffset.x);
+    params.Set<NVSDK_NGX_Parameter_Jitter_Offset_Y>(dispatchDescription->jitterOffset.y);
+    params.Set<NVSDK_NGX_Parameter_MV_Scale_X>(dispatchDescription->motionVectorScale.x);
+    params.Set<NVSDK_NGX_Parameter_MV_Scale_Y>(dispatchDescription->motionVectorScale.y);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Exposure_Scale>(1.0);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Pre_Exposure>(dispatchDescription->preExposure);
+    params.Set<NVSDK_NGX_Parameter_Reset>(dispatchDescription->reset ? 1 : 0);
+    params.Set<NVSDK_NGX_Parameter_Width>(dispatchDescription->renderSize.width);
+    params.Set<NVSDK_NGX_Parameter_Height>(dispatchDescription->renderSize.height);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width>(dispatchDescription->renderSize.width);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height>(dispatchDescription->renderSize.height);
+    params.Set<NVSDK_NGX_Parameter_Depth>(dispatchDescription->depth.resource);
+    params.Set<NVSDK_NGX_Parameter_ExposureTexture>(dispatchDescription->exposure.resource);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask>(dispatchDescription->reactive.resource);
+    params.Set<NVSDK_NGX_Parameter_Color>(dispatchDescription->color.resource);
+    params.Set<NVSDK_NGX_Parameter_MotionVectors>(dispatchDescription->motionVectors.resource);
+    params.Set<NVSDK_NGX_Parameter_Output>(dispatchDescription->output.resource);
+    params.Set<"FSR.cameraNear">(dispatchDescription->cameraNear);
+    params.Set<"FSR.cameraFar">(dispatchDescription->cameraFar);
+    params.Set<"FSR.cameraFovAngleVertical">(dispatchDescription->cameraFovAngleVertical);
+    params.Set<"FSR.frameTimeDelta">(dispatchDescription->frameTimeDelta);
+    params.Set<"FSR.transparencyAndComposition">(dispatchDescription->transparencyAndComposition.resource);
+    params.Set<"FSR.reactive">(dispatchDescription->reactive.resource);
+    params.Set<NVSDK_NGX_Parameter_Sharpness>(dispatchDescription->sharpness);
 
     LOG_DEBUG("handle: {:X}, internalResolution: {}x{}", handle->Id, dispatchDescription->renderSize.width,
               dispatchDescription->renderSize.height);
@@ -703,7 +725,7 @@ ffxFsr2ContextDispatch_Pattern_Dx12(Fsr212::FfxFsr2Context* context,
     State::Instance().setInputApiName = "FSR2.X-DX12";
 
     auto evalResult = NVSDK_NGX_D3D12_EvaluateFeature((ID3D12GraphicsCommandList*) dispatchDescription->commandList,
-                                                      handle, params, nullptr);
+                                                      handle, record->nvParams, nullptr);
 
     if (evalResult == NVSDK_NGX_Result_Success)
         return Fsr212::FFX_OK;
@@ -731,38 +753,42 @@ static Fsr212::FfxErrorCode ffxFsr20ContextDispatch_Dx12(Fsr212::FfxFsr2Context*
     if (dispatchDescription == nullptr || context == nullptr || dispatchDescription->commandList == nullptr)
         return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
 
-    // If not in contexts list create and add context
-    if (!_contexts.contains(context) && _initParams.contains(context) &&
-        !CreateDLSSContext20(context, dispatchDescription))
+    auto record = _contexts.Find(context);
+
+    if (record == nullptr)
+        return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
+
+    // Create DLSS feature on first dispatch
+    if (record->nvHandle == nullptr && !CreateDLSSContext20(record, dispatchDescription))
         return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
 
-    NVSDK_NGX_Parameter* params = _nvParams[context];
-    NVSDK_NGX_Handle* handle = _contexts[context];
-
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, dispatchDescription->jitterOffset.x);
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, dispatchDescription->jitterOffset.y);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_X, dispatchDescription->motionVectorScale.x);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, dispatchDescription->motionVectorScale.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, 1.0);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Pre_Exposure, dispatchDescription->preExposure);
-    params->Set(NVSDK_NGX_Parameter_Reset, dispatchDescription->reset ? 1 : 0);
-    params->Set(NVSDK_NGX_Parameter_Width, dispatchDescription->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_Height, dispatchDescription->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width, dispatchDescription->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height, dispatchDescription->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_Depth, dispatchDescription->depth.resource);
-    params->Set(NVSDK_NGX_Parameter_ExposureTexture, dispatchDescription->exposure.resource);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask, dispatchDescription->reactive.resource);
-    params->Set(NVSDK_NGX_Parameter_Color, dispatchDescription->color.resource);
-    params->Set(NVSDK_NGX_Parameter_MotionVectors, dispatchDescription->motionVectors.resource);
-    params->Set(NVSDK_NGX_Parameter_Output, dispatchDescription->output.resource);
-    params->Set("FSR.cameraNear", dispatchDescription->cameraNear);
-    params->Set("FSR.cameraFar", dispatchDescription->cameraFar);
-    params->Set("FSR.cameraFovAngleVertical", dispatchDescription->cameraFovAngleVertical);
-    params->Set("FSR.frameTimeDelta", dispatchDescription->frameTimeDelta);
-    params->Set("FSR.transparencyAndComposition", dispatchDescription->transparencyAndComposition.resource);
-    params->Set("FSR.reactive", dispatchDescription->reactive.resource);
-    params->Set(NVSDK_NGX_Parameter_Sharpness, dispatchDescription->sharpness);
+    NVNGX_ParameterWriter params { record->nvParams, record->optiParams };
+    NVSDK_NGX_Handle* handle = record->nvHandle;
+
+    params.Set<NVSDK_NGX_Parameter_Jitter_Offset_X>(dispatchDescription->jitterOffset.x);
+    params.Set<NVSDK_NGX_Parameter_Jitter_Offset_Y>(dispatchDescription->jitterOffset.y);
+    params.Set<NVSDK_NGX_Parameter_MV_Scale_X>(dispatchDescription->motionVectorScale.x);
+    params.Set<NVSDK_NGX_Parameter_MV_Scale_Y>(dispatchDescription->motionVectorScale.y);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Exposure_Scale>(1.0);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Pre_Exposure>(dispatchDescription->preExposure);
+    params.Set<NVSDK_NGX_Parameter_Reset>(dispatchDescription->reset ? 1 : 0);
+    params.Set<NVSDK_NGX_Parameter_Width>(dispatchDescription->renderSize.width);
+    params.Set<NVSDK_NGX_Parameter_Height>(dispatchDescription->renderSize.height);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width>(dispatchDescription->renderSize.width);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height>(dispatchDescription->renderSize.height);
+    params.Set<NVSDK_NGX_Parameter_Depth>(dispatchDescription->depth.resource);
+    params.Set<NVSDK_NGX_Parameter_ExposureTexture>(dispatchDescription->exposure.resource);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask>(dispatchDescription->reactive.resource);
+    params.Set<NVSDK_NGX_Parameter_Color>(dispatchDescription->color.resource);
+    params.Set<NVSDK_NGX_Parameter_MotionVectors>(dispatchDescription->motionVectors.resource);
+    params.Set<NVSDK_NGX_Parameter_Output>(dispatchDescription->output.resource);
+    params.Set<"FSR.cameraNear">(dispatchDescription->cameraNear);
+    params.Set<"FSR.cameraFar">(dispatchDescription->cameraFar);
+    params.Set<"FSR.cameraFovAngleVertical">(dispatchDescription->cameraFovAngleVertical);
+    params.Set<"FSR.frameTimeDelta">(dispatchDescription->frameTimeDelta);
+    params.Set<"FSR.transparencyAndComposition">(dispatchDescription->transparencyAndComposition.resource);
+    params.Set<"FSR.reactive">(dispatchDescription->reactive.resource);
+    params.Set<NVSDK_NGX_Parameter_Sharpness>(dispatchDescription->sharpness);
 
     LOG_DEBUG("handle: {:X}, internalResolution: {}x{}", handle->Id, dispatchDescription->renderSize.width,
               dispatchDescription->renderSize.height);
@@ -770,7 +796,7 @@ static Fsr212::FfxErrorCode ffxFsr20ContextDispatch_Dx12(Fsr212::FfxFsr2Context*
     State::Instance().setInputApiName = "FSR2.0-DX12";
 
     auto evalResult = NVSDK_NGX_D3D12_EvaluateFeature((ID3D12GraphicsCommandList*) dispatchDescription->commandList,
-                                                      handle, params, nullptr);
+                                                      handle, record->nvParams, nullptr);
 
     if (evalResult == NVSDK_NGX_Result_Success)
         return Fsr212::FFX_OK;
@@ -799,38 +825,42 @@ static Fsr212::FfxErrorCode ffxFsr20ContextDispatch_Pattern_Dx12(Fsr212::FfxFsr2
     if (dispatchDescription == nullptr || context == nullptr || dispatchDescription->commandList == nullptr)
         return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
 
-    // If not in contexts list create and add context
-    if (!_contexts.contains(context) && _initParams.contains(context) &&
-        !CreateDLSSContext20(context, dispatchDescription))
+    auto record = _contexts.Find(context);
+
+    if (record == nullptr)
         return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
 
-    NVSDK_NGX_Parameter* params = _nvParams[context];
-    NVSDK_NGX_Handle* handle = _contexts[context];
-
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, dispatchDescription->jitterOffset.x);
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, dispatchDescription->jitterOffset.y);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_X, dispatchDescription->motionVectorScale.x);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, dispatchDescription->motionVectorScale.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, 1.0);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Pre_Exposure, dispatchDescription->preExposure);
-    params->Set(NVSDK_NGX_Parameter_Reset, dispatchDescription->reset ? 1 : 0);
-    params->Set(NVSDK_NGX_Parameter_Width, dispatchDescription->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_Height, dispatchDescription->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width, dispatchDescription->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height, dispatchDescription->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_Depth, dispatchDescription->depth.resource);
-    params->Set(NVSDK_NGX_Parameter_ExposureTexture, dispatchDescription->exposure.resource);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask, dispatchDescription->reactive.resource);
-    params->Set(NVSDK_NGX_Parameter_Color, dispatchDescription->color.resource);
-    params->Set(NVSDK_NGX_Parameter_MotionVectors, dispatchDescription->motionVectors.resource);
-    params->Set(NVSDK_NGX_Parameter_Output, dispatchDescription->output.resource);
-    params->Set("FSR.cameraNear", dispatchDescription->cameraNear);
-    params->Set("FSR.cameraFar", dispatchDescription->cameraFar);
-    params->Set("FSR.cameraFovAngleVertical", dispatchDescription->cameraFovAngleVertical);
-    params->Set("FSR.frameTimeDelta", dispatchDescription->frameTimeDelta);
-    params->Set("FSR.transparencyAndComposition", dispatchDescription->transparencyAndComposition.resource);
-    params->Set("FSR.reactive", dispatchDescription->reactive.resource);
-    params->Set(NVSDK_NGX_Parameter_Sharpness, dispatchDescription->sharpness);
+    // Create DLSS feature on first dispatch
+    if (record->nvHandle == nullptr && !CreateDLSSContext20(record, dispatchDescription))
+        return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
+
+    NVNGX_ParameterWriter params { record->nvParams, record->optiParams };
+    NVSDK_NGX_Handle* handle = record->nvHandle;
+
+    params.Set<NVSDK_NGX_Parameter_Jitter_Offset_X>(dispatchDescription->jitterOffset.x);
+    params.Set<NVSDK_NGX_Parameter_Jitter_Offset_Y>(dispatchDescription->jitterOffset.y);
+    params.Set<NVSDK_NGX_Parameter_MV_Scale_X>(dispatchDescription->motionVectorScale.x);
+    params.Set<NVSDK_NGX_Parameter_MV_Scale_Y>(dispatchDescription->motionVectorScale.y);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Exposure_Scale>(1.0);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Pre_Exposure>(dispatchDescription->preExposure);
+    params.Set<NVSDK_NGX_Parameter_Reset>(dispatchDescription->reset ? 1 : 0);
+    params.Set<NVSDK_NGX_Parameter_Width>(dispatchDescription->renderSize.width);
+    params.Set<NVSDK_NGX_Parameter_Height>(dispatchDescription->renderSize.height);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width>(dispatchDescription->renderSize.width);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height>(dispatchDescription->renderSize.height);
+    params.Set<NVSDK_NGX_Parameter_Depth>(dispatchDescription->depth.resource);
+    params.Set<NVSDK_NGX_Parameter_ExposureTexture>(dispatchDescription->exposure.resource);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask>(dispatchDescription->reactive.resource);
+    params.Set<NVSDK_NGX_Parameter_Color>(dispatchDescription->color.resource);
+    params.Set<NVSDK_NGX_Parameter_MotionVectors>(dispatchDescription->motionVectors.resource);
+    params.Set<NVSDK_NGX_Parameter_Output>(dispatchDescription->output.resource);
+    params.Set<"FSR.cameraNear">(dispatchDescription->cameraNear);
+    params.Set<"FSR.cameraFar">(dispatchDescription->cameraFar);
+    params.Set<"FSR.cameraFovAngleVertical">(dispatchDescription->cameraFovAngleVertical);
+    params.Set<"FSR.frameTimeDelta">(dispatchDescription->frameTimeDelta);
+    params.Set<"FSR.transparencyAndComposition">(dispatchDescription->transparencyAndComposition.resource);
+    params.Set<"FSR.reactive">(dispatchDescription->reactive.resource);
+    params.Set<NVSDK_NGX_Parameter_Sharpness>(dispatchDescription->sharpness);
 
     LOG_DEBUG("handle: {:X}, internalResolution: {}x{}", handle->Id, dispatchDescription->renderSize.width,
               dispatchDescription->renderSize.height);
@@ -838,7 +868,7 @@ static Fsr212::FfxErrorCode ffxFsr20ContextDispatch_Pattern_Dx12(Fsr212::FfxFsr2
     State::Instance().setInputApiName = "FSR2.0-DX12";
 
     auto evalResult = NVSDK_NGX_D3D12_EvaluateFeature((ID3D12GraphicsCommandList*) dispatchDescription->commandList,
-                                                      handle, params, nullptr);
+                                                      handle, record->nvParams, nullptr);
 
     if (evalResult == NVSDK_NGX_Result_Success)
         return Fsr212::FFX_OK;
@@ -863,38 +893,42 @@ static Fsr212::FfxErrorCode ffxFsr2TinyContextDispatch_Dx12(Fsr212::FfxFsr2Conte
     if (dispatchDescription == nullptr || context == nullptr || dispatchDescription->commandList == nullptr)
         return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
 
-    // If not in contexts list create and add context
-    if (!_contexts.contains(context) && _initParams.contains(context) &&
-        !CreateDLSSContextTiny(context, dispatchDescription))
+    auto record = _contexts.Find(context);
+
+    if (record == nullptr)
+        return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
+
+    // Create DLSS feature on first dispatch
+    if (record->nvHandle == nullptr && !CreateDLSSContextTiny(record, dispatchDescription))
         return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
 
-    NVSDK_NGX_Parameter* params = _nvParams[context];
-    NVSDK_NGX_Handle* handle = _contexts[context];
-
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, dispatchDescription->jitterOffset.x);
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, dispatchDescription->jitterOffset.y);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_X, dispatchDescription->motionVectorScale.x);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, dispatchDescription->motionVectorScale.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, 1.0);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Pre_Exposure, dispatchDescription->preExposure);
-    params->Set(NVSDK_NGX_Parameter_Reset, dispatchDescription->reset ? 1 : 0);
-    params->Set(NVSDK_NGX_Parameter_Width, dispatchDescription->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_Height, dispatchDescription->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width, dispatchDescription->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height, dispatchDescription->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_Depth, dispatchDescription->depth.resource);
-    params->Set(NVSDK_NGX_Parameter_ExposureTexture, dispatchDescription->exposure.resource);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask, dispatchDescription->reactive.resource);
-    params->Set(NVSDK_NGX_Parameter_Color, dispatchDescription->color.resource);
-    params->Set(NVSDK_NGX_Parameter_MotionVectors, dispatchDescription->motionVectors.resource);
-    params->Set(NVSDK_NGX_Parameter_Output, dispatchDescription->output.resource);
-    params->Set("FSR.cameraNear", dispatchDescription->cameraNear);
-    params->Set("FSR.cameraFar", dispatchDescription->cameraFar);
-    params->Set("FSR.cameraFovAngleVertical", dispatchDescription->cameraFovAngleVertical);
-    params->Set("FSR.frameTimeDelta", dispatchDescription->frameTimeDelta);
-    params->Set("FSR.transparencyAndComposition", dispatchDescription->transparencyAndComposition.resource);
-    params->Set("FSR.reactive", dispatchDescription->reactive.resource);
-    params->Set(NVSDK_NGX_Parameter_Sharpness, dispatchDescription->sharpness);
+    NVNGX_ParameterWriter params { record->nvParams, record->optiParams };
+    NVSDK_NGX_Handle* handle = record->nvHandle;
+
+    params.Set<NVSDK_NGX_Parameter_Jitter_Offset_X>(dispatchDescription->jitterOffset.x);
+    params.Set<NVSDK_NGX_Parameter_Jitter_Offset_Y>(dispatchDescription->jitterOffset.y);
+    params.Set<NVSDK_NGX_Parameter_MV_Scale_X>(dispatchDescription->motionVectorScale.x);
+    params.Set<NVSDK_NGX_Parameter_MV_Scale_Y>(dispatchDescription->motionVectorScale.y);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Exposure_Scale>(1.0);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Pre_Exposure>(dispatchDescription->preExposure);
+    params.Set<NVSDK_NGX_Parameter_Reset>(dispatchDescription->reset ? 1 : 0);
+    params.Set<NVSDK_NGX_Parameter_Width>(dispatchDescription->renderSize.width);
+    params.Set<NVSDK_NGX_Parameter_Height>(dispatchDescription->renderSize.height);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width>(dispatchDescription->renderSize.width);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height>(dispatchDescription->renderSize.height);
+    params.Set<NVSDK_NGX_Parameter_Depth>(dispatchDescription->depth.resource);
+    params.Set<NVSDK_NGX_Parameter_ExposureTexture>(dispatchDescription->exposure.resource);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask>(dispatchDescription->reactive.resource);
+    params.Set<NVSDK_NGX_Parameter_Color>(dispatchDescription->color.resource);
+    params.Set<NVSDK_NGX_Parameter_MotionVectors>(dispatchDescription->motionVectors.resource);
+    params.Set<NVSDK_NGX_Parameter_Output>(dispatchDescription->output.resource);
+    params.Set<"FSR.cameraNear">(dispatchDescription->cameraNear);
+    params.Set<"FSR.cameraFar">(dispatchDescription->cameraFar);
+    params.Set<"FSR.cameraFovAngleVertical">(dispatchDescription->cameraFovAngleVertical);
+    params.Set<"FSR.frameTimeDelta">(dispatchDescription->frameTimeDelta);
+    params.Set<"FSR.transparencyAndComposition">(dispatchDescription->transparencyAndComposition.resource);
+    params.Set<"FSR.reactive">(dispatchDescription->reactive.resource);
+    params.Set<NVSDK_NGX_Parameter_Sharpness>(dispatchDescription->sharpness);
 
     LOG_DEBUG("handle: {:X}, internalResolution: {}x{}", handle->Id, dispatchDescription->renderSize.width,
               dispatchDescription->renderSize.height);
@@ -902,7 +936,7 @@ static Fsr212::FfxErrorCode ffxFsr2TinyContextDispatch_Dx12(Fsr212::FfxFsr2Conte
     State::Instance().setInputApiName = "FSR2.TT-DX12";
 
     auto evalResult = NVSDK_NGX_D3D12_EvaluateFeature((ID3D12GraphicsCommandList*) dispatchDescription->commandList,
-                                                      handle, params, nullptr);
+                                                      handle, record->nvParams, nullptr);
 
     if (evalResult == NVSDK_NGX_Result_Success)
         return Fsr212::FFX_OK;
@@ -918,12 +952,10 @@ static Fsr212::FfxErrorCode ffxFsr2ContextDestroy_Dx12(Fsr212::FfxFsr2Context* c
     if (context == nullptr)
         return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
 
-    if (_contexts.contains(context))
-        NVSDK_NGX_D3D12_ReleaseFeature(_contexts[context]);
+    if (auto record = _contexts.Find(context); record != nullptr && record->nvHandle != nullptr)
+        NVSDK_NGX_D3D12_ReleaseFeature(record->nvHandle);
 
-    _contexts.erase(context);
-    _nvParams.erase(context);
-    _initParams.erase(context);
+    _contexts.Remove(context);
 
     _skipDestroy = true;
     auto cdResult = o_ffxFsr2ContextDestroy_Dx12(context);
@@ -939,12 +971,10 @@ static Fsr212::FfxErrorCode ffxFsr2ContextDestroy_Pattern_Dx12(Fsr212::FfxFsr2Co
     if (context == nullptr)
         return Fsr212::FFX_ERROR_INVALID_ARGUMENT;
 
-    if (_contexts.contains(context))
-        NVSDK_NGX_D3D12_ReleaseFeature(_contexts[context]);
+    if (auto record = _contexts.Find(context); record != nullptr && record->nvHandle != nullptr)
+        NVSDK_NGX_D3D12_ReleaseFeature(record->nvHandle);
 
-    _contexts.erase(context);
-    _nvParams.erase(context);
-    _initParams.erase(context);
+    _contexts.Remove(context);
 
     auto cdResult = o_ffxFsr2ContextDestroy_Pattern_Dx12(context);
     LOG_INFO("result: {:X}", (UINT) cdResult);
@@ -1186,12 +1216,30 @@ void HookFSR2ExeInputs()
                 break;
             }
 
-            // Destroy
-            LOG_DEBUG("Checking destroyPattern");
             std::string_view destroyPattern(
                 "40 53 48 83 EC 20 48 8B D9 48 85 C9 75 ? B8 00 00 00 80 48 83 C4 20 5B C3");
-            o_ffxFsr2ContextDestroy_Pattern_Dx12 = (PFN_ffxFsr2ContextDestroy) scanner::GetAddress(
-                exeModule, destroyPattern, 0, (size_t) o_ffxFsr2ContextCreate_Pattern_Dx12);
+            std::string_view dispatchPattern20("40 55 56 41 57 48 8D AC 24 ? ? ? ? B8 ? ? ? ? E8 ? ? ? ? 48 2B E0 80 "
+                                               "B9 ? ? ? ? 00 4C 8B FA 48 8B 02 48 8B F1");
+            std::string_view dispatchPattern("40 55 53 57 48 8D AC 24 ? ? ? ? B8 ? ? ? ? E8 ? ? ? ? 48 2B E0 80 B9 ? ? "
+                                             "? ? 00 48 8B DA 48 8B 02 48 8B F9");
+            std::string_view dispatchPatternAITD("40 55 57 41 56 48 8D AC 24 ? ? ? ? B8 ? ? ? ? E8 ? ? ? ? 48 2B "
+                                                 "E0 80 B9 ? ? ? ? ? 4C 8B F2 48 8B 02 48 8B F9");
+            std::string_view dispatchPatternBanish(
+                "40 55 56 57 48 8D AC 24 ? ? ? ? B8 ? ? ? ? E8 ? ? ? ? 48 2B E0 48 8B 05 ? ? ? ? 48 33 C4 48 89 85 "
+                "? ? ? ? F7 01 ? ? ? ? 48 8B F2 48 8B F9");
+
+            // Search remaining methods with one pass over the exe, fallbacks are only used when needed
+            LOG_DEBUG("Checking destroy & dispatch patterns");
+            auto createAddress = (uintptr_t) o_ffxFsr2ContextCreate_Pattern_Dx12;
+            scanner::Request requests[] = { { destroyPattern, createAddress },
+                                            { dispatchPattern20, createAddress },
+                                            { dispatchPattern, createAddress },
+                                            { dispatchPatternAITD, createAddress },
+                                            { dispatchPatternBanish } };
+            scanner::FindAll(exeModule, requests);
+
+            // Destroy
+            o_ffxFsr2ContextDestroy_Pattern_Dx12 = (PFN_ffxFsr2ContextDestroy) requests[0].result;
 
             if (o_ffxFsr2ContextDestroy_Pattern_Dx12 != nullptr)
                 DetourAttach(&(PVOID&) o_ffxFsr2ContextDestroy_Pattern_Dx12, ffxFsr2ContextDestroy_Pattern_Dx12);
@@ -1207,11 +1255,7 @@ void HookFSR2ExeInputs()
             // DRG
             // Not receiving calls
             // Assumed FSR2.0
-            LOG_DEBUG("Checking dispatchPattern20");
-            std::string_view dispatchPattern20("40 55 56 41 57 48 8D AC 24 ? ? ? ? B8 ? ? ? ? E8 ? ? ? ? 48 2B E0 80 "
-                                               "B9 ? ? ? ? 00 4C 8B FA 48 8B 02 48 8B F1");
-            o_ffxFsr20ContextDispatch_Pattern_Dx12 = (PFN_ffxFsr2ContextDispatch) scanner::GetAddress(
-                exeModule, dispatchPattern20, 0, (size_t) o_ffxFsr2ContextCreate_Pattern_Dx12);
+            o_ffxFsr20ContextDispatch_Pattern_Dx12 = (PFN_ffxFsr2ContextDispatch) requests[1].result;
 
             if (o_ffxFsr20ContextDispatch_Pattern_Dx12 != nullptr)
                 DetourAttach(&(PVOID&) o_ffxFsr20ContextDispatch_Pattern_Dx12, ffxFsr20ContextDispatch_Pattern_Dx12);
@@ -1219,21 +1263,14 @@ void HookFSR2ExeInputs()
             LOG_DEBUG("ffxFsr20ContextDispatch_Pattern_Dx12: {:X}", (size_t) o_ffxFsr20ContextDispatch_Pattern_Dx12);
 
             // Lies of P
-            LOG_DEBUG("Checking dispatchPattern");
-            std::string_view dispatchPattern("40 55 53 57 48 8D AC 24 ? ? ? ? B8 ? ? ? ? E8 ? ? ? ? 48 2B E0 80 B9 ? ? "
-                                             "? ? 00 48 8B DA 48 8B 02 48 8B F9");
-            o_ffxFsr2ContextDispatch_Pattern_Dx12 = (PFN_ffxFsr2ContextDispatch) scanner::GetAddress(
-                exeModule, dispatchPattern, 0, (size_t) o_ffxFsr2ContextCreate_Pattern_Dx12);
+            o_ffxFsr2ContextDispatch_Pattern_Dx12 = (PFN_ffxFsr2ContextDispatch) requests[2].result;
 
             // Alone in the Dark - Game is using FSR1
             // Deliver Us Mars
             if (o_ffxFsr2ContextDispatch_Pattern_Dx12 == nullptr)
             {
-                LOG_DEBUG("Checking dispatchPatternAITD");
-                std::string_view dispatchPatternAITD("40 55 57 41 56 48 8D AC 24 ? ? ? ? B8 ? ? ? ? E8 ? ? ? ? 48 2B "
-                                                     "E0 80 B9 ? ? ? ? ? 4C 8B F2 48 8B 02 48 8B F9");
-                o_ffxFsr2ContextDispatch_Pattern_Dx12 = (PFN_ffxFsr2ContextDispatch) scanner::GetAddress(
-                    exeModule, dispatchPatternAITD, 0, (size_t) o_ffxFsr2ContextCreate_Pattern_Dx12);
+                LOG_DEBUG("Using dispatchPatternAITD");
+                o_ffxFsr2ContextDispatch_Pattern_Dx12 = (PFN_ffxFsr2ContextDispatch) requests[3].result;
             }
 
             // Witchfire
@@ -1260,11 +1297,8 @@ void HookFSR2ExeInputs()
             // RHI implementation, needs r.FidelityFX.FSR2.UseNativeDX12=1
             if (o_ffxFsr2ContextDispatch_Pattern_Dx12 == nullptr)
             {
-                std::string_view dispatchPatternBanish(
-                    "40 55 56 57 48 8D AC 24 ? ? ? ? B8 ? ? ? ? E8 ? ? ? ? 48 2B E0 48 8B 05 ? ? ? ? 48 33 C4 48 89 85 "
-                    "? ? ? ? F7 01 ? ? ? ? 48 8B F2 48 8B F9");
-                o_ffxFsr2ContextDispatch_Pattern_Dx12 =
-                    (PFN_ffxFsr2ContextDispatch) scanner::GetAddress(exeModule, dispatchPatternBanish, 0);
+                LOG_DEBUG("Using dispatchPatternBanish");
+                o_ffxFsr2ContextDispatch_Pattern_Dx12 = (PFN_ffxFsr2ContextDispatch) requests[4].result;
             }
 
             // AW2
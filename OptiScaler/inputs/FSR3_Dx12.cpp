@@ -6,6 +6,8 @@
 #include "resource.h"
 #include "NVNGX_Parameter.h"
 
+#include <misc/ContextRegistry.h>
+
 #include <proxies/KernelBase_Proxy.h>
 
 #include <scanner/scanner.h>
@@ -43,9 +45,17 @@ static PFN_ffxFsr3UpscalerGetRenderResolutionFromQualityMode o_ffxFsr3UpscalerGe
     nullptr;
 static PFN_ffxFSR3GetInterfaceDX12 o_ffxFSR3GetInterfaceDX12 = nullptr;
 
-static std::map<Fsr3::FfxFsr3UpscalerContext*, Fsr3::FfxFsr3UpscalerContextDescription> _initParams;
-static std::map<Fsr3::FfxFsr3UpscalerContext*, NVSDK_NGX_Parameter*> _nvParams;
-static std::map<Fsr3::FfxFsr3UpscalerContext*, NVSDK_NGX_Handle*> _contexts;
+struct Fsr3InputContext
+{
+    Fsr3::FfxFsr3UpscalerContextDescription initParams {};
+    NVSDK_NGX_Parameter* nvParams = nullptr;
+    NVNGX_Parameters* optiParams = nullptr;
+
+    // Created on first dispatch
+    NVSDK_NGX_Handle* nvHandle = nullptr;
+};
+
+static ContextRegistry<Fsr3::FfxFsr3UpscalerContext*, Fsr3InputContext> _contexts;
 static ID3D12Device* _d3d12Device = nullptr;
 static bool _nvnxgInited = false;
 static bool _skipCreate = false;
@@ -53,17 +63,16 @@ static bool _skipDispatch = false;
 static bool _skipDestroy = false;
 static float qualityRatios[] = { 1.0, 1.5, 1.7, 2.0, 3.0 };
 
-static bool CreateDLSSContext(Fsr3::FfxFsr3UpscalerContext* handle,
-                              const Fsr3::FfxFsr3UpscalerDispatchDescription* pExecParams)
+static bool CreateDLSSContext(Fsr3InputContext* record, const Fsr3::FfxFsr3UpscalerDispatchDescription* pExecParams)
 {
     LOG_DEBUG("");
 
-    if (!_nvParams.contains(handle))
+    if (record->nvParams == nullptr)
         return false;
 
     NVSDK_NGX_Handle* nvHandle = nullptr;
-    auto params = _nvParams[handle];
-    auto initParams = &_initParams[handle];
+    auto params = record->nvParams;
+    auto initParams = &record->initParams;
     auto commandList = (ID3D12GraphicsCommandList*) pExecParams->commandList;
 
     UINT initFlags = 0;
@@ -109,7 +118,7 @@ static bool CreateDLSSContext(Fsr3::FfxFsr3UpscalerContext* handle,
         NVSDK_NGX_Result_Success)
         return false;
 
-    _contexts[handle] = nvHandle;
+    record->nvHandle = nvHandle;
 
     return true;
 }
@@ -271,14 +280,16 @@ static Fsr3::FfxErrorCode ffxFsr3ContextCreate_Dx12(Fsr3::FfxFsr3UpscalerContext
     if (NVSDK_NGX_D3D12_GetCapabilityParameters(&params) != NVSDK_NGX_Result_Success)
         return Fsr3::FFX_ERROR_BACKEND_API_ERROR;
 
-    _nvParams[pContext] = params;
+    auto& record = _contexts.Add(pContext);
+    record.nvParams = params;
+    record.optiParams = GetOptiParameters(params);
 
     Fsr3::FfxFsr3UpscalerContextDescription ccd {};
     ccd.flags = pContextDescription->flags;
     ccd.maxRenderSize = pContextDescription->maxRenderSize;
     ccd.displaySize = pContextDescription->displaySize;
     ccd.backendInterface.device = pContextDescription->backendInterface.device;
-    _initParams[pContext] = ccd;
+    record.initParams = ccd;
 
     LOG_INFO("context created: {:X}", (size_t) pContext);
 
@@ -308,39 +319,43 @@ static Fsr3::FfxErrorCode ffxFsr3ContextDispatch_Dx12(Fsr3::FfxFsr3UpscalerConte
     if (pDispatchDescription == nullptr || pContext == nullptr || pDispatchDescription->commandList == nullptr)
         return Fsr3::FFX_ERROR_BACKEND_API_ERROR;
 
-    // If not in contexts list create and add context
-    if (!_contexts.contains(pContext) && _initParams.contains(pContext) &&
-        !CreateDLSSContext(pContext, pDispatchDescription))
+    auto record = _contexts.Find(pContext);
+
+    if (record == nullptr)
+        return Fsr3::FFX_ERROR_INVALID_ARGUMENT;
+
+    // Create DLSS feature on first dispatch
+    if (record->nvHandle == nullptr && !CreateDLSSContext(record, pDispatchDescription))
         return Fsr3::FFX_ERROR_INVALID_ARGUMENT;
 
-    NVSDK_NGX_Parameter* params = _nvParams[pContext];
-    NVSDK_NGX_Handle* handle = _contexts[pContext];
-
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, pDispatchDescription->jitterOffset.x);
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, pDispatchDescription->jitterOffset.y);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_X, pDispatchDescription->motionVectorScale.x);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, pDispatchDescription->motionVectorScale.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, 1.0);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Pre_Exposure, pDispatchDescription->preExposure);
-    params->Set(NVSDK_NGX_Parameter_Reset, pDispatchDescription->reset ? 1 : 0);
-    params->Set(NVSDK_NGX_Parameter_Width, pDispatchDescription->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_Height, pDispatchDescription->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width, pDispatchDescription->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height, pDispatchDescription->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_Depth, pDispatchDescription->depth.resource);
-    params->Set(NVSDK_NGX_Parameter_ExposureTexture, pDispatchDescription->exposure.resource);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask, pDispatchDescription->reactive.resource);
-    params->Set(NVSDK_NGX_Parameter_Color, pDispatchDescription->color.resource);
-    params->Set(NVSDK_NGX_Parameter_MotionVectors, pDispatchDescription->motionVectors.resource);
-    params->Set(NVSDK_NGX_Parameter_Output, pDispatchDescription->output.resource);
-    params->Set("FSR.cameraNear", pDispatchDescription->cameraNear);
-    params->Set("FSR.cameraFar", pDispatchDescription->cameraFar);
-    params->Set("FSR.cameraFovAngleVertical", pDispatchDescription->cameraFovAngleVertical);
-    params->Set("FSR.frameTimeDelta", pDispatchDescription->frameTimeDelta);
-    params->Set("FSR.transparencyAndComposition", pDispatchDescription->transparencyAndComposition.resource);
-    params->Set("FSR.reactive", pDispatchDescription->reactive.resource);
-    params->Set("FSR.viewSpaceToMetersFactor", pDispatchDescription->viewSpaceToMetersFactor);
-    params->Set(NVSDK_NGX_Parameter_Sharpness, pDispatchDescription->sharpness);
+    NVNGX_ParameterWriter params { record->nvParams, record->optiParams };
+    NVSDK_NGX_Handle* handle = record->nvHandle;
+
+    params.Set<NVSDK_NGX_Parameter_Jitter_Offset_X>(pDispatchDescription->jitterOffset.x);
+    params.Set<NVSDK_NGX_Parameter_Jitter_Offset_Y>(pDispatchDescription->jitterOffset.y);
+    params.Set<NVSDK_NGX_Parameter_MV_Scale_X>(pDispatchDescription->motionVectorScale.x);
+    params.Set<NVSDK_NGX_Parameter_MV_Scale_Y>(pDispatchDescription->motionVectorScale.y);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Exposure_Scale>(1.0);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Pre_Exposure>(pDispatchDescription->preExposure);
+    params.Set<NVSDK_NGX_Parameter_Reset>(pDispatchDescription->reset ? 1 : 0);
+    params.Set<NVSDK_NGX_Parameter_Width>(pDispatchDescription->renderSize.width);
+    params.Set<NVSDK_NGX_Parameter_Height>(pDispatchDescription->renderSize.height);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width>(pDispatchDescription->renderSize.width);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height>(pDispatchDescription->renderSize.height);
+    params.Set<NVSDK_NGX_Parameter_Depth>(pDispatchDescription->depth.resource);
+    params.Set<NVSDK_NGX_Parameter_ExposureTexture>(pDispatchDescription->exposure.resource);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask>(pDispatchDescription->reactive.resource);
+    params.Set<NVSDK_NGX_Parameter_Color>(pDispatchDescription->color.resource);
+    params.Set<NVSDK_NGX_Parameter_MotionVectors>(pDispatchDescription->motionVectors.resource);
+    params.Set<NVSDK_NGX_Parameter_Output>(pDispatchDescription->output.resource);
+    params.Set<"FSR.cameraNear">(pDispatchDescription->cameraNear);
+    params.Set<"FSR.cameraFar">(pDispatchDescription->cameraFar);
+    params.Set<"FSR.cameraFovAngleVertical">(pDispatchDescription->cameraFovAngleVertical);
+    params.Set<"FSR.frameTimeDelta">(pDispatchDescription->frameTimeDelta);
+    params.Set<"FSR.transparencyAndComposition">(pDispatchDescription->transparencyAndComposition.resource);
+    params.Set<"FSR.reactive">(pDispatchDescription->reactive.resource);
+    params.Set<"FSR.viewSpaceToMetersFactor">(pDispatchDescription->viewSpaceToMetersFactor);
+    params.Set<NVSDK_NGX_Parameter_Sharpness>(pDispatchDescription->sharpness);
 
     LOG_DEBUG("handle: {:X}, internalResolution: {}x{}", handle->Id, pDispatchDescription->renderSize.width,
               pDispatchDescription->renderSize.height);
@@ -348,7 +363,7 @@ static Fsr3::FfxErrorCode ffxFsr3ContextDispatch_Dx12(Fsr3::FfxFsr3UpscalerConte
     State::Instance().setInputApiName = "FSR3-DX12";
 
     auto evalResult = NVSDK_NGX_D3D12_EvaluateFeature((ID3D12GraphicsCommandList*) pDispatchDescription->commandList,
-                                                      handle, params, nullptr);
+                                                      handle, record->nvParams, nullptr);
 
     if (evalResult == NVSDK_NGX_Result_Success)
         return Fsr3::FFX_OK;
@@ -364,12 +379,10 @@ static Fsr3::FfxErrorCode ffxFsr3ContextDestroy_Dx12(Fsr3::FfxFsr3UpscalerContex
 
     LOG_DEBUG("context: {:X}", (size_t) pContext);
 
-    if (_contexts.contains(pContext))
-        NVSDK_NGX_D3D12_ReleaseFeature(_contexts[pContext]);
+    if (auto record = _contexts.Find(pContext); record != nullptr && record->nvHandle != nullptr)
+        NVSDK_NGX_D3D12_ReleaseFeature(record->nvHandle);
 
-    _contexts.erase(pContext);
-    _nvParams.erase(pContext);
-    _initParams.erase(pContext);
+    _contexts.Remove(pContext);
 
     _skipDestroy = true;
     auto cdResult = o_ffxFsr3UpscalerContextDestroy_Dx12(pContext);
@@ -475,14 +488,16 @@ ffxFsr3ContextCreate_Pattern_Dx12(Fsr3::FfxFsr3UpscalerContext* pContext,
     if (NVSDK_NGX_D3D12_GetCapabilityParameters(&params) != NVSDK_NGX_Result_Success)
         return Fsr3::FFX_ERROR_BACKEND_API_ERROR;
 
-    _nvParams[pContext] = params;
+    auto& record = _contexts.Add(pContext);
+    record.nvParams = params;
+    record.optiParams = GetOptiParameters(params);
 
     Fsr3::FfxFsr3UpscalerContextDescription ccd {};
     ccd.flags = pContextDescription->flags;
     ccd.maxRenderSize = pContextDescription->maxRenderSize;
     ccd.displaySize = pContextDescription->displaySize;
     ccd.backendInterface.device = pContextDescription->backendInterface.device;
-    _initParams[pContext] = ccd;
+    record.initParams = ccd;
 
     LOG_INFO("context created: {:X}", (size_t) pContext);
 
@@ -503,39 +518,43 @@ ffxFsr3ContextDispatch_Pattern_Dx12(Fsr3::FfxFsr3UpscalerContext* pContext,
     if (pDispatchDescription == nullptr || pContext == nullptr || pDispatchDescription->commandList == nullptr)
         return Fsr3::FFX_ERROR_BACKEND_API_ERROR;
 
-    // If not in contexts list create and add context
-    if (!_contexts.contains(pContext) && _initParams.contains(pContext) &&
-        !CreateDLSSContext(pContext, pDispatchDescription))
+    auto record = _contexts.Find(pContext);
+
+    if (record == nullptr)
+        return Fsr3::FFX_ERROR_INVALID_ARGUMENT;
+
+    // Create DLSS feature on first dispatch
+    if (record->nvHandle == nullptr && !CreateDLSSContext(record, pDispatchDescription))
         return Fsr3::FFX_ERROR_INVALID_ARGUMENT;
 
-    NVSDK_NGX_Parameter* params = _nvParams[pContext];
-    NVSDK_NGX_Handle* handle = _contexts[pContext];
-
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, pDispatchDescription->jitterOffset.x);
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, pDispatchDescription->jitterOffset.y);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_X, pDispatchDescription->motionVectorScale.x);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, pDispatchDescription->motionVectorScale.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, 1.0);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Pre_Exposure, pDispatchDescription->preExposure);
-    params->Set(NVSDK_NGX_Parameter_Reset, pDispatchDescription->reset ? 1 : 0);
-    params->Set(NVSDK_NGX_Parameter_Width, pDispatchDescription->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_Height, pDispatchDescription->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width, pDispatchDescription->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height, pDispatchDescription->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_Depth, pDispatchDescription->depth.resource);
-    params->Set(NVSDK_NGX_Parameter_ExposureTexture, pDispatchDescription->exposure.resource);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask, pDispatchDescription->reactive.resource);
-    params->Set(NVSDK_NGX_Parameter_Color, pDispatchDescription->color.resource);
-    params->Set(NVSDK_NGX_Parameter_MotionVectors, pDispatchDescription->motionVectors.resource);
-    params->Set(NVSDK_NGX_Parameter_Output, pDispatchDescription->output.resource);
-    params->Set("FSR.cameraNear", pDispatchDescription->cameraNear);
-    params->Set("FSR.cameraFar", pDispatchDescription->cameraFar);
-    params->Set("FSR.cameraFovAngleVertical", pDispatchDescription->cameraFovAngleVertical);
-    params->Set("FSR.frameTimeDelta", pDispatchDescription->frameTimeDelta);
-    params->Set("FSR.transparencyAndComposition", pDispatchDescription->transparencyAndComposition.resource);
-    params->Set("FSR.reactive", pDispatchDescription->reactive.resource);
-    params->Set("FSR.viewSpaceToMetersFactor", pDispatchDescription->viewSpaceToMetersFactor);
-    params->Set(NVSDK_NGX_Parameter_Sharpness, pDispatchDescription->sharpness);
+    NVNGX_ParameterWriter params { record->nvParams, record->optiParams };
+    NVSDK_NGX_Handle* handle = record->nvHandle;
+
+    params.Set<NVSDK_NGX_Parameter_Jitter_Offset_X>(pDispatchDescription->jitterOffset.x);
+    params.Set<NVSDK_NGX_Parameter_Jitter_Offset_Y>(pDispatchDescription->jitterOffset.y);
+    params.Set<NVSDK_NGX_Parameter_MV_Scale_X>(pDispatchDescription->motionVectorScale.x);
+    params.Set<NVSDK_NGX_Parameter_MV_Scale_Y>(pDispatchDescription->motionVectorScale.y);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Exposure_Scale>(1.0);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Pre_Exposure>(pDispatchDescription->preExposure);
+    params.Set<NVSDK_NGX_Parameter_Reset>(pDispatchDescription->reset ? 1 : 0);
+    params.Set<NVSDK_NGX_Parameter_Width>(pDispatchDescription->renderSize.width);
+    params.Set<NVSDK_NGX_Parameter_Height>(pDispatchDescription->renderSize.height);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width>(pDispatchDescription->renderSize.width);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height>(pDispatchDescription->renderSize.height);
+    params.Set<NVSDK_NGX_Parameter_Depth>(pDispatchDescription->depth.resource);
+    params.Set<NVSDK_NGX_Parameter_ExposureTexture>(pDispatchDescription->exposure.resource);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask>(pDispatchDescription->reactive.resource);
+    params.Set<NVSDK_NGX_Parameter_Color>(pDispatchDescription->color.resource);
+    params.Set<NVSDK_NGX_Parameter_MotionVectors>(pDispatchDescription->motionVectors.resource);
+    params.Set<NVSDK_NGX_Parameter_Output>(pDispatchDescription->output.resource);
+    params.Set<"FSR.cameraNear">(pDispatchDescription->cameraNear);
+    params.Set<"FSR.cameraFar">(pDispatchDescription->cameraFar);
+    params.Set<"FSR.cameraFovAngleVertical">(pDispatchDescription->cameraFovAngleVertical);
+    params.Set<"FSR.frameTimeDelta">(pDispatchDescription->frameTimeDelta);
+    params.Set<"FSR.transparencyAndComposition">(pDispatchDescription->transparencyAndComposition.resource);
+    params.Set<"FSR.reactive">(pDispatchDescription->reactive.resource);
+    params.Set<"FSR.viewSpaceToMetersFactor">(pDispatchDescription->viewSpaceToMetersFactor);
+    params.Set<NVSDK_NGX_Parameter_Sharpness>(pDispatchDescription->sharpness);
 
     LOG_DEBUG("handle: {:X}, internalResolution: {}x{}", handle->Id, pDispatchDescription->renderSize.width,
               pDispatchDescription->renderSize.height);
@@ -543,7 +562,7 @@ ffxFsr3ContextDispatch_Pattern_Dx12(Fsr3::FfxFsr3UpscalerContext* pContext,
     State::Instance().setInputApiName = "FSR3-DX12";
 
     auto evalResult = NVSDK_NGX_D3D12_EvaluateFeature((ID3D12GraphicsCommandList*) pDispatchDescription->commandList,
-                                                      handle, params, nullptr);
+                                                      handle, record->nvParams, nullptr);
 
     if (evalResult == NVSDK_NGX_Result_Success)
         return Fsr3::FFX_OK;
@@ -559,12 +578,10 @@ static Fsr3::FfxErrorCode ffxFsr3ContextDestroy_Pattern_Dx12(Fsr3::FfxFsr3Upscal
 
     LOG_DEBUG("context: {:X}", (size_t) pContext);
 
-    if (_contexts.contains(pContext))
-        NVSDK_NGX_D3D12_ReleaseFeature(_contexts[pContext]);
+    if (auto record = _contexts.Find(pContext); record != nullptr && record->nvHandle != nullptr)
+        NVSDK_NGX_D3D12_ReleaseFeature(record->nvHandle);
 
-    _contexts.erase(pContext);
-    _nvParams.erase(pContext);
-    _initParams.erase(pContext);
+    _contexts.Remove(pContext);
 
     auto cdResult = o_ffxFsr3UpscalerContextDestroy_Dx12(pContext);
     LOG_INFO("result: {:X}", (UINT) cdResult);
@@ -689,12 +706,23 @@ void HookFSR3ExeInputs()
 
     if (Config::Instance()->Fsr3Pattern.value_or_default())
     {
-        // Create
-        LOG_DEBUG("Checking createPattern");
         std::string_view createPattern(
             "48 ? ? ? ? 57 48 83 EC 20 48 8B DA 41 B8 ? ? ? ? 33 D2 48 8B F9 E8 ? ? ? ? 48 85 FF 74 ? 48 85 DB");
-        o_ffxFsr3UpscalerContextCreate_Pattern_Dx12 =
-            (PFN_ffxFsr3UpscalerContextCreate) scanner::GetAddress(exeModule, createPattern, 0);
+        std::string_view destroyPattern(
+            "40 ? ? ? ? 20 48 8B D9 48 85 C9 75 ? B8 ? ? ? ? 48 83 C4 20 5B C3 44 8B 81 ? ? ? ? 48 8D 91 ? ? ? ? 48 ? "
+            "? ? ? 48 83 C1 18 48 ? ? ? ? 48 ? ? ? ? E8 ? ? ? ? 44 8B 83");
+        std::string_view dispatchPattern("48 85 C9 74 36 48 85 D2 74 31 8B 41 04 39 82 ? ? ? ? 77 20 8B 41 08 39 82 ? "
+                                         "? ? ? 77 15 48 83 B9 ? ? ? ? ? 75 06 B8 ? ? ? ? C3");
+        std::string_view rfqPattern(
+            "85 C9 74 3C 83 E9 01 74 2E 83 E9 01 74 20 83 E9 01 74 12 83 F9 01 74 04 0F 57 C0 C3");
+
+        // Search all methods with one pass over the exe
+        LOG_DEBUG("Checking patterns");
+        scanner::Request requests[] = { { createPattern }, { destroyPattern }, { dispatchPattern }, { rfqPattern } };
+        scanner::FindAll(exeModule, requests);
+
+        // Create
+        o_ffxFsr3UpscalerContextCreate_Pattern_Dx12 = (PFN_ffxFsr3UpscalerContextCreate) requests[0].result;
 
         // RDR1 have duplicate methods and first found one is not used
         if (o_ffxFsr3UpscalerContextCreate_Pattern_Dx12 != nullptr &&
@@ -706,19 +734,13 @@ void HookFSR3ExeInputs()
             DetourAttach(&(PVOID&) o_ffxFsr3UpscalerContextCreate_Pattern_Dx12, ffxFsr3ContextCreate_Pattern_Dx12);
 
         // Destroy
-        LOG_DEBUG("Checking destroyPattern");
-        std::string_view destroyPattern(
-            "40 ? ? ? ? 20 48 8B D9 48 85 C9 75 ? B8 ? ? ? ? 48 83 C4 20 5B C3 44 8B 81 ? ? ? ? 48 8D 91 ? ? ? ? 48 ? "
-            "? ? ? 48 83 C1 18 48 ? ? ? ? 48 ? ? ? ? E8 ? ? ? ? 44 8B 83");
-
         // RDR1 have duplicate methods and first found one is not used
         if (State::Instance().gameQuirks & GameQuirk::SkipFsr3Method &&
             o_ffxFsr3UpscalerContextCreate_Pattern_Dx12 != nullptr)
             o_ffxFsr3UpscalerContextDestroy_Pattern_Dx12 = (PFN_ffxFsr3UpscalerContextDestroy) scanner::GetAddress(
                 exeModule, destroyPattern, 0, (size_t) o_ffxFsr3UpscalerContextCreate_Pattern_Dx12);
         else
-            o_ffxFsr3UpscalerContextDestroy_Pattern_Dx12 =
-                (PFN_ffxFsr3UpscalerContextDestroy) scanner::GetAddress(exeModule, destroyPattern, 0);
+            o_ffxFsr3UpscalerContextDestroy_Pattern_Dx12 = (PFN_ffxFsr3UpscalerContextDestroy) requests[1].result;
 
         if (o_ffxFsr3UpscalerContextDestroy_Pattern_Dx12 != nullptr)
             DetourAttach(&(PVOID&) o_ffxFsr3UpscalerContextDestroy_Pattern_Dx12, ffxFsr3ContextDestroy_Pattern_Dx12);
@@ -727,18 +749,13 @@ void HookFSR3ExeInputs()
                   (size_t) o_ffxFsr3UpscalerContextDestroy_Pattern_Dx12);
 
         // Dispatch
-        LOG_DEBUG("Checking dispatchPattern");
-        std::string_view dispatchPattern("48 85 C9 74 36 48 85 D2 74 31 8B 41 04 39 82 ? ? ? ? 77 20 8B 41 08 39 82 ? "
-                                         "? ? ? 77 15 48 83 B9 ? ? ? ? ? 75 06 B8 ? ? ? ? C3");
-
         // RDR1 have duplicate methods and first found one is not used
         if (State::Instance().gameQuirks & GameQuirk::SkipFsr3Method &&
             o_ffxFsr3UpscalerContextCreate_Pattern_Dx12 != nullptr)
             o_ffxFsr3UpscalerContextDispatch_Pattern_Dx12 = (PFN_ffxFsr3UpscalerContextDispatch) scanner::GetAddress(
                 exeModule, dispatchPattern, 0, (size_t) o_ffxFsr3UpscalerContextCreate_Pattern_Dx12);
         else
-            o_ffxFsr3UpscalerContextDispatch_Pattern_Dx12 =
-                (PFN_ffxFsr3UpscalerContextDispatch) scanner::GetAddress(exeModule, dispatchPattern, 0);
+            o_ffxFsr3UpscalerContextDispatch_Pattern_Dx12 = (PFN_ffxFsr3UpscalerContextDispatch) requests[2].result;
 
         if (o_ffxFsr3UpscalerContextDispatch_Pattern_Dx12 != nullptr)
             DetourAttach(&(PVOID&) o_ffxFsr3UpscalerContextDispatch_Pattern_Dx12, ffxFsr3ContextDispatch_Pattern_Dx12);
@@ -747,13 +764,8 @@ void HookFSR3ExeInputs()
                   (size_t) o_ffxFsr3UpscalerContextDispatch_Pattern_Dx12);
 
         // Ratio from quality
-        LOG_DEBUG("Checking dispatchPattern");
-        std::string_view rfqPattern(
-            "85 C9 74 3C 83 E9 01 74 2E 83 E9 01 74 20 83 E9 01 74 12 83 F9 01 74 04 0F 57 C0 C3");
-
-        // RDR1 have duplicate methods and first found one is not used
         o_ffxFsr3UpscalerGetUpscaleRatioFromQualityMode_Pattern_Dx12 =
-            (PFN_ffxFsr3UpscalerGetUpscaleRatioFromQualityMode) scanner::GetAddress(exeModule, rfqPattern, 0);
+            (PFN_ffxFsr3UpscalerGetUpscaleRatioFromQualityMode) requests[3].result;
 
         if (o_ffxFsr3UpscalerGetUpscaleRatioFromQualityMode_Pattern_Dx12 != nullptr)
             DetourAttach(&(PVOID&) o_ffxFsr3UpscalerGetUpscaleRatioFromQualityMode_Pattern_Dx12,
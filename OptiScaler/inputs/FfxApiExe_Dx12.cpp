@@ -5,6 +5,8 @@
 #include "resource.h"
 #include "NVNGX_Parameter.h"
 
+#include <misc/ContextRegistry.h>
+
 #include <proxies/KernelBase_Proxy.h>
 
 #include "detours/detours.h"
@@ -20,23 +22,32 @@ inline static PfnFfxConfigure _D3D12_Configure = nullptr;
 inline static PfnFfxQuery _D3D12_Query = nullptr;
 inline static PfnFfxDispatch _D3D12_Dispatch = nullptr;
 
-static std::map<ffxContext, ffxCreateContextDescUpscale> _initParams;
-static std::map<ffxContext, NVSDK_NGX_Parameter*> _nvParams;
-static std::map<ffxContext, NVSDK_NGX_Handle*> _contexts;
+struct FfxApiExeInputContext
+{
+    ffxCreateContextDescUpscale initParams {};
+    NVSDK_NGX_Parameter* nvParams = nullptr;
+    NVNGX_Parameters* optiParams = nullptr;
+
+    // Created on first dispatch
+    NVSDK_NGX_Handle* nvHandle = nullptr;
+};
+
+static ContextRegistry<ffxContext, FfxApiExeInputContext> _contexts;
 static ID3D12Device* _d3d12Device = nullptr;
 static bool _nvnxgInited = false;
 static float qualityRatios[] = { 1.0, 1.5, 1.7, 2.0, 3.0 };
 
-static bool CreateDLSSContext(ffxContext handle, const ffxDispatchDescUpscale* pExecParams)
+static bool CreateDLSSContext(ffxContext handle, FfxApiExeInputContext* record,
+                              const ffxDispatchDescUpscale* pExecParams)
 {
     LOG_DEBUG("context: {:X}", (size_t) handle);
 
-    if (!_nvParams.contains(handle))
+    if (record->nvParams == nullptr)
         return false;
 
     NVSDK_NGX_Handle* nvHandle = nullptr;
-    auto params = _nvParams[handle];
-    auto initParams = &_initParams[handle];
+    auto params = record->nvParams;
+    auto initParams = &record->initParams;
     auto commandList = (ID3D12GraphicsCommandList*) pExecParams->commandList;
 
     UINT initFlags = 0;
@@ -91,7 +102,7 @@ static bool CreateDLSSContext(ffxContext handle, const ffxDispatchDescUpscale* p
         return false;
     }
 
-    _contexts[handle] = nvHandle;
+    record->nvHandle = nvHandle;
     LOG_INFO("context created: {:X}", (size_t) handle);
 
     return true;
@@ -249,13 +260,15 @@ static ffxReturnCode_t ffxCreateContext_Dx12(ffxContext* context, ffxCreateConte
     if (NVSDK_NGX_D3D12_GetCapabilityParameters(&params) != NVSDK_NGX_Result_Success)
         return FFX_API_RETURN_ERROR_RUNTIME_ERROR;
 
-    _nvParams[*context] = params;
+    auto& record = _contexts.Add(*context);
+    record.nvParams = params;
+    record.optiParams = GetOptiParameters(params);
 
     ffxCreateContextDescUpscale ccd {};
     ccd.flags = createDesc->flags;
     ccd.maxRenderSize = createDesc->maxRenderSize;
     ccd.maxUpscaleSize = createDesc->maxUpscaleSize;
-    _initParams[*context] = ccd;
+    record.initParams = ccd;
 
     LOG_INFO("context created: {:X}", (size_t) *context);
 
@@ -272,12 +285,10 @@ static ffxReturnCode_t ffxDestroyContext_Dx12(ffxContext* context, const ffxAllo
     auto cdResult = _D3D12_DestroyContext(context, memCb);
     LOG_INFO("result: {:X}", (UINT) cdResult);
 
-    if (_contexts.contains(*context))
-        NVSDK_NGX_D3D12_ReleaseFeature(_contexts[*context]);
+    if (auto record = _contexts.Find(*context); record != nullptr && record->nvHandle != nullptr)
+        NVSDK_NGX_D3D12_ReleaseFeature(record->nvHandle);
 
-    _contexts.erase(*context);
-    _nvParams.erase(*context);
-    _initParams.erase(*context);
+    _contexts.Remove(*context);
 
     return FFX_API_RETURN_OK;
 }
@@ -346,7 +357,9 @@ static ffxReturnCode_t ffxDispatch_Dx12(ffxContext* context, ffxDispatchDescHead
 
     LOG_DEBUG("context: {:X}, type: {:X}", (size_t) *context, desc->type);
 
-    if (context == nullptr || !_initParams.contains(*context))
+    auto record = context != nullptr ? _contexts.Find(*context) : nullptr;
+
+    if (record == nullptr)
     {
         LOG_INFO("Not in _contexts, desc type: {:X}", desc->type);
         return _D3D12_Dispatch(context, desc);
@@ -374,41 +387,42 @@ static ffxReturnCode_t ffxDispatch_Dx12(ffxContext* context, ffxDispatchDescHead
     if (dispatchDesc->commandList == nullptr)
         return FFX_API_RETURN_ERROR_PARAMETER;
 
-    // If not in contexts list create and add context
     auto contextId = (size_t) *context;
-    if (!_contexts.contains(*context) && _initParams.contains(*context) && !CreateDLSSContext(*context, dispatchDesc))
+
+    // Create DLSS feature on first dispatch
+    if (record->nvHandle == nullptr && !CreateDLSSContext(*context, record, dispatchDesc))
         return FFX_API_RETURN_ERROR_RUNTIME_ERROR;
 
-    NVSDK_NGX_Parameter* params = _nvParams[*context];
-    NVSDK_NGX_Handle* handle = _contexts[*context];
-
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, dispatchDesc->jitterOffset.x);
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, dispatchDesc->jitterOffset.y);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_X, dispatchDesc->motionVectorScale.x);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, dispatchDesc->motionVectorScale.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, 1.0);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Pre_Exposure, dispatchDesc->preExposure);
-    params->Set(NVSDK_NGX_Parameter_Reset, dispatchDesc->reset ? 1 : 0);
-    params->Set(NVSDK_NGX_Parameter_Width, dispatchDesc->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_Height, dispatchDesc->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width, dispatchDesc->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height, dispatchDesc->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_Depth, dispatchDesc->depth.resource);
-    params->Set(NVSDK_NGX_Parameter_ExposureTexture, dispatchDesc->exposure.resource);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask, dispatchDesc->reactive.resource);
-    params->Set(NVSDK_NGX_Parameter_Color, dispatchDesc->color.resource);
-    params->Set(NVSDK_NGX_Parameter_MotionVectors, dispatchDesc->motionVectors.resource);
-    params->Set(NVSDK_NGX_Parameter_Output, dispatchDesc->output.resource);
-    params->Set("FSR.cameraNear", dispatchDesc->cameraNear);
-    params->Set("FSR.cameraFar", dispatchDesc->cameraFar);
-    params->Set("FSR.cameraFovAngleVertical", dispatchDesc->cameraFovAngleVertical);
-    params->Set("FSR.frameTimeDelta", dispatchDesc->frameTimeDelta);
-    params->Set("FSR.viewSpaceToMetersFactor", dispatchDesc->viewSpaceToMetersFactor);
-    params->Set("FSR.transparencyAndComposition", dispatchDesc->transparencyAndComposition.resource);
-    params->Set("FSR.reactive", dispatchDesc->reactive.resource);
-    params->Set(NVSDK_NGX_Parameter_Sharpness, dispatchDesc->sharpness);
-    params->Set("FSR.upscaleSize.width", dispatchDesc->upscaleSize.width);
-    params->Set("FSR.upscaleSize.height", dispatchDesc->upscaleSize.height);
+    NVNGX_ParameterWriter params { record->nvParams, record->optiParams };
+    NVSDK_NGX_Handle* handle = record->nvHandle;
+
+    params.Set<NVSDK_NGX_Parameter_Jitter_Offset_X>(dispatchDesc->jitterOffset.x);
+    params.Set<NVSDK_NGX_Parameter_Jitter_Offset_Y>(dispatchDesc->jitterOffset.y);
+    params.Set<NVSDK_NGX_Parameter_MV_Scale_X>(dispatchDesc->motionVectorScale.x);
+    params.Set<NVSDK_NGX_Parameter_MV_Scale_Y>(dispatchDesc->motionVectorScale.y);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Exposure_Scale>(1.0);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Pre_Exposure>(dispatchDesc->preExposure);
+    params.Set<NVSDK_NGX_Parameter_Reset>(dispatchDesc->reset ? 1 : 0);
+    params.Set<NVSDK_NGX_Parameter_Width>(dispatchDesc->renderSize.width);
+    params.Set<NVSDK_NGX_Parameter_Height>(dispatchDesc->renderSize.height);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width>(dispatchDesc->renderSize.width);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height>(dispatchDesc->renderSize.height);
+    params.Set<NVSDK_NGX_Parameter_Depth>(dispatchDesc->depth.resource);
+    params.Set<NVSDK_NGX_Parameter_ExposureTexture>(dispatchDesc->exposure.resource);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask>(dispatchDesc->reactive.resource);
+    params.Set<NVSDK_NGX_Parameter_Color>(dispatchDesc->color.resource);
+    params.Set<NVSDK_NGX_Parameter_MotionVectors>(dispatchDesc->motionVectors.resource);
+    params.Set<NVSDK_NGX_Parameter_Output>(dispatchDesc->output.resource);
+    params.Set<"FSR.cameraNear">(dispatchDesc->cameraNear);
+    params.Set<"FSR.cameraFar">(dispatchDesc->cameraFar);
+    params.Set<"FSR.cameraFovAngleVertical">(dispatchDesc->cameraFovAngleVertical);
+    params.Set<"FSR.frameTimeDelta">(dispatchDesc->frameTimeDelta);
+    params.Set<"FSR.viewSpaceToMetersFactor">(dispatchDesc->viewSpaceToMetersFactor);
+    params.Set<"FSR.transparencyAndComposition">(dispatchDesc->transparencyAndComposition.resource);
+    params.Set<"FSR.reactive">(dispatchDesc->reactive.resource);
+    params.Set<NVSDK_NGX_Parameter_Sharpness>(dispatchDesc->sharpness);
+    params.Set<"FSR.upscaleSize.width">(dispatchDesc->upscaleSize.width);
+    params.Set<"FSR.upscaleSize.height">(dispatchDesc->upscaleSize.height);
 
     LOG_DEBUG("handle: {:X}, internalResolution: {}x{}", handle->Id, dispatchDesc->renderSize.width,
               dispatchDesc->renderSize.height);
@@ -416,7 +430,7 @@ static ffxReturnCode_t ffxDispatch_Dx12(ffxContext* context, ffxDispatchDescHead
     State::Instance().setInputApiName = "FFX-DX12";
 
     auto evalResult = NVSDK_NGX_D3D12_EvaluateFeature((ID3D12GraphicsCommandList*) dispatchDesc->commandList, handle,
-                                                      params, nullptr);
+                                                      record->nvParams, nullptr);
 
     if (evalResult == NVSDK_NGX_Result_Success)
         return FFX_API_RETURN_OK;
@@ -6,16 +6,25 @@
 #include "proxies/FfxApi_Proxy.h"
 #include "NVNGX_Parameter.h"
 
+#include <misc/ContextRegistry.h>
+
 #include "ffx_upscale.h"
 #include "dx12/ffx_api_dx12.h"
 
-static std::map<ffxContext, ffxCreateContextDescUpscale> _initParams;
-static std::map<ffxContext, NVSDK_NGX_Parameter*> _nvParams;
-static std::map<ffxContext, NVSDK_NGX_Handle*> _contexts;
+struct FfxApiInputContext
+{
+    ffxCreateContextDescUpscale initParams {};
+    NVSDK_NGX_Parameter* nvParams = nullptr;
+    NVNGX_Parameters* optiParams = nullptr;
+
+    // Created on first dispatch
+    NVSDK_NGX_Handle* nvHandle = nullptr;
+};
+
+static ContextRegistry<ffxContext, FfxApiInputContext> _contexts;
 static ID3D12Device* _d3d12Device = nullptr;
 static bool _nvnxgInited = false;
 static float qualityRatios[] = { 1.0, 1.5, 1.7, 2.0, 3.0 };
-static size_t _contextCounter = 0;
 
 static std::string FfxGetGetDescTypeName(UINT type)
 {
@@ -124,16 +133,17 @@ static std::string FfxGetGetDescTypeName(UINT type)
     return std::format("??? ({:X})", type);
 }
 
-static bool CreateDLSSContext(ffxContext handle, const ffxDispatchDescUpscale* pExecParams)
+static bool CreateDLSSContext(ffxContext handle, FfxApiInputContext* record,
+                              const ffxDispatchDescUpscale* pExecParams)
 {
     LOG_DEBUG("context: {:X}", (size_t) handle);
 
-    if (!_nvParams.contains(handle))
+    if (record->nvParams == nullptr)
         return false;
 
     NVSDK_NGX_Handle* nvHandle = nullptr;
-    auto params = _nvParams[handle];
-    auto initParams = &_initParams[handle];
+    auto params = record->nvParams;
+    auto initParams = &record->initParams;
     auto commandList = (ID3D12GraphicsCommandList*) pExecParams->commandList;
 
     UINT initFlags = 0;
@@ -188,7 +198,7 @@ static bool CreateDLSSContext(ffxContext handle, const ffxDispatchDescUpscale* p
         return false;
     }
 
-    _contexts[handle] = nvHandle;
+    record->nvHandle = nvHandle;
     LOG_INFO("context created: {:X}", (size_t) handle);
 
     return true;
@@ -407,24 +417,22 @@ ffxReturnCode_t ffxCreateContext_Dx12(ffxContext* context, ffxCreateContextDescH
         _nvnxgInited = true;
     }
 
-    if (!Config::Instance()->EnableHotSwapping.value_or_default())
-    {
-        *context = (ffxContext) ++_contextCounter;
-        LOG_INFO("Custom context index:{}", _contextCounter);
-    }
-
     NVSDK_NGX_Parameter* params = nullptr;
 
     if (NVSDK_NGX_D3D12_GetCapabilityParameters(&params) != NVSDK_NGX_Result_Success)
         return FFX_API_RETURN_ERROR_RUNTIME_ERROR;
 
-    _nvParams[*context] = params;
+    // Without hot swapping there is no ffx context, game gets the handle of the record
+    auto& record = Config::Instance()->EnableHotSwapping.value_or_default() ? _contexts.Add(*context)
+                                                                             : _contexts.Create(*context);
+    record.nvParams = params;
+    record.optiParams = GetOptiParameters(params);
 
     ffxCreateContextDescUpscale ccd {};
     ccd.flags = createDesc->flags;
     ccd.maxRenderSize = createDesc->maxRenderSize;
     ccd.maxUpscaleSize = createDesc->maxUpscaleSize;
-    _initParams[*context] = ccd;
+    record.initParams = ccd;
 
     LOG_INFO("context created: {:X}", (size_t) *context);
 
@@ -439,15 +447,15 @@ ffxReturnCode_t ffxDestroyContext_Dx12(ffxContext* context, const ffxAllocationC
     LOG_DEBUG("context: {:X}", (size_t) *context);
 
     bool upscalerContext = false;
-    if (_contexts.contains(*context))
+    if (auto record = _contexts.Find(*context); record != nullptr)
     {
-        NVSDK_NGX_D3D12_ReleaseFeature(_contexts[*context]);
+        if (record->nvHandle != nullptr)
+            NVSDK_NGX_D3D12_ReleaseFeature(record->nvHandle);
+
         upscalerContext = true;
     }
 
-    _contexts.erase(*context);
-    _nvParams.erase(*context);
-    _initParams.erase(*context);
+    _contexts.Remove(*context);
 
     if (State::Instance().currentFG != nullptr)
         LOG_DEBUG("context: {:X}, SwapchainContext: {:X}, FGContext: {:X}", (size_t) *context,
@@ -517,7 +525,9 @@ ffxReturnCode_t ffxQuery_Dx12(ffxContext* context, ffxQueryDescHeader* desc)
         return FFX_API_RETURN_OK;
     }
 
-    if (context != nullptr && _contexts.contains(*context) && !Config::Instance()->EnableHotSwapping.value_or_default())
+    auto record = context != nullptr ? _contexts.Find(*context) : nullptr;
+
+    if (record != nullptr && record->nvHandle != nullptr && !Config::Instance()->EnableHotSwapping.value_or_default())
     {
         LOG_INFO("Hot swapping disabled, ignoring upscaler query");
         return FFX_API_RETURN_OK;
@@ -538,7 +548,9 @@ ffxReturnCode_t ffxDispatch_Dx12(ffxContext* context, ffxDispatchDescHeader* des
 
     LOG_DEBUG("context: {:X}, type: {}", (size_t) *context, FfxGetGetDescTypeName(desc->type));
 
-    if (context == nullptr || !_initParams.contains(*context))
+    auto record = _contexts.Find(*context);
+
+    if (record == nullptr)
     {
         LOG_INFO("Not in _contexts");
         return FfxApiProxy::D3D12_Dispatch()(context, desc);
@@ -569,52 +581,53 @@ ffxReturnCode_t ffxDispatch_Dx12(ffxContext* context, ffxDispatchDescHeader* des
     if (dispatchDesc->commandList == nullptr)
         return FfxApiProxy::D3D12_Dispatch()(context, desc);
 
-    // If not in contexts list create and add context
     auto contextId = (size_t) *context;
-    if (!_contexts.contains(*context) && _initParams.contains(*context) && !CreateDLSSContext(*context, dispatchDesc))
+
+    // Create DLSS feature on first dispatch
+    if (record->nvHandle == nullptr && !CreateDLSSContext(*context, record, dispatchDesc))
         return FFX_API_RETURN_ERROR_RUNTIME_ERROR;
 
-    NVSDK_NGX_Parameter* params = _nvParams[*context];
-    NVSDK_NGX_Handle* handle = _contexts[*context];
-
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, dispatchDesc->jitterOffset.x);
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, dispatchDesc->jitterOffset.y);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_X, dispatchDesc->motionVectorScale.x);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, dispatchDesc->motionVectorScale.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, 1.0);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Pre_Exposure, dispatchDesc->preExposure);
-    params->Set(NVSDK_NGX_Parameter_Reset, dispatchDesc->reset ? 1 : 0);
-    params->Set(NVSDK_NGX_Parameter_Width, dispatchDesc->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_Height, dispatchDesc->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width, dispatchDesc->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height, dispatchDesc->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_Depth, dispatchDesc->depth.resource);
-    params->Set(NVSDK_NGX_Parameter_ExposureTexture, dispatchDesc->exposure.resource);
+    NVNGX_ParameterWriter params { record->nvParams, record->optiParams };
+    NVSDK_NGX_Handle* handle = record->nvHandle;
+
+    params.Set<NVSDK_NGX_Parameter_Jitter_Offset_X>(dispatchDesc->jitterOffset.x);
+    params.Set<NVSDK_NGX_Parameter_Jitter_Offset_Y>(dispatchDesc->jitterOffset.y);
+    params.Set<NVSDK_NGX_Parameter_MV_Scale_X>(dispatchDesc->motionVectorScale.x);
+    params.Set<NVSDK_NGX_Parameter_MV_Scale_Y>(dispatchDesc->motionVectorScale.y);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Exposure_Scale>(1.0);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Pre_Exposure>(dispatchDesc->preExposure);
+    params.Set<NVSDK_NGX_Parameter_Reset>(dispatchDesc->reset ? 1 : 0);
+    params.Set<NVSDK_NGX_Parameter_Width>(dispatchDesc->renderSize.width);
+    params.Set<NVSDK_NGX_Parameter_Height>(dispatchDesc->renderSize.height);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width>(dispatchDesc->renderSize.width);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height>(dispatchDesc->renderSize.height);
+    params.Set<NVSDK_NGX_Parameter_Depth>(dispatchDesc->depth.resource);
+    params.Set<NVSDK_NGX_Parameter_ExposureTexture>(dispatchDesc->exposure.resource);
 
     if (dispatchDesc->reactive.description.width >= dispatchDesc->renderSize.width &&
         dispatchDesc->reactive.description.height >= dispatchDesc->renderSize.height)
-        params->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask, dispatchDesc->reactive.resource);
+        params.Set<NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask>(dispatchDesc->reactive.resource);
 
-    params->Set(NVSDK_NGX_Parameter_Color, dispatchDesc->color.resource);
-    params->Set(NVSDK_NGX_Parameter_MotionVectors, dispatchDesc->motionVectors.resource);
-    params->Set(NVSDK_NGX_Parameter_Output, dispatchDesc->output.resource);
-    params->Set("FSR.cameraNear", dispatchDesc->cameraNear);
-    params->Set("FSR.cameraFar", dispatchDesc->cameraFar);
-    params->Set("FSR.cameraFovAngleVertical", dispatchDesc->cameraFovAngleVertical);
-    params->Set("FSR.frameTimeDelta", dispatchDesc->frameTimeDelta);
-    params->Set("FSR.viewSpaceToMetersFactor", dispatchDesc->viewSpaceToMetersFactor);
+    params.Set<NVSDK_NGX_Parameter_Color>(dispatchDesc->color.resource);
+    params.Set<NVSDK_NGX_Parameter_MotionVectors>(dispatchDesc->motionVectors.resource);
+    params.Set<NVSDK_NGX_Parameter_Output>(dispatchDesc->output.resource);
+    params.Set<"FSR.cameraNear">(dispatchDesc->cameraNear);
+    params.Set<"FSR.cameraFar">(dispatchDesc->cameraFar);
+    params.Set<"FSR.cameraFovAngleVertical">(dispatchDesc->cameraFovAngleVertical);
+    params.Set<"FSR.frameTimeDelta">(dispatchDesc->frameTimeDelta);
+    params.Set<"FSR.viewSpaceToMetersFactor">(dispatchDesc->viewSpaceToMetersFactor);
 
     if (dispatchDesc->transparencyAndComposition.description.width >= dispatchDesc->renderSize.width &&
         dispatchDesc->transparencyAndComposition.description.height >= dispatchDesc->renderSize.height)
-        params->Set("FSR.transparencyAndComposition", dispatchDesc->transparencyAndComposition.resource);
+        params.Set<"FSR.transparencyAndComposition">(dispatchDesc->transparencyAndComposition.resource);
 
     if (dispatchDesc->reactive.description.width >= dispatchDesc->renderSize.width &&
         dispatchDesc->reactive.description.height >= dispatchDesc->renderSize.height)
-        params->Set("FSR.reactive", dispatchDesc->reactive.resource);
+        params.Set<"FSR.reactive">(dispatchDesc->reactive.resource);
 
-    params->Set(NVSDK_NGX_Parameter_Sharpness, dispatchDesc->sharpness);
-    params->Set("FSR.upscaleSize.width", dispatchDesc->upscaleSize.width);
-    params->Set("FSR.upscaleSize.height", dispatchDesc->upscaleSize.height);
+    params.Set<NVSDK_NGX_Parameter_Sharpness>(dispatchDesc->sharpness);
+    params.Set<"FSR.upscaleSize.width">(dispatchDesc->upscaleSize.width);
+    params.Set<"FSR.upscaleSize.height">(dispatchDesc->upscaleSize.height);
 
     LOG_DEBUG("handle: {:X}, internalResolution: {}x{}", handle->Id, dispatchDesc->renderSize.width,
               dispatchDesc->renderSize.height);
@@ -622,7 +635,7 @@ ffxReturnCode_t ffxDispatch_Dx12(ffxContext* context, ffxDispatchDescHeader* des
     State::Instance().setInputApiName = "FFX-DX12";
 
     auto evalResult = NVSDK_NGX_D3D12_EvaluateFeature((ID3D12GraphicsCommandList*) dispatchDesc->commandList, handle,
-                                                      params, nullptr);
+                                                      record->nvParams, nullptr);
 
     if (evalResult == NVSDK_NGX_Result_Success)
         return FFX_API_RETURN_OK;
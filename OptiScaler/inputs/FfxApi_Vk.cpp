@@ -5,6 +5,8 @@
 #include <resource.h>
 #include <NVNGX_Parameter.h>
 
+#include <misc/ContextRegistry.h>
+
 #include <proxies/FfxApi_Proxy.h>
 
 #include <ffx_upscale.h>
@@ -13,9 +15,17 @@
 #include <nvsdk_ngx_vk.h>
 #include <nvsdk_ngx_helpers_vk.h>
 
-static std::map<ffxContext, ffxCreateContextDescUpscale> _initParams;
-static std::map<ffxContext, NVSDK_NGX_Parameter*> _nvParams;
-static std::map<ffxContext, NVSDK_NGX_Handle*> _contexts;
+struct FfxApiVkInputContext
+{
+    ffxCreateContextDescUpscale initParams {};
+    NVSDK_NGX_Parameter* nvParams = nullptr;
+    NVNGX_Parameters* optiParams = nullptr;
+
+    // Created on first dispatch
+    NVSDK_NGX_Handle* nvHandle = nullptr;
+};
+
+static ContextRegistry<ffxContext, FfxApiVkInputContext> _contexts;
 static VkDevice _vkDevice = nullptr;
 static VkPhysicalDevice _vkPhysicalDevice = nullptr;
 static PFN_vkGetDeviceProcAddr _vkDeviceProcAddress = nullptr;
@@ -152,16 +162,17 @@ static bool CreateIVandNVRes(FfxApiResource resource, VkImageView* imageView, NV
     return true;
 }
 
-static bool CreateDLSSContext(ffxContext handle, const ffxDispatchDescUpscale* pExecParams)
+static bool CreateDLSSContext(ffxContext handle, FfxApiVkInputContext* record,
+                              const ffxDispatchDescUpscale* pExecParams)
 {
     LOG_DEBUG("context: {:X}", (size_t) handle);
 
-    if (!_nvParams.contains(handle))
+    if (record->nvParams == nullptr)
         return false;
 
     NVSDK_NGX_Handle* nvHandle = nullptr;
-    auto params = _nvParams[handle];
-    auto initParams = &_initParams[handle];
+    auto params = record->nvParams;
+    auto initParams = &record->initParams;
     auto commandList = (VkCommandBuffer) pExecParams->commandList;
 
     UINT initFlags = 0;
@@ -216,7 +227,7 @@ static bool CreateDLSSContext(ffxContext handle, const ffxDispatchDescUpscale* p
         return false;
     }
 
-    _contexts[handle] = nvHandle;
+    record->nvHandle = nvHandle;
     LOG_INFO("context created: {:X}", (size_t) handle);
 
     return true;
@@ -378,13 +389,15 @@ ffxReturnCode_t ffxCreateContext_Vk(ffxContext* context, ffxCreateContextDescHea
     if (NVSDK_NGX_VULKAN_GetCapabilityParameters(&params) != NVSDK_NGX_Result_Success)
         return FFX_API_RETURN_ERROR_RUNTIME_ERROR;
 
-    _nvParams[*context] = params;
+    auto& record = _contexts.Add(*context);
+    record.nvParams = params;
+    record.optiParams = GetOptiParameters(params);
 
     ffxCreateContextDescUpscale ccd {};
     ccd.flags = createDesc->flags;
     ccd.maxRenderSize = createDesc->maxRenderSize;
     ccd.maxUpscaleSize = createDesc->maxUpscaleSize;
-    _initParams[*context] = ccd;
+    record.initParams = ccd;
 
     LOG_INFO("context created: {:X}", (size_t) *context);
 
@@ -398,12 +411,10 @@ ffxReturnCode_t ffxDestroyContext_Vk(ffxContext* context, const ffxAllocationCal
 
     LOG_DEBUG("context: {:X}", (size_t) *context);
 
-    if (_contexts.contains(*context))
-        NVSDK_NGX_VULKAN_ReleaseFeature(_contexts[*context]);
+    if (auto record = _contexts.Find(*context); record != nullptr && record->nvHandle != nullptr)
+        NVSDK_NGX_VULKAN_ReleaseFeature(record->nvHandle);
 
-    _contexts.erase(*context);
-    _nvParams.erase(*context);
-    _initParams.erase(*context);
+    _contexts.Remove(*context);
 
     auto cdResult = FfxApiProxy::VULKAN_DestroyContext()(context, memCb);
     LOG_INFO("result: {:X}", (UINT) cdResult);
@@ -472,7 +483,9 @@ ffxReturnCode_t ffxDispatch_Vk(ffxContext* context, ffxDispatchDescHeader* desc)
 
     LOG_DEBUG("context: {:X}, type: {:X}", (size_t) *context, desc->type);
 
-    if (!_initParams.contains(*context))
+    auto record = _contexts.Find(*context);
+
+    if (record == nullptr)
     {
         LOG_INFO("Not in _contexts, desc type: {:X}", desc->type);
         return FfxApiProxy::VULKAN_Dispatch()(context, desc);
@@ -506,29 +519,29 @@ ffxReturnCode_t ffxDispatch_Vk(ffxContext* context, ffxDispatchDescHeader* desc)
         return FFX_API_RETURN_ERROR_PARAMETER;
     }
 
-    // If not in contexts list create and add context
     auto contextId = (size_t) *context;
-    if (!_contexts.contains(*context) && _initParams.contains(*context) && !CreateDLSSContext(*context, dispatchDesc))
+
+    // Create DLSS feature on first dispatch
+    if (record->nvHandle == nullptr && !CreateDLSSContext(*context, record, dispatchDesc))
     {
-        LOG_DEBUG("!_contexts.contains(*context) && _initParams.contains(*context) && !CreateDLSSContext(*context, "
-                  "dispatchDesc)");
+        LOG_DEBUG("record->nvHandle == nullptr && !CreateDLSSContext(*context, record, dispatchDesc)");
         return FFX_API_RETURN_ERROR_RUNTIME_ERROR;
     }
 
-    NVSDK_NGX_Parameter* params = _nvParams[*context];
-    NVSDK_NGX_Handle* handle = _contexts[*context];
-
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, dispatchDesc->jitterOffset.x);
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, dispatchDesc->jitterOffset.y);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_X, dispatchDesc->motionVectorScale.x);
-    params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, dispatchDesc->motionVectorScale.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, 1.0);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Pre_Exposure, dispatchDesc->preExposure);
-    params->Set(NVSDK_NGX_Parameter_Reset, dispatchDesc->reset ? 1 : 0);
-    params->Set(NVSDK_NGX_Parameter_Width, dispatchDesc->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_Height, dispatchDesc->renderSize.height);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width, dispatchDesc->renderSize.width);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height, dispatchDesc->renderSize.height);
+    NVNGX_ParameterWriter params { record->nvParams, record->optiParams };
+    NVSDK_NGX_Handle* handle = record->nvHandle;
+
+    params.Set<NVSDK_NGX_Parameter_Jitter_Offset_X>(dispatchDesc->jitterOffset.x);
+    params.Set<NVSDK_NGX_Parameter_Jitter_Offset_Y>(dispatchDesc->jitterOffset.y);
+    params.Set<NVSDK_NGX_Parameter_MV_Scale_X>(dispatchDesc->motionVectorScale.x);
+    params.Set<NVSDK_NGX_Parameter_MV_Scale_Y>(dispatchDesc->motionVectorScale.y);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Exposure_Scale>(1.0);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Pre_Exposure>(dispatchDesc->preExposure);
+    params.Set<NVSDK_NGX_Parameter_Reset>(dispatchDesc->reset ? 1 : 0);
+    params.Set<NVSDK_NGX_Parameter_Width>(dispatchDesc->renderSize.width);
+    params.Set<NVSDK_NGX_Parameter_Height>(dispatchDesc->renderSize.height);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width>(dispatchDesc->renderSize.width);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height>(dispatchDesc->renderSize.height);
 
     // Clear last frames image views
     LOG_DEBUG("Clear last frames image views");
@@ -564,19 +577,19 @@ ffxReturnCode_t ffxDispatch_Vk(ffxContext* context, ffxDispatchDescHeader* desc)
     }
     else
     {
-        params->Set(NVSDK_NGX_Parameter_Depth, &depthNVRes);
+        params.Set<NVSDK_NGX_Parameter_Depth>(&depthNVRes);
     }
 
     if (dispatchDesc->exposure.resource != nullptr &&
         CreateIVandNVRes(dispatchDesc->exposure, &expImageView, &expNVRes))
     {
-        params->Set(NVSDK_NGX_Parameter_ExposureTexture, &expNVRes);
+        params.Set<NVSDK_NGX_Parameter_ExposureTexture>(&expNVRes);
     }
 
     if (dispatchDesc->reactive.resource != nullptr &&
         CreateIVandNVRes(dispatchDesc->reactive, &biasImageView, &biasNVRes))
     {
-        params->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask, &biasNVRes);
+        params.Set<NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask>(&biasNVRes);
     }
 
     if (dispatchDesc->color.resource == nullptr || !CreateIVandNVRes(dispatchDesc->color, &colorImageView, &colorNVRes))
@@ -586,7 +599,7 @@ ffxReturnCode_t ffxDispatch_Vk(ffxContext* context, ffxDispatchDescHeader* desc)
     }
     else
     {
-        params->Set(NVSDK_NGX_Parameter_Color, &colorNVRes);
+        params.Set<NVSDK_NGX_Parameter_Color>(&colorNVRes);
     }
 
     if (dispatchDesc->motionVectors.resource == nullptr ||
@@ -597,7 +610,7 @@ ffxReturnCode_t ffxDispatch_Vk(ffxContext* context, ffxDispatchDescHeader* desc)
     }
     else
     {
-        params->Set(NVSDK_NGX_Parameter_MotionVectors, &mvNVRes);
+        params.Set<NVSDK_NGX_Parameter_MotionVectors>(&mvNVRes);
     }
 
     if (dispatchDesc->output.resource == nullptr ||
@@ -608,35 +621,35 @@ ffxReturnCode_t ffxDispatch_Vk(ffxContext* context, ffxDispatchDescHeader* desc)
     }
     else
     {
-        params->Set(NVSDK_NGX_Parameter_Output, &outputNVRes);
+        params.Set<NVSDK_NGX_Parameter_Output>(&outputNVRes);
     }
 
     if (dispatchDesc->transparencyAndComposition.resource != nullptr &&
         CreateIVandNVRes(dispatchDesc->transparencyAndComposition, &fsrTransparencyView, &fsrTransparencyNVRes))
     {
-        params->Set("FSR.transparencyAndComposition", &fsrTransparencyNVRes);
+        params.Set<"FSR.transparencyAndComposition">(&fsrTransparencyNVRes);
     }
 
     if (dispatchDesc->reactive.resource != nullptr &&
         CreateIVandNVRes(dispatchDesc->reactive, &fsrReactiveView, &fsrReactiveNVRes))
     {
-        params->Set("FSR.reactive", &fsrReactiveNVRes);
+        params.Set<"FSR.reactive">(&fsrReactiveNVRes);
     }
 
-    params->Set("FSR.cameraNear", dispatchDesc->cameraNear);
-    params->Set("FSR.cameraFar", dispatchDesc->cameraFar);
-    params->Set("FSR.cameraFovAngleVertical", dispatchDesc->cameraFovAngleVertical);
-    params->Set("FSR.frameTimeDelta", dispatchDesc->frameTimeDelta);
-    params->Set("FSR.viewSpaceToMetersFactor", dispatchDesc->viewSpaceToMetersFactor);
-    params->Set(NVSDK_NGX_Parameter_Sharpness, dispatchDesc->sharpness);
+    params.Set<"FSR.cameraNear">(dispatchDesc->cameraNear);
+    params.Set<"FSR.cameraFar">(dispatchDesc->cameraFar);
+    params.Set<"FSR.cameraFovAngleVertical">(dispatchDesc->cameraFovAngleVertical);
+    params.Set<"FSR.frameTimeDelta">(dispatchDesc->frameTimeDelta);
+    params.Set<"FSR.viewSpaceToMetersFactor">(dispatchDesc->viewSpaceToMetersFactor);
+    params.Set<NVSDK_NGX_Parameter_Sharpness>(dispatchDesc->sharpness);
 
     LOG_DEBUG("handle: {:X}, internalResolution: {}x{}", handle->Id, dispatchDesc->renderSize.width,
               dispatchDesc->renderSize.height);
 
     State::Instance().setInputApiName = "FFX-VK";
 
-    auto evalResult =
-        NVSDK_NGX_VULKAN_EvaluateFeature((VkCommandBuffer) dispatchDesc->commandList, handle, params, nullptr);
+    auto evalResult = NVSDK_NGX_VULKAN_EvaluateFeature((VkCommandBuffer) dispatchDesc->commandList, handle,
+                                                       record->nvParams, nullptr);
 
     if (evalResult == NVSDK_NGX_Result_Success)
         return FFX_API_RETURN_OK;
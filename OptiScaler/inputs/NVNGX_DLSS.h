@@ -1,8 +1,13 @@
 #pragma once
 
+#include "upscalers/BackendWarmup.h"
+
 template <typename FeatureType> struct ContextData
 {
     std::unique_ptr<FeatureType> feature;
     NVSDK_NGX_Parameter* createParams = nullptr;
     int changeBackendCounter = 0;
+
+    // Backend which is being built in background, only used by Dx12 for now
+    std::unique_ptr<BackendWarmup<FeatureType>> warmup;
 };
@@ -1,4 +1,5 @@
 #include "Config.h"
+#include "FrameConfig.h"
 #include "Util.h"
 
 #include "NVNGX_Parameter.h"
@@ -16,6 +17,12 @@
 #include "framegen/ffx/FSRFG_Dx12.h"
 
 #include "hooks/HooksDx.h"
+#include "misc/GpuTimer_Dx12.h"
+#include "misc/DeferredRelease_Dx12.h"
+#include "misc/DescriptorRing_Dx12.h"
+#include "misc/TransientPool_Dx12.h"
+#include "misc/ShaderCache_Dx12.h"
+#include "misc/RootSignatureTracker.h"
 #include "proxies/FfxApi_Proxy.h"
 
 #include <hudfix/Hudfix_Dx12.h>
@@ -24,7 +31,6 @@
 #include "shaders/depth_scale/DS_Dx12.h"
 
 #include <dxgi1_4.h>
-#include <shared_mutex>
 #include "detours/detours.h"
 #include <ffx_framegeneration.h>
 #include <ankerl/unordered_dense.h>
@@ -39,8 +45,8 @@
 
 static ankerl::unordered_dense::map<unsigned int, ContextData<IFeature_Dx12>> Dx12Contexts;
 
-static ankerl::unordered_dense::map<ID3D12GraphicsCommandList*, ID3D12RootSignature*> computeSignatures;
-static ankerl::unordered_dense::map<ID3D12GraphicsCommandList*, ID3D12RootSignature*> graphicSignatures;
+using RootSignatures = RootSignatureTracker<>;
+static RootSignatures rootSignatures;
 static ID3D12Device* D3D12Device = nullptr;
 static int evalCounter = 0;
 static std::wstring appDataPath = L".";
@@ -110,6 +116,230 @@ static bool CreateBufferResource(LPCWSTR Name, ID3D12Device* InDevice, ID3D12Res
     return true;
 }
 
+#pragma region Backend Change
+
+// Copies the creation values of the current feature to createParams of the context
+static void PrepareCreateParams(ContextData<IFeature_Dx12>* deviceContext, NVSDK_NGX_Parameter* InParameters,
+                                const std::string& backend)
+{
+    auto dc = deviceContext->feature.get();
+
+    if (backend != "dlssd" && backend != "dlss")
+        deviceContext->createParams = GetNGXParameters("OptiDx12");
+    else
+        deviceContext->createParams = InParameters;
+
+    deviceContext->createParams->Set(NVSDK_NGX_Parameter_DLSS_Feature_Create_Flags, dc->GetFeatureFlags());
+    deviceContext->createParams->Set(NVSDK_NGX_Parameter_Width, dc->RenderWidth());
+    deviceContext->createParams->Set(NVSDK_NGX_Parameter_Height, dc->RenderHeight());
+    deviceContext->createParams->Set(NVSDK_NGX_Parameter_OutWidth, dc->DisplayWidth());
+    deviceContext->createParams->Set(NVSDK_NGX_Parameter_OutHeight, dc->DisplayHeight());
+    deviceContext->createParams->Set(NVSDK_NGX_Parameter_PerfQualityValue, dc->PerfQualityValue());
+}
+
+static void ReleaseCreateParams(ContextData<IFeature_Dx12>* deviceContext)
+{
+    // if opti nvparam release it
+    int optiParam = 0;
+    if (deviceContext->createParams != nullptr &&
+        deviceContext->createParams->Get("OptiScaler", &optiParam) == NVSDK_NGX_Result_Success && optiParam == 1)
+    {
+        free(deviceContext->createParams);
+    }
+
+    deviceContext->createParams = nullptr;
+}
+
+// DLSS Enabler backend index, -1 when backend has none
+static int EnablerBackendIndex(const std::string& backend)
+{
+    // backend selection
+    // 0 : XeSS
+    // 1 : FSR2.2
+    // 2 : FSR2.1
+    // 3 : DLSS
+    // 4 : FSR3.1
+    if (backend == "xess")
+        return 0;
+
+    if (backend == "fsr22")
+        return 1;
+
+    if (backend == "fsr21")
+        return 2;
+
+    if (backend == "dlss")
+        return 3;
+
+    if (backend == "fsr31")
+        return 4;
+
+    return -1;
+}
+
+// Creates the feature object of backend without initializing it, unknown backends are created as XeSS
+static std::unique_ptr<IFeature_Dx12> CreateFeature(std::string& backend, unsigned int handleId,
+                                                    NVSDK_NGX_Parameter* params)
+{
+    if (backend == "fsr22")
+    {
+        LOG_INFO("creating new FSR 2.2.1 feature");
+        return std::make_unique<FSR2FeatureDx12>(handleId, params);
+    }
+
+    if (backend == "fsr21")
+    {
+        LOG_INFO("creating new FSR 2.1.2 feature");
+        return std::make_unique<FSR2FeatureDx12_212>(handleId, params);
+    }
+
+    if (backend == "dlss")
+    {
+        LOG_INFO("creating new DLSS feature");
+        return std::make_unique<DLSSFeatureDx12>(handleId, params);
+    }
+
+    if (backend == "dlssd")
+    {
+        LOG_INFO("creating new DLSSD feature");
+        return std::make_unique<DLSSDFeatureDx12>(handleId, params);
+    }
+
+    if (backend == "fsr31")
+    {
+        LOG_INFO("creating new FSR 3.X feature");
+        return std::make_unique<FSR31FeatureDx12>(handleId, params);
+    }
+
+    backend = "xess";
+    LOG_INFO("creating new XeSS feature");
+    return std::make_unique<XeSSFeatureDx12>(handleId, params);
+}
+
+// Runs on the warm-up worker thread
+static bool InitFeature(IFeature_Dx12& feature, const std::string& backend, NVSDK_NGX_Parameter* params,
+                        ID3D12Device* device)
+{
+    if (feature.Init(device, nullptr, params))
+        return true;
+
+    LOG_ERROR("background init failed for {}", backend);
+    return false;
+}
+
+// Only backends which don't record anything while initializing can be built on a worker thread,
+// DLSS/DLSSD need the command list for CreateFeature
+static bool CanWarmUp(ContextData<IFeature_Dx12>* deviceContext, const std::string& backend)
+{
+    if (backend != "fsr21" && backend != "fsr22" && backend != "fsr31" && backend != "xess")
+        return false;
+
+    // Old feature needs to be working to render meanwhile and retired safely after the swap
+    return deviceContext->changeBackendCounter == 0 && deviceContext->feature != nullptr &&
+           deviceContext->feature->IsInited() && DeferredRelease_Dx12::IsActive() && D3D12Device != nullptr;
+}
+
+static bool StartWarmup(ContextData<IFeature_Dx12>* deviceContext, unsigned int handleId,
+                        NVSDK_NGX_Parameter* InParameters, const std::string& backend)
+{
+    if (deviceContext->warmup == nullptr)
+        deviceContext->warmup = std::make_unique<BackendWarmup<IFeature_Dx12>>();
+
+    PrepareCreateParams(deviceContext, InParameters, backend);
+
+    auto device = D3D12Device;
+    auto params = deviceContext->createParams;
+    auto name = backend;
+
+    // Constructor reads State/Config so it runs here, Init keeps its shared work until the swap
+    auto feature = CreateFeature(name, handleId, params);
+    feature->DeferShared();
+
+    auto started =
+        deviceContext->warmup->Start(name, std::move(feature), [name, params, device](IFeature_Dx12& feature)
+                                     { return InitFeature(feature, name, params, device); });
+
+    if (!started)
+    {
+        ReleaseCreateParams(deviceContext);
+        return false;
+    }
+
+    LOG_INFO("warming up {} in background, current feature keeps rendering", backend);
+    return true;
+}
+
+// Called every frame while a warm-up is active, swaps the features when the new one is ready
+static void UpdateWarmup(ContextData<IFeature_Dx12>* deviceContext, unsigned int handleId,
+                         NVSDK_NGX_Parameter* InParameters)
+{
+    auto warmup = deviceContext->warmup.get();
+    auto backend = warmup->Backend();
+
+    if (warmup->TakeFailed())
+    {
+        ReleaseCreateParams(deviceContext);
+
+        // Same fallback with the inline path, next frame starts it
+        if (backend != "fsr21")
+        {
+            LOG_WARN("warm-up of {} failed, trying fsr21", backend);
+            State::Instance().newBackend = "fsr21";
+            InParameters->Set("DLSSEnabler.Dx12Backend", 2);
+        }
+        else
+        {
+            LOG_ERROR("warm-up of {} failed, keeping current feature", backend);
+            State::Instance().newBackend = "";
+            State::Instance().changeBackend[handleId] = false;
+        }
+
+        return;
+    }
+
+    // Frames which are still in flight were recorded with the previous feature, when its release can't
+    // be deferred it keeps rendering and the swap is tried again next frame
+    auto swapped = warmup->TrySwap(deviceContext->feature, [](std::unique_ptr<IFeature_Dx12>& previous)
+                                   { return DeferredRelease_Dx12::Defer(previous, "Replaced feature"); });
+
+    if (!swapped)
+        return;
+
+    // Writes of Init to State/Config and the helpers it creates
+    deviceContext->feature->ApplyShared();
+
+    if (State::Instance().currentFG != nullptr && State::Instance().currentFG->IsActive())
+    {
+        State::Instance().currentFG->StopAndDestroyContext(false, false, false);
+        Hudfix_Dx12::ResetCounters();
+        State::Instance().FGchanged = true;
+        State::Instance().ClearCapturedHudlesses = true;
+    }
+
+    Config::Instance()->Dx12Upscaler = backend;
+
+    if (auto upscalerChoice = EnablerBackendIndex(backend); upscalerChoice >= 0)
+        InParameters->Set("DLSSEnabler.Dx12Backend", upscalerChoice);
+
+    // Another backend might be selected while this one was building
+    if (State::Instance().newBackend == backend)
+    {
+        State::Instance().newBackend = "";
+        State::Instance().changeBackend[handleId] = false;
+    }
+
+    ReleaseCreateParams(deviceContext);
+    evalCounter = 0;
+
+    State::Instance().currentFeature = deviceContext->feature.get();
+    if (State::Instance().currentFG != nullptr)
+        State::Instance().currentFG->UpdateTarget();
+
+    LOG_INFO("swapped to {} after background init", backend);
+}
+
+#pragma endregion
+
 #pragma region Hooks
 
 typedef void (*PFN_SetComputeRootSignature)(ID3D12GraphicsCommandList* commandList,
@@ -121,8 +351,6 @@ static PFN_SetComputeRootSignature orgSetComputeRootSignature = nullptr;
 static PFN_SetComputeRootSignature orgSetGraphicRootSignature = nullptr;
 
 static bool contextRendering = false;
-static std::shared_mutex computeSigatureMutex;
-static std::shared_mutex graphSigatureMutex;
 
 static IID streamlineRiid {};
 
@@ -141,8 +369,7 @@ static void hkSetComputeRootSignature(ID3D12GraphicsCommandList* commandList, ID
     if (Config::Instance()->RestoreComputeSignature.value_or_default() && !contextRendering && commandList != nullptr &&
         pRootSignature != nullptr)
     {
-        std::unique_lock<std::shared_mutex> lock(computeSigatureMutex);
-        computeSignatures.insert_or_assign(commandList, pRootSignature);
+        rootSignatures.Set(commandList, RootSignatures::Kind::Compute, pRootSignature);
     }
 
     orgSetComputeRootSignature(commandList, pRootSignature);
@@ -153,8 +380,7 @@ static void hkSetGraphicRootSignature(ID3D12GraphicsCommandList* commandList, ID
     if (Config::Instance()->RestoreGraphicSignature.value_or_default() && !contextRendering && commandList != nullptr &&
         pRootSignature != nullptr)
     {
-        std::unique_lock<std::shared_mutex> lock(graphSigatureMutex);
-        graphicSignatures.insert_or_assign(commandList, pRootSignature);
+        rootSignatures.Set(commandList, RootSignatures::Kind::Graphic, pRootSignature);
     }
 
     orgSetGraphicRootSignature(commandList, pRootSignature);
@@ -286,32 +512,10 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_Init_Ext(unsigned long long InApp
     State::Instance().api = DX12;
     State::Instance().currentD3D12Device = InDevice;
 
-    if (!State::Instance().isWorkingAsNvngx && HooksDx::queryHeap == nullptr)
+    if (!State::Instance().isWorkingAsNvngx)
     {
-        // Create query heap for timestamp queries
-        D3D12_QUERY_HEAP_DESC queryHeapDesc = {};
-        queryHeapDesc.Count = 2; // Start and End timestamps
-        queryHeapDesc.NodeMask = 0;
-        queryHeapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
-        auto result = InDevice->CreateQueryHeap(&queryHeapDesc, IID_PPV_ARGS(&HooksDx::queryHeap));
-
-        if (result != S_OK)
-        {
-            LOG_ERROR("CreateQueryHeap error: {:X}", (UINT) result);
-        }
-        else
-        {
-            // Create a readback buffer to retrieve timestamp data
-            D3D12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(2 * sizeof(UINT64));
-            D3D12_HEAP_PROPERTIES heapProps = {};
-            heapProps.Type = D3D12_HEAP_TYPE_READBACK;
-            result = InDevice->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &bufferDesc,
-                                                       D3D12_RESOURCE_STATE_COPY_DEST, nullptr,
-                                                       IID_PPV_ARGS(&HooksDx::readbackBuffer));
-
-            if (result != S_OK)
-                LOG_ERROR("CreateCommittedResource error: {:X}", (UINT) result);
-        }
+        GpuTimer_Dx12::Init(InDevice);
+        DeferredRelease_Dx12::Init(InDevice);
     }
 
     // early hooking for signatures
@@ -486,6 +690,11 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_Shutdown(void)
 
     State::Instance().currentFeature = nullptr;
 
+    TransientPool_Dx12::Shutdown();
+    DescriptorRing_Dx12::Shutdown();
+    DeferredRelease_Dx12::Flush();
+    ShaderCache_Dx12::Save();
+
     // Unhooking and cleaning stuff causing issues during shutdown.
     // Disabled for now to check if it cause any issues
     // UnhookAll();
@@ -893,9 +1102,12 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_CreateFeature(ID3D12GraphicsComma
     if (Config::Instance()->RestoreComputeSignature.value_or_default() ||
         Config::Instance()->RestoreGraphicSignature.value_or_default())
     {
-        if (Config::Instance()->RestoreComputeSignature.value_or_default() && computeSignatures.contains(InCmdList))
+        auto computeSignature = rootSignatures.Get(InCmdList, RootSignatures::Kind::Compute);
+        auto graphicSignature = rootSignatures.Get(InCmdList, RootSignatures::Kind::Graphic);
+
+        if (Config::Instance()->RestoreComputeSignature.value_or_default() && computeSignature != nullptr)
         {
-            auto signature = computeSignatures[InCmdList];
+            auto signature = (ID3D12RootSignature*) computeSignature;
             LOG_TRACE("restore ComputeRootSig: {0:X}", (UINT64) signature);
             orgSetComputeRootSignature(InCmdList, signature);
         }
@@ -904,9 +1116,9 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_CreateFeature(ID3D12GraphicsComma
             LOG_TRACE("can't restore ComputeRootSig");
         }
 
-        if (Config::Instance()->RestoreGraphicSignature.value_or_default() && graphicSignatures.contains(InCmdList))
+        if (Config::Instance()->RestoreGraphicSignature.value_or_default() && graphicSignature != nullptr)
         {
-            auto signature = graphicSignatures[InCmdList];
+            auto signature = (ID3D12RootSignature*) graphicSignature;
             LOG_TRACE("restore GraphicRootSig: {0:X}", (UINT64) signature);
             orgSetGraphicRootSignature(InCmdList, signature);
         }
@@ -971,6 +1183,13 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_ReleaseFeature(NVSDK_NGX_Handle*
         return DLSSGMod::D3D12_ReleaseFeature(InHandle);
     }
 
+    if (auto& context = Dx12Contexts[handleId]; context.warmup != nullptr && context.warmup->IsActive())
+    {
+        LOG_INFO("cancelling background init of {}", context.warmup->Backend());
+        context.warmup->Cancel();
+        ReleaseCreateParams(&context);
+    }
+
     if (auto deviceContext = Dx12Contexts[handleId].feature.get(); deviceContext != nullptr)
     {
         if (deviceContext == State::Instance().currentFeature)
@@ -979,7 +1198,9 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_ReleaseFeature(NVSDK_NGX_Handle*
             deviceContext->Shutdown();
         }
 
-        Dx12Contexts[handleId].feature.reset();
+        if (shutdown || !DeferredRelease_Dx12::Defer(Dx12Contexts[handleId].feature, "Released feature"))
+            Dx12Contexts[handleId].feature.reset();
+
         auto it = std::find_if(Dx12Contexts.begin(), Dx12Contexts.end(),
                                [&handleId](const auto& p) { return p.first == handleId; });
         Dx12Contexts.erase(it);
@@ -1052,12 +1273,24 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
         return NVSDK_NGX_Result_Fail;
     }
 
-    LOG_DEBUG("Handle: {}, CmdList: {:X}", InFeatureHandle->Id, (size_t) InCmdList);
+    LOG_DEBUG_DEFERRED("Handle: {}, CmdList: {:X}", InFeatureHandle->Id, (size_t) InCmdList);
     auto handleId = InFeatureHandle->Id;
+    auto frameConfig = FrameConfig::Get();
+
+    // Features which were replaced or released are destroyed here when GPU is done with them
+    DeferredRelease_Dx12::Collect();
+    rootSignatures.NextFrame();
+
+    if (static bool fullLogged = false; !fullLogged && rootSignatures.WasFull())
+    {
+        fullLogged = true;
+        LOG_WARN("Root signature table is full, {} command lists are tracked with a lock",
+                 rootSignatures.OverflowCount());
+    }
 
     if (handleId < DLSS_MOD_ID_OFFSET)
     {
-        if (Config::Instance()->DLSSEnabled.value_or_default() && NVNGXProxy::D3D12_EvaluateFeature() != nullptr)
+        if (frameConfig->DLSSEnabled && NVNGXProxy::D3D12_EvaluateFeature() != nullptr)
         {
             LOG_DEBUG("D3D12_EvaluateFeature for ({0})", handleId);
             auto result = NVNGXProxy::D3D12_EvaluateFeature()(InCmdList, InFeatureHandle, InParameters, InCallback);
@@ -1119,7 +1352,7 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
         // Fixes an issue with the depth being corrupted on AMD under Windows
         ID3D12Resource* dlssgDepth = nullptr;
 
-        if (Config::Instance()->MakeDepthCopy.value_or_default())
+        if (frameConfig->MakeDepthCopy)
             InParameters->Get("DLSSG.Depth", &dlssgDepth);
 
         if (dlssgDepth)
@@ -1183,7 +1416,7 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
     State::Instance().setInputApiName.clear();
 
     evalCounter++;
-    if (Config::Instance()->SkipFirstFrames.has_value() && evalCounter < Config::Instance()->SkipFirstFrames.value())
+    if (frameConfig->SkipFirstFrames.has_value() && evalCounter < frameConfig->SkipFirstFrames.value())
         return NVSDK_NGX_Result_Success;
 
     if (InCallback)
@@ -1263,11 +1496,23 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
             State::Instance().changeBackend[handleId] = true;
     }
 
+    // New backend is built in background while the current one keeps rendering
+    if (deviceContext->warmup != nullptr && deviceContext->warmup->IsActive())
+    {
+        UpdateWarmup(deviceContext, handleId, InParameters);
+    }
+    else if (State::Instance().changeBackend[handleId] && CanWarmUp(deviceContext, State::Instance().newBackend))
+    {
+        LOG_INFO("changing backend to {0}", State::Instance().newBackend);
+        StartWarmup(deviceContext, handleId, InParameters, State::Instance().newBackend);
+    }
+
     // Change backend
-    if (State::Instance().changeBackend[handleId])
+    if (State::Instance().changeBackend[handleId] &&
+        (deviceContext->warmup == nullptr || !deviceContext->warmup->IsActive()))
     {
         if (State::Instance().newBackend == "" ||
-            (!Config::Instance()->DLSSEnabled.value_or_default() && State::Instance().newBackend == "dlss"))
+            (!frameConfig->DLSSEnabled && State::Instance().newBackend == "dlss"))
             State::Instance().newBackend = Config::Instance()->Dx12Upscaler.value_or_default();
 
         deviceContext->changeBackendCounter++;
@@ -1289,23 +1534,20 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
             {
                 LOG_INFO("changing backend to {0}", State::Instance().newBackend);
 
-                auto dc = deviceContext->feature.get();
-
-                if (State::Instance().newBackend != "dlssd" && State::Instance().newBackend != "dlss")
-                    deviceContext->createParams = GetNGXParameters("OptiDx12");
-                else
-                    deviceContext->createParams = InParameters;
-
-                deviceContext->createParams->Set(NVSDK_NGX_Parameter_DLSS_Feature_Create_Flags, dc->GetFeatureFlags());
-                deviceContext->createParams->Set(NVSDK_NGX_Parameter_Width, dc->RenderWidth());
-                deviceContext->createParams->Set(NVSDK_NGX_Parameter_Height, dc->RenderHeight());
-                deviceContext->createParams->Set(NVSDK_NGX_Parameter_OutWidth, dc->DisplayWidth());
-                deviceContext->createParams->Set(NVSDK_NGX_Parameter_OutHeight, dc->DisplayHeight());
-                deviceContext->createParams->Set(NVSDK_NGX_Parameter_PerfQualityValue, dc->PerfQualityValue());
-
-                dc = nullptr;
+                PrepareCreateParams(deviceContext, InParameters, State::Instance().newBackend);
 
-                if (State::Instance().gameQuirks & GameQuirk::FastFeatureReset)
+                // Old feature stays alive until the frames which used it are completed on the GPU
+                if (DeferredRelease_Dx12::Defer(deviceContext->feature, "Replaced feature"))
+                {
+                    LOG_DEBUG("reset of current feature is deferred");
+                }
+                else if (!deviceContext->feature->IsInited())
+                {
+                    // Init failed, nothing was recorded with it
+                    LOG_DEBUG("current feature was not inited, resetting at once");
+                }
+                // No present with a queue seen yet, there is no fence which tells when the GPU is done with it
+                else if (State::Instance().gameQuirks & GameQuirk::FastFeatureReset)
                 {
                     LOG_DEBUG("sleeping before reset of current feature for 100ms (Fast Feature Reset)");
                     std::this_thread::sleep_for(std::chrono::milliseconds(100));
@@ -1347,55 +1589,13 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
         // create new feature
         if (deviceContext->changeBackendCounter == 2)
         {
-            // backend selection
-            // 0 : XeSS
-            // 1 : FSR2.2
-            // 2 : FSR2.1
-            // 3 : DLSS
-            // 4 : FSR3.1
-            int upscalerChoice = -1;
-
             // prepare new upscaler
-            if (State::Instance().newBackend == "fsr22")
-            {
-                Config::Instance()->Dx12Upscaler = "fsr22";
-                LOG_INFO("creating new FSR 2.2.1 feature");
-                deviceContext->feature = std::make_unique<FSR2FeatureDx12>(handleId, deviceContext->createParams);
-                upscalerChoice = 1;
-            }
-            else if (State::Instance().newBackend == "fsr21")
-            {
-                Config::Instance()->Dx12Upscaler = "fsr21";
-                LOG_INFO("creating new FSR 2.1.2 feature");
-                deviceContext->feature = std::make_unique<FSR2FeatureDx12_212>(handleId, deviceContext->createParams);
-                upscalerChoice = 2;
-            }
-            else if (State::Instance().newBackend == "dlss")
-            {
-                Config::Instance()->Dx12Upscaler = "dlss";
-                LOG_INFO("creating new DLSS feature");
-                deviceContext->feature = std::make_unique<DLSSFeatureDx12>(handleId, deviceContext->createParams);
-                upscalerChoice = 3;
-            }
-            else if (State::Instance().newBackend == "dlssd")
-            {
-                LOG_INFO("creating new DLSSD feature");
-                deviceContext->feature = std::make_unique<DLSSDFeatureDx12>(handleId, deviceContext->createParams);
-            }
-            else if (State::Instance().newBackend == "fsr31")
-            {
-                Config::Instance()->Dx12Upscaler = "fsr31";
-                LOG_INFO("creating new FSR 3.X feature");
-                deviceContext->feature = std::make_unique<FSR31FeatureDx12>(handleId, deviceContext->createParams);
-                upscalerChoice = 4;
-            }
-            else
-            {
-                Config::Instance()->Dx12Upscaler = "xess";
-                LOG_INFO("creating new XeSS feature");
-                deviceContext->feature = std::make_unique<XeSSFeatureDx12>(handleId, deviceContext->createParams);
-                upscalerChoice = 0;
-            }
+            deviceContext->feature = CreateFeature(State::Instance().newBackend, handleId, deviceContext->createParams);
+
+            if (State::Instance().newBackend != "dlssd")
+                Config::Instance()->Dx12Upscaler = State::Instance().newBackend;
+
+            auto upscalerChoice = EnablerBackendIndex(State::Instance().newBackend);
 
             if (upscalerChoice >= 0)
                 InParameters->Set("DLSSEnabler.Dx12Backend", upscalerChoice);
@@ -1445,14 +1645,7 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
                 evalCounter = 0;
             }
 
-            // if opti nvparam release it
-            int optiParam = 0;
-            if (deviceContext->createParams->Get("OptiScaler", &optiParam) == NVSDK_NGX_Result_Success &&
-                optiParam == 1)
-            {
-                free(deviceContext->createParams);
-                deviceContext->createParams = nullptr;
-            }
+            ReleaseCreateParams(deviceContext);
         }
 
         // if initial feature can't be inited
@@ -1480,8 +1673,8 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
     State::Instance().currentFeature = deviceContext->feature.get();
 
     // Root signature restore
-    if (deviceContext->feature->Name() != "DLSSD" && (Config::Instance()->RestoreComputeSignature.value_or_default() ||
-                                                      Config::Instance()->RestoreGraphicSignature.value_or_default()))
+    if (deviceContext->feature->Name() != "DLSSD" &&
+        (frameConfig->RestoreComputeSignature || frameConfig->RestoreGraphicSignature))
         contextRendering = true;
 
     IFGFeature_Dx12* fg = nullptr;
@@ -1489,10 +1682,10 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
         fg = State::Instance().currentFG;
 
     // FG Init || Disable
-    if (State::Instance().activeFgType == OptiFG && Config::Instance()->OverlayMenu.value_or_default())
+    if (State::Instance().activeFgType == OptiFG && frameConfig->OverlayMenu)
     {
-        if (!State::Instance().FGchanged && Config::Instance()->FGEnabled.value_or_default() && !fg->IsPaused() &&
-            FfxApiProxy::InitFfxDx12() && !fg->IsActive() && HooksDx::CurrentSwapchainFormat() != DXGI_FORMAT_UNKNOWN)
+        if (!State::Instance().FGchanged && frameConfig->FGEnabled && !fg->IsPaused() && FfxApiProxy::InitFfxDx12() &&
+            !fg->IsActive() && HooksDx::CurrentSwapchainFormat() != DXGI_FORMAT_UNKNOWN)
         {
             fg->CreateObjects(D3D12Device);
             fg->CreateContext(D3D12Device, deviceContext->feature->GetFeatureFlags(),
@@ -1500,8 +1693,7 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
             fg->ResetCounters();
             fg->UpdateTarget();
         }
-        else if ((!Config::Instance()->FGEnabled.value_or_default() || State::Instance().FGchanged) && fg != nullptr &&
-                 fg->IsActive())
+        else if ((!frameConfig->FGEnabled || State::Instance().FGchanged) && fg != nullptr && fg->IsActive())
         {
             fg->StopAndDestroyContext(State::Instance().SCchanged, false, false);
             State::Instance().ClearCapturedHudlesses = true;
@@ -1534,39 +1726,38 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
     float mvScaleY = 0.0f;
 
     {
-        if (!Config::Instance()->FsrUseFsrInputValues.value_or_default() ||
+        if (!frameConfig->FsrUseFsrInputValues ||
             InParameters->Get("FSR.cameraNear", &cameraNear) != NVSDK_NGX_Result_Success)
         {
             if (deviceContext->feature->DepthInverted())
-                cameraFar = Config::Instance()->FsrCameraNear.value_or_default();
+                cameraFar = frameConfig->FsrCameraNear;
             else
-                cameraNear = Config::Instance()->FsrCameraNear.value_or_default();
+                cameraNear = frameConfig->FsrCameraNear;
         }
 
-        if (!Config::Instance()->FsrUseFsrInputValues.value_or_default() ||
+        if (!frameConfig->FsrUseFsrInputValues ||
             InParameters->Get("FSR.cameraFar", &cameraFar) != NVSDK_NGX_Result_Success)
         {
             if (deviceContext->feature->DepthInverted())
-                cameraNear = Config::Instance()->FsrCameraFar.value_or_default();
+                cameraNear = frameConfig->FsrCameraFar;
             else
-                cameraFar = Config::Instance()->FsrCameraFar.value_or_default();
+                cameraFar = frameConfig->FsrCameraFar;
         }
 
-        if (!Config::Instance()->FsrUseFsrInputValues.value_or_default() ||
+        if (!frameConfig->FsrUseFsrInputValues ||
             InParameters->Get("FSR.cameraFovAngleVertical", &cameraVFov) != NVSDK_NGX_Result_Success)
         {
-            if (Config::Instance()->FsrVerticalFov.has_value())
-                cameraVFov = Config::Instance()->FsrVerticalFov.value() * 0.0174532925199433f;
-            else if (Config::Instance()->FsrHorizontalFov.value_or_default() > 0.0f)
-                cameraVFov =
-                    2.0f * atan((tan(Config::Instance()->FsrHorizontalFov.value() * 0.0174532925199433f) * 0.5f) /
-                                (float) deviceContext->feature->TargetHeight() *
-                                (float) deviceContext->feature->TargetWidth());
+            if (frameConfig->FsrVerticalFovSet)
+                cameraVFov = frameConfig->FsrVerticalFov * 0.0174532925199433f;
+            else if (frameConfig->FsrHorizontalFov > 0.0f)
+                cameraVFov = 2.0f * atan((tan(frameConfig->FsrHorizontalFov * 0.0174532925199433f) * 0.5f) /
+                                         (float) deviceContext->feature->TargetHeight() *
+                                         (float) deviceContext->feature->TargetWidth());
             else
                 cameraVFov = 1.0471975511966f;
         }
 
-        if (!Config::Instance()->FsrUseFsrInputValues.value_or_default())
+        if (!frameConfig->FsrUseFsrInputValues)
             InParameters->Get("FSR.viewSpaceToMetersFactor", &meterFactor);
 
         State::Instance().lastFsrCameraFar = cameraFar;
@@ -1598,9 +1789,8 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
 
     UINT frameIndex;
     if (!State::Instance().isShuttingDown && fg != nullptr && fg->IsActive() &&
-        State::Instance().activeFgType == OptiFG && Config::Instance()->OverlayMenu.value_or_default() &&
-        Config::Instance()->FGEnabled.value_or_default() && !fg->IsPaused() &&
-        State::Instance().currentSwapchain != nullptr)
+        State::Instance().activeFgType == OptiFG && frameConfig->OverlayMenu && frameConfig->FGEnabled &&
+        !fg->IsPaused() && State::Instance().currentSwapchain != nullptr)
     {
         // Wait for present
         if (fg->Mutex.getOwner() == 2)
@@ -1638,9 +1828,12 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
             InParameters->Get(NVSDK_NGX_Parameter_MotionVectors, (void**) &paramVelocity);
 
         if (paramVelocity != nullptr)
+        {
+            GpuTimer_Dx12::Scope timer(commandList, GpuPass::InputCopy);
             fg->SetVelocity(commandList, paramVelocity,
-                            (D3D12_RESOURCE_STATES) Config::Instance()->MVResourceBarrier.value_or(
+                            (D3D12_RESOURCE_STATES) frameConfig->MVResourceBarrier.value_or(
                                 D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE));
+        }
 
         ID3D12Resource* paramDepth = nullptr;
         if (InParameters->Get(NVSDK_NGX_Parameter_Depth, &paramDepth) != NVSDK_NGX_Result_Success)
@@ -1650,7 +1843,7 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
         {
             auto done = false;
 
-            if (Config::Instance()->FGEnableDepthScale.value_or_default())
+            if (frameConfig->FGEnableDepthScale)
             {
                 if (DepthScale == nullptr)
                     DepthScale = new DS_Dx12("Depth Scale", D3D12Device);
@@ -1665,6 +1858,8 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
                     if (DepthScale->Dispatch(D3D12Device, InCmdList, paramDepth, DepthScale->Buffer()))
                     {
                         DepthScale->SetBufferState(InCmdList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+
+                        GpuTimer_Dx12::Scope timer(commandList, GpuPass::InputCopy);
                         fg->SetDepth(commandList, DepthScale->Buffer(), D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
                         done = true;
                     }
@@ -1672,11 +1867,17 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
             }
 
             if (!done)
+            {
+                GpuTimer_Dx12::Scope timer(commandList, GpuPass::InputCopy);
                 fg->SetDepth(commandList, paramDepth,
-                             (D3D12_RESOURCE_STATES) Config::Instance()->DepthResourceBarrier.value_or(
+                             (D3D12_RESOURCE_STATES) frameConfig->DepthResourceBarrier.value_or(
                                  D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE));
+            }
         }
 
+        // Velocity and depth go back to the game's states with one barrier call
+        fg->FlushBarriers();
+
 #ifdef USE_COPY_QUEUE_FOR_FG
         auto result = FrameGen_Dx12::fgCopyCommandList[frameIndex]->Close();
         ID3D12CommandList* cl[] = { nullptr };
@@ -1687,35 +1888,24 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
         LOG_DEBUG("(FG) copy buffers done, frame: {0}", fg->FrameCount());
     }
 
-    // Record the first timestamp
-    if (!State::Instance().isWorkingAsNvngx && HooksDx::queryHeap != nullptr)
-        InCmdList->EndQuery(HooksDx::queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, 0);
-
     // Run upscaler
+    auto upscalerTimer = GpuTimer_Dx12::Begin(InCmdList, GpuPass::Upscaler);
     auto evalResult = deviceContext->feature->Evaluate(InCmdList, InParameters);
+    GpuTimer_Dx12::End(upscalerTimer);
 
-    // Record the second timestamp
-    if (!State::Instance().isWorkingAsNvngx && HooksDx::queryHeap != nullptr)
-    {
-        InCmdList->EndQuery(HooksDx::queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, 1);
-
-        // Resolve the queries to the readback buffer
-        InCmdList->ResolveQueryData(HooksDx::queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, 0, 2, HooksDx::readbackBuffer, 0);
-    }
+    // Upscalers can change options (RCAS, barriers etc.) while evaluating
+    frameConfig = FrameConfig::Get();
 
     NVSDK_NGX_Result methodResult = NVSDK_NGX_Result_Fail;
 
     // FG Dispatch
     if (evalResult)
     {
-        HooksDx::dx12UpscaleTrig = true;
-
         // FG Dispatch
-        if (fg != nullptr && fg->IsActive() && State::Instance().activeFgType == OptiFG &&
-            Config::Instance()->OverlayMenu.value_or_default() && Config::Instance()->FGEnabled.value_or_default() &&
-            !fg->IsPaused() && State::Instance().currentSwapchain != nullptr)
+        if (fg != nullptr && fg->IsActive() && State::Instance().activeFgType == OptiFG && frameConfig->OverlayMenu &&
+            frameConfig->FGEnabled && !fg->IsPaused() && State::Instance().currentSwapchain != nullptr)
         {
-            if (Config::Instance()->FGHUDFix.value_or_default())
+            if (frameConfig->FGHUDFix)
             {
                 // For signal after mv & depth copies
                 Hudfix_Dx12::UpscaleEnd(deviceContext->feature->FrameCount(), State::Instance().lastFrameTime);
@@ -1731,7 +1921,7 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
 
                 if (Hudfix_Dx12::CheckForHudless(
                         __FUNCTION__, InCmdList, &info,
-                        (D3D12_RESOURCE_STATES) Config::Instance()->OutputResourceBarrier.value_or(
+                        (D3D12_RESOURCE_STATES) frameConfig->OutputResourceBarrier.value_or(
                             D3D12_RESOURCE_STATE_UNORDERED_ACCESS),
                         true))
                 {
@@ -1749,27 +1939,30 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_D3D12_EvaluateFeature(ID3D12GraphicsCom
     }
 
     // Root signature restore
-    if (deviceContext->feature->Name() != "DLSSD" && (Config::Instance()->RestoreComputeSignature.value_or_default() ||
-                                                      Config::Instance()->RestoreGraphicSignature.value_or_default()))
+    if (deviceContext->feature->Name() != "DLSSD" &&
+        (frameConfig->RestoreComputeSignature || frameConfig->RestoreGraphicSignature))
     {
-        if (Config::Instance()->RestoreComputeSignature.value_or_default() && computeSignatures[InCmdList])
+        auto computeSignature = rootSignatures.Get(InCmdList, RootSignatures::Kind::Compute);
+        auto graphicSignature = rootSignatures.Get(InCmdList, RootSignatures::Kind::Graphic);
+
+        if (frameConfig->RestoreComputeSignature && computeSignature != nullptr)
         {
-            auto signature = computeSignatures[InCmdList];
+            auto signature = (ID3D12RootSignature*) computeSignature;
             LOG_TRACE("restore orgComputeRootSig: {0:X}", (UINT64) signature);
             orgSetComputeRootSignature(InCmdList, signature);
         }
-        else if (Config::Instance()->RestoreComputeSignature.value_or_default())
+        else if (frameConfig->RestoreComputeSignature)
         {
             LOG_WARN("Can't restore ComputeRootSig!");
         }
 
-        if (Config::Instance()->RestoreGraphicSignature.value_or_default() && graphicSignatures[InCmdList])
+        if (frameConfig->RestoreGraphicSignature && graphicSignature != nullptr)
         {
-            auto signature = graphicSignatures[InCmdList];
+            auto signature = (ID3D12RootSignature*) graphicSignature;
             LOG_TRACE("restore orgGraphicRootSig: {0:X}", (UINT64) signature);
             orgSetGraphicRootSignature(InCmdList, signature);
         }
-        else if (Config::Instance()->RestoreGraphicSignature.value_or_default())
+        else if (frameConfig->RestoreGraphicSignature)
         {
             LOG_WARN("Can't restore GraphicRootSig!");
         }
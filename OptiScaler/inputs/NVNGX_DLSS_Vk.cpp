@@ -890,8 +890,8 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_VULKAN_ReleaseFeature(NVSDK_NGX_Handle*
             deviceContext->Shutdown();
         }
 
+        // Retires every submitted use of the feature, no extra delay is needed after it
         vkDeviceWaitIdle(vkDevice);
-        std::this_thread::sleep_for(std::chrono::milliseconds(500));
 
         VkContexts[handleId].feature.reset();
         auto it = std::find_if(VkContexts.begin(), VkContexts.end(),
@@ -899,8 +899,6 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_VULKAN_ReleaseFeature(NVSDK_NGX_Handle*
         VkContexts.erase(it);
     }
 
-    std::this_thread::sleep_for(std::chrono::milliseconds(500));
-
     return NVSDK_NGX_Result_Success;
 }
 
@@ -1063,8 +1061,8 @@ NVSDK_NGX_API NVSDK_NGX_Result NVSDK_NGX_VULKAN_EvaluateFeature(VkCommandBuffer
 
                 dc = nullptr;
 
-                LOG_DEBUG("sleeping before reset of current feature for 1000ms");
-                std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+                // Retires every submitted use of the feature, like NVSDK_NGX_VULKAN_ReleaseFeature
+                vkDeviceWaitIdle(vkDevice);
 
                 VkContexts[handleId].feature.reset();
                 VkContexts[handleId].feature = nullptr;
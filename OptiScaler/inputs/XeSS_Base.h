@@ -1,20 +1,34 @@
 #pragma once
 
 #include "pch.h"
-#include <map>
+
+#include <misc/ContextRegistry.h>
 
 #include <xess_d3d12.h>
 #include <xess_vk.h>
 
+struct NVNGX_Parameters;
+
 typedef struct Scale
 {
     float x;
     float y;
 } scale;
 
-extern std::map<xess_context_handle_t, NVSDK_NGX_Parameter*> _nvParams;
-extern std::map<xess_context_handle_t, NVSDK_NGX_Handle*> _contexts;
-extern std::map<xess_context_handle_t, Scale> _motionScales;
-extern std::map<xess_context_handle_t, Scale> _jitterScales;
-extern std::map<xess_context_handle_t, xess_d3d12_init_params_t> _d3d12InitParams;
-extern std::map<xess_context_handle_t, xess_vk_init_params_t> _vkInitParams;
+struct XeSSContext
+{
+    NVSDK_NGX_Parameter* nvParams = nullptr;
+    NVNGX_Parameters* optiParams = nullptr;
+
+    // Created on first execute
+    NVSDK_NGX_Handle* nvHandle = nullptr;
+
+    Scale motionScale { 1.0f, 1.0f };
+    std::optional<Scale> jitterScale;
+
+    // Set by the init of the api the context is used with
+    std::optional<xess_d3d12_init_params_t> d3d12InitParams;
+    std::optional<xess_vk_init_params_t> vkInitParams;
+};
+
+extern ContextRegistry<xess_context_handle_t, XeSSContext> _xessContexts;
@@ -111,23 +111,18 @@ xess_result_t hk_xessDestroyContext(xess_context_handle_t hContext)
 {
     LOG_DEBUG("hContext: {}", (size_t) hContext);
 
-    if (!_contexts.contains(hContext))
+    auto context = _xessContexts.Find(hContext);
+
+    if (context == nullptr)
         return XESS_RESULT_ERROR_INVALID_CONTEXT;
 
-    if (_d3d12InitParams.contains(hContext))
-    {
-        NVSDK_NGX_D3D12_ReleaseFeature(_contexts[hContext]);
-        _d3d12InitParams.erase(hContext);
-    }
+    if (context->nvHandle != nullptr && context->d3d12InitParams.has_value())
+        NVSDK_NGX_D3D12_ReleaseFeature(context->nvHandle);
 
-    if (_vkInitParams.contains(hContext))
-    {
-        NVSDK_NGX_VULKAN_ReleaseFeature(_contexts[hContext]);
-        _vkInitParams.erase(hContext);
-    }
+    if (context->nvHandle != nullptr && context->vkInitParams.has_value())
+        NVSDK_NGX_VULKAN_ReleaseFeature(context->nvHandle);
 
-    _contexts.erase(hContext);
-    _nvParams.erase(hContext);
+    _xessContexts.Remove(hContext);
 
     return XESS_RESULT_SUCCESS;
 }
@@ -136,7 +131,12 @@ xess_result_t hk_xessSetVelocityScale(xess_context_handle_t hContext, float x, f
 {
     LOG_DEBUG("hContext: {}, x: {}, y: {}", (size_t) hContext, x, y);
 
-    _motionScales[hContext] = { x, y };
+    auto context = _xessContexts.Find(hContext);
+
+    if (context == nullptr)
+        return XESS_RESULT_ERROR_INVALID_CONTEXT;
+
+    context->motionScale = { x, y };
 
     return XESS_RESULT_SUCCESS;
 }
@@ -152,10 +152,12 @@ xess_result_t hk_xessGetExposureMultiplier(xess_context_handle_t hContext, float
 {
     LOG_DEBUG("");
 
-    if (!_nvParams.contains(hContext))
+    auto context = _xessContexts.Find(hContext);
+
+    if (context == nullptr)
         return XESS_RESULT_ERROR_INVALID_CONTEXT;
 
-    if (_nvParams[hContext]->Get(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, pScale) == NVSDK_NGX_Result_Success)
+    if (context->nvParams->Get(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, pScale) == NVSDK_NGX_Result_Success)
         return XESS_RESULT_SUCCESS;
 
     return XESS_RESULT_ERROR_UNKNOWN;
@@ -259,10 +261,12 @@ xess_result_t hk_xessGetJitterScale(xess_context_handle_t hContext, float* pX, f
 {
     LOG_DEBUG("");
 
-    if (!_jitterScales.contains(hContext))
+    auto context = _xessContexts.Find(hContext);
+
+    if (context == nullptr || !context->jitterScale.has_value())
         return XESS_RESULT_ERROR_INVALID_CONTEXT;
 
-    auto scales = &_jitterScales[hContext];
+    auto scales = &context->jitterScale.value();
 
     *pX = scales->x;
     *pY = scales->y;
@@ -363,10 +367,12 @@ xess_result_t hk_xessGetVelocityScale(xess_context_handle_t hContext, float* pX,
 {
     LOG_DEBUG("");
 
-    if (!_motionScales.contains(hContext))
+    auto context = _xessContexts.Find(hContext);
+
+    if (context == nullptr)
         return XESS_RESULT_ERROR_INVALID_CONTEXT;
 
-    auto scales = &_motionScales[hContext];
+    auto scales = &context->motionScale;
 
     *pX = scales->x;
     *pY = scales->y;
@@ -378,7 +384,12 @@ xess_result_t hk_xessSetJitterScale(xess_context_handle_t hContext, float x, flo
 {
     LOG_DEBUG("x: {}, y: {}", x, y);
 
-    _jitterScales[hContext] = { x, y };
+    auto context = _xessContexts.Find(hContext);
+
+    if (context == nullptr)
+        return XESS_RESULT_ERROR_INVALID_CONTEXT;
+
+    context->jitterScale = { x, y };
 
     return XESS_RESULT_SUCCESS;
 }
@@ -387,10 +398,12 @@ xess_result_t hk_xessSetExposureMultiplier(xess_context_handle_t hContext, float
 {
     LOG_DEBUG("");
 
-    if (!_nvParams.contains(hContext))
+    auto context = _xessContexts.Find(hContext);
+
+    if (context == nullptr)
         return XESS_RESULT_ERROR_INVALID_CONTEXT;
 
-    _nvParams[hContext]->Set(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, scale);
+    context->nvParams->Set(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, scale);
 
     return XESS_RESULT_SUCCESS;
 }
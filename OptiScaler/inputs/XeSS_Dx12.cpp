@@ -5,22 +5,21 @@
 #include <proxies/XeSS_Proxy.h>
 #include "menu/menu_overlay_dx.h"
 
-static UINT64 _handleCounter = 13370000;
 static UINT64 _frameCounter = 0;
 static xess_context_handle_t _currentContext = nullptr;
 static ID3D12Device* _d3d12Device = nullptr;
 
-static bool CreateDLSSContext(xess_context_handle_t handle, ID3D12GraphicsCommandList* commandList,
+static bool CreateDLSSContext(XeSSContext* context, ID3D12GraphicsCommandList* commandList,
                               const xess_d3d12_execute_params_t* pExecParams)
 {
     LOG_DEBUG("");
 
-    if (!_nvParams.contains(handle))
+    if (context->nvParams == nullptr)
         return false;
 
     NVSDK_NGX_Handle* nvHandle = nullptr;
-    auto params = _nvParams[handle];
-    auto initParams = &_d3d12InitParams[handle];
+    auto params = context->nvParams;
+    auto initParams = &context->d3d12InitParams.value();
 
     UINT initFlags = 0;
 
@@ -88,7 +87,7 @@ static bool CreateDLSSContext(xess_context_handle_t handle, ID3D12GraphicsComman
         NVSDK_NGX_Result_Success)
         return false;
 
-    _contexts[handle] = nvHandle;
+    context->nvHandle = nvHandle;
 
     return true;
 }
@@ -144,15 +143,15 @@ xess_result_t hk_xessD3D12CreateContext(ID3D12Device* pDevice, xess_context_hand
     }
 
     _d3d12Device = pDevice;
-    *phContext = (xess_context_handle_t) ++_handleCounter;
 
     NVSDK_NGX_Parameter* params = nullptr;
 
     if (NVSDK_NGX_D3D12_GetCapabilityParameters(&params) != NVSDK_NGX_Result_Success)
         return XESS_RESULT_ERROR_INVALID_ARGUMENT;
 
-    _nvParams[*phContext] = params;
-    _motionScales[*phContext] = { 1.0, 1.0 };
+    auto& context = _xessContexts.Create(*phContext);
+    context.nvParams = params;
+    context.optiParams = GetOptiParameters(params);
 
     return XESS_RESULT_SUCCESS;
 }
@@ -168,6 +167,11 @@ xess_result_t hk_xessD3D12Init(xess_context_handle_t hContext, const xess_d3d12_
 {
     LOG_DEBUG("");
 
+    auto context = _xessContexts.Find(hContext);
+
+    if (context == nullptr)
+        return XESS_RESULT_ERROR_INVALID_CONTEXT;
+
     xess_d3d12_init_params_t ip {};
     ip.bufferHeapOffset = pInitParams->bufferHeapOffset;
     ip.creationNodeMask = pInitParams->creationNodeMask;
@@ -180,13 +184,13 @@ xess_result_t hk_xessD3D12Init(xess_context_handle_t hContext, const xess_d3d12_
     ip.textureHeapOffset = pInitParams->textureHeapOffset;
     ip.visibleNodeMask = pInitParams->visibleNodeMask;
 
-    _d3d12InitParams[hContext] = ip;
+    context->d3d12InitParams = ip;
 
-    if (!_contexts.contains(hContext))
+    if (context->nvHandle == nullptr)
         return XESS_RESULT_SUCCESS;
 
-    NVSDK_NGX_D3D12_ReleaseFeature(_contexts[hContext]);
-    _contexts.erase(hContext);
+    NVSDK_NGX_D3D12_ReleaseFeature(context->nvHandle);
+    context->nvHandle = nullptr;
 
     return XESS_RESULT_SUCCESS;
 }
@@ -199,84 +203,86 @@ xess_result_t hk_xessD3D12Execute(xess_context_handle_t hContext, ID3D12Graphics
     if (pCommandList == nullptr)
         return XESS_RESULT_ERROR_INVALID_ARGUMENT;
 
-    if (!_contexts.contains(hContext) && !CreateDLSSContext(hContext, pCommandList, pExecParams))
+    auto context = _xessContexts.Find(hContext);
+
+    if (context == nullptr)
+        return XESS_RESULT_ERROR_INVALID_CONTEXT;
+
+    // Defaults when the game didn't call init
+    if (!context->d3d12InitParams.has_value())
+        context->d3d12InitParams.emplace();
+
+    if (context->nvHandle == nullptr && !CreateDLSSContext(context, pCommandList, pExecParams))
         return XESS_RESULT_ERROR_UNKNOWN;
 
-    NVSDK_NGX_Parameter* params = _nvParams[hContext];
-    NVSDK_NGX_Handle* handle = _contexts[hContext];
-    xess_d3d12_init_params_t* initParams = &_d3d12InitParams[hContext];
+    NVNGX_ParameterWriter params { context->nvParams, context->optiParams };
+    NVSDK_NGX_Handle* handle = context->nvHandle;
+    xess_d3d12_init_params_t* initParams = &context->d3d12InitParams.value();
+    auto scales = &context->motionScale;
 
-    if (_motionScales.contains(hContext))
+    if ((initParams->initFlags & XESS_INIT_FLAG_USE_NDC_VELOCITY))
     {
-        auto scales = &_motionScales[hContext];
-
-        if ((initParams->initFlags & XESS_INIT_FLAG_USE_NDC_VELOCITY))
+        if (initParams->initFlags & XESS_INIT_FLAG_HIGH_RES_MV)
         {
-            if (initParams->initFlags & XESS_INIT_FLAG_HIGH_RES_MV)
-            {
-                params->Set(NVSDK_NGX_Parameter_MV_Scale_X, initParams->outputResolution.x * 0.5 * scales->x);
-                params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, initParams->outputResolution.y * -0.5 * scales->y);
-            }
-            else
-            {
-                params->Set(NVSDK_NGX_Parameter_MV_Scale_X, pExecParams->inputWidth * 0.5 * scales->x);
-                params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, pExecParams->inputHeight * -0.5 * scales->y);
-            }
+            params.Set<NVSDK_NGX_Parameter_MV_Scale_X>(initParams->outputResolution.x * 0.5 * scales->x);
+            params.Set<NVSDK_NGX_Parameter_MV_Scale_Y>(initParams->outputResolution.y * -0.5 * scales->y);
         }
         else
         {
-            params->Set(NVSDK_NGX_Parameter_MV_Scale_X, scales->x);
-            params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, scales->y);
+            params.Set<NVSDK_NGX_Parameter_MV_Scale_X>(pExecParams->inputWidth * 0.5 * scales->x);
+            params.Set<NVSDK_NGX_Parameter_MV_Scale_Y>(pExecParams->inputHeight * -0.5 * scales->y);
         }
     }
+    else
+    {
+        params.Set<NVSDK_NGX_Parameter_MV_Scale_X>(scales->x);
+        params.Set<NVSDK_NGX_Parameter_MV_Scale_Y>(scales->y);
+    }
 
     float jitterScaleX = 1.0f;
     float jitterScaleY = 1.0f;
 
-    if (_jitterScales.contains(hContext))
+    if (context->jitterScale.has_value())
     {
-        auto scales = &_jitterScales[hContext];
-        jitterScaleX = scales->x;
-        jitterScaleY = scales->y;
+        jitterScaleX = context->jitterScale->x;
+        jitterScaleY = context->jitterScale->y;
     }
 
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, pExecParams->jitterOffsetX * jitterScaleX);
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, pExecParams->jitterOffsetY * jitterScaleY);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, pExecParams->exposureScale);
-    params->Set(NVSDK_NGX_Parameter_Reset, pExecParams->resetHistory);
-    params->Set(NVSDK_NGX_Parameter_Width, pExecParams->inputWidth);
-    params->Set(NVSDK_NGX_Parameter_Height, pExecParams->inputHeight);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width, pExecParams->inputWidth);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height, pExecParams->inputHeight);
-    params->Set(NVSDK_NGX_Parameter_Depth, pExecParams->pDepthTexture);
-    params->Set(NVSDK_NGX_Parameter_ExposureTexture, pExecParams->pExposureScaleTexture);
+    params.Set<NVSDK_NGX_Parameter_Jitter_Offset_X>(pExecParams->jitterOffsetX * jitterScaleX);
+    params.Set<NVSDK_NGX_Parameter_Jitter_Offset_Y>(pExecParams->jitterOffsetY * jitterScaleY);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Exposure_Scale>(pExecParams->exposureScale);
+    params.Set<NVSDK_NGX_Parameter_Reset>(pExecParams->resetHistory);
+    params.Set<NVSDK_NGX_Parameter_Width>(pExecParams->inputWidth);
+    params.Set<NVSDK_NGX_Parameter_Height>(pExecParams->inputHeight);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width>(pExecParams->inputWidth);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height>(pExecParams->inputHeight);
+    params.Set<NVSDK_NGX_Parameter_Depth>(pExecParams->pDepthTexture);
+    params.Set<NVSDK_NGX_Parameter_ExposureTexture>(pExecParams->pExposureScaleTexture);
 
     if (feature_version { XeSSProxy::Version().major, XeSSProxy::Version().minor, XeSSProxy::Version().patch } <
         feature_version { 2, 0, 1 })
-        params->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask, pExecParams->pResponsivePixelMaskTexture);
+        params.Set<NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask>(pExecParams->pResponsivePixelMaskTexture);
     else
-        params->Set("FSR.reactive", pExecParams->pResponsivePixelMaskTexture);
-
-    params->Set(NVSDK_NGX_Parameter_Color, pExecParams->pColorTexture);
-    params->Set(NVSDK_NGX_Parameter_MotionVectors, pExecParams->pVelocityTexture);
-    params->Set(NVSDK_NGX_Parameter_Output, pExecParams->pOutputTexture);
-
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Color_Subrect_Base_X, pExecParams->inputColorBase.x);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Color_Subrect_Base_Y, pExecParams->inputColorBase.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Depth_Subrect_Base_X, pExecParams->inputDepthBase.x);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Depth_Subrect_Base_Y, pExecParams->inputDepthBase.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_MV_SubrectBase_X, pExecParams->inputMotionVectorBase.x);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_MV_SubrectBase_Y, pExecParams->inputMotionVectorBase.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Output_Subrect_Base_X, pExecParams->outputColorBase.x);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Output_Subrect_Base_Y, pExecParams->outputColorBase.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_SubrectBase_X,
-                pExecParams->inputResponsiveMaskBase.x);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_SubrectBase_Y,
-                pExecParams->inputResponsiveMaskBase.y);
+        params.Set<"FSR.reactive">(pExecParams->pResponsivePixelMaskTexture);
+
+    params.Set<NVSDK_NGX_Parameter_Color>(pExecParams->pColorTexture);
+    params.Set<NVSDK_NGX_Parameter_MotionVectors>(pExecParams->pVelocityTexture);
+    params.Set<NVSDK_NGX_Parameter_Output>(pExecParams->pOutputTexture);
+
+    params.Set<NVSDK_NGX_Parameter_DLSS_Input_Color_Subrect_Base_X>(pExecParams->inputColorBase.x);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Input_Color_Subrect_Base_Y>(pExecParams->inputColorBase.y);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Input_Depth_Subrect_Base_X>(pExecParams->inputDepthBase.x);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Input_Depth_Subrect_Base_Y>(pExecParams->inputDepthBase.y);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Input_MV_SubrectBase_X>(pExecParams->inputMotionVectorBase.x);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Input_MV_SubrectBase_Y>(pExecParams->inputMotionVectorBase.y);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Output_Subrect_Base_X>(pExecParams->outputColorBase.x);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Output_Subrect_Base_Y>(pExecParams->outputColorBase.y);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_SubrectBase_X>(pExecParams->inputResponsiveMaskBase.x);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_SubrectBase_Y>(pExecParams->inputResponsiveMaskBase.y);
 
     State::Instance().setInputApiName = "XeSS";
 
-    if (NVSDK_NGX_D3D12_EvaluateFeature(pCommandList, handle, params, nullptr) == NVSDK_NGX_Result_Success)
+    if (NVSDK_NGX_D3D12_EvaluateFeature(pCommandList, handle, context->nvParams, nullptr) == NVSDK_NGX_Result_Success)
         return XESS_RESULT_SUCCESS;
 
     return XESS_RESULT_ERROR_UNKNOWN;
@@ -286,10 +292,12 @@ xess_result_t hk_xessD3D12GetInitParams(xess_context_handle_t hContext, xess_d3d
 {
     LOG_DEBUG("");
 
-    if (!_d3d12InitParams.contains(hContext))
+    auto context = _xessContexts.Find(hContext);
+
+    if (context == nullptr || !context->d3d12InitParams.has_value())
         return XESS_RESULT_ERROR_INVALID_CONTEXT;
 
-    auto ip = &_d3d12InitParams[hContext];
+    auto ip = &context->d3d12InitParams.value();
 
     pInitParams->bufferHeapOffset = ip->bufferHeapOffset;
     pInitParams->creationNodeMask = ip->creationNodeMask;
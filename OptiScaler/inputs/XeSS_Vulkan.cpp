@@ -7,7 +7,6 @@
 
 #include <nvsdk_ngx_vk.h>
 
-static UINT64 _handleCounter = 23370000;
 static UINT64 _frameCounter = 0;
 static xess_context_handle_t _currentContext = nullptr;
 static VkDevice _device = nullptr;
@@ -20,17 +19,17 @@ static NVSDK_NGX_Resource_VK colorNVRes[3] {};
 static NVSDK_NGX_Resource_VK outputNVRes[3] {};
 static NVSDK_NGX_Resource_VK mvNVRes[3] {};
 
-static bool CreateDLSSContext(xess_context_handle_t handle, VkCommandBuffer commandList,
+static bool CreateDLSSContext(XeSSContext* context, VkCommandBuffer commandList,
                               const xess_vk_execute_params_t* pExecParams)
 {
     LOG_DEBUG("");
 
-    if (!_nvParams.contains(handle))
+    if (context->nvParams == nullptr)
         return false;
 
     NVSDK_NGX_Handle* nvHandle = nullptr;
-    auto params = _nvParams[handle];
-    auto initParams = &_vkInitParams[handle];
+    auto params = context->nvParams;
+    auto initParams = &context->vkInitParams.value();
 
     UINT initFlags = 0;
 
@@ -98,7 +97,7 @@ static bool CreateDLSSContext(xess_context_handle_t handle, VkCommandBuffer comm
         NVSDK_NGX_Result_Success)
         return false;
 
-    _contexts[handle] = nvHandle;
+    context->nvHandle = nvHandle;
 
     return true;
 }
@@ -172,15 +171,14 @@ xess_result_t hk_xessVKCreateContext(VkInstance instance, VkPhysicalDevice physi
             return XESS_RESULT_ERROR_UNINITIALIZED;
     }
 
-    *phContext = (xess_context_handle_t) ++_handleCounter;
-
     NVSDK_NGX_Parameter* params = nullptr;
 
     if (NVSDK_NGX_VULKAN_GetCapabilityParameters(&params) != NVSDK_NGX_Result_Success)
         return XESS_RESULT_ERROR_INVALID_ARGUMENT;
 
-    _nvParams[*phContext] = params;
-    _motionScales[*phContext] = { 1.0f, 1.0f };
+    auto& context = _xessContexts.Create(*phContext);
+    context.nvParams = params;
+    context.optiParams = GetOptiParameters(params);
 
     LOG_DEBUG("Created context: {}", (size_t) *phContext);
 
@@ -198,6 +196,11 @@ xess_result_t hk_xessVKInit(xess_context_handle_t hContext, const xess_vk_init_p
 {
     LOG_DEBUG("initFlags: {:X}", pInitParams->initFlags);
 
+    auto context = _xessContexts.Find(hContext);
+
+    if (context == nullptr)
+        return XESS_RESULT_ERROR_INVALID_CONTEXT;
+
     xess_vk_init_params_t ip {};
     ip.bufferHeapOffset = pInitParams->bufferHeapOffset;
     ip.creationNodeMask = pInitParams->creationNodeMask;
@@ -210,13 +213,13 @@ xess_result_t hk_xessVKInit(xess_context_handle_t hContext, const xess_vk_init_p
     ip.textureHeapOffset = pInitParams->textureHeapOffset;
     ip.visibleNodeMask = pInitParams->visibleNodeMask;
 
-    _vkInitParams[hContext] = ip;
+    context->vkInitParams = ip;
 
-    if (!_contexts.contains(hContext))
+    if (context->nvHandle == nullptr)
         return XESS_RESULT_SUCCESS;
 
-    NVSDK_NGX_VULKAN_ReleaseFeature(_contexts[hContext]);
-    _contexts.erase(hContext);
+    NVSDK_NGX_VULKAN_ReleaseFeature(context->nvHandle);
+    context->nvHandle = nullptr;
 
     return XESS_RESULT_SUCCESS;
 }
@@ -229,55 +232,59 @@ xess_result_t hk_xessVKExecute(xess_context_handle_t hContext, VkCommandBuffer c
     if (commandBuffer == nullptr)
         return XESS_RESULT_ERROR_INVALID_ARGUMENT;
 
-    if (!_contexts.contains(hContext) && !CreateDLSSContext(hContext, commandBuffer, pExecParams))
+    auto context = _xessContexts.Find(hContext);
+
+    if (context == nullptr)
+        return XESS_RESULT_ERROR_INVALID_CONTEXT;
+
+    // Defaults when the game didn't call init
+    if (!context->vkInitParams.has_value())
+        context->vkInitParams.emplace();
+
+    if (context->nvHandle == nullptr && !CreateDLSSContext(context, commandBuffer, pExecParams))
         return XESS_RESULT_ERROR_UNKNOWN;
 
-    NVSDK_NGX_Parameter* params = _nvParams[hContext];
-    NVSDK_NGX_Handle* handle = _contexts[hContext];
-    xess_vk_init_params_t* initParams = &_vkInitParams[hContext];
+    NVNGX_ParameterWriter params { context->nvParams, context->optiParams };
+    NVSDK_NGX_Handle* handle = context->nvHandle;
+    xess_vk_init_params_t* initParams = &context->vkInitParams.value();
+    auto scales = &context->motionScale;
 
-    if (_motionScales.contains(hContext))
+    if ((initParams->initFlags & XESS_INIT_FLAG_USE_NDC_VELOCITY))
     {
-        auto scales = &_motionScales[hContext];
-
-        if ((initParams->initFlags & XESS_INIT_FLAG_USE_NDC_VELOCITY))
+        if (initParams->initFlags & XESS_INIT_FLAG_HIGH_RES_MV)
         {
-            if (initParams->initFlags & XESS_INIT_FLAG_HIGH_RES_MV)
-            {
-                params->Set(NVSDK_NGX_Parameter_MV_Scale_X, initParams->outputResolution.x * 0.5 * scales->x);
-                params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, initParams->outputResolution.y * -0.5 * scales->y);
-            }
-            else
-            {
-                params->Set(NVSDK_NGX_Parameter_MV_Scale_X, pExecParams->inputWidth * 0.5 * scales->x);
-                params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, pExecParams->inputHeight * -0.5 * scales->y);
-            }
+            params.Set<NVSDK_NGX_Parameter_MV_Scale_X>(initParams->outputResolution.x * 0.5 * scales->x);
+            params.Set<NVSDK_NGX_Parameter_MV_Scale_Y>(initParams->outputResolution.y * -0.5 * scales->y);
         }
         else
         {
-            params->Set(NVSDK_NGX_Parameter_MV_Scale_X, scales->x);
-            params->Set(NVSDK_NGX_Parameter_MV_Scale_Y, scales->y);
+            params.Set<NVSDK_NGX_Parameter_MV_Scale_X>(pExecParams->inputWidth * 0.5 * scales->x);
+            params.Set<NVSDK_NGX_Parameter_MV_Scale_Y>(pExecParams->inputHeight * -0.5 * scales->y);
         }
     }
+    else
+    {
+        params.Set<NVSDK_NGX_Parameter_MV_Scale_X>(scales->x);
+        params.Set<NVSDK_NGX_Parameter_MV_Scale_Y>(scales->y);
+    }
 
     float jitterScaleX = 1.0f;
     float jitterScaleY = 1.0f;
 
-    if (_jitterScales.contains(hContext))
+    if (context->jitterScale.has_value())
     {
-        auto scales = &_jitterScales[hContext];
-        jitterScaleX = scales->x;
-        jitterScaleY = scales->y;
+        jitterScaleX = context->jitterScale->x;
+        jitterScaleY = context->jitterScale->y;
     }
 
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_X, pExecParams->jitterOffsetX * jitterScaleX);
-    params->Set(NVSDK_NGX_Parameter_Jitter_Offset_Y, pExecParams->jitterOffsetY * jitterScaleY);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Exposure_Scale, pExecParams->exposureScale);
-    params->Set(NVSDK_NGX_Parameter_Reset, pExecParams->resetHistory);
-    params->Set(NVSDK_NGX_Parameter_Width, pExecParams->inputWidth);
-    params->Set(NVSDK_NGX_Parameter_Height, pExecParams->inputHeight);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width, pExecParams->inputWidth);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height, pExecParams->inputHeight);
+    params.Set<NVSDK_NGX_Parameter_Jitter_Offset_X>(pExecParams->jitterOffsetX * jitterScaleX);
+    params.Set<NVSDK_NGX_Parameter_Jitter_Offset_Y>(pExecParams->jitterOffsetY * jitterScaleY);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Exposure_Scale>(pExecParams->exposureScale);
+    params.Set<NVSDK_NGX_Parameter_Reset>(pExecParams->resetHistory);
+    params.Set<NVSDK_NGX_Parameter_Width>(pExecParams->inputWidth);
+    params.Set<NVSDK_NGX_Parameter_Height>(pExecParams->inputHeight);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width>(pExecParams->inputWidth);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height>(pExecParams->inputHeight);
 
     _frameCounter++;
     auto index = _frameCounter % 3;
@@ -291,13 +298,13 @@ xess_result_t hk_xessVKExecute(xess_context_handle_t hContext, VkCommandBuffer c
     else
     {
         CreateNVRes(&pExecParams->depthTexture, &depthNVRes[index]);
-        params->Set(NVSDK_NGX_Parameter_Depth, &depthNVRes[index]);
+        params.Set<NVSDK_NGX_Parameter_Depth>(&depthNVRes[index]);
     }
 
     if (pExecParams->exposureScaleTexture.image != nullptr)
     {
         CreateNVRes(&pExecParams->exposureScaleTexture, &expNVRes[index]);
-        params->Set(NVSDK_NGX_Parameter_ExposureTexture, &expNVRes[index]);
+        params.Set<NVSDK_NGX_Parameter_ExposureTexture>(&expNVRes[index]);
     }
 
     if (pExecParams->responsivePixelMaskTexture.image != nullptr)
@@ -306,9 +313,9 @@ xess_result_t hk_xessVKExecute(xess_context_handle_t hContext, VkCommandBuffer c
 
         if (feature_version { XeSSProxy::Version().major, XeSSProxy::Version().minor, XeSSProxy::Version().patch } <
             feature_version { 2, 0, 1 })
-            params->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask, &biasNVRes[index]);
+            params.Set<NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_Mask>(&biasNVRes[index]);
         else
-            params->Set("FSR.reactive", &biasNVRes[index]);
+            params.Set<"FSR.reactive">(&biasNVRes[index]);
     }
 
     if (pExecParams->colorTexture.image == nullptr)
@@ -319,7 +326,7 @@ xess_result_t hk_xessVKExecute(xess_context_handle_t hContext, VkCommandBuffer c
     else
     {
         CreateNVRes(&pExecParams->colorTexture, &colorNVRes[index]);
-        params->Set(NVSDK_NGX_Parameter_Color, &colorNVRes[index]);
+        params.Set<NVSDK_NGX_Parameter_Color>(&colorNVRes[index]);
     }
 
     if (pExecParams->velocityTexture.image == nullptr)
@@ -330,7 +337,7 @@ xess_result_t hk_xessVKExecute(xess_context_handle_t hContext, VkCommandBuffer c
     else
     {
         CreateNVRes(&pExecParams->velocityTexture, &mvNVRes[index]);
-        params->Set(NVSDK_NGX_Parameter_MotionVectors, &mvNVRes[index]);
+        params.Set<NVSDK_NGX_Parameter_MotionVectors>(&mvNVRes[index]);
     }
 
     if (pExecParams->outputTexture.image == nullptr)
@@ -341,25 +348,23 @@ xess_result_t hk_xessVKExecute(xess_context_handle_t hContext, VkCommandBuffer c
     else
     {
         CreateNVRes(&pExecParams->outputTexture, &outputNVRes[index], true);
-        params->Set(NVSDK_NGX_Parameter_Output, &outputNVRes[index]);
+        params.Set<NVSDK_NGX_Parameter_Output>(&outputNVRes[index]);
     }
 
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Color_Subrect_Base_X, pExecParams->inputColorBase.x);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Color_Subrect_Base_Y, pExecParams->inputColorBase.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Depth_Subrect_Base_X, pExecParams->inputDepthBase.x);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Depth_Subrect_Base_Y, pExecParams->inputDepthBase.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_MV_SubrectBase_X, pExecParams->inputMotionVectorBase.x);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_MV_SubrectBase_Y, pExecParams->inputMotionVectorBase.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Output_Subrect_Base_X, pExecParams->outputColorBase.x);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Output_Subrect_Base_Y, pExecParams->outputColorBase.y);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_SubrectBase_X,
-                pExecParams->inputResponsiveMaskBase.x);
-    params->Set(NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_SubrectBase_Y,
-                pExecParams->inputResponsiveMaskBase.y);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Input_Color_Subrect_Base_X>(pExecParams->inputColorBase.x);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Input_Color_Subrect_Base_Y>(pExecParams->inputColorBase.y);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Input_Depth_Subrect_Base_X>(pExecParams->inputDepthBase.x);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Input_Depth_Subrect_Base_Y>(pExecParams->inputDepthBase.y);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Input_MV_SubrectBase_X>(pExecParams->inputMotionVectorBase.x);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Input_MV_SubrectBase_Y>(pExecParams->inputMotionVectorBase.y);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Output_Subrect_Base_X>(pExecParams->outputColorBase.x);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Output_Subrect_Base_Y>(pExecParams->outputColorBase.y);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_SubrectBase_X>(pExecParams->inputResponsiveMaskBase.x);
+    params.Set<NVSDK_NGX_Parameter_DLSS_Input_Bias_Current_Color_SubrectBase_Y>(pExecParams->inputResponsiveMaskBase.y);
 
     State::Instance().setInputApiName = "XeSS";
 
-    if (NVSDK_NGX_VULKAN_EvaluateFeature(commandBuffer, handle, params, nullptr) == NVSDK_NGX_Result_Success)
+    if (NVSDK_NGX_VULKAN_EvaluateFeature(commandBuffer, handle, context->nvParams, nullptr) == NVSDK_NGX_Result_Success)
         return XESS_RESULT_SUCCESS;
 
     return XESS_RESULT_ERROR_UNKNOWN;
@@ -369,10 +374,12 @@ xess_result_t hk_xessVKGetInitParams(xess_context_handle_t hContext, xess_vk_ini
 {
     LOG_DEBUG("");
 
-    if (!_vkInitParams.contains(hContext))
+    auto context = _xessContexts.Find(hContext);
+
+    if (context == nullptr || !context->vkInitParams.has_value())
         return XESS_RESULT_ERROR_INVALID_CONTEXT;
 
-    auto ip = &_vkInitParams[hContext];
+    auto ip = &context->vkInitParams.value();
 
     pInitParams->bufferHeapOffset = ip->bufferHeapOffset;
     pInitParams->creationNodeMask = ip->creationNodeMask;
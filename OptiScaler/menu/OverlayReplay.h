@@ -0,0 +1,50 @@
+#pragma once
+
+// Everything which changes the layout of the fps overlay, a change rebuilds it on the next present
+struct OverlayLayout
+{
+    int type = -1;
+    int position = 0;
+    bool horizontal = false;
+    bool hdr = false;
+    float alpha = 0.0f;
+    float scale = 0.0f;
+    float width = 0.0f;
+    float height = 0.0f;
+    const void* feature = nullptr;
+    bool frozen = false;
+
+    bool operator==(const OverlayLayout&) const = default;
+};
+
+// Decides if the draw data of the last fps overlay rebuild can be rendered again, api and ImGui independent.
+//
+// Kept draw data is only reused when it was built from the same layout less than one refresh interval ago.
+// Refresh rate is in Hz, 0 rebuilds on every present. Times are in milliseconds.
+struct OverlayReplay
+{
+    OverlayLayout layout {};
+    double builtAt = 0.0;
+    bool cached = false;
+
+    bool CanReplay(const OverlayLayout& current, double now, int refreshRate) const
+    {
+        if (!cached || refreshRate <= 0)
+            return false;
+
+        if (now < builtAt || now - builtAt >= 1000.0 / refreshRate)
+            return false;
+
+        return layout == current;
+    }
+
+    // Draw data built while the splash is shown can't be kept, it fades out
+    void Built(const OverlayLayout& current, double now, bool cacheable)
+    {
+        layout = current;
+        builtAt = now;
+        cached = cacheable;
+    }
+
+    void Invalidate() { cached = false; }
+};
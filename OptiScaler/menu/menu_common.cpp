@@ -1,6 +1,7 @@
 ﻿#include "menu_common.h"
 
 #include "font/Hack_Compressed.h"
+#include "OverlayReplay.h"
 
 #include <hooks/HooksDx.h>
 
@@ -11,6 +12,9 @@
 
 #include <framegen/ffx/FSRFG_Dx12.h>
 
+#include <misc/GpuTimer_Dx12.h>
+#include <misc/TransientPool_Dx12.h>
+
 #include <nvapi/fakenvapi.h>
 #include <nvapi/ReflexHooks.h>
 
@@ -1288,6 +1292,61 @@ static void MenuSizeCheck(ImGuiIO io)
 static double lastTime = 0.0;
 static UINT64 uwpTargetFrame = 0;
 
+// Retained fps overlay. When only the overlay is shown the draw data of the last rebuild stays valid until
+// the next ImGui::NewFrame, presents in between skip building the ui and render the same draw data again.
+static OverlayReplay overlayReplay {};
+static bool overlayReplayed = false;
+static double overlayStart = 0.0;
+
+static OverlayLayout CurrentOverlayLayout()
+{
+    auto config = Config::Instance();
+    auto feature = State::Instance().currentFeature;
+
+    OverlayLayout layout;
+    layout.type = config->FpsOverlayType.value_or_default();
+    layout.position = config->FpsOverlayPos.value_or_default();
+    layout.horizontal = config->FpsOverlayHorizontal.value_or_default();
+    layout.hdr = State::Instance().isHdrActive;
+    layout.alpha = config->FpsOverlayAlpha.value_or_default();
+    layout.scale = config->FpsScale.value_or(config->MenuScale.value_or_default());
+    layout.width = State::Instance().screenWidth;
+    layout.height = State::Instance().screenHeight;
+    layout.feature = feature;
+    layout.frozen = feature != nullptr && feature->IsFrozen();
+
+    return layout;
+}
+
+// Draw data of the previous frame can only be rendered again while its textures are alive,
+// a backend reset destroys them and only NewFrame queues them for creation again
+static bool OverlayTexturesAlive()
+{
+    for (auto texture : ImGui::GetPlatformIO().Textures)
+    {
+        if (texture->Status == ImTextureStatus_Destroyed)
+            return false;
+    }
+
+    return true;
+}
+
+void MenuCommon::FinishFrame()
+{
+    if (!overlayReplayed)
+        ImGui::Render();
+}
+
+void MenuCommon::FrameRendered()
+{
+    // Frames with the menu open would hide the cost of the overlay
+    if (_isVisible || overlayStart <= 0.0)
+        return;
+
+    State::Instance().overlayTimes.Push(Util::MillisecondsNow() - overlayStart);
+    overlayStart = 0.0;
+}
+
 bool MenuCommon::RenderMenu()
 {
     if (!_isInited)
@@ -1297,6 +1356,8 @@ bool MenuCommon::RenderMenu()
 
     // FPS & frame time calculation
     auto now = Util::MillisecondsNow();
+    overlayStart = now;
+    overlayReplayed = false;
     double frameTime = 0.0;
     double frameRate = 0.0;
 
@@ -1308,8 +1369,7 @@ bool MenuCommon::RenderMenu()
 
     lastTime = now;
 
-    State::Instance().frameTimes.pop_front();
-    State::Instance().frameTimes.push_back(frameTime);
+    State::Instance().frameTimes.Push(frameTime);
 
     ImGuiIO& io = ImGui::GetIO();
     (void) io;
@@ -1383,7 +1443,25 @@ bool MenuCommon::RenderMenu()
         inputFpsCycle = false;
     }
 
+    // Only the fps overlay, reuse its last draw data until the refresh interval passes or the layout changes
+    if (!_isVisible && Config::Instance()->ShowFps.value_or_default())
+    {
+        auto refreshRate = Config::Instance()->FpsOverlayRefreshRate.value_or_default();
+        bool splashActive =
+            !Config::Instance()->DisableSplash.value_or_default() && now > splashStart && now < splashLimit;
+
+        if (!splashActive && overlayReplay.CanReplay(CurrentOverlayLayout(), now, refreshRate) &&
+            ImGui::GetDrawData() != nullptr && OverlayTexturesAlive())
+        {
+            overlayReplayed = true;
+            return true;
+        }
+    }
+
+    overlayReplay.Invalidate();
+
     bool frameStarted = false;
+    bool splashShown = false;
     bool frameTimesCalculated = false;
     const double splashTime = 7000.0;
     const double fadeTime = 1000.0;
@@ -1466,6 +1544,7 @@ bool MenuCommon::RenderMenu()
             ImGui::PopStyleVar(2);
 
             frameStarted = true;
+            splashShown = true;
 
             if (!_isVisible && !Config::Instance()->ShowFps.value_or_default())
             {
@@ -1481,19 +1560,8 @@ bool MenuCommon::RenderMenu()
     // If Fps overlay is visible
     if (Config::Instance()->ShowFps.value_or_default())
     {
-        float frameCnt = 0;
-        frameTime = 0;
-        for (size_t i = 299; i > 199; i--)
-        {
-            if (State::Instance().frameTimes[i] > 0.0)
-            {
-                frameTime += State::Instance().frameTimes[i];
-                frameCnt++;
-            }
-        }
-
-        frameTime /= frameCnt;
-        frameRate = 1000.0 / frameTime;
+        frameTime = State::Instance().frameTimes.RecentMean(100);
+        frameRate = frameTime > 0.0 ? 1000.0 / frameTime : 0.0;
         frameTimesCalculated = true;
 
         if (!frameStarted)
@@ -1515,21 +1583,10 @@ bool MenuCommon::RenderMenu()
             frameStarted = true;
         }
 
-        State::Instance().frameTimeMutex.lock();
-        std::vector<float> frameTimeArray(State::Instance().frameTimes.begin(), State::Instance().frameTimes.end());
-        std::vector<float> upscalerFrameTimeArray(State::Instance().upscaleTimes.begin(),
-                                                  State::Instance().upscaleTimes.end());
-        State::Instance().frameTimeMutex.unlock();
-        float averageFrameTime = 0.0f;
-        float averageUpscalerFT = 0.0f;
-
-        for (size_t i = 0; i < frameTimeArray.size(); i++)
-        {
-            averageFrameTime += frameTimeArray[i];
-            averageUpscalerFT += upscalerFrameTimeArray[i];
-        }
-        averageFrameTime /= frameTimeArray.size();
-        averageUpscalerFT /= frameTimeArray.size();
+        auto& frameTimes = State::Instance().frameTimes;
+        auto& upscaleTimes = State::Instance().upscaleTimes;
+        float averageFrameTime = frameTimes.GetSummary().mean;
+        float averageUpscalerFT = upscaleTimes.GetSummary().mean;
 
         // Set overlay position
         ImGui::SetNextWindowPos(overlayPosition, ImGuiCond_Always);
@@ -1652,15 +1709,15 @@ bool MenuCommon::RenderMenu()
                     ImGui::Spacing();
                 }
 
-                secondLine = std::format("Frame Time: {:6.2f} ms, Avg: {:6.2f} ms", State::Instance().frameTimes.back(),
+                secondLine = std::format("Frame Time: {:6.2f} ms, Avg: {:6.2f} ms", frameTimes.Last(),
                                          averageFrameTime);
             }
 
             // Prepare Line 3
             if (Config::Instance()->FpsOverlayType.value_or_default() > 3)
             {
-                thirdLine = std::format("Upscaler Time: {:6.2f} ms, Avg: {:6.2f} ms",
-                                        State::Instance().upscaleTimes.back(), averageUpscalerFT);
+                thirdLine = std::format("Upscaler Time: {:6.2f} ms, Avg: {:6.2f} ms", upscaleTimes.Last(),
+                                        averageUpscalerFT);
             }
 
             ImVec2 plotSize;
@@ -1712,8 +1769,8 @@ bool MenuCommon::RenderMenu()
                     ImGui::SameLine(0.0f, 0.0f);
 
                 // Graph of frame times
-                ImGui::PlotLines("##FrameTimeGraph", frameTimeArray.data(), static_cast<int>(frameTimeArray.size()), 0,
-                                 nullptr, 0.0f, 66.6f, plotSize);
+                ImGui::PlotLines("##FrameTimeGraph", frameTimes.PlotGetter, &frameTimes, frameTimes.Size(), 0, nullptr,
+                                 0.0f, 66.6f, plotSize);
             }
 
             if (Config::Instance()->FpsOverlayType.value_or_default() > 3)
@@ -1738,8 +1795,8 @@ bool MenuCommon::RenderMenu()
                     ImGui::SameLine(0.0f, 0.0f);
 
                 // Graph of upscaler times
-                ImGui::PlotLines("##UpscalerFrameTimeGraph", upscalerFrameTimeArray.data(),
-                                 static_cast<int>(upscalerFrameTimeArray.size()), 0, nullptr, 0.0f, 20.0f, plotSize);
+                ImGui::PlotLines("##UpscalerFrameTimeGraph", upscaleTimes.PlotGetter, &upscaleTimes,
+                                 upscaleTimes.Size(), 0, nullptr, 0.0f, 20.0f, plotSize);
             }
 
             ImGui::PopStyleColor(3); // Restore the style
@@ -1776,6 +1833,8 @@ bool MenuCommon::RenderMenu()
 
         if (!_isVisible)
         {
+            overlayReplay.Built(CurrentOverlayLayout(), now, !splashShown);
+
             ImGui::EndFrame();
             return true;
         }
@@ -1792,19 +1851,8 @@ bool MenuCommon::RenderMenu()
         // If overlay is not visible frame needs to be inited
         if (!frameTimesCalculated)
         {
-            float frameCnt = 0;
-            frameTime = 0;
-            for (size_t i = 299; i > 199; i--)
-            {
-                if (State::Instance().frameTimes[i] > 0.0)
-                {
-                    frameTime += State::Instance().frameTimes[i];
-                    frameCnt++;
-                }
-            }
-
-            frameTime /= frameCnt;
-            frameRate = 1000.0 / frameTime;
+            frameTime = State::Instance().frameTimes.RecentMean(100);
+            frameRate = frameTime > 0.0 ? 1000.0 / frameTime : 0.0;
         }
 
         if (!frameStarted)
@@ -4070,6 +4118,23 @@ bool MenuCommon::RenderMenu()
                             Config::Instance()->FpsScale = values[currentIndex];
                         }
                     }
+
+                    int refreshRate = Config::Instance()->FpsOverlayRefreshRate.value_or_default();
+                    if (ImGui::SliderInt("Refresh Rate", &refreshRate, 0, 60,
+                                         refreshRate == 0 ? "Every frame" : "%d Hz", ImGuiSliderFlags_ClampOnInput))
+                    {
+                        Config::Instance()->FpsOverlayRefreshRate = refreshRate;
+                    }
+                    ShowHelpMarker("How many times per second the overlay is rebuilt\n"
+                                   "Frames in between draw the last one again");
+
+                    // Collected while the menu is closed
+                    auto overlayTimes = State::Instance().overlayTimes.GetSummary();
+                    if (overlayTimes.count > 0)
+                    {
+                        ImGui::Text("Overlay CPU Time: %.3f ms, Max: %.3f ms", overlayTimes.mean, overlayTimes.max);
+                        ShowHelpMarker("CPU time per present spent on the overlay while the menu is closed");
+                    }
                 }
 
                 // UPSCALER INPUTS -----------------------------
@@ -4314,26 +4379,101 @@ bool MenuCommon::RenderMenu()
                 {
                     ImGui::TableNextColumn();
                     ImGui::Text("FrameTime");
-                    State::Instance().frameTimeMutex.lock();
-                    auto ft = std::format("{:6.2f} ms / {:5.1f} fps", State::Instance().frameTimes.back(), frameRate);
-                    std::vector<float> frameTimeArray(State::Instance().frameTimes.begin(),
-                                                      State::Instance().frameTimes.end());
-                    ImGui::PlotLines(ft.c_str(), frameTimeArray.data(), (int) frameTimeArray.size());
+                    auto& frameTimes = State::Instance().frameTimes;
+                    auto ftSummary = frameTimes.GetSummary();
+                    auto ft = std::format("{:6.2f} ms / {:5.1f} fps", ftSummary.last, frameRate);
+                    ImGui::PlotLines(ft.c_str(), frameTimes.PlotGetter, &frameTimes, frameTimes.Size());
+                    ImGui::Text("P99: %.2f ms, 1%% Low: %.1f fps", ftSummary.p99, ftSummary.low1Fps);
 
                     if (currentFeature != nullptr && !currentFeature->IsFrozen())
                     {
+                        auto& upscaleTimes = State::Instance().upscaleTimes;
+
                         ImGui::TableNextColumn();
                         ImGui::Text("Upscaler");
-                        auto ups = std::format("{:7.4f} ms", State::Instance().upscaleTimes.back());
-                        std::vector<float> upscaleTimeArray(State::Instance().upscaleTimes.begin(),
-                                                            State::Instance().upscaleTimes.end());
-                        ImGui::PlotLines(ups.c_str(), upscaleTimeArray.data(), (int) upscaleTimeArray.size());
+                        auto ups = std::format("{:7.4f} ms", upscaleTimes.Last());
+                        ImGui::PlotLines(ups.c_str(), upscaleTimes.PlotGetter, &upscaleTimes, upscaleTimes.Size());
                     }
-                    State::Instance().frameTimeMutex.unlock();
 
                     ImGui::EndTable();
                 }
 
+                // GPU PASS TIMINGS ----------
+                if (State::Instance().api == DX12 && GpuTimer_Dx12::IsInited())
+                {
+                    ImGui::Spacing();
+
+                    if (ImGui::CollapsingHeader("GPU Pass Timings"))
+                    {
+                        if (ImGui::BeginTable("passTimes", 5,
+                                              ImGuiTableFlags_SizingStretchSame | ImGuiTableFlags_RowBg))
+                        {
+                            ImGui::TableSetupColumn("Pass");
+                            ImGui::TableSetupColumn("Last");
+                            ImGui::TableSetupColumn("Mean");
+                            ImGui::TableSetupColumn("P50");
+                            ImGui::TableSetupColumn("P99");
+                            ImGui::TableHeadersRow();
+
+                            for (size_t i = 0; i < GpuPassCount; i++)
+                            {
+                                auto summary = GpuTimer_Dx12::GetSummary((GpuPass) i);
+
+                                if (summary.count == 0)
+                                    continue;
+
+                                ImGui::TableNextColumn();
+                                ImGui::Text("%s", GpuPassName((GpuPass) i));
+                                ImGui::TableNextColumn();
+                                ImGui::Text("%7.4f ms", summary.last);
+                                ImGui::TableNextColumn();
+                                ImGui::Text("%7.4f ms", summary.mean);
+                                ImGui::TableNextColumn();
+                                ImGui::Text("%7.4f ms", summary.p50);
+                                ImGui::TableNextColumn();
+                                ImGui::Text("%7.4f ms", summary.p99);
+                            }
+
+                            ImGui::EndTable();
+                        }
+
+                        if (ImGui::Button("Save to CSV"))
+                            GpuTimer_Dx12::ExportCsv(Util::DllPath().parent_path() / "OptiScaler_GpuTimings.csv");
+
+                        ImGui::SameLine(0.0f, 6.0f);
+
+                        if (ImGui::Button("Save to JSON"))
+                            GpuTimer_Dx12::ExportJson(Util::DllPath().parent_path() / "OptiScaler_GpuTimings.json");
+
+                        ShowHelpMarker("Saves timings of last 256 measured frames next to OptiScaler.dll\n"
+                                       "CSV has the summary of each pass, JSON also has every frame");
+                    }
+                }
+
+                // TRANSIENT TEXTURES -------
+                if (State::Instance().api == DX12)
+                {
+                    auto stats = TransientPool_Dx12::GetStats();
+
+                    if (stats.textures > 0 || stats.peakBytes > 0)
+                    {
+                        ImGui::Spacing();
+
+                        if (ImGui::CollapsingHeader("Transient Textures"))
+                        {
+                            constexpr float mb = 1024.0f * 1024.0f;
+
+                            ImGui::Text("Textures: %u, heaps: %u", stats.textures, stats.heaps);
+                            ImGui::Text("In use: %.1f MB, idle: %.1f MB", stats.usedBytes / mb, stats.idleBytes / mb);
+                            ImGui::Text("Heaps: %.1f MB, committed: %.1f MB", stats.heapBytes / mb,
+                                        stats.committedBytes / mb);
+                            ImGui::Text("Peak: %.1f MB, steady: %.1f MB", stats.peakBytes / mb, stats.steadyBytes / mb);
+                            ShowHelpMarker("Buffers of RCAS, output scaling and bias passes\n"
+                                           "Steady is the memory after it didn't change for 300 frames");
+                        }
+                    }
+                }
+
                 // BOTTOM LINE ---------------
                 ImGui::Spacing();
                 ImGui::Separator();
@@ -4610,6 +4750,7 @@ bool MenuCommon::RenderMenu()
                         ImGui::TableSetupColumn("##1", ImGuiTableColumnFlags_WidthStretch);
                         ImGui::TableSetupColumn("##2", ImGuiTableColumnFlags_WidthFixed);
 
+                        std::lock_guard<std::mutex> capturedLock(State::Instance().CapturedHudlessesMutex);
                         ankerl::unordered_dense::map<void*, CapturedHudlessInfo>::iterator it;
 
                         for (it = State::Instance().CapturedHudlesses.begin();
@@ -153,6 +153,13 @@ class MenuCommon
     static HWND Handle() { return _handle; }
 
     static bool RenderMenu();
+
+    // Ends the frame of RenderMenu, presents which reuse the retained overlay keep the previous draw data
+    static void FinishFrame();
+
+    // Called after the draw data is recorded, cpu time of the present goes to State::overlayTimes
+    static void FrameRendered();
+
     static void Init(HWND InHwnd, bool isUWP);
     static void Shutdown();
     static void HideMenu();
@@ -108,6 +108,7 @@ bool Menu_Dx11::Render(ID3D11DeviceContext* pCmdList, ID3D11Resource* outTexture
         {
             // Render
             ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+            MenuCommon::FrameRendered();
             return true;
         }
 
@@ -119,6 +120,7 @@ bool Menu_Dx11::Render(ID3D11DeviceContext* pCmdList, ID3D11Resource* outTexture
 
         // Copy result
         pCmdList->CopyResource(outTexture, _renderTargetTexture);
+        MenuCommon::FrameRendered();
     }
 
     return true;
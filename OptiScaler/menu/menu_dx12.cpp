@@ -191,7 +191,10 @@ bool Menu_Dx12::Render(ID3D12GraphicsCommandList* pCmdList, ID3D12Resource* outT
 
         // Render
         if (MenuDxBase::RenderMenu())
+        {
             ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), pCmdList);
+            MenuCommon::FrameRendered();
+        }
 
         outBarrier.Transition.StateBefore = D3D12_RESOURCE_STATE_RENDER_TARGET;
         outBarrier.Transition.StateAfter = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
@@ -240,6 +243,7 @@ bool Menu_Dx12::Render(ID3D12GraphicsCommandList* pCmdList, ID3D12Resource* outT
     if (MenuDxBase::RenderMenu())
     {
         ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), pCmdList);
+        MenuCommon::FrameRendered();
 
         outBarrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_SOURCE;
         outBarrier.Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_DEST;
@@ -37,6 +37,10 @@ bool MenuOverlayBase::RenderMenu()
     return MenuCommon::RenderMenu();
 }
 
+void MenuOverlayBase::FinishFrame() { MenuCommon::FinishFrame(); }
+
+void MenuOverlayBase::FrameRendered() { MenuCommon::FrameRendered(); }
+
 void MenuOverlayBase::Shutdown() { MenuCommon::Shutdown(); }
 
 void MenuOverlayBase::HideMenu() { MenuCommon::HideMenu(); }
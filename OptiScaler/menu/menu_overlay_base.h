@@ -19,6 +19,8 @@ class MenuOverlayBase
 
     static void Init(HWND InHandle, bool isUWP);
     static bool RenderMenu();
+    static void FinishFrame();
+    static void FrameRendered();
     static void Shutdown();
     static void HideMenu();
 };
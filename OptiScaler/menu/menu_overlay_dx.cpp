@@ -4,6 +4,8 @@
 #include <Util.h>
 #include <Logger.h>
 #include <Config.h>
+#include <misc/GpuTimer_Dx12.h>
+#include <hooks/SwapchainContext_Dx.h>
 
 #include <imgui/imgui_impl_dx11.h>
 #include <imgui/imgui_impl_dx12.h>
@@ -45,30 +47,6 @@ static bool _showRenderImGuiDebugOnce = true;
 static std::mutex _dx11CleanMutex;
 static std::mutex _dx12CleanMutex;
 
-static IID streamlineRiid {};
-
-static bool CheckForRealObject(std::string functionName, IUnknown* pObject, IUnknown** ppRealObject)
-{
-    if (streamlineRiid.Data1 == 0)
-    {
-        auto iidResult = IIDFromString(L"{ADEC44E2-61F0-45C3-AD9F-1B37379284FF}", &streamlineRiid);
-
-        if (iidResult != S_OK)
-            return false;
-    }
-
-    auto qResult = pObject->QueryInterface(streamlineRiid, (void**) ppRealObject);
-
-    if (qResult == S_OK && *ppRealObject != nullptr)
-    {
-        LOG_INFO("{} Streamline proxy found!", functionName);
-        (*ppRealObject)->Release();
-        return true;
-    }
-
-    return false;
-}
-
 static int GetCorrectDXGIFormat(int eCurrentFormat)
 {
     switch (eCurrentFormat)
@@ -288,10 +266,11 @@ static void RenderImGui_DX11(IDXGISwapChain* pSwapChain)
 
             if (MenuOverlayBase::RenderMenu())
             {
-                ImGui::Render();
+                MenuOverlayBase::FinishFrame();
 
                 g_pd3dDeviceContext->OMSetRenderTargets(1, &g_pd3dRenderTarget, NULL);
                 ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+                MenuOverlayBase::FrameRendered();
             }
         }
     }
@@ -472,7 +451,7 @@ static void RenderImGui_DX12(IDXGISwapChain* pSwapChainPlain)
 
             if (MenuOverlayBase::RenderMenu())
             {
-                ImGui::Render();
+                MenuOverlayBase::FinishFrame();
 
                 UINT backBufferIdx = pSwapChain->GetCurrentBackBufferIndex();
                 ID3D12CommandAllocator* commandAllocator = g_commandAllocators[backBufferIdx];
@@ -506,7 +485,10 @@ static void RenderImGui_DX12(IDXGISwapChain* pSwapChainPlain)
                 g_pd3dCommandList->OMSetRenderTargets(1, &g_mainRenderTargetDescriptor[backBufferIdx], FALSE, NULL);
                 g_pd3dCommandList->SetDescriptorHeaps(1, &g_pd3dSrvDescHeap);
 
-                ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), g_pd3dCommandList);
+                {
+                    GpuTimer_Dx12::Scope timer(g_pd3dCommandList, GpuPass::Menu);
+                    ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), g_pd3dCommandList);
+                }
 
                 barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_RENDER_TARGET;
                 barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PRESENT;
@@ -523,6 +505,7 @@ static void RenderImGui_DX12(IDXGISwapChain* pSwapChainPlain)
 
                 ID3D12CommandList* ppCommandLists[] = { g_pd3dCommandList };
                 ((ID3D12CommandQueue*) currentSCCommandQueue)->ExecuteCommandLists(1, ppCommandLists);
+                MenuOverlayBase::FrameRendered();
             }
         }
         else
@@ -551,31 +534,31 @@ void MenuOverlayDx::CleanupRenderTarget(bool clearQueue, HWND hWnd)
 }
 
 void MenuOverlayDx::Present(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT Flags,
-                            const DXGI_PRESENT_PARAMETERS* pPresentParameters, IUnknown* pDevice, HWND hWnd, bool isUWP)
+                            const DXGI_PRESENT_PARAMETERS* pPresentParameters, const SwapchainContext_Dx* pContext,
+                            HWND hWnd, bool isUWP)
 {
     LOG_DEBUG("");
 
-    ID3D12CommandQueue* cq = nullptr;
-    ID3D11Device* device = nullptr;
-    ID3D12Device* device12 = nullptr;
+    // Resolved by the swapchain when it was created, owned by its context
+    ID3D12CommandQueue* cq = pContext->queue;
+    ID3D11Device* device = pContext->device11;
+    ID3D12Device* device12 = pContext->device12;
 
-    // try to obtain directx objects and find the path
-    if (pDevice->QueryInterface(IID_PPV_ARGS(&device)) == S_OK)
+    if (device != nullptr)
     {
         if (!_dx11Device)
             LOG_DEBUG("D3D11Device captured");
 
         _dx11Device = true;
     }
-    else if (pDevice->QueryInterface(IID_PPV_ARGS(&cq)) == S_OK)
+    else if (cq != nullptr)
     {
         if (!_dx12Device)
             LOG_DEBUG("D3D12CommandQueue captured");
 
-        if (!CheckForRealObject(__FUNCTION__, pDevice, &currentSCCommandQueue))
-            currentSCCommandQueue = pDevice;
+        currentSCCommandQueue = cq;
 
-        if (((ID3D12CommandQueue*) currentSCCommandQueue)->GetDevice(IID_PPV_ARGS(&device12)) == S_OK)
+        if (device12 != nullptr)
         {
             if (!_dx12Device)
                 LOG_DEBUG("D3D12Device captured");
@@ -634,16 +617,6 @@ void MenuOverlayDx::Present(IDXGISwapChain* pSwapChain, UINT SyncInterval, UINT
         RenderImGui_DX11(pSwapChain);
     else if (_dx12Device)
         RenderImGui_DX12(pSwapChain);
-
-    // release used objects
-    if (cq != nullptr)
-        cq->Release();
-
-    if (device != nullptr)
-        device->Release();
-
-    if (device12 != nullptr)
-        device12->Release();
 }
 
 ID3D12DescriptorHeap* MenuOverlayDx::SrvDescriptorHeap() { return g_pd3dSrvDescHeap; }
@@ -506,7 +506,7 @@ bool MenuOverlayVk::QueuePresent(VkQueue queue, VkPresentInfoKHR* pPresentInfo)
                     vkCmdBeginRenderPass(fd->CommandBuffer, &info, VK_SUBPASS_CONTENTS_INLINE);
                 }
 
-                ImGui::Render();
+                MenuOverlayBase::FinishFrame();
                 ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), fd->CommandBuffer);
 
                 // Submit command buffer
@@ -541,11 +541,12 @@ bool MenuOverlayVk::QueuePresent(VkQueue queue, VkPresentInfoKHR* pPresentInfo)
 
                 pPresentInfo->waitSemaphoreCount = pPresentInfo->swapchainCount;
                 pPresentInfo->pWaitSemaphores = &_ImVulkan_Semaphores[semaphoreIndex];
+                MenuOverlayBase::FrameRendered();
             }
             else
             {
                 // To make RenderMenu happy as it expects this
-                ImGui::Render();
+                MenuOverlayBase::FinishFrame();
             }
         }
     }
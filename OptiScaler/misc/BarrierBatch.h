@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Resource state transitions of one command list, api independent.
+//
+// Callers tell the batch which state a resource has to be in for their next operation and Flush
+// emits everything which changed since the previous flush in one call. Only the state at the
+// previous flush and the last requested one are kept, so asking for the same state again is
+// merged and a transition which is undone before the next flush (giving a resource back to the
+// game and taking it again for the next copy) emits nothing. Resources stay tracked until Finish,
+// states of the game's resources are only known while we are recording into its command list.
+template <typename Resource, typename State> class BarrierBatch
+{
+  public:
+    struct Transition
+    {
+        Resource resource {};
+        State before {};
+        State after {};
+    };
+
+  private:
+    struct Entry
+    {
+        Resource resource {};
+        State flushed {};
+        State desired {};
+    };
+
+    // A pass touches a handful of resources, searching them is cheaper than hashing
+    std::vector<Entry> _entries;
+    std::vector<Transition> _transitions;
+
+    Entry* EntryOf(Resource resource)
+    {
+        for (auto& entry : _entries)
+        {
+            if (entry.resource == resource)
+                return &entry;
+        }
+
+        return nullptr;
+    }
+
+  public:
+    // Resource must be in desired state after the next Flush,
+    // current is only used when the resource is not tracked yet
+    void Require(Resource resource, State current, State desired)
+    {
+        if (auto entry = EntryOf(resource); entry != nullptr)
+        {
+            entry->desired = desired;
+            return;
+        }
+
+        _entries.push_back({ resource, current, desired });
+    }
+
+    // Returns the state the resource will be in after the next Flush
+    State StateOf(Resource resource, State fallback)
+    {
+        auto entry = EntryOf(resource);
+        return entry != nullptr ? entry->desired : fallback;
+    }
+
+    bool IsPending() const
+    {
+        for (const auto& entry : _entries)
+        {
+            if (entry.flushed != entry.desired)
+                return true;
+        }
+
+        return false;
+    }
+
+    bool IsEmpty() const { return _entries.empty(); }
+
+    // emit(const Transition* transitions, size_t count) is called once when anything changed,
+    // returns the number of transitions
+    template <typename Emit> size_t Flush(Emit&& emit)
+    {
+        _transitions.clear();
+
+        for (auto& entry : _entries)
+        {
+            if (entry.flushed == entry.desired)
+                continue;
+
+            _transitions.push_back({ entry.resource, entry.flushed, entry.desired });
+            entry.flushed = entry.desired;
+        }
+
+        if (!_transitions.empty())
+            emit(_transitions.data(), _transitions.size());
+
+        return _transitions.size();
+    }
+
+    // Flushes and forgets every resource
+    template <typename Emit> size_t Finish(Emit&& emit)
+    {
+        auto count = Flush(emit);
+        _entries.clear();
+        return count;
+    }
+
+    // Forgets every resource without emitting, returns the number of transitions which were pending
+    size_t Discard()
+    {
+        size_t count = 0;
+
+        for (const auto& entry : _entries)
+        {
+            if (entry.flushed != entry.desired)
+                count++;
+        }
+
+        _entries.clear();
+        return count;
+    }
+};
+
+// BarrierBatch which records into one command list at a time.
+//
+// Transitions required for a command list only make sense on that list, the previous one may already
+// be closed or submitted when the next list begins. Callers Finish on the list they used, transitions
+// still pending when another list begins are dropped instead of being recorded into the old list.
+template <typename CommandList, typename Resource, typename State> class CommandListBarrierBatch
+{
+    BarrierBatch<Resource, State> _batch;
+    CommandList* _cmdList = nullptr;
+
+  public:
+    using Transition = typename BarrierBatch<Resource, State>::Transition;
+
+    CommandListBarrierBatch() = default;
+    explicit CommandListBarrierBatch(CommandList* cmdList) : _cmdList(cmdList) {}
+
+    // Following transitions are recorded into cmdList, returns the number of dropped transitions
+    size_t Begin(CommandList* cmdList)
+    {
+        if (cmdList == _cmdList)
+            return 0;
+
+        _cmdList = cmdList;
+        return _batch.Discard();
+    }
+
+    void Require(Resource resource, State current, State desired) { _batch.Require(resource, current, desired); }
+    State StateOf(Resource resource, State fallback) { return _batch.StateOf(resource, fallback); }
+    bool IsPending() const { return _batch.IsPending(); }
+    CommandList* List() const { return _cmdList; }
+
+    // record(CommandList* cmdList, const Transition* transitions, size_t count), nothing is recorded
+    // without a command list
+    template <typename Record> size_t Flush(Record&& record)
+    {
+        if (_cmdList == nullptr)
+            return 0;
+
+        return _batch.Flush([&](const Transition* transitions, size_t count)
+                            { record(_cmdList, transitions, count); });
+    }
+
+    template <typename Record> size_t Finish(Record&& record)
+    {
+        auto count = Flush(record);
+        _batch.Discard();
+        return count;
+    }
+};
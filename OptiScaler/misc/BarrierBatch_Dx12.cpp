@@ -0,0 +1,47 @@
+#include "BarrierBatch_Dx12.h"
+
+#include <cassert>
+
+void BarrierBatch_Dx12::Begin(ID3D12GraphicsCommandList* cmdList)
+{
+    auto previous = _batch.List();
+
+    if (auto dropped = _batch.Begin(cmdList); dropped > 0)
+    {
+        // Previous list may be closed or submitted already, recording into it is worse than losing the states
+        LOG_ERROR("{} pending transitions of {:X} dropped by {:X}, missing Finish", dropped, (size_t) previous,
+                  (size_t) cmdList);
+        assert(dropped == 0);
+    }
+}
+
+void BarrierBatch_Dx12::Record(ID3D12GraphicsCommandList* cmdList, const Batch::Transition* transitions, size_t count)
+{
+    _barriers.resize(count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        auto& barrier = _barriers[i];
+        barrier = {};
+        barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+        barrier.Transition.pResource = transitions[i].resource;
+        barrier.Transition.StateBefore = transitions[i].before;
+        barrier.Transition.StateAfter = transitions[i].after;
+        barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+    }
+
+    cmdList->ResourceBarrier((UINT) count, _barriers.data());
+}
+
+void BarrierBatch_Dx12::Flush()
+{
+    _batch.Flush([this](auto* cmdList, const auto* transitions, size_t count)
+                 { Record(cmdList, transitions, count); });
+}
+
+void BarrierBatch_Dx12::Finish()
+{
+    // Without a command list there is nothing to record into, states are lost either way
+    _batch.Finish([this](auto* cmdList, const auto* transitions, size_t count)
+                  { Record(cmdList, transitions, count); });
+}
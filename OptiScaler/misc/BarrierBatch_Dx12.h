@@ -0,0 +1,52 @@
+#pragma once
+#include <pch.h>
+
+#include "BarrierBatch.h"
+
+#include <d3d12.h>
+
+#include <vector>
+
+// Transition barriers of one command list, recorded with a single ResourceBarrier call per flush.
+//
+// Only whole resources in legacy states, the game owns the states of its resources and we give them
+// back in the state it handed them to us. Pending transitions are flushed when the batch is destroyed,
+// callers Finish before the batch begins another command list or the pending ones are dropped.
+class BarrierBatch_Dx12
+{
+    using Batch = CommandListBarrierBatch<ID3D12GraphicsCommandList, ID3D12Resource*, D3D12_RESOURCE_STATES>;
+
+    Batch _batch;
+    std::vector<D3D12_RESOURCE_BARRIER> _barriers;
+
+    void Record(ID3D12GraphicsCommandList* cmdList, const Batch::Transition* transitions, size_t count);
+
+  public:
+    BarrierBatch_Dx12() = default;
+    explicit BarrierBatch_Dx12(ID3D12GraphicsCommandList* cmdList) : _batch(cmdList) {}
+    ~BarrierBatch_Dx12() { Finish(); }
+
+    BarrierBatch_Dx12(const BarrierBatch_Dx12&) = delete;
+    BarrierBatch_Dx12& operator=(const BarrierBatch_Dx12&) = delete;
+
+    // Following transitions are recorded into cmdList, pending ones of the previous list are dropped
+    void Begin(ID3D12GraphicsCommandList* cmdList);
+
+    void Require(ID3D12Resource* resource, D3D12_RESOURCE_STATES current, D3D12_RESOURCE_STATES desired)
+    {
+        _batch.Require(resource, current, desired);
+    }
+
+    D3D12_RESOURCE_STATES StateOf(ID3D12Resource* resource, D3D12_RESOURCE_STATES fallback)
+    {
+        return _batch.StateOf(resource, fallback);
+    }
+
+    ID3D12GraphicsCommandList* CommandList() const { return _batch.List(); }
+
+    // Records the pending transitions, called before the work which needs them
+    void Flush();
+
+    // Flushes and forgets the resources, called at the end of the pass
+    void Finish();
+};
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+// Per context state of the input translators, one record per context of the game.
+//
+// Records live in slots which are reused after Remove, every reuse bumps the generation of the slot.
+// Contexts created by OptiScaler itself get their handle as the context value, Find decodes it
+// without hashing and a stale handle of a destroyed context doesn't match the new owner of its slot.
+// Contexts allocated by the game (FSR2/3 context memory, ffx contexts with hot swapping) are found
+// through one hash lookup. Records don't move, pointers stay valid until their context is removed.
+//
+// Not synchronized, like the maps it replaces. Api calls of one input come from the game's render thread.
+template <typename Key, typename Record> class ContextRegistry
+{
+    static_assert(std::is_pointer_v<Key>, "Contexts are identified by pointer sized handles");
+
+  public:
+    using Handle = uint64_t;
+
+    // Generation 0 is never used so a zeroed handle can't match
+    static uint32_t NextGeneration(uint32_t generation) { return generation == UINT32_MAX ? 1 : generation + 1; }
+
+  private:
+    struct Slot
+    {
+        Key key = nullptr;
+        uint32_t generation = 1;
+        bool used = false;
+        Record record {};
+    };
+
+    std::deque<Slot> _slots;
+    std::vector<uint32_t> _free;
+    std::unordered_map<Key, uint32_t> _index;
+
+    static Handle MakeHandle(uint32_t slot, uint32_t generation) { return (Handle) generation << 32 | (slot + 1); }
+
+    Slot* SlotOf(Key key)
+    {
+        auto handle = (Handle) key;
+        auto slot = (uint32_t) handle;
+
+        if (slot == 0 || slot > _slots.size())
+            return nullptr;
+
+        auto& entry = _slots[slot - 1];
+
+        if (!entry.used || entry.generation != (uint32_t) (handle >> 32) || entry.key != key)
+            return nullptr;
+
+        return &entry;
+    }
+
+    uint32_t AllocateSlot()
+    {
+        if (!_free.empty())
+        {
+            auto slot = _free.back();
+            _free.pop_back();
+            return slot;
+        }
+
+        _slots.emplace_back();
+        return (uint32_t) _slots.size() - 1;
+    }
+
+  public:
+    // Adds a context of the game, an existing record of the key is reset
+    Record& Add(Key key)
+    {
+        if (auto existing = Find(key); existing != nullptr)
+        {
+            *existing = Record {};
+            return *existing;
+        }
+
+        auto slot = AllocateSlot();
+        auto& entry = _slots[slot];
+        entry.key = key;
+        entry.used = true;
+        _index[key] = slot;
+
+        return entry.record;
+    }
+
+    // Adds a context created by OptiScaler, key receives the handle which should be given to the game
+    Record& Create(Key& key)
+    {
+        auto slot = AllocateSlot();
+        auto& entry = _slots[slot];
+        entry.key = reinterpret_cast<Key>(MakeHandle(slot, entry.generation));
+        entry.used = true;
+        _index[entry.key] = slot;
+
+        key = entry.key;
+        return entry.record;
+    }
+
+    Record* Find(Key key)
+    {
+        if (key == nullptr)
+            return nullptr;
+
+        if (auto entry = SlotOf(key); entry != nullptr)
+            return &entry->record;
+
+        auto it = _index.find(key);
+
+        if (it == _index.end())
+            return nullptr;
+
+        return &_slots[it->second].record;
+    }
+
+    bool Contains(Key key) { return Find(key) != nullptr; }
+
+    // Record of the key is destroyed, returns false when the key is unknown
+    bool Remove(Key key)
+    {
+        auto it = key == nullptr ? _index.end() : _index.find(key);
+
+        if (it == _index.end())
+            return false;
+
+        auto slot = it->second;
+        _index.erase(it);
+
+        auto& entry = _slots[slot];
+        entry.key = nullptr;
+        entry.used = false;
+        entry.record = Record {};
+
+        entry.generation = NextGeneration(entry.generation);
+        _free.push_back(slot);
+        return true;
+    }
+
+    size_t Size() const { return _index.size(); }
+};
@@ -0,0 +1,243 @@
+#include <pch.h>
+
+#include "DeferredLog.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// Single producer (owner thread), single consumer (formatting thread) byte ring
+struct Ring
+{
+    static constexpr size_t Size = 64 * 1024;
+
+    std::byte data[Size];
+    std::atomic<uint64_t> head = 0;
+    std::atomic<uint64_t> tail = 0;
+    std::atomic<bool> closed = false;
+
+    void CopyIn(uint64_t position, const void* source, size_t size)
+    {
+        auto offset = (size_t) (position % Size);
+        auto first = std::min(size, Size - offset);
+
+        std::memcpy(data + offset, source, first);
+        std::memcpy(data, (const std::byte*) source + first, size - first);
+    }
+
+    void CopyOut(uint64_t position, void* target, size_t size) const
+    {
+        auto offset = (size_t) (position % Size);
+        auto first = std::min(size, Size - offset);
+
+        std::memcpy(target, data + offset, first);
+        std::memcpy((std::byte*) target + first, data, size - first);
+    }
+};
+
+// Marks the ring closed when its thread exits, formatting thread drops it after reading the rest
+struct ThreadRing
+{
+    std::shared_ptr<Ring> ring;
+
+    ~ThreadRing()
+    {
+        if (ring != nullptr)
+            ring->closed.store(true, std::memory_order_release);
+    }
+};
+
+std::atomic<bool> _running = false;
+std::atomic<DeferredLog::Sink> _sink = nullptr;
+
+std::mutex _ringsMutex;
+std::vector<std::shared_ptr<Ring>> _rings;
+
+// Held while records are formatted, so Stop and the thread don't read the same ring
+std::mutex _drainMutex;
+
+// Formatting thread sleeps until a record is written, writers only notify when it is sleeping
+std::mutex _wakeMutex;
+std::condition_variable _wake;
+std::atomic<bool> _sleeping = false;
+
+thread_local ThreadRing _threadRing;
+
+Ring* GetThreadRing()
+{
+    if (_threadRing.ring == nullptr)
+    {
+        _threadRing.ring = std::make_shared<Ring>();
+
+        std::lock_guard<std::mutex> lock(_ringsMutex);
+        _rings.push_back(_threadRing.ring);
+    }
+
+    return _threadRing.ring.get();
+}
+
+void Drain()
+{
+    std::vector<std::shared_ptr<Ring>> rings;
+
+    {
+        std::lock_guard<std::mutex> lock(_ringsMutex);
+        rings = _rings;
+    }
+
+    auto sink = _sink.load(std::memory_order_acquire);
+    std::byte args[DeferredLog::MaxArgsSize];
+    std::string message;
+
+    for (auto& ring : rings)
+    {
+        // Closed flag is read first, everything its thread wrote is visible after it
+        bool closed = ring->closed.load(std::memory_order_acquire);
+        auto head = ring->head.load(std::memory_order_acquire);
+        auto tail = ring->tail.load(std::memory_order_relaxed);
+
+        while (tail < head)
+        {
+            DeferredLog::RecordHeader header;
+            ring->CopyOut(tail, &header, sizeof(header));
+            ring->CopyOut(tail + sizeof(header), args, header.size);
+            tail += sizeof(header) + header.size;
+
+            if (sink == nullptr)
+                continue;
+
+            try
+            {
+                header.decode(header.site->format, args, message);
+            }
+            catch (const std::exception& ex)
+            {
+                message = std::string("Deferred log format error: ") + ex.what();
+            }
+
+            sink(header.site->level, header.time, message);
+        }
+
+        ring->tail.store(tail, std::memory_order_release);
+
+        if (closed)
+        {
+            std::lock_guard<std::mutex> lock(_ringsMutex);
+            std::erase(_rings, ring);
+        }
+    }
+}
+
+bool HasRecords()
+{
+    std::lock_guard<std::mutex> lock(_ringsMutex);
+
+    for (const auto& ring : _rings)
+    {
+        if (ring->head.load(std::memory_order_seq_cst) != ring->tail.load(std::memory_order_relaxed))
+            return true;
+    }
+
+    return false;
+}
+
+// Waits until a record is written, returns false when stopped
+bool WaitForRecords()
+{
+    std::unique_lock<std::mutex> lock(_wakeMutex);
+
+    // Flag is raised before the last check, a record written after the check sees it and wakes us
+    _sleeping.store(true, std::memory_order_seq_cst);
+
+    if (!HasRecords())
+    {
+        _wake.wait(lock,
+                   []
+                   {
+                       return !_sleeping.load(std::memory_order_acquire) ||
+                              !_running.load(std::memory_order_acquire);
+                   });
+    }
+
+    _sleeping.store(false, std::memory_order_relaxed);
+    return _running.load(std::memory_order_acquire);
+}
+
+void ThreadMain()
+{
+    while (WaitForRecords())
+    {
+        // Writers don't wake us while we are awake, so the rest of the frame's records are
+        // formatted in one go instead of one wake per record
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        std::lock_guard<std::mutex> lock(_drainMutex);
+        Drain();
+    }
+}
+
+void WakeThread()
+{
+    if (!_sleeping.load(std::memory_order_seq_cst) || !_sleeping.exchange(false, std::memory_order_acq_rel))
+        return;
+
+    // Taking the lock makes sure the thread is inside wait and doesn't miss the notify
+    std::lock_guard<std::mutex> lock(_wakeMutex);
+    _wake.notify_one();
+}
+} // namespace
+
+bool DeferredLog::Write(const RecordHeader& header, const void* args)
+{
+    if (!_running.load(std::memory_order_acquire))
+        return false;
+
+    auto ring = GetThreadRing();
+    auto size = sizeof(header) + header.size;
+    auto head = ring->head.load(std::memory_order_relaxed);
+
+    if (head + size - ring->tail.load(std::memory_order_acquire) > Ring::Size)
+        return false;
+
+    ring->CopyIn(head, &header, sizeof(header));
+    ring->CopyIn(head + sizeof(header), args, header.size);
+    ring->head.store(head + size, std::memory_order_seq_cst);
+
+    WakeThread();
+    return true;
+}
+
+void DeferredLog::Start(Sink sink)
+{
+    _sink.store(sink, std::memory_order_release);
+
+    if (_running.exchange(true, std::memory_order_acq_rel))
+        return;
+
+    // Not joined, Stop can be called while the loader lock is held
+    std::thread(ThreadMain).detach();
+}
+
+void DeferredLog::Stop()
+{
+    if (!_running.exchange(false, std::memory_order_acq_rel))
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        _wake.notify_all();
+    }
+
+    // Thread might be gone already when the process is exiting, format what is left here
+    if (_drainMutex.try_lock())
+    {
+        Drain();
+        _drainMutex.unlock();
+    }
+}
+
+bool DeferredLog::IsRunning() { return _running.load(std::memory_order_acquire); }
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+// Only Decode and Log need <format>, Write and the thread build with older standard libraries too
+#if __has_include(<format>)
+#include <format>
+#define DEFERRED_LOG_HAS_FORMAT
+#endif
+
+// Log records which are formatted later on a background thread.
+//
+// Every call site has a static Site (format string and level), its address is the id of the format
+// string. A record is the site, a decoder for the argument types, a timestamp and the raw bytes of
+// the arguments. Records are written into a ring of the calling thread, so hot paths only pay for
+// a few stores. Only trivially copyable arguments can be deferred, pointers are logged as addresses
+// (char pointers are rejected because they would be read too late).
+namespace DeferredLog
+{
+using Clock = std::chrono::system_clock;
+using Sink = void (*)(int level, Clock::time_point time, std::string_view message);
+using Decoder = void (*)(const char* format, const std::byte* args, std::string& out);
+
+struct Site
+{
+    int level;
+    const char* format;
+};
+
+struct RecordHeader
+{
+    const Site* site;
+    Decoder decode;
+    Clock::time_point time;
+    uint32_t size;
+};
+
+constexpr size_t MaxArgsSize = 128;
+
+template <typename T>
+constexpr bool IsDeferrable = std::is_trivially_copyable_v<T> && !std::is_same_v<T, char*> &&
+                              !std::is_same_v<T, const char*> && !std::is_same_v<T, wchar_t*> &&
+                              !std::is_same_v<T, const wchar_t*>;
+
+template <typename... Args> constexpr size_t ArgsSize() { return (sizeof(Args) + ... + 0); }
+
+// Returns false when the record couldn't be queued (not started or ring of the thread is full)
+bool Write(const RecordHeader& header, const void* args);
+
+// Copies the arguments into a record for decode, returns false like Write
+template <typename... Args> bool Queue(const Site* site, Decoder decode, const Args&... args)
+{
+    static_assert((IsDeferrable<Args> && ...), "Only trivially copyable values can be logged deferred");
+    static_assert(ArgsSize<Args...>() <= MaxArgsSize, "Too many arguments for a deferred log");
+
+    std::byte buffer[ArgsSize<Args...>() + 1];
+    std::byte* cursor = buffer;
+    ((std::memcpy(cursor, &args, sizeof(args)), cursor += sizeof(args)), ...);
+
+    RecordHeader header { site, decode, Clock::now(), (uint32_t) ArgsSize<Args...>() };
+    return Write(header, buffer);
+}
+
+#ifdef DEFERRED_LOG_HAS_FORMAT
+template <typename... Args> void Decode(const char* format, const std::byte* args, std::string& out)
+{
+    std::tuple<Args...> values;
+    std::apply(
+        [&](auto&... value)
+        {
+            ((std::memcpy(&value, args, sizeof(value)), args += sizeof(value)), ...);
+            out = std::vformat(format, std::make_format_args(value...));
+        },
+        values);
+}
+
+// Arguments are evaluated once by the caller, fallback formats them immediately when they can't be queued
+template <typename Fallback, typename... Args> void Log(const Site* site, Fallback&& fallback, const Args&... args)
+{
+    if (!Queue(site, &Decode<Args...>, args...))
+        fallback(args...);
+}
+#endif
+
+// Starts the formatting thread, records are passed to sink in order of each thread
+void Start(Sink sink);
+
+// Formats everything which is queued and stops the thread
+void Stop();
+
+bool IsRunning();
+} // namespace DeferredLog
+
+// Queues the record when the background thread is running, otherwise calls fallback(msg, ...).
+// Format string is kept outside of the lambda, __FUNCTION__ would name the lambda there.
+#define DEFERRED_LOG(level, fallback, msg, ...)                                                                        \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        static constexpr char _deferredLogFormat[] = msg;                                                              \
+        static constexpr DeferredLog::Site _deferredLogSite { (int) (level), _deferredLogFormat };                     \
+        DeferredLog::Log(                                                                                              \
+            &_deferredLogSite, [](const auto&... _args) { fallback(_deferredLogFormat, _args...); }, ##__VA_ARGS__);   \
+    } while (false)
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Api independent part of the deferred destruction, objects are released when a fence value which
+// was tied to their last use is completed. Values only have to be monotonic, they can come from a
+// D3D12 fence, a Vulkan timeline semaphore or CpuFence.
+
+// CPU side fence with the same completed value interface as ID3D12Fence, signalled manually
+class CpuFence
+{
+    std::atomic<uint64_t> _completed = 0;
+
+  public:
+    void Signal(uint64_t value) { _completed.store(value, std::memory_order_release); }
+    uint64_t GetCompletedValue() const { return _completed.load(std::memory_order_acquire); }
+};
+
+class DeferredReleaseQueue
+{
+  public:
+    using Release = std::function<void()>;
+
+  private:
+    struct Entry
+    {
+        uint64_t retireValue = 0;
+        Release release;
+        std::string name;
+    };
+
+    std::deque<Entry> _entries;
+    mutable std::mutex _mutex;
+
+    // Releases are run outside of the lock, they might queue new entries
+    static size_t Run(std::vector<Entry>& entries)
+    {
+        for (auto& entry : entries)
+        {
+            if (entry.release)
+                entry.release();
+        }
+
+        return entries.size();
+    }
+
+  public:
+    // Entries are retired in push order, an entry is never released before the ones pushed earlier
+    // even when its own value is lower
+    void Push(uint64_t retireValue, Release release, std::string_view name = "")
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _entries.push_back({ retireValue, std::move(release), std::string(name) });
+    }
+
+    // Releases entries whose value is completed, returns the count of released entries
+    size_t Retire(uint64_t completedValue)
+    {
+        std::vector<Entry> ready;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            while (!_entries.empty() && _entries.front().retireValue <= completedValue)
+            {
+                ready.push_back(std::move(_entries.front()));
+                _entries.pop_front();
+            }
+        }
+
+        return Run(ready);
+    }
+
+    template <typename Fence> size_t Retire(const Fence* fence) { return Retire(fence->GetCompletedValue()); }
+
+    // Releases everything, caller must make sure GPU is done with them
+    size_t Flush()
+    {
+        std::vector<Entry> ready;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            while (!_entries.empty())
+            {
+                ready.push_back(std::move(_entries.front()));
+                _entries.pop_front();
+            }
+        }
+
+        return Run(ready);
+    }
+
+    size_t Pending() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _entries.size();
+    }
+
+    // Highest value which needs to be completed for Flush to be safe, 0 when empty
+    uint64_t LastValue() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        uint64_t value = 0;
+
+        for (const auto& entry : _entries)
+            value = entry.retireValue > value ? entry.retireValue : value;
+
+        return value;
+    }
+};
@@ -0,0 +1,102 @@
+#include "DeferredRelease_Dx12.h"
+
+bool DeferredRelease_Dx12::Init(ID3D12Device* device)
+{
+    std::lock_guard<std::mutex> lock(_initMutex);
+
+    if (_fence != nullptr)
+        return true;
+
+    if (device == nullptr)
+        return false;
+
+    ID3D12Fence* fence = nullptr;
+    auto result = device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence));
+
+    if (result != S_OK)
+    {
+        LOG_ERROR("CreateFence error: {:X}", (UINT) result);
+        return false;
+    }
+
+    _fence = fence;
+
+    LOG_INFO("Deferred release fence created");
+    return true;
+}
+
+bool DeferredRelease_Dx12::Defer(DeferredReleaseQueue::Release release, std::string_view name)
+{
+    if (!IsActive())
+        return false;
+
+    // Frame which is being recorded might already have used the object, next signal can be the one
+    // of the previous frame when present runs on another thread. Second signal covers both cases.
+    auto retireValue = RetireValue();
+    _queue.Push(retireValue, std::move(release), name);
+
+    LOG_DEBUG("{} will be released after fence value {}", name, retireValue);
+    return true;
+}
+
+void DeferredRelease_Dx12::Release(IUnknown* object, std::string_view name)
+{
+    if (object == nullptr)
+        return;
+
+    if (!Defer([object]() { object->Release(); }, name))
+        object->Release();
+}
+
+void DeferredRelease_Dx12::EndFrame(ID3D12CommandQueue* queue)
+{
+    if (_fence == nullptr || queue == nullptr)
+        return;
+
+    auto value = _signalledValue.load(std::memory_order_relaxed) + 1;
+
+    if (queue->Signal(_fence, value) == S_OK)
+        _signalledValue.store(value, std::memory_order_release);
+}
+
+void DeferredRelease_Dx12::Collect()
+{
+    if (_fence == nullptr || _queue.Pending() == 0)
+        return;
+
+    auto released = _queue.Retire(_fence);
+
+    if (released > 0)
+        LOG_DEBUG("Released {} deferred objects", released);
+}
+
+void DeferredRelease_Dx12::Flush(DWORD timeoutMs)
+{
+    if (_queue.Pending() == 0)
+        return;
+
+    if (_fence != nullptr)
+    {
+        // Values after the last signal will never complete, wait for what can be waited
+        auto waitValue = std::min(_queue.LastValue(), _signalledValue.load(std::memory_order_acquire));
+
+        if (_fence->GetCompletedValue() < waitValue)
+        {
+            auto event = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+
+            if (event != nullptr)
+            {
+                if (_fence->SetEventOnCompletion(waitValue, event) == S_OK &&
+                    WaitForSingleObject(event, timeoutMs) == WAIT_TIMEOUT)
+                {
+                    LOG_WARN("Timeout while waiting for fence value {}", waitValue);
+                }
+
+                CloseHandle(event);
+            }
+        }
+    }
+
+    auto released = _queue.Flush();
+    LOG_DEBUG("Flushed {} deferred objects", released);
+}
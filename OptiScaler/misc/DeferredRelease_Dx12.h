@@ -0,0 +1,60 @@
+#pragma once
+#include <pch.h>
+
+#include "DeferredRelease.h"
+
+#include <d3d12.h>
+
+#include <memory>
+
+// Deferred destruction for the DX12 path.
+//
+// EndFrame signals a fence on the present queue, objects which are deferred during a frame are
+// released after the signal of that frame is completed. Work which was recorded for the object
+// before the present is covered this way without waiting on the CPU.
+class DeferredRelease_Dx12
+{
+  public:
+    static bool Init(ID3D12Device* device);
+
+    // True after the first frame was signalled, before that nothing can be deferred
+    static bool IsActive() { return _fence != nullptr && _signalledValue.load(std::memory_order_acquire) > 0; }
+
+    // Returns false when deferring is not possible, caller should release the object itself
+    static bool Defer(DeferredReleaseQueue::Release release, std::string_view name);
+
+    // Object is only moved when it is deferred
+    template <typename T> static bool Defer(std::unique_ptr<T>& object, std::string_view name)
+    {
+        if (object == nullptr || !IsActive())
+            return false;
+
+        auto shared = std::shared_ptr<T>(std::move(object));
+        return Defer([shared]() mutable { shared.reset(); }, name);
+    }
+
+    // Releases a D3D object (resource, heap, pipeline) after RetireValue(), or at once when nothing can be
+    // deferred yet. Takes over the reference of the caller.
+    static void Release(IUnknown* object, std::string_view name);
+
+    // Fence value after which work recorded until now is completed, see Defer
+    static UINT64 RetireValue() { return _signalledValue.load(std::memory_order_acquire) + 2; }
+
+    // 0 before Init
+    static UINT64 CompletedValue() { return _fence != nullptr ? _fence->GetCompletedValue() : 0; }
+
+    // Called once per presented frame with the queue used for presenting
+    static void EndFrame(ID3D12CommandQueue* queue);
+
+    // Releases completed objects, called from the render thread so destructors run there
+    static void Collect();
+
+    // Waits up to timeoutMs for pending objects and releases all of them
+    static void Flush(DWORD timeoutMs = 1000);
+
+  private:
+    inline static ID3D12Fence* _fence = nullptr;
+    inline static std::atomic<UINT64> _signalledValue = 0;
+    inline static DeferredReleaseQueue _queue;
+    inline static std::mutex _initMutex;
+};
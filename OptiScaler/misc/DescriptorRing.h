@@ -0,0 +1,128 @@
+#pragma once
+
+#include "TransientPlanner.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <optional>
+
+// Index allocator of the shared shader visible descriptor heap, api independent.
+//
+// Heap is split in a persistent region at the start and a ring after it. Persistent ranges stay
+// until they are freed and are reused after the fence value given to FreePersistent. Transient
+// ranges are linear allocations from the ring, EndFrame tags everything allocated since the
+// previous call with a fence value and the tail of the ring passes them when it is completed.
+// Ranges are always contiguous, an allocation which doesn't fit at the end of the ring starts
+// again at its beginning. Reset drops every range when the heap is created again, ranges carry
+// the generation they were allocated in so a stale one is never freed into the new heap.
+class DescriptorRing
+{
+    struct Frame
+    {
+        uint64_t retireValue = 0;
+        uint64_t head = 0;
+    };
+
+    TransientPlanner _persistent;
+    uint32_t _generation = 1;
+    uint32_t _ringStart = 0;
+    uint32_t _ringSize = 0;
+
+    // Positions only grow, index in the ring is position % _ringSize
+    uint64_t _head = 0;
+    uint64_t _tail = 0;
+    uint64_t _peak = 0;
+
+    std::deque<Frame> _frames;
+
+  public:
+    DescriptorRing(uint32_t persistentCount, uint32_t ringCount)
+        : _persistent(persistentCount), _ringStart(persistentCount), _ringSize(ringCount)
+    {
+    }
+
+    uint32_t Capacity() const { return _ringStart + _ringSize; }
+
+    // Returns the first index in the heap, nullopt when the ring has no room for count descriptors
+    std::optional<uint32_t> AllocateTransient(uint32_t count)
+    {
+        if (count == 0 || count > _ringSize)
+            return std::nullopt;
+
+        auto position = _head;
+        auto offset = (uint32_t) (position % _ringSize);
+
+        // Skip the rest of the ring when the range would wrap around
+        if (offset + count > _ringSize)
+            position += _ringSize - offset;
+
+        if (position + count - _tail > _ringSize)
+            return std::nullopt;
+
+        _head = position + count;
+        _peak = std::max(_peak, _head - _tail);
+
+        return _ringStart + (uint32_t) (position % _ringSize);
+    }
+
+    std::optional<uint32_t> AllocatePersistent(uint32_t count)
+    {
+        auto allocation = _persistent.Allocate(count, 1);
+
+        if (!allocation.has_value())
+            return std::nullopt;
+
+        return (uint32_t) allocation->offset;
+    }
+
+    // Range can be reused after retireValue is completed, false when it is from an earlier generation
+    bool FreePersistent(uint32_t index, uint32_t count, uint64_t retireValue, uint32_t generation)
+    {
+        if (generation != _generation)
+            return false;
+
+        _persistent.Free({ index, count, false }, retireValue);
+        return true;
+    }
+
+    // Transient ranges allocated since the last call are reused after retireValue is completed
+    void EndFrame(uint64_t retireValue)
+    {
+        auto last = _frames.empty() ? _tail : _frames.back().head;
+
+        if (last == _head)
+            return;
+
+        _frames.push_back({ retireValue, _head });
+    }
+
+    void Reclaim(uint64_t completedValue)
+    {
+        while (!_frames.empty() && _frames.front().retireValue <= completedValue)
+        {
+            _tail = _frames.front().head;
+            _frames.pop_front();
+        }
+
+        _persistent.Reclaim(completedValue);
+    }
+
+    // Forgets every range, heap behind it is gone
+    void Reset()
+    {
+        _persistent = TransientPlanner(_ringStart);
+        _frames.clear();
+        _head = 0;
+        _tail = 0;
+        _peak = 0;
+        _generation++;
+    }
+
+    uint32_t Generation() const { return _generation; }
+    uint32_t TransientUsed() const { return (uint32_t) (_head - _tail); }
+    uint32_t TransientPeak() const { return (uint32_t) _peak; }
+    uint32_t TransientCapacity() const { return _ringSize; }
+    uint32_t PersistentUsed() const { return (uint32_t) _persistent.Used(); }
+    uint32_t PersistentCapacity() const { return _ringStart; }
+};
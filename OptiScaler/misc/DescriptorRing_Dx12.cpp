@@ -0,0 +1,200 @@
+#include "DescriptorRing_Dx12.h"
+
+#include "DeferredRelease_Dx12.h"
+
+#include <State.h>
+
+void DescriptorRing_Dx12::ReleaseHeap()
+{
+    if (_heap == nullptr)
+        return;
+
+    // Command lists recorded before might still use the views
+    DeferredRelease_Dx12::Release(_heap, "Descriptor ring");
+
+    _heap = nullptr;
+    _device = nullptr;
+    _failed = 0;
+    _ring.Reset();
+}
+
+bool DescriptorRing_Dx12::Init(ID3D12Device* device)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (device == nullptr)
+        return false;
+
+    if (_heap != nullptr)
+    {
+        if (device == _device)
+            return true;
+
+        LOG_INFO("Device changed, creating descriptor ring again, {} persistent descriptors dropped",
+                 _ring.PersistentUsed());
+
+        ReleaseHeap();
+    }
+
+    D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
+    heapDesc.NumDescriptors = PersistentCount + RingCount;
+    heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+    heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+
+    State::Instance().skipHeapCapture = true;
+
+    ID3D12DescriptorHeap* heap = nullptr;
+    auto result = device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&heap));
+
+    State::Instance().skipHeapCapture = false;
+
+    if (result != S_OK)
+    {
+        LOG_ERROR("CreateDescriptorHeap error: {:X}", (UINT) result);
+        return false;
+    }
+
+    heap->SetName(L"OptiScaler_DescriptorRing");
+
+    _device = device;
+    _cpuStart = heap->GetCPUDescriptorHandleForHeapStart();
+    _gpuStart = heap->GetGPUDescriptorHandleForHeapStart();
+    _increment = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    _heap = heap;
+
+    LOG_INFO("Descriptor ring created, persistent: {}, transient: {}", PersistentCount, RingCount);
+    return true;
+}
+
+DescriptorRing_Dx12::Range DescriptorRing_Dx12::MakeRange(uint32_t index, uint32_t count)
+{
+    Range range;
+    range.index = index;
+    range.count = count;
+    range.increment = _increment;
+    range.generation = _ring.Generation();
+    range.cpu.ptr = _cpuStart.ptr + (SIZE_T) index * _increment;
+    range.gpu.ptr = _gpuStart.ptr + (UINT64) index * _increment;
+
+    return range;
+}
+
+bool DescriptorRing_Dx12::AllocateTransient(ID3D12Device* device, uint32_t count, Range& range)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_heap == nullptr || device != _device)
+        return false;
+
+    auto index = _ring.AllocateTransient(count);
+
+    // Until the first present signalled the fence nothing is known to be completed, dispatches
+    // recorded so far can still be reading any range. The first EndFrame tags all of them.
+    if (!index.has_value() && DeferredRelease_Dx12::IsActive())
+    {
+        _ring.Reclaim(DeferredRelease_Dx12::CompletedValue());
+        index = _ring.AllocateTransient(count);
+    }
+
+    if (!index.has_value())
+    {
+        // GPU is too far behind, skipping the pass is better than overwriting views in use
+        if (_failed++ == 0)
+            LOG_WARN("Descriptor ring is full, {} descriptors in use", _ring.TransientUsed());
+
+        return false;
+    }
+
+    range = MakeRange(index.value(), count);
+    return true;
+}
+
+bool DescriptorRing_Dx12::AllocatePersistent(ID3D12Device* device, uint32_t count, Range& range)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_heap == nullptr || device != _device)
+        return false;
+
+    auto index = _ring.AllocatePersistent(count);
+
+    if (!index.has_value())
+    {
+        LOG_ERROR("No room for {} persistent descriptors", count);
+        return false;
+    }
+
+    range = MakeRange(index.value(), count);
+    return true;
+}
+
+void DescriptorRing_Dx12::FreePersistent(Range& range)
+{
+    if (!range.IsValid())
+        return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Stale ranges went away with their heap
+    auto retireValue = DeferredRelease_Dx12::IsActive() ? DeferredRelease_Dx12::RetireValue() : 0;
+    _ring.FreePersistent(range.index, range.count, retireValue, range.generation);
+
+    range = {};
+}
+
+bool DescriptorRing_Dx12::IsCurrent(const Range& range)
+{
+    if (!range.IsValid())
+        return false;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _heap != nullptr && range.generation == _ring.Generation();
+}
+
+bool DescriptorRing_Dx12::Bind(ID3D12GraphicsCommandList* cmdList, const Range& range)
+{
+    ID3D12DescriptorHeap* heap = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        // Heap was replaced by another device after the views were written
+        if (range.generation != _ring.Generation())
+            return false;
+
+        heap = _heap;
+    }
+
+    if (heap == nullptr)
+        return false;
+
+    // Heap stays alive until the work recorded now is completed, ReleaseHeap defers it
+    ID3D12DescriptorHeap* heaps[] = { heap };
+    cmdList->SetDescriptorHeaps(_countof(heaps), heaps);
+    return true;
+}
+
+void DescriptorRing_Dx12::EndFrame()
+{
+    if (!DeferredRelease_Dx12::IsActive())
+        return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_heap == nullptr)
+        return;
+
+    _ring.EndFrame(DeferredRelease_Dx12::RetireValue());
+    _ring.Reclaim(DeferredRelease_Dx12::CompletedValue());
+}
+
+void DescriptorRing_Dx12::Shutdown()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_heap == nullptr)
+        return;
+
+    LOG_INFO("Releasing descriptor ring, transient peak: {}", _ring.TransientPeak());
+    ReleaseHeap();
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <pch.h>
+
+#include "DescriptorRing.h"
+
+#include <d3d12.h>
+
+#include <mutex>
+
+// Shader visible CBV/SRV/UAV heap shared by the internal compute passes.
+//
+// Passes take the views of one dispatch from the ring, they are reclaimed with the deferred
+// release fence so a range is never rewritten while the GPU can still read it. Views which don't
+// change between dispatches (constant buffers) live in the persistent region. Before the fence
+// is active nothing is reclaimed, passes are skipped if the ring fills up before the first present
+// signals it. When passes are created for another device the heap is created again
+// for it, ranges of the old heap become stale and passes of the old device can't allocate.
+class DescriptorRing_Dx12
+{
+  public:
+    struct Range
+    {
+        D3D12_CPU_DESCRIPTOR_HANDLE cpu {};
+        D3D12_GPU_DESCRIPTOR_HANDLE gpu {};
+        uint32_t index = 0;
+        uint32_t count = 0;
+        uint32_t increment = 0;
+        uint32_t generation = 0;
+
+        bool IsValid() const { return count > 0; }
+
+        D3D12_CPU_DESCRIPTOR_HANDLE Cpu(uint32_t i) const { return { cpu.ptr + (SIZE_T) i * increment }; }
+        D3D12_GPU_DESCRIPTOR_HANDLE Gpu(uint32_t i) const { return { gpu.ptr + (UINT64) i * increment }; }
+    };
+
+    static constexpr uint32_t PersistentCount = 256;
+    static constexpr uint32_t RingCount = 3840;
+
+    // Heap belongs to the last device passes were created for, a new device replaces it
+    static bool Init(ID3D12Device* device);
+    static bool IsInit() { return _heap != nullptr; }
+
+    // Range was allocated from the current heap
+    static bool IsCurrent(const Range& range);
+
+    // Views for a single dispatch, valid until the frame they were recorded in is completed
+    static bool AllocateTransient(ID3D12Device* device, uint32_t count, Range& range);
+
+    static bool AllocatePersistent(ID3D12Device* device, uint32_t count, Range& range);
+
+    // Range is reused after the GPU is done with the current frame, range is cleared
+    static void FreePersistent(Range& range);
+
+    // Binds the heap range was allocated from, false when it was replaced meanwhile
+    static bool Bind(ID3D12GraphicsCommandList* cmdList, const Range& range);
+
+    // Called once per presented frame after DeferredRelease_Dx12::EndFrame
+    static void EndFrame();
+
+    // Releases the heap, ranges allocated before become stale
+    static void Shutdown();
+
+  private:
+    inline static ID3D12DescriptorHeap* _heap = nullptr;
+    inline static ID3D12Device* _device = nullptr;
+    inline static D3D12_CPU_DESCRIPTOR_HANDLE _cpuStart {};
+    inline static D3D12_GPU_DESCRIPTOR_HANDLE _gpuStart {};
+    inline static uint32_t _increment = 0;
+    inline static uint32_t _failed = 0;
+    inline static DescriptorRing _ring { PersistentCount, RingCount };
+    inline static std::mutex _mutex;
+
+    static Range MakeRange(uint32_t index, uint32_t count);
+    static void ReleaseHeap();
+};
@@ -0,0 +1,516 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+// Files with the given extensions below a root folder, api independent.
+//
+// Build walks the folder once, the calling thread reads directories from a shared queue and helper
+// threads take from the same queue when they get to run. The caller never waits for a helper, a
+// build started while the loader lock is held (helpers can't start until it's released) is just
+// single threaded. Every directory is stored with its last write time, adding, removing or renaming
+// an entry changes the time of its parent so IsCurrent only has to check the directories instead of
+// walking them again. Directories we write into ourselves (logs, caches) change their time on every
+// run, IsCurrent lists them and compares the names of their subdirectories and indexed files.
+//
+// Names are compared case insensitive (ASCII), matches are returned in the order a sorted depth
+// first walk would find them.
+class FileIndex
+{
+  public:
+    static constexpr uint32_t Magic = 0x4946534F; // OSFI
+    static constexpr uint32_t Version = 1;
+
+    static FileIndex Build(const std::filesystem::path& root, const std::vector<std::string>& extensions,
+                           uint32_t helpers)
+    {
+        FileIndex index;
+        index._root = root;
+
+        for (const auto& extension : extensions)
+            index._extensions.push_back(ToLower(std::u8string(extension.begin(), extension.end())));
+
+        auto walk = std::make_shared<Walk>();
+        walk->extensions = index._extensions;
+
+        std::error_code ec;
+        auto rootTime = std::filesystem::last_write_time(root, ec);
+
+        if (ec)
+            return index;
+
+        walk->directories.push_back({ root, rootTime.time_since_epoch().count(), 0 });
+        walk->queue.push_back(0);
+
+        for (uint32_t i = 0; i < helpers; i++)
+            std::thread([walk] { walk->Work(); }).detach();
+
+        walk->Work();
+
+        {
+            std::lock_guard<std::mutex> lock(walk->mutex);
+            index._directories = std::move(walk->directories);
+            index._files = std::move(walk->files);
+        }
+
+        index.Sort();
+        return index;
+    }
+
+    const std::filesystem::path& Root() const { return _root; }
+    size_t DirectoryCount() const { return _directories.size(); }
+    size_t FileCount() const { return _files.size(); }
+
+    // False when a directory was changed or removed since the index was built, only the listing of
+    // the written directories is compared
+    bool IsCurrent(const std::vector<std::filesystem::path>& written = {}) const
+    {
+        if (_directories.empty())
+            return false;
+
+        std::vector<Directory> subdirectories;
+        std::vector<File> found;
+
+        for (uint32_t i = 0; i < _directories.size(); i++)
+        {
+            const auto& directory = _directories[i];
+
+            if (std::find(written.begin(), written.end(), directory.path) != written.end())
+            {
+                subdirectories.clear();
+                found.clear();
+
+                if (Listing(directory.path, i, _extensions, subdirectories, found) != directory.listing)
+                    return false;
+
+                continue;
+            }
+
+            std::error_code ec;
+            auto time = std::filesystem::last_write_time(directory.path, ec);
+
+            if (ec || time.time_since_epoch().count() != directory.time)
+                return false;
+        }
+
+        return true;
+    }
+
+    // All files with this name
+    std::vector<std::filesystem::path> Find(const std::filesystem::path& fileName) const
+    {
+        std::vector<std::filesystem::path> result;
+        auto name = ToLower(fileName.u8string());
+        auto it = std::lower_bound(_files.begin(), _files.end(), name,
+                                   [](const File& file, const std::u8string& value) { return file.name < value; });
+
+        for (; it != _files.end() && it->name == name; it++)
+            result.push_back(_directories[it->directory].path / it->original);
+
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    // First file with this name below startDir, anywhere in the index when there is none
+    std::optional<std::filesystem::path> FindFirst(const std::filesystem::path& startDir,
+                                                   const std::filesystem::path& fileName) const
+    {
+        auto paths = Find(fileName);
+
+        if (paths.empty())
+            return std::nullopt;
+
+        for (const auto& path : paths)
+        {
+            if (IsBelow(path, startDir))
+                return path;
+        }
+
+        return paths.front();
+    }
+
+    std::vector<uint8_t> Serialize() const
+    {
+        std::vector<uint8_t> file;
+
+        FileHeader header { Magic, Version, (uint32_t) _extensions.size(), (uint32_t) _directories.size(),
+                            (uint32_t) _files.size() };
+        Append(file, &header, sizeof(header));
+        AppendString(file, _root.u8string());
+
+        for (const auto& extension : _extensions)
+            AppendString(file, extension);
+
+        for (const auto& directory : _directories)
+        {
+            AppendString(file, directory.path.u8string());
+            Append(file, &directory.time, sizeof(directory.time));
+            Append(file, &directory.listing, sizeof(directory.listing));
+        }
+
+        for (const auto& entry : _files)
+        {
+            Append(file, &entry.directory, sizeof(entry.directory));
+            AppendString(file, entry.original);
+        }
+
+        auto checksum = Hash(file.data(), file.size());
+        Append(file, &checksum, sizeof(checksum));
+
+        return file;
+    }
+
+    // Returns false and leaves an empty index when the file can't be used
+    bool Deserialize(const std::vector<uint8_t>& file)
+    {
+        *this = FileIndex {};
+
+        uint64_t checksum = 0;
+
+        if (file.size() < sizeof(FileHeader) + sizeof(checksum))
+            return false;
+
+        auto size = file.size() - sizeof(checksum);
+        std::memcpy(&checksum, file.data() + size, sizeof(checksum));
+
+        if (Hash(file.data(), size) != checksum)
+            return false;
+
+        FileHeader header {};
+        std::memcpy(&header, file.data(), sizeof(header));
+
+        if (header.magic != Magic || header.version != Version)
+            return false;
+
+        size_t offset = sizeof(header);
+        std::u8string text;
+
+        if (!ReadString(file, size, offset, text))
+            return false;
+
+        FileIndex index;
+        index._root = text;
+
+        for (uint32_t i = 0; i < header.extensionCount; i++)
+        {
+            if (!ReadString(file, size, offset, text))
+                return false;
+
+            index._extensions.push_back(text);
+        }
+
+        for (uint32_t i = 0; i < header.directoryCount; i++)
+        {
+            Directory directory;
+
+            if (!ReadString(file, size, offset, text) ||
+                size - offset < sizeof(directory.time) + sizeof(directory.listing))
+            {
+                return false;
+            }
+
+            directory.path = text;
+            std::memcpy(&directory.time, file.data() + offset, sizeof(directory.time));
+            offset += sizeof(directory.time);
+            std::memcpy(&directory.listing, file.data() + offset, sizeof(directory.listing));
+            offset += sizeof(directory.listing);
+
+            index._directories.push_back(std::move(directory));
+        }
+
+        for (uint32_t i = 0; i < header.fileCount; i++)
+        {
+            File entry;
+
+            if (size - offset < sizeof(entry.directory))
+                return false;
+
+            std::memcpy(&entry.directory, file.data() + offset, sizeof(entry.directory));
+            offset += sizeof(entry.directory);
+
+            if (entry.directory >= index._directories.size() || !ReadString(file, size, offset, entry.original))
+                return false;
+
+            entry.name = ToLower(entry.original);
+            index._files.push_back(std::move(entry));
+        }
+
+        if (offset != size)
+            return false;
+
+        index.Sort();
+        *this = std::move(index);
+        return true;
+    }
+
+    bool LoadFile(const std::filesystem::path& path)
+    {
+        std::ifstream stream(path, std::ios::binary);
+
+        if (!stream)
+        {
+            *this = FileIndex {};
+            return false;
+        }
+
+        std::vector<uint8_t> file((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+        return Deserialize(file);
+    }
+
+    // Written to a temporary file first, a crash while saving can't leave a half written index
+    bool SaveFile(const std::filesystem::path& path) const
+    {
+        auto file = Serialize();
+        auto tempPath = path;
+        tempPath += ".tmp";
+
+        {
+            std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+
+            if (!stream)
+                return false;
+
+            stream.write((const char*) file.data(), (std::streamsize) file.size());
+
+            if (!stream)
+                return false;
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tempPath, path, ec);
+
+        if (ec)
+        {
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+
+        return true;
+    }
+
+  private:
+#pragma pack(push, 1)
+    struct FileHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t extensionCount;
+        uint32_t directoryCount;
+        uint32_t fileCount;
+    };
+#pragma pack(pop)
+
+    struct Directory
+    {
+        std::filesystem::path path;
+        int64_t time = 0;
+
+        // Names of the subdirectories and indexed files
+        uint64_t listing = 0;
+    };
+
+    struct File
+    {
+        uint32_t directory = 0;
+        std::u8string name;
+        std::u8string original;
+    };
+
+    // State of one build, helpers which start late keep it alive until they see the queue is empty
+    struct Walk
+    {
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::vector<uint32_t> queue;
+        uint32_t active = 0;
+
+        std::vector<std::u8string> extensions;
+        std::vector<Directory> directories;
+        std::vector<File> files;
+
+        void Work()
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+
+            while (true)
+            {
+                if (queue.empty())
+                {
+                    if (active == 0)
+                        return;
+
+                    changed.wait(lock);
+                    continue;
+                }
+
+                auto id = queue.back();
+                queue.pop_back();
+                auto path = directories[id].path;
+                active++;
+                lock.unlock();
+
+                std::vector<Directory> subdirectories;
+                std::vector<File> found;
+                auto listing = Listing(path, id, extensions, subdirectories, found);
+
+                lock.lock();
+                directories[id].listing = listing;
+
+                for (auto& subdirectory : subdirectories)
+                {
+                    queue.push_back((uint32_t) directories.size());
+                    directories.push_back(std::move(subdirectory));
+                }
+
+                files.insert(files.end(), std::make_move_iterator(found.begin()),
+                             std::make_move_iterator(found.end()));
+
+                active--;
+                changed.notify_all();
+            }
+        }
+    };
+
+    std::filesystem::path _root;
+    std::vector<std::u8string> _extensions;
+    std::vector<Directory> _directories;
+    std::vector<File> _files;
+
+    void Sort()
+    {
+        std::sort(_files.begin(), _files.end(), [](const File& a, const File& b) { return a.name < b.name; });
+    }
+
+    static std::u8string ToLower(std::u8string text)
+    {
+        for (auto& c : text)
+        {
+            if (c >= u8'A' && c <= u8'Z')
+                c = (char8_t) (c - u8'A' + u8'a');
+        }
+
+        return text;
+    }
+
+    static bool IsWanted(const std::filesystem::path& path, const std::vector<std::u8string>& extensions)
+    {
+        auto extension = ToLower(path.extension().u8string());
+        return std::find(extensions.begin(), extensions.end(), extension) != extensions.end();
+    }
+
+    // Reads one directory, returns the hash of its listing
+    static uint64_t Listing(const std::filesystem::path& path, uint32_t id,
+                            const std::vector<std::u8string>& extensions, std::vector<Directory>& subdirectories,
+                            std::vector<File>& found)
+    {
+        uint64_t listing = 0;
+        std::error_code ec;
+        std::filesystem::directory_iterator it(path, std::filesystem::directory_options::skip_permission_denied, ec);
+
+        for (; !ec && it != std::filesystem::directory_iterator(); it.increment(ec))
+        {
+            const auto& entry = *it;
+            std::error_code entryEc;
+            auto name = entry.path().filename().u8string();
+
+            // Directory symlinks are not followed, same as recursive_directory_iterator
+            if (entry.is_directory(entryEc) && !entry.is_symlink(entryEc))
+            {
+                // Attributes come with the directory listing on Windows, this doesn't touch the disk
+                auto time = entry.last_write_time(entryEc);
+
+                if (!entryEc)
+                    subdirectories.push_back({ entry.path(), time.time_since_epoch().count(), 0 });
+            }
+            else if (!entry.is_directory(entryEc) && IsWanted(entry.path(), extensions))
+            {
+                found.push_back({ id, ToLower(name), name });
+            }
+            else
+            {
+                continue;
+            }
+
+            // Sum doesn't depend on the order of the entries
+            listing += Hash((const uint8_t*) name.data(), name.size());
+        }
+
+        return listing;
+    }
+
+    static bool IsBelow(const std::filesystem::path& path, const std::filesystem::path& directory)
+    {
+        auto it = path.begin();
+
+        for (const auto& part : directory)
+        {
+            // Trailing separator of remove_filename() results
+            if (part.empty())
+                continue;
+
+            if (it == path.end() || *it != part)
+                return false;
+
+            it++;
+        }
+
+        return true;
+    }
+
+    // FNV-1a
+    static uint64_t Hash(const uint8_t* data, size_t size)
+    {
+        uint64_t hash = 0xCBF29CE484222325ull;
+
+        for (size_t i = 0; i < size; i++)
+        {
+            hash ^= data[i];
+            hash *= 0x100000001B3ull;
+        }
+
+        return hash;
+    }
+
+    static void Append(std::vector<uint8_t>& file, const void* data, size_t size)
+    {
+        auto bytes = (const uint8_t*) data;
+        file.insert(file.end(), bytes, bytes + size);
+    }
+
+    static void AppendString(std::vector<uint8_t>& file, const std::u8string& text)
+    {
+        auto length = (uint32_t) text.size();
+        Append(file, &length, sizeof(length));
+        Append(file, text.data(), text.size());
+    }
+
+    static bool ReadString(const std::vector<uint8_t>& file, size_t size, size_t& offset, std::u8string& text)
+    {
+        uint32_t length = 0;
+
+        if (size - offset < sizeof(length))
+            return false;
+
+        std::memcpy(&length, file.data() + offset, sizeof(length));
+        offset += sizeof(length);
+
+        if (size - offset < length)
+            return false;
+
+        text.assign((const char8_t*) file.data() + offset, length);
+        offset += length;
+        return true;
+    }
+};
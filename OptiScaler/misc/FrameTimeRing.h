@@ -0,0 +1,160 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+
+#include "SeqLock.h"
+
+// Fixed size history of frame/upscaler times in milliseconds.
+//
+// Push can be called from any thread, upscaler times come from the present hooks of each api and
+// from the Dx12 GPU timer. Pushes are serialized with a mutex, they happen once per frame. Push keeps
+// the window sorted (one removal and one insertion, both memmoves of at most Capacity floats), so
+// the summary with its percentiles is current after every sample. The summary is published through
+// a SeqLock, readers never lock and always get the statistics of one sample.
+template <size_t Capacity> class FrameTimeRing
+{
+  public:
+    struct Summary
+    {
+        uint32_t count = 0;
+        float last = 0.0f;
+        float mean = 0.0f;
+        float min = 0.0f;
+        float max = 0.0f;
+        float p50 = 0.0f;
+        float p99 = 0.0f;
+
+        // Average fps of the slowest 1% of the frames
+        float low1Fps = 0.0f;
+    };
+
+  private:
+    std::atomic<float> _samples[Capacity] {};
+    std::atomic<uint64_t> _written = 0;
+
+    SeqLock<Summary> _summary;
+
+    // Producer state, guarded by _pushMutex
+    std::mutex _pushMutex;
+    float _values[Capacity] {};
+    float _sorted[Capacity] {};
+    double _sum = 0.0;
+
+    void RemoveSorted(size_t count, float value)
+    {
+        auto position = std::lower_bound(_sorted, _sorted + count, value) - _sorted;
+        std::memmove(_sorted + position, _sorted + position + 1, (count - position - 1) * sizeof(float));
+    }
+
+    void InsertSorted(size_t count, float value)
+    {
+        auto position = std::upper_bound(_sorted, _sorted + count, value) - _sorted;
+        std::memmove(_sorted + position + 1, _sorted + position, (count - position) * sizeof(float));
+        _sorted[position] = value;
+    }
+
+    Summary Summarize(size_t count, float last) const
+    {
+        Summary summary;
+        summary.count = (uint32_t) count;
+        summary.last = last;
+        summary.mean = (float) (_sum / count);
+        summary.min = _sorted[0];
+        summary.max = _sorted[count - 1];
+
+        // Rank of the sample which is at the percentile, counted from the fastest one
+        summary.p50 = _sorted[(count - 1) * 50 / 100];
+        summary.p99 = _sorted[(count - 1) * 99 / 100];
+
+        // Slowest 1% of the frames, at least one
+        auto lowCount = std::max<size_t>(1, count / 100);
+        double lowSum = 0.0;
+
+        for (size_t i = count - lowCount; i < count; i++)
+            lowSum += _sorted[i];
+
+        summary.low1Fps = lowSum > 0.0 ? (float) (1000.0 * lowCount / lowSum) : 0.0f;
+
+        return summary;
+    }
+
+  public:
+    void Push(double value)
+    {
+        if (!(value > 0.0))
+            return;
+
+        auto sample = (float) value;
+
+        std::lock_guard<std::mutex> lock(_pushMutex);
+
+        auto written = _written.load(std::memory_order_relaxed);
+        auto index = (size_t) (written % Capacity);
+        auto count = (size_t) std::min<uint64_t>(written, Capacity);
+
+        if (written >= Capacity)
+        {
+            auto evicted = _values[index];
+            _sum -= evicted;
+            RemoveSorted(count, evicted);
+            count--;
+        }
+
+        _values[index] = sample;
+        _sum += sample;
+        InsertSorted(count, sample);
+        count++;
+
+        _samples[index].store(sample, std::memory_order_relaxed);
+        _written.store(written + 1, std::memory_order_release);
+
+        _summary.Store(Summarize(count, sample));
+    }
+
+    static constexpr int Size() { return (int) Capacity; }
+
+    uint32_t Count() const
+    {
+        return (uint32_t) std::min<uint64_t>(_written.load(std::memory_order_acquire), Capacity);
+    }
+
+    float Last() const { return _summary.Load().last; }
+
+    Summary GetSummary() const { return _summary.Load(); }
+
+    // Sample by age, 0 is the oldest of the Size() visible ones. Missing samples are returned as 0
+    float At(size_t age) const
+    {
+        auto written = _written.load(std::memory_order_acquire);
+
+        if (age >= Capacity || written + age < Capacity)
+            return 0.0f;
+
+        return _samples[(written + age) % Capacity].load(std::memory_order_relaxed);
+    }
+
+    // Mean of the last count samples
+    float RecentMean(size_t count) const
+    {
+        auto written = _written.load(std::memory_order_acquire);
+        count = (size_t) std::min<uint64_t>({ (uint64_t) count, written, (uint64_t) Capacity });
+
+        if (count == 0)
+            return 0.0f;
+
+        double sum = 0.0;
+
+        for (size_t i = 1; i <= count; i++)
+            sum += _samples[(written - i) % Capacity].load(std::memory_order_relaxed);
+
+        return (float) (sum / count);
+    }
+
+    // For ImGui::PlotLines getter overload, oldest sample first
+    static float PlotGetter(void* data, int index) { return ((const FrameTimeRing*) data)->At((size_t) index); }
+};
@@ -0,0 +1,373 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Api independent part of the GPU pass timer, only works on raw timestamps
+// so it can be fed with synthetic values outside of a D3D12 device.
+
+enum class GpuPass : uint32_t
+{
+    InputCopy,
+    Bias,
+    DepthScale,
+    Upscaler,
+    Rcas,
+    OutputScaling,
+    PostFused,
+    FGDispatch,
+    HudfixCopy,
+    Menu,
+    Count
+};
+
+constexpr size_t GpuPassCount = (size_t) GpuPass::Count;
+
+inline const char* GpuPassName(GpuPass pass)
+{
+    switch (pass)
+    {
+    case GpuPass::InputCopy:
+        return "Input Copy";
+    case GpuPass::Bias:
+        return "Bias";
+    case GpuPass::DepthScale:
+        return "Depth Scale";
+    case GpuPass::Upscaler:
+        return "Upscaler";
+    case GpuPass::Rcas:
+        return "RCAS";
+    case GpuPass::OutputScaling:
+        return "Output Scaling";
+    case GpuPass::PostFused:
+        return "RCAS + Output Scaling";
+    case GpuPass::FGDispatch:
+        return "FG Dispatch";
+    case GpuPass::HudfixCopy:
+        return "Hudfix Copy";
+    case GpuPass::Menu:
+        return "Menu";
+    default:
+        return "Unknown";
+    }
+}
+
+namespace GpuTimerStats
+{
+// Measurements above this are treated as garbage (not finished or reordered submits)
+constexpr double MaxValidMs = 100.0;
+
+// Converts a begin/end timestamp pair to milliseconds, returns false for invalid pairs.
+// Readback ranges are cleared after reading, so a zero begin means the pair was never resolved.
+inline bool ToMilliseconds(uint64_t begin, uint64_t end, uint64_t frequency, double& ms)
+{
+    if (frequency == 0 || begin == 0 || end < begin)
+        return false;
+
+    ms = (double) (end - begin) / (double) frequency * 1000.0;
+    return ms < MaxValidMs;
+}
+
+// Sums all pairs of a pass in one frame. data holds begin/end pairs, endedMask marks which pairs
+// were closed on the CPU side. Returns false when no valid pair was found.
+inline bool SumPass(const uint64_t* data, uint32_t endedMask, uint64_t frequency, double& totalMs)
+{
+    bool found = false;
+    totalMs = 0.0;
+
+    for (uint32_t i = 0; i < 32 && endedMask != 0; i++, endedMask >>= 1)
+    {
+        if ((endedMask & 1) == 0)
+            continue;
+
+        double ms = 0.0;
+        if (ToMilliseconds(data[i * 2], data[i * 2 + 1], frequency, ms))
+        {
+            totalMs += ms;
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+struct Summary
+{
+    size_t count = 0;
+    double last = 0.0;
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p99 = 0.0;
+};
+
+// Keeps last WindowSize samples of a pass
+template <size_t WindowSize = 256> class RollingWindow
+{
+    std::array<double, WindowSize> _samples {};
+    size_t _next = 0;
+    size_t _count = 0;
+
+  public:
+    void Add(double value)
+    {
+        _samples[_next] = value;
+        _next = (_next + 1) % WindowSize;
+
+        if (_count < WindowSize)
+            _count++;
+    }
+
+    void Clear()
+    {
+        _next = 0;
+        _count = 0;
+    }
+
+    size_t Count() const { return _count; }
+
+    // Oldest first
+    std::vector<double> Samples() const
+    {
+        std::vector<double> samples;
+        samples.reserve(_count);
+
+        for (size_t i = 0; i < _count; i++)
+            samples.push_back(_samples[(_next + WindowSize - _count + i) % WindowSize]);
+
+        return samples;
+    }
+
+    Summary Compute() const
+    {
+        Summary summary {};
+        summary.count = _count;
+
+        if (_count == 0)
+            return summary;
+
+        summary.last = _samples[(_next + WindowSize - 1) % WindowSize];
+
+        std::array<double, WindowSize> sorted;
+        double total = 0.0;
+
+        for (size_t i = 0; i < _count; i++)
+        {
+            sorted[i] = _samples[i];
+            total += _samples[i];
+        }
+
+        summary.mean = total / (double) _count;
+
+        std::sort(sorted.begin(), sorted.begin() + _count);
+        summary.p50 = sorted[(_count - 1) * 50 / 100];
+        summary.p99 = sorted[(_count - 1) * 99 / 100];
+
+        return summary;
+    }
+};
+
+struct PassReport
+{
+    const char* name = nullptr;
+    Summary summary;
+    std::vector<double> samples;
+};
+
+// {"passes":[{"name":..,"count":..,"last_ms":..,"mean_ms":..,"p50_ms":..,"p99_ms":..,"samples_ms":[..]}]}
+inline std::string ToJson(const std::vector<PassReport>& passes)
+{
+    std::string json = "{\n  \"passes\": [";
+    char number[32];
+
+    auto append = [&](const char* key, double value)
+    {
+        std::snprintf(number, sizeof(number), "%.4f", value);
+        json += ", \"";
+        json += key;
+        json += "\": ";
+        json += number;
+    };
+
+    for (size_t i = 0; i < passes.size(); i++)
+    {
+        const auto& pass = passes[i];
+
+        json += i == 0 ? "\n    {" : ",\n    {";
+        json += "\"name\": \"";
+        json += pass.name != nullptr ? pass.name : "";
+        json += "\", \"count\": ";
+        json += std::to_string(pass.summary.count);
+
+        append("last_ms", pass.summary.last);
+        append("mean_ms", pass.summary.mean);
+        append("p50_ms", pass.summary.p50);
+        append("p99_ms", pass.summary.p99);
+
+        json += ", \"samples_ms\": [";
+
+        for (size_t s = 0; s < pass.samples.size(); s++)
+        {
+            std::snprintf(number, sizeof(number), s == 0 ? "%.4f" : ", %.4f", pass.samples[s]);
+            json += number;
+        }
+
+        json += "]}";
+    }
+
+    json += passes.empty() ? "]\n}\n" : "\n  ]\n}\n";
+    return json;
+}
+
+// Bookkeeping of the timestamp ring, the D3D12 side only writes and resolves the queries.
+//
+// Begin/End run on any thread which records a pass, they allocate query pairs in the current slot.
+// Close, Submitted, Collect and Advance are called once per present under the caller's lock.
+// A slot is recording until the frame is closed, then pending until the fence signaled after it is
+// completed. When the GPU is FrameCount frames behind the next slot is still pending, the current
+// one stays closed and passes of that frame are not measured.
+template <uint32_t FrameCount, uint32_t MaxSamples> class TimestampRing
+{
+    static_assert(MaxSamples <= 32, "Ended samples are tracked in a 32 bit mask");
+
+  public:
+    static constexpr uint32_t QueriesPerSlot = (uint32_t) GpuPassCount * MaxSamples * 2;
+    static constexpr uint32_t QueryCount = QueriesPerSlot * FrameCount;
+
+    struct Pair
+    {
+        bool valid = false;
+        uint32_t slot = 0;
+        uint32_t pass = 0;
+        uint32_t sample = 0;
+
+        // Index of the begin query, end query is the next one
+        uint32_t query = 0;
+    };
+
+    TimestampRing() { Start(0); }
+
+    Pair Begin(uint32_t pass)
+    {
+        if (pass >= GpuPassCount)
+            return {};
+
+        auto slotIndex = _current.load(std::memory_order_acquire);
+        auto& slot = _slots[slotIndex];
+
+        // GPU is too far behind, this frame is skipped
+        if (!slot.recording.load(std::memory_order_acquire))
+            return {};
+
+        auto sample = slot.samples[pass].fetch_add(1, std::memory_order_relaxed);
+
+        if (sample >= MaxSamples)
+            return {};
+
+        return Pair { true, slotIndex, pass, sample, (slotIndex * QueriesPerSlot) + (pass * MaxSamples + sample) * 2 };
+    }
+
+    void End(const Pair& pair)
+    {
+        if (pair.valid)
+            _slots[pair.slot].ended[pair.pass].fetch_or(1u << pair.sample, std::memory_order_release);
+    }
+
+    // Stops recording into the current slot, returns false when it was already closed (skipped frame)
+    bool Close()
+    {
+        auto& slot = _slots[_current.load(std::memory_order_relaxed)];
+
+        if (!slot.recording.load(std::memory_order_relaxed))
+            return false;
+
+        slot.recording.store(false, std::memory_order_release);
+        return true;
+    }
+
+    // Fence value signaled after the closed slot's commands
+    void Submitted(uint64_t fenceValue)
+    {
+        auto& slot = _slots[_current.load(std::memory_order_relaxed)];
+        slot.fenceValue = fenceValue;
+        slot.pending = true;
+    }
+
+    // Calls read(slot, endedMasks) for every pending slot the GPU finished, oldest first.
+    // endedMasks has one mask of closed pairs per pass.
+    template <typename F> uint32_t Collect(uint64_t completedValue, F&& read)
+    {
+        auto current = _current.load(std::memory_order_relaxed);
+        uint32_t collected = 0;
+
+        for (uint32_t i = 1; i <= FrameCount; i++)
+        {
+            auto slotIndex = (current + i) % FrameCount;
+            auto& slot = _slots[slotIndex];
+
+            if (!slot.pending || slot.fenceValue > completedValue)
+                continue;
+
+            uint32_t ended[GpuPassCount];
+
+            for (size_t pass = 0; pass < GpuPassCount; pass++)
+                ended[pass] = slot.ended[pass].load(std::memory_order_acquire);
+
+            read(slotIndex, (const uint32_t*) ended);
+
+            slot.pending = false;
+            collected++;
+        }
+
+        return collected;
+    }
+
+    // Moves to the next slot when it's free, otherwise stays on the closed one
+    bool Advance()
+    {
+        auto next = (_current.load(std::memory_order_relaxed) + 1) % FrameCount;
+
+        if (_slots[next].pending)
+            return false;
+
+        Start(next);
+        return true;
+    }
+
+    uint32_t CurrentSlot() const { return _current.load(std::memory_order_relaxed); }
+    bool Recording() const { return _slots[CurrentSlot()].recording.load(std::memory_order_relaxed); }
+
+  private:
+    struct Slot
+    {
+        std::atomic<uint32_t> samples[GpuPassCount] {};
+        std::atomic<uint32_t> ended[GpuPassCount] {};
+        std::atomic<bool> recording = false;
+        uint64_t fenceValue = 0;
+        bool pending = false;
+    };
+
+    Slot _slots[FrameCount];
+    std::atomic<uint32_t> _current = 0;
+
+    void Start(uint32_t slotIndex)
+    {
+        auto& slot = _slots[slotIndex];
+
+        for (size_t i = 0; i < GpuPassCount; i++)
+        {
+            slot.samples[i].store(0, std::memory_order_relaxed);
+            slot.ended[i].store(0, std::memory_order_relaxed);
+        }
+
+        slot.pending = false;
+        slot.recording.store(true, std::memory_order_release);
+        _current.store(slotIndex, std::memory_order_release);
+    }
+};
+} // namespace GpuTimerStats
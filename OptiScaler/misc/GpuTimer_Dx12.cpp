@@ -0,0 +1,260 @@
+#include "GpuTimer_Dx12.h"
+
+#include <State.h>
+
+#include <include/d3dx/d3dx12.h>
+
+#include <fstream>
+
+bool GpuTimer_Dx12::Init(ID3D12Device* device)
+{
+    std::lock_guard<std::mutex> lock(_frameMutex);
+
+    if (_queryHeap != nullptr)
+        return true;
+
+    if (device == nullptr)
+        return false;
+
+    D3D12_QUERY_HEAP_DESC queryHeapDesc = {};
+    queryHeapDesc.Count = Ring::QueryCount;
+    queryHeapDesc.NodeMask = 0;
+    queryHeapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+
+    ID3D12QueryHeap* queryHeap = nullptr;
+    auto result = device->CreateQueryHeap(&queryHeapDesc, IID_PPV_ARGS(&queryHeap));
+
+    if (result != S_OK)
+    {
+        LOG_ERROR("CreateQueryHeap error: {:X}", (UINT) result);
+        return false;
+    }
+
+    D3D12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(queryHeapDesc.Count * sizeof(UINT64));
+    D3D12_HEAP_PROPERTIES heapProps = {};
+    heapProps.Type = D3D12_HEAP_TYPE_READBACK;
+    result = device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &bufferDesc,
+                                             D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(&_readbackBuffer));
+
+    if (result != S_OK)
+    {
+        LOG_ERROR("CreateCommittedResource error: {:X}", (UINT) result);
+        queryHeap->Release();
+        return false;
+    }
+
+    result = device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&_fence));
+
+    if (result != S_OK)
+    {
+        LOG_ERROR("CreateFence error: {:X}", (UINT) result);
+        _readbackBuffer->Release();
+        _readbackBuffer = nullptr;
+        queryHeap->Release();
+        return false;
+    }
+
+    // Freshly created readback memory is not guaranteed to be zeroed
+    void* data = nullptr;
+    if (_readbackBuffer->Map(0, nullptr, &data) == S_OK && data != nullptr)
+    {
+        memset(data, 0, queryHeapDesc.Count * sizeof(UINT64));
+        _readbackBuffer->Unmap(0, nullptr);
+    }
+
+    // Published last, Begin uses it to check if the timer is ready
+    _queryHeap = queryHeap;
+
+    LOG_INFO("Created timestamp ring, {} frames x {} queries", FrameCount, Ring::QueriesPerSlot);
+    return true;
+}
+
+// Copy queues need an additional feature check for timestamps, bundles can't have queries.
+// Passes are recorded into the same few lists every frame, type of the last ones seen by this
+// thread is kept so GetType isn't called for every pass.
+bool GpuTimer_Dx12::CanMeasure(ID3D12GraphicsCommandList* cmdList)
+{
+    struct TypeCache
+    {
+        ID3D12GraphicsCommandList* lists[4] {};
+        bool measurable[4] {};
+        uint32_t next = 0;
+    };
+
+    static thread_local TypeCache cache;
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        if (cache.lists[i] == cmdList)
+            return cache.measurable[i];
+    }
+
+    auto type = cmdList->GetType();
+    auto measurable = type == D3D12_COMMAND_LIST_TYPE_DIRECT || type == D3D12_COMMAND_LIST_TYPE_COMPUTE;
+
+    cache.lists[cache.next] = cmdList;
+    cache.measurable[cache.next] = measurable;
+    cache.next = (cache.next + 1) % 4;
+
+    return measurable;
+}
+
+GpuTimer_Dx12::Token GpuTimer_Dx12::Begin(ID3D12GraphicsCommandList* cmdList, GpuPass pass)
+{
+    if (_queryHeap == nullptr || cmdList == nullptr || pass >= GpuPass::Count || !CanMeasure(cmdList))
+        return {};
+
+    auto pair = _ring.Begin((uint32_t) pass);
+
+    if (!pair.valid)
+        return {};
+
+    cmdList->EndQuery(_queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, pair.query);
+
+    return Token { cmdList, pair };
+}
+
+void GpuTimer_Dx12::End(const Token& token)
+{
+    if (token.cmdList == nullptr || _queryHeap == nullptr)
+        return;
+
+    auto query = token.pair.query;
+
+    token.cmdList->EndQuery(_queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, query + 1);
+    token.cmdList->ResolveQueryData(_queryHeap, D3D12_QUERY_TYPE_TIMESTAMP, query, 2, _readbackBuffer,
+                                    query * sizeof(UINT64));
+
+    _ring.End(token.pair);
+}
+
+void GpuTimer_Dx12::EndFrame(ID3D12CommandQueue* queue)
+{
+    if (_queryHeap == nullptr || queue == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> lock(_frameMutex);
+
+    if (_frequency == 0 && queue->GetTimestampFrequency(&_frequency) != S_OK)
+        _frequency = 0;
+
+    // When previous frame was skipped current slot is still waiting for its fence
+    if (_ring.Close())
+    {
+        _fenceValue++;
+
+        if (queue->Signal(_fence, _fenceValue) == S_OK)
+            _ring.Submitted(_fenceValue);
+    }
+
+    Collect();
+    _ring.Advance();
+}
+
+void GpuTimer_Dx12::Collect()
+{
+    constexpr auto slotBytes = Ring::QueriesPerSlot * sizeof(UINT64);
+    std::vector<double> upscalerTimes;
+
+    _ring.Collect(_fence->GetCompletedValue(),
+                  [&](uint32_t slotIndex, const uint32_t* ended)
+                  {
+                      D3D12_RANGE range = { slotIndex * slotBytes, (slotIndex + 1) * slotBytes };
+
+                      UINT64* data = nullptr;
+                      if (_readbackBuffer->Map(0, &range, reinterpret_cast<void**>(&data)) != S_OK || data == nullptr)
+                      {
+                          LOG_WARN("timestampData is null!");
+                          return;
+                      }
+
+                      auto slotData = data + slotIndex * Ring::QueriesPerSlot;
+
+                      {
+                          std::lock_guard<std::mutex> statsLock(_statsMutex);
+
+                          for (uint32_t pass = 0; pass < GpuPassCount; pass++)
+                          {
+                              double ms = 0.0;
+
+                              if (GpuTimerStats::SumPass(slotData + pass * MaxSamples * 2, ended[pass], _frequency,
+                                                         ms))
+                              {
+                                  _stats[pass].Add(ms);
+
+                                  if (pass == (uint32_t) GpuPass::Upscaler)
+                                      upscalerTimes.push_back(ms);
+                              }
+                          }
+                      }
+
+                      // Clear the slot so pairs which are not resolved next time are not read as valid
+                      memset(slotData, 0, slotBytes);
+                      _readbackBuffer->Unmap(0, &range);
+                  });
+
+    for (auto time : upscalerTimes)
+        State::Instance().upscaleTimes.Push(time);
+}
+
+GpuTimerStats::Summary GpuTimer_Dx12::GetSummary(GpuPass pass)
+{
+    if (pass >= GpuPass::Count)
+        return {};
+
+    std::lock_guard<std::mutex> lock(_statsMutex);
+    return _stats[(uint32_t) pass].Compute();
+}
+
+bool GpuTimer_Dx12::ExportCsv(const std::filesystem::path& path)
+{
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+
+    if (!file.is_open())
+    {
+        LOG_ERROR("Can't open {} for writing", path.string());
+        return false;
+    }
+
+    file << "pass,samples,last_ms,mean_ms,p50_ms,p99_ms\n";
+
+    for (uint32_t pass = 0; pass < GpuPassCount; pass++)
+    {
+        auto summary = GetSummary((GpuPass) pass);
+        file << std::format("{},{},{:.4f},{:.4f},{:.4f},{:.4f}\n", GpuPassName((GpuPass) pass), summary.count,
+                            summary.last, summary.mean, summary.p50, summary.p99);
+    }
+
+    LOG_INFO("GPU pass timings saved to {}", path.string());
+    return true;
+}
+
+bool GpuTimer_Dx12::ExportJson(const std::filesystem::path& path)
+{
+    std::vector<GpuTimerStats::PassReport> passes;
+
+    {
+        std::lock_guard<std::mutex> lock(_statsMutex);
+
+        for (uint32_t pass = 0; pass < GpuPassCount; pass++)
+        {
+            if (_stats[pass].Count() == 0)
+                continue;
+
+            passes.push_back({ GpuPassName((GpuPass) pass), _stats[pass].Compute(), _stats[pass].Samples() });
+        }
+    }
+
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+
+    if (!file.is_open())
+    {
+        LOG_ERROR("Can't open {} for writing", path.string());
+        return false;
+    }
+
+    file << GpuTimerStats::ToJson(passes);
+
+    LOG_INFO("GPU pass timings saved to {}", path.string());
+    return true;
+}
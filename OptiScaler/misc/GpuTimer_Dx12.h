@@ -0,0 +1,72 @@
+#pragma once
+#include <pch.h>
+
+#include "GpuTimerStats.h"
+
+#include <d3d12.h>
+
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+
+// Per pass GPU timestamps for the DX12 path.
+//
+// Queries are written into a ring of FrameCount slots, each slot has MaxSamples begin/end pairs for
+// every pass. EndFrame signals a fence on the present queue and moves to the next slot, results of a
+// slot are only read back after its fence is completed so the CPU never waits for the GPU.
+class GpuTimer_Dx12
+{
+  public:
+    static constexpr uint32_t FrameCount = 4;
+    static constexpr uint32_t MaxSamples = 4;
+
+    using Ring = GpuTimerStats::TimestampRing<FrameCount, MaxSamples>;
+
+    struct Token
+    {
+        ID3D12GraphicsCommandList* cmdList = nullptr;
+        Ring::Pair pair;
+    };
+
+    class Scope
+    {
+        Token _token;
+
+      public:
+        Scope(ID3D12GraphicsCommandList* cmdList, GpuPass pass) : _token(Begin(cmdList, pass)) {}
+        ~Scope() { End(_token); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    static bool Init(ID3D12Device* device);
+    static bool IsInited() { return _queryHeap != nullptr; }
+
+    // Returns an empty token (cmdList == nullptr) when the pass can't be measured
+    static Token Begin(ID3D12GraphicsCommandList* cmdList, GpuPass pass);
+    static void End(const Token& token);
+
+    // Called once per presented frame with the queue used for presenting
+    static void EndFrame(ID3D12CommandQueue* queue);
+
+    static GpuTimerStats::Summary GetSummary(GpuPass pass);
+    static bool ExportCsv(const std::filesystem::path& path);
+    static bool ExportJson(const std::filesystem::path& path);
+
+  private:
+    inline static ID3D12QueryHeap* _queryHeap = nullptr;
+    inline static ID3D12Resource* _readbackBuffer = nullptr;
+    inline static ID3D12Fence* _fence = nullptr;
+    inline static UINT64 _fenceValue = 0;
+    inline static UINT64 _frequency = 0;
+
+    inline static Ring _ring;
+    inline static std::mutex _frameMutex;
+
+    inline static GpuTimerStats::RollingWindow<> _stats[GpuPassCount];
+    inline static std::mutex _statsMutex;
+
+    static bool CanMeasure(ID3D12GraphicsCommandList* cmdList);
+    static void Collect();
+};
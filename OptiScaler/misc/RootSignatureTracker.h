@@ -0,0 +1,261 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+// Last compute/graphic root signature set on each command list, for restoring them after upscaling.
+//
+// Set is called from the SetRootSignature hooks of every recording thread, so it doesn't lock or
+// allocate. Command lists are mapped to slots of a fixed open addressing table, each thread
+// remembers its last slot and only does a generation check and a store when the same command list
+// is used again. Slots which weren't touched for StaleFrames frames are reused for new command
+// lists, this keeps the table bounded when games create and destroy command lists. A command list
+// is only recorded by one thread at a time, so there is a single writer per key. When all probed
+// slots of a command list are in use it goes to an overflow map with a lock, it moves back to the
+// table as soon as it gets a slot.
+template <size_t SlotCount = 4096> class RootSignatureTracker
+{
+    static_assert((SlotCount & (SlotCount - 1)) == 0, "SlotCount must be a power of 2");
+
+  public:
+    enum class Kind : uint32_t
+    {
+        Compute,
+        Graphic,
+        Count
+    };
+
+    static constexpr uint32_t MaxProbe = 16;
+    static constexpr uint32_t StaleFrames = 256;
+
+  private:
+    // Key while a slot is being reused, never a valid pointer
+    static constexpr uintptr_t Reclaiming = 1;
+
+    struct alignas(64) Slot
+    {
+        std::atomic<uintptr_t> key = 0;
+        std::atomic<uint32_t> generation = 0;
+        std::atomic<uint32_t> lastFrame = 0;
+        std::atomic<void*> signatures[(size_t) Kind::Count] {};
+    };
+
+    struct Cache
+    {
+        const void* owner = nullptr;
+        uintptr_t key = 0;
+        uint32_t index = 0;
+        uint32_t generation = 0;
+    };
+
+    struct OverflowEntry
+    {
+        std::array<void*, (size_t) Kind::Count> signatures {};
+        uint32_t lastFrame = 0;
+    };
+
+    Slot _slots[SlotCount];
+    std::atomic<uint32_t> _frame = 0;
+    std::atomic<bool> _full = false;
+
+    // Command lists which didn't get a slot, only looked at while it's not empty
+    mutable std::mutex _overflowMutex;
+    std::unordered_map<uintptr_t, OverflowEntry> _overflow;
+    std::atomic<size_t> _overflowCount = 0;
+
+    inline static thread_local Cache _cache;
+
+    static uint32_t Hash(uintptr_t key)
+    {
+        // Command lists are at least 16 byte aligned
+        auto value = (uint64_t) (key >> 4) * 0x9E3779B97F4A7C15ull;
+        return (uint32_t) (value >> 32) & (SlotCount - 1);
+    }
+
+    bool IsStale(const Slot& slot, uint32_t frame) const
+    {
+        return frame - slot.lastFrame.load(std::memory_order_relaxed) > StaleFrames;
+    }
+
+    // Finds the slot of key, returns SlotCount when key has no slot
+    uint32_t Find(uintptr_t key) const
+    {
+        auto index = Hash(key);
+
+        for (uint32_t i = 0; i < MaxProbe; i++, index = (index + 1) & (SlotCount - 1))
+        {
+            auto slotKey = _slots[index].key.load(std::memory_order_acquire);
+
+            if (slotKey == key)
+                return index;
+
+            if (slotKey == 0)
+                break;
+        }
+
+        return (uint32_t) SlotCount;
+    }
+
+    // Finds or takes a slot for key, returns SlotCount when all probed slots are in use
+    uint32_t Acquire(uintptr_t key)
+    {
+        auto start = Hash(key);
+        auto frame = _frame.load(std::memory_order_relaxed);
+        auto index = start;
+
+        for (uint32_t i = 0; i < MaxProbe; i++, index = (index + 1) & (SlotCount - 1))
+        {
+            auto& slot = _slots[index];
+            auto slotKey = slot.key.load(std::memory_order_acquire);
+
+            if (slotKey == key)
+                return index;
+
+            if (slotKey == 0 && slot.key.compare_exchange_strong(slotKey, key, std::memory_order_acq_rel))
+                return index;
+
+            // Another thread might have taken it for the same key
+            if (slotKey == key)
+                return index;
+        }
+
+        // No free slot, reuse one of a command list which wasn't recorded for a while
+        index = start;
+
+        for (uint32_t i = 0; i < MaxProbe; i++, index = (index + 1) & (SlotCount - 1))
+        {
+            auto& slot = _slots[index];
+            auto slotKey = slot.key.load(std::memory_order_acquire);
+
+            if (slotKey == Reclaiming || !IsStale(slot, frame) ||
+                !slot.key.compare_exchange_strong(slotKey, Reclaiming, std::memory_order_acq_rel))
+            {
+                continue;
+            }
+
+            slot.generation.fetch_add(1, std::memory_order_acq_rel);
+
+            for (auto& signature : slot.signatures)
+                signature.store(nullptr, std::memory_order_relaxed);
+
+            slot.lastFrame.store(frame, std::memory_order_relaxed);
+            slot.key.store(key, std::memory_order_release);
+            return index;
+        }
+
+        _full.store(true, std::memory_order_relaxed);
+        return (uint32_t) SlotCount;
+    }
+
+    void TakeOverflow(uintptr_t key, Slot& slot)
+    {
+        std::lock_guard<std::mutex> lock(_overflowMutex);
+
+        auto it = _overflow.find(key);
+
+        if (it == _overflow.end())
+            return;
+
+        for (size_t i = 0; i < it->second.signatures.size(); i++)
+            slot.signatures[i].store(it->second.signatures[i], std::memory_order_release);
+
+        _overflow.erase(it);
+        _overflowCount.store(_overflow.size(), std::memory_order_release);
+    }
+
+  public:
+    void Set(const void* commandList, Kind kind, void* signature)
+    {
+        auto key = (uintptr_t) commandList;
+
+        if (key <= Reclaiming || kind >= Kind::Count)
+            return;
+
+        auto frame = _frame.load(std::memory_order_relaxed);
+
+        if (_cache.owner == this && _cache.key == key)
+        {
+            auto& slot = _slots[_cache.index];
+
+            // Refreshed first so the slot doesn't look stale while it is checked
+            slot.lastFrame.store(frame, std::memory_order_relaxed);
+
+            if (slot.generation.load(std::memory_order_acquire) == _cache.generation &&
+                slot.key.load(std::memory_order_acquire) == key)
+            {
+                slot.signatures[(size_t) kind].store(signature, std::memory_order_release);
+                return;
+            }
+        }
+
+        auto index = Acquire(key);
+
+        if (index >= SlotCount)
+        {
+            std::lock_guard<std::mutex> lock(_overflowMutex);
+
+            auto& entry = _overflow[key];
+            entry.signatures[(size_t) kind] = signature;
+            entry.lastFrame = frame;
+            _overflowCount.store(_overflow.size(), std::memory_order_release);
+            return;
+        }
+
+        auto& slot = _slots[index];
+
+        // Other kind might have been stored while there was no slot
+        if (_overflowCount.load(std::memory_order_acquire) > 0)
+            TakeOverflow(key, slot);
+
+        slot.signatures[(size_t) kind].store(signature, std::memory_order_release);
+        slot.lastFrame.store(frame, std::memory_order_relaxed);
+
+        _cache = { this, key, index, slot.generation.load(std::memory_order_acquire) };
+    }
+
+    // Returns nullptr when nothing was recorded for the command list
+    void* Get(const void* commandList, Kind kind) const
+    {
+        auto key = (uintptr_t) commandList;
+
+        if (key <= Reclaiming || kind >= Kind::Count)
+            return nullptr;
+
+        auto index = Find(key);
+
+        if (index < SlotCount)
+            return _slots[index].signatures[(size_t) kind].load(std::memory_order_acquire);
+
+        if (_overflowCount.load(std::memory_order_acquire) == 0)
+            return nullptr;
+
+        std::lock_guard<std::mutex> lock(_overflowMutex);
+
+        auto it = _overflow.find(key);
+        return it != _overflow.end() ? it->second.signatures[(size_t) kind] : nullptr;
+    }
+
+    // Called once per frame, used for finding slots of command lists which are not used anymore
+    void NextFrame()
+    {
+        auto frame = _frame.fetch_add(1, std::memory_order_relaxed) + 1;
+
+        if (_overflowCount.load(std::memory_order_acquire) == 0)
+            return;
+
+        std::lock_guard<std::mutex> lock(_overflowMutex);
+
+        std::erase_if(_overflow, [frame](const auto& item) { return frame - item.second.lastFrame > StaleFrames; });
+        _overflowCount.store(_overflow.size(), std::memory_order_release);
+    }
+
+    // True when a command list couldn't get a slot at least once
+    bool WasFull() const { return _full.load(std::memory_order_relaxed); }
+
+    // Command lists which are in the overflow map now
+    size_t OverflowCount() const { return _overflowCount.load(std::memory_order_acquire); }
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+// Small value written rarely and copied by readers on any thread, api independent.
+//
+// Store bumps the sequence to odd, writes the value and bumps it to even again. Load copies the value
+// and retries when the sequence was odd or changed meanwhile, so readers never lock and never see
+// half of a write. The value is kept as atomic words, a reader copying while a write is in progress
+// is not a data race. Writers are serialized with a mutex, they are rare (resizes, mode changes).
+template <typename T> class SeqLock
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Value is copied word by word");
+
+    static constexpr size_t WordCount = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    std::atomic<uint32_t> _sequence { 0 };
+    std::atomic<uint64_t> _words[WordCount] {};
+    std::mutex _writeMutex;
+
+  public:
+    SeqLock() { Store(T {}); }
+    explicit SeqLock(const T& value) { Store(value); }
+
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    void Store(const T& value)
+    {
+        uint64_t words[WordCount] {};
+        std::memcpy(words, &value, sizeof(T));
+
+        std::lock_guard<std::mutex> lock(_writeMutex);
+
+        auto sequence = _sequence.load(std::memory_order_relaxed);
+        _sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t i = 0; i < WordCount; i++)
+            _words[i].store(words[i], std::memory_order_relaxed);
+
+        _sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    T Load() const
+    {
+        uint64_t words[WordCount];
+
+        for (uint32_t attempt = 0;; attempt++)
+        {
+            auto before = _sequence.load(std::memory_order_acquire);
+
+            if ((before & 1) == 0)
+            {
+                for (size_t i = 0; i < WordCount; i++)
+                    words[i] = _words[i].load(std::memory_order_relaxed);
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                if (_sequence.load(std::memory_order_relaxed) == before)
+                    break;
+            }
+
+            // Writer might have been preempted in the middle of a write
+            if (attempt >= 64)
+                std::this_thread::yield();
+        }
+
+        T value;
+        std::memcpy(&value, words, sizeof(T));
+        return value;
+    }
+};
@@ -0,0 +1,336 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <system_error>
+#include <tuple>
+#include <vector>
+
+// On disk cache of compiled shader bytecode and pipeline state blobs, api independent.
+//
+// File is a header followed by records, every record has its own checksum. Bytecode records are
+// keyed by the version of the compiler dll and the hash of the source, entry point, target and
+// compile flags, compiled bytecode doesn't depend on the GPU so they are shared by all adapters.
+// Pipeline records are keyed by the bytecode, flags and root signature and belong to one adapter
+// and driver version, a pipeline stored for a newer driver of the same adapter drops the records
+// of the older one.
+//
+// Invalidation rules:
+// - Wrong magic or format version rejects the whole file
+// - A truncated record or a checksum mismatch drops that record and everything after it
+// - Pipeline records are only returned for the exact adapter and driver they were stored with
+class ShaderCache
+{
+  public:
+    enum class Kind : uint32_t
+    {
+        Bytecode = 1,
+        Pipeline = 2,
+    };
+
+    struct Identity
+    {
+        uint32_t vendorId = 0;
+        uint32_t deviceId = 0;
+        uint64_t driverVersion = 0;
+
+        bool IsValid() const { return vendorId != 0 && driverVersion != 0; }
+
+        bool operator==(const Identity& other) const
+        {
+            return vendorId == other.vendorId && deviceId == other.deviceId && driverVersion == other.driverVersion;
+        }
+    };
+
+    static constexpr uint32_t Magic = 0x4353534F; // OSSC
+    static constexpr uint32_t Version = 2;
+
+    // Records bigger than this are rejected, a single compute pipeline is a few hundred KB at most
+    static constexpr uint32_t MaxRecordSize = 16u * 1024 * 1024;
+
+    static constexpr uint64_t HashSeed = 0xCBF29CE484222325ull;
+
+    // FNV-1a, chain calls with the previous result as seed to hash several parts
+    static uint64_t Hash(const void* data, size_t size, uint64_t seed = HashSeed)
+    {
+        auto bytes = (const uint8_t*) data;
+        auto hash = seed;
+
+        for (size_t i = 0; i < size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= 0x100000001B3ull;
+        }
+
+        return hash;
+    }
+
+    static uint64_t Hash(const char* text, uint64_t seed = HashSeed)
+    {
+        // Terminator is hashed too so "ab" + "c" and "a" + "bc" differ
+        return Hash(text, std::strlen(text) + 1, seed);
+    }
+
+    // Compiler version is the file version of the compiler dll which is loaded, not the one of the sdk
+    static uint64_t BytecodeKey(uint64_t compilerVersion, const char* shaderCode, size_t size, const char* entryPoint,
+                                const char* target, uint64_t seed = HashSeed)
+    {
+        auto key = Hash(&compilerVersion, sizeof(compilerVersion), seed);
+        key = Hash(shaderCode, size, key);
+        key = Hash(entryPoint, key);
+
+        return Hash(target, key);
+    }
+
+    // Driver blob of a pipeline is only valid for the same bytecode and root signature
+    static uint64_t PipelineKey(const void* bytecode, size_t size, uint32_t flags, uint64_t rootSignatureHash)
+    {
+        auto key = Hash(bytecode, size);
+        key = Hash(&flags, sizeof(flags), key);
+
+        return Hash(&rootSignatureHash, sizeof(rootSignatureHash), key);
+    }
+
+    // Returns nullptr when there is no record, pointer is valid until the next Store or Remove
+    const std::vector<uint8_t>* Find(Kind kind, uint64_t key, const Identity& identity) const
+    {
+        auto it = _records.find(MakeKey(kind, key, identity));
+
+        if (it == _records.end())
+            return nullptr;
+
+        return &it->second;
+    }
+
+    void Store(Kind kind, uint64_t key, const Identity& identity, const void* data, size_t size)
+    {
+        if (size == 0 || size > MaxRecordSize)
+            return;
+
+        if (kind == Kind::Pipeline)
+        {
+            // Driver was updated, pipelines of the old one can't be used anymore
+            for (auto it = _records.begin(); it != _records.end();)
+            {
+                auto& [recordKind, recordKey, vendorId, deviceId, driverVersion] = it->first;
+
+                if (recordKind == (uint32_t) Kind::Pipeline && vendorId == identity.vendorId &&
+                    deviceId == identity.deviceId && driverVersion != identity.driverVersion)
+                {
+                    it = _records.erase(it);
+                }
+                else
+                {
+                    it++;
+                }
+            }
+        }
+
+        auto bytes = (const uint8_t*) data;
+        _records[MakeKey(kind, key, identity)].assign(bytes, bytes + size);
+        _dirty = true;
+    }
+
+    bool Remove(Kind kind, uint64_t key, const Identity& identity)
+    {
+        if (_records.erase(MakeKey(kind, key, identity)) == 0)
+            return false;
+
+        _dirty = true;
+        return true;
+    }
+
+    std::vector<uint8_t> Serialize() const
+    {
+        std::vector<uint8_t> file;
+
+        FileHeader header { Magic, Version, (uint32_t) _records.size(), 0 };
+        Append(file, &header, sizeof(header));
+
+        for (const auto& [recordKey, data] : _records)
+        {
+            auto& [kind, key, vendorId, deviceId, driverVersion] = recordKey;
+
+            RecordHeader record {};
+            record.kind = kind;
+            record.size = (uint32_t) data.size();
+            record.key = key;
+            record.vendorId = vendorId;
+            record.deviceId = deviceId;
+            record.driverVersion = driverVersion;
+            record.checksum = Hash(data.data(), data.size());
+
+            Append(file, &record, sizeof(record));
+            Append(file, data.data(), data.size());
+        }
+
+        return file;
+    }
+
+    // Replaces the contents, returns false when the file is rejected as a whole
+    bool Deserialize(const std::vector<uint8_t>& file)
+    {
+        _records.clear();
+        _dirty = false;
+
+        FileHeader header {};
+
+        if (file.size() < sizeof(header))
+            return false;
+
+        std::memcpy(&header, file.data(), sizeof(header));
+
+        if (header.magic != Magic || header.version != Version)
+            return false;
+
+        size_t offset = sizeof(header);
+
+        for (uint32_t i = 0; i < header.recordCount; i++)
+        {
+            RecordHeader record {};
+
+            if (file.size() - offset < sizeof(record))
+            {
+                _dirty = true;
+                break;
+            }
+
+            std::memcpy(&record, file.data() + offset, sizeof(record));
+            offset += sizeof(record);
+
+            if (record.size == 0 || record.size > MaxRecordSize || file.size() - offset < record.size ||
+                Hash(file.data() + offset, record.size) != record.checksum)
+            {
+                // Rewrite the file without the broken tail
+                _dirty = true;
+                break;
+            }
+
+            if (record.kind == (uint32_t) Kind::Bytecode || record.kind == (uint32_t) Kind::Pipeline)
+            {
+                Identity identity { record.vendorId, record.deviceId, record.driverVersion };
+                auto& data = _records[MakeKey((Kind) record.kind, record.key, identity)];
+                data.assign(file.data() + offset, file.data() + offset + record.size);
+            }
+
+            offset += record.size;
+        }
+
+        return true;
+    }
+
+    bool LoadFile(const std::filesystem::path& path)
+    {
+        std::ifstream stream(path, std::ios::binary);
+
+        if (!stream)
+        {
+            _records.clear();
+            _dirty = false;
+            return false;
+        }
+
+        std::vector<uint8_t> file((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+        if (Deserialize(file))
+            return true;
+
+        // Rejected file is replaced on the next save
+        _dirty = true;
+        return false;
+    }
+
+    // Written to a temporary file first, a crash while saving can't leave a half written cache
+    bool SaveFile(const std::filesystem::path& path)
+    {
+        auto file = Serialize();
+        auto tempPath = path;
+        tempPath += ".tmp";
+
+        {
+            std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+
+            if (!stream)
+                return false;
+
+            stream.write((const char*) file.data(), (std::streamsize) file.size());
+
+            if (!stream)
+                return false;
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tempPath, path, ec);
+
+        if (ec)
+        {
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+
+        _dirty = false;
+        return true;
+    }
+
+    bool IsDirty() const { return _dirty; }
+    void ClearDirty() { _dirty = false; }
+    size_t Count() const { return _records.size(); }
+
+    uint64_t Bytes() const
+    {
+        uint64_t bytes = 0;
+
+        for (const auto& record : _records)
+            bytes += record.second.size();
+
+        return bytes;
+    }
+
+  private:
+#pragma pack(push, 1)
+    struct FileHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t recordCount;
+        uint32_t reserved;
+    };
+
+    struct RecordHeader
+    {
+        uint32_t kind;
+        uint32_t size;
+        uint64_t key;
+        uint32_t vendorId;
+        uint32_t deviceId;
+        uint64_t driverVersion;
+        uint64_t checksum;
+    };
+#pragma pack(pop)
+
+    // Kind, key, vendor, device, driver
+    using RecordKey = std::tuple<uint32_t, uint64_t, uint32_t, uint32_t, uint64_t>;
+
+    std::map<RecordKey, std::vector<uint8_t>> _records;
+    bool _dirty = false;
+
+    static RecordKey MakeKey(Kind kind, uint64_t key, const Identity& identity)
+    {
+        // Bytecode is the same on every adapter
+        if (kind == Kind::Bytecode)
+            return { (uint32_t) kind, key, 0, 0, 0 };
+
+        return { (uint32_t) kind, key, identity.vendorId, identity.deviceId, identity.driverVersion };
+    }
+
+    static void Append(std::vector<uint8_t>& file, const void* data, size_t size)
+    {
+        auto offset = file.size();
+        file.resize(offset + size);
+        std::memcpy(file.data() + offset, data, size);
+    }
+};
@@ -0,0 +1,389 @@
+#include "ShaderCache_Dx12.h"
+
+#include <Config.h>
+#include <State.h>
+#include <Util.h>
+
+#include <proxies/Dxgi_Proxy.h>
+
+#include <thread>
+
+bool ShaderCache_Dx12::IsEnabled() { return Config::Instance()->UseShaderCache.value_or_default(); }
+
+std::filesystem::path ShaderCache_Dx12::CachePath()
+{
+    return Util::DllPath().parent_path() / "OptiScaler.shadercache";
+}
+
+void ShaderCache_Dx12::Load()
+{
+    auto path = CachePath();
+    ShaderCache cache;
+    auto loaded = cache.LoadFile(path);
+    auto count = cache.Count();
+    auto bytes = cache.Bytes();
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _cache = std::move(cache);
+        _loadState = LoadState::Loaded;
+    }
+
+    _loadedCondition.notify_all();
+
+    if (loaded)
+        LOG_INFO("Shader cache loaded, entries: {}, size: {} KB", count, bytes / 1024);
+    else if (std::filesystem::exists(path))
+        LOG_WARN("Shader cache file is not valid, it will be rebuilt");
+}
+
+void ShaderCache_Dx12::Prefetch()
+{
+    if (!IsEnabled())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (_loadState != LoadState::NotStarted)
+            return;
+
+        _loadState = LoadState::Loading;
+    }
+
+    // Not joined, this is called while the loader lock is held and the thread only starts after
+    std::thread(Load).detach();
+}
+
+void ShaderCache_Dx12::WaitForLoad(std::unique_lock<std::mutex>& lock)
+{
+    if (_loadState == LoadState::NotStarted)
+    {
+        // Prefetch was not called, load on this thread
+        _loadState = LoadState::Loading;
+        lock.unlock();
+        Load();
+        lock.lock();
+        return;
+    }
+
+    _loadedCondition.wait(lock, [] { return _loadState == LoadState::Loaded; });
+}
+
+ShaderCache::Identity ShaderCache_Dx12::GetIdentity(ID3D12Device* device)
+{
+    auto luid = device->GetAdapterLuid();
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        for (const auto& adapter : _adapters)
+        {
+            if (adapter.luid.LowPart == luid.LowPart && adapter.luid.HighPart == luid.HighPart)
+                return adapter.identity;
+        }
+    }
+
+    ShaderCache::Identity identity {};
+
+    DxgiProxy::Init();
+    IDXGIFactory1* factory = nullptr;
+    IDXGIAdapter* adapter = nullptr;
+
+    State::Instance().skipSpoofing = true;
+
+    do
+    {
+        if (DxgiProxy::CreateDxgiFactory1_() == nullptr ||
+            DxgiProxy::CreateDxgiFactory1_()(__uuidof(IDXGIFactory4), &factory) != S_OK || factory == nullptr)
+        {
+            break;
+        }
+
+        if (((IDXGIFactory4*) factory)->EnumAdapterByLuid(luid, IID_PPV_ARGS(&adapter)) != S_OK ||
+            adapter == nullptr)
+        {
+            break;
+        }
+
+        DXGI_ADAPTER_DESC desc {};
+        LARGE_INTEGER umdVersion {};
+
+        if (adapter->GetDesc(&desc) != S_OK ||
+            adapter->CheckInterfaceSupport(__uuidof(IDXGIDevice), &umdVersion) != S_OK)
+        {
+            break;
+        }
+
+        identity.vendorId = desc.VendorId;
+        identity.deviceId = desc.DeviceId;
+        identity.driverVersion = (uint64_t) umdVersion.QuadPart;
+
+    } while (false);
+
+    State::Instance().skipSpoofing = false;
+
+    if (adapter != nullptr)
+        adapter->Release();
+
+    if (factory != nullptr)
+        factory->Release();
+
+    if (identity.IsValid())
+    {
+        LOG_INFO("Shader cache adapter: {:X}:{:X}, driver: {}.{}.{}.{}", identity.vendorId, identity.deviceId,
+                 identity.driverVersion >> 48, (identity.driverVersion >> 32) & 0xFFFF,
+                 (identity.driverVersion >> 16) & 0xFFFF, identity.driverVersion & 0xFFFF);
+    }
+    else
+    {
+        LOG_WARN("Can't read adapter and driver version, pipelines won't be cached");
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _adapters.push_back({ luid, identity });
+
+    return identity;
+}
+
+void ShaderCache_Dx12::MarkStored()
+{
+    _framesSinceStore.store(0, std::memory_order_relaxed);
+    _pendingSave.store(true, std::memory_order_release);
+}
+
+uint64_t ShaderCache_Dx12::CompilerVersion()
+{
+    std::call_once(_compilerVersionOnce,
+                   []
+                   {
+                       // Games can ship their own d3dcompiler_47.dll, its output might differ from the system one
+                       _compilerVersion = D3D_COMPILER_VERSION;
+
+                       auto module = GetModuleHandleW(D3DCOMPILER_DLL_W);
+                       wchar_t path[MAX_PATH] {};
+                       version_t version {};
+
+                       if (module == nullptr || GetModuleFileNameW(module, path, MAX_PATH) == 0 ||
+                           !Util::GetDLLVersion(path, &version))
+                       {
+                           LOG_WARN("Can't read the version of {}, using {}", wstring_to_string(D3DCOMPILER_DLL_W),
+                                    D3D_COMPILER_VERSION);
+                           return;
+                       }
+
+                       _compilerVersion = ((uint64_t) version.major << 48) | ((uint64_t) version.minor << 32) |
+                                          ((uint64_t) version.patch << 16) | version.reserved;
+
+                       LOG_INFO("Shader compiler: {}.{}.{}.{}", version.major, version.minor, version.patch,
+                                version.reserved);
+                   });
+
+    return _compilerVersion;
+}
+
+uint64_t ShaderCache_Dx12::BytecodeKey(const char* shaderCode, size_t size, const char* entryPoint, const char* target,
+                                       uint64_t seed)
+{
+    return ShaderCache::BytecodeKey(CompilerVersion(), shaderCode, size, entryPoint, target, seed);
+}
+
+ID3DBlob* ShaderCache_Dx12::FindBytecode(uint64_t key)
+{
+    if (!IsEnabled())
+        return nullptr;
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    WaitForLoad(lock);
+
+    auto data = _cache.Find(ShaderCache::Kind::Bytecode, key, {});
+
+    if (data == nullptr)
+        return nullptr;
+
+    ID3DBlob* blob = nullptr;
+
+    if (D3DCreateBlob(data->size(), &blob) != S_OK || blob == nullptr)
+        return nullptr;
+
+    memcpy(blob->GetBufferPointer(), data->data(), data->size());
+    return blob;
+}
+
+void ShaderCache_Dx12::StoreBytecode(uint64_t key, ID3DBlob* blob)
+{
+    if (!IsEnabled() || blob == nullptr)
+        return;
+
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        WaitForLoad(lock);
+
+        _cache.Store(ShaderCache::Kind::Bytecode, key, {}, blob->GetBufferPointer(), blob->GetBufferSize());
+    }
+
+    MarkStored();
+}
+
+ID3DBlob* ShaderCache_Dx12::CompileShader(const char* shaderCode, const char* entryPoint, const char* target,
+                                          CompileFn compile)
+{
+    if (!IsEnabled())
+        return compile(shaderCode, entryPoint, target);
+
+    auto key = BytecodeKey(shaderCode, strlen(shaderCode), entryPoint, target);
+    auto blob = FindBytecode(key);
+
+    if (blob != nullptr)
+    {
+        LOG_DEBUG("Using cached bytecode for {}", entryPoint);
+        return blob;
+    }
+
+    blob = compile(shaderCode, entryPoint, target);
+    StoreBytecode(key, blob);
+
+    return blob;
+}
+
+namespace
+{
+// {6B2F3A52-8C1D-4E7B-9A35-0F1C2D4E5B61}
+const GUID RootSignatureHashGuid = { 0x6b2f3a52, 0x8c1d, 0x4e7b, { 0x9a, 0x35, 0x0f, 0x1c, 0x2d, 0x4e, 0x5b, 0x61 } };
+} // namespace
+
+HRESULT ShaderCache_Dx12::CreateRootSignature(ID3D12Device* device, ID3DBlob* serialized,
+                                              ID3D12RootSignature** rootSignature)
+{
+    auto hr = device->CreateRootSignature(0, serialized->GetBufferPointer(), serialized->GetBufferSize(),
+                                          IID_PPV_ARGS(rootSignature));
+
+    if (hr != S_OK)
+        return hr;
+
+    // Private data lives as long as the root signature, a new one at the same address can't inherit it
+    auto hash = ShaderCache::Hash(serialized->GetBufferPointer(), serialized->GetBufferSize());
+    (*rootSignature)->SetPrivateData(RootSignatureHashGuid, sizeof(hash), &hash);
+
+    return hr;
+}
+
+HRESULT ShaderCache_Dx12::CreateComputePipeline(ID3D12Device* device, const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc,
+                                                ID3D12PipelineState** pipelineState)
+{
+    auto psoDesc = desc;
+    psoDesc.CachedPSO = {};
+
+    if (!IsEnabled())
+        return device->CreateComputePipelineState(&psoDesc, IID_PPV_ARGS(pipelineState));
+
+    auto identity = GetIdentity(device);
+    uint64_t rootSignatureHash = 0;
+    UINT hashSize = sizeof(rootSignatureHash);
+
+    if (psoDesc.pRootSignature == nullptr ||
+        psoDesc.pRootSignature->GetPrivateData(RootSignatureHashGuid, &hashSize, &rootSignatureHash) != S_OK ||
+        hashSize != sizeof(rootSignatureHash))
+    {
+        // Blob of another root signature would be rejected or worse, accepted
+        LOG_DEBUG("Root signature was not created by the cache, pipeline is not cached");
+        return device->CreateComputePipelineState(&psoDesc, IID_PPV_ARGS(pipelineState));
+    }
+
+    if (!identity.IsValid())
+        return device->CreateComputePipelineState(&psoDesc, IID_PPV_ARGS(pipelineState));
+
+    auto key = ShaderCache::PipelineKey(psoDesc.CS.pShaderBytecode, psoDesc.CS.BytecodeLength, (uint32_t) psoDesc.Flags,
+                                        rootSignatureHash);
+    std::vector<uint8_t> cachedBlob;
+
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        WaitForLoad(lock);
+
+        if (auto data = _cache.Find(ShaderCache::Kind::Pipeline, key, identity); data != nullptr)
+            cachedBlob = *data;
+    }
+
+    if (!cachedBlob.empty())
+    {
+        psoDesc.CachedPSO.pCachedBlob = cachedBlob.data();
+        psoDesc.CachedPSO.CachedBlobSizeInBytes = cachedBlob.size();
+
+        auto hr = device->CreateComputePipelineState(&psoDesc, IID_PPV_ARGS(pipelineState));
+
+        if (hr == S_OK)
+            return hr;
+
+        // Driver didn't accept the blob, create it from scratch
+        LOG_DEBUG("Cached pipeline rejected: {:X}", (UINT) hr);
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _cache.Remove(ShaderCache::Kind::Pipeline, key, identity);
+        }
+
+        psoDesc.CachedPSO = {};
+    }
+
+    auto hr = device->CreateComputePipelineState(&psoDesc, IID_PPV_ARGS(pipelineState));
+
+    if (hr != S_OK)
+        return hr;
+
+    ID3DBlob* blob = nullptr;
+
+    if ((*pipelineState)->GetCachedBlob(&blob) == S_OK && blob != nullptr)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _cache.Store(ShaderCache::Kind::Pipeline, key, identity, blob->GetBufferPointer(), blob->GetBufferSize());
+        }
+
+        blob->Release();
+        MarkStored();
+    }
+
+    return hr;
+}
+
+void ShaderCache_Dx12::EndFrame()
+{
+    if (!_pendingSave.load(std::memory_order_acquire))
+        return;
+
+    // Passes are usually created in bursts, wait until it is quiet
+    if (_framesSinceStore.fetch_add(1, std::memory_order_relaxed) + 1 < SaveFrames)
+        return;
+
+    _pendingSave.store(false, std::memory_order_release);
+    std::thread(Save).detach();
+}
+
+void ShaderCache_Dx12::Save()
+{
+    // Only one writer for the file
+    std::lock_guard<std::mutex> saveLock(_saveMutex);
+
+    ShaderCache snapshot;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (_loadState != LoadState::Loaded || !_cache.IsDirty())
+            return;
+
+        snapshot = _cache;
+        _cache.ClearDirty();
+    }
+
+    auto path = CachePath();
+
+    if (!snapshot.SaveFile(path))
+    {
+        LOG_WARN("Can't write shader cache: {}", path.string());
+        return;
+    }
+
+    LOG_INFO("Shader cache saved, entries: {}, size: {} KB", snapshot.Count(), snapshot.Bytes() / 1024);
+}
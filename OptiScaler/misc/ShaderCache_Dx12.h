@@ -0,0 +1,91 @@
+#pragma once
+#include <pch.h>
+
+#include "ShaderCache.h"
+
+#include <d3d12.h>
+#include <d3dcompiler.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+// Persistent cache for the runtime compiled shaders and compute pipelines of the internal passes.
+//
+// Cache file is read on a background thread at DLL load, lookups wait for it only if they come
+// before it is done. Compiled bytecode skips D3DCompile, pipeline blobs from GetCachedBlob are
+// given to the driver as CachedPSO and dropped when it rejects them. Root signatures created with
+// CreateRootSignature carry the hash of their serialized blob, pipelines are only cached when
+// their root signature has one. New entries are written back
+// on a background thread once no new entry was added for SaveFrames frames.
+class ShaderCache_Dx12
+{
+  public:
+    using CompileFn = ID3DBlob* (*) (const char* shaderCode, const char* entryPoint, const char* target);
+
+    static constexpr uint32_t SaveFrames = 300;
+
+    // Starts loading the cache file, called once at DLL load
+    static void Prefetch();
+
+    // Key of a compiled shader, seed can carry anything else which changes the output (defines, flags)
+    static uint64_t BytecodeKey(const char* shaderCode, size_t size, const char* entryPoint, const char* target,
+                                uint64_t seed = ShaderCache::HashSeed);
+
+    // Returns a new blob, nullptr when there is no cached bytecode
+    static ID3DBlob* FindBytecode(uint64_t key);
+    static void StoreBytecode(uint64_t key, ID3DBlob* blob);
+
+    // Cached bytecode or the result of compile, which is stored for the next run
+    static ID3DBlob* CompileShader(const char* shaderCode, const char* entryPoint, const char* target,
+                                   CompileFn compile);
+
+    // CreateRootSignature which tags the root signature with the hash of serialized
+    static HRESULT CreateRootSignature(ID3D12Device* device, ID3DBlob* serialized,
+                                       ID3D12RootSignature** rootSignature);
+
+    // CreateComputePipelineState with the cached blob of the pipeline when there is one, CachedPSO of desc is ignored
+    static HRESULT CreateComputePipeline(ID3D12Device* device, const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc,
+                                         ID3D12PipelineState** pipelineState);
+
+    // Called once per presented frame, starts the background save when it's time
+    static void EndFrame();
+
+    // Writes pending entries, blocks the caller
+    static void Save();
+
+  private:
+    enum class LoadState
+    {
+        NotStarted,
+        Loading,
+        Loaded,
+    };
+
+    struct Adapter
+    {
+        LUID luid {};
+        ShaderCache::Identity identity {};
+    };
+
+    inline static ShaderCache _cache;
+    inline static std::mutex _mutex;
+    inline static std::condition_variable _loadedCondition;
+    inline static LoadState _loadState = LoadState::NotStarted;
+    inline static std::vector<Adapter> _adapters;
+    inline static std::once_flag _compilerVersionOnce;
+    inline static uint64_t _compilerVersion = 0;
+
+    inline static std::atomic<bool> _pendingSave = false;
+    inline static std::atomic<uint32_t> _framesSinceStore = 0;
+    inline static std::mutex _saveMutex;
+
+    static bool IsEnabled();
+    static std::filesystem::path CachePath();
+    static void Load();
+    static void WaitForLoad(std::unique_lock<std::mutex>& lock);
+    static ShaderCache::Identity GetIdentity(ID3D12Device* device);
+    static uint64_t CompilerVersion();
+    static void MarkStored();
+};
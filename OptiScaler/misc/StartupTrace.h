@@ -0,0 +1,235 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+// Named time spans recorded from any thread, api independent.
+//
+// Spans have steady clock nanoseconds and a small id of the recording thread (1 for the first thread
+// which recorded something, usually the one running DllMain). They go into a fixed array through an
+// atomic index, recording doesn't lock or allocate so it can be used under the loader lock and from
+// hooks; spans past Capacity are counted and dropped. Names are not copied, use string literals.
+//
+// ExportChromeTrace writes complete ("X") events in the Trace Event Format, chrome://tracing and
+// Perfetto show nested spans of a thread as a flame graph.
+class SpanRecorder
+{
+  public:
+    static constexpr uint32_t Capacity = 1024;
+
+    struct Span
+    {
+        const char* name = nullptr;
+        uint64_t start = 0;
+        uint64_t end = 0;
+        uint32_t thread = 0;
+    };
+
+    struct Token
+    {
+        const char* name = nullptr;
+        uint64_t start = 0;
+    };
+
+    class Scope
+    {
+        SpanRecorder& _recorder;
+        Token _token;
+
+      public:
+        Scope(SpanRecorder& recorder, const char* name) : _recorder(recorder), _token(recorder.Begin(name)) {}
+        ~Scope() { _recorder.End(_token); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    static uint64_t Now()
+    {
+        auto now = std::chrono::steady_clock::now().time_since_epoch();
+        return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+    }
+
+    static uint32_t ThreadId()
+    {
+        static std::atomic<uint32_t> next { 1 };
+        thread_local uint32_t id = next.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    Token Begin(const char* name) const { return { name, Now() }; }
+
+    void End(const Token& token)
+    {
+        if (token.name != nullptr)
+            Record(token.name, token.start, Now(), ThreadId());
+    }
+
+    void Record(const char* name, uint64_t start, uint64_t end, uint32_t thread)
+    {
+        auto index = _next.fetch_add(1, std::memory_order_relaxed);
+
+        if (index >= Capacity)
+        {
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        auto& slot = _slots[index];
+        slot.span = { name, start, end, thread };
+        slot.ready.store(true, std::memory_order_release);
+    }
+
+    // Completed spans in the order they were ended, a span still being written is skipped
+    std::vector<Span> Spans() const
+    {
+        std::vector<Span> spans;
+        auto count = std::min(_next.load(std::memory_order_acquire), Capacity);
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (_slots[i].ready.load(std::memory_order_acquire))
+                spans.push_back(_slots[i].span);
+        }
+
+        return spans;
+    }
+
+    uint32_t Dropped() const { return _dropped.load(std::memory_order_relaxed); }
+
+    // Timestamps are microseconds since the first span started
+    std::string ExportChromeTrace(uint32_t processId) const
+    {
+        auto spans = Spans();
+        auto origin = UINT64_MAX;
+
+        for (const auto& span : spans)
+            origin = std::min(origin, span.start);
+
+        std::string json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        char buffer[128];
+
+        std::snprintf(buffer, sizeof(buffer),
+                      "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":1,\"args\":{\"name\":", processId);
+        json += buffer;
+        AppendString(json, "OptiScaler");
+        json += "}}";
+
+        for (const auto& span : spans)
+        {
+            auto start = span.start - origin;
+            auto duration = span.end > span.start ? span.end - span.start : 0;
+
+            json += ",{\"name\":";
+            AppendString(json, span.name);
+
+            // Integer formatting, printf of doubles would follow the locale set by the game
+            std::snprintf(buffer, sizeof(buffer),
+                          ",\"cat\":\"startup\",\"ph\":\"X\",\"ts\":%llu.%03llu,\"dur\":%llu.%03llu,\"pid\":%u,"
+                          "\"tid\":%u}",
+                          (unsigned long long) (start / 1000), (unsigned long long) (start % 1000),
+                          (unsigned long long) (duration / 1000), (unsigned long long) (duration % 1000), processId,
+                          span.thread);
+            json += buffer;
+        }
+
+        json += "]}";
+        return json;
+    }
+
+    // Written to a temporary file first like the caches, a crash while saving leaves the old trace
+    bool SaveChromeTrace(const std::filesystem::path& path, uint32_t processId) const
+    {
+        auto json = ExportChromeTrace(processId);
+        auto tempPath = path;
+        tempPath += ".tmp";
+
+        {
+            std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+
+            if (!stream)
+                return false;
+
+            stream.write(json.data(), (std::streamsize) json.size());
+
+            if (!stream)
+                return false;
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tempPath, path, ec);
+
+        if (ec)
+        {
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+
+        return true;
+    }
+
+  private:
+    struct Slot
+    {
+        Span span;
+        std::atomic<bool> ready { false };
+    };
+
+    Slot _slots[Capacity];
+    std::atomic<uint32_t> _next { 0 };
+    std::atomic<uint32_t> _dropped { 0 };
+
+    static void AppendString(std::string& json, const char* text)
+    {
+        json += '"';
+
+        for (auto c = text; *c != 0; c++)
+        {
+            if (*c == '"' || *c == '\\')
+            {
+                json += '\\';
+                json += *c;
+            }
+            else if ((unsigned char) *c < 0x20)
+            {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned) (unsigned char) *c);
+                json += escaped;
+            }
+            else
+            {
+                json += *c;
+            }
+        }
+
+        json += '"';
+    }
+};
+
+// Spans of DllMain and the hooks it installs
+class StartupTrace
+{
+  public:
+    class Scope : public SpanRecorder::Scope
+    {
+      public:
+        explicit Scope(const char* name) : SpanRecorder::Scope(Recorder(), name) {}
+    };
+
+    static SpanRecorder& Recorder()
+    {
+        static SpanRecorder recorder;
+        return recorder;
+    }
+
+    static SpanRecorder::Token Begin(const char* name) { return Recorder().Begin(name); }
+    static void End(const SpanRecorder::Token& token) { Recorder().End(token); }
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+// Bool with a separate value on every thread.
+//
+// Used for flags which tell our own hooks that OptiScaler itself is calling the api, like
+// State::skipSpoofing. Hooks run on the calling thread, so a flag raised by a worker (backend
+// warm-up, descriptor ring init) doesn't change what the game's calls on the render thread see,
+// and the render thread can't clear it while the worker is still inside the api.
+//
+// Every Tag is a separate thread_local. Copying is deleted so the value can't be taken out with
+// auto by accident, read it as bool.
+template <typename Tag> class ThreadFlag
+{
+    inline static thread_local bool _value = false;
+
+  public:
+    ThreadFlag() = default;
+    ThreadFlag(const ThreadFlag&) = delete;
+    ThreadFlag& operator=(const ThreadFlag&) = delete;
+
+    ThreadFlag& operator=(bool value)
+    {
+        _value = value;
+        return *this;
+    }
+
+    operator bool() const { return _value; }
+};
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// Placement of transient textures inside one heap, api independent and doesn't touch the GPU.
+//
+// Every allocation has a lifetime, the passes of a frame between its first and last use. Two live
+// allocations may share memory when their lifetimes don't overlap, the default lifetime covers
+// the whole frame so such allocations always get their own range. A freed range keeps the fence
+// value of the last frame which used it and isn't touched until that value is completed, so the
+// memory of a texture whose lifetime ended is aliased by the next one without waiting on the CPU.
+//
+// Allocations are placed first fit: candidates are the start of the heap and the ends of ranges
+// which conflict with the new one, the lowest offset without a conflict wins. Offsets below the
+// high water mark were used before, textures placed there need an aliasing barrier before their
+// first use. Textures which share memory with another live one need it in every frame.
+class TransientPlanner
+{
+  public:
+    // Inclusive range of pass indices in a frame
+    struct Lifetime
+    {
+        uint32_t first = 0;
+        uint32_t last = UINT32_MAX;
+
+        bool Overlaps(const Lifetime& other) const { return first <= other.last && other.first <= last; }
+        bool operator==(const Lifetime& other) const = default;
+    };
+
+    struct Allocation
+    {
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        bool aliased = false;
+        Lifetime lifetime {};
+    };
+
+  private:
+    struct Range
+    {
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        Lifetime lifetime {};
+        uint64_t retireValue = 0;
+        bool retiring = false;
+
+        uint64_t End() const { return offset + size; }
+        bool Intersects(uint64_t start, uint64_t end) const { return offset < end && start < End(); }
+    };
+
+    uint64_t _capacity = 0;
+    uint64_t _used = 0;
+    uint64_t _peak = 0;
+    uint64_t _highWater = 0;
+
+    // Live and retiring ranges, a few dozen at most
+    std::vector<Range> _ranges;
+
+    // Retiring ranges might still be read by the GPU, nothing can be placed over them
+    static bool Conflicts(const Range& range, const Lifetime& lifetime)
+    {
+        return range.retiring || range.lifetime.Overlaps(lifetime);
+    }
+
+    bool IsFree(uint64_t start, uint64_t end, const Lifetime& lifetime) const
+    {
+        for (const auto& range : _ranges)
+        {
+            if (range.Intersects(start, end) && Conflicts(range, lifetime))
+                return false;
+        }
+
+        return true;
+    }
+
+  public:
+    explicit TransientPlanner(uint64_t capacity) : _capacity(capacity) {}
+
+    // Returns nullopt when there is no range which can hold size at alignment (power of 2)
+    std::optional<Allocation> Allocate(uint64_t size, uint64_t alignment, Lifetime lifetime)
+    {
+        if (size == 0 || size > _capacity || alignment == 0 || (alignment & (alignment - 1)) != 0 ||
+            lifetime.first > lifetime.last)
+        {
+            return std::nullopt;
+        }
+
+        std::vector<uint64_t> candidates { 0 };
+
+        for (const auto& range : _ranges)
+        {
+            if (Conflicts(range, lifetime))
+                candidates.push_back((range.End() + alignment - 1) & ~(alignment - 1));
+        }
+
+        std::sort(candidates.begin(), candidates.end());
+
+        for (auto offset : candidates)
+        {
+            if (offset > _capacity - size)
+                break;
+
+            if (!IsFree(offset, offset + size, lifetime))
+                continue;
+
+            Allocation allocation { offset, size, offset < _highWater, lifetime };
+            _ranges.push_back({ offset, size, lifetime, 0, false });
+
+            _used += size;
+            _peak = std::max(_peak, _used);
+            _highWater = std::max(_highWater, offset + size);
+
+            return allocation;
+        }
+
+        return std::nullopt;
+    }
+
+    // Lives for the whole frame
+    std::optional<Allocation> Allocate(uint64_t size, uint64_t alignment)
+    {
+        return Allocate(size, alignment, Lifetime {});
+    }
+
+    // Range can be reused after retireValue is completed, 0 makes it free at the next Reclaim
+    void Free(const Allocation& allocation, uint64_t retireValue)
+    {
+        for (auto& range : _ranges)
+        {
+            if (range.retiring || range.offset != allocation.offset || range.size != allocation.size ||
+                range.lifetime != allocation.lifetime)
+            {
+                continue;
+            }
+
+            range.retiring = true;
+            range.retireValue = retireValue;
+            _used -= allocation.size;
+            return;
+        }
+    }
+
+    // Frees ranges whose value is completed, returns the count of freed ranges
+    size_t Reclaim(uint64_t completedValue)
+    {
+        return std::erase_if(_ranges, [completedValue](const Range& range)
+                             { return range.retiring && range.retireValue <= completedValue; });
+    }
+
+    // True when another live allocation uses a part of the same memory in a different pass
+    bool SharesMemory(const Allocation& allocation) const
+    {
+        uint32_t count = 0;
+
+        for (const auto& range : _ranges)
+        {
+            if (!range.retiring && range.Intersects(allocation.offset, allocation.offset + allocation.size))
+                count++;
+        }
+
+        return count > 1;
+    }
+
+    uint64_t Capacity() const { return _capacity; }
+
+    // Sum of live allocations, can be more than the footprint when they share memory
+    uint64_t Used() const { return _used; }
+    uint64_t Peak() const { return _peak; }
+    uint64_t HighWater() const { return _highWater; }
+
+    // End of the highest range which is live or retiring
+    uint64_t Footprint() const
+    {
+        uint64_t end = 0;
+
+        for (const auto& range : _ranges)
+            end = std::max(end, range.End());
+
+        return end;
+    }
+
+    uint64_t RetiringBytes() const
+    {
+        uint64_t bytes = 0;
+
+        for (const auto& range : _ranges)
+        {
+            if (range.retiring)
+                bytes += range.size;
+        }
+
+        return bytes;
+    }
+
+    // Nothing is placed and nothing waits for the GPU
+    bool IsEmpty() const { return _ranges.empty(); }
+};
@@ -0,0 +1,457 @@
+#include "TransientPool_Dx12.h"
+
+#include "DeferredRelease_Dx12.h"
+
+namespace
+{
+bool SameDesc(const D3D12_RESOURCE_DESC& a, const D3D12_RESOURCE_DESC& b)
+{
+    return a.Dimension == b.Dimension && a.Alignment == b.Alignment && a.Width == b.Width && a.Height == b.Height &&
+           a.DepthOrArraySize == b.DepthOrArraySize && a.MipLevels == b.MipLevels && a.Format == b.Format &&
+           a.SampleDesc.Count == b.SampleDesc.Count && a.SampleDesc.Quality == b.SampleDesc.Quality &&
+           a.Layout == b.Layout && a.Flags == b.Flags;
+}
+} // namespace
+
+bool TransientPool_Dx12::CanPlace(ID3D12Device* device, const D3D12_RESOURCE_DESC& desc, D3D12_HEAP_TYPE heapType,
+                                  const D3D12_RESOURCE_ALLOCATION_INFO& info)
+{
+    if (_device == nullptr)
+    {
+        D3D12_FEATURE_DATA_D3D12_OPTIONS options {};
+
+        if (device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &options, sizeof(options)) == S_OK)
+            _heapTier = options.ResourceHeapTier;
+
+        _device = device;
+        LOG_INFO("Resource heap tier: {}", (UINT) _heapTier);
+    }
+
+    // Tier 1 heaps can't mix render targets with other textures, committed resources are used there
+    return device == _device && _heapTier >= D3D12_RESOURCE_HEAP_TIER_2 && heapType == D3D12_HEAP_TYPE_DEFAULT &&
+           desc.Dimension != D3D12_RESOURCE_DIMENSION_BUFFER && info.SizeInBytes != UINT64_MAX &&
+           info.Alignment <= D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+}
+
+TransientPool_Dx12::Heap* TransientPool_Dx12::Place(const D3D12_RESOURCE_ALLOCATION_INFO& info,
+                                                    TransientPlanner::Lifetime lifetime,
+                                                    TransientPlanner::Allocation& allocation)
+{
+    for (auto& heap : _heaps)
+    {
+        auto placed = heap->planner.Allocate(info.SizeInBytes, info.Alignment, lifetime);
+
+        if (placed.has_value())
+        {
+            allocation = placed.value();
+            heap->lastUsedFrame = _frame;
+            return heap.get();
+        }
+    }
+
+    auto size = std::max(HeapSize, (info.SizeInBytes + D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT - 1) &
+                                       ~((UINT64) D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT - 1));
+
+    D3D12_HEAP_DESC heapDesc {};
+    heapDesc.SizeInBytes = size;
+    heapDesc.Properties.Type = D3D12_HEAP_TYPE_DEFAULT;
+    heapDesc.Alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+    heapDesc.Flags = D3D12_HEAP_FLAG_ALLOW_ALL_BUFFERS_AND_TEXTURES;
+
+    ID3D12Heap* d3dHeap = nullptr;
+    auto result = _device->CreateHeap(&heapDesc, IID_PPV_ARGS(&d3dHeap));
+
+    if (result != S_OK)
+    {
+        LOG_ERROR("CreateHeap({}) error: {:X}", size, (UINT) result);
+        return nullptr;
+    }
+
+    d3dHeap->SetName(L"OptiScaler_TransientHeap");
+
+    auto heap = std::make_unique<Heap>(size);
+    heap->heap = d3dHeap;
+    heap->lastUsedFrame = _frame;
+    allocation = heap->planner.Allocate(info.SizeInBytes, info.Alignment, lifetime).value();
+
+    LOG_DEBUG("New transient heap, size: {}", size);
+
+    _heaps.push_back(std::move(heap));
+    return _heaps.back().get();
+}
+
+bool TransientPool_Dx12::Acquire(ID3D12Device* device, const D3D12_RESOURCE_DESC& desc,
+                                 const D3D12_HEAP_PROPERTIES& heapProperties, D3D12_RESOURCE_STATES state,
+                                 LPCWSTR name, Texture& texture, TransientPlanner::Lifetime lifetime)
+{
+    if (device == nullptr)
+        return false;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Device was created again after shutdown
+    _shutdown = false;
+
+    for (auto& entry : _entries)
+    {
+        if (entry.inUse || entry.heapType != heapProperties.Type || !SameDesc(entry.desc, desc) ||
+            entry.allocation.lifetime != lifetime)
+        {
+            continue;
+        }
+
+        ID3D12Device* entryDevice = nullptr;
+
+        if (entry.resource->GetDevice(IID_PPV_ARGS(&entryDevice)) != S_OK)
+            continue;
+
+        entryDevice->Release();
+
+        if (entryDevice != device)
+            continue;
+
+        entry.inUse = true;
+        entry.resource->SetName(name);
+
+        texture.resource = entry.resource;
+        texture.state = entry.state;
+        texture.needsInit = entry.needsAliasing || entry.needsDiscard;
+        texture.inFrame = entry.heap != nullptr && entry.allocation.lifetime != TransientPlanner::Lifetime {};
+
+        LOG_DEBUG("Recycled {}x{} texture", desc.Width, desc.Height);
+        return true;
+    }
+
+    Entry entry {};
+    entry.desc = desc;
+    entry.heapType = heapProperties.Type;
+    entry.state = state;
+
+    auto info = device->GetResourceAllocationInfo(0, 1, &desc);
+    HRESULT result = E_FAIL;
+
+    if (CanPlace(device, desc, heapProperties.Type, info))
+    {
+        entry.heap = Place(info, lifetime, entry.allocation);
+
+        if (entry.heap != nullptr)
+        {
+            // Placed render targets have to be initialized with a discard, which needs the render target state
+            if (desc.Flags & D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET)
+            {
+                entry.state = D3D12_RESOURCE_STATE_RENDER_TARGET;
+                entry.needsDiscard = true;
+                entry.discardState = entry.state;
+            }
+            else if (desc.Flags & D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL)
+            {
+                entry.state = D3D12_RESOURCE_STATE_DEPTH_WRITE;
+                entry.needsDiscard = true;
+                entry.discardState = entry.state;
+            }
+
+            entry.needsAliasing = entry.allocation.aliased;
+
+            result = device->CreatePlacedResource(entry.heap->heap, entry.allocation.offset, &desc, entry.state,
+                                                  nullptr, IID_PPV_ARGS(&entry.resource));
+
+            if (result != S_OK)
+            {
+                LOG_ERROR("CreatePlacedResource error: {:X}", (UINT) result);
+                entry.heap->planner.Free(entry.allocation, 0);
+                entry.heap = nullptr;
+            }
+        }
+    }
+
+    if (entry.heap == nullptr)
+    {
+        entry.state = state;
+        entry.needsAliasing = false;
+        entry.needsDiscard = false;
+
+        result = device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &desc, state, nullptr,
+                                                 IID_PPV_ARGS(&entry.resource));
+
+        if (result != S_OK)
+        {
+            LOG_ERROR("CreateCommittedResource error: {:X}", (UINT) result);
+            return false;
+        }
+    }
+
+    entry.size = info.SizeInBytes != UINT64_MAX ? info.SizeInBytes : 0;
+    entry.inUse = true;
+    entry.resource->SetName(name);
+
+    LOG_DEBUG("New {}x{} texture, size: {}, placed: {}, aliased: {}, passes: {}-{}", desc.Width, desc.Height,
+              entry.size, entry.heap != nullptr, entry.needsAliasing, lifetime.first, lifetime.last);
+
+    texture.resource = entry.resource;
+    texture.state = entry.state;
+    texture.needsInit = entry.needsAliasing || entry.needsDiscard;
+    texture.inFrame = entry.heap != nullptr && lifetime != TransientPlanner::Lifetime {};
+
+    _entries.push_back(entry);
+    _peakBytes = std::max(_peakBytes, ResidentBytes());
+
+    return true;
+}
+
+void TransientPool_Dx12::Release(ID3D12Resource* resource, D3D12_RESOURCE_STATES state)
+{
+    if (resource == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    for (auto it = _entries.begin(); it != _entries.end(); it++)
+    {
+        if (it->resource != resource)
+            continue;
+
+        it->inUse = false;
+        it->state = state;
+        it->releasedFrame = _frame;
+
+        if (_shutdown)
+        {
+            Destroy(*it);
+            _entries.erase(it);
+            ReleaseUnusedHeaps();
+        }
+
+        return;
+    }
+
+    LOG_WARN("Resource is not from the pool");
+}
+
+void TransientPool_Dx12::BeforeFirstUse(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* resource,
+                                        D3D12_RESOURCE_STATES state)
+{
+    if (cmdList == nullptr || resource == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    for (auto& entry : _entries)
+    {
+        if (entry.resource != resource)
+            continue;
+
+        if (entry.initFrame == _frame)
+            return;
+
+        entry.initFrame = _frame;
+
+        // Another texture used the memory in an other pass of the last frame, content is gone
+        if (entry.heap != nullptr && entry.heap->planner.SharesMemory(entry.allocation))
+        {
+            entry.needsAliasing = true;
+            entry.needsDiscard = entry.discardState != D3D12_RESOURCE_STATE_COMMON;
+        }
+
+        if (entry.needsAliasing)
+        {
+            D3D12_RESOURCE_BARRIER barrier = {};
+            barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_ALIASING;
+            barrier.Aliasing.pResourceBefore = nullptr;
+            barrier.Aliasing.pResourceAfter = resource;
+            cmdList->ResourceBarrier(1, &barrier);
+            entry.needsAliasing = false;
+        }
+
+        if (entry.needsDiscard)
+        {
+            // Discard needs the render target or depth write state, texture goes back to its state after it
+            D3D12_RESOURCE_BARRIER transitions[2] = {};
+
+            for (auto& transition : transitions)
+            {
+                transition.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+                transition.Transition.pResource = resource;
+                transition.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+            }
+
+            transitions[0].Transition.StateBefore = state;
+            transitions[0].Transition.StateAfter = entry.discardState;
+            transitions[1].Transition.StateBefore = entry.discardState;
+            transitions[1].Transition.StateAfter = state;
+
+            if (state != entry.discardState)
+                cmdList->ResourceBarrier(1, &transitions[0]);
+
+            cmdList->DiscardResource(resource, nullptr);
+
+            if (state != entry.discardState)
+                cmdList->ResourceBarrier(1, &transitions[1]);
+
+            entry.needsDiscard = false;
+        }
+
+        return;
+    }
+}
+
+void TransientPool_Dx12::Destroy(Entry& entry)
+{
+    auto resource = entry.resource;
+    entry.resource = nullptr;
+
+    if (entry.heap != nullptr)
+    {
+        // Range is reused when the fence passes the frames which might still read the texture
+        auto retireValue = DeferredRelease_Dx12::IsActive() ? DeferredRelease_Dx12::RetireValue() : 0;
+        entry.heap->planner.Free(entry.allocation, retireValue);
+        entry.heap->lastUsedFrame = _frame;
+    }
+
+    DeferredRelease_Dx12::Release(resource, "Transient texture");
+}
+
+void TransientPool_Dx12::ReleaseUnusedHeaps()
+{
+    for (auto it = _heaps.begin(); it != _heaps.end();)
+    {
+        auto heap = it->get();
+        auto used = std::any_of(_entries.begin(), _entries.end(), [heap](const Entry& e) { return e.heap == heap; });
+
+        if (used)
+        {
+            it++;
+            continue;
+        }
+
+        // Queued after the placed resources of the heap
+        DeferredRelease_Dx12::Release(heap->heap, "Transient heap");
+
+        it = _heaps.erase(it);
+    }
+}
+
+uint64_t TransientPool_Dx12::ResidentBytes()
+{
+    uint64_t bytes = 0;
+
+    for (const auto& heap : _heaps)
+        bytes += heap->planner.Capacity();
+
+    for (const auto& entry : _entries)
+    {
+        if (entry.heap == nullptr)
+            bytes += entry.size;
+    }
+
+    return bytes;
+}
+
+void TransientPool_Dx12::EndFrame()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_entries.empty() && _heaps.empty())
+        return;
+
+    _frame++;
+
+    for (auto it = _entries.begin(); it != _entries.end();)
+    {
+        if (it->inUse || _frame - it->releasedFrame <= IdleFrames)
+        {
+            it++;
+            continue;
+        }
+
+        LOG_DEBUG("Evicting idle {}x{} texture", it->desc.Width, it->desc.Height);
+        Destroy(*it);
+        it = _entries.erase(it);
+    }
+
+    auto completed = DeferredRelease_Dx12::CompletedValue();
+
+    for (auto it = _heaps.begin(); it != _heaps.end();)
+    {
+        auto& heap = *it;
+        heap->planner.Reclaim(completed);
+
+        // Kept for a while even when empty, next DRS step would create it again
+        if (!heap->planner.IsEmpty() || _frame - heap->lastUsedFrame <= IdleFrames)
+        {
+            it++;
+            continue;
+        }
+
+        LOG_DEBUG("Releasing empty transient heap");
+        heap->heap->Release();
+        it = _heaps.erase(it);
+    }
+
+    auto resident = ResidentBytes();
+    _peakBytes = std::max(_peakBytes, resident);
+
+    if (resident != _lastResidentBytes)
+    {
+        _lastResidentBytes = resident;
+        _unchangedFrames = 0;
+    }
+    else if (++_unchangedFrames == SteadyFrames)
+    {
+        _steadyBytes = resident;
+    }
+}
+
+void TransientPool_Dx12::Shutdown()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _shutdown = true;
+
+    for (auto it = _entries.begin(); it != _entries.end();)
+    {
+        if (it->inUse)
+        {
+            it++;
+            continue;
+        }
+
+        Destroy(*it);
+        it = _entries.erase(it);
+    }
+
+    ReleaseUnusedHeaps();
+
+    // Heap tier is checked again for the next device
+    if (_entries.empty())
+        _device = nullptr;
+
+    LOG_INFO("Peak transient memory: {} MB, steady: {} MB", _peakBytes / (1024 * 1024), _steadyBytes / (1024 * 1024));
+}
+
+TransientPool_Dx12::Stats TransientPool_Dx12::GetStats()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    Stats stats {};
+
+    for (const auto& heap : _heaps)
+        stats.heapBytes += heap->planner.Capacity();
+
+    for (const auto& entry : _entries)
+    {
+        if (entry.inUse)
+            stats.usedBytes += entry.size;
+        else
+            stats.idleBytes += entry.size;
+
+        if (entry.heap == nullptr)
+            stats.committedBytes += entry.size;
+    }
+
+    stats.peakBytes = _peakBytes;
+    stats.steadyBytes = _steadyBytes;
+    stats.textures = (uint32_t) _entries.size();
+    stats.heaps = (uint32_t) _heaps.size();
+
+    return stats;
+}
@@ -0,0 +1,138 @@
+#pragma once
+#include <pch.h>
+
+#include "TransientPlanner.h"
+
+#include <d3d12.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Shared pool for the textures of the post-processing passes.
+//
+// Passes acquire their buffers by descriptor instead of creating committed resources. A released
+// texture stays in the pool for IdleFrames frames and is handed to the next Acquire with the same
+// descriptor, so DRS going back and forth between sizes doesn't allocate. Textures are placed in
+// shared heaps where possible, a texture which was evicted leaves its range to the planner and
+// the next texture aliases that memory once the GPU is done with it. Passes give the lifetime of
+// their texture in the frame, textures whose passes don't overlap share memory in the same frame.
+// Falls back to committed resources when the device doesn't support mixed heaps.
+class TransientPool_Dx12
+{
+  public:
+    // Order of the passes in a frame, lifetimes of the textures are given with them
+    enum Pass : uint32_t
+    {
+        BiasPass,
+        UpscalerPass,
+        RcasPass,
+        OutputScalingPass,
+    };
+
+    struct Texture
+    {
+        ID3D12Resource* resource = nullptr;
+
+        // Current state of the resource, might differ from the requested one when it is recycled
+        D3D12_RESOURCE_STATES state = D3D12_RESOURCE_STATE_COMMON;
+
+        // BeforeFirstUse must be called before the texture is used
+        bool needsInit = false;
+
+        // Lifetime is shorter than the frame, BeforeFirstUse must be called before the first use in every frame
+        bool inFrame = false;
+    };
+
+    struct Stats
+    {
+        uint64_t usedBytes = 0;
+        uint64_t idleBytes = 0;
+        uint64_t heapBytes = 0;
+        uint64_t committedBytes = 0;
+        uint64_t peakBytes = 0;
+
+        // Resident bytes once they didn't change for SteadyFrames frames, 0 before that
+        uint64_t steadyBytes = 0;
+
+        uint32_t textures = 0;
+        uint32_t heaps = 0;
+    };
+
+    static constexpr uint32_t IdleFrames = 120;
+    static constexpr uint32_t SteadyFrames = 300;
+    static constexpr uint64_t HeapSize = 64ull * 1024 * 1024;
+
+    // Returns a texture matching desc, recycled from an earlier owner when possible. Content of a
+    // texture with a lifetime is only kept between its passes.
+    static bool Acquire(ID3D12Device* device, const D3D12_RESOURCE_DESC& desc,
+                        const D3D12_HEAP_PROPERTIES& heapProperties, D3D12_RESOURCE_STATES state, LPCWSTR name,
+                        Texture& texture, TransientPlanner::Lifetime lifetime = {});
+
+    // Gives the texture back to the pool with its current state, caller must not use it anymore
+    static void Release(ID3D12Resource* resource, D3D12_RESOURCE_STATES state);
+
+    // Aliasing barrier and discard of placed render targets, must be recorded before anything else
+    // uses the texture. Textures sharing memory with another one get them again in every frame.
+    // State is the current state of the texture, it is not changed.
+    static void BeforeFirstUse(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* resource,
+                               D3D12_RESOURCE_STATES state);
+
+    // Called once per presented frame, evicts idle textures and reclaims retired ranges
+    static void EndFrame();
+
+    // Releases idle textures and empty heaps, textures in use are released when given back
+    static void Shutdown();
+
+    static Stats GetStats();
+
+  private:
+    struct Heap
+    {
+        ID3D12Heap* heap = nullptr;
+        TransientPlanner planner;
+        uint32_t lastUsedFrame = 0;
+
+        explicit Heap(uint64_t size) : planner(size) {}
+    };
+
+    struct Entry
+    {
+        ID3D12Resource* resource = nullptr;
+        D3D12_RESOURCE_DESC desc {};
+        D3D12_HEAP_TYPE heapType = D3D12_HEAP_TYPE_DEFAULT;
+        D3D12_RESOURCE_STATES state = D3D12_RESOURCE_STATE_COMMON;
+        Heap* heap = nullptr;
+        TransientPlanner::Allocation allocation {};
+        uint64_t size = 0;
+        uint32_t releasedFrame = 0;
+        uint32_t initFrame = UINT32_MAX;
+        bool inUse = false;
+        bool needsAliasing = false;
+        bool needsDiscard = false;
+
+        // Render target or depth write for placed textures which must be discarded after aliasing
+        D3D12_RESOURCE_STATES discardState = D3D12_RESOURCE_STATE_COMMON;
+    };
+
+    inline static std::mutex _mutex;
+    inline static std::vector<std::unique_ptr<Heap>> _heaps;
+    inline static std::vector<Entry> _entries;
+    inline static ID3D12Device* _device = nullptr;
+    inline static D3D12_RESOURCE_HEAP_TIER _heapTier = D3D12_RESOURCE_HEAP_TIER_1;
+    inline static uint32_t _frame = 0;
+    inline static bool _shutdown = false;
+
+    inline static uint64_t _peakBytes = 0;
+    inline static uint64_t _steadyBytes = 0;
+    inline static uint64_t _lastResidentBytes = 0;
+    inline static uint32_t _unchangedFrames = 0;
+
+    static bool CanPlace(ID3D12Device* device, const D3D12_RESOURCE_DESC& desc, D3D12_HEAP_TYPE heapType,
+                         const D3D12_RESOURCE_ALLOCATION_INFO& info);
+    static Heap* Place(const D3D12_RESOURCE_ALLOCATION_INFO& info, TransientPlanner::Lifetime lifetime,
+                       TransientPlanner::Allocation& allocation);
+    static void Destroy(Entry& entry);
+    static void ReleaseUnusedHeaps();
+    static uint64_t ResidentBytes();
+};
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+// Immutable snapshot of state which changes rarely but is read on hot paths, api independent.
+//
+// Readers pass the current version of the source, the snapshot is only rebuilt by fill when the
+// version moved. Every rebuild publishes a new object and a reader keeps the one it got alive for
+// as long as it holds the pointer, no matter how often other threads change the source meanwhile.
+// Each thread caches the last snapshot it has seen, so the mutex is only taken after a change.
+template <typename T> class VersionedSnapshot
+{
+  public:
+    using Snapshot = std::shared_ptr<const T>;
+
+    // fill: void(T&), reads the source into a new snapshot
+    template <typename F> Snapshot Get(uint32_t version, F&& fill)
+    {
+        auto& cache = Local();
+
+        if (cache.owner != _id || cache.snapshot == nullptr || cache.version != version)
+        {
+            cache.snapshot = Current(version, fill);
+            cache.version = version;
+            cache.owner = _id;
+        }
+
+        return cache.snapshot;
+    }
+
+    // Number of snapshots built so far
+    uint32_t Builds() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _builds;
+    }
+
+  private:
+    struct ReaderCache
+    {
+        uint64_t owner = 0;
+        uint32_t version = 0;
+        Snapshot snapshot;
+    };
+
+    inline static std::atomic<uint64_t> _nextId { 1 };
+
+    // Ids instead of addresses, a new instance at the address of a destroyed one must not hit its caches
+    const uint64_t _id = _nextId.fetch_add(1, std::memory_order_relaxed);
+
+    mutable std::mutex _mutex;
+    Snapshot _current;
+    uint32_t _builtVersion = 0;
+    uint32_t _builds = 0;
+
+    static ReaderCache& Local()
+    {
+        static thread_local ReaderCache cache;
+        return cache;
+    }
+
+    template <typename F> Snapshot Current(uint32_t version, F& fill)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        // Another thread might have already rebuilt it, a newer snapshot is fine too
+        if (_current != nullptr && (int32_t) (version - _builtVersion) <= 0)
+            return _current;
+
+        auto next = std::make_shared<T>();
+        fill(*next);
+
+        // If source changed while filling, version stays behind and next Get will rebuild again
+        _current = std::move(next);
+        _builtVersion = version;
+        _builds++;
+
+        return _current;
+    }
+};
@@ -22,6 +22,7 @@
 #define SPDLOG_USE_STD_FORMAT
 #define SPDLOG_WCHAR_FILENAMES
 #include "spdlog/spdlog.h"
+#include "misc/DeferredLog.h"
 
 #define VK_USE_PLATFORM_WIN32_KHR
 
@@ -46,31 +47,53 @@ inline HMODULE vulkanModule = nullptr;
 inline HMODULE d3d11Module = nullptr;
 inline DWORD processId;
 
-#define LOG_TRACE(msg, ...) spdlog::trace(__FUNCTION__ " " msg, ##__VA_ARGS__)
+// Level is checked before the arguments are evaluated, so disabled logs don't cost more than a load
+#define LOG_LEVEL(level, msg, ...)                                                                                     \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (spdlog::should_log(level))                                                                                 \
+            spdlog::log(level, __FUNCTION__ " " msg, ##__VA_ARGS__);                                                   \
+    } while (false)
 
-#define LOG_DEBUG(msg, ...) spdlog::debug(__FUNCTION__ " " msg, ##__VA_ARGS__)
+#define LOG_TRACE(msg, ...) LOG_LEVEL(spdlog::level::trace, msg, ##__VA_ARGS__)
+
+#define LOG_DEBUG(msg, ...) LOG_LEVEL(spdlog::level::debug, msg, ##__VA_ARGS__)
 
 #ifdef DETAILED_DEBUG_LOGS
-#define LOG_DEBUG_ONLY(msg, ...) spdlog::debug(__FUNCTION__ " " msg, ##__VA_ARGS__)
+#define LOG_DEBUG_ONLY(msg, ...) LOG_LEVEL(spdlog::level::debug, msg, ##__VA_ARGS__)
 #else
 #define LOG_DEBUG_ONLY(msg, ...)
 #endif
 
 #ifdef LOG_ASYNC
-#define LOG_DEBUG_ASYNC(msg, ...) spdlog::debug(__FUNCTION__ " " msg, ##__VA_ARGS__)
+#define LOG_DEBUG_ASYNC(msg, ...) LOG_LEVEL(spdlog::level::debug, msg, ##__VA_ARGS__)
 #else
 #define LOG_DEBUG_ASYNC(msg, ...)
 #endif
 
-#define LOG_INFO(msg, ...) spdlog::info(__FUNCTION__ " " msg, ##__VA_ARGS__)
+// For per frame logs, arguments are copied and formatted later by the DeferredLog thread.
+// Only trivially copyable arguments can be used, strings must go through LOG_DEBUG.
+#define LOG_DEBUG_DEFERRED(msg, ...)                                                                                   \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (spdlog::should_log(spdlog::level::debug))                                                                  \
+            DEFERRED_LOG(spdlog::level::debug, spdlog::debug, __FUNCTION__ " " msg, ##__VA_ARGS__);                   \
+    } while (false)
+
+#define LOG_INFO(msg, ...) LOG_LEVEL(spdlog::level::info, msg, ##__VA_ARGS__)
 
-#define LOG_WARN(msg, ...) spdlog::warn(__FUNCTION__ " " msg, ##__VA_ARGS__)
+#define LOG_WARN(msg, ...) LOG_LEVEL(spdlog::level::warn, msg, ##__VA_ARGS__)
 
-#define LOG_ERROR(msg, ...) spdlog::error(__FUNCTION__ " " msg, ##__VA_ARGS__)
+#define LOG_ERROR(msg, ...) LOG_LEVEL(spdlog::level::err, msg, ##__VA_ARGS__)
 
-#define LOG_FUNC() spdlog::trace(__FUNCTION__)
+#define LOG_FUNC()                                                                                                     \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (spdlog::should_log(spdlog::level::trace))                                                                  \
+            spdlog::trace(__FUNCTION__);                                                                               \
+    } while (false)
 
-#define LOG_FUNC_RESULT(result) spdlog::trace(__FUNCTION__ " result: {0:X}", (UINT64) result)
+#define LOG_FUNC_RESULT(result) LOG_LEVEL(spdlog::level::trace, "result: {0:X}", (UINT64) result)
 
 struct feature_version
 {
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+// Sorted interval index for descriptor heap handle ranges.
+//
+// CPU and GPU handles are separate address spaces so each one has its own table. Tables are
+// immutable after they are published, adding a heap builds a new copy and bumps the generation.
+// Readers keep a thread local reference to the last snapshot they have seen and only take the
+// lock when the generation changed, so a lookup is a generation load plus a binary search.
+//
+// The index owns the heaps. A heap whose range is taken over by a new one is removed from both
+// tables and retired with the epoch (present counter) of the replacement. Hooks and stale reader
+// snapshots might still use its pointer for a moment, so it is only freed by Collect() once
+// RetireEpochs more epochs have passed.
+//
+// T must expose cpuStart, cpuEnd, gpuStart and gpuEnd (see HeapInfo).
+template <typename T> class HeapIndex
+{
+  public:
+    static constexpr uint64_t RetireEpochs = 8;
+
+    struct Range
+    {
+        size_t start = 0;
+        size_t end = 0;
+        T* heap = nullptr;
+    };
+
+  private:
+    using Table = std::vector<Range>;
+
+    struct Snapshot
+    {
+        Table cpu;
+        Table gpu;
+    };
+
+    struct ReaderCache
+    {
+        const HeapIndex* owner = nullptr;
+        uint32_t generation = 0;
+        std::shared_ptr<const Snapshot> snapshot;
+        Range lastCpu {};
+        Range lastGpu {};
+    };
+
+    struct Retired
+    {
+        std::unique_ptr<T> heap;
+        uint64_t epoch = 0;
+    };
+
+    mutable std::shared_mutex _mutex;
+    std::shared_ptr<const Snapshot> _current = std::make_shared<const Snapshot>();
+    std::atomic<uint32_t> _generation { 1 };
+
+    // Guarded by _mutex
+    std::vector<std::unique_ptr<T>> _live;
+    std::vector<Retired> _retired;
+
+    static ReaderCache& Local()
+    {
+        static thread_local ReaderCache cache;
+        return cache;
+    }
+
+    ReaderCache& Acquire() const
+    {
+        auto& cache = Local();
+
+        if (cache.owner != this || cache.generation != _generation.load(std::memory_order_acquire))
+        {
+            std::shared_lock<std::shared_mutex> lock(_mutex);
+
+            cache.owner = this;
+            cache.snapshot = _current;
+            cache.generation = _generation.load(std::memory_order_relaxed);
+            cache.lastCpu = {};
+            cache.lastGpu = {};
+        }
+
+        return cache;
+    }
+
+    // Released heaps can have their address range handed out again by the driver,
+    // any range overlapping the new one is stale and gets replaced
+    static void Insert(Table& table, size_t start, size_t end, T* heap, std::vector<T*>& replaced)
+    {
+        if (start >= end)
+            return;
+
+        auto first = std::lower_bound(table.begin(), table.end(), start,
+                                      [](const Range& range, size_t value) { return range.end <= value; });
+        auto last = std::lower_bound(first, table.end(), end,
+                                     [](const Range& range, size_t value) { return range.start < value; });
+
+        for (auto it = first; it != last; ++it)
+            replaced.push_back(it->heap);
+
+        first = table.erase(first, last);
+        table.insert(first, Range { start, end, heap });
+    }
+
+    static void EraseHeap(Table& table, const T* heap)
+    {
+        std::erase_if(table, [heap](const Range& range) { return range.heap == heap; });
+    }
+
+    static const Range* Find(const Table& table, size_t handle)
+    {
+        auto it = std::upper_bound(table.begin(), table.end(), handle,
+                                   [](size_t value, const Range& range) { return value < range.start; });
+
+        if (it == table.begin())
+            return nullptr;
+
+        --it;
+
+        if (handle >= it->end)
+            return nullptr;
+
+        return &(*it);
+    }
+
+  public:
+    // Takes ownership of heap, heaps it replaces are retired at epoch
+    T* Add(std::unique_ptr<T> heap, uint64_t epoch)
+    {
+        std::unique_lock<std::shared_mutex> lock(_mutex);
+
+        auto next = std::make_shared<Snapshot>(*_current);
+        auto added = heap.get();
+        std::vector<T*> replaced;
+
+        Insert(next->cpu, added->cpuStart, added->cpuEnd, added, replaced);
+
+        if (added->gpuStart != 0)
+            Insert(next->gpu, added->gpuStart, added->gpuEnd, added, replaced);
+
+        // A heap which lost one of its ranges is gone, drop the other one too
+        for (auto old : replaced)
+        {
+            EraseHeap(next->cpu, old);
+            EraseHeap(next->gpu, old);
+
+            auto it = std::find_if(_live.begin(), _live.end(), [old](const auto& live) { return live.get() == old; });
+
+            if (it == _live.end())
+                continue;
+
+            _retired.push_back(Retired { std::move(*it), epoch });
+            *it = std::move(_live.back());
+            _live.pop_back();
+        }
+
+        _live.push_back(std::move(heap));
+
+        _current = std::move(next);
+        _generation.fetch_add(1, std::memory_order_release);
+
+        return added;
+    }
+
+    // Frees the heaps retired at least RetireEpochs before epoch, returns how many were freed
+    size_t Collect(uint64_t epoch)
+    {
+        std::vector<std::unique_ptr<T>> expired;
+
+        {
+            std::unique_lock<std::shared_mutex> lock(_mutex);
+
+            if (_retired.empty())
+                return 0;
+
+            std::erase_if(_retired,
+                          [&](Retired& retired)
+                          {
+                              if (retired.epoch + RetireEpochs > epoch)
+                                  return false;
+
+                              expired.push_back(std::move(retired.heap));
+                              return true;
+                          });
+        }
+
+        // Destructors might take other locks, run them outside of ours
+        return expired.size();
+    }
+
+    size_t RetiredCount() const
+    {
+        std::shared_lock<std::shared_mutex> lock(_mutex);
+        return _retired.size();
+    }
+
+    T* FindByCpuHandle(size_t cpuHandle) const
+    {
+        if (cpuHandle == 0)
+            return nullptr;
+
+        auto& cache = Acquire();
+
+        if (cache.lastCpu.start <= cpuHandle && cpuHandle < cache.lastCpu.end)
+            return cache.lastCpu.heap;
+
+        auto range = Find(cache.snapshot->cpu, cpuHandle);
+
+        if (range == nullptr)
+            return nullptr;
+
+        cache.lastCpu = *range;
+        return range->heap;
+    }
+
+    T* FindByGpuHandle(size_t gpuHandle) const
+    {
+        if (gpuHandle == 0)
+            return nullptr;
+
+        auto& cache = Acquire();
+
+        if (cache.lastGpu.start <= gpuHandle && gpuHandle < cache.lastGpu.end)
+            return cache.lastGpu.heap;
+
+        auto range = Find(cache.snapshot->gpu, gpuHandle);
+
+        if (range == nullptr)
+            return nullptr;
+
+        cache.lastGpu = *range;
+        return range->heap;
+    }
+
+    size_t Count() const { return Acquire().snapshot->cpu.size(); }
+};
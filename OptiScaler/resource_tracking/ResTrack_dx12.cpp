@@ -4,6 +4,7 @@
 #include <State.h>
 #include <Util.h>
 
+#include <hooks/SwapchainContext_Dx.h>
 #include <menu/menu_overlay_dx.h>
 
 #include <algorithm>
@@ -101,8 +102,9 @@ static PFN_SetGraphicsRootDescriptorTable o_SetGraphicsRootDescriptorTable = nul
 static PFN_SetComputeRootDescriptorTable o_SetComputeRootDescriptorTable = nullptr;
 
 // heaps
-static std::unique_ptr<HeapInfo> fgHeaps[1000];
-static UINT fgHeapIndex = 0;
+// Replaced HeapInfo objects are retired by the index and freed a few presents later (see EndFrame)
+static HeapIndex<HeapInfo> fgHeapIndex;
+static std::atomic<uint64_t> fgHeapEpoch = 0;
 
 static void* _hudlessCmdList = nullptr;
 static void* _inputsCmdList = nullptr;
@@ -111,29 +113,13 @@ static void* _notFoundInputsCmdList = nullptr;
 static bool _hudlessCmdListFound = false;
 static bool _inputsCmdListFound = false;
 
-struct HeapCacheTLS
-{
-    int index = -1;
-    unsigned genSeen = 0;
-};
-
-static thread_local HeapCacheTLS cache;
-static thread_local HeapCacheTLS cacheRTV;
-static thread_local HeapCacheTLS cacheCBV;
-static thread_local HeapCacheTLS cacheSRV;
-static thread_local HeapCacheTLS cacheUAV;
-static std::atomic<unsigned> gHeapGeneration { 1 };
-
-static thread_local HeapCacheTLS cacheGR;
-static thread_local HeapCacheTLS cacheCR;
-
 bool ResTrack_Dx12::CheckResource(ID3D12Resource* resource)
 {
     if (State::Instance().currentSwapchain == nullptr || State::Instance().isShuttingDown)
         return false;
 
     DXGI_SWAP_CHAIN_DESC scDesc {};
-    if (State::Instance().currentSwapchain->GetDesc(&scDesc) != S_OK)
+    if (!SwapchainContext_Dx::CurrentDesc(&scDesc))
     {
         LOG_WARN("Can't get swapchain desc!");
         return false;
@@ -155,7 +141,6 @@ static ankerl::unordered_dense::map<ID3D12GraphicsCommandList*,
                                     ankerl::unordered_dense::map<ID3D12Resource*, ResourceInfo>>
     fgPossibleHudless[BUFFER_COUNT];
 
-static std::shared_mutex heapMutex;
 static std::mutex hudlessMutex;
 
 inline static IID streamlineRiid {};
@@ -247,233 +232,29 @@ void ResTrack_Dx12::ResourceBarrier(ID3D12GraphicsCommandList* InCommandList, ID
 
 SIZE_T ResTrack_Dx12::GetGPUHandle(ID3D12Device* This, SIZE_T cpuHandle, D3D12_DESCRIPTOR_HEAP_TYPE type)
 {
-    std::shared_lock<std::shared_mutex> lock(heapMutex);
-    for (UINT i = 0; i < fgHeapIndex; i++)
-    {
-        auto val = fgHeaps[i].get();
-        if (val->cpuStart <= cpuHandle && val->cpuEnd >= cpuHandle && val->gpuStart != 0)
-        {
-            auto incSize = This->GetDescriptorHandleIncrementSize(type);
-            auto addr = cpuHandle - val->cpuStart;
-            auto index = addr / incSize;
-            auto gpuAddr = val->gpuStart + (index * incSize);
+    auto heap = fgHeapIndex.FindByCpuHandle(cpuHandle);
 
-            return gpuAddr;
-        }
-    }
+    if (heap == nullptr || heap->gpuStart == 0)
+        return NULL;
 
-    return NULL;
+    auto index = (cpuHandle - heap->cpuStart) / heap->increment;
+    return heap->gpuStart + (index * heap->increment);
 }
 
 SIZE_T ResTrack_Dx12::GetCPUHandle(ID3D12Device* This, SIZE_T gpuHandle, D3D12_DESCRIPTOR_HEAP_TYPE type)
 {
-    std::shared_lock<std::shared_mutex> lock(heapMutex);
-    for (UINT i = 0; i < fgHeapIndex; i++)
-    {
-        auto val = fgHeaps[i].get();
-        if (val->gpuStart <= gpuHandle && val->gpuEnd >= gpuHandle && val->cpuStart != 0)
-        {
-            auto incSize = This->GetDescriptorHandleIncrementSize(type);
-            auto addr = gpuHandle - val->gpuStart;
-            auto index = addr / incSize;
-            auto cpuAddr = val->cpuStart + (index * incSize);
-
-            return cpuAddr;
-        }
-    }
-
-    return NULL;
-}
-
-HeapInfo* ResTrack_Dx12::GetHeapByCpuHandleCBV(SIZE_T cpuHandle)
-{
-    unsigned currentGen = gHeapGeneration.load(std::memory_order_relaxed);
-
-    if (cacheCBV.genSeen == currentGen && cacheCBV.index != -1)
-    {
-        auto heapInfo = fgHeaps[cacheCBV.index].get();
-
-        if (heapInfo->cpuStart <= cpuHandle && cpuHandle < heapInfo->cpuEnd)
-            return heapInfo;
-    }
-
-    for (size_t i = 0; i < fgHeapIndex; i++)
-    {
-        if (fgHeaps[i]->cpuStart <= cpuHandle && fgHeaps[i]->cpuEnd > cpuHandle)
-        {
-            cacheCBV.index = i;
-            cacheCBV.genSeen = currentGen;
-            return fgHeaps[i].get();
-        }
-    }
-
-    return nullptr;
-}
-
-HeapInfo* ResTrack_Dx12::GetHeapByCpuHandleRTV(SIZE_T cpuHandle)
-{
-    unsigned currentGen = gHeapGeneration.load(std::memory_order_relaxed);
-
-    if (cacheRTV.genSeen == currentGen && cacheRTV.index != -1)
-    {
-        auto heapInfo = fgHeaps[cacheRTV.index].get();
-
-        if (heapInfo->cpuStart <= cpuHandle && cpuHandle < heapInfo->cpuEnd)
-            return heapInfo;
-    }
-
-    for (size_t i = 0; i < fgHeapIndex; i++)
-    {
-        if (fgHeaps[i]->cpuStart <= cpuHandle && fgHeaps[i]->cpuEnd > cpuHandle)
-        {
-            cacheRTV.index = i;
-            cacheRTV.genSeen = currentGen;
-            return fgHeaps[i].get();
-        }
-    }
-
-    return nullptr;
-}
-
-HeapInfo* ResTrack_Dx12::GetHeapByCpuHandleSRV(SIZE_T cpuHandle)
-{
-    unsigned currentGen = gHeapGeneration.load(std::memory_order_relaxed);
-
-    if (cacheSRV.genSeen == currentGen && cacheSRV.index != -1)
-    {
-        auto heapInfo = fgHeaps[cacheSRV.index].get();
-
-        if (heapInfo->cpuStart <= cpuHandle && cpuHandle < heapInfo->cpuEnd)
-            return heapInfo;
-    }
-
-    for (size_t i = 0; i < fgHeapIndex; i++)
-    {
-        if (fgHeaps[i]->cpuStart <= cpuHandle && fgHeaps[i]->cpuEnd > cpuHandle)
-        {
-            cacheSRV.index = i;
-            cacheSRV.genSeen = currentGen;
-            return fgHeaps[i].get();
-        }
-    }
-
-    return nullptr;
-}
-
-HeapInfo* ResTrack_Dx12::GetHeapByCpuHandleUAV(SIZE_T cpuHandle)
-{
-    unsigned currentGen = gHeapGeneration.load(std::memory_order_relaxed);
-
-    if (cacheUAV.genSeen == currentGen && cacheUAV.index != -1)
-    {
-        auto heapInfo = fgHeaps[cacheUAV.index].get();
-
-        if (heapInfo->cpuStart <= cpuHandle && cpuHandle < heapInfo->cpuEnd)
-            return heapInfo;
-    }
-
-    for (size_t i = 0; i < fgHeapIndex; i++)
-    {
-        if (fgHeaps[i]->cpuStart <= cpuHandle && fgHeaps[i]->cpuEnd > cpuHandle)
-        {
-            cacheUAV.index = i;
-            cacheUAV.genSeen = currentGen;
-            return fgHeaps[i].get();
-        }
-    }
-
-    return nullptr;
-}
-
-HeapInfo* ResTrack_Dx12::GetHeapByCpuHandle(SIZE_T cpuHandle)
-{
-    unsigned currentGen = gHeapGeneration.load(std::memory_order_relaxed);
-
-    {
-        std::shared_lock<std::shared_mutex> lock(heapMutex);
+    auto heap = fgHeapIndex.FindByGpuHandle(gpuHandle);
 
-        if (cache.genSeen == currentGen && cache.index != -1)
-        {
-            auto heapInfo = fgHeaps[cache.index].get();
-
-            if (heapInfo->cpuStart <= cpuHandle && cpuHandle < heapInfo->cpuEnd)
-                return heapInfo;
-        }
-    }
-
-    for (size_t i = 0; i < fgHeapIndex; i++)
-    {
-        if (fgHeaps[i]->cpuStart <= cpuHandle && fgHeaps[i]->cpuEnd > cpuHandle)
-        {
-            cache.index = i;
-            cache.genSeen = currentGen;
-            return fgHeaps[i].get();
-        }
-    }
+    if (heap == nullptr || heap->cpuStart == 0)
+        return NULL;
 
-    return nullptr;
+    auto index = (gpuHandle - heap->gpuStart) / heap->increment;
+    return heap->cpuStart + (index * heap->increment);
 }
 
-HeapInfo* ResTrack_Dx12::GetHeapByGpuHandleGR(SIZE_T gpuHandle)
-{
-    unsigned currentGen = gHeapGeneration.load(std::memory_order_relaxed);
-
-    {
-        std::shared_lock<std::shared_mutex> lock(heapMutex);
-
-        if (cacheGR.genSeen == currentGen && cacheGR.index != -1)
-        {
-            auto heapInfo = fgHeaps[cacheGR.index].get();
-
-            if (heapInfo->gpuStart <= gpuHandle && gpuHandle < heapInfo->gpuEnd)
-                return heapInfo;
-        }
-    }
-
-    for (size_t i = 0; i < fgHeapIndex; i++)
-    {
-        if (fgHeaps[i]->cpuStart <= gpuHandle && fgHeaps[i]->gpuEnd > gpuHandle)
-        {
-            cacheGR.index = i;
-            cacheGR.genSeen = currentGen;
-            return fgHeaps[i].get();
-        }
-    }
+HeapInfo* ResTrack_Dx12::GetHeapByCpuHandle(SIZE_T cpuHandle) { return fgHeapIndex.FindByCpuHandle(cpuHandle); }
 
-    return nullptr;
-}
-
-HeapInfo* ResTrack_Dx12::GetHeapByGpuHandleCR(SIZE_T gpuHandle)
-{
-    if (gpuHandle == NULL)
-        return nullptr;
-
-    unsigned currentGen = gHeapGeneration.load(std::memory_order_relaxed);
-
-    {
-        std::shared_lock<std::shared_mutex> lock(heapMutex);
-
-        if (cacheCR.genSeen == currentGen && cacheCR.index != -1)
-        {
-            auto heapInfo = fgHeaps[cacheCR.index].get();
-
-            if (heapInfo->gpuStart <= gpuHandle && gpuHandle < heapInfo->gpuEnd)
-                return heapInfo;
-        }
-    }
-
-    for (size_t i = 0; i < fgHeapIndex; i++)
-    {
-        if (fgHeaps[i]->cpuStart <= gpuHandle && fgHeaps[i]->gpuEnd > gpuHandle)
-        {
-            cacheCR.index = i;
-            cacheCR.genSeen = currentGen;
-            return fgHeaps[i].get();
-        }
-    }
-
-    return nullptr;
-}
+HeapInfo* ResTrack_Dx12::GetHeapByGpuHandle(SIZE_T gpuHandle) { return fgHeapIndex.FindByGpuHandle(gpuHandle); }
 
 #pragma endregion
 
@@ -556,7 +337,7 @@ void ResTrack_Dx12::hkCreateRenderTargetView(ID3D12Device* This, ID3D12Resource*
         !CheckResource(pResource))
     {
 
-        auto heap = GetHeapByCpuHandleSRV(DestDescriptor.ptr);
+        auto heap = GetHeapByCpuHandle(DestDescriptor.ptr);
 
         if (heap != nullptr)
             heap->ClearByCpuHandle(DestDescriptor.ptr);
@@ -577,7 +358,7 @@ void ResTrack_Dx12::hkCreateRenderTargetView(ID3D12Device* This, ID3D12Resource*
     FillResourceInfo(pResource, &resInfo);
     resInfo.type = RTV;
 
-    auto heap = GetHeapByCpuHandleRTV(DestDescriptor.ptr);
+    auto heap = GetHeapByCpuHandle(DestDescriptor.ptr);
     if (heap != nullptr)
         heap->SetByCpuHandle(DestDescriptor.ptr, resInfo);
 }
@@ -609,7 +390,7 @@ void ResTrack_Dx12::hkCreateShaderResourceView(ID3D12Device* This, ID3D12Resourc
         !CheckResource(pResource))
     {
 
-        auto heap = GetHeapByCpuHandleSRV(DestDescriptor.ptr);
+        auto heap = GetHeapByCpuHandle(DestDescriptor.ptr);
 
         if (heap != nullptr)
             heap->ClearByCpuHandle(DestDescriptor.ptr);
@@ -630,7 +411,7 @@ void ResTrack_Dx12::hkCreateShaderResourceView(ID3D12Device* This, ID3D12Resourc
     FillResourceInfo(pResource, &resInfo);
     resInfo.type = SRV;
 
-    auto heap = GetHeapByCpuHandleSRV(DestDescriptor.ptr);
+    auto heap = GetHeapByCpuHandle(DestDescriptor.ptr);
     if (heap != nullptr)
         heap->SetByCpuHandle(DestDescriptor.ptr, resInfo);
 }
@@ -661,7 +442,7 @@ void ResTrack_Dx12::hkCreateUnorderedAccessView(ID3D12Device* This, ID3D12Resour
     if (pResource == nullptr || pDesc == nullptr || pDesc->ViewDimension != D3D12_SRV_DIMENSION_TEXTURE2D ||
         !CheckResource(pResource))
     {
-        auto heap = GetHeapByCpuHandleSRV(DestDescriptor.ptr);
+        auto heap = GetHeapByCpuHandle(DestDescriptor.ptr);
 
         if (heap != nullptr)
             heap->ClearByCpuHandle(DestDescriptor.ptr);
@@ -679,7 +460,7 @@ void ResTrack_Dx12::hkCreateUnorderedAccessView(ID3D12Device* This, ID3D12Resour
     FillResourceInfo(pResource, &resInfo);
     resInfo.type = UAV;
 
-    auto heap = GetHeapByCpuHandleUAV(DestDescriptor.ptr);
+    auto heap = GetHeapByCpuHandle(DestDescriptor.ptr);
     if (heap != nullptr)
         heap->SetByCpuHandle(DestDescriptor.ptr, resInfo);
 }
@@ -821,13 +602,10 @@ HRESULT ResTrack_Dx12::hkCreateDescriptorHeap(ID3D12Device* This, D3D12_DESCRIPT
 
         LOG_TRACE("Heap: {:X}, Heap type: {}, Cpu: {}-{}, Gpu: {}-{}, Desc count: {}", (size_t) *ppvHeap, type,
                   cpuStart, cpuEnd, gpuStart, gpuEnd, numDescriptors);
-        {
-            std::unique_lock<std::shared_mutex> lock(heapMutex);
-            fgHeaps[fgHeapIndex] = std::make_unique<HeapInfo>(heap, cpuStart, cpuEnd, gpuStart, gpuEnd, numDescriptors,
-                                                              increment, type, fgHeapIndex);
-            fgHeapIndex++;
-            gHeapGeneration.fetch_add(1, std::memory_order_relaxed);
-        }
+
+        auto heapInfo =
+            std::make_unique<HeapInfo>(heap, cpuStart, cpuEnd, gpuStart, gpuEnd, numDescriptors, increment, type);
+        fgHeapIndex.Add(std::move(heapInfo), fgHeapEpoch.load(std::memory_order_relaxed));
     }
     else
     {
@@ -847,31 +625,28 @@ ULONG ResTrack_Dx12::hkRelease(ID3D12Resource* This)
     if (State::Instance().isShuttingDown)
         return o_Release(This);
 
-    _trMutex.lock();
-
     This->AddRef();
-    if (o_Release(This) <= 1 && _trackedResources.contains(This))
+    if (o_Release(This) <= 1)
     {
-        auto vector = &_trackedResources[This];
-
-        LOG_TRACK("Resource: {:X}, Heaps: {}", (size_t) This, vector->size());
-
-        for (size_t i = 0; i < vector->size(); i++)
+        auto clearSlot = [This](ResourceInfo* info)
         {
             // Be sure something else is not using this heap
-            if (vector->at(i)->buffer == This)
+            if (info->buffer == This)
             {
-                LOG_TRACK("  Resource: {:X}, Clearing: {:X}", (size_t) This, (size_t) vector->at(i));
-                vector->at(i)->buffer = nullptr;
-                vector->at(i)->lastUsedFrame = 0;
+                LOG_TRACK("  Resource: {:X}, Clearing: {:X}", (size_t) This, (size_t) info);
+                info->buffer = nullptr;
+                info->lastUsedFrame = 0;
             }
-        }
+        };
 
-        State::Instance().CapturedHudlesses.erase(This);
-        _trackedResources.erase(This);
-    }
+        if (_trackedResources.Release(This, clearSlot))
+        {
+            LOG_TRACK("Resource: {:X}", (size_t) This);
 
-    _trMutex.unlock();
+            std::lock_guard<std::mutex> lock(State::Instance().CapturedHudlessesMutex);
+            State::Instance().CapturedHudlesses.erase(This);
+        }
+    }
 
     return o_Release(This);
 }
@@ -1193,7 +968,7 @@ void ResTrack_Dx12::hkSetGraphicsRootDescriptorTable(ID3D12GraphicsCommandList*
         return;
     }
 
-    auto heap = GetHeapByGpuHandleGR(BaseDescriptor.ptr);
+    auto heap = GetHeapByGpuHandle(BaseDescriptor.ptr);
     if (heap == nullptr)
     {
         LOG_DEBUG_ONLY("No heap!");
@@ -1278,7 +1053,7 @@ void ResTrack_Dx12::hkOMSetRenderTargets(ID3D12GraphicsCommandList* This, UINT N
 
             if (RTsSingleHandleToDescriptorRange)
             {
-                heap = GetHeapByCpuHandleRTV(pRenderTargetDescriptors[0].ptr);
+                heap = GetHeapByCpuHandle(pRenderTargetDescriptors[0].ptr);
                 if (heap == nullptr)
                 {
                     LOG_DEBUG_ONLY("No heap!");
@@ -1291,7 +1066,7 @@ void ResTrack_Dx12::hkOMSetRenderTargets(ID3D12GraphicsCommandList* This, UINT N
             {
                 handle = pRenderTargetDescriptors[i];
 
-                heap = GetHeapByCpuHandleRTV(handle.ptr);
+                heap = GetHeapByCpuHandle(handle.ptr);
                 if (heap == nullptr)
                 {
                     LOG_DEBUG_ONLY("No heap!");
@@ -1363,7 +1138,7 @@ void ResTrack_Dx12::hkSetComputeRootDescriptorTable(ID3D12GraphicsCommandList* T
         return;
     }
 
-    auto heap = GetHeapByGpuHandleCR(BaseDescriptor.ptr);
+    auto heap = GetHeapByGpuHandle(BaseDescriptor.ptr);
     if (heap == nullptr)
     {
         LOG_DEBUG_ONLY("No heap!");
@@ -1944,6 +1719,15 @@ void ResTrack_Dx12::ClearPossibleHudless()
     _hudlessCmdListFound = false;
 }
 
+void ResTrack_Dx12::EndFrame()
+{
+    auto epoch = fgHeapEpoch.fetch_add(1, std::memory_order_relaxed) + 1;
+    auto freed = fgHeapIndex.Collect(epoch);
+
+    if (freed > 0)
+        LOG_DEBUG("Freed {} replaced heaps, {} waiting", freed, fgHeapIndex.RetiredCount());
+}
+
 void ResTrack_Dx12::SetInputsCmdList(ID3D12GraphicsCommandList* cmdList)
 {
     auto fg = State::Instance().currentFG;
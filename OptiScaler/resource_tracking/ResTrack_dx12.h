@@ -4,6 +4,9 @@
 
 #include <hudfix/Hudfix_Dx12.h>
 
+#include "HeapIndex.h"
+#include "ResourceIndex.h"
+
 #include <ankerl/unordered_dense.h>
 
 // Test resources if they are valid or not
@@ -31,9 +34,10 @@ static void TestResource(ResourceInfo* info)
 }
 #endif
 
-static ankerl::unordered_dense::map<ID3D12Resource*, std::vector<ResourceInfo*>> _trackedResources;
-static std::mutex _trMutex;
-static std::shared_mutex _heapMutex[1000];
+using TrackedResources = ResourceIndex<ID3D12Resource, ResourceInfo>;
+
+// resource -> descriptor slots, used to clear slots when a resource is released
+inline TrackedResources _trackedResources;
 
 typedef struct HeapInfo
 {
@@ -46,20 +50,32 @@ typedef struct HeapInfo
     UINT increment = 0;
     UINT type = 0;
     std::shared_ptr<ResourceInfo[]> info;
+    std::shared_ptr<TrackedResources::Node[]> nodes;
     UINT lastOffset = 0;
-    UINT mutexIndex = 0;
 
     HeapInfo(ID3D12DescriptorHeap* heap, SIZE_T cpuStart, SIZE_T cpuEnd, SIZE_T gpuStart, SIZE_T gpuEnd,
-             UINT numResources, UINT increment, UINT type, UINT mutexIndex)
+             UINT numResources, UINT increment, UINT type)
         : cpuStart(cpuStart), cpuEnd(cpuEnd), gpuStart(gpuStart), gpuEnd(gpuEnd), numDescriptors(numResources),
-          increment(increment), info(new ResourceInfo[numResources]), type(type), heap(heap), mutexIndex(mutexIndex)
+          increment(increment), info(new ResourceInfo[numResources]),
+          nodes(new TrackedResources::Node[numResources]), type(type), heap(heap)
     {
         for (size_t i = 0; i < numDescriptors; i++)
         {
             info[i].buffer = nullptr;
+            nodes[i].info = &info[i];
         }
     }
 
+    // Retired heaps are freed a few frames after they were replaced, their slots must leave the reverse index
+    ~HeapInfo()
+    {
+        for (size_t i = 0; i < numDescriptors; i++)
+            _trackedResources.Unlink(&nodes[i]);
+    }
+
+    HeapInfo(const HeapInfo&) = delete;
+    HeapInfo& operator=(const HeapInfo&) = delete;
+
     ResourceInfo* GetByCpuHandle(SIZE_T cpuHandle) const
     {
         auto index = (cpuHandle - cpuStart) / increment;
@@ -100,125 +116,47 @@ typedef struct HeapInfo
 
     void SetByCpuHandle(SIZE_T cpuHandle, ResourceInfo setInfo) const
     {
-        auto index = (cpuHandle - cpuStart) / increment;
-
-        if (index >= numDescriptors)
-            return;
-
-#ifdef DEBUG_TRACKING
-        TestResource(&setInfo);
-#endif
-
-        info[index] = setInfo;
-
-        {
-            _trMutex.lock();
-
-            if (_trackedResources.contains(setInfo.buffer))
-                _trackedResources[setInfo.buffer].push_back(&info[index]);
-            else
-                _trackedResources[setInfo.buffer] = { &info[index] };
-
-            LOG_TRACK("Add resource: {:X} to info: {:X}, Res: {}x{}", (size_t) setInfo.buffer, (size_t) &info[index],
-                      setInfo.width, setInfo.height);
-
-            _trMutex.unlock();
-        }
+        SetByIndex((cpuHandle - cpuStart) / increment, setInfo);
     }
 
     void SetByGpuHandle(SIZE_T gpuHandle, ResourceInfo setInfo) const
     {
-        auto index = (gpuHandle - gpuStart) / increment;
-
-        if (index >= numDescriptors)
-            return;
-
-#ifdef DEBUG_TRACKING
-        TestResource(&setInfo);
-#endif
-
-        info[index] = setInfo;
-
-        {
-            _trMutex.lock();
-
-            if (_trackedResources.contains(setInfo.buffer))
-                _trackedResources[setInfo.buffer].push_back(&info[index]);
-            else
-                _trackedResources[setInfo.buffer] = { &info[index] };
+        SetByIndex((gpuHandle - gpuStart) / increment, setInfo);
+    }
 
-            LOG_TRACK("Add resource: {:X} to info: {:X}, Res: {}x{}", (size_t) setInfo.buffer, (size_t) &info[index],
-                      setInfo.width, setInfo.height);
+    void ClearByCpuHandle(SIZE_T cpuHandle) const { ClearByIndex((cpuHandle - cpuStart) / increment); }
 
-            _trMutex.unlock();
-        }
-    }
+    void ClearByGpuHandle(SIZE_T gpuHandle) const { ClearByIndex((gpuHandle - gpuStart) / increment); }
 
-    void ClearByCpuHandle(SIZE_T cpuHandle) const
+  private:
+    void SetByIndex(SIZE_T index, ResourceInfo& setInfo) const
     {
-        auto index = (cpuHandle - cpuStart) / increment;
-
         if (index >= numDescriptors)
             return;
 
-        _trMutex.lock();
-
-        if (info[index].buffer != nullptr)
-        {
-            LOG_TRACK("Resource: {:X}, Res: {}x{}", (size_t) info[index].buffer, info[index].width, info[index].height);
-
-            if (_trackedResources.contains(info[index].buffer))
-            {
-                auto vector = &_trackedResources[info[index].buffer];
-
-                for (size_t i = 0; i < vector->size(); i++)
-                {
-                    if (vector->at(i) == &info[index])
-                    {
-                        LOG_TRACK("Erase from _trackedResources info: {:X}", (size_t) vector->at(i));
-                        vector->erase(vector->begin() + i);
-                        break;
-                    }
-                }
-            }
-        }
+#ifdef DEBUG_TRACKING
+        TestResource(&setInfo);
+#endif
 
-        _trMutex.unlock();
+        // Written under the lock Release clears the slot with, a release of the previous resource
+        // running meanwhile can't wipe the new descriptor
+        _trackedResources.Link(&nodes[index], setInfo.buffer, [&] { info[index] = setInfo; });
 
-        info[index].buffer = nullptr;
-        info[index].lastUsedFrame = 0;
+        LOG_TRACK("Add resource: {:X} to info: {:X}, Res: {}x{}", (size_t) setInfo.buffer, (size_t) &info[index],
+                  setInfo.width, setInfo.height);
     }
 
-    void ClearByGpuHandle(SIZE_T gpuHandle) const
+    void ClearByIndex(SIZE_T index) const
     {
-        auto index = (gpuHandle - gpuStart) / increment;
-
         if (index >= numDescriptors)
             return;
 
-        _trMutex.lock();
-
         if (info[index].buffer != nullptr)
         {
             LOG_TRACK("Resource: {:X}, Res: {}x{}", (size_t) info[index].buffer, info[index].width, info[index].height);
-
-            if (_trackedResources.contains(info[index].buffer))
-            {
-                auto vector = &_trackedResources[info[index].buffer];
-
-                for (size_t i = 0; i < vector->size(); i++)
-                {
-                    if (vector->at(i) == &info[index])
-                    {
-                        LOG_TRACK("Erase from _trackedResources info: {:X}", (size_t) vector->at(i));
-                        vector->erase(vector->begin() + i);
-                        break;
-                    }
-                }
-            }
         }
 
-        _trMutex.unlock();
+        _trackedResources.Unlink(&nodes[index]);
 
         info[index].buffer = nullptr;
         info[index].lastUsedFrame = 0;
@@ -313,19 +251,15 @@ class ResTrack_Dx12
     static SIZE_T GetGPUHandle(ID3D12Device* This, SIZE_T cpuHandle, D3D12_DESCRIPTOR_HEAP_TYPE type);
     static SIZE_T GetCPUHandle(ID3D12Device* This, SIZE_T gpuHandle, D3D12_DESCRIPTOR_HEAP_TYPE type);
 
-    static HeapInfo* GetHeapByCpuHandleCBV(SIZE_T cpuHandle);
-    static HeapInfo* GetHeapByCpuHandleRTV(SIZE_T cpuHandle);
-    static HeapInfo* GetHeapByCpuHandleSRV(SIZE_T cpuHandle);
-    static HeapInfo* GetHeapByCpuHandleUAV(SIZE_T cpuHandle);
     static HeapInfo* GetHeapByCpuHandle(SIZE_T cpuHandle);
-    static HeapInfo* GetHeapByGpuHandleGR(SIZE_T gpuHandle);
-    static HeapInfo* GetHeapByGpuHandleCR(SIZE_T gpuHandle);
+    static HeapInfo* GetHeapByGpuHandle(SIZE_T gpuHandle);
 
     static void FillResourceInfo(ID3D12Resource* resource, ResourceInfo* info);
 
   public:
     static void HookDevice(ID3D12Device* device);
     static void ClearPossibleHudless();
+    static void EndFrame();
     static void SetInputsCmdList(ID3D12GraphicsCommandList* cmdList);
     static void SetHudlessCmdList(ID3D12GraphicsCommandList* cmdList);
     static void ExecuteWaitingCommandLists();
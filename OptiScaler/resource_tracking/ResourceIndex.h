@@ -0,0 +1,156 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include <ankerl/unordered_dense.h>
+
+// Reverse index from a resource to the descriptor slots which are pointing to it.
+//
+// Every descriptor slot owns one Node (kept next to the slot in HeapInfo), nodes of the same resource
+// are chained in an intrusive doubly linked list. Linking and unlinking a slot is O(1) and only locks
+// the shard of the resource, so view creation on different threads rarely touches the same lock.
+template <typename TResource, typename TInfo> class ResourceIndex
+{
+  public:
+    struct Node
+    {
+        TInfo* info = nullptr;
+        std::atomic<TResource*> owner = nullptr;
+        Node* prev = nullptr;
+        Node* next = nullptr;
+    };
+
+  private:
+    static constexpr size_t ShardBits = 6;
+    static constexpr size_t ShardCount = 1ull << ShardBits;
+
+    struct alignas(64) Shard
+    {
+        std::mutex mutex;
+        ankerl::unordered_dense::map<TResource*, Node*> heads;
+    };
+
+    Shard _shards[ShardCount];
+
+    Shard& ShardOf(TResource* resource)
+    {
+        auto value = (uint64_t) (uintptr_t) resource;
+        value ^= value >> 17;
+        value *= 0x9E3779B97F4A7C15ull;
+        return _shards[value >> (64 - ShardBits)];
+    }
+
+    // Caller must hold the shard lock of node->owner
+    static void Remove(Shard& shard, TResource* owner, Node* node)
+    {
+        if (node->prev != nullptr)
+        {
+            node->prev->next = node->next;
+        }
+        else
+        {
+            if (node->next != nullptr)
+                shard.heads[owner] = node->next;
+            else
+                shard.heads.erase(owner);
+        }
+
+        if (node->next != nullptr)
+            node->next->prev = node->prev;
+
+        node->prev = nullptr;
+        node->next = nullptr;
+        node->owner.store(nullptr, std::memory_order_relaxed);
+    }
+
+  public:
+    // Moves node to the list of resource, removes it from its previous owner first. update writes the
+    // slot and runs under the shard lock of resource, so Release of the resource sees either the old
+    // slot or the new one linked. Release of the previous owner can't reach the node after Unlink.
+    template <typename F> void Link(Node* node, TResource* resource, F&& update)
+    {
+        Unlink(node);
+
+        if (resource == nullptr)
+        {
+            update();
+            return;
+        }
+
+        auto& shard = ShardOf(resource);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        update();
+
+        auto& head = shard.heads[resource];
+
+        node->prev = nullptr;
+        node->next = head;
+
+        if (head != nullptr)
+            head->prev = node;
+
+        head = node;
+        node->owner.store(resource, std::memory_order_relaxed);
+    }
+
+    void Link(Node* node, TResource* resource) { Link(node, resource, [] {}); }
+
+    void Unlink(Node* node)
+    {
+        auto owner = node->owner.load(std::memory_order_relaxed);
+
+        if (owner == nullptr)
+            return;
+
+        auto& shard = ShardOf(owner);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        // Might be released or moved by another thread while we were waiting for the lock
+        if (node->owner.load(std::memory_order_relaxed) != owner)
+            return;
+
+        Remove(shard, owner, node);
+    }
+
+    // Drops every node of resource, callback is called for each slot while the shard is locked.
+    // Returns false when resource was not tracked.
+    template <typename F> bool Release(TResource* resource, F&& callback)
+    {
+        auto& shard = ShardOf(resource);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.heads.find(resource);
+
+        if (it == shard.heads.end())
+            return false;
+
+        auto node = it->second;
+        shard.heads.erase(it);
+
+        while (node != nullptr)
+        {
+            auto next = node->next;
+
+            callback(node->info);
+
+            node->prev = nullptr;
+            node->next = nullptr;
+            node->owner.store(nullptr, std::memory_order_relaxed);
+
+            node = next;
+        }
+
+        return true;
+    }
+
+    bool Contains(TResource* resource)
+    {
+        auto& shard = ShardOf(resource);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.heads.contains(resource);
+    }
+};
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace scanner
+{
+// Pattern results of scanned modules, api independent.
+//
+// Entries are grouped by module identity (hash of the module path) and tagged with the build key
+// of the module (PE header and file attributes). When a module shows up with a different build,
+// every entry of it is dropped, so patterns which were not found in the old build are scanned
+// again and the file doesn't keep results of builds which are gone. Result rva 0 means pattern was
+// not found.
+//
+// Lines: <module id> <build key> <pattern hash> <start rva> <result rva>, anything else is skipped.
+class ScanCache
+{
+  public:
+    static uint64_t Hash(std::string_view text)
+    {
+        uint64_t hash = 14695981039346656037ull;
+
+        for (auto c : text)
+        {
+            hash ^= (uint8_t) c;
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    // Returns false when there is no entry for the current build of the module
+    bool Find(const std::string& moduleId, const std::string& build, uint64_t patternHash, uint64_t startRva,
+              uint64_t* resultRva)
+    {
+        auto module = _modules.find(moduleId);
+
+        if (module == _modules.end())
+            return false;
+
+        if (module->second.build != build)
+        {
+            Evict(module);
+            return false;
+        }
+
+        auto entry = module->second.results.find({ patternHash, startRva });
+
+        if (entry == module->second.results.end())
+            return false;
+
+        *resultRva = entry->second;
+        return true;
+    }
+
+    void Store(const std::string& moduleId, const std::string& build, uint64_t patternHash, uint64_t startRva,
+               uint64_t resultRva)
+    {
+        auto& module = _modules[moduleId];
+
+        if (module.build != build)
+        {
+            _evicted += module.results.size();
+            module.results.clear();
+            module.build = build;
+        }
+
+        auto [entry, inserted] = module.results.try_emplace({ patternHash, startRva }, resultRva);
+
+        if (!inserted && entry->second == resultRva)
+            return;
+
+        entry->second = resultRva;
+        _dirty = true;
+    }
+
+    void Load(std::istream& input)
+    {
+        std::string line;
+
+        while (std::getline(input, line))
+        {
+            std::istringstream fields(line);
+            std::string moduleId, build;
+            uint64_t patternHash, startRva, resultRva;
+            std::string extra;
+
+            if (!(fields >> moduleId >> build >> std::hex >> patternHash >> startRva >> resultRva) || (fields >> extra))
+                continue;
+
+            auto& module = _modules[moduleId];
+
+            // Last build written wins, older lines of the same module are stale
+            if (module.build != build)
+            {
+                module.results.clear();
+                module.build = build;
+            }
+
+            module.results[{ patternHash, startRva }] = resultRva;
+        }
+    }
+
+    void Save(std::ostream& output)
+    {
+        output << std::hex;
+
+        for (const auto& [moduleId, module] : _modules)
+        {
+            for (const auto& [key, resultRva] : module.results)
+                output << moduleId << " " << module.build << " " << key.first << " " << key.second << " " << resultRva
+                       << "\n";
+        }
+
+        output << std::dec;
+        _dirty = false;
+    }
+
+    bool Dirty() const { return _dirty; }
+
+    // Number of entries dropped because their module was updated
+    size_t Evicted() const { return _evicted; }
+
+    size_t Size() const
+    {
+        size_t size = 0;
+
+        for (const auto& module : _modules)
+            size += module.second.results.size();
+
+        return size;
+    }
+
+  private:
+    struct Module
+    {
+        std::string build;
+        std::map<std::pair<uint64_t, uint64_t>, uint64_t> results;
+    };
+
+    std::map<std::string, Module> _modules;
+    size_t _evicted = 0;
+    bool _dirty = false;
+
+    void Evict(std::map<std::string, Module>::iterator module)
+    {
+        _evicted += module->second.results.size();
+        _modules.erase(module);
+        _dirty = true;
+    }
+};
+} // namespace scanner
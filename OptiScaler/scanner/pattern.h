@@ -0,0 +1,289 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define SCANNER_SSE2
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace scanner
+{
+// IDA style pattern ("48 8B ? ? 89"), parsed once and reused for every scanned range
+struct CompiledPattern
+{
+    std::vector<uint8_t> bytes;
+    std::vector<uint8_t> fixed;
+
+    // Index of the fixed byte which is used to find candidates, rarest one in x64 code
+    size_t anchor = 0;
+
+    bool Compile(std::string_view pattern)
+    {
+        bytes.clear();
+        fixed.clear();
+
+        for (size_t i = 0; i < pattern.size();)
+        {
+            if (pattern[i] == ' ')
+            {
+                i++;
+                continue;
+            }
+
+            if (pattern[i] == '?')
+            {
+                bytes.push_back(0);
+                fixed.push_back(0);
+
+                while (i < pattern.size() && pattern[i] == '?')
+                    i++;
+
+                continue;
+            }
+
+            if (i + 1 >= pattern.size())
+                return false;
+
+            char hex[3] = { pattern[i], pattern[i + 1], 0 };
+            char* end = nullptr;
+            auto value = strtoul(hex, &end, 16);
+
+            if (end != hex + 2)
+                return false;
+
+            bytes.push_back((uint8_t) value);
+            fixed.push_back(1);
+            i += 2;
+        }
+
+        return SelectAnchor();
+    }
+
+    bool Matches(const uint8_t* data) const
+    {
+        for (size_t i = 0; i < bytes.size(); i++)
+        {
+            if (fixed[i] && data[i] != bytes[i])
+                return false;
+        }
+
+        return true;
+    }
+
+    size_t Size() const { return bytes.size(); }
+
+  private:
+    static int Commonness(uint8_t value)
+    {
+        switch (value)
+        {
+        case 0x00:
+        case 0xFF:
+        case 0xCC:
+            return 3;
+
+        case 0x48:
+        case 0x8B:
+        case 0x89:
+        case 0x4C:
+        case 0x8D:
+        case 0x24:
+        case 0x83:
+        case 0x44:
+        case 0x41:
+        case 0x0F:
+            return 2;
+
+        case 0xE8:
+        case 0x85:
+        case 0xC0:
+        case 0x74:
+        case 0x75:
+        case 0x20:
+        case 0x01:
+        case 0x33:
+        case 0xC3:
+            return 1;
+
+        default:
+            return 0;
+        }
+    }
+
+    bool SelectAnchor()
+    {
+        int best = -1;
+
+        for (size_t i = 0; i < bytes.size(); i++)
+        {
+            if (!fixed[i])
+                continue;
+
+            auto score = Commonness(bytes[i]);
+
+            if (best == -1 || score < best)
+            {
+                best = score;
+                anchor = i;
+            }
+        }
+
+        // Patterns without any fixed byte would match everywhere
+        return best != -1;
+    }
+};
+
+struct ScanJob
+{
+    const CompiledPattern* pattern = nullptr;
+
+    // Matches starting before this address are ignored
+    const uint8_t* minStart = nullptr;
+
+    // First match, stays nullptr when nothing is found
+    const uint8_t* found = nullptr;
+};
+
+// Scans the part of [rangeBegin, rangeEnd) where a match can start inside [chunkBegin, chunkEnd)
+// for all jobs in a single pass. Candidates are found by comparing 16 bytes at once against the
+// anchor bytes of the patterns, full comparison is only done at those positions. Chunks can be
+// scanned in parallel, matches are only reported for the chunk they start in.
+inline void ScanRange(const uint8_t* rangeBegin, const uint8_t* rangeEnd, const uint8_t* chunkBegin,
+                      const uint8_t* chunkEnd, std::span<ScanJob> jobs)
+{
+    constexpr size_t MaxAnchors = 16;
+
+    uint8_t anchors[MaxAnchors];
+    size_t anchorCount = 0;
+    size_t maxAnchorOffset = 0;
+    size_t remaining = 0;
+    bool filter = true;
+
+    for (auto& job : jobs)
+    {
+        if (job.found != nullptr || job.pattern == nullptr || job.pattern->Size() == 0)
+            continue;
+
+        remaining++;
+
+        auto value = job.pattern->bytes[job.pattern->anchor];
+        bool known = false;
+
+        for (size_t i = 0; i < anchorCount; i++)
+        {
+            if (anchors[i] == value)
+            {
+                known = true;
+                break;
+            }
+        }
+
+        // More distinct anchors than we can filter with, fall back to checking every position
+        if (!known)
+        {
+            if (anchorCount < MaxAnchors)
+                anchors[anchorCount++] = value;
+            else
+                filter = false;
+        }
+
+        if (job.pattern->anchor > maxAnchorOffset)
+            maxAnchorOffset = job.pattern->anchor;
+    }
+
+    if (remaining == 0)
+        return;
+
+    auto checkCandidate = [&](const uint8_t* position)
+    {
+        for (auto& job : jobs)
+        {
+            if (job.found != nullptr || job.pattern == nullptr || job.pattern->Size() == 0)
+                continue;
+
+            auto pattern = job.pattern;
+
+            if (filter && *position != pattern->bytes[pattern->anchor])
+                continue;
+
+            if ((size_t) (position - rangeBegin) < pattern->anchor)
+                continue;
+
+            auto start = position - pattern->anchor;
+
+            if (start < chunkBegin || start >= chunkEnd || start < job.minStart ||
+                (size_t) (rangeEnd - start) < pattern->Size())
+                continue;
+
+            if (pattern->Matches(start))
+            {
+                job.found = start;
+                remaining--;
+            }
+        }
+    };
+
+    auto scanEnd = chunkEnd + maxAnchorOffset;
+    if (scanEnd > rangeEnd || scanEnd < chunkEnd)
+        scanEnd = rangeEnd;
+
+    auto position = chunkBegin;
+
+    if (!filter)
+    {
+        for (; position < scanEnd && remaining > 0; position++)
+            checkCandidate(position);
+
+        return;
+    }
+
+#ifdef SCANNER_SSE2
+    __m128i anchorVectors[MaxAnchors];
+    for (size_t i = 0; i < anchorCount; i++)
+        anchorVectors[i] = _mm_set1_epi8((char) anchors[i]);
+
+    for (; scanEnd - position >= 16 && remaining > 0; position += 16)
+    {
+        auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(position));
+        unsigned bits = 0;
+
+        for (size_t i = 0; i < anchorCount; i++)
+            bits |= (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(block, anchorVectors[i]));
+
+        while (bits != 0 && remaining > 0)
+        {
+#ifdef _MSC_VER
+            unsigned long index;
+            _BitScanForward(&index, bits);
+#else
+            unsigned index = (unsigned) __builtin_ctz(bits);
+#endif
+            checkCandidate(position + index);
+            bits &= bits - 1;
+        }
+    }
+#endif
+
+    for (; position < scanEnd && remaining > 0; position++)
+    {
+        for (size_t i = 0; i < anchorCount; i++)
+        {
+            if (*position == anchors[i])
+            {
+                checkCandidate(position);
+                break;
+            }
+        }
+    }
+}
+} // namespace scanner
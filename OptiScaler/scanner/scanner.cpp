@@ -1,7 +1,14 @@
 #include "scanner.h"
+#include "pattern.h"
+#include "ScanCache.h"
+
+#include <Util.h>
 
 #include <proxies/KernelBase_Proxy.h>
 
+#include <fstream>
+#include <mutex>
+
 struct SectionRange
 {
     BYTE *start, *end;
@@ -35,141 +42,267 @@ std::vector<SectionRange> GetExecSections(HMODULE hMod)
     return secs;
 }
 
-uintptr_t FindPattern(uintptr_t startAddress, uintptr_t maxSize, const char* mask)
+#pragma region Result cache
+
+static std::mutex cacheMutex;
+static bool cacheLoaded = false;
+static bool saveScheduled = false;
+static scanner::ScanCache cache;
+
+static std::filesystem::path CachePath() { return Util::DllPath().parent_path() / L"OptiScaler.scancache"; }
+
+// Same file can be loaded under different names, identity is the lower case path
+static std::string ModuleId(HMODULE module)
 {
-    std::vector<std::pair<uint8_t, bool>> pattern;
+    wchar_t modulePath[MAX_PATH];
+    auto length = GetModuleFileNameW(module, modulePath, MAX_PATH);
+
+    std::string path;
+    path.reserve(length);
 
-    for (size_t i = 0; i < strlen(mask);)
+    for (DWORD i = 0; i < length; i++)
     {
-        if (mask[i] != '?')
-        {
-            pattern.emplace_back(static_cast<uint8_t>(strtoul(&mask[i], nullptr, 16)), false);
-            i += 3;
-        }
-        else
+        auto c = modulePath[i];
+        path.push_back((char) ((c >= L'A' && c <= L'Z') ? c + 32 : c));
+    }
+
+    return std::format("{:016X}", scanner::ScanCache::Hash(path));
+}
+
+// A new build of the module gets a new key
+static std::string ModuleBuild(HMODULE module)
+{
+    BYTE* base = reinterpret_cast<BYTE*>(module);
+    auto dos = reinterpret_cast<IMAGE_DOS_HEADER*>(base);
+    auto nt = reinterpret_cast<IMAGE_NT_HEADERS64*>(base + dos->e_lfanew);
+
+    uint64_t fileSize = 0;
+    uint64_t writeTime = 0;
+
+    wchar_t modulePath[MAX_PATH];
+    if (GetModuleFileNameW(module, modulePath, MAX_PATH) != 0)
+    {
+        WIN32_FILE_ATTRIBUTE_DATA attributes {};
+
+        if (GetFileAttributesExW(modulePath, GetFileExInfoStandard, &attributes))
         {
-            pattern.emplace_back(0x00, true);
-            i += 2;
+            fileSize = ((uint64_t) attributes.nFileSizeHigh << 32) | attributes.nFileSizeLow;
+            writeTime = ((uint64_t) attributes.ftLastWriteTime.dwHighDateTime << 32) |
+                        attributes.ftLastWriteTime.dwLowDateTime;
         }
     }
 
-    const auto dataStart = reinterpret_cast<const uint8_t*>(startAddress);
-    const auto dataEnd = dataStart + maxSize + 1;
+    return std::format("{:08X}{:08X}{:08X}{:X}{:X}", nt->FileHeader.TimeDateStamp, nt->OptionalHeader.SizeOfImage,
+                       nt->OptionalHeader.CheckSum, fileSize, writeTime);
+}
+
+// Caller must hold cacheMutex
+static void LoadCache()
+{
+    if (cacheLoaded)
+        return;
 
-    auto sig = std::search(dataStart, dataEnd, pattern.begin(), pattern.end(),
-                           [](uint8_t currentByte, std::pair<uint8_t, bool> Pattern)
-                           { return Pattern.second || (currentByte == Pattern.first); });
+    cacheLoaded = true;
 
-    if (sig == dataEnd)
-        return NULL;
+    std::ifstream file(CachePath());
+
+    if (!file.is_open())
+        return;
+
+    cache.Load(file);
 
-    return std::distance(dataStart, sig) + startAddress;
+    LOG_DEBUG("Loaded {} cached patterns", cache.Size());
 }
 
-uintptr_t scanner::GetAddress(const std::wstring_view moduleName, const std::string_view pattern, ptrdiff_t offset,
-                              uintptr_t startAddress)
+static void SaveCache()
 {
-    uintptr_t address = NULL;
-    auto module = GetModuleHandle(moduleName.data());
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    saveScheduled = false;
 
-    if (module == nullptr)
-        return NULL;
+    if (!cache.Dirty())
+        return;
 
-    auto sections = GetExecSections(module);
+    // Written next to the cache and renamed, a crash while writing leaves the old file
+    auto path = CachePath();
+    auto tempPath = path;
+    tempPath += L".tmp";
 
-    if (startAddress != 0)
     {
-        for (size_t i = 0; i < sections.size(); i++)
+        std::ofstream file(tempPath, std::ios::trunc);
+
+        if (!file.is_open())
         {
-            auto section = &sections[i];
+            LOG_WARN("Can't write pattern cache");
+            return;
+        }
 
-            if (((uintptr_t) section->start < startAddress && (uintptr_t) section->end > startAddress))
-            {
-                address = FindPattern(startAddress, (uintptr_t) section->end - startAddress, pattern.data());
+        cache.Save(file);
+    }
 
-                if (address != NULL)
-                    break;
-            }
-            else if ((uintptr_t) section->start > startAddress)
-            {
-                address = FindPattern((uintptr_t) section->start, (uintptr_t) section->end - (uintptr_t) section->start,
-                                      pattern.data());
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
 
-                if (address != NULL)
-                    break;
-            }
-        }
-    }
+    if (ec)
+        LOG_WARN("Can't replace pattern cache: {}", ec.message());
     else
-    {
-        for (size_t i = 0; i < sections.size(); i++)
-        {
-            auto section = &sections[i];
-            address = FindPattern((uintptr_t) section->start, (uintptr_t) section->end - (uintptr_t) section->start,
-                                  pattern.data());
+        LOG_DEBUG("Saved {} cached patterns, {} evicted so far", cache.Size(), cache.Evicted());
+}
 
-            if (address != NULL)
-                break;
-        }
-    }
+// Holds a reference of our module, the dll can't be unmapped while the thread sleeps or writes
+static DWORD WINAPI SaveThread(LPVOID module)
+{
+    Sleep(2000);
+    SaveCache();
 
-    if (address != NULL)
+    FreeLibraryAndExitThread((HMODULE) module, 0);
+}
+
+// Caller must hold cacheMutex. Most scans run from DllMain, the file is written by a thread which
+// can only start after the loader lock is released. Misses of the whole batch are written at once.
+static void ScheduleSave()
+{
+    if (saveScheduled || !cache.Dirty())
+        return;
+
+    HMODULE module = nullptr;
+
+    if (!GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS, (LPCWSTR) &SaveThread, &module))
     {
-        return (address + offset);
+        LOG_WARN("Can't reference module, pattern cache is not saved");
+        return;
     }
-    else
+
+    auto thread = CreateThread(nullptr, 0, SaveThread, module, 0, nullptr);
+
+    if (thread == nullptr)
     {
-        return NULL;
+        LOG_WARN("Can't start pattern cache save");
+        KernelBaseProxy::FreeLibrary_()(module);
+        return;
     }
+
+    CloseHandle(thread);
+    saveScheduled = true;
 }
 
-uintptr_t scanner::GetAddress(HMODULE module, const std::string_view pattern, ptrdiff_t offset, uintptr_t startAddress)
+#pragma endregion
+
+void scanner::FindAll(HMODULE module, std::span<Request> requests)
 {
-    if (module == nullptr)
-        return NULL;
+    if (module == nullptr || requests.empty())
+        return;
 
-    uintptr_t address = NULL;
-    auto sections = GetExecSections(module);
+    auto base = reinterpret_cast<uint8_t*>(module);
+    auto nt = reinterpret_cast<IMAGE_NT_HEADERS64*>(base + reinterpret_cast<IMAGE_DOS_HEADER*>(base)->e_lfanew);
+    auto imageSize = (uint64_t) nt->OptionalHeader.SizeOfImage;
+    auto moduleId = ModuleId(module);
+    auto moduleBuild = ModuleBuild(module);
+
+    std::vector<CompiledPattern> patterns(requests.size());
+    std::vector<ScanJob> jobs(requests.size());
+    std::vector<uint64_t> patternHashes(requests.size());
+    std::vector<uint64_t> startRvas(requests.size());
+    size_t pending = 0;
 
-    if (startAddress != 0)
     {
-        for (size_t i = 0; i < sections.size(); i++)
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        LoadCache();
+
+        for (size_t i = 0; i < requests.size(); i++)
         {
-            auto section = &sections[i];
+            auto& request = requests[i];
+            request.result = NULL;
 
-            if (((uintptr_t) section->start < startAddress && (uintptr_t) section->end > startAddress))
+            if (!patterns[i].Compile(request.pattern))
             {
-                address = FindPattern(startAddress, (uintptr_t) section->end - startAddress, pattern.data());
-
-                if (address != NULL)
-                    break;
+                LOG_ERROR("Invalid pattern: {}", request.pattern);
+                continue;
             }
-            else if ((uintptr_t) section->start > startAddress)
-            {
-                address = FindPattern((uintptr_t) section->start, (uintptr_t) section->end - (uintptr_t) section->start,
-                                      pattern.data());
 
-                if (address != NULL)
-                    break;
+            patternHashes[i] = ScanCache::Hash(request.pattern);
+            startRvas[i] = request.startAddress > (uintptr_t) base ? request.startAddress - (uintptr_t) base : 0;
+
+            if (uint64_t cachedRva = 0; cache.Find(moduleId, moduleBuild, patternHashes[i], startRvas[i], &cachedRva))
+            {
+                // Not found in this build of the module
+                if (cachedRva == 0)
+                    continue;
+
+                // Be sure module is still the same one
+                if (cachedRva + patterns[i].Size() <= imageSize && patterns[i].Matches(base + cachedRva))
+                {
+                    request.result = (uintptr_t) base + cachedRva;
+                    continue;
+                }
             }
+
+            jobs[i].pattern = &patterns[i];
+            jobs[i].minStart = reinterpret_cast<const uint8_t*>(request.startAddress);
+            pending++;
         }
     }
-    else
+
+    if (pending == 0)
+        return;
+
+    const uint8_t* lowestStart = nullptr;
+
+    for (auto& job : jobs)
     {
-        for (size_t i = 0; i < sections.size(); i++)
-        {
-            auto section = &sections[i];
-            address = FindPattern((uintptr_t) section->start, (uintptr_t) section->end - (uintptr_t) section->start,
-                                  pattern.data());
+        if (job.pattern != nullptr && (lowestStart == nullptr || job.minStart < lowestStart))
+            lowestStart = job.minStart;
+    }
 
-            if (address != NULL)
-                break;
-        }
+    auto sections = GetExecSections(module);
+
+    for (auto& section : sections)
+    {
+        if (section.end <= lowestStart)
+            continue;
+
+        auto scanStart = std::max<const uint8_t*>(section.start, lowestStart);
+        ScanRange(section.start, section.end, scanStart, section.end, jobs);
     }
 
-    if (address != NULL)
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    for (size_t i = 0; i < requests.size(); i++)
     {
-        return (address + offset);
+        if (jobs[i].pattern == nullptr)
+            continue;
+
+        if (jobs[i].found != nullptr)
+            requests[i].result = (uintptr_t) jobs[i].found;
+
+        cache.Store(moduleId, moduleBuild, patternHashes[i], startRvas[i],
+                    jobs[i].found != nullptr ? (uint64_t) (jobs[i].found - base) : 0);
+    }
+
+    ScheduleSave();
+}
+
+uintptr_t scanner::GetAddress(const std::wstring_view moduleName, const std::string_view pattern, ptrdiff_t offset,
+                              uintptr_t startAddress)
+{
+    auto module = GetModuleHandle(moduleName.data());
+
+    if (module == nullptr)
+        return NULL;
+
+    return GetAddress(module, pattern, offset, startAddress);
+}
+
+uintptr_t scanner::GetAddress(HMODULE module, const std::string_view pattern, ptrdiff_t offset, uintptr_t startAddress)
+{
+    if (module == nullptr)
+        return NULL;
+
+    Request request { pattern, startAddress };
+    FindAll(module, { &request, 1 });
+
+    if (request.result != NULL)
+    {
+        return (request.result + offset);
     }
     else
     {
@@ -185,19 +318,10 @@ uintptr_t scanner::GetOffsetFromInstruction(const std::wstring_view moduleName,
     if (module == nullptr)
         return NULL;
 
-    uintptr_t address = NULL;
-
-    auto sections = GetExecSections(module);
-
-    for (size_t i = 0; i < sections.size(); i++)
-    {
-        auto section = &sections[i];
-        address = FindPattern((uintptr_t) section->start, (uintptr_t) section->end - (uintptr_t) section->start,
-                              pattern.data());
+    Request request { pattern };
+    FindAll(module, { &request, 1 });
 
-        if (address != NULL)
-            break;
-    }
+    auto address = request.result;
 
     if (address != NULL)
     {
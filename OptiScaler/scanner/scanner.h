@@ -2,8 +2,26 @@
 
 #include <pch.h>
 
+#include <span>
+
 namespace scanner
 {
+struct Request
+{
+    std::string_view pattern;
+
+    // Only matches at or after this address are returned
+    uintptr_t startAddress = 0;
+
+    // Address of first match, NULL if pattern not found
+    uintptr_t result = NULL;
+};
+
+// Searches all requests with a single pass over the executable sections of module.
+// Results are cached on disk per module build and written by a background thread, cached addresses
+// are verified before use.
+void FindAll(HMODULE module, std::span<Request> requests);
+
 uintptr_t GetAddress(const std::wstring_view moduleName, const std::string_view pattern, ptrdiff_t offset = 0,
                      uintptr_t startAddress = 0);
 uintptr_t GetAddress(HMODULE module, const std::string_view pattern, ptrdiff_t offset = 0, uintptr_t startAddress = 0);
@@ -4,6 +4,9 @@
 #include "precompile/Bias_Shader.h"
 
 #include <Config.h>
+#include <misc/GpuTimer_Dx12.h>
+#include <misc/TransientPool_Dx12.h>
+#include <misc/ShaderCache_Dx12.h>
 
 inline static DXGI_FORMAT TranslateTypelessFormats(DXGI_FORMAT format)
 {
@@ -38,7 +41,7 @@ bool Bias_Dx12::CreateComputeShader(ID3D12Device* device, ID3D12RootSignature* r
     psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
     psoDesc.CS = CD3DX12_SHADER_BYTECODE(shaderBlob->GetBufferPointer(), shaderBlob->GetBufferSize());
 
-    HRESULT hr = device->CreateComputePipelineState(&psoDesc, __uuidof(ID3D12PipelineState*), (void**) pipelineState);
+    HRESULT hr = ShaderCache_Dx12::CreateComputePipeline(device, psoDesc, pipelineState);
 
     if (FAILED(hr))
     {
@@ -63,7 +66,7 @@ bool Bias_Dx12::CreateBufferResource(ID3D12Device* InDevice, ID3D12Resource* InS
         if (bufDesc.Width != (UINT64) (texDesc.Width) || bufDesc.Height != (UINT) (texDesc.Height) ||
             bufDesc.Format != texDesc.Format)
         {
-            _buffer->Release();
+            TransientPool_Dx12::Release(_buffer, _bufferState);
             _buffer = nullptr;
         }
         else
@@ -87,23 +90,31 @@ bool Bias_Dx12::CreateBufferResource(ID3D12Device* InDevice, ID3D12Resource* InS
     texDesc.Width = texDesc.Width;
     texDesc.Height = texDesc.Height;
 
-    hr = InDevice->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &texDesc, InState, nullptr,
-                                           IID_PPV_ARGS(&_buffer));
+    TransientPool_Dx12::Texture texture;
 
-    if (hr != S_OK)
+    if (!TransientPool_Dx12::Acquire(InDevice, texDesc, heapProperties, InState, L"Bias_Buffer", texture,
+                                     { TransientPool_Dx12::BiasPass, TransientPool_Dx12::UpscalerPass }))
     {
-        LOG_ERROR("Bias_Dx12::CreateBufferResource [{0}] CreateCommittedResource result: {1:x}", _name, hr);
+        LOG_ERROR("Bias_Dx12::CreateBufferResource [{0}] Can't acquire buffer", _name);
         return false;
     }
 
-    _buffer->SetName(L"Bias_Buffer");
-    _bufferState = InState;
+    _buffer = texture.resource;
+    _bufferState = texture.state;
+    _bufferNeedsInit = texture.needsInit;
+    _bufferInFrame = texture.inFrame;
 
     return true;
 }
 
 void Bias_Dx12::SetBufferState(ID3D12GraphicsCommandList* InCommandList, D3D12_RESOURCE_STATES InState)
 {
+    if (_bufferNeedsInit || _bufferInFrame)
+    {
+        TransientPool_Dx12::BeforeFirstUse(InCommandList, _buffer, _bufferState);
+        _bufferNeedsInit = false;
+    }
+
     if (_bufferState == InState)
         return;
 
@@ -126,42 +137,12 @@ bool Bias_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCm
 
     LOG_DEBUG("[{0}] Start!", _name);
 
-    _counter++;
-    _counter = _counter % 2;
-
-    if (_cpuSrvHandle[_counter].ptr == NULL)
-        _cpuSrvHandle[_counter] = _srvHeap[_counter]->GetCPUDescriptorHandleForHeapStart();
+    GpuTimer_Dx12::Scope timer(InCmdList, GpuPass::Bias);
 
-    if (_cpuUavHandle[_counter].ptr == NULL)
-    {
-        _cpuUavHandle[_counter] = _cpuSrvHandle[_counter];
-        _cpuUavHandle[_counter].ptr +=
-            InDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-    }
-
-    if (_cpuCbvHandle[_counter].ptr == NULL)
-    {
-        _cpuCbvHandle[_counter] = _cpuUavHandle[_counter];
-        _cpuCbvHandle[_counter].ptr +=
-            InDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-    }
+    DescriptorRing_Dx12::Range range;
 
-    if (_gpuSrvHandle[_counter].ptr == NULL)
-        _gpuSrvHandle[_counter] = _srvHeap[_counter]->GetGPUDescriptorHandleForHeapStart();
-
-    if (_gpuUavHandle[_counter].ptr == NULL)
-    {
-        _gpuUavHandle[_counter] = _gpuSrvHandle[_counter];
-        _gpuUavHandle[_counter].ptr +=
-            InDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-    }
-
-    if (_gpuCbvHandle[_counter].ptr == NULL)
-    {
-        _gpuCbvHandle[_counter] = _gpuUavHandle[_counter];
-        _gpuCbvHandle[_counter].ptr +=
-            InDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-    }
+    if (!DescriptorRing_Dx12::AllocateTransient(InDevice, 2, range)) // SRV + UAV
+        return false;
 
     auto inDesc = InResource->GetDesc();
     auto outDesc = OutResource->GetDesc();
@@ -173,7 +154,7 @@ bool Bias_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCm
     srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
     srvDesc.Texture2D.MipLevels = 1;
 
-    InDevice->CreateShaderResourceView(InResource, &srvDesc, _cpuSrvHandle[_counter]);
+    InDevice->CreateShaderResourceView(InResource, &srvDesc, range.Cpu(0));
 
     // Create UAV for Output Texture
     D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
@@ -181,7 +162,7 @@ bool Bias_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCm
     uavDesc.ViewDimension = D3D12_UAV_DIMENSION_TEXTURE2D;
     uavDesc.Texture2D.MipSlice = 0;
 
-    InDevice->CreateUnorderedAccessView(OutResource, nullptr, &uavDesc, _cpuUavHandle[_counter]);
+    InDevice->CreateUnorderedAccessView(OutResource, nullptr, &uavDesc, range.Cpu(1));
 
     InternalConstants constants {};
 
@@ -213,20 +194,27 @@ bool Bias_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCm
     memcpy(pCBDataBegin, &constants, sizeof(constants));
     _constantBuffer->Unmap(0, nullptr);
 
-    D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc = {};
-    cbvDesc.BufferLocation = _constantBuffer->GetGPUVirtualAddress();
-    cbvDesc.SizeInBytes = sizeof(constants);
-    InDevice->CreateConstantBufferView(&cbvDesc, _cpuCbvHandle[_counter]);
+    // Constant buffer never changes, its view is created once per descriptor heap
+    if (!DescriptorRing_Dx12::IsCurrent(_cbvRange))
+    {
+        if (!DescriptorRing_Dx12::AllocatePersistent(InDevice, 1, _cbvRange))
+            return false;
+
+        D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc = {};
+        cbvDesc.BufferLocation = _constantBuffer->GetGPUVirtualAddress();
+        cbvDesc.SizeInBytes = sizeof(constants);
+        InDevice->CreateConstantBufferView(&cbvDesc, _cbvRange.Cpu(0));
+    }
 
-    ID3D12DescriptorHeap* heaps[] = { _srvHeap[_counter] };
-    InCmdList->SetDescriptorHeaps(_countof(heaps), heaps);
+    if (!DescriptorRing_Dx12::Bind(InCmdList, range))
+        return false;
 
     InCmdList->SetComputeRootSignature(_rootSignature);
     InCmdList->SetPipelineState(_pipelineState);
 
-    InCmdList->SetComputeRootDescriptorTable(0, _gpuSrvHandle[_counter]);
-    InCmdList->SetComputeRootDescriptorTable(1, _gpuUavHandle[_counter]);
-    InCmdList->SetComputeRootDescriptorTable(2, _gpuCbvHandle[_counter]);
+    InCmdList->SetComputeRootDescriptorTable(0, range.Gpu(0));
+    InCmdList->SetComputeRootDescriptorTable(1, range.Gpu(1));
+    InCmdList->SetComputeRootDescriptorTable(2, _cbvRange.Gpu(0));
 
     UINT dispatchWidth = 0;
     UINT dispatchHeight = 0;
@@ -331,8 +319,7 @@ Bias_Dx12::Bias_Dx12(std::string InName, ID3D12Device* InDevice) : _name(InName)
             break;
         }
 
-        hr = InDevice->CreateRootSignature(0, signatureBlob->GetBufferPointer(), signatureBlob->GetBufferSize(),
-                                           IID_PPV_ARGS(&_rootSignature));
+        hr = ShaderCache_Dx12::CreateRootSignature(InDevice, signatureBlob, &_rootSignature);
 
         if (FAILED(hr))
         {
@@ -366,8 +353,7 @@ Bias_Dx12::Bias_Dx12(std::string InName, ID3D12Device* InDevice) : _name(InName)
         computePsoDesc.pRootSignature = _rootSignature;
         computePsoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
         computePsoDesc.CS = CD3DX12_SHADER_BYTECODE(reinterpret_cast<const void*>(bias_cso), sizeof(bias_cso));
-        auto hr = InDevice->CreateComputePipelineState(&computePsoDesc, __uuidof(ID3D12PipelineState*),
-                                                       (void**) &_pipelineState);
+        auto hr = ShaderCache_Dx12::CreateComputePipeline(InDevice, computePsoDesc, &_pipelineState);
 
         if (FAILED(hr))
         {
@@ -378,7 +364,8 @@ Bias_Dx12::Bias_Dx12(std::string InName, ID3D12Device* InDevice) : _name(InName)
     else
     {
         // Compile shader blobs
-        ID3DBlob* _recEncodeShader = Bias_CompileShader(biasShader.c_str(), "CSMain", "cs_5_0");
+        ID3DBlob* _recEncodeShader = ShaderCache_Dx12::CompileShader(biasShader.c_str(), "CSMain", "cs_5_0",
+                                                                     Bias_CompileShader);
 
         if (_recEncodeShader == nullptr)
         {
@@ -400,32 +387,7 @@ Bias_Dx12::Bias_Dx12(std::string InName, ID3D12Device* InDevice) : _name(InName)
         }
     }
 
-    D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
-    heapDesc.NumDescriptors = 3; // SRV + UAV + CBV
-    heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-    heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-
-    State::Instance().skipHeapCapture = true;
-
-    auto hr = InDevice->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&_srvHeap[0]));
-
-    if (FAILED(hr))
-    {
-        LOG_ERROR("[{0}] CreateDescriptorHeap[0] error {1:x}", _name, (unsigned int) hr);
-        return;
-    }
-
-    hr = InDevice->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&_srvHeap[1]));
-
-    State::Instance().skipHeapCapture = false;
-
-    if (FAILED(hr))
-    {
-        LOG_ERROR("[{0}] CreateDescriptorHeap[1] error {1:x}", _name, (unsigned int) hr);
-        return;
-    }
-
-    _init = _srvHeap[1] != nullptr;
+    _init = DescriptorRing_Dx12::Init(InDevice);
 }
 
 Bias_Dx12::~Bias_Dx12()
@@ -445,21 +407,11 @@ Bias_Dx12::~Bias_Dx12()
         _pipelineState = nullptr;
     }
 
-    if (_srvHeap[0] != nullptr)
-    {
-        _srvHeap[0]->Release();
-        _srvHeap[0] = nullptr;
-    }
-
-    if (_srvHeap[1] != nullptr)
-    {
-        _srvHeap[1]->Release();
-        _srvHeap[1] = nullptr;
-    }
+    DescriptorRing_Dx12::FreePersistent(_cbvRange);
 
     if (_buffer != nullptr)
     {
-        _buffer->Release();
+        TransientPool_Dx12::Release(_buffer, _bufferState);
         _buffer = nullptr;
     }
 
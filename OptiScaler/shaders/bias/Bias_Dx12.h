@@ -2,6 +2,8 @@
 
 #include <pch.h>
 
+#include <misc/DescriptorRing_Dx12.h>
+
 #include <d3d12.h>
 #include <d3dx/d3dx12.h>
 
@@ -15,17 +17,9 @@ class Bias_Dx12
 
     std::string _name = "";
     bool _init = false;
-    int _counter = 0;
 
     ID3D12RootSignature* _rootSignature = nullptr;
     ID3D12PipelineState* _pipelineState = nullptr;
-    ID3D12DescriptorHeap* _srvHeap[2] = { nullptr, nullptr };
-    D3D12_CPU_DESCRIPTOR_HANDLE _cpuSrvHandle[2] { { NULL }, { NULL } };
-    D3D12_CPU_DESCRIPTOR_HANDLE _cpuUavHandle[2] { { NULL }, { NULL } };
-    D3D12_CPU_DESCRIPTOR_HANDLE _cpuCbvHandle[2] { { NULL }, { NULL } };
-    D3D12_GPU_DESCRIPTOR_HANDLE _gpuSrvHandle[2] { { NULL }, { NULL } };
-    D3D12_GPU_DESCRIPTOR_HANDLE _gpuUavHandle[2] { { NULL }, { NULL } };
-    D3D12_GPU_DESCRIPTOR_HANDLE _gpuCbvHandle[2] { { NULL }, { NULL } };
 
     inline static bool CreateComputeShader(ID3D12Device* device, ID3D12RootSignature* rootSignature,
                                            ID3D12PipelineState** pipelineState, ID3DBlob* shaderBlob);
@@ -33,7 +27,10 @@ class Bias_Dx12
     ID3D12Device* _device = nullptr;
     ID3D12Resource* _buffer = nullptr;
     ID3D12Resource* _constantBuffer = nullptr;
+    DescriptorRing_Dx12::Range _cbvRange;
     D3D12_RESOURCE_STATES _bufferState = D3D12_RESOURCE_STATE_COMMON;
+    bool _bufferNeedsInit = false;
+    bool _bufferInFrame = false;
 
     UINT InNumThreadsX = 32;
     UINT InNumThreadsY = 32;
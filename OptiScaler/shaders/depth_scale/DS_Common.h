@@ -3,12 +3,9 @@
 #include <d3dcompiler.h>
 #include <DirectXMath.h>
 
-using namespace DirectX;
+#include "DS_Constants.h"
 
-struct alignas(256) DSConstants
-{
-    float DepthScale;
-};
+using namespace DirectX;
 
 inline static std::string shaderCode = R"(
 cbuffer Params : register(b0)
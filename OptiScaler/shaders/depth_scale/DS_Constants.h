@@ -0,0 +1,7 @@
+#pragma once
+
+// Constant buffer of the depth scale shader, also used by the CPU version in shaders/reference
+struct alignas(256) DSConstants
+{
+    float DepthScale;
+};
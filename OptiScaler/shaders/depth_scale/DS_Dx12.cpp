@@ -2,6 +2,9 @@
 
 #include <Config.h>
 #include <State.h>
+#include <misc/DeferredRelease_Dx12.h>
+#include <misc/GpuTimer_Dx12.h>
+#include <misc/ShaderCache_Dx12.h>
 #include "precompiled/DS_Shader.h"
 
 inline static DXGI_FORMAT TranslateTypelessFormats(DXGI_FORMAT format)
@@ -47,7 +50,7 @@ static bool CreateComputeShader(ID3D12Device* device, ID3D12RootSignature* rootS
     psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
     psoDesc.CS = CD3DX12_SHADER_BYTECODE(shaderBlob->GetBufferPointer(), shaderBlob->GetBufferSize());
 
-    HRESULT hr = device->CreateComputePipelineState(&psoDesc, __uuidof(ID3D12PipelineState*), (void**) pipelineState);
+    HRESULT hr = ShaderCache_Dx12::CreateComputePipeline(device, psoDesc, pipelineState);
 
     if (FAILED(hr))
     {
@@ -74,7 +77,7 @@ bool DS_Dx12::CreateBufferResource(ID3D12Device* InDevice, ID3D12Resource* InSou
 
         if (bufDesc.Width != InWidth || bufDesc.Height != InHeight)
         {
-            _buffer->Release();
+            DeferredRelease_Dx12::Release(_buffer, "DS buffer");
             _buffer = nullptr;
         }
         else
@@ -139,42 +142,12 @@ bool DS_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCmdL
 
     LOG_DEBUG("[{0}] Start!", _name);
 
-    _counter++;
-    _counter = _counter % 2;
+    GpuTimer_Dx12::Scope timer(InCmdList, GpuPass::DepthScale);
 
-    if (_cpuSrvHandle[_counter].ptr == NULL)
-        _cpuSrvHandle[_counter] = _srvHeap[_counter]->GetCPUDescriptorHandleForHeapStart();
+    DescriptorRing_Dx12::Range range;
 
-    if (_cpuUavHandle[_counter].ptr == NULL)
-    {
-        _cpuUavHandle[_counter] = _cpuSrvHandle[_counter];
-        _cpuUavHandle[_counter].ptr +=
-            InDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-    }
-
-    if (_cpuCbvHandle[_counter].ptr == NULL)
-    {
-        _cpuCbvHandle[_counter] = _cpuUavHandle[_counter];
-        _cpuCbvHandle[_counter].ptr +=
-            InDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-    }
-
-    if (_gpuSrvHandle[_counter].ptr == NULL)
-        _gpuSrvHandle[_counter] = _srvHeap[_counter]->GetGPUDescriptorHandleForHeapStart();
-
-    if (_gpuUavHandle[_counter].ptr == NULL)
-    {
-        _gpuUavHandle[_counter] = _gpuSrvHandle[_counter];
-        _gpuUavHandle[_counter].ptr +=
-            InDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-    }
-
-    if (_gpuCbvHandle[_counter].ptr == NULL)
-    {
-        _gpuCbvHandle[_counter] = _gpuUavHandle[_counter];
-        _gpuCbvHandle[_counter].ptr +=
-            InDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-    }
+    if (!DescriptorRing_Dx12::AllocateTransient(InDevice, 2, range)) // SRV + UAV
+        return false;
 
     auto inDesc = InResource->GetDesc();
     auto outDesc = OutResource->GetDesc();
@@ -185,14 +158,14 @@ bool DS_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCmdL
     srvDesc.Format = TranslateTypelessFormats(inDesc.Format);
     srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
     srvDesc.Texture2D.MipLevels = 1;
-    InDevice->CreateShaderResourceView(InResource, &srvDesc, _cpuSrvHandle[_counter]);
+    InDevice->CreateShaderResourceView(InResource, &srvDesc, range.Cpu(0));
 
     // Create UAV for Output Texture
     D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
     uavDesc.Format = DXGI_FORMAT_R32_FLOAT;
     uavDesc.ViewDimension = D3D12_UAV_DIMENSION_TEXTURE2D;
     uavDesc.Texture2D.MipSlice = 0;
-    InDevice->CreateUnorderedAccessView(OutResource, nullptr, &uavDesc, _cpuUavHandle[_counter]);
+    InDevice->CreateUnorderedAccessView(OutResource, nullptr, &uavDesc, range.Cpu(1));
 
     DSConstants constants {};
 
@@ -219,20 +192,27 @@ bool DS_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCmdL
     memcpy(pCBDataBegin, &constants, sizeof(constants));
     _constantBuffer->Unmap(0, nullptr);
 
-    D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc = {};
-    cbvDesc.BufferLocation = _constantBuffer->GetGPUVirtualAddress();
-    cbvDesc.SizeInBytes = sizeof(constants);
-    InDevice->CreateConstantBufferView(&cbvDesc, _cpuCbvHandle[_counter]);
+    // Constant buffer never changes, its view is created once per descriptor heap
+    if (!DescriptorRing_Dx12::IsCurrent(_cbvRange))
+    {
+        if (!DescriptorRing_Dx12::AllocatePersistent(InDevice, 1, _cbvRange))
+            return false;
+
+        D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc = {};
+        cbvDesc.BufferLocation = _constantBuffer->GetGPUVirtualAddress();
+        cbvDesc.SizeInBytes = sizeof(constants);
+        InDevice->CreateConstantBufferView(&cbvDesc, _cbvRange.Cpu(0));
+    }
 
-    ID3D12DescriptorHeap* heaps[] = { _srvHeap[_counter] };
-    InCmdList->SetDescriptorHeaps(_countof(heaps), heaps);
+    if (!DescriptorRing_Dx12::Bind(InCmdList, range))
+        return false;
 
     InCmdList->SetComputeRootSignature(_rootSignature);
     InCmdList->SetPipelineState(_pipelineState);
 
-    InCmdList->SetComputeRootDescriptorTable(0, _gpuSrvHandle[_counter]);
-    InCmdList->SetComputeRootDescriptorTable(1, _gpuUavHandle[_counter]);
-    InCmdList->SetComputeRootDescriptorTable(2, _gpuCbvHandle[_counter]);
+    InCmdList->SetComputeRootDescriptorTable(0, range.Gpu(0));
+    InCmdList->SetComputeRootDescriptorTable(1, range.Gpu(1));
+    InCmdList->SetComputeRootDescriptorTable(2, _cbvRange.Gpu(0));
 
     UINT dispatchWidth = 0;
     UINT dispatchHeight = 0;
@@ -347,8 +327,7 @@ DS_Dx12::DS_Dx12(std::string InName, ID3D12Device* InDevice) : _name(InName), _d
             break;
         }
 
-        hr = InDevice->CreateRootSignature(0, signatureBlob->GetBufferPointer(), signatureBlob->GetBufferSize(),
-                                           IID_PPV_ARGS(&_rootSignature));
+        hr = ShaderCache_Dx12::CreateRootSignature(InDevice, signatureBlob, &_rootSignature);
 
         if (FAILED(hr))
         {
@@ -382,8 +361,7 @@ DS_Dx12::DS_Dx12(std::string InName, ID3D12Device* InDevice) : _name(InName), _d
         computePsoDesc.pRootSignature = _rootSignature;
         computePsoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
         computePsoDesc.CS = CD3DX12_SHADER_BYTECODE(reinterpret_cast<const void*>(DS_cso), sizeof(DS_cso));
-        auto hr = InDevice->CreateComputePipelineState(&computePsoDesc, __uuidof(ID3D12PipelineState*),
-                                                       (void**) &_pipelineState);
+        auto hr = ShaderCache_Dx12::CreateComputePipeline(InDevice, computePsoDesc, &_pipelineState);
 
         if (FAILED(hr))
         {
@@ -396,7 +374,7 @@ DS_Dx12::DS_Dx12(std::string InName, ID3D12Device* InDevice) : _name(InName), _d
         // Compile shader blobs
         ID3DBlob* _recEncodeShader = nullptr;
 
-        _recEncodeShader = DS_CompileShader(shaderCode.c_str(), "CSMain", "cs_5_0");
+        _recEncodeShader = ShaderCache_Dx12::CompileShader(shaderCode.c_str(), "CSMain", "cs_5_0", DS_CompileShader);
 
         if (_recEncodeShader == nullptr)
         {
@@ -418,40 +396,7 @@ DS_Dx12::DS_Dx12(std::string InName, ID3D12Device* InDevice) : _name(InName), _d
         }
     }
 
-    D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
-    heapDesc.NumDescriptors = 3; // SRV + UAV + CBV
-    heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-    heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-
-    State::Instance().skipHeapCapture = true;
-
-    auto hr = InDevice->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&_srvHeap[0]));
-
-    if (FAILED(hr))
-    {
-        LOG_ERROR("[{0}] CreateDescriptorHeap[0] error {1:x}", _name, hr);
-        return;
-    }
-
-    hr = InDevice->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&_srvHeap[1]));
-
-    if (FAILED(hr))
-    {
-        LOG_ERROR("[{0}] CreateDescriptorHeap[1] error {1:x}", _name, hr);
-        return;
-    }
-
-    hr = InDevice->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&_srvHeap[2]));
-
-    State::Instance().skipHeapCapture = false;
-
-    if (FAILED(hr))
-    {
-        LOG_ERROR("[{0}] CreateDescriptorHeap[2] error {1:x}", _name, hr);
-        return;
-    }
-
-    _init = _srvHeap[2] != nullptr;
+    _init = DescriptorRing_Dx12::Init(InDevice);
 }
 
 DS_Dx12::~DS_Dx12()
@@ -471,23 +416,7 @@ DS_Dx12::~DS_Dx12()
         _rootSignature = nullptr;
     }
 
-    if (_srvHeap[0] != nullptr)
-    {
-        _srvHeap[0]->Release();
-        _srvHeap[0] = nullptr;
-    }
-
-    if (_srvHeap[1] != nullptr)
-    {
-        _srvHeap[1]->Release();
-        _srvHeap[1] = nullptr;
-    }
-
-    if (_srvHeap[2] != nullptr)
-    {
-        _srvHeap[2]->Release();
-        _srvHeap[2] = nullptr;
-    }
+    DescriptorRing_Dx12::FreePersistent(_cbvRange);
 
     if (_buffer != nullptr)
     {
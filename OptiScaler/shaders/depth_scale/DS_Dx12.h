@@ -4,6 +4,8 @@
 
 #include "DS_Common.h"
 
+#include <misc/DescriptorRing_Dx12.h>
+
 #include <d3d12.h>
 #include <d3dx/d3dx12.h>
 
@@ -14,14 +16,6 @@ class DS_Dx12
     bool _init = false;
     ID3D12RootSignature* _rootSignature = nullptr;
     ID3D12PipelineState* _pipelineState = nullptr;
-    ID3D12DescriptorHeap* _srvHeap[3] = { nullptr, nullptr, nullptr };
-    D3D12_CPU_DESCRIPTOR_HANDLE _cpuSrvHandle[2] { { NULL }, { NULL } };
-    D3D12_CPU_DESCRIPTOR_HANDLE _cpuUavHandle[2] { { NULL }, { NULL } };
-    D3D12_CPU_DESCRIPTOR_HANDLE _cpuCbvHandle[2] { { NULL }, { NULL } };
-    D3D12_GPU_DESCRIPTOR_HANDLE _gpuSrvHandle[2] { { NULL }, { NULL } };
-    D3D12_GPU_DESCRIPTOR_HANDLE _gpuUavHandle[2] { { NULL }, { NULL } };
-    D3D12_GPU_DESCRIPTOR_HANDLE _gpuCbvHandle[2] { { NULL }, { NULL } };
-    int _counter = 0;
 
     uint32_t InNumThreadsX = 16;
     uint32_t InNumThreadsY = 16;
@@ -29,6 +23,7 @@ class DS_Dx12
     ID3D12Device* _device = nullptr;
     ID3D12Resource* _buffer = nullptr;
     ID3D12Resource* _constantBuffer = nullptr;
+    DescriptorRing_Dx12::Range _cbvRange;
     D3D12_RESOURCE_STATES _bufferState = D3D12_RESOURCE_STATE_COMMON;
 
   public:
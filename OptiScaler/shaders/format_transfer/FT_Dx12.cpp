@@ -5,6 +5,8 @@
 #include "precompile/B8R8G8A8_Shader.h"
 
 #include <Config.h>
+#include <misc/DeferredRelease_Dx12.h>
+#include <misc/ShaderCache_Dx12.h>
 
 inline static DXGI_FORMAT TranslateTypelessFormats(DXGI_FORMAT format)
 {
@@ -45,7 +47,7 @@ static bool CreateComputeShader(ID3D12Device* device, ID3D12RootSignature* rootS
     psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
     psoDesc.CS = CD3DX12_SHADER_BYTECODE(shaderBlob->GetBufferPointer(), shaderBlob->GetBufferSize());
 
-    HRESULT hr = device->CreateComputePipelineState(&psoDesc, __uuidof(ID3D12PipelineState*), (void**) pipelineState);
+    HRESULT hr = ShaderCache_Dx12::CreateComputePipeline(device, psoDesc, pipelineState);
 
     if (FAILED(hr))
     {
@@ -69,7 +71,7 @@ bool FT_Dx12::CreateBufferResource(ID3D12Device* InDevice, ID3D12Resource* InSou
 
         if (bufDesc.Width != texDesc.Width || bufDesc.Height != texDesc.Height || bufDesc.Format != format)
         {
-            _buffer->Release();
+            DeferredRelease_Dx12::Release(_buffer, "FT buffer");
             _buffer = nullptr;
         }
         else
@@ -131,28 +133,10 @@ bool FT_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCmdL
 
     LOG_DEBUG("[{0}] Start!", _name);
 
-    _counter++;
-    _counter = _counter % 2;
+    DescriptorRing_Dx12::Range range;
 
-    if (_cpuSrvHandle[_counter].ptr == NULL)
-        _cpuSrvHandle[_counter] = _srvHeap[_counter]->GetCPUDescriptorHandleForHeapStart();
-
-    if (_cpuUavHandle[_counter].ptr == NULL)
-    {
-        _cpuUavHandle[_counter] = _cpuSrvHandle[_counter];
-        _cpuUavHandle[_counter].ptr +=
-            InDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-    }
-
-    if (_gpuSrvHandle[_counter].ptr == NULL)
-        _gpuSrvHandle[_counter] = _srvHeap[_counter]->GetGPUDescriptorHandleForHeapStart();
-
-    if (_gpuUavHandle[_counter].ptr == NULL)
-    {
-        _gpuUavHandle[_counter] = _gpuSrvHandle[_counter];
-        _gpuUavHandle[_counter].ptr +=
-            InDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-    }
+    if (!DescriptorRing_Dx12::AllocateTransient(InDevice, 2, range)) // SRV + UAV
+        return false;
 
     auto inDesc = InResource->GetDesc();
     auto outDesc = OutResource->GetDesc();
@@ -165,23 +149,23 @@ bool FT_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCmdL
     srvDesc.Texture2D.MipLevels = 1;
     srvDesc.Texture2D.MostDetailedMip = 0;
     srvDesc.Texture2D.ResourceMinLODClamp = 0.0f;
-    InDevice->CreateShaderResourceView(InResource, &srvDesc, _cpuSrvHandle[_counter]);
+    InDevice->CreateShaderResourceView(InResource, &srvDesc, range.Cpu(0));
 
     // Create UAV for Output Texture
     D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
     uavDesc.Format = DXGI_FORMAT_R32_UINT;
     uavDesc.ViewDimension = D3D12_UAV_DIMENSION_TEXTURE2D;
     uavDesc.Texture2D.MipSlice = 0;
-    InDevice->CreateUnorderedAccessView(OutResource, nullptr, &uavDesc, _cpuUavHandle[_counter]);
+    InDevice->CreateUnorderedAccessView(OutResource, nullptr, &uavDesc, range.Cpu(1));
 
-    ID3D12DescriptorHeap* heaps[] = { _srvHeap[_counter] };
-    InCmdList->SetDescriptorHeaps(_countof(heaps), heaps);
+    if (!DescriptorRing_Dx12::Bind(InCmdList, range))
+        return false;
 
     InCmdList->SetComputeRootSignature(_rootSignature);
     InCmdList->SetPipelineState(_pipelineState);
 
-    InCmdList->SetComputeRootDescriptorTable(0, _gpuSrvHandle[_counter]);
-    InCmdList->SetComputeRootDescriptorTable(1, _gpuUavHandle[_counter]);
+    InCmdList->SetComputeRootDescriptorTable(0, range.Gpu(0));
+    InCmdList->SetComputeRootDescriptorTable(1, range.Gpu(1));
 
     UINT dispatchWidth = 0;
     UINT dispatchHeight = 0;
@@ -262,8 +246,7 @@ FT_Dx12::FT_Dx12(std::string InName, ID3D12Device* InDevice, DXGI_FORMAT InForma
             break;
         }
 
-        hr = InDevice->CreateRootSignature(0, signatureBlob->GetBufferPointer(), signatureBlob->GetBufferSize(),
-                                           IID_PPV_ARGS(&_rootSignature));
+        hr = ShaderCache_Dx12::CreateRootSignature(InDevice, signatureBlob, &_rootSignature);
 
         if (FAILED(hr))
         {
@@ -327,8 +310,7 @@ FT_Dx12::FT_Dx12(std::string InName, ID3D12Device* InDevice, DXGI_FORMAT InForma
             return;
         }
 
-        auto hr = InDevice->CreateComputePipelineState(&computePsoDesc, __uuidof(ID3D12PipelineState*),
-                                                       (void**) &_pipelineState);
+        auto hr = ShaderCache_Dx12::CreateComputePipeline(InDevice, computePsoDesc, &_pipelineState);
 
         if (FAILED(hr))
         {
@@ -340,15 +322,18 @@ FT_Dx12::FT_Dx12(std::string InName, ID3D12Device* InDevice, DXGI_FORMAT InForma
     {
         if (InFormat == DXGI_FORMAT_R10G10B10A2_UNORM)
         {
-            _recEncodeShader = FT_CompileShader(ftR10G10B10A2Code.c_str(), "CSMain", "cs_5_0");
+            _recEncodeShader = ShaderCache_Dx12::CompileShader(ftR10G10B10A2Code.c_str(), "CSMain", "cs_5_0",
+                                                               FT_CompileShader);
         }
         else if (InFormat == DXGI_FORMAT_R8G8B8A8_UNORM || InFormat == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB)
         {
-            _recEncodeShader = FT_CompileShader(ftR8G8B8A8Code.c_str(), "CSMain", "cs_5_0");
+            _recEncodeShader = ShaderCache_Dx12::CompileShader(ftR8G8B8A8Code.c_str(), "CSMain", "cs_5_0",
+                                                               FT_CompileShader);
         }
         else if (InFormat == DXGI_FORMAT_B8G8R8A8_UNORM)
         {
-            _recEncodeShader = FT_CompileShader(ftB8G8R8A8Code.c_str(), "CSMain", "cs_5_0");
+            _recEncodeShader = ShaderCache_Dx12::CompileShader(ftB8G8R8A8Code.c_str(), "CSMain", "cs_5_0",
+                                                               FT_CompileShader);
         }
         else
         {
@@ -376,36 +361,7 @@ FT_Dx12::FT_Dx12(std::string InName, ID3D12Device* InDevice, DXGI_FORMAT InForma
         }
     }
 
-    D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
-    heapDesc.NumDescriptors = 2; // SRV + UAV
-    heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-    heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-
-    auto hr = InDevice->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&_srvHeap[0]));
-
-    if (FAILED(hr))
-    {
-        LOG_ERROR("[{0}] CreateDescriptorHeap[0] error {1:x}", _name, hr);
-        return;
-    }
-
-    hr = InDevice->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&_srvHeap[1]));
-
-    if (FAILED(hr))
-    {
-        LOG_ERROR("[{0}] CreateDescriptorHeap[1] error {1:x}", _name, hr);
-        return;
-    }
-
-    hr = InDevice->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&_srvHeap[2]));
-
-    if (FAILED(hr))
-    {
-        LOG_ERROR("[{0}] CreateDescriptorHeap[2] error {1:x}", _name, hr);
-        return;
-    }
-
-    _init = _srvHeap[2] != nullptr;
+    _init = DescriptorRing_Dx12::Init(InDevice);
 }
 
 bool FT_Dx12::IsFormatCompatible(DXGI_FORMAT InFormat)
@@ -445,24 +401,6 @@ FT_Dx12::~FT_Dx12()
         _rootSignature = nullptr;
     }
 
-    if (_srvHeap[0] != nullptr)
-    {
-        _srvHeap[0]->Release();
-        _srvHeap[0] = nullptr;
-    }
-
-    if (_srvHeap[1] != nullptr)
-    {
-        _srvHeap[1]->Release();
-        _srvHeap[1] = nullptr;
-    }
-
-    if (_srvHeap[2] != nullptr)
-    {
-        _srvHeap[2]->Release();
-        _srvHeap[2] = nullptr;
-    }
-
     if (_buffer != nullptr)
     {
         _buffer->Release();
@@ -4,6 +4,8 @@
 
 #include "FT_Common.h"
 
+#include <misc/DescriptorRing_Dx12.h>
+
 #include <d3d12.h>
 #include <d3dx/d3dx12.h>
 
@@ -14,12 +16,6 @@ class FT_Dx12
     bool _init = false;
     ID3D12RootSignature* _rootSignature = nullptr;
     ID3D12PipelineState* _pipelineState = nullptr;
-    ID3D12DescriptorHeap* _srvHeap[3] = { nullptr, nullptr, nullptr };
-    D3D12_CPU_DESCRIPTOR_HANDLE _cpuSrvHandle[2] { { NULL }, { NULL } };
-    D3D12_CPU_DESCRIPTOR_HANDLE _cpuUavHandle[2] { { NULL }, { NULL } };
-    D3D12_GPU_DESCRIPTOR_HANDLE _gpuSrvHandle[2] { { NULL }, { NULL } };
-    D3D12_GPU_DESCRIPTOR_HANDLE _gpuUavHandle[2] { { NULL }, { NULL } };
-    int _counter = 0;
 
     uint32_t InNumThreadsX = 512;
     uint32_t InNumThreadsY = 1;
@@ -3,12 +3,7 @@
 #include "pch.h"
 #include <d3dcompiler.h>
 
-struct CompareParams
-{
-    float DiffThreshold = 0.02f;
-    float PinkAmount = 0.6f;
-    float InvOutputSize[2] = { 0, 0 };
-};
+#include "HC_Constants.h"
 
 static std::string hcCode = R"(
 Texture2D gRefTex : register(t0); 
@@ -0,0 +1,9 @@
+#pragma once
+
+// Parameters of the hudless compare shader, also used by the CPU version in shaders/reference
+struct CompareParams
+{
+    float DiffThreshold = 0.02f;
+    float PinkAmount = 0.6f;
+    float InvOutputSize[2] = { 0, 0 };
+};
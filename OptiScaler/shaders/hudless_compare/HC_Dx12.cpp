@@ -1,6 +1,8 @@
 #include "HC_Dx12.h"
 
 #include <Config.h>
+#include <misc/DeferredRelease_Dx12.h>
+#include <hooks/SwapchainContext_Dx.h>
 
 DXGI_FORMAT HC_Dx12::ToSRGB(DXGI_FORMAT f)
 {
@@ -57,7 +59,7 @@ bool HC_Dx12::CreateBufferResource(UINT index, ID3D12Device* InDevice, ID3D12Res
         if (bufDesc.Width != (UINT64) (texDesc.Width) || bufDesc.Height != (UINT) (texDesc.Height) ||
             bufDesc.Format != texDesc.Format)
         {
-            _buffer[index]->Release();
+            DeferredRelease_Dx12::Release(_buffer[index], "HC buffer");
             _buffer[index] = nullptr;
         }
         else
@@ -131,7 +133,7 @@ HC_Dx12::HC_Dx12(std::string InName, ID3D12Device* InDevice)
     _name = InName;
 
     DXGI_SWAP_CHAIN_DESC scDesc {};
-    if (State::Instance().currentSwapchain->GetDesc(&scDesc) != S_OK)
+    if (!SwapchainContext_Dx::CurrentDesc(&scDesc))
     {
         LOG_ERROR("Can't get swapchain desc!");
         return;
@@ -270,6 +272,7 @@ HC_Dx12::HC_Dx12(std::string InName, ID3D12Device* InDevice)
 
     if (FAILED(hr))
     {
+        State::Instance().skipHeapCapture = false;
         LOG_ERROR("[{0}] CreateDescriptorHeap[0] error {1:x}", _name, hr);
         return;
     }
@@ -279,6 +282,8 @@ HC_Dx12::HC_Dx12(std::string InName, ID3D12Device* InDevice)
     heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
     hr = InDevice->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&_srvHeap[1]));
 
+    State::Instance().skipHeapCapture = false;
+
     if (FAILED(hr))
     {
         LOG_ERROR("[{0}] CreateDescriptorHeap[1] error {1:x}", _name, hr);
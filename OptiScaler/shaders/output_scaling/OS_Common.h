@@ -2,13 +2,7 @@
 #include <pch.h>
 #include <d3dcompiler.h>
 
-struct alignas(256) Constants
-{
-    int32_t srcWidth;
-    int32_t srcHeight;
-    int32_t destWidth;
-    int32_t destHeight;
-};
+#include "OS_Constants.h"
 
 // Lanczos with luminance correction
 inline static std::string downsampleCodeLanczos = R"(
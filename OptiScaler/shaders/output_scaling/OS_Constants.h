@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+// Constant buffer of the output scaling shaders, also used by the CPU versions in shaders/reference
+struct alignas(256) Constants
+{
+    int32_t srcWidth;
+    int32_t srcHeight;
+    int32_t destWidth;
+    int32_t destHeight;
+};
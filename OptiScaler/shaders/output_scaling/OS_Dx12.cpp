@@ -14,6 +14,9 @@
 #include <shaders/fsr1/FSR_EASU_Shader.h>
 
 #include <Config.h>
+#include <misc/GpuTimer_Dx12.h>
+#include <misc/TransientPool_Dx12.h>
+#include <misc/ShaderCache_Dx12.h>
 
 inline static DXGI_FORMAT TranslateTypelessFormats(DXGI_FORMAT format)
 {
@@ -48,7 +51,7 @@ static bool CreateComputeShader(ID3D12Device* device, ID3D12RootSignature* rootS
     psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
     psoDesc.CS = CD3DX12_SHADER_BYTECODE(shaderBlob->GetBufferPointer(), shaderBlob->GetBufferSize());
 
-    HRESULT hr = device->CreateComputePipelineState(&psoDesc, __uuidof(ID3D12PipelineState*), (void**) pipelineState);
+    HRESULT hr = ShaderCache_Dx12::CreateComputePipeline(device, psoDesc, pipelineState);
 
     if (FAILED(hr))
     {
@@ -75,7 +78,7 @@ bool OS_Dx12::CreateBufferResource(ID3D12Device* InDevice, ID3D12Resource* InSou
 
         if (bufDesc.Width != InWidth || bufDesc.Height != InHeight || bufDesc.Format != texDesc.Format)
         {
-            _buffer->Release();
+            TransientPool_Dx12::Release(_buffer, _bufferState);
             _buffer = nullptr;
         }
         else
@@ -99,23 +102,31 @@ bool OS_Dx12::CreateBufferResource(ID3D12Device* InDevice, ID3D12Resource* InSou
     texDesc.Width = InWidth;
     texDesc.Height = InHeight;
 
-    hr = InDevice->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &texDesc, InState, nullptr,
-                                           IID_PPV_ARGS(&_buffer));
+    TransientPool_Dx12::Texture texture;
 
-    if (hr != S_OK)
+    if (!TransientPool_Dx12::Acquire(InDevice, texDesc, heapProperties, InState, L"Bicubic_Buffer", texture,
+                                     { TransientPool_Dx12::UpscalerPass, TransientPool_Dx12::OutputScalingPass }))
     {
-        LOG_ERROR("[{0}] CreateCommittedResource result: {1:x}", _name, hr);
+        LOG_ERROR("[{0}] Can't acquire buffer", _name);
         return false;
     }
 
-    _buffer->SetName(L"Bicubic_Buffer");
-    _bufferState = InState;
+    _buffer = texture.resource;
+    _bufferState = texture.state;
+    _bufferNeedsInit = texture.needsInit;
+    _bufferInFrame = texture.inFrame;
 
     return true;
 }
 
 void OS_Dx12::SetBufferState(ID3D12GraphicsCommandList* InCommandList, D3D12_RESOURCE_STATES InState)
 {
+    if (_bufferNeedsInit || _bufferInFrame)
+    {
+        TransientPool_Dx12::BeforeFirstUse(InCommandList, _buffer, _bufferState);
+        _bufferNeedsInit = false;
+    }
+
     if (_bufferState == InState)
         return;
 
@@ -137,42 +148,12 @@ bool OS_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCmdL
 
     LOG_DEBUG("[{0}] Start!", _name);
 
-    _counter++;
-    _counter = _counter % 2;
+    GpuTimer_Dx12::Scope timer(InCmdList, GpuPass::OutputScaling);
 
-    if (_cpuSrvHandle[_counter].ptr == NULL)
-        _cpuSrvHandle[_counter] = _srvHeap[_counter]->GetCPUDescriptorHandleForHeapStart();
+    DescriptorRing_Dx12::Range range;
 
-    if (_cpuUavHandle[_counter].ptr == NULL)
-    {
-        _cpuUavHandle[_counter] = _cpuSrvHandle[_counter];
-        _cpuUavHandle[_counter].ptr +=
-            InDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-    }
-
-    if (_cpuCbvHandle[_counter].ptr == NULL)
-    {
-        _cpuCbvHandle[_counter] = _cpuUavHandle[_counter];
-        _cpuCbvHandle[_counter].ptr +=
-            InDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-    }
-
-    if (_gpuSrvHandle[_counter].ptr == NULL)
-        _gpuSrvHandle[_counter] = _srvHeap[_counter]->GetGPUDescriptorHandleForHeapStart();
-
-    if (_gpuUavHandle[_counter].ptr == NULL)
-    {
-        _gpuUavHandle[_counter] = _gpuSrvHandle[_counter];
-        _gpuUavHandle[_counter].ptr +=
-            InDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-    }
-
-    if (_gpuCbvHandle[_counter].ptr == NULL)
-    {
-        _gpuCbvHandle[_counter] = _gpuUavHandle[_counter];
-        _gpuCbvHandle[_counter].ptr +=
-            InDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-    }
+    if (!DescriptorRing_Dx12::AllocateTransient(InDevice, 3, range)) // SRV + UAV + CBV
+        return false;
 
     auto inDesc = InResource->GetDesc();
     auto outDesc = OutResource->GetDesc();
@@ -184,7 +165,7 @@ bool OS_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCmdL
     srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
     srvDesc.Texture2D.MipLevels = 1;
 
-    InDevice->CreateShaderResourceView(InResource, &srvDesc, _cpuSrvHandle[_counter]);
+    InDevice->CreateShaderResourceView(InResource, &srvDesc, range.Cpu(0));
 
     // Create UAV for Output Texture
     D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
@@ -192,7 +173,7 @@ bool OS_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCmdL
     uavDesc.ViewDimension = D3D12_UAV_DIMENSION_TEXTURE2D;
     uavDesc.Texture2D.MipSlice = 0;
 
-    InDevice->CreateUnorderedAccessView(OutResource, nullptr, &uavDesc, _cpuUavHandle[_counter]);
+    InDevice->CreateUnorderedAccessView(OutResource, nullptr, &uavDesc, range.Cpu(1));
 
     // Create CBV for Constants
     D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc = {};
@@ -236,17 +217,17 @@ bool OS_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCmdL
         cbvDesc.SizeInBytes = sizeof(constants);
     }
 
-    InDevice->CreateConstantBufferView(&cbvDesc, _cpuCbvHandle[_counter]);
+    InDevice->CreateConstantBufferView(&cbvDesc, range.Cpu(2));
 
-    ID3D12DescriptorHeap* heaps[] = { _srvHeap[_counter] };
-    InCmdList->SetDescriptorHeaps(_countof(heaps), heaps);
+    if (!DescriptorRing_Dx12::Bind(InCmdList, range))
+        return false;
 
     InCmdList->SetComputeRootSignature(_rootSignature);
     InCmdList->SetPipelineState(_pipelineState);
 
-    InCmdList->SetComputeRootDescriptorTable(0, _gpuSrvHandle[_counter]);
-    InCmdList->SetComputeRootDescriptorTable(1, _gpuUavHandle[_counter]);
-    InCmdList->SetComputeRootDescriptorTable(2, _gpuCbvHandle[_counter]);
+    InCmdList->SetComputeRootDescriptorTable(0, range.Gpu(0));
+    InCmdList->SetComputeRootDescriptorTable(1, range.Gpu(1));
+    InCmdList->SetComputeRootDescriptorTable(2, range.Gpu(2));
 
     UINT dispatchWidth = 0;
     UINT dispatchHeight = 0;
@@ -363,8 +344,7 @@ OS_Dx12::OS_Dx12(std::string InName, ID3D12Device* InDevice, bool InUpsample)
             break;
         }
 
-        hr = InDevice->CreateRootSignature(0, signatureBlob->GetBufferPointer(), signatureBlob->GetBufferSize(),
-                                           IID_PPV_ARGS(&_rootSignature));
+        hr = ShaderCache_Dx12::CreateRootSignature(InDevice, signatureBlob, &_rootSignature);
 
         if (FAILED(hr))
         {
@@ -444,8 +424,7 @@ OS_Dx12::OS_Dx12(std::string InName, ID3D12Device* InDevice, bool InUpsample)
             }
         }
 
-        auto hr = InDevice->CreateComputePipelineState(&computePsoDesc, __uuidof(ID3D12PipelineState*),
-                                                       (void**) &_pipelineState);
+        auto hr = ShaderCache_Dx12::CreateComputePipeline(InDevice, computePsoDesc, &_pipelineState);
 
         if (FAILED(hr))
         {
@@ -460,30 +439,36 @@ OS_Dx12::OS_Dx12(std::string InName, ID3D12Device* InDevice, bool InUpsample)
 
         if (_upsample)
         {
-            _recEncodeShader = OS_CompileShader(upsampleCode.c_str(), "CSMain", "cs_5_0");
+            _recEncodeShader = ShaderCache_Dx12::CompileShader(upsampleCode.c_str(), "CSMain", "cs_5_0",
+                                                               OS_CompileShader);
         }
         else
         {
             switch (Config::Instance()->OutputScalingDownscaler.value_or_default())
             {
             case 0:
-                _recEncodeShader = OS_CompileShader(downsampleCodeBC.c_str(), "CSMain", "cs_5_0");
+                _recEncodeShader = ShaderCache_Dx12::CompileShader(downsampleCodeBC.c_str(), "CSMain", "cs_5_0",
+                                                                   OS_CompileShader);
                 break;
 
             case 1:
-                _recEncodeShader = OS_CompileShader(downsampleCodeLanczos.c_str(), "CSMain", "cs_5_0");
+                _recEncodeShader = ShaderCache_Dx12::CompileShader(downsampleCodeLanczos.c_str(), "CSMain", "cs_5_0",
+                                                                   OS_CompileShader);
                 break;
 
             case 2:
-                _recEncodeShader = OS_CompileShader(downsampleCodeCatmull.c_str(), "CSMain", "cs_5_0");
+                _recEncodeShader = ShaderCache_Dx12::CompileShader(downsampleCodeCatmull.c_str(), "CSMain", "cs_5_0",
+                                                                   OS_CompileShader);
                 break;
 
             case 3:
-                _recEncodeShader = OS_CompileShader(downsampleCodeMAGIC.c_str(), "CSMain", "cs_5_0");
+                _recEncodeShader = ShaderCache_Dx12::CompileShader(downsampleCodeMAGIC.c_str(), "CSMain", "cs_5_0",
+                                                                   OS_CompileShader);
                 break;
 
             default:
-                _recEncodeShader = OS_CompileShader(downsampleCodeBC.c_str(), "CSMain", "cs_5_0");
+                _recEncodeShader = ShaderCache_Dx12::CompileShader(downsampleCodeBC.c_str(), "CSMain", "cs_5_0",
+                                                                   OS_CompileShader);
                 break;
             }
         }
@@ -508,39 +493,6 @@ OS_Dx12::OS_Dx12(std::string InName, ID3D12Device* InDevice, bool InUpsample)
         }
     }
 
-    D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
-    heapDesc.NumDescriptors = 3; // SRV + UAV + CBV
-    heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-    heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-
-    State::Instance().skipHeapCapture = true;
-
-    auto hr = InDevice->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&_srvHeap[0]));
-
-    if (FAILED(hr))
-    {
-        LOG_ERROR("[{0}] CreateDescriptorHeap[0] error {1:x}", _name, hr);
-        return;
-    }
-
-    hr = InDevice->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&_srvHeap[1]));
-
-    if (FAILED(hr))
-    {
-        LOG_ERROR("[{0}] CreateDescriptorHeap[1] error {1:x}", _name, hr);
-        return;
-    }
-
-    hr = InDevice->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&_srvHeap[2]));
-
-    State::Instance().skipHeapCapture = false;
-
-    if (FAILED(hr))
-    {
-        LOG_ERROR("[{0}] CreateDescriptorHeap[2] error {1:x}", _name, hr);
-        return;
-    }
-
     // FSR upscaling
     if (Config::Instance()->OutputScalingUseFsr.value_or_default())
     {
@@ -548,7 +500,7 @@ OS_Dx12::OS_Dx12(std::string InName, ID3D12Device* InDevice, bool InUpsample)
         InNumThreadsY = 16;
     }
 
-    _init = _srvHeap[2] != nullptr;
+    _init = DescriptorRing_Dx12::Init(InDevice);
 }
 
 OS_Dx12::~OS_Dx12()
@@ -593,27 +545,9 @@ OS_Dx12::~OS_Dx12()
         _rootSignature = nullptr;
     }
 
-    if (_srvHeap[0] != nullptr)
-    {
-        _srvHeap[0]->Release();
-        _srvHeap[0] = nullptr;
-    }
-
-    if (_srvHeap[1] != nullptr)
-    {
-        _srvHeap[1]->Release();
-        _srvHeap[1] = nullptr;
-    }
-
-    if (_srvHeap[2] != nullptr)
-    {
-        _srvHeap[2]->Release();
-        _srvHeap[2] = nullptr;
-    }
-
     if (_buffer != nullptr)
     {
-        _buffer->Release();
+        TransientPool_Dx12::Release(_buffer, _bufferState);
         _buffer = nullptr;
     }
 
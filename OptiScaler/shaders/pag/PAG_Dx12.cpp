@@ -1,5 +1,6 @@
 #include "PAG_Dx12.h"
 #include "../Config.h"
+#include "../misc/DeferredRelease_Dx12.h"
 
 inline static DXGI_FORMAT GetDepthFormat(DXGI_FORMAT InFormat)
 {
@@ -100,7 +101,7 @@ inline static bool CreateReferencedResource(ID3D12Device* InDevice, ID3D12Resour
         if (bufDesc.Width != (UINT64) (texDesc.Width) || bufDesc.Height != (UINT) (texDesc.Height) ||
             bufDesc.Format != texDesc.Format)
         {
-            (*OutResource)->Release();
+            DeferredRelease_Dx12::Release(*OutResource, "PAG buffer");
             *OutResource = nullptr;
         }
         else
@@ -0,0 +1,530 @@
+#pragma once
+#include <pch.h>
+#include <d3dcompiler.h>
+
+// RCAS, output scaling and the format conversion of FT in a single dispatch.
+//
+// Permutations are selected with defines which are added in front of the code before compiling:
+// SCALE_KERNEL     0 = None | 1 = Bicubic | 2 = Lanczos | 3 = Catmull-Rom | 4 = MAGC | 5 = Bicubic upsample
+// SHARPEN          0 or 1, RCAS of the source
+// DYNAMIC_SHARPEN  0 or 1, motion adaptive sharpness
+// OUTPUT_FORMAT    0 = Typed view | 1 = R10G10B10A2 | 2 = R8G8B8A8 | 3 = B8G8R8A8, packed through a R32_UINT view
+//
+// Sharpened source texels which are needed by a group are computed once into LDS, scale kernels read
+// them from there. Math of the scale kernels is the same as OS_Common.h, RCAS is the same as RCAS_Common.h.
+// shaders/reference/PF_Reference.h is the CPU version which is used to compare it with the separate passes.
+inline static std::string pfCode = R"(
+cbuffer Params : register(b0)
+{
+    int SrcWidth;
+    int SrcHeight;
+    int DstWidth;
+    int DstHeight;
+
+    float Sharpness;
+    float Contrast;
+    int DisplaySizeMV;
+    int Debug;
+
+    float MotionSharpness;
+    float MotionTextureScale;
+    float MvScaleX;
+    float MvScaleY;
+    float Threshold;
+    float ScaleLimit;
+};
+
+Texture2D<float4> Source : register(t0);
+Texture2D<float2> Motion : register(t1);
+
+#if OUTPUT_FORMAT == 0
+RWTexture2D<float4> Dest : register(u0);
+#else
+RWTexture2D<uint> Dest : register(u0);
+#endif
+
+#define GROUP_SIZE 16
+#define GROUP_COUNT (GROUP_SIZE * GROUP_SIZE)
+
+// 27 KB of LDS, enough for 2.5x downscaling with Lanczos, texels outside of it are computed directly
+#define TILE_SIZE 48
+
+#if SCALE_KERNEL == 2
+#define TAP_COUNT 7
+#else
+#define TAP_COUNT 4
+#endif
+
+groupshared float g_R[TILE_SIZE * TILE_SIZE];
+groupshared float g_G[TILE_SIZE * TILE_SIZE];
+groupshared float g_B[TILE_SIZE * TILE_SIZE];
+
+float getRCASLuma(float3 rgb)
+{
+    return dot(rgb, float3(0.5, 1.0, 0.5));
+}
+
+float luminance(float3 color)
+{
+    return dot(color, float3(0.2126, 0.7152, 0.0722));
+}
+
+float3 LoadSource(int2 pos)
+{
+    return Source.Load(int3(pos, 0)).rgb;
+}
+
+#if SHARPEN
+float3 Rcas(int2 pos)
+{
+    float setSharpness = Sharpness;
+
+#if DYNAMIC_SHARPEN
+    float2 mv;
+    float motion;
+    float add = 0.0f;
+
+    if (DisplaySizeMV > 0)
+        mv = Motion.Load(int3(pos.x, pos.y, 0)).rg;
+    else
+        mv = Motion.Load(int3(pos.x * MotionTextureScale, pos.y * MotionTextureScale, 0)).rg;
+
+    motion = max(abs(mv.r * MvScaleX), abs(mv.g * MvScaleY));
+
+    if (motion > Threshold)
+        add = (motion / (ScaleLimit - Threshold)) * MotionSharpness;
+
+    if ((add > MotionSharpness && MotionSharpness > 0.0f) || (add < MotionSharpness && MotionSharpness < 0.0f))
+        add = MotionSharpness;
+
+    setSharpness += add;
+
+    if (setSharpness > 1.3f)
+        setSharpness = 1.3f;
+    else if (setSharpness < 0.0f)
+        setSharpness = 0.0f;
+#endif
+
+    float3 e = LoadSource(pos);
+
+    // skip sharpening if set value == 0
+    if (setSharpness == 0.0f)
+    {
+#if DYNAMIC_SHARPEN
+        if (Debug > 0 && Sharpness > 0)
+            e.g *= 1 + (12.0f * Sharpness);
+#endif
+        return e;
+    }
+
+    float3 b = LoadSource(int2(pos.x, pos.y - 1));
+    float3 d = LoadSource(int2(pos.x - 1, pos.y));
+    float3 f = LoadSource(int2(pos.x + 1, pos.y));
+    float3 h = LoadSource(int2(pos.x, pos.y + 1));
+
+    // Min and max of ring.
+    float3 minRGB = min(min(b, d), min(f, h));
+    float3 maxRGB = max(max(b, d), max(f, h));
+
+    // Immediate constants for peak range.
+    float2 peakC = float2(1.0, -4.0);
+
+    // Standard RCAS limiters
+    float3 hitMin = minRGB * rcp(4.0 * maxRGB);
+    float3 hitMax = (peakC.xxx - maxRGB) * rcp(4.0 * minRGB + peakC.yyy);
+    float3 lobeRGB = max(-hitMin, hitMax);
+    float lobe = max(-0.1875, min(max(lobeRGB.r, max(lobeRGB.g, lobeRGB.b)), 0.0)) * setSharpness;
+
+    // Apply contrast adaptation only if Contrast > 0
+    if (Contrast >= -10.0)
+    {
+        float3 amp = saturate(min(minRGB, 2.0 - maxRGB) / max(maxRGB, 1e-5));
+        amp = rsqrt(amp);
+
+        float peak = -3.0 * Contrast + 8.0;
+        float contrastFactor = 1.0 / max(amp.g * peak, 1.0);
+
+        lobe *= lerp(1.0, contrastFactor, Contrast);
+    }
+
+    // Resolve with medium precision rcp
+    float rcpL = rcp(4.0 * lobe + 1.0);
+    float3 output = ((b + d + f + h) * lobe + e) * rcpL;
+
+#if DYNAMIC_SHARPEN
+    if (Debug > 0)
+    {
+        if (Sharpness < setSharpness)
+            output.r *= 1 + (12.0f * (setSharpness - Sharpness));
+        else
+            output.g *= 1 + (12.0f * (Sharpness - setSharpness));
+    }
+#endif
+
+    return output;
+}
+#endif
+
+// Texel of the intermediate image of the separate passes, which is zero outside of the source
+float3 FetchSource(int2 pos)
+{
+    if (pos.x < 0 || pos.y < 0 || pos.x >= SrcWidth || pos.y >= SrcHeight)
+        return 0;
+
+#if SHARPEN
+    return Rcas(pos);
+#else
+    return LoadSource(pos);
+#endif
+}
+
+float2 SourceScale()
+{
+    return float2(SrcWidth, SrcHeight) / float2(DstWidth, DstHeight);
+}
+
+// Smallest texel coordinate the kernel reads for an output pixel, before clamping
+int2 FirstTap(uint2 pos)
+{
+#if SCALE_KERNEL == 1
+    float2 uv = float2(pos.x / (DstWidth - 1.0f), pos.y / (DstHeight - 1.0f));
+    return int2(floor(uv * float2(SrcWidth, SrcHeight))) - 1;
+#elif SCALE_KERNEL == 2
+    return int2(float2(pos) * SourceScale()) - 3;
+#elif SCALE_KERNEL == 5
+    return int2(floor((pos + 0.5) * SourceScale() - 1.5));
+#else
+    return int2(float2(pos) * SourceScale()) - 1;
+#endif
+}
+
+void StoreTile(uint index, float3 rgb)
+{
+    g_R[index] = rgb.r;
+    g_G[index] = rgb.g;
+    g_B[index] = rgb.b;
+}
+
+static int2 g_TileOrigin;
+static int2 g_TileSize;
+
+float3 LoadTap(int2 pos)
+{
+    int2 tile = pos - g_TileOrigin;
+
+    if (tile.x < 0 || tile.y < 0 || tile.x >= g_TileSize.x || tile.y >= g_TileSize.y)
+        return FetchSource(pos);
+
+    uint index = tile.x + tile.y * TILE_SIZE;
+    return float3(g_R[index], g_G[index], g_B[index]);
+}
+
+#if SCALE_KERNEL == 1
+float bicubic_weight(float x)
+{
+    float a = -0.75f;
+    float absX = abs(x);
+    if (absX <= 1.0f)
+        return (a + 2.0f) * absX * absX * absX - (a + 3.0f) * absX * absX + 1.0f;
+    else if (absX < 2.0f)
+        return a * absX * absX * absX - 5.0f * a * absX * absX + 8.0f * a * absX - 4.0f * a;
+    else
+        return 0.0f;
+}
+#elif SCALE_KERNEL == 2
+float lanczosKernel(float x, float radius, float pi)
+{
+    if (x == 0.0) return 1.0;
+    if (x > radius) return 0.0;
+
+    x *= pi;
+    return (sin(x) / x) * (sin(x / radius) / (x / radius));
+}
+#elif SCALE_KERNEL == 3
+float catmullRom(float x)
+{
+    x = abs(x);
+
+    if (x < 1.0)
+        return (1.5 * x - 2.5) * x * x + 1.0;
+    else if (x < 2.0)
+        return ((-0.5 * x + 2.5) * x - 4.0) * x + 2.0;
+
+    return 0.0;
+}
+#elif SCALE_KERNEL == 4
+float magcKernel(float x)
+{
+    x = abs(x);
+
+    if (x <= 1.0)
+        return 1.0 - 2.0 * x * x + x * x * x;
+    else if (x <= 2.0)
+        return 4.0 - 8.0 * x + 5.0 * x * x - x * x * x;
+
+    return 0.0;
+}
+#elif SCALE_KERNEL == 5
+float W1(float x, float A)
+{
+    return x * x * ((A + 2) * x - (A + 3)) + 1.0;
+}
+
+float W2(float x, float A)
+{
+    return A * (x * (x * (x - 5) + 8) - 4);
+}
+
+float4 ComputeWeights(float d1, float A)
+{
+    return float4(W2(1.0 + d1, A), W1(d1, A), W1(1.0 - d1, A), W2(2.0 - d1, A));
+}
+
+// Same 16 discrete offsets as the weight table of the upsample pass
+float4 GetBicubicFilterWeights(float offset)
+{
+    return ComputeWeights(((uint) (offset * 16.0) + 0.5) / 16.0, -0.5);
+}
+#endif
+
+// Scales the color to the average luminance when it deviates too much
+float3 CorrectLuminance(float3 color, float avgLuminance)
+{
+    float currentLuminance = luminance(color);
+
+    if (abs(currentLuminance - avgLuminance) > 0.5)
+        color *= avgLuminance / max(currentLuminance, 1e-5);
+
+    return color;
+}
+
+float3 Scale(uint2 pos)
+{
+#if SCALE_KERNEL == 1
+    float2 uv = float2(pos.x / (DstWidth - 1.0f), pos.y / (DstHeight - 1.0f));
+    float2 pixel = uv * float2(SrcWidth, SrcHeight);
+    float2 texel = floor(pixel);
+    float2 t = pixel - texel;
+    t = t * t * (3.0f - 2.0f * t);
+
+    float3 samples[16];
+    float avgLuminance = 0.0;
+
+    [unroll]
+    for (int i = 0; i < 16; i++)
+    {
+        samples[i] = LoadTap(int2(texel) + int2(i % 4 - 1, i / 4 - 1));
+        avgLuminance += luminance(samples[i]);
+    }
+
+    avgLuminance /= 16.0;
+
+    float3 result = 0.0;
+
+    [unroll]
+    for (int j = 0; j < 16; j++)
+    {
+        float weight = bicubic_weight((j % 4 - 1) - t.x) * bicubic_weight((j / 4 - 1) - t.y);
+        result += CorrectLuminance(samples[j], avgLuminance) * weight;
+    }
+
+    return result;
+
+#elif SCALE_KERNEL == 2
+    const float lanczosRadius = 3.0;
+    const float pi = 3.14159265359;
+
+    float2 sourcePos = float2(pos) * SourceScale();
+    float2 maxPos = float2(SrcWidth - 1, SrcHeight - 1);
+    float avgLuminance = 0.0;
+
+    for (int dy = -1; dy <= 2; dy++)
+    {
+        for (int dx = -1; dx <= 2; dx++)
+        {
+            int2 sampleCoords = sourcePos + int2(dx, dy);
+            sampleCoords = clamp(sampleCoords, int2(0, 0), int2(SrcWidth - 1, SrcHeight - 1));
+            avgLuminance += luminance(LoadTap(sampleCoords));
+        }
+    }
+
+    avgLuminance /= 16.0;
+
+    float3 color = 0.0;
+    float totalWeight = 0.0;
+
+    for (int y = -int(lanczosRadius); y <= int(lanczosRadius); y++)
+    {
+        for (int x = -int(lanczosRadius); x <= int(lanczosRadius); x++)
+        {
+            float2 samplePos = clamp(sourcePos + float2(x, y), float2(0, 0), maxPos);
+            float3 sampleColor = CorrectLuminance(LoadTap(int2(samplePos)), avgLuminance);
+
+            // Separate pass multiplies with both components of a float2 which holds the product
+            float2 dist = abs(samplePos - sourcePos);
+            float weight = lanczosKernel(dist.x, lanczosRadius, pi) * lanczosKernel(dist.y, lanczosRadius, pi);
+            weight *= weight;
+
+            color += sampleColor * weight;
+            totalWeight += weight;
+        }
+    }
+
+    return color / totalWeight;
+
+#elif SCALE_KERNEL == 3 || SCALE_KERNEL == 4
+    float2 sourcePos = float2(pos) * SourceScale();
+    int2 sourceBase = int2(sourcePos);
+    float2 fraction = frac(sourcePos);
+
+    float3 samples[16];
+    float avgLuminance = 0.0;
+
+    [unroll]
+    for (int i = 0; i < 16; i++)
+    {
+        int2 sampleCoords = sourceBase + int2(i % 4 - 1, i / 4 - 1);
+        sampleCoords = clamp(sampleCoords, int2(0, 0), int2(SrcWidth - 1, SrcHeight - 1));
+        samples[i] = LoadTap(sampleCoords);
+        avgLuminance += luminance(samples[i]);
+    }
+
+    avgLuminance /= 16.0;
+
+    float3 color = 0.0;
+    float totalWeight = 0.0;
+
+    [unroll]
+    for (int j = 0; j < 16; j++)
+    {
+#if SCALE_KERNEL == 3
+        float weight = catmullRom(float(j % 4 - 1) - fraction.x) * catmullRom(float(j / 4 - 1) - fraction.y);
+#else
+        float weight = magcKernel(float(j % 4 - 1) - fraction.x) * magcKernel(float(j / 4 - 1) - fraction.y);
+#endif
+        color += CorrectLuminance(samples[j], avgLuminance) * weight;
+        totalWeight += weight;
+    }
+
+    return color / totalWeight;
+
+#elif SCALE_KERNEL == 5
+    float2 topLeftSample = (pos + 0.5) * SourceScale() - 1.5;
+    float2 phase = frac(topLeftSample);
+    int2 base = int2(floor(topLeftSample));
+
+    float4 xWeights = GetBicubicFilterWeights(phase.x);
+    float4 yWeights = GetBicubicFilterWeights(phase.y);
+
+    float3 result = 0.0;
+
+    [unroll]
+    for (int y = 0; y < 4; y++)
+    {
+        float3 row = 0.0;
+
+        [unroll]
+        for (int x = 0; x < 4; x++)
+            row += LoadTap(base + int2(x, y)) * xWeights[x];
+
+        result += row * yWeights[y];
+    }
+
+    return result;
+
+#else
+    return FetchSource(int2(pos));
+#endif
+}
+
+void WriteOutput(uint2 pos, float3 rgb, float alpha)
+{
+#if OUTPUT_FORMAT == 0
+    Dest[pos] = float4(rgb, alpha);
+#else
+    float4 color = saturate(float4(rgb, alpha));
+
+#if OUTPUT_FORMAT == 1
+    uint R = (uint) (color.r * 1023.0f);
+    uint G = (uint) (color.g * 1023.0f);
+    uint B = (uint) (color.b * 1023.0f);
+    uint A = (uint) (color.a * 3.0f);
+
+    Dest[pos] = R | G << 10 | B << 20 | A << 30;
+#else
+    uint R = (uint) (color.r * 255.0f);
+    uint G = (uint) (color.g * 255.0f);
+    uint B = (uint) (color.b * 255.0f);
+    uint A = (uint) (color.a * 255.0f);
+
+#if OUTPUT_FORMAT == 2
+    Dest[pos] = R | G << 8 | B << 16 | A << 24;
+#else
+    Dest[pos] = B | G << 8 | R << 16 | A << 24;
+#endif
+#endif
+#endif
+}
+
+[numthreads(GROUP_SIZE, GROUP_SIZE, 1)]
+void CSMain(uint3 DTid : SV_DispatchThreadID, uint3 Gid : SV_GroupID, uint GI : SV_GroupIndex)
+{
+#if SCALE_KERNEL != 0
+    // Same values for the whole group, every thread computes them
+    uint2 groupStart = Gid.xy * GROUP_SIZE;
+    uint2 groupEnd = min(groupStart + GROUP_SIZE - 1, uint2(DstWidth - 1, DstHeight - 1));
+
+    g_TileOrigin = FirstTap(groupStart);
+    g_TileSize = clamp(FirstTap(groupEnd) + TAP_COUNT - g_TileOrigin, 0, TILE_SIZE);
+
+    for (uint i = GI; i < (uint) (g_TileSize.x * g_TileSize.y); i += GROUP_COUNT)
+    {
+        uint2 tile = uint2(i % g_TileSize.x, i / g_TileSize.x);
+        StoreTile(tile.x + tile.y * TILE_SIZE, FetchSource(g_TileOrigin + int2(tile)));
+    }
+
+    GroupMemoryBarrierWithGroupSync();
+#endif
+
+    if (DTid.x >= (uint) DstWidth || DTid.y >= (uint) DstHeight)
+        return;
+
+    float3 color = Scale(DTid.xy);
+
+    // Alpha is not filtered, nearest source texel
+    int2 alphaPos = clamp(int2((DTid.xy + 0.5) * SourceScale()), int2(0, 0), int2(SrcWidth - 1, SrcHeight - 1));
+    float alpha = Source.Load(int3(alphaPos, 0)).a;
+
+    WriteOutput(DTid.xy, color, alpha);
+}
+)";
+
+inline static ID3DBlob* PF_CompileShader(const char* shaderCode, const char* entryPoint, const char* target)
+{
+    ID3DBlob* shaderBlob = nullptr;
+    ID3DBlob* errorBlob = nullptr;
+
+    HRESULT hr = D3DCompile(shaderCode, strlen(shaderCode), nullptr, nullptr, nullptr, entryPoint, target,
+                            D3DCOMPILE_OPTIMIZATION_LEVEL3, 0, &shaderBlob, &errorBlob);
+
+    if (FAILED(hr))
+    {
+        LOG_ERROR("error while compiling shader");
+
+        if (errorBlob)
+        {
+            LOG_ERROR("error while compiling shader : {0}", (char*) errorBlob->GetBufferPointer());
+            errorBlob->Release();
+        }
+
+        if (shaderBlob)
+            shaderBlob->Release();
+
+        return nullptr;
+    }
+
+    if (errorBlob)
+        errorBlob->Release();
+
+    return shaderBlob;
+}
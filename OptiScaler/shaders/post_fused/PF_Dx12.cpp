@@ -0,0 +1,365 @@
+#include "PF_Dx12.h"
+
+#include <Config.h>
+#include <misc/GpuTimer_Dx12.h>
+#include <misc/ShaderCache_Dx12.h>
+
+inline static DXGI_FORMAT TranslateTypelessFormats(DXGI_FORMAT format)
+{
+    switch (format)
+    {
+    case DXGI_FORMAT_R32G32B32A32_TYPELESS:
+        return DXGI_FORMAT_R32G32B32A32_FLOAT;
+    case DXGI_FORMAT_R32G32B32_TYPELESS:
+        return DXGI_FORMAT_R32G32B32_FLOAT;
+    case DXGI_FORMAT_R16G16B16A16_TYPELESS:
+        return DXGI_FORMAT_R16G16B16A16_FLOAT;
+    case DXGI_FORMAT_R10G10B10A2_TYPELESS:
+        return DXGI_FORMAT_R10G10B10A2_UNORM;
+    case DXGI_FORMAT_R8G8B8A8_TYPELESS:
+        return DXGI_FORMAT_R8G8B8A8_UNORM;
+    case DXGI_FORMAT_B8G8R8A8_TYPELESS:
+        return DXGI_FORMAT_B8G8R8A8_UNORM;
+    case DXGI_FORMAT_R16G16_TYPELESS:
+        return DXGI_FORMAT_R16G16_FLOAT;
+    case DXGI_FORMAT_R32G32_TYPELESS:
+        return DXGI_FORMAT_R32G32_FLOAT;
+    default:
+        return format;
+    }
+}
+
+uint32_t PF_Dx12::PermutationKey(ScaleKernel InKernel, bool InSharpen, bool InDynamicSharpen, OutputFormat InFormat)
+{
+    return (uint32_t) InKernel | (InSharpen ? 0x10 : 0) | (InDynamicSharpen ? 0x20 : 0) | ((uint32_t) InFormat << 8);
+}
+
+PF_Dx12::ScaleKernel PF_Dx12::GetScaleKernel(uint32_t InSrcWidth, uint32_t InDstWidth)
+{
+    if (InSrcWidth < InDstWidth)
+        return ScaleKernel::BicubicUpsample;
+
+    switch (Config::Instance()->OutputScalingDownscaler.value_or_default())
+    {
+    case 1:
+        return ScaleKernel::Lanczos;
+
+    case 2:
+        return ScaleKernel::Catmull;
+
+    case 3:
+        return ScaleKernel::Magc;
+
+    default:
+        return ScaleKernel::Bicubic;
+    }
+}
+
+PF_Dx12::OutputFormat PF_Dx12::GetOutputFormat(DXGI_FORMAT InFormat)
+{
+    // These can have a R32_UINT view, shader packs the texels like FT does
+    switch (InFormat)
+    {
+    case DXGI_FORMAT_R10G10B10A2_TYPELESS:
+        return OutputFormat::R10G10B10A2;
+
+    case DXGI_FORMAT_R8G8B8A8_TYPELESS:
+        return OutputFormat::R8G8B8A8;
+
+    case DXGI_FORMAT_B8G8R8A8_TYPELESS:
+        return OutputFormat::B8G8R8A8;
+
+    default:
+        return OutputFormat::Typed;
+    }
+}
+
+ID3D12PipelineState* PF_Dx12::CreatePipeline(std::string InName, ID3D12Device* InDevice,
+                                             ID3D12RootSignature* InRootSignature, uint32_t InKey)
+{
+    auto code = std::format("#define SCALE_KERNEL {}\n#define SHARPEN {}\n#define DYNAMIC_SHARPEN {}\n"
+                            "#define OUTPUT_FORMAT {}\n",
+                            InKey & 0x0F, (InKey & 0x10) ? 1 : 0, (InKey & 0x20) ? 1 : 0, InKey >> 8);
+    code += pfCode;
+
+    ID3DBlob* shaderBlob = ShaderCache_Dx12::CompileShader(code.c_str(), "CSMain", "cs_5_0", PF_CompileShader);
+
+    if (shaderBlob == nullptr)
+    {
+        LOG_ERROR("[{0}] PF_CompileShader error!", InName);
+        return nullptr;
+    }
+
+    D3D12_COMPUTE_PIPELINE_STATE_DESC psoDesc = {};
+    psoDesc.pRootSignature = InRootSignature;
+    psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
+    psoDesc.CS = CD3DX12_SHADER_BYTECODE(shaderBlob->GetBufferPointer(), shaderBlob->GetBufferSize());
+
+    ID3D12PipelineState* pipelineState = nullptr;
+    auto hr = ShaderCache_Dx12::CreateComputePipeline(InDevice, psoDesc, &pipelineState);
+
+    shaderBlob->Release();
+
+    if (FAILED(hr))
+    {
+        LOG_ERROR("[{0}] CreateComputePipelineState error: {1:X}", InName, (UINT) hr);
+        return nullptr;
+    }
+
+    return pipelineState;
+}
+
+ID3D12PipelineState* PF_Dx12::GetPipeline(ID3D12Device* InDevice, uint32_t InKey)
+{
+    for (auto& pipeline : _pipelines)
+    {
+        if (pipeline.key != InKey)
+            continue;
+
+        if (pipeline.compile.valid())
+        {
+            // D3DCompile takes tens of milliseconds, the render thread doesn't wait for it
+            if (pipeline.compile.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                return nullptr;
+
+            pipeline.pipelineState = pipeline.compile.get();
+            LOG_DEBUG("[{0}] Permutation {1:X} ready: {2}", _name, InKey, pipeline.pipelineState != nullptr);
+        }
+
+        return pipeline.pipelineState;
+    }
+
+    LOG_DEBUG("[{0}] Compiling permutation {1:X}", _name, InKey);
+
+    // Failed permutations are kept too, so they are not compiled again every frame
+    auto& pipeline = _pipelines.emplace_back();
+    pipeline.key = InKey;
+    pipeline.compile = std::async(std::launch::async, CreatePipeline, _name, InDevice, _rootSignature, InKey);
+
+    return nullptr;
+}
+
+bool PF_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCmdList, ID3D12Resource* InResource,
+                       ID3D12Resource* InMotionVectors, RcasConstants InConstants, ID3D12Resource* OutResource)
+{
+    if (!_init || InDevice == nullptr || InCmdList == nullptr || InResource == nullptr || OutResource == nullptr ||
+        InMotionVectors == nullptr || State::Instance().currentFeature == nullptr)
+        return false;
+
+    auto feature = State::Instance().currentFeature;
+    auto outDesc = OutResource->GetDesc();
+
+    auto dynamicSharpen = Config::Instance()->MotionSharpnessEnabled.value_or_default();
+    auto sharpen = InConstants.Sharpness > 0.0f || dynamicSharpen;
+    auto kernel = GetScaleKernel(feature->TargetWidth(), feature->DisplayWidth());
+    auto format = GetOutputFormat(outDesc.Format);
+
+    auto pipelineState = GetPipeline(InDevice, PermutationKey(kernel, sharpen, dynamicSharpen, format));
+
+    if (pipelineState == nullptr)
+        return false;
+
+    DescriptorRing_Dx12::Range range;
+
+    if (!DescriptorRing_Dx12::AllocateTransient(InDevice, 3, range)) // SRV x 2 + UAV
+        return false;
+
+    LOG_DEBUG("[{0}] Start!", _name);
+
+    GpuTimer_Dx12::Scope timer(InCmdList, GpuPass::PostFused);
+
+    auto inDesc = InResource->GetDesc();
+    auto mvDesc = InMotionVectors->GetDesc();
+
+    // Create SRV for Input Texture
+    D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+    srvDesc.Format = TranslateTypelessFormats(inDesc.Format);
+    srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+    srvDesc.Texture2D.MipLevels = 1;
+
+    InDevice->CreateShaderResourceView(InResource, &srvDesc, range.Cpu(0));
+
+    // Create SRV for Motion Texture
+    D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc2 = {};
+    srvDesc2.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+    srvDesc2.Format = TranslateTypelessFormats(mvDesc.Format);
+    srvDesc2.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+    srvDesc2.Texture2D.MipLevels = 1;
+
+    InDevice->CreateShaderResourceView(InMotionVectors, &srvDesc2, range.Cpu(1));
+
+    // Create UAV for Output Texture
+    D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+    uavDesc.Format = format == OutputFormat::Typed ? TranslateTypelessFormats(outDesc.Format) : DXGI_FORMAT_R32_UINT;
+    uavDesc.ViewDimension = D3D12_UAV_DIMENSION_TEXTURE2D;
+    uavDesc.Texture2D.MipSlice = 0;
+
+    InDevice->CreateUnorderedAccessView(OutResource, nullptr, &uavDesc, range.Cpu(2));
+
+    InternalConstants constants {};
+    constants.SrcWidth = feature->TargetWidth();
+    constants.SrcHeight = feature->TargetHeight();
+    constants.DstWidth = feature->DisplayWidth();
+    constants.DstHeight = feature->DisplayHeight();
+
+    if (Config::Instance()->ContrastEnabled.value_or_default())
+        constants.Contrast = Config::Instance()->Contrast.value_or_default() * -1.0f;
+    else
+        constants.Contrast = -100.0f;
+
+    constants.Sharpness = InConstants.Sharpness;
+    constants.DisplaySizeMV = InConstants.DisplaySizeMV ? 1 : 0;
+    constants.Debug = Config::Instance()->MotionSharpnessDebug.value_or_default() ? 1 : 0;
+    constants.MotionSharpness = Config::Instance()->MotionSharpness.value_or_default();
+    constants.MvScaleX = InConstants.MvScaleX;
+    constants.MvScaleY = InConstants.MvScaleY;
+    constants.Threshold = Config::Instance()->MotionThreshold.value_or_default();
+    constants.ScaleLimit = Config::Instance()->MotionScaleLimit.value_or_default();
+
+    if (InConstants.RenderWidth == 0 || InConstants.DisplayWidth == 0)
+        constants.MotionTextureScale = 1.0f;
+    else
+        constants.MotionTextureScale = (float) InConstants.RenderWidth / (float) InConstants.DisplayWidth;
+
+    if (!DescriptorRing_Dx12::Bind(InCmdList, range))
+        return false;
+
+    InCmdList->SetComputeRootSignature(_rootSignature);
+    InCmdList->SetPipelineState(pipelineState);
+
+    InCmdList->SetComputeRoot32BitConstants(0, sizeof(constants) / 4, &constants, 0);
+    InCmdList->SetComputeRootDescriptorTable(1, range.Gpu(0));
+
+    UINT dispatchWidth = (constants.DstWidth + InNumThreadsX - 1) / InNumThreadsX;
+    UINT dispatchHeight = (constants.DstHeight + InNumThreadsY - 1) / InNumThreadsY;
+
+    InCmdList->Dispatch(dispatchWidth, dispatchHeight, 1);
+
+    return true;
+}
+
+PF_Dx12::PF_Dx12(std::string InName, ID3D12Device* InDevice) : _name(InName), _device(InDevice)
+{
+    if (InDevice == nullptr)
+    {
+        LOG_ERROR("InDevice is nullptr!");
+        return;
+    }
+
+    LOG_DEBUG("{0} start!", _name);
+
+    // Describe and create the root signature
+    // ---------------------------------------------------
+    D3D12_DESCRIPTOR_RANGE descriptorRange[2];
+
+    // SRV Range (Input and Motion Textures)
+    descriptorRange[0].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+    descriptorRange[0].NumDescriptors = 2;
+    descriptorRange[0].BaseShaderRegister = 0; // t0 - t1
+    descriptorRange[0].RegisterSpace = 0;
+    descriptorRange[0].OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
+
+    // UAV Range (Output Texture)
+    descriptorRange[1].RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_UAV;
+    descriptorRange[1].NumDescriptors = 1;
+    descriptorRange[1].BaseShaderRegister = 0; // u0
+    descriptorRange[1].RegisterSpace = 0;
+    descriptorRange[1].OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
+
+    // Define the root parameters
+    // ---------------------------------------------------
+    D3D12_ROOT_PARAMETER rootParameters[2];
+
+    // Constants are small enough to be set directly, no constant buffer is needed
+    rootParameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+    rootParameters[0].Constants.ShaderRegister = 0; // b0
+    rootParameters[0].Constants.RegisterSpace = 0;
+    rootParameters[0].Constants.Num32BitValues = sizeof(InternalConstants) / 4;
+    rootParameters[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+
+    // One table for all views, they are allocated together from the descriptor ring
+    rootParameters[1].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+    rootParameters[1].DescriptorTable.NumDescriptorRanges = 2;
+    rootParameters[1].DescriptorTable.pDescriptorRanges = descriptorRange;
+    rootParameters[1].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+
+    // A root signature is an array of root parameters
+    // ---------------------------------------------------
+    D3D12_ROOT_SIGNATURE_DESC rootSigDesc;
+    rootSigDesc.NumParameters = 2;
+    rootSigDesc.pParameters = rootParameters;
+    rootSigDesc.NumStaticSamplers = 0;
+    rootSigDesc.pStaticSamplers = nullptr;
+    rootSigDesc.Flags = D3D12_ROOT_SIGNATURE_FLAG_NONE;
+
+    ID3DBlob* errorBlob = nullptr;
+    ID3DBlob* signatureBlob = nullptr;
+
+    do
+    {
+        auto hr = D3D12SerializeRootSignature(&rootSigDesc, D3D_ROOT_SIGNATURE_VERSION_1, &signatureBlob, &errorBlob);
+
+        if (FAILED(hr))
+        {
+            LOG_ERROR("[{0}] D3D12SerializeRootSignature error {1:x}", _name, (unsigned int) hr);
+            break;
+        }
+
+        hr = ShaderCache_Dx12::CreateRootSignature(InDevice, signatureBlob, &_rootSignature);
+
+        if (FAILED(hr))
+        {
+            LOG_ERROR("[{0}] CreateRootSignature error {1:x}", _name, (unsigned int) hr);
+            break;
+        }
+
+    } while (false);
+
+    if (errorBlob != nullptr)
+    {
+        errorBlob->Release();
+        errorBlob = nullptr;
+    }
+
+    if (signatureBlob != nullptr)
+    {
+        signatureBlob->Release();
+        signatureBlob = nullptr;
+    }
+
+    if (_rootSignature == nullptr)
+    {
+        LOG_ERROR("[{0}] _rootSignature is null!", _name);
+        return;
+    }
+
+    _init = DescriptorRing_Dx12::Init(InDevice);
+}
+
+PF_Dx12::~PF_Dx12()
+{
+    if (!_init || State::Instance().isShuttingDown)
+        return;
+
+    for (auto& pipeline : _pipelines)
+    {
+        // Worker uses the root signature, wait for it before releasing anything
+        if (pipeline.compile.valid())
+            pipeline.pipelineState = pipeline.compile.get();
+
+        if (pipeline.pipelineState != nullptr)
+        {
+            pipeline.pipelineState->Release();
+            pipeline.pipelineState = nullptr;
+        }
+    }
+
+    _pipelines.clear();
+
+    if (_rootSignature != nullptr)
+    {
+        _rootSignature->Release();
+        _rootSignature = nullptr;
+    }
+}
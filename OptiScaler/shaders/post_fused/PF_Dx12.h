@@ -0,0 +1,97 @@
+#pragma once
+
+#include <pch.h>
+
+#include "PF_Common.h"
+
+#include <shaders/rcas/RCAS_Common.h>
+#include <misc/DescriptorRing_Dx12.h>
+
+#include <d3d12.h>
+#include <d3dx/d3dx12.h>
+
+#include <future>
+
+// RCAS and output scaling of the upscaler output in one dispatch, without the intermediate buffer.
+// Pipelines are compiled on a worker thread on first use of a permutation, Dispatch returns false
+// until it is ready so the separate passes are used meanwhile. FSR EASU scaling is not supported.
+class PF_Dx12
+{
+  public:
+    enum class ScaleKernel : uint32_t
+    {
+        None = 0,
+        Bicubic,
+        Lanczos,
+        Catmull,
+        Magc,
+        BicubicUpsample,
+    };
+
+    enum class OutputFormat : uint32_t
+    {
+        Typed = 0,
+        R10G10B10A2,
+        R8G8B8A8,
+        B8G8R8A8,
+    };
+
+  private:
+    // Root constants
+    struct InternalConstants
+    {
+        int SrcWidth;
+        int SrcHeight;
+        int DstWidth;
+        int DstHeight;
+
+        float Sharpness;
+        float Contrast;
+        int DisplaySizeMV;
+        int Debug;
+
+        float MotionSharpness;
+        float MotionTextureScale;
+        float MvScaleX;
+        float MvScaleY;
+        float Threshold;
+        float ScaleLimit;
+    };
+
+    struct Pipeline
+    {
+        uint32_t key = 0;
+        std::future<ID3D12PipelineState*> compile; // Valid while the worker thread is compiling
+        ID3D12PipelineState* pipelineState = nullptr; // nullptr while compiling or when compiling failed
+    };
+
+    std::string _name = "";
+    bool _init = false;
+
+    ID3D12Device* _device = nullptr;
+    ID3D12RootSignature* _rootSignature = nullptr;
+    std::vector<Pipeline> _pipelines;
+
+    UINT InNumThreadsX = 16;
+    UINT InNumThreadsY = 16;
+
+    static uint32_t PermutationKey(ScaleKernel InKernel, bool InSharpen, bool InDynamicSharpen,
+                                   OutputFormat InFormat);
+    static ID3D12PipelineState* CreatePipeline(std::string InName, ID3D12Device* InDevice,
+                                               ID3D12RootSignature* InRootSignature, uint32_t InKey);
+    ID3D12PipelineState* GetPipeline(ID3D12Device* InDevice, uint32_t InKey);
+
+  public:
+    static ScaleKernel GetScaleKernel(uint32_t InSrcWidth, uint32_t InDstWidth);
+    static OutputFormat GetOutputFormat(DXGI_FORMAT InFormat);
+
+    // Returns false without recording anything when the pass can't be used, separate passes should be used then
+    bool Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCmdList, ID3D12Resource* InResource,
+                  ID3D12Resource* InMotionVectors, RcasConstants InConstants, ID3D12Resource* OutResource);
+
+    bool IsInit() const { return _init; }
+
+    PF_Dx12(std::string InName, ID3D12Device* InDevice);
+
+    ~PF_Dx12();
+};
@@ -3,6 +3,9 @@
 #include "precompile/RCAS_Shader.h"
 
 #include <Config.h>
+#include <misc/GpuTimer_Dx12.h>
+#include <misc/TransientPool_Dx12.h>
+#include <misc/ShaderCache_Dx12.h>
 
 inline static DXGI_FORMAT TranslateTypelessFormats(DXGI_FORMAT format)
 {
@@ -37,7 +40,7 @@ bool RCAS_Dx12::CreateComputeShader(ID3D12Device* device, ID3D12RootSignature* r
     psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
     psoDesc.CS = CD3DX12_SHADER_BYTECODE(shaderBlob->GetBufferPointer(), shaderBlob->GetBufferSize());
 
-    HRESULT hr = device->CreateComputePipelineState(&psoDesc, __uuidof(ID3D12PipelineState*), (void**) pipelineState);
+    HRESULT hr = ShaderCache_Dx12::CreateComputePipeline(device, psoDesc, pipelineState);
 
     if (FAILED(hr))
     {
@@ -62,7 +65,7 @@ bool RCAS_Dx12::CreateBufferResource(ID3D12Device* InDevice, ID3D12Resource* InS
         if (bufDesc.Width != (UINT64) (texDesc.Width) || bufDesc.Height != (UINT) (texDesc.Height) ||
             bufDesc.Format != texDesc.Format)
         {
-            _buffer->Release();
+            TransientPool_Dx12::Release(_buffer, _bufferState);
             _buffer = nullptr;
         }
         else
@@ -86,23 +89,31 @@ bool RCAS_Dx12::CreateBufferResource(ID3D12Device* InDevice, ID3D12Resource* InS
     texDesc.Width = texDesc.Width;
     texDesc.Height = texDesc.Height;
 
-    hr = InDevice->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &texDesc, InState, nullptr,
-                                           IID_PPV_ARGS(&_buffer));
+    TransientPool_Dx12::Texture texture;
 
-    if (hr != S_OK)
+    if (!TransientPool_Dx12::Acquire(InDevice, texDesc, heapProperties, InState, L"RCAS_Buffer", texture,
+                                     { TransientPool_Dx12::UpscalerPass, TransientPool_Dx12::RcasPass }))
     {
-        LOG_ERROR("[{0}] CreateCommittedResource result: {1:x}", _name, hr);
+        LOG_ERROR("[{0}] Can't acquire buffer", _name);
         return false;
     }
 
-    _buffer->SetName(L"RCAS_Buffer");
-    _bufferState = InState;
+    _buffer = texture.resource;
+    _bufferState = texture.state;
+    _bufferNeedsInit = texture.needsInit;
+    _bufferInFrame = texture.inFrame;
 
     return true;
 }
 
 void RCAS_Dx12::SetBufferState(ID3D12GraphicsCommandList* InCommandList, D3D12_RESOURCE_STATES InState)
 {
+    if (_bufferNeedsInit || _bufferInFrame)
+    {
+        TransientPool_Dx12::BeforeFirstUse(InCommandList, _buffer, _bufferState);
+        _bufferNeedsInit = false;
+    }
+
     if (_bufferState == InState)
         return;
 
@@ -126,56 +137,12 @@ bool RCAS_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCm
 
     LOG_DEBUG("[{0}] Start!", _name);
 
-    _counter++;
-    _counter = _counter % 2;
-
-    if (_cpuSrvHandle[_counter].ptr == NULL)
-        _cpuSrvHandle[_counter] = _srvHeap[_counter]->GetCPUDescriptorHandleForHeapStart();
-
-    if (_cpuSrvHandle2[_counter].ptr == NULL)
-    {
-        _cpuSrvHandle2[_counter] = _cpuSrvHandle[_counter];
-        _cpuSrvHandle2[_counter].ptr +=
-            InDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-    }
-
-    if (_cpuUavHandle[_counter].ptr == NULL)
-    {
-        _cpuUavHandle[_counter] = _cpuSrvHandle2[_counter];
-        _cpuUavHandle[_counter].ptr +=
-            InDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-    }
-
-    if (_cpuCbvHandle[_counter].ptr == NULL)
-    {
-        _cpuCbvHandle[_counter] = _cpuUavHandle[_counter];
-        _cpuCbvHandle[_counter].ptr +=
-            InDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-    }
-
-    if (_gpuSrvHandle[_counter].ptr == NULL)
-        _gpuSrvHandle[_counter] = _srvHeap[_counter]->GetGPUDescriptorHandleForHeapStart();
-
-    if (_gpuSrvHandle2[_counter].ptr == NULL)
-    {
-        _gpuSrvHandle2[_counter] = _gpuSrvHandle[_counter];
-        _gpuSrvHandle2[_counter].ptr +=
-            InDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-    }
+    GpuTimer_Dx12::Scope timer(InCmdList, GpuPass::Rcas);
 
-    if (_gpuUavHandle[_counter].ptr == NULL)
-    {
-        _gpuUavHandle[_counter] = _gpuSrvHandle2[_counter];
-        _gpuUavHandle[_counter].ptr +=
-            InDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-    }
+    DescriptorRing_Dx12::Range range;
 
-    if (_gpuCbvHandle[_counter].ptr == NULL)
-    {
-        _gpuCbvHandle[_counter] = _gpuUavHandle[_counter];
-        _gpuCbvHandle[_counter].ptr +=
-            InDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-    }
+    if (!DescriptorRing_Dx12::AllocateTransient(InDevice, 3, range)) // SRV x 2 + UAV
+        return false;
 
     auto inDesc = InResource->GetDesc();
     auto mvDesc = InMotionVectors->GetDesc();
@@ -188,7 +155,7 @@ bool RCAS_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCm
     srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
     srvDesc.Texture2D.MipLevels = 1;
 
-    InDevice->CreateShaderResourceView(InResource, &srvDesc, _cpuSrvHandle[_counter]);
+    InDevice->CreateShaderResourceView(InResource, &srvDesc, range.Cpu(0));
 
     // Create SRV for Motion Texture
     D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc2 = {};
@@ -197,7 +164,7 @@ bool RCAS_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCm
     srvDesc2.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
     srvDesc2.Texture2D.MipLevels = 1;
 
-    InDevice->CreateShaderResourceView(InMotionVectors, &srvDesc2, _cpuSrvHandle2[_counter]);
+    InDevice->CreateShaderResourceView(InMotionVectors, &srvDesc2, range.Cpu(1));
 
     // Create UAV for Output Texture
     D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
@@ -205,7 +172,7 @@ bool RCAS_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCm
     uavDesc.ViewDimension = D3D12_UAV_DIMENSION_TEXTURE2D;
     uavDesc.Texture2D.MipSlice = 0;
 
-    InDevice->CreateUnorderedAccessView(OutResource, nullptr, &uavDesc, _cpuUavHandle[_counter]);
+    InDevice->CreateUnorderedAccessView(OutResource, nullptr, &uavDesc, range.Cpu(2));
 
     if (_constantBuffer == nullptr)
     {
@@ -268,21 +235,28 @@ bool RCAS_Dx12::Dispatch(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCm
     memcpy(pCBDataBegin, &constants, sizeof(constants));
     _constantBuffer->Unmap(0, nullptr);
 
-    D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc = {};
-    cbvDesc.BufferLocation = _constantBuffer->GetGPUVirtualAddress();
-    cbvDesc.SizeInBytes = sizeof(constants);
-    InDevice->CreateConstantBufferView(&cbvDesc, _cpuCbvHandle[_counter]);
+    // Constant buffer never changes, its view is created once per descriptor heap
+    if (!DescriptorRing_Dx12::IsCurrent(_cbvRange))
+    {
+        if (!DescriptorRing_Dx12::AllocatePersistent(InDevice, 1, _cbvRange))
+            return false;
 
-    ID3D12DescriptorHeap* heaps[] = { _srvHeap[_counter] };
-    InCmdList->SetDescriptorHeaps(_countof(heaps), heaps);
+        D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc = {};
+        cbvDesc.BufferLocation = _constantBuffer->GetGPUVirtualAddress();
+        cbvDesc.SizeInBytes = sizeof(constants);
+        InDevice->CreateConstantBufferView(&cbvDesc, _cbvRange.Cpu(0));
+    }
+
+    if (!DescriptorRing_Dx12::Bind(InCmdList, range))
+        return false;
 
     InCmdList->SetComputeRootSignature(_rootSignature);
     InCmdList->SetPipelineState(_pipelineState);
 
-    InCmdList->SetComputeRootDescriptorTable(0, _gpuSrvHandle[_counter]);
-    InCmdList->SetComputeRootDescriptorTable(1, _gpuSrvHandle2[_counter]);
-    InCmdList->SetComputeRootDescriptorTable(2, _gpuUavHandle[_counter]);
-    InCmdList->SetComputeRootDescriptorTable(3, _gpuCbvHandle[_counter]);
+    InCmdList->SetComputeRootDescriptorTable(0, range.Gpu(0));
+    InCmdList->SetComputeRootDescriptorTable(1, range.Gpu(1));
+    InCmdList->SetComputeRootDescriptorTable(2, range.Gpu(2));
+    InCmdList->SetComputeRootDescriptorTable(3, _cbvRange.Gpu(0));
 
     UINT dispatchWidth = 0;
     UINT dispatchHeight = 0;
@@ -386,8 +360,7 @@ RCAS_Dx12::RCAS_Dx12(std::string InName, ID3D12Device* InDevice) : _name(InName)
             break;
         }
 
-        hr = InDevice->CreateRootSignature(0, signatureBlob->GetBufferPointer(), signatureBlob->GetBufferSize(),
-                                           IID_PPV_ARGS(&_rootSignature));
+        hr = ShaderCache_Dx12::CreateRootSignature(InDevice, signatureBlob, &_rootSignature);
 
         if (FAILED(hr))
         {
@@ -421,8 +394,7 @@ RCAS_Dx12::RCAS_Dx12(std::string InName, ID3D12Device* InDevice) : _name(InName)
         computePsoDesc.pRootSignature = _rootSignature;
         computePsoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
         computePsoDesc.CS = CD3DX12_SHADER_BYTECODE(reinterpret_cast<const void*>(rcas_cso), sizeof(rcas_cso));
-        auto hr = InDevice->CreateComputePipelineState(&computePsoDesc, __uuidof(ID3D12PipelineState*),
-                                                       (void**) &_pipelineState);
+        auto hr = ShaderCache_Dx12::CreateComputePipeline(InDevice, computePsoDesc, &_pipelineState);
 
         if (FAILED(hr))
         {
@@ -433,7 +405,8 @@ RCAS_Dx12::RCAS_Dx12(std::string InName, ID3D12Device* InDevice) : _name(InName)
     else
     {
         // Compile shader blobs
-        ID3DBlob* _recEncodeShader = RCAS_CompileShader(rcasCode.c_str(), "CSMain", "cs_5_0");
+        ID3DBlob* _recEncodeShader = ShaderCache_Dx12::CompileShader(rcasCode.c_str(), "CSMain", "cs_5_0",
+                                                                     RCAS_CompileShader);
 
         if (_recEncodeShader == nullptr)
         {
@@ -455,48 +428,7 @@ RCAS_Dx12::RCAS_Dx12(std::string InName, ID3D12Device* InDevice) : _name(InName)
         }
     }
 
-    D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
-    heapDesc.NumDescriptors = 4; // SRV x 2 + UAV + CBV
-    heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-    heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-
-    State::Instance().skipHeapCapture = true;
-
-    auto hr = InDevice->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&_srvHeap[0]));
-
-    if (FAILED(hr))
-    {
-        LOG_ERROR("[{0}] CreateDescriptorHeap[0] error {1:x}", _name, (unsigned int) hr);
-        return;
-    }
-
-    hr = InDevice->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&_srvHeap[1]));
-
-    if (FAILED(hr))
-    {
-        LOG_ERROR("[{0}] CreateDescriptorHeap[1] error {1:x}", _name, (unsigned int) hr);
-        return;
-    }
-
-    hr = InDevice->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&_srvHeap[2]));
-
-    if (FAILED(hr))
-    {
-        LOG_ERROR("[{0}] CreateDescriptorHeap[2] error {1:x}", _name, (unsigned int) hr);
-        return;
-    }
-
-    hr = InDevice->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&_srvHeap[3]));
-
-    State::Instance().skipHeapCapture = false;
-
-    if (FAILED(hr))
-    {
-        LOG_ERROR("[{0}] CreateDescriptorHeap[3] error {1:x}", _name, (unsigned int) hr);
-        return;
-    }
-
-    _init = _srvHeap[3] != nullptr;
+    _init = DescriptorRing_Dx12::Init(InDevice);
 }
 
 RCAS_Dx12::~RCAS_Dx12()
@@ -541,33 +473,11 @@ RCAS_Dx12::~RCAS_Dx12()
         _pipelineState = nullptr;
     }
 
-    if (_srvHeap[0] != nullptr)
-    {
-        _srvHeap[0]->Release();
-        _srvHeap[0] = nullptr;
-    }
-
-    if (_srvHeap[1] != nullptr)
-    {
-        _srvHeap[1]->Release();
-        _srvHeap[1] = nullptr;
-    }
-
-    if (_srvHeap[2] != nullptr)
-    {
-        _srvHeap[2]->Release();
-        _srvHeap[2] = nullptr;
-    }
-
-    if (_srvHeap[3] != nullptr)
-    {
-        _srvHeap[3]->Release();
-        _srvHeap[3] = nullptr;
-    }
+    DescriptorRing_Dx12::FreePersistent(_cbvRange);
 
     if (_buffer != nullptr)
     {
-        _buffer->Release();
+        TransientPool_Dx12::Release(_buffer, _bufferState);
         _buffer = nullptr;
     }
 
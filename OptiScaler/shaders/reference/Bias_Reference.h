@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Reference_Image.h"
+
+// CPU version of biasShader in shaders/bias/Bias_Common.h
+namespace Reference
+{
+
+// Red channel multiplied with the bias, alpha is zero because the shader writes float3
+inline Color Bias(const Image& source, float bias, int x, int y)
+{
+    return Color::FromVec(source.Load(x, y).Vec() * Float4::Set(bias, 1.0f, 1.0f, 0.0f));
+}
+
+inline Image BiasImage(const Image& source, float bias)
+{
+    Image output(source.Width(), source.Height());
+
+    for (int y = 0; y < source.Height(); y++)
+    {
+        for (int x = 0; x < source.Width(); x++)
+            output.Store(x, y, Bias(source, bias, x, y));
+    }
+
+    return output;
+}
+
+} // namespace Reference
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Reference_Image.h"
+
+#include <shaders/depth_scale/DS_Constants.h>
+
+// CPU version of shaderCode in shaders/depth_scale/DS_Common.h
+//
+// Depth is a single channel, red of the images. Four texels of a row are processed together.
+namespace Reference
+{
+
+inline Image DepthScaleImage(const Image& source, const DSConstants& constants)
+{
+    Image output(source.Width(), source.Height());
+    auto depthScale = Float4::Splat(constants.DepthScale);
+
+    for (int y = 0; y < source.Height(); y++)
+    {
+        for (int x = 0; x < source.Width(); x += 4)
+        {
+            auto depth = Float4::Set(source.Load(x, y).r, source.Load(x + 1, y).r, source.Load(x + 2, y).r,
+                                     source.Load(x + 3, y).r);
+
+            float scaled[4];
+            Float4::Saturate(depth / depthScale).Store(scaled);
+
+            for (int i = 0; i < 4; i++)
+                output.Store(x + i, y, { scaled[i], 0.0f, 0.0f, 0.0f });
+        }
+    }
+
+    return output;
+}
+
+} // namespace Reference
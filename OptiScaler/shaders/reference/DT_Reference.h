@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Reference_Image.h"
+
+// CPU version of shaderCode in shaders/depth_transfer/DT_Common.h, copies the red channel into a float texture
+namespace Reference
+{
+
+inline Image DepthTransferImage(const Image& source)
+{
+    Image output(source.Width(), source.Height());
+
+    for (int y = 0; y < source.Height(); y++)
+    {
+        for (int x = 0; x < source.Width(); x++)
+            output.Store(x, y, { source.Load(x, y).r, 0.0f, 0.0f, 0.0f });
+    }
+
+    return output;
+}
+
+} // namespace Reference
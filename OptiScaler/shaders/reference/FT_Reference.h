@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Reference_Image.h"
+
+// CPU versions of the format conversions in shaders/format_transfer/FT_Common.h
+namespace Reference
+{
+
+// Saturated channels scaled to the bit ranges, truncated like the uint casts of the shaders
+inline void ToUnorm(const Color& color, float colorMax, float alphaMax, uint32_t channels[4])
+{
+    float scaled[4];
+    (Float4::Saturate(color.Vec()) * Float4::Set(colorMax, colorMax, colorMax, alphaMax)).Store(scaled);
+
+    for (int i = 0; i < 4; i++)
+        channels[i] = (uint32_t) scaled[i];
+}
+
+inline uint32_t PackR10G10B10A2(const Color& color)
+{
+    uint32_t c[4];
+    ToUnorm(color, 1023.0f, 3.0f, c);
+
+    return c[0] | c[1] << 10 | c[2] << 20 | c[3] << 30;
+}
+
+inline uint32_t PackR8G8B8A8(const Color& color)
+{
+    uint32_t c[4];
+    ToUnorm(color, 255.0f, 255.0f, c);
+
+    return c[0] | c[1] << 8 | c[2] << 16 | c[3] << 24;
+}
+
+// Memory order of the format, ftB8G8R8A8Code puts red in the second byte
+inline uint32_t PackB8G8R8A8(const Color& color)
+{
+    uint32_t c[4];
+    ToUnorm(color, 255.0f, 255.0f, c);
+
+    return c[2] | c[1] << 8 | c[0] << 16 | c[3] << 24;
+}
+
+// Packing of ftB8G8R8A8Code as it is
+inline uint32_t PackFtB8G8R8A8(const Color& color)
+{
+    uint32_t c[4];
+    ToUnorm(color, 255.0f, 255.0f, c);
+
+    return c[2] | c[0] << 8 | c[1] << 16 | c[3] << 24;
+}
+
+// Whole dispatch of one of the FT shaders, packed texels row by row
+template <typename Pack> std::vector<uint32_t> FormatTransferImage(const Image& source, Pack&& pack)
+{
+    std::vector<uint32_t> packed;
+    packed.reserve((size_t) source.Width() * source.Height());
+
+    for (int y = 0; y < source.Height(); y++)
+    {
+        for (int x = 0; x < source.Width(); x++)
+            packed.push_back(pack(source.Load(x, y)));
+    }
+
+    return packed;
+}
+
+// Value read back after a store to a UNORM view of the format, for modelling an intermediate buffer
+inline Color Quantize(const Color& color, int colorBits, int alphaBits)
+{
+    auto quantize = [](float value, int bits)
+    {
+        if (bits <= 0)
+            return value;
+
+        float max = (float) ((1u << bits) - 1);
+        return (float) (uint32_t) (Saturate(value) * max + 0.5f) / max;
+    };
+
+    return { quantize(color.r, colorBits), quantize(color.g, colorBits), quantize(color.b, colorBits),
+             quantize(color.a, alphaBits) };
+}
+
+} // namespace Reference
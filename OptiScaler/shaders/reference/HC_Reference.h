@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Reference_Image.h"
+
+#include <shaders/hudless_compare/HC_Constants.h>
+
+// CPU version of the pixel shader of hcCode in shaders/hudless_compare/HC_Common.h
+namespace Reference
+{
+
+// Sample with the point clamp sampler
+inline Color PointSample(const Image& image, float u, float v)
+{
+    int x = std::clamp((int) std::floor(u * image.Width()), 0, image.Width() - 1);
+    int y = std::clamp((int) std::floor(v * image.Height()), 0, image.Height() - 1);
+    return image.Load(x, y);
+}
+
+inline float SmoothStep(float edge0, float edge1, float value)
+{
+    float t = Saturate((value - edge0) / (edge1 - edge0));
+    return t * t * (3.0f - 2.0f * t);
+}
+
+// Back buffer copy where it differs from the hudless reference is tinted pink
+inline Color HudlessCompare(const Image& reference, const Image& backCopy, const CompareParams& params, int x, int y)
+{
+    float u = (x + 0.5f) * params.InvOutputSize[0];
+    float v = (y + 0.5f) * params.InvOutputSize[1];
+
+    auto refC = PointSample(reference, u, v).Vec();
+    auto backC = PointSample(backCopy, u, v);
+
+    auto diff = Float4::Abs(refC - backC.Vec());
+    float d = std::max(std::max(diff.Get(0), diff.Get(1)), diff.Get(2));
+
+    float m = SmoothStep(params.DiffThreshold, params.DiffThreshold * 2.0f, d);
+
+    auto pink = Float4::Set(1.0f, 0.4f, 0.6f, backC.a);
+    auto output = Color::FromVec(backC.Vec() + (pink - backC.Vec()) * (m * params.PinkAmount));
+    output.a = backC.a;
+
+    return output;
+}
+
+inline Image HudlessCompareImage(const Image& reference, const Image& backCopy, const CompareParams& params,
+                                 int width, int height)
+{
+    Image output(width, height);
+
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+            output.Store(x, y, HudlessCompare(reference, backCopy, params, x, y));
+    }
+
+    return output;
+}
+
+} // namespace Reference
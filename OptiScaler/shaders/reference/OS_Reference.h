@@ -0,0 +1,274 @@
+#pragma once
+
+#include "Reference_Image.h"
+
+#include <shaders/output_scaling/OS_Constants.h>
+
+// CPU versions of the scaling kernels in shaders/output_scaling/OS_Common.h, sizes come in the constant buffer
+// struct of the shaders
+namespace Reference
+{
+
+enum class ScaleKernel : uint32_t
+{
+    None = 0,
+    Bicubic,
+    Lanczos,
+    Catmull,
+    Magc,
+    BicubicUpsample,
+};
+
+inline float Luminance(const Color& color) { return color.r * 0.2126f + color.g * 0.7152f + color.b * 0.0722f; }
+
+inline Color CorrectLuminance(Color color, float avgLuminance)
+{
+    float currentLuminance = Luminance(color);
+
+    if (std::abs(currentLuminance - avgLuminance) > 0.5f)
+    {
+        float luminanceScale = avgLuminance / std::max(currentLuminance, 1e-5f);
+        color = Color::FromVec(color.Vec() * Float4::Set(luminanceScale, luminanceScale, luminanceScale, 1.0f));
+    }
+
+    return color;
+}
+
+inline float BicubicWeight(float x)
+{
+    float a = -0.75f;
+    float absX = std::abs(x);
+
+    if (absX <= 1.0f)
+        return (a + 2.0f) * absX * absX * absX - (a + 3.0f) * absX * absX + 1.0f;
+    else if (absX < 2.0f)
+        return a * absX * absX * absX - 5.0f * a * absX * absX + 8.0f * a * absX - 4.0f * a;
+
+    return 0.0f;
+}
+
+inline float LanczosKernel(float x, float radius, float pi)
+{
+    if (x == 0.0f)
+        return 1.0f;
+
+    if (x > radius)
+        return 0.0f;
+
+    x *= pi;
+    return (std::sin(x) / x) * (std::sin(x / radius) / (x / radius));
+}
+
+inline float CatmullRom(float x)
+{
+    x = std::abs(x);
+
+    if (x < 1.0f)
+        return (1.5f * x - 2.5f) * x * x + 1.0f;
+    else if (x < 2.0f)
+        return ((-0.5f * x + 2.5f) * x - 4.0f) * x + 2.0f;
+
+    return 0.0f;
+}
+
+inline float MagcKernel(float x)
+{
+    x = std::abs(x);
+
+    if (x <= 1.0f)
+        return 1.0f - 2.0f * x * x + x * x * x;
+    else if (x <= 2.0f)
+        return 4.0f - 8.0f * x + 5.0f * x * x - x * x * x;
+
+    return 0.0f;
+}
+
+// Weight table of the upsample shader, 16 discrete offsets and A is always -0.5
+inline void BicubicFilterWeights(float offset, float weights[4])
+{
+    const float A = -0.5f;
+    auto w1 = [A](float x) { return x * x * ((A + 2) * x - (A + 3)) + 1.0f; };
+    auto w2 = [A](float x) { return A * (x * (x * (x - 5) + 8) - 4); };
+
+    float d1 = ((uint32_t) (offset * 16.0f) + 0.5f) / 16.0f;
+
+    weights[0] = w2(1.0f + d1);
+    weights[1] = w1(d1);
+    weights[2] = w1(1.0f - d1);
+    weights[3] = w2(2.0f - d1);
+}
+
+// One output texel, fetch(x, y) returns the source texel and is only called with the coordinates the shader reads
+template <typename Fetch> Color Scale(ScaleKernel kernel, const Constants& params, Fetch&& fetch, int x, int y)
+{
+    float scaleX = (float) params.srcWidth / (float) params.destWidth;
+    float scaleY = (float) params.srcHeight / (float) params.destHeight;
+
+    auto clampX = [&params](int value) { return std::clamp(value, 0, params.srcWidth - 1); };
+    auto clampY = [&params](int value) { return std::clamp(value, 0, params.srcHeight - 1); };
+
+    switch (kernel)
+    {
+    case ScaleKernel::Bicubic:
+    {
+        float pixelX = (x / (params.destWidth - 1.0f)) * params.srcWidth;
+        float pixelY = (y / (params.destHeight - 1.0f)) * params.srcHeight;
+        float texelX = std::floor(pixelX);
+        float texelY = std::floor(pixelY);
+        float tx = pixelX - texelX;
+        float ty = pixelY - texelY;
+        tx = tx * tx * (3.0f - 2.0f * tx);
+        ty = ty * ty * (3.0f - 2.0f * ty);
+
+        Color samples[16];
+        float avgLuminance = 0.0f;
+
+        for (int i = 0; i < 16; i++)
+        {
+            samples[i] = fetch(ToInt(texelX + (i % 4 - 1)), ToInt(texelY + (i / 4 - 1)));
+            avgLuminance += Luminance(samples[i]);
+        }
+
+        avgLuminance /= 16.0f;
+
+        Color result;
+
+        for (int i = 0; i < 16; i++)
+        {
+            float weight = BicubicWeight((i % 4 - 1) - tx) * BicubicWeight((i / 4 - 1) - ty);
+            result = result + CorrectLuminance(samples[i], avgLuminance) * weight;
+        }
+
+        return result;
+    }
+
+    case ScaleKernel::Lanczos:
+    {
+        const float lanczosRadius = 3.0f;
+        const float pi = 3.14159265359f;
+
+        float sourceX = (float) x * scaleX;
+        float sourceY = (float) y * scaleY;
+        float avgLuminance = 0.0f;
+
+        for (int dy = -1; dy <= 2; dy++)
+        {
+            for (int dx = -1; dx <= 2; dx++)
+                avgLuminance += Luminance(fetch(clampX(ToInt(sourceX + dx)), clampY(ToInt(sourceY + dy))));
+        }
+
+        avgLuminance /= 16.0f;
+
+        Color color;
+        float totalWeight = 0.0f;
+
+        for (int oy = -3; oy <= 3; oy++)
+        {
+            for (int ox = -3; ox <= 3; ox++)
+            {
+                float sampleX = std::clamp(sourceX + ox, 0.0f, (float) (params.srcWidth - 1));
+                float sampleY = std::clamp(sourceY + oy, 0.0f, (float) (params.srcHeight - 1));
+
+                auto sampleColor = CorrectLuminance(fetch(ToInt(sampleX), ToInt(sampleY)), avgLuminance);
+
+                // Shader multiplies with both components of a float2 which holds the product
+                float weight = LanczosKernel(std::abs(sampleX - sourceX), lanczosRadius, pi) *
+                               LanczosKernel(std::abs(sampleY - sourceY), lanczosRadius, pi);
+                weight *= weight;
+
+                color = color + sampleColor * weight;
+                totalWeight += weight;
+            }
+        }
+
+        return color * (1.0f / totalWeight);
+    }
+
+    case ScaleKernel::Catmull:
+    case ScaleKernel::Magc:
+    {
+        float sourceX = (float) x * scaleX;
+        float sourceY = (float) y * scaleY;
+        int baseX = ToInt(sourceX);
+        int baseY = ToInt(sourceY);
+        float fractionX = Frac(sourceX);
+        float fractionY = Frac(sourceY);
+
+        Color samples[16];
+        float avgLuminance = 0.0f;
+
+        for (int i = 0; i < 16; i++)
+        {
+            samples[i] = fetch(clampX(baseX + i % 4 - 1), clampY(baseY + i / 4 - 1));
+            avgLuminance += Luminance(samples[i]);
+        }
+
+        avgLuminance /= 16.0f;
+
+        Color color;
+        float totalWeight = 0.0f;
+
+        for (int i = 0; i < 16; i++)
+        {
+            float dx = (float) (i % 4 - 1) - fractionX;
+            float dy = (float) (i / 4 - 1) - fractionY;
+            float weight = kernel == ScaleKernel::Catmull ? CatmullRom(dx) * CatmullRom(dy)
+                                                          : MagcKernel(dx) * MagcKernel(dy);
+
+            color = color + CorrectLuminance(samples[i], avgLuminance) * weight;
+            totalWeight += weight;
+        }
+
+        return color * (1.0f / totalWeight);
+    }
+
+    case ScaleKernel::BicubicUpsample:
+    {
+        float topLeftX = (x + 0.5f) * scaleX - 1.5f;
+        float topLeftY = (y + 0.5f) * scaleY - 1.5f;
+        int baseX = (int) std::floor(topLeftX);
+        int baseY = (int) std::floor(topLeftY);
+
+        float xWeights[4];
+        float yWeights[4];
+        BicubicFilterWeights(Frac(topLeftX), xWeights);
+        BicubicFilterWeights(Frac(topLeftY), yWeights);
+
+        Color result;
+
+        for (int j = 0; j < 4; j++)
+        {
+            Color row;
+
+            for (int i = 0; i < 4; i++)
+                row = row + fetch(baseX + i, baseY + j) * xWeights[i];
+
+            result = result + row * yWeights[j];
+        }
+
+        // Shader writes float3
+        result.a = 0.0f;
+        return result;
+    }
+
+    default:
+        return fetch(x, y);
+    }
+}
+
+// Whole dispatch of the separate pass
+inline Image ScaleImage(ScaleKernel kernel, const Constants& params, const Image& source)
+{
+    Image output(params.destWidth, params.destHeight);
+    auto fetch = [&source](int x, int y) { return source.Load(x, y); };
+
+    for (int y = 0; y < params.destHeight; y++)
+    {
+        for (int x = 0; x < params.destWidth; x++)
+            output.Store(x, y, Scale(kernel, params, fetch, x, y));
+    }
+
+    return output;
+}
+
+} // namespace Reference
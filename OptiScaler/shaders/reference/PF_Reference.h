@@ -0,0 +1,251 @@
+#pragma once
+
+#include "FT_Reference.h"
+#include "OS_Reference.h"
+#include "RCAS_Reference.h"
+
+// CPU version of pfCode in shaders/post_fused/PF_Common.h and of the separate passes it replaces.
+//
+// Fused pass computes the sharpened texels the scale kernel reads instead of reading them from an
+// intermediate image. Without quantization of the intermediate image both give the same colors,
+// alpha differs because the separate passes write float3 and the fused pass keeps the source alpha.
+//
+// FusedImage runs like the dispatch: every 16x16 group fills a tile of at most 48x48 sharpened
+// texels (the LDS of the shader) starting at the first tap of its first pixel, taps outside of the
+// tile fall back to computing the texel directly. Fused is the same pixel without the tile.
+namespace Reference
+{
+
+enum class OutputFormat : uint32_t
+{
+    Typed = 0,
+    R10G10B10A2,
+    R8G8B8A8,
+    B8G8R8A8,
+};
+
+struct FusedParams
+{
+    ScaleKernel Kernel = ScaleKernel::None;
+    Constants Scale {};
+    bool Sharpen = true;
+    RcasParams Rcas {};
+    OutputFormat Format = OutputFormat::Typed;
+};
+
+inline uint32_t Pack(OutputFormat format, const Color& color)
+{
+    switch (format)
+    {
+    case OutputFormat::R10G10B10A2:
+        return PackR10G10B10A2(color);
+
+    case OutputFormat::R8G8B8A8:
+        return PackR8G8B8A8(color);
+
+    case OutputFormat::B8G8R8A8:
+        return PackB8G8R8A8(color);
+
+    default:
+        return 0;
+    }
+}
+
+constexpr int FusedGroupSize = 16;
+constexpr int FusedTileSize = 48;
+
+// Where the taps of FusedImage came from
+struct FusedTileStats
+{
+    uint64_t tileTaps = 0;
+    uint64_t fallbackTaps = 0;
+    uint64_t clampedGroups = 0; // Groups which needed more than FusedTileSize texels in a direction
+};
+
+// FetchSource of the shader, texel of the intermediate image of the separate passes
+inline Color FusedFetchSource(const Image& source, const Image& motion, const FusedParams& params, int x, int y)
+{
+    auto& scale = params.Scale;
+
+    if (x < 0 || y < 0 || x >= scale.srcWidth || y >= scale.srcHeight)
+        return Color {};
+
+    auto color = params.Sharpen ? Rcas(source, motion, params.Rcas, x, y) : source.Load(x, y);
+
+    // float3 in the shader
+    color.a = 0.0f;
+    return color;
+}
+
+inline int FusedTapCount(ScaleKernel kernel) { return kernel == ScaleKernel::Lanczos ? 7 : 4; }
+
+// FirstTap of the shader, smallest texel the kernel reads for an output pixel before clamping
+inline void FusedFirstTap(ScaleKernel kernel, const Constants& scale, int x, int y, int& tapX, int& tapY)
+{
+    float scaleX = (float) scale.srcWidth / (float) scale.destWidth;
+    float scaleY = (float) scale.srcHeight / (float) scale.destHeight;
+
+    switch (kernel)
+    {
+    case ScaleKernel::Bicubic:
+        tapX = (int) std::floor((x / (scale.destWidth - 1.0f)) * scale.srcWidth) - 1;
+        tapY = (int) std::floor((y / (scale.destHeight - 1.0f)) * scale.srcHeight) - 1;
+        break;
+
+    case ScaleKernel::Lanczos:
+        tapX = ToInt((float) x * scaleX) - 3;
+        tapY = ToInt((float) y * scaleY) - 3;
+        break;
+
+    case ScaleKernel::BicubicUpsample:
+        tapX = (int) std::floor((x + 0.5f) * scaleX - 1.5f);
+        tapY = (int) std::floor((y + 0.5f) * scaleY - 1.5f);
+        break;
+
+    default:
+        tapX = ToInt((float) x * scaleX) - 1;
+        tapY = ToInt((float) y * scaleY) - 1;
+        break;
+    }
+}
+
+// Alpha is not filtered, nearest source texel
+inline float FusedAlpha(const Image& source, const Constants& scale, int x, int y)
+{
+    float scaleX = (float) scale.srcWidth / (float) scale.destWidth;
+    float scaleY = (float) scale.srcHeight / (float) scale.destHeight;
+    int alphaX = std::clamp(ToInt((x + 0.5f) * scaleX), 0, scale.srcWidth - 1);
+    int alphaY = std::clamp(ToInt((y + 0.5f) * scaleY), 0, scale.srcHeight - 1);
+
+    return source.Load(alphaX, alphaY).a;
+}
+
+// Output texel of the fused pass before the format conversion, every tap computed directly
+inline Color Fused(const Image& source, const Image& motion, const FusedParams& params, int x, int y)
+{
+    auto fetch = [&](int fx, int fy) { return FusedFetchSource(source, motion, params, fx, fy); };
+
+    auto color = Scale(params.Kernel, params.Scale, fetch, x, y);
+    color.a = FusedAlpha(source, params.Scale, x, y);
+
+    return color;
+}
+
+// One group of the dispatch, output texels of the group are stored to output
+inline void FusedGroup(const Image& source, const Image& motion, const FusedParams& params, int groupX, int groupY,
+                       std::vector<Color>& tile, Image& output, FusedTileStats* stats)
+{
+    auto& scale = params.Scale;
+    int startX = groupX * FusedGroupSize;
+    int startY = groupY * FusedGroupSize;
+    int endX = std::min(startX + FusedGroupSize - 1, scale.destWidth - 1);
+    int endY = std::min(startY + FusedGroupSize - 1, scale.destHeight - 1);
+
+    if (params.Kernel == ScaleKernel::None)
+    {
+        for (int y = startY; y <= endY; y++)
+        {
+            for (int x = startX; x <= endX; x++)
+                output.Store(x, y, Fused(source, motion, params, x, y));
+        }
+
+        return;
+    }
+
+    int originX, originY, lastX, lastY;
+    FusedFirstTap(params.Kernel, scale, startX, startY, originX, originY);
+    FusedFirstTap(params.Kernel, scale, endX, endY, lastX, lastY);
+
+    int neededX = lastX + FusedTapCount(params.Kernel) - originX;
+    int neededY = lastY + FusedTapCount(params.Kernel) - originY;
+    int tileWidth = std::clamp(neededX, 0, FusedTileSize);
+    int tileHeight = std::clamp(neededY, 0, FusedTileSize);
+
+    if (stats != nullptr && (neededX > FusedTileSize || neededY > FusedTileSize))
+        stats->clampedGroups++;
+
+    // Texels of the tile are laid out with a stride of FusedTileSize like the groupshared arrays
+    for (int i = 0; i < tileWidth * tileHeight; i++)
+    {
+        int tx = i % tileWidth;
+        int ty = i / tileWidth;
+        tile[tx + ty * FusedTileSize] = FusedFetchSource(source, motion, params, originX + tx, originY + ty);
+    }
+
+    auto loadTap = [&](int x, int y)
+    {
+        int tx = x - originX;
+        int ty = y - originY;
+
+        if (tx < 0 || ty < 0 || tx >= tileWidth || ty >= tileHeight)
+        {
+            if (stats != nullptr)
+                stats->fallbackTaps++;
+
+            return FusedFetchSource(source, motion, params, x, y);
+        }
+
+        if (stats != nullptr)
+            stats->tileTaps++;
+
+        return tile[tx + ty * FusedTileSize];
+    };
+
+    for (int y = startY; y <= endY; y++)
+    {
+        for (int x = startX; x <= endX; x++)
+        {
+            auto color = Scale(params.Kernel, scale, loadTap, x, y);
+            color.a = FusedAlpha(source, scale, x, y);
+            output.Store(x, y, color);
+        }
+    }
+}
+
+inline Image FusedImage(const Image& source, const Image& motion, const FusedParams& params,
+                        FusedTileStats* stats = nullptr)
+{
+    Image output(params.Scale.destWidth, params.Scale.destHeight);
+    std::vector<Color> tile((size_t) FusedTileSize * FusedTileSize);
+
+    int groupsX = (output.Width() + FusedGroupSize - 1) / FusedGroupSize;
+    int groupsY = (output.Height() + FusedGroupSize - 1) / FusedGroupSize;
+
+    for (int groupY = 0; groupY < groupsY; groupY++)
+    {
+        for (int groupX = 0; groupX < groupsX; groupX++)
+            FusedGroup(source, motion, params, groupX, groupY, tile, output, stats);
+    }
+
+    return output;
+}
+
+// RCAS into an intermediate image and scaling of it, like the upscaler features do without the fused pass.
+// Intermediate image is quantized when colorBits is not zero.
+inline Image SeparateImage(const Image& source, const Image& motion, const FusedParams& params, int colorBits = 0,
+                           int alphaBits = 0)
+{
+    auto intermediate = params.Sharpen ? RcasImage(source, motion, params.Rcas) : source;
+
+    if (colorBits > 0)
+    {
+        for (int y = 0; y < intermediate.Height(); y++)
+        {
+            for (int x = 0; x < intermediate.Width(); x++)
+                intermediate.Store(x, y, Quantize(intermediate.Load(x, y), colorBits, alphaBits));
+        }
+    }
+
+    if (params.Kernel == ScaleKernel::None)
+        return intermediate;
+
+    return ScaleImage(params.Kernel, params.Scale, intermediate);
+}
+
+// Packed texels of an output, row by row
+inline std::vector<uint32_t> PackImage(OutputFormat format, const Image& image)
+{
+    return FormatTransferImage(image, [format](const Color& color) { return Pack(format, color); });
+}
+
+} // namespace Reference
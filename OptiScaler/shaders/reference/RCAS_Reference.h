@@ -0,0 +1,141 @@
+#pragma once
+
+#include "Reference_Image.h"
+
+// CPU version of rcasCode in shaders/rcas/RCAS_Common.h
+namespace Reference
+{
+
+// Same layout as the cbuffer of the shader
+struct RcasParams
+{
+    float Sharpness = 0.0f;
+    float Contrast = -100.0f;
+
+    int DynamicSharpenEnabled = 0;
+    int DisplaySizeMV = 0;
+    int Debug = 0;
+
+    float MotionSharpness = 0.0f;
+    float MotionTextureScale = 1.0f;
+    float MvScaleX = 1.0f;
+    float MvScaleY = 1.0f;
+    float Threshold = 0.0f;
+    float ScaleLimit = 10.0f;
+};
+
+inline float RcasSharpness(const Image& motion, const RcasParams& params, int x, int y)
+{
+    float setSharpness = params.Sharpness;
+
+    if (params.DynamicSharpenEnabled <= 0)
+        return setSharpness;
+
+    Color mv;
+    float add = 0.0f;
+
+    if (params.DisplaySizeMV > 0)
+        mv = motion.Load(x, y);
+    else
+        mv = motion.Load(ToInt(x * params.MotionTextureScale), ToInt(y * params.MotionTextureScale));
+
+    float value = std::max(std::abs(mv.r * params.MvScaleX), std::abs(mv.g * params.MvScaleY));
+
+    if (value > params.Threshold)
+        add = (value / (params.ScaleLimit - params.Threshold)) * params.MotionSharpness;
+
+    if ((add > params.MotionSharpness && params.MotionSharpness > 0.0f) ||
+        (add < params.MotionSharpness && params.MotionSharpness < 0.0f))
+    {
+        add = params.MotionSharpness;
+    }
+
+    setSharpness += add;
+
+    if (setSharpness > 1.3f)
+        setSharpness = 1.3f;
+    else if (setSharpness < 0.0f)
+        setSharpness = 0.0f;
+
+    return setSharpness;
+}
+
+// One output texel, alpha is zero because the shader writes float3
+inline Color Rcas(const Image& source, const Image& motion, const RcasParams& params, int x, int y)
+{
+    float setSharpness = RcasSharpness(motion, params, x, y);
+
+    auto e = source.Load(x, y);
+    e.a = 0.0f;
+
+    if (setSharpness == 0.0f)
+    {
+        if (params.Debug > 0 && params.DynamicSharpenEnabled > 0 && params.Sharpness > 0)
+            e.g *= 1 + (12.0f * params.Sharpness);
+
+        return e;
+    }
+
+    // Alpha lanes are cleared so they don't take part in the lobe
+    auto alphaMask = Float4::Set(1.0f, 1.0f, 1.0f, 0.0f);
+    auto b = source.Load(x, y - 1).Vec() * alphaMask;
+    auto d = source.Load(x - 1, y).Vec() * alphaMask;
+    auto f = source.Load(x + 1, y).Vec() * alphaMask;
+    auto h = source.Load(x, y + 1).Vec() * alphaMask;
+
+    auto minRGB = Float4::Min(Float4::Min(b, d), Float4::Min(f, h));
+    auto maxRGB = Float4::Max(Float4::Max(b, d), Float4::Max(f, h));
+
+    auto one = Float4::Splat(1.0f);
+    auto four = Float4::Splat(4.0f);
+    auto hitMin = minRGB * (one / (four * maxRGB));
+    auto hitMax = (one - maxRGB) * (one / (four * minRGB - four));
+    auto lobeRGB = Float4::Max(-hitMin, hitMax);
+
+    float maxLobe = std::max(lobeRGB.Get(0), std::max(lobeRGB.Get(1), lobeRGB.Get(2)));
+    float lobe = std::max(-0.1875f, std::min(maxLobe, 0.0f)) * setSharpness;
+
+    if (params.Contrast >= -10.0f)
+    {
+        // Only green is used by the shader
+        float minG = minRGB.Get(1);
+        float maxG = maxRGB.Get(1);
+        float amp = Saturate(std::min(minG, 2.0f - maxG) / std::max(maxG, 1e-5f));
+        amp = 1.0f / std::sqrt(amp);
+
+        float peak = -3.0f * params.Contrast + 8.0f;
+        float contrastFactor = 1.0f / std::max(amp * peak, 1.0f);
+
+        lobe *= Lerp(1.0f, contrastFactor, params.Contrast);
+    }
+
+    float rcpL = Rcp(4.0f * lobe + 1.0f);
+
+    auto output = Color::FromVec(((b + d + f + h) * lobe + e.Vec()) * rcpL);
+
+    if (params.Debug > 0 && params.DynamicSharpenEnabled > 0)
+    {
+        if (params.Sharpness < setSharpness)
+            output.r *= 1 + (12.0f * (setSharpness - params.Sharpness));
+        else
+            output.g *= 1 + (12.0f * (params.Sharpness - setSharpness));
+    }
+
+    return output;
+}
+
+// Whole dispatch, output has the size of the source
+inline Image RcasImage(const Image& source, const Image& motion, const RcasParams& params)
+{
+    Image output(source.Width(), source.Height());
+
+    for (int y = 0; y < source.Height(); y++)
+    {
+        for (int x = 0; x < source.Width(); x++)
+            output.Store(x, y, Rcas(source, motion, params, x, y));
+    }
+
+    return output;
+}
+
+} // namespace Reference
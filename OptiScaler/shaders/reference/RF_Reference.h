@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Reference_Image.h"
+
+#include <shaders/resource_flip/RF_Constants.h>
+
+// CPU version of rfCode in shaders/resource_flip/RF_Common.h
+namespace Reference
+{
+
+// Vertical flip of the rows between offset and height + offset, velocity also flips the sign of the y motion.
+// Output has the size of the source, texels the shader doesn't write stay zero.
+inline Image ResourceFlipImage(const Image& source, const RFConstants& constants)
+{
+    Image output(source.Width(), source.Height());
+
+    // float3 store, blue is also cleared for velocity
+    auto mask = constants.velocity == 0 ? Float4::Set(1.0f, 1.0f, 1.0f, 0.0f) : Float4::Set(1.0f, -1.0f, 0.0f, 0.0f);
+
+    for (int y = 0; y < source.Height(); y++)
+    {
+        if ((uint32_t) y < constants.offset || (uint32_t) y > constants.height + constants.offset)
+            continue;
+
+        // Coordinate is an uint in the shader, rows above zero wrap around and the store is dropped
+        auto destY = (int64_t) constants.height - y - constants.offset;
+
+        if (destY < 0)
+            continue;
+
+        for (int x = 0; x < source.Width(); x++)
+            output.Store(x, (int) destY, Color::FromVec(source.Load(x, y).Vec() * mask));
+    }
+
+    return output;
+}
+
+} // namespace Reference
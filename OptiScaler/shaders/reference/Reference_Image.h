@@ -0,0 +1,107 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "Reference_Simd.h"
+
+// CPU versions of the internal compute shaders, api independent so they also build on Linux.
+//
+// They follow the HLSL code step by step in 32 bit float, out of bounds Load returns zero like it
+// does on the GPU. Meant for checking shader changes numerically, not for rendering.
+namespace Reference
+{
+
+struct Color
+{
+    float r = 0.0f;
+    float g = 0.0f;
+    float b = 0.0f;
+    float a = 0.0f;
+
+    Float4 Vec() const { return Float4::Load(&r); }
+    static Color FromVec(const Float4& vec)
+    {
+        Color color;
+        vec.Store(&color.r);
+        return color;
+    }
+
+    Color operator+(const Color& other) const { return FromVec(Vec() + other.Vec()); }
+    Color operator*(float value) const { return FromVec(Vec() * value); }
+};
+
+static_assert(sizeof(Color) == 4 * sizeof(float), "Color is loaded as one Float4");
+
+class Image
+{
+  public:
+    Image() = default;
+    Image(int width, int height) : _width(width), _height(height), _pixels((size_t) width * height) {}
+
+    int Width() const { return _width; }
+    int Height() const { return _height; }
+
+    bool Contains(int x, int y) const { return x >= 0 && y >= 0 && x < _width && y < _height; }
+
+    // Texture2D.Load
+    Color Load(int x, int y) const
+    {
+        if (!Contains(x, y))
+            return {};
+
+        return _pixels[(size_t) y * _width + x];
+    }
+
+    // Out of bounds writes are dropped like UAV stores
+    void Store(int x, int y, const Color& color)
+    {
+        if (Contains(x, y))
+            _pixels[(size_t) y * _width + x] = color;
+    }
+
+    Color* Data() { return _pixels.data(); }
+    const Color* Data() const { return _pixels.data(); }
+
+  private:
+    int _width = 0;
+    int _height = 0;
+    std::vector<Color> _pixels;
+};
+
+inline float Saturate(float value) { return std::clamp(value, 0.0f, 1.0f); }
+inline float Frac(float value) { return value - std::floor(value); }
+inline float Rcp(float value) { return 1.0f / value; }
+inline float Lerp(float a, float b, float t) { return a + (b - a) * t; }
+
+// Float to int conversion of HLSL, truncates towards zero
+inline int ToInt(float value) { return (int) value; }
+
+// Largest difference of the color channels, alpha is compared only when requested
+inline float MaxDifference(const Image& a, const Image& b, bool compareAlpha = false)
+{
+    if (a.Width() != b.Width() || a.Height() != b.Height())
+        return INFINITY;
+
+    float result = 0.0f;
+
+    for (int y = 0; y < a.Height(); y++)
+    {
+        for (int x = 0; x < a.Width(); x++)
+        {
+            auto ca = a.Load(x, y);
+            auto cb = b.Load(x, y);
+
+            result = std::max({ result, std::abs(ca.r - cb.r), std::abs(ca.g - cb.g), std::abs(ca.b - cb.b) });
+
+            if (compareAlpha)
+                result = std::max(result, std::abs(ca.a - cb.a));
+        }
+    }
+
+    return result;
+}
+
+} // namespace Reference
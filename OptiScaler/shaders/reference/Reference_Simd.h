@@ -0,0 +1,181 @@
+#pragma once
+
+#include <cmath>
+
+// Four float lanes, one texel (rgba) per vector.
+//
+// SSE2 on x86, NEON on ARM64 and plain floats elsewhere. Define REFERENCE_SCALAR to force the plain
+// version, every operation is IEEE exact in all of them so the results are bit identical. Min and Max
+// return the second operand when one is NaN like minps / maxps do.
+#if !defined(REFERENCE_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64))
+#define REFERENCE_SSE
+#include <emmintrin.h>
+#elif !defined(REFERENCE_SCALAR) && (defined(__aarch64__) || defined(_M_ARM64))
+#define REFERENCE_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Reference
+{
+
+class Float4
+{
+  public:
+    Float4() : Float4(Splat(0.0f)) {}
+
+    static Float4 Load(const float* values)
+    {
+#if defined(REFERENCE_SSE)
+        return _mm_loadu_ps(values);
+#elif defined(REFERENCE_NEON)
+        return vld1q_f32(values);
+#else
+        return { values[0], values[1], values[2], values[3] };
+#endif
+    }
+
+    void Store(float* values) const
+    {
+#if defined(REFERENCE_SSE)
+        _mm_storeu_ps(values, _v);
+#elif defined(REFERENCE_NEON)
+        vst1q_f32(values, _v);
+#else
+        for (int i = 0; i < 4; i++)
+            values[i] = _v[i];
+#endif
+    }
+
+    static Float4 Splat(float value)
+    {
+#if defined(REFERENCE_SSE)
+        return _mm_set1_ps(value);
+#elif defined(REFERENCE_NEON)
+        return vdupq_n_f32(value);
+#else
+        return { value, value, value, value };
+#endif
+    }
+
+    static Float4 Set(float x, float y, float z, float w)
+    {
+        float values[4] = { x, y, z, w };
+        return Load(values);
+    }
+
+    float Get(int index) const
+    {
+        float values[4];
+        Store(values);
+        return values[index];
+    }
+
+    friend Float4 operator+(const Float4& a, const Float4& b)
+    {
+#if defined(REFERENCE_SSE)
+        return _mm_add_ps(a._v, b._v);
+#elif defined(REFERENCE_NEON)
+        return vaddq_f32(a._v, b._v);
+#else
+        return { a._v[0] + b._v[0], a._v[1] + b._v[1], a._v[2] + b._v[2], a._v[3] + b._v[3] };
+#endif
+    }
+
+    friend Float4 operator-(const Float4& a, const Float4& b)
+    {
+#if defined(REFERENCE_SSE)
+        return _mm_sub_ps(a._v, b._v);
+#elif defined(REFERENCE_NEON)
+        return vsubq_f32(a._v, b._v);
+#else
+        return { a._v[0] - b._v[0], a._v[1] - b._v[1], a._v[2] - b._v[2], a._v[3] - b._v[3] };
+#endif
+    }
+
+    friend Float4 operator*(const Float4& a, const Float4& b)
+    {
+#if defined(REFERENCE_SSE)
+        return _mm_mul_ps(a._v, b._v);
+#elif defined(REFERENCE_NEON)
+        return vmulq_f32(a._v, b._v);
+#else
+        return { a._v[0] * b._v[0], a._v[1] * b._v[1], a._v[2] * b._v[2], a._v[3] * b._v[3] };
+#endif
+    }
+
+    friend Float4 operator/(const Float4& a, const Float4& b)
+    {
+#if defined(REFERENCE_SSE)
+        return _mm_div_ps(a._v, b._v);
+#elif defined(REFERENCE_NEON)
+        return vdivq_f32(a._v, b._v);
+#else
+        return { a._v[0] / b._v[0], a._v[1] / b._v[1], a._v[2] / b._v[2], a._v[3] / b._v[3] };
+#endif
+    }
+
+    friend Float4 operator*(const Float4& a, float b) { return a * Splat(b); }
+    friend Float4 operator-(const Float4& a) { return Splat(0.0f) - a; }
+
+    static Float4 Min(const Float4& a, const Float4& b)
+    {
+#if defined(REFERENCE_SSE)
+        return _mm_min_ps(a._v, b._v);
+#elif defined(REFERENCE_NEON)
+        return vbslq_f32(vcltq_f32(a._v, b._v), a._v, b._v);
+#else
+        return { a._v[0] < b._v[0] ? a._v[0] : b._v[0], a._v[1] < b._v[1] ? a._v[1] : b._v[1],
+                 a._v[2] < b._v[2] ? a._v[2] : b._v[2], a._v[3] < b._v[3] ? a._v[3] : b._v[3] };
+#endif
+    }
+
+    static Float4 Max(const Float4& a, const Float4& b)
+    {
+#if defined(REFERENCE_SSE)
+        return _mm_max_ps(a._v, b._v);
+#elif defined(REFERENCE_NEON)
+        return vbslq_f32(vcgtq_f32(a._v, b._v), a._v, b._v);
+#else
+        return { a._v[0] > b._v[0] ? a._v[0] : b._v[0], a._v[1] > b._v[1] ? a._v[1] : b._v[1],
+                 a._v[2] > b._v[2] ? a._v[2] : b._v[2], a._v[3] > b._v[3] ? a._v[3] : b._v[3] };
+#endif
+    }
+
+    static Float4 Abs(const Float4& a)
+    {
+#if defined(REFERENCE_SSE)
+        return _mm_andnot_ps(_mm_set1_ps(-0.0f), a._v);
+#elif defined(REFERENCE_NEON)
+        return vabsq_f32(a._v);
+#else
+        return { std::fabs(a._v[0]), std::fabs(a._v[1]), std::fabs(a._v[2]), std::fabs(a._v[3]) };
+#endif
+    }
+
+    static Float4 Sqrt(const Float4& a)
+    {
+#if defined(REFERENCE_SSE)
+        return _mm_sqrt_ps(a._v);
+#elif defined(REFERENCE_NEON)
+        return vsqrtq_f32(a._v);
+#else
+        return { std::sqrt(a._v[0]), std::sqrt(a._v[1]), std::sqrt(a._v[2]), std::sqrt(a._v[3]) };
+#endif
+    }
+
+    static Float4 Saturate(const Float4& a) { return Min(Max(a, Splat(0.0f)), Splat(1.0f)); }
+
+  private:
+#if defined(REFERENCE_SSE)
+    __m128 _v;
+    Float4(__m128 v) : _v(v) {}
+#elif defined(REFERENCE_NEON)
+    float32x4_t _v;
+    Float4(float32x4_t v) : _v(v) {}
+#else
+    float _v[4];
+    Float4(float x, float y, float z, float w) : _v { x, y, z, w } {}
+#endif
+};
+
+} // namespace Reference
@@ -3,15 +3,9 @@
 #include <d3dcompiler.h>
 #include <DirectXMath.h>
 
-using namespace DirectX;
+#include "RF_Constants.h"
 
-struct alignas(256) RFConstants
-{
-    UINT width;
-    UINT height;
-    UINT offset;
-    UINT velocity;
-};
+using namespace DirectX;
 
 inline static std::string rfCode = R"(
 cbuffer Params : register(b0)
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+// Constant buffer of the resource flip shader, also used by the CPU version in shaders/reference
+struct alignas(256) RFConstants
+{
+    uint32_t width;
+    uint32_t height;
+    uint32_t offset;
+    uint32_t velocity;
+};
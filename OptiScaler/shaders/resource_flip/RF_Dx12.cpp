@@ -2,6 +2,7 @@
 
 #include <Config.h>
 #include <State.h>
+#include <misc/ShaderCache_Dx12.h>
 
 #include "precompiled/RF_Shader.h"
 
@@ -48,7 +49,7 @@ static bool CreateComputeShader(ID3D12Device* device, ID3D12RootSignature* rootS
     psoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
     psoDesc.CS = CD3DX12_SHADER_BYTECODE(shaderBlob->GetBufferPointer(), shaderBlob->GetBufferSize());
 
-    HRESULT hr = device->CreateComputePipelineState(&psoDesc, __uuidof(ID3D12PipelineState*), (void**) pipelineState);
+    HRESULT hr = ShaderCache_Dx12::CreateComputePipeline(device, psoDesc, pipelineState);
 
     if (FAILED(hr))
     {
@@ -280,8 +281,7 @@ RF_Dx12::RF_Dx12(std::string InName, ID3D12Device* InDevice) : _name(InName), _d
             break;
         }
 
-        hr = InDevice->CreateRootSignature(0, signatureBlob->GetBufferPointer(), signatureBlob->GetBufferSize(),
-                                           IID_PPV_ARGS(&_rootSignature));
+        hr = ShaderCache_Dx12::CreateRootSignature(InDevice, signatureBlob, &_rootSignature);
 
         if (FAILED(hr))
         {
@@ -315,8 +315,7 @@ RF_Dx12::RF_Dx12(std::string InName, ID3D12Device* InDevice) : _name(InName), _d
         computePsoDesc.pRootSignature = _rootSignature;
         computePsoDesc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
         computePsoDesc.CS = CD3DX12_SHADER_BYTECODE(reinterpret_cast<const void*>(RF_cso), sizeof(RF_cso));
-        auto hr = InDevice->CreateComputePipelineState(&computePsoDesc, __uuidof(ID3D12PipelineState*),
-                                                       (void**) &_pipelineState);
+        auto hr = ShaderCache_Dx12::CreateComputePipeline(InDevice, computePsoDesc, &_pipelineState);
 
         if (FAILED(hr))
         {
@@ -329,7 +328,7 @@ RF_Dx12::RF_Dx12(std::string InName, ID3D12Device* InDevice) : _name(InName), _d
         // Compile shader blobs
         ID3DBlob* _recEncodeShader = nullptr;
 
-        _recEncodeShader = RF_CompileShader(rfCode.c_str(), "CSMain", "cs_5_0");
+        _recEncodeShader = ShaderCache_Dx12::CompileShader(rfCode.c_str(), "CSMain", "cs_5_0", RF_CompileShader);
 
         if (_recEncodeShader == nullptr)
         {
@@ -2,6 +2,7 @@
 
 #include <Logger.h>
 #include <Util.h>
+#include <misc/ShaderCache_Dx12.h>
 
 #include <d3d12.h>
 #include <d3dcompiler.h>
@@ -986,6 +987,12 @@ bool SMAA_Dx12::EnsureShaders(const D3D12_RESOURCE_DESC& inputDesc)
     compileFlags |= D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
 #endif
 
+    // Defines and flags change the bytecode too, they are part of the cache key
+    uint64_t cacheSeed = ShaderCache::Hash(&compileFlags, sizeof(compileFlags));
+
+    for (const auto& entry : macroPairs)
+        cacheSeed = ShaderCache::Hash(entry.second.c_str(), ShaderCache::Hash(entry.first.c_str(), cacheSeed));
+
     auto compileShader = [&](const char* entryPoint, Microsoft::WRL::ComPtr<ID3DBlob>& blob) -> bool {
         Microsoft::WRL::ComPtr<ID3DBlob> errors;
         HRESULT hr = S_OK;
@@ -996,8 +1003,18 @@ bool SMAA_Dx12::EnsureShaders(const D3D12_RESOURCE_DESC& inputDesc)
         }
         else
         {
+            auto cacheKey = ShaderCache_Dx12::BytecodeKey(g_cmaa2ShaderSource, sizeof(g_cmaa2ShaderSource) - 1,
+                                                          entryPoint, "cs_5_1", cacheSeed);
+            blob.Attach(ShaderCache_Dx12::FindBytecode(cacheKey));
+
+            if (blob)
+                return true;
+
             hr = D3DCompile(g_cmaa2ShaderSource, sizeof(g_cmaa2ShaderSource) - 1, "CMAA2.hlsl", macros.data(), nullptr,
                             entryPoint, "cs_5_1", compileFlags, 0, &blob, &errors);
+
+            if (SUCCEEDED(hr))
+                ShaderCache_Dx12::StoreBytecode(cacheKey, blob.Get());
         }
         if (FAILED(hr))
         {
@@ -1059,8 +1076,7 @@ bool SMAA_Dx12::EnsureShaders(const D3D12_RESOURCE_DESC& inputDesc)
         return false;
     }
 
-    hr = _device->CreateRootSignature(0, serialized->GetBufferPointer(), serialized->GetBufferSize(),
-                                      IID_PPV_ARGS(_rootSignature.ReleaseAndGetAddressOf()));
+    hr = ShaderCache_Dx12::CreateRootSignature(_device, serialized.Get(), _rootSignature.ReleaseAndGetAddressOf());
     if (FAILED(hr))
     {
         LOG_ERROR("[{}] Failed to create CMAA2 root signature (hr={:x})", _name, hr);
@@ -1091,7 +1107,7 @@ bool SMAA_Dx12::EnsureShaders(const D3D12_RESOURCE_DESC& inputDesc)
         D3D12_COMPUTE_PIPELINE_STATE_DESC psoDesc = {};
         psoDesc.pRootSignature = _rootSignature.Get();
         psoDesc.CS = { shaderBlob->GetBufferPointer(), shaderBlob->GetBufferSize() };
-        HRESULT localHr = _device->CreateComputePipelineState(&psoDesc, IID_PPV_ARGS(&pipeline));
+        HRESULT localHr = ShaderCache_Dx12::CreateComputePipeline(_device, psoDesc, pipeline.ReleaseAndGetAddressOf());
         if (FAILED(localHr))
         {
             LOG_ERROR("[{}] Failed to create CMAA2 pipeline state (hr={:x})", _name, localHr);
@@ -62,7 +62,7 @@ inline static bool SkipSpoofing()
     if (skip)
     {
         LOG_TRACE("DxgiSpoofing: {}, skipSpoofing: {}, skipping spoofing",
-                  Config::Instance()->DxgiSpoofing.value_or_default(), State::Instance().skipSpoofing);
+                  Config::Instance()->DxgiSpoofing.value_or_default(), (bool) State::Instance().skipSpoofing);
 
         return true;
     }
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+
+// Builds a new upscaler feature on a worker thread while the current one keeps rendering.
+//
+// Start, TrySwap, TakeFailed and Cancel must be called from the thread which owns the current
+// feature (render thread). Worker only runs the init of the feature it was given and publishes the
+// result with the status, so the exchange itself is done at a frame boundary without any locking.
+template <typename Feature> class BackendWarmup
+{
+  public:
+    enum class Status : uint32_t
+    {
+        Idle,
+        Building,
+        Ready,
+        Failed
+    };
+
+    // Inits the feature on the worker thread, returns false when it fails
+    using Init = std::function<bool(Feature&)>;
+
+  private:
+    std::atomic<Status> _status = Status::Idle;
+    std::unique_ptr<Feature> _pending;
+    std::string _backend;
+    std::thread _worker;
+
+    void Join()
+    {
+        if (_worker.joinable())
+            _worker.join();
+    }
+
+  public:
+    BackendWarmup() = default;
+    BackendWarmup(const BackendWarmup&) = delete;
+    BackendWarmup& operator=(const BackendWarmup&) = delete;
+
+    ~BackendWarmup() { Cancel(); }
+
+    Status GetStatus() const { return _status.load(std::memory_order_acquire); }
+    bool IsActive() const { return GetStatus() != Status::Idle; }
+
+    // Backend name of the running or finished warm-up
+    const std::string& Backend() const { return _backend; }
+
+    // Feature is created by the caller on its own thread, only init runs on the worker. Returns false
+    // when a warm-up is already active.
+    bool Start(std::string backend, std::unique_ptr<Feature> feature, Init init)
+    {
+        if (IsActive() || feature == nullptr || !init)
+            return false;
+
+        Join();
+
+        _backend = std::move(backend);
+        _pending = std::move(feature);
+        _status.store(Status::Building, std::memory_order_release);
+
+        _worker = std::thread(
+            [this, init = std::move(init)]()
+            {
+                bool built = init(*_pending);
+                _status.store(built ? Status::Ready : Status::Failed, std::memory_order_release);
+            });
+
+        return true;
+    }
+
+    // When the new feature is ready, hands current to retire and makes the new one current. Retire
+    // takes the previous feature (it might still be in use by the GPU) and returns false when it can't
+    // be retired now, then nothing changes and the swap can be tried again next frame.
+    template <typename Retire> bool TrySwap(std::unique_ptr<Feature>& current, Retire&& retire)
+    {
+        if (GetStatus() != Status::Ready)
+            return false;
+
+        Join();
+
+        if (!retire(current))
+            return false;
+
+        current = std::move(_pending);
+        _status.store(Status::Idle, std::memory_order_release);
+
+        return true;
+    }
+
+    // Clears a failed warm-up so a new one can be started, returns true if it was failed. Failed
+    // feature is destroyed here, on the owner thread.
+    bool TakeFailed()
+    {
+        if (GetStatus() != Status::Failed)
+            return false;
+
+        Join();
+
+        _pending.reset();
+        _status.store(Status::Idle, std::memory_order_release);
+
+        return true;
+    }
+
+    // Waits for the worker and drops the feature it built
+    void Cancel()
+    {
+        Join();
+
+        _pending.reset();
+        _status.store(Status::Idle, std::memory_order_release);
+    }
+};
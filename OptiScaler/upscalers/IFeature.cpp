@@ -8,6 +8,24 @@ void IFeature::SetHandle(unsigned int InHandleId)
     LOG_INFO("Handle: {0}", _handle->Id);
 }
 
+void IFeature::RunShared(std::function<void()> work)
+{
+    if (_deferShared)
+        _sharedWork.push_back(std::move(work));
+    else
+        work();
+}
+
+void IFeature::ApplyShared()
+{
+    _deferShared = false;
+
+    for (auto& work : _sharedWork)
+        work();
+
+    _sharedWork.clear();
+}
+
 bool IFeature::SetInitParameters(NVSDK_NGX_Parameter* InParameters)
 {
     unsigned int width = 0;
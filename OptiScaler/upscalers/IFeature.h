@@ -4,7 +4,9 @@
 #include <nvsdk_ngx.h>
 #include <nvsdk_ngx_defs.h>
 
+#include <functional>
 #include <unordered_set>
+#include <vector>
 
 #define DLSS_MOD_ID_OFFSET 1000000
 
@@ -47,6 +49,10 @@ class IFeature
 
     std::unordered_set<std::pair<float, float>, hashFunction> _jitterInfo;
 
+    // Set while the feature is built on the warm-up worker, shared work waits for ApplyShared
+    bool _deferShared = false;
+    std::vector<std::function<void()>> _sharedWork;
+
   protected:
     bool _initParameters = false;
     NVSDK_NGX_Handle* _handle = nullptr;
@@ -79,6 +85,10 @@ class IFeature
 
     virtual void SetInit(bool InValue) { _isInited = InValue; }
 
+    // Init work which writes State/Config or creates shared objects like the menu. Runs at once, or on
+    // the render thread at the swap when the feature is built in background.
+    void RunShared(std::function<void()> work);
+
   public:
     NVSDK_NGX_Handle* Handle() const { return _handle; };
     static unsigned int GetNextHandleId() { return handleCounter++; }
@@ -90,6 +100,11 @@ class IFeature
     size_t JitterCount() { return _jitterInfo.size(); }
 
     void TickFrozenCheck();
+
+    // Called before Init on the warm-up worker, shared work of Init is kept until ApplyShared
+    void DeferShared() { _deferShared = true; }
+    // Render thread, runs the kept shared work in the order Init queued it
+    void ApplyShared();
     bool IsFrozen() const { return _featureFrozen; };
     bool UpdateOutputResolution(const NVSDK_NGX_Parameter* InParameters);
     unsigned int DisplayWidth() const { return _displayWidth; };
@@ -55,6 +55,8 @@ bool IFeature_Dx11wDx12::CopyTextureFrom11To12(ID3D11Resource* InResource, D3D11
         {
             if (OutResource->SharedTexture != nullptr)
             {
+                // Previous frame might still be reading it on the Dx12 queue
+                WaitForDx12Fence(_submitRing.LastFence());
                 OutResource->SharedTexture->Release();
 
                 if (OutResource->Dx12Handle != NULL &&
@@ -151,6 +153,7 @@ bool IFeature_Dx11wDx12::CopyTextureFrom11To12(ID3D11Resource* InResource, D3D11
             {
                 if (OutResource->SharedTexture != nullptr)
                 {
+                    WaitForDx12Fence(_submitRing.LastFence());
                     OutResource->SharedTexture->Release();
 
                     if (OutResource->Dx12Handle != NULL &&
@@ -244,6 +247,8 @@ bool IFeature_Dx11wDx12::CopyTextureFrom11To12(ID3D11Resource* InResource, D3D11
 
 void IFeature_Dx11wDx12::ReleaseSharedResources()
 {
+    WaitForDx12Fence(_submitRing.LastFence());
+
     SAFE_RELEASE(dx11Color.SharedTexture);
     SAFE_RELEASE(dx11Mv.SharedTexture);
     SAFE_RELEASE(dx11Out.SharedTexture);
@@ -259,12 +264,15 @@ void IFeature_Dx11wDx12::ReleaseSharedResources()
 
     ReleaseSyncResources();
 
-    SAFE_RELEASE(Dx12CommandList[0]);
-    SAFE_RELEASE(Dx12CommandList[1]);
+    for (uint32_t i = 0; i < Dx12FramesInFlight; i++)
+    {
+        SAFE_RELEASE(Dx12CommandList[i]);
+        SAFE_RELEASE(Dx12CommandAllocator[i]);
+    }
+
     SAFE_RELEASE(Dx12CommandQueue);
-    SAFE_RELEASE(Dx12CommandAllocator[0]);
-    SAFE_RELEASE(Dx12CommandAllocator[1]);
     SAFE_RELEASE(Dx12Fence);
+    _submitRing.Reset();
 
     if (Dx12FenceEvent)
     {
@@ -425,61 +433,35 @@ HRESULT IFeature_Dx11wDx12::CreateDx12Device(D3D_FEATURE_LEVEL InFeatureLevel)
         }
     }
 
-    if (Dx12CommandAllocator[0] == nullptr)
+    for (uint32_t i = 0; i < Dx12FramesInFlight; i++)
     {
-        result = State::Instance().currentD3D12Device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT,
-                                                                              IID_PPV_ARGS(&Dx12CommandAllocator[0]));
-
-        if (result != S_OK)
+        if (Dx12CommandAllocator[i] == nullptr)
         {
-            LOG_ERROR("CreateCommandAllocator error: {0:x}", result);
-            State::Instance().vulkanSkipHooks = false;
-            State::Instance().skipSpoofing = false;
-            return E_NOINTERFACE;
-        }
-    }
+            result = State::Instance().currentD3D12Device->CreateCommandAllocator(
+                D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&Dx12CommandAllocator[i]));
 
-    if (Dx12CommandAllocator[1] == nullptr)
-    {
-        result = State::Instance().currentD3D12Device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT,
-                                                                              IID_PPV_ARGS(&Dx12CommandAllocator[1]));
-
-        if (result != S_OK)
-        {
-            LOG_ERROR("CreateCommandAllocator error: {0:x}", result);
-            State::Instance().vulkanSkipHooks = false;
-            State::Instance().skipSpoofing = false;
-            return E_NOINTERFACE;
+            if (result != S_OK)
+            {
+                LOG_ERROR("CreateCommandAllocator[{}] error: {:x}", i, result);
+                State::Instance().vulkanSkipHooks = false;
+                State::Instance().skipSpoofing = false;
+                return E_NOINTERFACE;
+            }
         }
-    }
 
-    if (Dx12CommandList[0] == nullptr)
-    {
-        // CreateCommandList
-        result = State::Instance().currentD3D12Device->CreateCommandList(
-            0, D3D12_COMMAND_LIST_TYPE_DIRECT, Dx12CommandAllocator[0], nullptr, IID_PPV_ARGS(&Dx12CommandList[0]));
-
-        if (result != S_OK)
+        if (Dx12CommandList[i] == nullptr)
         {
-            LOG_ERROR("CreateCommandList error: {0:x}", result);
-            State::Instance().vulkanSkipHooks = false;
-            State::Instance().skipSpoofing = false;
-            return E_NOINTERFACE;
-        }
-    }
+            // CreateCommandList
+            result = State::Instance().currentD3D12Device->CreateCommandList(
+                0, D3D12_COMMAND_LIST_TYPE_DIRECT, Dx12CommandAllocator[i], nullptr, IID_PPV_ARGS(&Dx12CommandList[i]));
 
-    if (Dx12CommandList[1] == nullptr)
-    {
-        // CreateCommandList
-        result = State::Instance().currentD3D12Device->CreateCommandList(
-            0, D3D12_COMMAND_LIST_TYPE_DIRECT, Dx12CommandAllocator[1], nullptr, IID_PPV_ARGS(&Dx12CommandList[1]));
-
-        if (result != S_OK)
-        {
-            LOG_ERROR("CreateCommandList error: {0:x}", result);
-            State::Instance().vulkanSkipHooks = false;
-            State::Instance().skipSpoofing = false;
-            return E_NOINTERFACE;
+            if (result != S_OK)
+            {
+                LOG_ERROR("CreateCommandList[{}] error: {:x}", i, result);
+                State::Instance().vulkanSkipHooks = false;
+                State::Instance().skipSpoofing = false;
+                return E_NOINTERFACE;
+            }
         }
     }
 
@@ -511,16 +493,31 @@ HRESULT IFeature_Dx11wDx12::CreateDx12Device(D3D_FEATURE_LEVEL InFeatureLevel)
     return S_OK;
 }
 
-bool IFeature_Dx11wDx12::ProcessDx11Textures(const NVSDK_NGX_Parameter* InParameters)
+void IFeature_Dx11wDx12::WaitForDx12Fence(uint64_t InValue)
 {
-    // Wait for last frame
-    if (Dx12Fence->GetCompletedValue() < _frameCount)
+    if (InValue == 0 || Dx12Fence == nullptr || Dx12FenceEvent == nullptr)
+        return;
+
+    if (Dx12Fence->GetCompletedValue() < InValue)
     {
-        Dx12Fence->SetEventOnCompletion(_frameCount, Dx12FenceEvent);
+        Dx12Fence->SetEventOnCompletion(InValue, Dx12FenceEvent);
         WaitForSingleObject(Dx12FenceEvent, INFINITE);
     }
+}
 
-    auto frame = _frameCount % 2;
+void IFeature_Dx11wDx12::SubmitDx12Frame()
+{
+    Dx12CommandQueue->Signal(Dx12Fence, _frameCount);
+    _submitRing.Submit(_frameCount);
+}
+
+bool IFeature_Dx11wDx12::ProcessDx11Textures(const NVSDK_NGX_Parameter* InParameters)
+{
+    // Only wait for the frame which used this slot's allocator, previous frame can still be running.
+    // Shared textures don't need a CPU wait, Dx11 copies are queued after the Dx11 wait in CopyBackOutput.
+    WaitForDx12Fence(_submitRing.RequiredFence());
+
+    auto frame = _submitRing.Current();
 
     Dx12CommandAllocator[frame]->Reset();
     Dx12CommandList[frame]->Reset(Dx12CommandAllocator[frame], nullptr);
@@ -819,18 +816,22 @@ bool IFeature_Dx11wDx12::ProcessDx11Textures(const NVSDK_NGX_Parameter* InParame
     return true;
 }
 
-bool IFeature_Dx11wDx12::CopyBackOutput()
+void IFeature_Dx11wDx12::SyncDx12ToDx11()
 {
-    // Fence ones
-    {
-        // wait for fsr on dx12
-        Dx11DeviceContext->Wait(dx11FenceTextureCopy, _fenceValue);
-        _fenceValue++;
+    if (dx11FenceTextureCopy == nullptr || dx12FenceTextureCopy == nullptr)
+        return;
 
-        // Copy Back
-        Dx11DeviceContext->CopyResource(paramOutput[_frameCount % 2], dx11Out.SharedTexture);
-    }
+    Dx12CommandQueue->Signal(dx12FenceTextureCopy, _fenceValue);
 
+    // wait for upscaler on dx12
+    Dx11DeviceContext->Wait(dx11FenceTextureCopy, _fenceValue);
+    _fenceValue++;
+}
+
+bool IFeature_Dx11wDx12::CopyBackOutput()
+{
+    // Dx11 already waits for the upscaler in SyncDx12ToDx11
+    Dx11DeviceContext->CopyResource(paramOutput[_frameCount % 2], dx11Out.SharedTexture);
     return true;
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 #include "IFeature_Dx11.h"
+#include "SubmitRing.h"
 
 #include <menu/menu_dx11.h>
 
@@ -40,12 +41,17 @@ class IFeature_Dx11wDx12 : public virtual IFeature_Dx11
     ID3D11DeviceContext4* Dx11DeviceContext = nullptr;
 
     // D3D11with12
+    // Frames which can be recorded while previous ones are still running on the Dx12 queue.
+    // Shader helpers (RCAS, Bias, OS) double buffer their descriptors so this can't be increased alone.
+    static constexpr uint32_t Dx12FramesInFlight = 2;
+
     // ID3D12Device* Dx12Device = nullptr;
     ID3D12CommandQueue* Dx12CommandQueue = nullptr;
-    ID3D12CommandAllocator* Dx12CommandAllocator[2] = { nullptr, nullptr };
-    ID3D12GraphicsCommandList* Dx12CommandList[2] = { nullptr, nullptr };
+    ID3D12CommandAllocator* Dx12CommandAllocator[Dx12FramesInFlight] = {};
+    ID3D12GraphicsCommandList* Dx12CommandList[Dx12FramesInFlight] = {};
     ID3D12Fence* Dx12Fence = nullptr;
     HANDLE Dx12FenceEvent = nullptr;
+    SubmitRing<Dx12FramesInFlight> _submitRing;
 
     D3D11_TEXTURE2D_RESOURCE_C dx11Color = {};
     D3D11_TEXTURE2D_RESOURCE_C dx11Mv = {};
@@ -75,6 +81,17 @@ class IFeature_Dx11wDx12 : public virtual IFeature_Dx11
     bool ProcessDx11Textures(const NVSDK_NGX_Parameter* InParameters);
     bool CopyBackOutput();
 
+    // Signals the copy fence on the Dx12 queue and makes the Dx11 context wait for it. Must follow every
+    // Dx12 submit, also when evaluation failed, otherwise fence values of the two queues go out of step
+    void SyncDx12ToDx11();
+
+    // Command list of the current submit slot, ProcessDx11Textures resets it for recording
+    ID3D12GraphicsCommandList* CurrentDx12CommandList() const { return Dx12CommandList[_submitRing.Current()]; }
+
+    // Signals Dx12Fence with _frameCount and moves to the next submit slot
+    void SubmitDx12Frame();
+    void WaitForDx12Fence(uint64_t InValue);
+
     void ResourceBarrier(ID3D12GraphicsCommandList* InCommandList, ID3D12Resource* InResource,
                          D3D12_RESOURCE_STATES InBeforeState, D3D12_RESOURCE_STATES InAfterState);
 
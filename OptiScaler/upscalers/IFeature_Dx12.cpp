@@ -1,6 +1,7 @@
 #include "IFeature_Dx12.h"
 #include <pch.h>
 
+#include "Config.h"
 #include "State.h"
 
 void IFeature_Dx12::ResourceBarrier(ID3D12GraphicsCommandList* InCommandList, ID3D12Resource* InResource,
@@ -15,6 +16,26 @@ void IFeature_Dx12::ResourceBarrier(ID3D12GraphicsCommandList* InCommandList, ID
     InCommandList->ResourceBarrier(1, &barrier);
 }
 
+bool IFeature_Dx12::FusedPostPass(ID3D12GraphicsCommandList* InCommandList, ID3D12Resource* InResource,
+                                  ID3D12Resource* InMotionVectors, RcasConstants& InConstants,
+                                  ID3D12Resource* OutResource)
+{
+    // FSR EASU is only available precompiled
+    if (!Config::Instance()->OutputScalingFused.value_or_default() ||
+        Config::Instance()->OutputScalingUseFsr.value_or_default())
+    {
+        return false;
+    }
+
+    if (PostFused == nullptr)
+        PostFused = std::make_unique<PF_Dx12>("PostFused", Device);
+
+    if (!PostFused->IsInit())
+        return false;
+
+    return PostFused->Dispatch(Device, InCommandList, InResource, InMotionVectors, InConstants, OutResource);
+}
+
 IFeature_Dx12::IFeature_Dx12(unsigned int InHandleId, NVSDK_NGX_Parameter* InParameters) {}
 
 void IFeature_Dx12::Shutdown() {}
@@ -24,7 +45,9 @@ IFeature_Dx12::~IFeature_Dx12()
     if (State::Instance().isShuttingDown)
         return;
 
-    if (Imgui != nullptr && Imgui.get() != nullptr)
+    // Menu is shared, a replaced feature which is released later on the present thread must not take it
+    // from the current one
+    if (State::Instance().currentFeature == this && Imgui != nullptr && Imgui.get() != nullptr)
         Imgui.reset();
 
     if (OutputScaler != nullptr && OutputScaler.get() != nullptr)
@@ -38,4 +61,7 @@ IFeature_Dx12::~IFeature_Dx12()
 
     if (SMAA != nullptr && SMAA.get() != nullptr)
         SMAA.reset();
+
+    if (PostFused != nullptr && PostFused.get() != nullptr)
+        PostFused.reset();
 }
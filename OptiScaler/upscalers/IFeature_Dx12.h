@@ -7,6 +7,7 @@
 #include <menu/menu_dx12.h>
 #include <shaders/output_scaling/OS_Dx12.h>
 #include <shaders/rcas/RCAS_Dx12.h>
+#include <shaders/post_fused/PF_Dx12.h>
 #include <shaders/bias/Bias_Dx12.h>
 #include <shaders/smaa/SMAA_Dx12.h>
 
@@ -19,10 +20,15 @@ class IFeature_Dx12 : public virtual IFeature
     std::unique_ptr<RCAS_Dx12> RCAS = nullptr;
     std::unique_ptr<Bias_Dx12> Bias = nullptr;
     std::unique_ptr<SMAA_Dx12> SMAA = nullptr;
+    std::unique_ptr<PF_Dx12> PostFused = nullptr;
 
     void ResourceBarrier(ID3D12GraphicsCommandList* InCommandList, ID3D12Resource* InResource,
                          D3D12_RESOURCE_STATES InBeforeState, D3D12_RESOURCE_STATES InAfterState) const;
 
+    // RCAS and output scaling in one dispatch, returns false when they should be dispatched separately
+    bool FusedPostPass(ID3D12GraphicsCommandList* InCommandList, ID3D12Resource* InResource,
+                       ID3D12Resource* InMotionVectors, RcasConstants& InConstants, ID3D12Resource* OutResource);
+
   public:
     virtual bool Init(ID3D12Device* InDevice, ID3D12GraphicsCommandList* InCommandList,
                       NVSDK_NGX_Parameter* InParameters) = 0;
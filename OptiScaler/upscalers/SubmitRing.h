@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+
+// Rotation of per frame submit slots (command allocator + list) which are protected by a fence.
+//
+// A slot can be recorded again when the fence value it was submitted with is completed, so with
+// Count slots the CPU can record up to Count - 1 frames ahead of the GPU. Only bookkeeping is done
+// here, waiting and signalling is left to the owner.
+template <uint32_t Count> class SubmitRing
+{
+    static_assert(Count > 0);
+
+    uint64_t _slotFence[Count] {};
+    uint64_t _submitted = 0;
+    uint64_t _lastFence = 0;
+
+  public:
+    static constexpr uint32_t Size = Count;
+
+    // Slot that is recorded for the next submit
+    uint32_t Current() const { return (uint32_t) (_submitted % Count); }
+
+    // Fence value that must be completed before Current() can be reset, 0 when it was never used
+    uint64_t RequiredFence() const { return _slotFence[Current()]; }
+
+    // Fence value of the last submit, waiting for it drains every slot
+    uint64_t LastFence() const { return _lastFence; }
+
+    // Marks Current() as submitted with fenceValue and moves to the next slot
+    void Submit(uint64_t fenceValue)
+    {
+        _slotFence[Current()] = fenceValue;
+        _lastFence = fenceValue;
+        _submitted++;
+    }
+
+    void Reset()
+    {
+        for (uint32_t i = 0; i < Count; i++)
+            _slotFence[i] = 0;
+
+        _submitted = 0;
+        _lastFence = 0;
+    }
+};
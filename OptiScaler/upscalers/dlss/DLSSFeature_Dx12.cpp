@@ -313,6 +313,7 @@ bool DLSSFeatureDx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_N
         ID3D12Resource* setBuffer = nullptr;
 
         bool useSS = Config::Instance()->OutputScalingEnabled.value_or_default() && LowResMV();
+        bool fusedScaling = false;
 
         InParameters->Get(NVSDK_NGX_Parameter_Output, &paramOutput);
         InParameters->Get(NVSDK_NGX_Parameter_MotionVectors, &paramMotion);
@@ -392,8 +393,10 @@ bool DLSSFeatureDx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_N
 
             if (useSS)
             {
-                if (!RCAS->Dispatch(Device, InCommandList, setBuffer, paramMotion, rcasConstants,
-                                    OutputScaler->Buffer()))
+                fusedScaling = FusedPostPass(InCommandList, setBuffer, paramMotion, rcasConstants, paramOutput);
+
+                if (!fusedScaling && !RCAS->Dispatch(Device, InCommandList, setBuffer, paramMotion, rcasConstants,
+                                                     OutputScaler->Buffer()))
                 {
                     Config::Instance()->RcasEnabled.set_volatile_value(false);
                     return true;
@@ -410,7 +413,7 @@ bool DLSSFeatureDx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_N
         }
 
         // Downsampling
-        if (useSS)
+        if (useSS && !fusedScaling)
         {
             LOG_DEBUG("downscaling output...");
             OutputScaler->SetBufferState(InCommandList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
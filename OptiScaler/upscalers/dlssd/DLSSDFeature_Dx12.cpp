@@ -120,6 +120,7 @@ bool DLSSDFeatureDx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_
         ID3D12Resource* setBuffer = nullptr;
 
         bool useSS = Config::Instance()->OutputScalingEnabled.value_or_default() && LowResMV();
+        bool fusedScaling = false;
 
         InParameters->Get(NVSDK_NGX_Parameter_Output, &paramOutput);
         InParameters->Get(NVSDK_NGX_Parameter_MotionVectors, &paramMotion);
@@ -201,8 +202,10 @@ bool DLSSDFeatureDx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_
 
             if (useSS)
             {
-                if (!RCAS->Dispatch(Device, InCommandList, setBuffer, paramMotion, rcasConstants,
-                                    OutputScaler->Buffer()))
+                fusedScaling = FusedPostPass(InCommandList, setBuffer, paramMotion, rcasConstants, paramOutput);
+
+                if (!fusedScaling && !RCAS->Dispatch(Device, InCommandList, setBuffer, paramMotion, rcasConstants,
+                                                     OutputScaler->Buffer()))
                 {
                     Config::Instance()->RcasEnabled.set_volatile_value(false);
                     return true;
@@ -219,7 +222,7 @@ bool DLSSDFeatureDx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_
         }
 
         // Downsampling
-        if (useSS)
+        if (useSS && !fusedScaling)
         {
             LOG_DEBUG("downscaling output...");
             OutputScaler->SetBufferState(InCommandList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
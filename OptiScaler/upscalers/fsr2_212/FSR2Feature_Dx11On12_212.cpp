@@ -163,8 +163,7 @@ bool FSR2FeatureDx11on12_212::Evaluate(ID3D11DeviceContext* InDeviceContext, NVS
 
     LOG_DEBUG("Input Resolution: {0}x{1}", params.renderSize.width, params.renderSize.height);
 
-    auto frame = _frameCount % 2;
-    auto cmdList = Dx12CommandList[frame];
+    auto cmdList = CurrentDx12CommandList();
 
     params.commandList = Fsr212::ffxGetCommandListDX12_212(cmdList);
 
@@ -378,7 +377,7 @@ bool FSR2FeatureDx11on12_212::Evaluate(ID3D11DeviceContext* InDeviceContext, NVS
     cmdList->Close();
     ID3D12CommandList* ppCommandLists[] = { cmdList };
     Dx12CommandQueue->ExecuteCommandLists(1, ppCommandLists);
-    Dx12CommandQueue->Signal(dx12FenceTextureCopy, _fenceValue);
+    SyncDx12ToDx11();
 
     auto evalResult = false;
 
@@ -421,7 +420,7 @@ bool FSR2FeatureDx11on12_212::Evaluate(ID3D11DeviceContext* InDeviceContext, NVS
     } while (false);
 
     _frameCount++;
-    Dx12CommandQueue->Signal(Dx12Fence, _frameCount);
+    SubmitDx12Frame();
 
     return evalResult;
 }
@@ -15,12 +15,17 @@ bool FSR2FeatureDx12_212::Init(ID3D12Device* InDevice, ID3D12GraphicsCommandList
 
     if (InitFSR2(InParameters))
     {
-        if (!Config::Instance()->OverlayMenu.value_or_default() && (Imgui == nullptr || Imgui.get() == nullptr))
-            Imgui = std::make_unique<Menu_Dx12>(Util::GetProcessWindow(), InDevice);
+        RunShared(
+            [this, InDevice]()
+            {
+                if (!Config::Instance()->OverlayMenu.value_or_default() && (Imgui == nullptr || Imgui.get() == nullptr))
+                    Imgui = std::make_unique<Menu_Dx12>(Util::GetProcessWindow(), InDevice);
 
-        OutputScaler = std::make_unique<OS_Dx12>("Output Scaling", InDevice, (TargetWidth() < DisplayWidth()));
-        RCAS = std::make_unique<RCAS_Dx12>("RCAS", InDevice);
-        Bias = std::make_unique<Bias_Dx12>("Bias", InDevice);
+                OutputScaler =
+                    std::make_unique<OS_Dx12>("Output Scaling", InDevice, (TargetWidth() < DisplayWidth()));
+                RCAS = std::make_unique<RCAS_Dx12>("RCAS", InDevice);
+                Bias = std::make_unique<Bias_Dx12>("Bias", InDevice);
+            });
 
         return true;
     }
@@ -74,6 +79,7 @@ bool FSR2FeatureDx12_212::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVS
     GetRenderResolution(InParameters, &params.renderSize.width, &params.renderSize.height);
 
     bool useSS = Config::Instance()->OutputScalingEnabled.value_or_default() && LowResMV();
+    bool fusedScaling = false;
 
     LOG_DEBUG("Input Resolution: {0}x{1}", params.renderSize.width, params.renderSize.height);
 
@@ -417,8 +423,12 @@ bool FSR2FeatureDx12_212::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVS
 
         if (useSS)
         {
-            if (!RCAS->Dispatch(Device, InCommandList, (ID3D12Resource*) params.output.resource,
-                                (ID3D12Resource*) params.motionVectors.resource, rcasConstants, OutputScaler->Buffer()))
+            fusedScaling = FusedPostPass(InCommandList, (ID3D12Resource*) params.output.resource,
+                                         (ID3D12Resource*) params.motionVectors.resource, rcasConstants, paramOutput);
+
+            if (!fusedScaling && !RCAS->Dispatch(Device, InCommandList, (ID3D12Resource*) params.output.resource,
+                                                 (ID3D12Resource*) params.motionVectors.resource, rcasConstants,
+                                                 OutputScaler->Buffer()))
             {
                 Config::Instance()->RcasEnabled.set_volatile_value(false);
                 return true;
@@ -435,7 +445,7 @@ bool FSR2FeatureDx12_212::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVS
         }
     }
 
-    if (useSS)
+    if (useSS && !fusedScaling)
     {
         LOG_DEBUG("scaling output...");
         OutputScaler->SetBufferState(InCommandList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
@@ -552,12 +562,12 @@ bool FSR2FeatureDx12_212::InitFSR2(const NVSDK_NGX_Parameter* InParameters)
         if (ssMulti < 0.5f)
         {
             ssMulti = 0.5f;
-            Config::Instance()->OutputScalingMultiplier.set_volatile_value(ssMulti);
+            RunShared([ssMulti]() { Config::Instance()->OutputScalingMultiplier.set_volatile_value(ssMulti); });
         }
         else if (ssMulti > 3.0f)
         {
             ssMulti = 3.0f;
-            Config::Instance()->OutputScalingMultiplier.set_volatile_value(ssMulti);
+            RunShared([ssMulti]() { Config::Instance()->OutputScalingMultiplier.set_volatile_value(ssMulti); });
         }
 
         _targetWidth = DisplayWidth() * ssMulti;
@@ -575,7 +585,7 @@ bool FSR2FeatureDx12_212::InitFSR2(const NVSDK_NGX_Parameter* InParameters)
         _contextDesc.maxRenderSize.width = RenderWidth();
         _contextDesc.maxRenderSize.height = RenderHeight();
 
-        Config::Instance()->OutputScalingMultiplier.set_volatile_value(1.0f);
+        RunShared([]() { Config::Instance()->OutputScalingMultiplier.set_volatile_value(1.0f); });
 
         // if output scaling active let it to handle downsampling
         if (Config::Instance()->OutputScalingEnabled.value_or_default() && LowResMV())
@@ -190,8 +190,7 @@ bool FSR31FeatureDx11on12::Evaluate(ID3D11DeviceContext* InDeviceContext, NVSDK_
 
     LOG_DEBUG("Input Resolution: {0}x{1}", params.renderSize.width, params.renderSize.height);
 
-    auto frame = _frameCount % 2;
-    auto cmdList = Dx12CommandList[frame];
+    auto cmdList = CurrentDx12CommandList();
 
     params.commandList = cmdList;
 
@@ -484,7 +483,7 @@ bool FSR31FeatureDx11on12::Evaluate(ID3D11DeviceContext* InDeviceContext, NVSDK_
     cmdList->Close();
     ID3D12CommandList* ppCommandLists[] = { cmdList };
     Dx12CommandQueue->ExecuteCommandLists(1, ppCommandLists);
-    Dx12CommandQueue->Signal(dx12FenceTextureCopy, _fenceValue);
+    SyncDx12ToDx11();
 
     auto evalResult = false;
 
@@ -527,7 +526,7 @@ bool FSR31FeatureDx11on12::Evaluate(ID3D11DeviceContext* InDeviceContext, NVSDK_
     } while (false);
 
     _frameCount++;
-    Dx12CommandQueue->Signal(Dx12Fence, _frameCount);
+    SubmitDx12Frame();
 
     return evalResult;
 }
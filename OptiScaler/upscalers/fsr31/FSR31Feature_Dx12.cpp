@@ -36,12 +36,17 @@ bool FSR31FeatureDx12::Init(ID3D12Device* InDevice, ID3D12GraphicsCommandList* I
 
     if (InitFSR3(InParameters))
     {
-        if (!Config::Instance()->OverlayMenu.value_or_default() && (Imgui == nullptr || Imgui.get() == nullptr))
-            Imgui = std::make_unique<Menu_Dx12>(Util::GetProcessWindow(), InDevice);
+        RunShared(
+            [this, InDevice]()
+            {
+                if (!Config::Instance()->OverlayMenu.value_or_default() && (Imgui == nullptr || Imgui.get() == nullptr))
+                    Imgui = std::make_unique<Menu_Dx12>(Util::GetProcessWindow(), InDevice);
 
-        OutputScaler = std::make_unique<OS_Dx12>("Output Scaling", InDevice, (TargetWidth() < DisplayWidth()));
-        RCAS = std::make_unique<RCAS_Dx12>("RCAS", InDevice);
-        Bias = std::make_unique<Bias_Dx12>("Bias", InDevice);
+                OutputScaler =
+                    std::make_unique<OS_Dx12>("Output Scaling", InDevice, (TargetWidth() < DisplayWidth()));
+                RCAS = std::make_unique<RCAS_Dx12>("RCAS", InDevice);
+                Bias = std::make_unique<Bias_Dx12>("Bias", InDevice);
+            });
 
         return true;
     }
@@ -104,6 +109,7 @@ bool FSR31FeatureDx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_
     GetRenderResolution(InParameters, &params.renderSize.width, &params.renderSize.height);
 
     bool useSS = Config::Instance()->OutputScalingEnabled.value_or_default() && LowResMV();
+    bool fusedScaling = false;
 
     LOG_DEBUG("Input Resolution: {0}x{1}", params.renderSize.width, params.renderSize.height);
 
@@ -540,8 +546,12 @@ bool FSR31FeatureDx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_
 
         if (useSS)
         {
-            if (!RCAS->Dispatch(Device, InCommandList, (ID3D12Resource*) params.output.resource,
-                                (ID3D12Resource*) params.motionVectors.resource, rcasConstants, OutputScaler->Buffer()))
+            fusedScaling = FusedPostPass(InCommandList, (ID3D12Resource*) params.output.resource,
+                                         (ID3D12Resource*) params.motionVectors.resource, rcasConstants, paramOutput);
+
+            if (!fusedScaling && !RCAS->Dispatch(Device, InCommandList, (ID3D12Resource*) params.output.resource,
+                                                 (ID3D12Resource*) params.motionVectors.resource, rcasConstants,
+                                                 OutputScaler->Buffer()))
             {
                 Config::Instance()->RcasEnabled.set_volatile_value(false);
                 return true;
@@ -558,7 +568,7 @@ bool FSR31FeatureDx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_
         }
     }
 
-    if (useSS)
+    if (useSS && !fusedScaling)
     {
         LOG_DEBUG("scaling output...");
         OutputScaler->SetBufferState(InCommandList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
@@ -647,13 +657,21 @@ bool FSR31FeatureDx12::InitFSR3(const NVSDK_NGX_Parameter* InParameters)
     // get number of versions for allocation
     FfxApiProxy::D3D12_Query()(nullptr, &versionQuery.header);
 
-    State::Instance().fsr3xVersionIds.resize(versionCount);
-    State::Instance().fsr3xVersionNames.resize(versionCount);
-    versionQuery.versionIds = State::Instance().fsr3xVersionIds.data();
-    versionQuery.versionNames = State::Instance().fsr3xVersionNames.data();
+    // Menu reads the lists in State, they are filled locally and published with the other shared writes
+    std::vector<uint64_t> versionIds(versionCount);
+    std::vector<const char*> versionNames(versionCount);
+    versionQuery.versionIds = versionIds.data();
+    versionQuery.versionNames = versionNames.data();
     // fill version ids and names arrays.
     FfxApiProxy::D3D12_Query()(nullptr, &versionQuery.header);
 
+    RunShared(
+        [versionIds, versionNames]()
+        {
+            State::Instance().fsr3xVersionIds = versionIds;
+            State::Instance().fsr3xVersionNames = versionNames;
+        });
+
     _contextDesc.header.type = FFX_API_CREATE_CONTEXT_DESC_TYPE_UPSCALE;
 
     _contextDesc.fpMessage = FfxLogCallback;
@@ -693,12 +711,12 @@ bool FSR31FeatureDx12::InitFSR3(const NVSDK_NGX_Parameter* InParameters)
         if (ssMulti < 0.5f)
         {
             ssMulti = 0.5f;
-            Config::Instance()->OutputScalingMultiplier.set_volatile_value(ssMulti);
+            RunShared([ssMulti]() { Config::Instance()->OutputScalingMultiplier.set_volatile_value(ssMulti); });
         }
         else if (ssMulti > 3.0f)
         {
             ssMulti = 3.0f;
-            Config::Instance()->OutputScalingMultiplier.set_volatile_value(ssMulti);
+            RunShared([ssMulti]() { Config::Instance()->OutputScalingMultiplier.set_volatile_value(ssMulti); });
         }
 
         _targetWidth = DisplayWidth() * ssMulti;
@@ -716,7 +734,7 @@ bool FSR31FeatureDx12::InitFSR3(const NVSDK_NGX_Parameter* InParameters)
         _contextDesc.maxRenderSize.width = RenderWidth();
         _contextDesc.maxRenderSize.height = RenderHeight();
 
-        Config::Instance()->OutputScalingMultiplier.set_volatile_value(1.0f);
+        RunShared([]() { Config::Instance()->OutputScalingMultiplier.set_volatile_value(1.0f); });
 
         // if output scaling active let it to handle downsampling
         if (Config::Instance()->OutputScalingEnabled.value_or_default() && LowResMV())
@@ -748,13 +766,17 @@ bool FSR31FeatureDx12::InitFSR3(const NVSDK_NGX_Parameter* InParameters)
 
     _contextDesc.header.pNext = &backendDesc.header;
 
-    if (Config::Instance()->Fsr3xIndex.value_or_default() < 0 ||
-        Config::Instance()->Fsr3xIndex.value_or_default() >= State::Instance().fsr3xVersionIds.size())
-        Config::Instance()->Fsr3xIndex.set_volatile_value(0);
+    auto versionIndex = Config::Instance()->Fsr3xIndex.value_or_default();
+
+    if (versionIndex < 0 || versionIndex >= versionIds.size())
+    {
+        versionIndex = 0;
+        RunShared([]() { Config::Instance()->Fsr3xIndex.set_volatile_value(0); });
+    }
 
     ffxOverrideVersion ov = { 0 };
     ov.header.type = FFX_API_DESC_TYPE_OVERRIDE_VERSION;
-    ov.versionId = State::Instance().fsr3xVersionIds[Config::Instance()->Fsr3xIndex.value_or_default()];
+    ov.versionId = versionIds[versionIndex];
     backendDesc.header.pNext = &ov.header;
 
     LOG_DEBUG("_createContext!");
@@ -769,7 +791,7 @@ bool FSR31FeatureDx12::InitFSR3(const NVSDK_NGX_Parameter* InParameters)
         return false;
     }
 
-    auto version = State::Instance().fsr3xVersionNames[Config::Instance()->Fsr3xIndex.value_or_default()];
+    auto version = versionNames[versionIndex];
     _name = "FSR";
     parse_version(version);
 
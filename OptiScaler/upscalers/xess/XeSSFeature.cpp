@@ -153,12 +153,12 @@ bool XeSSFeature::InitXeSS(ID3D12Device* device, const NVSDK_NGX_Parameter* InPa
         if (ssMulti < 0.5f)
         {
             ssMulti = 0.5f;
-            Config::Instance()->OutputScalingMultiplier = ssMulti;
+            RunShared([ssMulti]() { Config::Instance()->OutputScalingMultiplier = ssMulti; });
         }
         else if (ssMulti > 3.0f)
         {
             ssMulti = 3.0f;
-            Config::Instance()->OutputScalingMultiplier = ssMulti;
+            RunShared([ssMulti]() { Config::Instance()->OutputScalingMultiplier = ssMulti; });
         }
 
         _targetWidth = DisplayWidth() * ssMulti;
@@ -178,8 +178,12 @@ bool XeSSFeature::InitXeSS(ID3D12Device* device, const NVSDK_NGX_Parameter* InPa
         // enable output scaling to restore image
         if (LowResMV())
         {
-            Config::Instance()->OutputScalingMultiplier = 1.0f;
-            Config::Instance()->OutputScalingEnabled = true;
+            RunShared(
+                []()
+                {
+                    Config::Instance()->OutputScalingMultiplier = 1.0f;
+                    Config::Instance()->OutputScalingEnabled = true;
+                });
         }
     }
 
@@ -214,7 +218,7 @@ bool XeSSFeature::InitXeSS(ID3D12Device* device, const NVSDK_NGX_Parameter* InPa
 
                 if (SUCCEEDED(hr))
                 {
-                    Config::Instance()->CreateHeaps = true;
+                    RunShared([]() { Config::Instance()->CreateHeaps = true; });
 
                     LOG_DEBUG("using _localBufferHeap & _localTextureHeap!");
 
@@ -164,7 +164,8 @@ bool XeSSFeatureDx11on12::Evaluate(ID3D11DeviceContext* InDeviceContext, NVSDK_N
     }
 
     // creatimg params for XeSS
-    xess_result_t xessResult;
+    xess_result_t xessResult = XESS_RESULT_ERROR_UNKNOWN;
+    bool disableReactiveMask = false;
     xess_d3d12_execute_params_t params {};
 
     InParameters->Get(NVSDK_NGX_Parameter_Jitter_Offset_X, &params.jitterOffsetX);
@@ -183,8 +184,7 @@ bool XeSSFeatureDx11on12::Evaluate(ID3D11DeviceContext* InDeviceContext, NVSDK_N
 
     LOG_DEBUG("Input Resolution: {0}x{1}", params.inputWidth, params.inputHeight);
 
-    auto frame = _frameCount % 2;
-    auto cmdList = Dx12CommandList[frame];
+    auto cmdList = CurrentDx12CommandList();
 
     do
     {
@@ -273,7 +273,8 @@ bool XeSSFeatureDx11on12::Evaluate(ID3D11DeviceContext* InDeviceContext, NVSDK_N
             Config::Instance()->DisableReactiveMask = true;
             LOG_WARN("Reactive mask not exist not enabled, disabling it!");
             State::Instance().changeBackend[_handle->Id] = true;
-            return true;
+            disableReactiveMask = true;
+            break;
         }
 
         float MVScaleX;
@@ -382,7 +383,7 @@ bool XeSSFeatureDx11on12::Evaluate(ID3D11DeviceContext* InDeviceContext, NVSDK_N
     cmdList->Close();
     ID3D12CommandList* ppCommandLists[] = { cmdList };
     Dx12CommandQueue->ExecuteCommandLists(1, ppCommandLists);
-    Dx12CommandQueue->Signal(dx12FenceTextureCopy, _fenceValue);
+    SyncDx12ToDx11();
 
     auto evalResult = false;
 
@@ -425,9 +426,10 @@ bool XeSSFeatureDx11on12::Evaluate(ID3D11DeviceContext* InDeviceContext, NVSDK_N
     } while (false);
 
     _frameCount++;
-    Dx12CommandQueue->Signal(Dx12Fence, _frameCount);
+    SubmitDx12Frame();
 
-    return evalResult;
+    // Backend is recreated without the mask, not an error
+    return evalResult || disableReactiveMask;
 }
 
 XeSSFeatureDx11on12::~XeSSFeatureDx11on12() {}
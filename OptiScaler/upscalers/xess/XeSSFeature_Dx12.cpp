@@ -16,12 +16,17 @@ bool XeSSFeatureDx12::Init(ID3D12Device* InDevice, ID3D12GraphicsCommandList* In
 
     if (InitXeSS(InDevice, InParameters))
     {
-        if (!Config::Instance()->OverlayMenu.value_or(true) && (Imgui == nullptr || Imgui.get() == nullptr))
-            Imgui = std::make_unique<Menu_Dx12>(Util::GetProcessWindow(), InDevice);
+        RunShared(
+            [this, InDevice]()
+            {
+                if (!Config::Instance()->OverlayMenu.value_or(true) && (Imgui == nullptr || Imgui.get() == nullptr))
+                    Imgui = std::make_unique<Menu_Dx12>(Util::GetProcessWindow(), InDevice);
 
-        OutputScaler = std::make_unique<OS_Dx12>("Output Scaling", InDevice, (TargetWidth() < DisplayWidth()));
-        RCAS = std::make_unique<RCAS_Dx12>("RCAS", InDevice);
-        Bias = std::make_unique<Bias_Dx12>("Bias", InDevice);
+                OutputScaler =
+                    std::make_unique<OS_Dx12>("Output Scaling", InDevice, (TargetWidth() < DisplayWidth()));
+                RCAS = std::make_unique<RCAS_Dx12>("RCAS", InDevice);
+                Bias = std::make_unique<Bias_Dx12>("Bias", InDevice);
+            });
 
         return true;
     }
@@ -84,6 +89,7 @@ bool XeSSFeatureDx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_N
     float ssMulti = Config::Instance()->OutputScalingMultiplier.value_or(1.5f);
 
     bool useSS = Config::Instance()->OutputScalingEnabled.value_or(false) && LowResMV();
+    bool fusedScaling = false;
 
     LOG_DEBUG("Input Resolution: {0}x{1}", params.inputWidth, params.inputHeight);
 
@@ -379,8 +385,11 @@ bool XeSSFeatureDx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_N
 
         if (useSS)
         {
-            if (!RCAS->Dispatch(Device, InCommandList, params.pOutputTexture, params.pVelocityTexture, rcasConstants,
-                                OutputScaler->Buffer()))
+            fusedScaling = FusedPostPass(InCommandList, params.pOutputTexture, params.pVelocityTexture, rcasConstants,
+                                         paramOutput);
+
+            if (!fusedScaling && !RCAS->Dispatch(Device, InCommandList, params.pOutputTexture, params.pVelocityTexture,
+                                                 rcasConstants, OutputScaler->Buffer()))
             {
                 Config::Instance()->RcasEnabled = false;
                 return true;
@@ -397,7 +406,7 @@ bool XeSSFeatureDx12::Evaluate(ID3D12GraphicsCommandList* InCommandList, NVSDK_N
         }
     }
 
-    if (useSS)
+    if (useSS && !fusedScaling)
     {
         LOG_DEBUG("scaling output...");
         OutputScaler->SetBufferState(InCommandList, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
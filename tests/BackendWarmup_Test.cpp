@@ -0,0 +1,201 @@
+#include "TestCheck.h"
+
+#include <misc/ThreadFlag.h>
+#include <upscalers/BackendWarmup.h>
+
+#include <future>
+#include <memory>
+#include <thread>
+
+struct SpoofTag;
+
+static ThreadFlag<SpoofTag> skipSpoofing;
+
+// What a hooked api sees, like the adapter description hook
+static bool HookSpoofs() { return !skipSpoofing; }
+
+struct FakeFeature
+{
+    int id;
+    std::thread::id initThread;
+    std::thread::id* destroyedOn = nullptr;
+    bool spoofedDuringInit = true;
+
+    explicit FakeFeature(int id) : id(id) {}
+
+    ~FakeFeature()
+    {
+        if (destroyedOn != nullptr)
+            *destroyedOn = std::this_thread::get_id();
+    }
+};
+
+using Warmup = BackendWarmup<FakeFeature>;
+
+static void WaitWhileBuilding(const Warmup& warmup)
+{
+    while (warmup.GetStatus() == Warmup::Status::Building)
+        std::this_thread::yield();
+}
+
+static bool Retire(std::unique_ptr<FakeFeature>& current, std::unique_ptr<FakeFeature>& retired)
+{
+    retired = std::move(current);
+    return true;
+}
+
+TEST_CASE(InitRunsOnWorkerAndSwaps)
+{
+    Warmup warmup;
+    std::promise<void> proceed;
+    auto proceedFuture = proceed.get_future();
+
+    CHECK(warmup.Start("fsr31", std::make_unique<FakeFeature>(2),
+                       [&](FakeFeature& feature)
+                       {
+                           proceedFuture.wait();
+                           feature.initThread = std::this_thread::get_id();
+                           return true;
+                       }));
+
+    CHECK_EQ(warmup.Backend(), std::string("fsr31"));
+    CHECK(warmup.GetStatus() == Warmup::Status::Building);
+
+    // Not ready yet, current keeps rendering
+    auto current = std::make_unique<FakeFeature>(1);
+    std::unique_ptr<FakeFeature> retired;
+    CHECK(!warmup.TrySwap(current, [&](auto& previous) { return Retire(previous, retired); }));
+    CHECK_EQ(current->id, 1);
+
+    proceed.set_value();
+    WaitWhileBuilding(warmup);
+    CHECK(warmup.GetStatus() == Warmup::Status::Ready);
+
+    CHECK(warmup.TrySwap(current, [&](auto& previous) { return Retire(previous, retired); }));
+    CHECK_EQ(current->id, 2);
+    CHECK(current->initThread != std::this_thread::get_id());
+    CHECK(retired != nullptr && retired->id == 1);
+    CHECK(!warmup.IsActive());
+}
+
+TEST_CASE(SwapWaitsUntilPreviousCanBeRetired)
+{
+    Warmup warmup;
+    warmup.Start("xess", std::make_unique<FakeFeature>(2), [](FakeFeature&) { return true; });
+    WaitWhileBuilding(warmup);
+
+    auto current = std::make_unique<FakeFeature>(1);
+
+    // Release of the previous one can't be deferred yet, nothing changes
+    CHECK(!warmup.TrySwap(current, [](auto&) { return false; }));
+    CHECK(current != nullptr && current->id == 1);
+    CHECK(warmup.GetStatus() == Warmup::Status::Ready);
+
+    // Retried next frame
+    std::unique_ptr<FakeFeature> retired;
+    CHECK(warmup.TrySwap(current, [&](auto& previous) { return Retire(previous, retired); }));
+    CHECK_EQ(current->id, 2);
+    CHECK_EQ(retired->id, 1);
+}
+
+TEST_CASE(FailedInitKeepsCurrent)
+{
+    std::thread::id destroyedOn;
+
+    Warmup warmup;
+    auto feature = std::make_unique<FakeFeature>(2);
+    feature->destroyedOn = &destroyedOn;
+    warmup.Start("fsr22", std::move(feature), [](FakeFeature&) { return false; });
+    WaitWhileBuilding(warmup);
+    CHECK(warmup.GetStatus() == Warmup::Status::Failed);
+
+    auto current = std::make_unique<FakeFeature>(1);
+    bool retireCalled = false;
+    CHECK(!warmup.TrySwap(current,
+                          [&](auto&)
+                          {
+                              retireCalled = true;
+                              return true;
+                          }));
+    CHECK(!retireCalled);
+    CHECK_EQ(current->id, 1);
+
+    // Failed feature is destroyed by the owner, not by the worker
+    CHECK(warmup.TakeFailed());
+    CHECK(destroyedOn == std::this_thread::get_id());
+    CHECK(!warmup.IsActive());
+    CHECK(!warmup.TakeFailed());
+}
+
+TEST_CASE(OnlyOneWarmupAtATime)
+{
+    Warmup warmup;
+    std::promise<void> proceed;
+    auto proceedFuture = proceed.get_future();
+
+    CHECK(warmup.Start("fsr21", std::make_unique<FakeFeature>(2),
+                       [&](FakeFeature&)
+                       {
+                           proceedFuture.wait();
+                           return true;
+                       }));
+    CHECK(!warmup.Start("xess", std::make_unique<FakeFeature>(3), [](FakeFeature&) { return true; }));
+    CHECK(!warmup.Start("xess", nullptr, [](FakeFeature&) { return true; }));
+
+    proceed.set_value();
+    warmup.Cancel();
+    CHECK(!warmup.IsActive());
+
+    // Cancelled one is dropped, a new one can start
+    CHECK(warmup.Start("xess", std::make_unique<FakeFeature>(3), [](FakeFeature&) { return true; }));
+    WaitWhileBuilding(warmup);
+
+    std::unique_ptr<FakeFeature> current;
+    std::unique_ptr<FakeFeature> retired;
+    CHECK(warmup.TrySwap(current, [&](auto& previous) { return Retire(previous, retired); }));
+    CHECK_EQ(current->id, 3);
+}
+
+TEST_CASE(SkipSpoofingOfInitDoesNotLeakIntoRenderThread)
+{
+    std::promise<void> inside;
+    std::promise<void> proceed;
+    auto proceedFuture = proceed.get_future();
+
+    Warmup warmup;
+
+    // Init raises the flag around its own api calls like FSR2Feature_Dx12::Init does
+    warmup.Start("fake", std::make_unique<FakeFeature>(1),
+                 [&](FakeFeature& feature)
+                 {
+                     skipSpoofing = true;
+                     inside.set_value();
+
+                     proceedFuture.wait();
+                     feature.spoofedDuringInit = HookSpoofs();
+
+                     skipSpoofing = false;
+                     return true;
+                 });
+
+    // Worker is between its own api calls, game keeps rendering
+    inside.get_future().wait();
+    CHECK(HookSpoofs());
+
+    // Render thread finishing its own skip section must not clear the worker's
+    skipSpoofing = true;
+    skipSpoofing = false;
+    proceed.set_value();
+
+    WaitWhileBuilding(warmup);
+
+    std::unique_ptr<FakeFeature> current;
+    std::unique_ptr<FakeFeature> retired;
+    warmup.TrySwap(current, [&](auto& previous) { return Retire(previous, retired); });
+
+    CHECK(current != nullptr);
+    CHECK(!current->spoofedDuringInit);
+    CHECK(HookSpoofs());
+}
+
+TEST_MAIN()
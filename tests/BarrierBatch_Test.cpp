@@ -0,0 +1,204 @@
+#include "TestCheck.h"
+
+#include <misc/BarrierBatch.h>
+
+#include <vector>
+
+// Command list which records the ResourceBarrier calls it gets, closed lists must not get any
+
+enum FakeState : int
+{
+    Common = 0,
+    CopySource = 1,
+    CopyDest = 2,
+    UnorderedAccess = 3,
+    ShaderResource = 4,
+};
+
+using Batch = CommandListBarrierBatch<struct FakeCommandList, int, FakeState>;
+
+struct FakeCommandList
+{
+    std::vector<std::vector<Batch::Transition>> calls;
+    bool closed = false;
+    int recordedWhileClosed = 0;
+
+    void ResourceBarrier(const Batch::Transition* transitions, size_t count)
+    {
+        if (closed)
+            recordedWhileClosed++;
+
+        calls.emplace_back(transitions, transitions + count);
+    }
+};
+
+static auto Recorder()
+{
+    return [](FakeCommandList* cmdList, const Batch::Transition* transitions, size_t count)
+    { cmdList->ResourceBarrier(transitions, count); };
+}
+
+static bool Has(const std::vector<Batch::Transition>& call, int resource, FakeState before, FakeState after)
+{
+    for (const auto& transition : call)
+    {
+        if (transition.resource == resource && transition.before == before && transition.after == after)
+            return true;
+    }
+
+    return false;
+}
+
+TEST_CASE(FlushEmitsOneCallWithAllTransitions)
+{
+    FakeCommandList list;
+    Batch batch(&list);
+
+    batch.Require(1, ShaderResource, CopySource);
+    batch.Require(2, UnorderedAccess, CopySource);
+    batch.Require(3, CopyDest, CopyDest);
+
+    CHECK_EQ(batch.Flush(Recorder()), 2u);
+    CHECK_EQ(list.calls.size(), 1u);
+    CHECK_EQ(list.calls[0].size(), 2u);
+    CHECK(Has(list.calls[0], 1, ShaderResource, CopySource));
+    CHECK(Has(list.calls[0], 2, UnorderedAccess, CopySource));
+
+    // Nothing changed, no empty ResourceBarrier call
+    CHECK_EQ(batch.Flush(Recorder()), 0u);
+    CHECK_EQ(list.calls.size(), 1u);
+}
+
+TEST_CASE(RestoreMergesWithNextTransition)
+{
+    FakeCommandList list;
+    Batch batch(&list);
+
+    // Copy of the velocity, source goes back and depth comes in with the same call
+    batch.Require(1, ShaderResource, CopySource);
+    batch.Flush(Recorder());
+    batch.Require(1, CopySource, ShaderResource);
+    batch.Require(2, Common, CopySource);
+    batch.Flush(Recorder());
+
+    CHECK_EQ(list.calls.size(), 2u);
+    CHECK_EQ(list.calls[1].size(), 2u);
+    CHECK(Has(list.calls[1], 1, CopySource, ShaderResource));
+    CHECK(Has(list.calls[1], 2, Common, CopySource));
+}
+
+TEST_CASE(UndoneTransitionIsElided)
+{
+    FakeCommandList list;
+    Batch batch(&list);
+
+    batch.Require(1, ShaderResource, CopySource);
+    batch.Require(1, ShaderResource, UnorderedAccess);
+    batch.Require(1, ShaderResource, ShaderResource);
+
+    CHECK(!batch.IsPending());
+    CHECK_EQ(batch.Finish(Recorder()), 0u);
+    CHECK(list.calls.empty());
+}
+
+TEST_CASE(RepeatedRequirementKeepsFirstKnownState)
+{
+    FakeCommandList list;
+    Batch batch(&list);
+
+    batch.Require(1, ShaderResource, CopySource);
+    batch.Require(1, Common, UnorderedAccess); // current is ignored, the batch already knows the state
+    CHECK_EQ(batch.StateOf(1, Common), UnorderedAccess);
+    CHECK_EQ(batch.StateOf(2, Common), Common);
+
+    batch.Flush(Recorder());
+
+    CHECK_EQ(list.calls.size(), 1u);
+    CHECK(Has(list.calls[0], 1, ShaderResource, UnorderedAccess));
+}
+
+TEST_CASE(FinishForgetsResources)
+{
+    FakeCommandList list;
+    Batch batch(&list);
+
+    batch.Require(1, ShaderResource, CopySource);
+    CHECK_EQ(batch.Finish(Recorder()), 1u);
+
+    // Game may have changed the state since, the given current state is used again
+    batch.Require(1, Common, CopySource);
+    batch.Flush(Recorder());
+
+    CHECK_EQ(list.calls.size(), 2u);
+    CHECK(Has(list.calls[1], 1, Common, CopySource));
+}
+
+TEST_CASE(BeginOnSameListKeepsPending)
+{
+    FakeCommandList list;
+    Batch batch;
+
+    CHECK_EQ(batch.Begin(&list), 0u);
+    batch.Require(1, ShaderResource, CopySource);
+    CHECK_EQ(batch.Begin(&list), 0u);
+    CHECK(batch.IsPending());
+
+    batch.Finish(Recorder());
+    CHECK_EQ(list.calls.size(), 1u);
+}
+
+TEST_CASE(BeginOnNewListDropsPendingOfPreviousList)
+{
+    FakeCommandList first;
+    FakeCommandList second;
+    Batch batch;
+
+    batch.Begin(&first);
+    batch.Require(1, ShaderResource, CopySource);
+    batch.Flush(Recorder());
+    batch.Require(1, CopySource, ShaderResource);
+
+    // Game closed and submitted the first list without us finishing on it
+    first.closed = true;
+
+    CHECK_EQ(batch.Begin(&second), 1u);
+    CHECK_EQ(batch.List(), &second);
+    CHECK(!batch.IsPending());
+
+    batch.Require(2, Common, CopySource);
+    batch.Finish(Recorder());
+
+    CHECK_EQ(first.recordedWhileClosed, 0);
+    CHECK_EQ(first.calls.size(), 1u);
+    CHECK_EQ(second.calls.size(), 1u);
+    CHECK_EQ(second.calls[0].size(), 1u);
+    CHECK(Has(second.calls[0], 2, Common, CopySource));
+}
+
+TEST_CASE(FinishedBatchSwitchesListsCleanly)
+{
+    FakeCommandList first;
+    FakeCommandList second;
+    Batch batch;
+
+    batch.Begin(&first);
+    batch.Require(1, ShaderResource, CopySource);
+    batch.Finish(Recorder());
+
+    CHECK_EQ(batch.Begin(&second), 0u);
+    CHECK_EQ(first.calls.size(), 1u);
+    CHECK(second.calls.empty());
+}
+
+TEST_CASE(NothingIsRecordedWithoutList)
+{
+    Batch batch;
+
+    batch.Require(1, ShaderResource, CopySource);
+    CHECK_EQ(batch.Flush(Recorder()), 0u);
+    CHECK(batch.IsPending());
+    CHECK_EQ(batch.Finish(Recorder()), 0u);
+    CHECK(!batch.IsPending());
+}
+
+TEST_MAIN()
@@ -0,0 +1,103 @@
+#include "TestCheck.h"
+
+#include <misc/ContextRegistry.h>
+
+#include <cstdint>
+
+struct Context;
+
+struct Record
+{
+    int id = 0;
+};
+
+using Registry = ContextRegistry<Context*, Record>;
+
+static Context* Key(uint64_t value) { return reinterpret_cast<Context*>(value); }
+static uint64_t Value(Context* key) { return reinterpret_cast<uint64_t>(key); }
+
+TEST_CASE(StaleHandleDoesNotFindNextOwner)
+{
+    Registry registry;
+
+    Context* first = nullptr;
+    registry.Create(first).id = 1;
+    CHECK(registry.Remove(first));
+
+    // Same slot, next generation
+    Context* second = nullptr;
+    registry.Create(second).id = 2;
+    CHECK((uint32_t) Value(second) == (uint32_t) Value(first));
+    CHECK(second != first);
+
+    CHECK(registry.Find(first) == nullptr);
+    CHECK(!registry.Remove(first));
+    CHECK(registry.Find(second) != nullptr && registry.Find(second)->id == 2);
+
+    // Slot goes to a context of the game next
+    CHECK(registry.Remove(second));
+    auto gameKey = Key(0x7FF612340000);
+    registry.Add(gameKey).id = 3;
+
+    CHECK(registry.Find(first) == nullptr);
+    CHECK(registry.Find(second) == nullptr);
+    CHECK(registry.Find(gameKey) != nullptr && registry.Find(gameKey)->id == 3);
+    CHECK_EQ(registry.Size(), (size_t) 1);
+}
+
+TEST_CASE(GenerationWrapsAroundZero)
+{
+    CHECK_EQ(Registry::NextGeneration(1), (uint32_t) 2);
+    CHECK_EQ(Registry::NextGeneration(UINT32_MAX - 1), UINT32_MAX);
+    CHECK_EQ(Registry::NextGeneration(UINT32_MAX), (uint32_t) 1);
+
+    Registry registry;
+    Context* handle = nullptr;
+    registry.Create(handle).id = 1;
+
+    // Handle with a zeroed generation never matches
+    CHECK(Value(handle) >> 32 != 0);
+    CHECK(registry.Find(Key((uint32_t) Value(handle))) == nullptr);
+
+    for (int i = 0; i < 1000; i++)
+    {
+        CHECK(registry.Remove(handle));
+        registry.Create(handle);
+        CHECK(Value(handle) >> 32 != 0);
+    }
+}
+
+TEST_CASE(GameKeysWhichLookLikeHandles)
+{
+    Registry registry;
+
+    // Low 32 bits decode to slot 1 and 2, high bits to generations which don't exist
+    auto gameKey1 = Key(0x00007FF600000001);
+    auto gameKey2 = Key(0x00007FF600000002);
+    registry.Add(gameKey1).id = 1;
+    registry.Add(gameKey2).id = 2;
+
+    Context* handle = nullptr;
+    registry.Create(handle).id = 3;
+
+    CHECK_EQ(registry.Find(gameKey1)->id, 1);
+    CHECK_EQ(registry.Find(gameKey2)->id, 2);
+    CHECK_EQ(registry.Find(handle)->id, 3);
+
+    // Exactly the handle of slot 1 at generation 1, while a game key owns that slot
+    auto lookalike = Key(0x0000000100000001);
+    CHECK(registry.Find(lookalike) == nullptr);
+    registry.Add(lookalike).id = 4;
+
+    CHECK_EQ(registry.Find(lookalike)->id, 4);
+    CHECK_EQ(registry.Find(gameKey1)->id, 1);
+    CHECK_EQ(registry.Find(handle)->id, 3);
+
+    // Removing the lookalike leaves the slot of the other game key alone
+    CHECK(registry.Remove(lookalike));
+    CHECK(registry.Find(lookalike) == nullptr);
+    CHECK_EQ(registry.Find(gameKey1)->id, 1);
+    CHECK_EQ(registry.Size(), (size_t) 3);
+}
+
+TEST_MAIN()
@@ -0,0 +1,117 @@
+#include "TestCheck.h"
+
+#include <misc/DeferredRelease.h>
+
+#include <string>
+#include <vector>
+
+TEST_CASE(ReleasedWhenFenceCompletes)
+{
+    CpuFence fence;
+    DeferredReleaseQueue queue;
+    std::vector<int> released;
+
+    queue.Push(1, [&] { released.push_back(1); }, "first");
+    queue.Push(3, [&] { released.push_back(3); }, "second");
+
+    CHECK_EQ(queue.Retire(&fence), 0u);
+    CHECK_EQ(queue.Pending(), 2u);
+
+    fence.Signal(2);
+    CHECK_EQ(queue.Retire(&fence), 1u);
+    CHECK_EQ(released.size(), 1u);
+
+    fence.Signal(3);
+    CHECK_EQ(queue.Retire(&fence), 1u);
+    CHECK_EQ(released.back(), 3);
+    CHECK_EQ(queue.Pending(), 0u);
+}
+
+TEST_CASE(LowerValueWaitsForEarlierEntries)
+{
+    CpuFence fence;
+    DeferredReleaseQueue queue;
+    std::vector<std::string> released;
+
+    queue.Push(5, [&] { released.push_back("feature"); });
+    queue.Push(2, [&] { released.push_back("resource"); });
+
+    fence.Signal(4);
+    CHECK_EQ(queue.Retire(&fence), 0u);
+
+    fence.Signal(5);
+    CHECK_EQ(queue.Retire(&fence), 2u);
+    CHECK_EQ(released.size(), 2u);
+    CHECK(released[0] == "feature");
+    CHECK(released[1] == "resource");
+}
+
+TEST_CASE(ReleaseCanQueueMore)
+{
+    CpuFence fence;
+    DeferredReleaseQueue queue;
+    int released = 0;
+
+    // Feature destructor releasing its own resources through the same queue
+    queue.Push(1,
+               [&]
+               {
+                   released++;
+                   queue.Push(2, [&] { released++; });
+               });
+
+    fence.Signal(1);
+    CHECK_EQ(queue.Retire(&fence), 1u);
+    CHECK_EQ(queue.Pending(), 1u);
+    CHECK_EQ(queue.LastValue(), 2u);
+
+    fence.Signal(2);
+    CHECK_EQ(queue.Retire(&fence), 1u);
+    CHECK_EQ(released, 2);
+}
+
+TEST_CASE(FlushReleasesEverything)
+{
+    DeferredReleaseQueue queue;
+    int released = 0;
+
+    queue.Push(10, [&] { released++; });
+    queue.Push(20, [&] { released++; });
+    queue.Push(30, {});
+
+    CHECK_EQ(queue.LastValue(), 30u);
+    CHECK_EQ(queue.Flush(), 3u);
+    CHECK_EQ(released, 2);
+    CHECK_EQ(queue.LastValue(), 0u);
+}
+
+// Same policy as DeferredRelease_Dx12: present signals one value per frame, objects deferred
+// during a frame wait for the second signal after the last one, see RetireValue
+TEST_CASE(FrameSignalPolicy)
+{
+    CpuFence gpu;
+    DeferredReleaseQueue queue;
+    uint64_t signalled = 0;
+    uint64_t releasedAtFrame = 0;
+
+    auto retireValue = [&] { return signalled + 2; };
+
+    for (uint64_t frame = 1; frame <= 10; frame++)
+    {
+        // Object replaced in frame 3 while frames 2 and 3 might still use it
+        if (frame == 3)
+            queue.Push(retireValue(), [] {});
+
+        // End of frame, GPU is one frame behind
+        signalled++;
+        gpu.Signal(signalled - 1);
+
+        if (queue.Retire(&gpu) > 0)
+            releasedAtFrame = frame;
+    }
+
+    // Signal of frame 4 has to complete, which is seen at the end of frame 5
+    CHECK_EQ(releasedAtFrame, 5u);
+}
+
+TEST_MAIN()
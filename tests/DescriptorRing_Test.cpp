@@ -0,0 +1,116 @@
+#include "TestCheck.h"
+
+#include <misc/DescriptorRing.h>
+
+TEST_CASE(TransientRangesStartAfterPersistentRegion)
+{
+    DescriptorRing ring(16, 64);
+
+    CHECK_EQ(ring.Capacity(), 80u);
+    CHECK_EQ(*ring.AllocateTransient(3), 16u);
+    CHECK_EQ(*ring.AllocateTransient(2), 19u);
+    CHECK_EQ(ring.TransientUsed(), 5u);
+
+    CHECK(!ring.AllocateTransient(0).has_value());
+    CHECK(!ring.AllocateTransient(65).has_value());
+}
+
+TEST_CASE(RangeWhichDoesntFitWrapsToStart)
+{
+    DescriptorRing ring(0, 10);
+
+    CHECK_EQ(*ring.AllocateTransient(6), 0u);
+    ring.EndFrame(1);
+    ring.Reclaim(1);
+
+    // 4 left at the end, range is contiguous so it starts again at 0
+    CHECK_EQ(*ring.AllocateTransient(5), 0u);
+    CHECK_EQ(ring.TransientUsed(), 9u);
+}
+
+TEST_CASE(RingWaitsForRetiredFrames)
+{
+    DescriptorRing ring(0, 8);
+
+    CHECK(ring.AllocateTransient(4).has_value());
+    ring.EndFrame(1);
+    CHECK(ring.AllocateTransient(4).has_value());
+    ring.EndFrame(2);
+
+    CHECK(!ring.AllocateTransient(1).has_value());
+
+    ring.Reclaim(1);
+    CHECK_EQ(ring.TransientUsed(), 4u);
+    CHECK_EQ(*ring.AllocateTransient(4), 0u);
+
+    ring.Reclaim(2);
+    CHECK_EQ(ring.TransientUsed(), 4u);
+    CHECK_EQ(ring.TransientPeak(), 8u);
+}
+
+TEST_CASE(RangesBeforeFirstFrameWaitForItsFence)
+{
+    DescriptorRing ring(0, 8);
+
+    // No fence yet, the GPU may still read everything handed out so far
+    CHECK(ring.AllocateTransient(8).has_value());
+    ring.Reclaim(100);
+    CHECK(!ring.AllocateTransient(1).has_value());
+
+    // First signalled frame covers all of them
+    ring.EndFrame(3);
+    ring.Reclaim(2);
+    CHECK(!ring.AllocateTransient(1).has_value());
+    ring.Reclaim(3);
+    CHECK_EQ(*ring.AllocateTransient(1), 0u);
+}
+
+TEST_CASE(PersistentRangeIsReusedAfterRetire)
+{
+    DescriptorRing ring(4, 8);
+    auto generation = ring.Generation();
+
+    auto a = ring.AllocatePersistent(4);
+    CHECK_EQ(*a, 0u);
+    CHECK(!ring.AllocatePersistent(1).has_value());
+
+    CHECK(ring.FreePersistent(*a, 4, 3, generation));
+    CHECK_EQ(ring.PersistentUsed(), 0u);
+    CHECK(!ring.AllocatePersistent(1).has_value());
+
+    ring.Reclaim(3);
+    CHECK_EQ(*ring.AllocatePersistent(2), 0u);
+}
+
+TEST_CASE(ResetDropsRangesOfOldHeap)
+{
+    DescriptorRing ring(4, 8);
+    auto oldGeneration = ring.Generation();
+
+    auto persistent = ring.AllocatePersistent(3);
+    CHECK(ring.AllocateTransient(8).has_value());
+    ring.EndFrame(1);
+
+    // Device changed, nothing of the old heap is waited for
+    ring.Reset();
+
+    CHECK(ring.Generation() != oldGeneration);
+    CHECK_EQ(ring.TransientUsed(), 0u);
+    CHECK_EQ(ring.PersistentUsed(), 0u);
+    CHECK_EQ(*ring.AllocateTransient(8), 4u);
+
+    auto fresh = ring.AllocatePersistent(3);
+    CHECK_EQ(*fresh, 0u);
+
+    // Pass of the old device frees its range late, must not free the new one
+    CHECK(!ring.FreePersistent(*persistent, 3, 0, oldGeneration));
+    ring.Reclaim(0);
+    CHECK_EQ(ring.PersistentUsed(), 3u);
+    CHECK(!ring.AllocatePersistent(2).has_value());
+
+    CHECK(ring.FreePersistent(*fresh, 3, 0, ring.Generation()));
+    ring.Reclaim(0);
+    CHECK_EQ(ring.PersistentUsed(), 0u);
+}
+
+TEST_MAIN()
@@ -0,0 +1,159 @@
+#include "TestCheck.h"
+
+#include <CustomOptional.h>
+#include <misc/VersionedSnapshot.h>
+
+#include <atomic>
+#include <thread>
+
+// Same shape as Config -> FrameConfig, without the Windows parts
+
+struct TestConfig
+{
+    CustomOptional<bool> Enabled { false };
+    CustomOptional<float> Sharpness { 0.3f };
+    CustomOptional<int, NoDefault> Frames;
+    CustomOptional<std::string> Name { "auto" };
+};
+
+static TestConfig config;
+
+struct TestFrameConfig
+{
+    using Snapshot = VersionedSnapshot<TestFrameConfig>::Snapshot;
+
+    bool Enabled;
+    float Sharpness;
+    std::optional<int> Frames;
+
+    static Snapshot Get() { return _snapshots.Get(ConfigVersion::Get(), Fill); }
+    static uint32_t Builds() { return _snapshots.Builds(); }
+
+  private:
+    inline static VersionedSnapshot<TestFrameConfig> _snapshots;
+
+    static void Fill(TestFrameConfig& frameConfig)
+    {
+        frameConfig.Enabled = config.Enabled.value_or_default();
+        frameConfig.Sharpness = config.Sharpness.value_or_default();
+        frameConfig.Frames = config.Frames;
+    }
+};
+
+TEST_CASE(ChangePropagatesToNextGet)
+{
+    auto before = TestFrameConfig::Get();
+    CHECK(!before->Enabled);
+
+    config.Enabled = true;
+    config.Sharpness = 0.8f;
+
+    auto after = TestFrameConfig::Get();
+    CHECK(after->Enabled);
+    CHECK_EQ(after->Sharpness, 0.8f);
+    CHECK(after != before);
+
+    // Snapshot which was taken before the change is untouched
+    CHECK(!before->Enabled);
+}
+
+TEST_CASE(UnchangedConfigReusesSnapshot)
+{
+    auto first = TestFrameConfig::Get();
+    auto builds = TestFrameConfig::Builds();
+
+    CHECK(TestFrameConfig::Get() == first);
+    CHECK_EQ(TestFrameConfig::Builds(), builds);
+}
+
+TEST_CASE(WritingSameValueDoesNotBump)
+{
+    config.Enabled = true;
+    config.Name = "auto";
+    auto version = ConfigVersion::Get();
+
+    // Menu widgets write their value back every frame
+    config.Enabled = true;
+    config.Enabled.set_volatile_value(true);
+    config.Name = "auto";
+    config.Name = std::string("auto");
+    CHECK_EQ(ConfigVersion::Get(), version);
+
+    config.Enabled = false;
+    CHECK(ConfigVersion::Get() != version);
+}
+
+TEST_CASE(OptionalTransitionsBumpOnce)
+{
+    config.Frames.reset();
+    auto version = ConfigVersion::Get();
+
+    config.Frames.reset();
+    CHECK_EQ(ConfigVersion::Get(), version);
+
+    config.Frames = 5;
+    CHECK_EQ(ConfigVersion::Get(), version + 1);
+
+    config.Frames = std::optional<int>(5);
+    CHECK_EQ(ConfigVersion::Get(), version + 1);
+
+    config.Frames = std::optional<int>();
+    CHECK_EQ(ConfigVersion::Get(), version + 2);
+    CHECK(!TestFrameConfig::Get()->Frames.has_value());
+
+    // set_from_config only applies to unset options
+    config.Frames.set_from_config(7);
+    CHECK_EQ(TestFrameConfig::Get()->Frames.value_or(0), 7);
+    config.Frames.set_from_config(9);
+    CHECK_EQ(TestFrameConfig::Get()->Frames.value_or(0), 7);
+}
+
+TEST_CASE(HeldSnapshotSurvivesManyRebuilds)
+{
+    config.Sharpness = 0.1f;
+    auto held = TestFrameConfig::Get();
+    std::atomic<bool> done = false;
+
+    // Other thread changes config and rebuilds far more often than the old 8 slot ring could take
+    std::thread writer(
+        [&]
+        {
+            for (int i = 0; i < 1000; i++)
+            {
+                config.Sharpness = (float) i + 2.0f;
+                TestFrameConfig::Get();
+            }
+
+            done = true;
+        });
+
+    bool stable = true;
+
+    while (!done)
+    {
+        if (held->Sharpness != 0.1f)
+            stable = false;
+    }
+
+    writer.join();
+
+    CHECK(stable);
+    CHECK_EQ(held->Sharpness, 0.1f);
+    CHECK_EQ(TestFrameConfig::Get()->Sharpness, 1001.0f);
+}
+
+TEST_CASE(EveryThreadSeesLatestValue)
+{
+    config.Sharpness = 0.25f;
+    TestFrameConfig::Get();
+
+    config.Sharpness = 0.5f;
+
+    float seen = 0.0f;
+    std::thread([&] { seen = TestFrameConfig::Get()->Sharpness; }).join();
+
+    CHECK_EQ(seen, 0.5f);
+    CHECK_EQ(TestFrameConfig::Get()->Sharpness, 0.5f);
+}
+
+TEST_MAIN()
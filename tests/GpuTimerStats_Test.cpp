@@ -0,0 +1,215 @@
+#include "TestCheck.h"
+
+#include <misc/GpuTimerStats.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using Ring = GpuTimerStats::TimestampRing<4, 4>;
+
+static constexpr uint32_t Upscaler = (uint32_t) GpuPass::Upscaler;
+static constexpr uint32_t Rcas = (uint32_t) GpuPass::Rcas;
+
+// What GpuTimer_Dx12::EndFrame does with a queue whose fence completes gpuCompleted
+static uint32_t EndFrame(Ring& ring, uint64_t& fenceValue, uint64_t gpuCompleted, std::vector<uint32_t>& collected)
+{
+    if (ring.Close())
+        ring.Submitted(++fenceValue);
+
+    auto count = ring.Collect(gpuCompleted, [&](uint32_t slot, const uint32_t*) { collected.push_back(slot); });
+    ring.Advance();
+
+    return count;
+}
+
+TEST_CASE(PairsAreUniquePerSlotPassAndSample)
+{
+    Ring ring;
+
+    auto a = ring.Begin(Upscaler);
+    auto b = ring.Begin(Upscaler);
+    auto c = ring.Begin(Rcas);
+
+    CHECK(a.valid && b.valid && c.valid);
+    CHECK_EQ(a.sample, 0u);
+    CHECK_EQ(b.sample, 1u);
+    CHECK(a.query != b.query);
+    CHECK(a.query != c.query);
+    CHECK(a.query % 2 == 0);
+    CHECK(a.query + 1 < Ring::QueriesPerSlot);
+}
+
+TEST_CASE(SamplesAboveMaxAreDropped)
+{
+    Ring ring;
+
+    for (int i = 0; i < 4; i++)
+        CHECK(ring.Begin(Upscaler).valid);
+
+    CHECK(!ring.Begin(Upscaler).valid);
+    CHECK(ring.Begin(Rcas).valid);
+    CHECK(!ring.Begin((uint32_t) GpuPass::Count).valid);
+}
+
+TEST_CASE(EndedMaskReachesCollect)
+{
+    Ring ring;
+    uint64_t fence = 0;
+
+    auto first = ring.Begin(Upscaler);
+    auto second = ring.Begin(Upscaler);
+    ring.Begin(Rcas); // never ended
+    ring.End(second);
+
+    CHECK(ring.Close());
+    ring.Submitted(++fence);
+
+    uint32_t upscalerMask = 0xFFFF;
+    uint32_t rcasMask = 0xFFFF;
+
+    auto count = ring.Collect(fence,
+                              [&](uint32_t, const uint32_t* ended)
+                              {
+                                  upscalerMask = ended[Upscaler];
+                                  rcasMask = ended[Rcas];
+                              });
+
+    CHECK_EQ(count, 1u);
+    CHECK_EQ(upscalerMask, 1u << second.sample);
+    CHECK_EQ(rcasMask, 0u);
+    (void) first;
+}
+
+TEST_CASE(SlotIsOnlyReadAfterItsFence)
+{
+    Ring ring;
+    uint64_t fence = 0;
+    std::vector<uint32_t> collected;
+
+    // GPU is one frame behind
+    for (uint64_t frame = 0; frame < 10; frame++)
+    {
+        ring.Begin(Upscaler);
+        EndFrame(ring, fence, frame, collected);
+    }
+
+    // Frame 9 is still in flight, every other frame was read once and in order
+    CHECK_EQ(collected.size(), 9u);
+
+    for (size_t i = 0; i < collected.size(); i++)
+        CHECK_EQ(collected[i], (uint32_t) (i % 4));
+}
+
+TEST_CASE(StalledGpuSkipsFramesInsteadOfWaiting)
+{
+    Ring ring;
+    uint64_t fence = 0;
+    std::vector<uint32_t> collected;
+
+    // Nothing completes, ring fills up after 4 frames
+    for (int frame = 0; frame < 4; frame++)
+    {
+        CHECK(ring.Begin(Upscaler).valid);
+        EndFrame(ring, fence, 0, collected);
+    }
+
+    CHECK(!ring.Recording());
+    CHECK(!ring.Begin(Upscaler).valid);
+
+    // Skipped frame doesn't signal another fence
+    EndFrame(ring, fence, 0, collected);
+    CHECK_EQ(fence, 4u);
+    CHECK(collected.empty());
+
+    // GPU catches up, recording continues in the oldest slot
+    EndFrame(ring, fence, 4, collected);
+    CHECK_EQ(collected.size(), 4u);
+    CHECK(ring.Recording());
+    CHECK(ring.Begin(Upscaler).valid);
+}
+
+TEST_CASE(RecordingFromManyThreads)
+{
+    using BigRing = GpuTimerStats::TimestampRing<4, 32>;
+    BigRing ring;
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 8; t++)
+    {
+        threads.emplace_back(
+            [&]
+            {
+                for (int i = 0; i < 8; i++)
+                {
+                    auto pair = ring.Begin(Upscaler);
+                    ring.End(pair);
+                }
+            });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    ring.Close();
+    ring.Submitted(1);
+
+    uint32_t mask = 0;
+    ring.Collect(1, [&](uint32_t, const uint32_t* ended) { mask = ended[Upscaler]; });
+
+    // 64 attempts for 32 samples, every sample handed out exactly once
+    CHECK_EQ(mask, 0xFFFFFFFFu);
+}
+
+TEST_CASE(SumPassSkipsInvalidPairs)
+{
+    // begin/end pairs at 1 MHz
+    uint64_t data[] = { 1000, 3000, 0, 5000, 7000, 6000, 10000, 10500 };
+    double ms = 0.0;
+
+    CHECK(GpuTimerStats::SumPass(data, 0b1111, 1000000, ms));
+    CHECK_EQ(ms, 2.5);
+
+    CHECK(!GpuTimerStats::SumPass(data, 0b0110, 1000000, ms));
+    CHECK(!GpuTimerStats::SumPass(data, 0b1111, 0, ms));
+}
+
+TEST_CASE(RollingWindowKeepsNewestSamples)
+{
+    GpuTimerStats::RollingWindow<4> window;
+
+    for (int i = 1; i <= 6; i++)
+        window.Add((double) i);
+
+    auto samples = window.Samples();
+    CHECK_EQ(samples.size(), 4u);
+    CHECK_EQ(samples.front(), 3.0);
+    CHECK_EQ(samples.back(), 6.0);
+
+    auto summary = window.Compute();
+    CHECK_EQ(summary.count, 4u);
+    CHECK_EQ(summary.last, 6.0);
+    CHECK_EQ(summary.mean, 4.5);
+    CHECK_EQ(summary.p50, 4.0);
+}
+
+TEST_CASE(JsonExport)
+{
+    GpuTimerStats::RollingWindow<8> window;
+    window.Add(1.0);
+    window.Add(0.5);
+
+    std::vector<GpuTimerStats::PassReport> passes;
+    passes.push_back({ GpuPassName(GpuPass::Upscaler), window.Compute(), window.Samples() });
+
+    auto json = GpuTimerStats::ToJson(passes);
+
+    CHECK(json.find("\"name\": \"Upscaler\"") != std::string::npos);
+    CHECK(json.find("\"count\": 2") != std::string::npos);
+    CHECK(json.find("\"mean_ms\": 0.7500") != std::string::npos);
+    CHECK(json.find("\"samples_ms\": [1.0000, 0.5000]") != std::string::npos);
+
+    CHECK_EQ(GpuTimerStats::ToJson({}), std::string("{\n  \"passes\": []\n}\n"));
+}
+
+TEST_MAIN()
@@ -0,0 +1,112 @@
+#include "TestCheck.h"
+
+#include <resource_tracking/HeapIndex.h>
+
+#include <thread>
+
+static int liveHeaps = 0;
+
+struct FakeHeap
+{
+    size_t cpuStart = 0;
+    size_t cpuEnd = 0;
+    size_t gpuStart = 0;
+    size_t gpuEnd = 0;
+
+    FakeHeap(size_t cpu, size_t gpu, size_t size)
+        : cpuStart(cpu), cpuEnd(cpu + size), gpuStart(gpu), gpuEnd(gpu == 0 ? 0 : gpu + size)
+    {
+        liveHeaps++;
+    }
+
+    ~FakeHeap() { liveHeaps--; }
+};
+
+static std::unique_ptr<FakeHeap> Heap(size_t cpu, size_t gpu, size_t size)
+{
+    return std::make_unique<FakeHeap>(cpu, gpu, size);
+}
+
+TEST_CASE(FindsHandlesInsideRanges)
+{
+    HeapIndex<FakeHeap> index;
+
+    auto a = index.Add(Heap(0x1000, 0x9000, 0x100), 0);
+    auto b = index.Add(Heap(0x2000, 0, 0x100), 0);
+
+    CHECK(index.FindByCpuHandle(0x1000) == a);
+    CHECK(index.FindByCpuHandle(0x10FF) == a);
+    CHECK(index.FindByCpuHandle(0x1100) == nullptr);
+    CHECK(index.FindByCpuHandle(0x2080) == b);
+    CHECK(index.FindByGpuHandle(0x9010) == a);
+    CHECK(index.FindByGpuHandle(0x2080) == nullptr);
+    CHECK(index.FindByCpuHandle(0) == nullptr);
+    CHECK_EQ(index.Count(), 2u);
+}
+
+TEST_CASE(ReplacedHeapIsRetiredAndFreedAfterEpochs)
+{
+    {
+        HeapIndex<FakeHeap> index;
+
+        auto old = index.Add(Heap(0x1000, 0x9000, 0x100), 0);
+        CHECK(index.FindByCpuHandle(0x1010) == old);
+
+        // Driver handed out the same cpu range again, old gpu range must not stay behind
+        auto fresh = index.Add(Heap(0x1000, 0xA000, 0x100), 3);
+
+        CHECK(index.FindByCpuHandle(0x1010) == fresh);
+        CHECK(index.FindByGpuHandle(0x9010) == nullptr);
+        CHECK(index.FindByGpuHandle(0xA010) == fresh);
+        CHECK_EQ(index.RetiredCount(), 1u);
+        CHECK_EQ(liveHeaps, 2);
+
+        CHECK_EQ(index.Collect(3 + HeapIndex<FakeHeap>::RetireEpochs - 1), 0u);
+        CHECK_EQ(liveHeaps, 2);
+
+        CHECK_EQ(index.Collect(3 + HeapIndex<FakeHeap>::RetireEpochs), 1u);
+        CHECK_EQ(index.RetiredCount(), 0u);
+        CHECK_EQ(liveHeaps, 1);
+    }
+
+    CHECK_EQ(liveHeaps, 0);
+}
+
+TEST_CASE(PartialOverlapRetiresEveryTouchedHeap)
+{
+    HeapIndex<FakeHeap> index;
+
+    index.Add(Heap(0x1000, 0, 0x100), 0);
+    index.Add(Heap(0x1100, 0, 0x100), 0);
+    index.Add(Heap(0x1200, 0, 0x100), 0);
+
+    auto wide = index.Add(Heap(0x1080, 0, 0x100), 1);
+
+    CHECK(index.FindByCpuHandle(0x1000) == nullptr);
+    CHECK(index.FindByCpuHandle(0x1090) == wide);
+    CHECK(index.FindByCpuHandle(0x1200) != nullptr);
+    CHECK_EQ(index.RetiredCount(), 2u);
+    CHECK_EQ(index.Count(), 2u);
+}
+
+TEST_CASE(ReaderOnOtherThreadSeesNewSnapshot)
+{
+    HeapIndex<FakeHeap> index;
+
+    auto old = index.Add(Heap(0x1000, 0, 0x100), 0);
+    FakeHeap* seen = nullptr;
+
+    std::thread([&] { seen = index.FindByCpuHandle(0x1010); }).join();
+    CHECK(seen == old);
+
+    auto fresh = index.Add(Heap(0x1000, 0, 0x100), 1);
+    index.Collect(1 + HeapIndex<FakeHeap>::RetireEpochs);
+
+    std::thread([&] { seen = index.FindByCpuHandle(0x1010); }).join();
+    CHECK(seen == fresh);
+
+    // Same thread cached the old range in its last hit slot
+    CHECK(index.FindByCpuHandle(0x1010) == fresh);
+}
+
+TEST_MAIN()
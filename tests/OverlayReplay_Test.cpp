@@ -0,0 +1,105 @@
+#include "TestCheck.h"
+
+#include <menu/OverlayReplay.h>
+
+static OverlayLayout Layout()
+{
+    OverlayLayout layout;
+    layout.type = 2;
+    layout.alpha = 0.4f;
+    layout.scale = 1.0f;
+    layout.width = 2560.0f;
+    layout.height = 1440.0f;
+    return layout;
+}
+
+static OverlayReplay BuiltAt(double now)
+{
+    OverlayReplay replay;
+    replay.Built(Layout(), now, true);
+    return replay;
+}
+
+TEST_CASE(NothingBuiltYet)
+{
+    OverlayReplay replay;
+    CHECK(!replay.CanReplay(Layout(), 0.0, 10));
+    CHECK(!replay.CanReplay(OverlayLayout {}, 0.0, 10));
+}
+
+TEST_CASE(ReplaysWithinRefreshInterval)
+{
+    auto replay = BuiltAt(1000.0);
+
+    // 10 Hz, kept for 100 ms
+    CHECK(replay.CanReplay(Layout(), 1000.0, 10));
+    CHECK(replay.CanReplay(Layout(), 1099.9, 10));
+    CHECK(!replay.CanReplay(Layout(), 1100.0, 10));
+    CHECK(!replay.CanReplay(Layout(), 1250.0, 10));
+
+    // 60 Hz
+    CHECK(replay.CanReplay(Layout(), 1016.0, 60));
+    CHECK(!replay.CanReplay(Layout(), 1017.0, 60));
+}
+
+TEST_CASE(ZeroRefreshRateRebuildsEveryPresent)
+{
+    auto replay = BuiltAt(1000.0);
+    CHECK(!replay.CanReplay(Layout(), 1000.0, 0));
+    CHECK(!replay.CanReplay(Layout(), 1001.0, -1));
+}
+
+TEST_CASE(LayoutChangeRebuilds)
+{
+    auto replay = BuiltAt(1000.0);
+    int feature = 0;
+
+    auto changed = Layout();
+    changed.position = 1;
+    CHECK(!replay.CanReplay(changed, 1010.0, 10));
+
+    changed = Layout();
+    changed.width = 1920.0f;
+    CHECK(!replay.CanReplay(changed, 1010.0, 10));
+
+    changed = Layout();
+    changed.hdr = true;
+    CHECK(!replay.CanReplay(changed, 1010.0, 10));
+
+    changed = Layout();
+    changed.feature = &feature;
+    CHECK(!replay.CanReplay(changed, 1010.0, 10));
+
+    changed = Layout();
+    changed.frozen = true;
+    CHECK(!replay.CanReplay(changed, 1010.0, 10));
+
+    // Rebuilt with the new layout, replays it
+    changed = Layout();
+    changed.scale = 1.5f;
+    replay.Built(changed, 1020.0, true);
+    CHECK(replay.CanReplay(changed, 1030.0, 10));
+    CHECK(!replay.CanReplay(Layout(), 1030.0, 10));
+}
+
+TEST_CASE(SplashFrameIsNotKept)
+{
+    OverlayReplay replay;
+    replay.Built(Layout(), 1000.0, false);
+    CHECK(!replay.CanReplay(Layout(), 1010.0, 10));
+}
+
+TEST_CASE(InvalidateRebuilds)
+{
+    auto replay = BuiltAt(1000.0);
+    replay.Invalidate();
+    CHECK(!replay.CanReplay(Layout(), 1010.0, 10));
+}
+
+TEST_CASE(ClockGoingBackRebuilds)
+{
+    auto replay = BuiltAt(1000.0);
+    CHECK(!replay.CanReplay(Layout(), 900.0, 10));
+}
+
+TEST_MAIN()
@@ -0,0 +1,164 @@
+#include "TestCheck.h"
+
+#include <shaders/reference/PF_Reference.h>
+
+#include <cstring>
+
+using namespace Reference;
+
+namespace
+{
+Image TestImage(int width, int height)
+{
+    Image image(width, height);
+
+    // Gradients with hard edges, something for RCAS to sharpen and for the kernels to ring on
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            float edge = ((x / 5 + y / 3) % 2) ? 0.9f : 0.1f;
+            image.Store(x, y, { edge, (float) x / width, (float) y / height, (float) ((x + y) % 4) / 3.0f });
+        }
+    }
+
+    return image;
+}
+
+Image TestMotion(int width, int height)
+{
+    Image motion(width, height);
+
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+            motion.Store(x, y, { (float) (x % 7) - 3.0f, (float) (y % 5) - 2.0f, 0.0f, 0.0f });
+    }
+
+    return motion;
+}
+
+FusedParams Params(ScaleKernel kernel, int srcWidth, int srcHeight, int destWidth, int destHeight, bool sharpen)
+{
+    FusedParams params;
+    params.Kernel = kernel;
+    params.Scale = { srcWidth, srcHeight, destWidth, destHeight };
+    params.Sharpen = sharpen;
+    params.Rcas.Sharpness = 0.6f;
+    params.Rcas.DynamicSharpenEnabled = 1;
+    params.Rcas.MotionSharpness = 0.4f;
+    params.Rcas.Threshold = 2.0f;
+    return params;
+}
+
+bool SameBits(const Image& a, const Image& b)
+{
+    return a.Width() == b.Width() && a.Height() == b.Height() &&
+           std::memcmp(a.Data(), b.Data(), sizeof(Color) * a.Width() * a.Height()) == 0;
+}
+
+Image UntiledImage(const Image& source, const Image& motion, const FusedParams& params)
+{
+    Image output(params.Scale.destWidth, params.Scale.destHeight);
+
+    for (int y = 0; y < output.Height(); y++)
+    {
+        for (int x = 0; x < output.Width(); x++)
+            output.Store(x, y, Fused(source, motion, params, x, y));
+    }
+
+    return output;
+}
+
+struct Case
+{
+    ScaleKernel kernel;
+    int srcWidth, srcHeight, destWidth, destHeight;
+};
+
+// Sizes which don't divide by the group size, so the last groups are partial
+const Case Cases[] = {
+    { ScaleKernel::None, 37, 29, 37, 29 },
+    { ScaleKernel::BicubicUpsample, 37, 29, 61, 47 },
+    { ScaleKernel::Bicubic, 61, 47, 37, 29 },
+    { ScaleKernel::Lanczos, 61, 47, 37, 29 },
+    { ScaleKernel::Catmull, 61, 47, 37, 29 },
+    { ScaleKernel::Magc, 61, 47, 37, 29 },
+};
+} // namespace
+
+TEST_CASE(TileGivesSameTexelsAsDirectFetch)
+{
+    for (const auto& c : Cases)
+    {
+        auto source = TestImage(c.srcWidth, c.srcHeight);
+        auto motion = TestMotion(c.srcWidth, c.srcHeight);
+
+        for (bool sharpen : { false, true })
+        {
+            auto params = Params(c.kernel, c.srcWidth, c.srcHeight, c.destWidth, c.destHeight, sharpen);
+            FusedTileStats stats;
+
+            CHECK(SameBits(FusedImage(source, motion, params, &stats), UntiledImage(source, motion, params)));
+
+            if (c.kernel != ScaleKernel::None)
+                CHECK(stats.tileTaps > 0);
+        }
+    }
+}
+
+TEST_CASE(FusedMatchesSeparatePasses)
+{
+    for (const auto& c : Cases)
+    {
+        auto source = TestImage(c.srcWidth, c.srcHeight);
+        auto motion = TestMotion(c.srcWidth, c.srcHeight);
+
+        for (bool sharpen : { false, true })
+        {
+            auto params = Params(c.kernel, c.srcWidth, c.srcHeight, c.destWidth, c.destHeight, sharpen);
+            auto fused = FusedImage(source, motion, params);
+            auto separate = SeparateImage(source, motion, params);
+
+            CHECK(MaxDifference(fused, separate) <= 1e-6f);
+        }
+    }
+}
+
+TEST_CASE(LargeDownscaleFallsBackOutsideTile)
+{
+    // 3x with Lanczos needs 16 * 3 + 6 texels per group, more than the tile holds
+    auto source = TestImage(150, 96);
+    auto motion = TestMotion(150, 96);
+    auto params = Params(ScaleKernel::Lanczos, 150, 96, 50, 32, true);
+
+    FusedTileStats stats;
+    auto fused = FusedImage(source, motion, params, &stats);
+
+    CHECK(stats.clampedGroups > 0);
+    CHECK(stats.fallbackTaps > 0);
+    CHECK(SameBits(fused, UntiledImage(source, motion, params)));
+    CHECK(MaxDifference(fused, SeparateImage(source, motion, params)) <= 1e-6f);
+
+    // 1.5x fits, nothing is computed twice
+    FusedTileStats fits;
+    FusedImage(source, motion, Params(ScaleKernel::Lanczos, 150, 96, 100, 64, true), &fits);
+    CHECK_EQ(fits.clampedGroups, 0u);
+    CHECK_EQ(fits.fallbackTaps, 0u);
+}
+
+TEST_CASE(AlphaComesFromNearestSourceTexel)
+{
+    auto source = TestImage(61, 47);
+    auto motion = TestMotion(61, 47);
+    auto params = Params(ScaleKernel::Catmull, 61, 47, 37, 29, true);
+    auto fused = FusedImage(source, motion, params);
+
+    for (int y = 0; y < fused.Height(); y++)
+    {
+        for (int x = 0; x < fused.Width(); x++)
+            CHECK_EQ(fused.Load(x, y).a, FusedAlpha(source, params.Scale, x, y));
+    }
+}
+
+TEST_MAIN()
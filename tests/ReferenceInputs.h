@@ -0,0 +1,99 @@
+#pragma once
+
+#include <shaders/reference/Bias_Reference.h>
+#include <shaders/reference/DS_Reference.h>
+#include <shaders/reference/DT_Reference.h>
+#include <shaders/reference/FT_Reference.h>
+#include <shaders/reference/HC_Reference.h>
+#include <shaders/reference/OS_Reference.h>
+#include <shaders/reference/PF_Reference.h>
+#include <shaders/reference/RCAS_Reference.h>
+#include <shaders/reference/RF_Reference.h>
+
+#include <cmath>
+#include <cstdint>
+
+// Inputs of the golden image tests and the throughput benchmark of shaders/reference. Only integer
+// math and exact float operations, so the images are the same on every platform.
+namespace ReferenceInputs
+{
+
+// Hash source, same sequence everywhere
+inline uint32_t Noise(uint32_t x, uint32_t y, uint32_t seed)
+{
+    uint32_t value = x * 0x8DA6B343u ^ y * 0xD8163841u ^ seed * 0xCB1AB31Fu;
+    value ^= value >> 15;
+    value *= 0x2C1B3C6Du;
+    value ^= value >> 12;
+    return value;
+}
+
+// Smooth gradients with hard edges and some noise, values slightly above 1 like HDR highlights
+inline Reference::Image Color(int width, int height, uint32_t seed = 1)
+{
+    Reference::Image image(width, height);
+
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            float edge = ((x / 7 + y / 5) % 2) ? 0.85f : 0.15f;
+            float noise = (float) (Noise(x, y, seed) & 0xFF) / 2048.0f;
+            float r = edge + noise;
+            float g = (float) x / (float) width;
+            float b = (float) y / (float) height * 1.25f;
+            float a = (float) ((x + y) % 4) / 3.0f;
+            image.Store(x, y, { r, g, b, a });
+        }
+    }
+
+    return image;
+}
+
+// Motion vectors in pixels, red and green
+inline Reference::Image Motion(int width, int height)
+{
+    Reference::Image image(width, height);
+
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            float mx = (float) ((int) (Noise(x / 8, y / 8, 7) % 33) - 16) * 0.5f;
+            float my = (float) ((int) (Noise(x / 8, y / 8, 9) % 17) - 8) * 0.5f;
+            image.Store(x, y, { mx, my, 0.0f, 0.0f });
+        }
+    }
+
+    return image;
+}
+
+// Reversed depth, near objects are blocks in front of a far plane
+inline Reference::Image Depth(int width, int height)
+{
+    Reference::Image image(width, height);
+
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            float depth = (Noise(x / 16, y / 16, 3) % 4 == 0) ? 0.75f : 0.0625f;
+            image.Store(x, y, { depth + (float) (x % 16) / 4096.0f, 0.0f, 0.0f, 0.0f });
+        }
+    }
+
+    return image;
+}
+
+inline Reference::RcasParams Rcas(bool dynamic)
+{
+    Reference::RcasParams params;
+    params.Sharpness = 0.6f;
+    params.DynamicSharpenEnabled = dynamic ? 1 : 0;
+    params.MotionSharpness = 0.4f;
+    params.Threshold = 2.0f;
+    params.ScaleLimit = 10.0f;
+    return params;
+}
+
+} // namespace ReferenceInputs
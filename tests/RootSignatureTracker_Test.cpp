@@ -0,0 +1,142 @@
+#include "TestCheck.h"
+
+#include <misc/RootSignatureTracker.h>
+
+#include <thread>
+
+// Table as big as the probe window, every command list can see every slot
+using Tracker = RootSignatureTracker<16>;
+using Kind = Tracker::Kind;
+
+static const void* List(size_t i) { return (const void*) (0x10000 + i * 64); }
+static void* Signature(size_t i) { return (void*) (0x900000 + i * 16); }
+
+static void NextFrames(Tracker& tracker, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+        tracker.NextFrame();
+}
+
+static void OnOtherThread(auto&& func) { std::thread(func).join(); }
+
+TEST_CASE(KindsAreSeparate)
+{
+    static Tracker tracker;
+
+    tracker.Set(List(0), Kind::Compute, Signature(1));
+    tracker.Set(List(0), Kind::Graphic, Signature(2));
+    tracker.Set(List(1), Kind::Compute, Signature(3));
+
+    CHECK_EQ(tracker.Get(List(0), Kind::Compute), Signature(1));
+    CHECK_EQ(tracker.Get(List(0), Kind::Graphic), Signature(2));
+    CHECK_EQ(tracker.Get(List(1), Kind::Compute), Signature(3));
+    CHECK(tracker.Get(List(1), Kind::Graphic) == nullptr);
+    CHECK(tracker.Get(List(2), Kind::Compute) == nullptr);
+}
+
+TEST_CASE(FullTableGoesToOverflow)
+{
+    static Tracker tracker;
+
+    for (size_t i = 0; i < 16; i++)
+        tracker.Set(List(i), Kind::Compute, Signature(i));
+
+    CHECK(!tracker.WasFull());
+
+    tracker.Set(List(16), Kind::Compute, Signature(16));
+    tracker.Set(List(16), Kind::Graphic, Signature(17));
+
+    CHECK(tracker.WasFull());
+    CHECK_EQ(tracker.OverflowCount(), (size_t) 1);
+    CHECK_EQ(tracker.Get(List(16), Kind::Compute), Signature(16));
+    CHECK_EQ(tracker.Get(List(16), Kind::Graphic), Signature(17));
+
+    for (size_t i = 0; i < 16; i++)
+        CHECK_EQ(tracker.Get(List(i), Kind::Compute), Signature(i));
+}
+
+TEST_CASE(StaleSlotIsReused)
+{
+    static Tracker tracker;
+
+    for (size_t i = 0; i < 16; i++)
+        tracker.Set(List(i), Kind::Compute, Signature(i));
+
+    // Not stale yet, new list can't take a slot
+    NextFrames(tracker, Tracker::StaleFrames);
+    tracker.Set(List(16), Kind::Compute, Signature(16));
+    CHECK_EQ(tracker.OverflowCount(), (size_t) 1);
+
+    // Everything except list 3 keeps recording
+    for (size_t i = 0; i < 16; i++)
+    {
+        if (i != 3)
+            OnOtherThread([&] { tracker.Set(List(i), Kind::Compute, Signature(i)); });
+    }
+
+    NextFrames(tracker, 1);
+
+    // List 16 moves from overflow into the slot of list 3
+    OnOtherThread([&] { tracker.Set(List(16), Kind::Graphic, Signature(17)); });
+
+    CHECK_EQ(tracker.OverflowCount(), (size_t) 0);
+    CHECK_EQ(tracker.Get(List(16), Kind::Compute), Signature(16));
+    CHECK_EQ(tracker.Get(List(16), Kind::Graphic), Signature(17));
+
+    // Old owner of the slot doesn't see the signatures of the new one
+    CHECK(tracker.Get(List(3), Kind::Compute) == nullptr);
+    CHECK(tracker.Get(List(3), Kind::Graphic) == nullptr);
+}
+
+TEST_CASE(ThreadCacheIsInvalidatedWhenSlotIsReused)
+{
+    static Tracker tracker;
+
+    // This thread caches the slot of list 0
+    tracker.Set(List(0), Kind::Compute, Signature(0));
+
+    OnOtherThread(
+        [&]
+        {
+            for (size_t i = 1; i < 16; i++)
+                tracker.Set(List(i), Kind::Compute, Signature(i));
+        });
+
+    NextFrames(tracker, Tracker::StaleFrames + 1);
+
+    // Only list 0 goes stale, list 16 takes its slot
+    OnOtherThread(
+        [&]
+        {
+            for (size_t i = 1; i < 16; i++)
+                tracker.Set(List(i), Kind::Compute, Signature(i));
+
+            tracker.Set(List(16), Kind::Compute, Signature(16));
+        });
+
+    CHECK_EQ(tracker.Get(List(16), Kind::Compute), Signature(16));
+    CHECK(tracker.Get(List(0), Kind::Compute) == nullptr);
+
+    // Cached slot belongs to list 16 now, list 0 must not write into it
+    tracker.Set(List(0), Kind::Compute, Signature(100));
+
+    CHECK_EQ(tracker.Get(List(16), Kind::Compute), Signature(16));
+    CHECK_EQ(tracker.Get(List(0), Kind::Compute), Signature(100));
+}
+
+TEST_CASE(StaleOverflowEntriesAreDropped)
+{
+    static Tracker tracker;
+
+    for (size_t i = 0; i < 17; i++)
+        tracker.Set(List(i), Kind::Compute, Signature(i));
+
+    CHECK_EQ(tracker.OverflowCount(), (size_t) 1);
+
+    NextFrames(tracker, Tracker::StaleFrames + 1);
+
+    CHECK_EQ(tracker.OverflowCount(), (size_t) 0);
+    CHECK(tracker.Get(List(16), Kind::Compute) == nullptr);
+}
+
+TEST_MAIN()
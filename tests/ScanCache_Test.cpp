@@ -0,0 +1,144 @@
+#include "TestCheck.h"
+
+#include <scanner/ScanCache.h>
+
+#include <sstream>
+
+using scanner::ScanCache;
+
+TEST_CASE(StoresAndFindsPerModuleBuild)
+{
+    ScanCache cache;
+    uint64_t rva = 1;
+
+    CHECK(!cache.Find("exe", "build1", 10, 0, &rva));
+
+    cache.Store("exe", "build1", 10, 0, 0x1234);
+    cache.Store("exe", "build1", 11, 0x100, 0);
+    CHECK(cache.Dirty());
+
+    CHECK(cache.Find("exe", "build1", 10, 0, &rva));
+    CHECK_EQ(rva, 0x1234u);
+
+    // Negative result is a hit too
+    CHECK(cache.Find("exe", "build1", 11, 0x100, &rva));
+    CHECK_EQ(rva, 0u);
+
+    // Same pattern with another start address is a different entry
+    CHECK(!cache.Find("exe", "build1", 11, 0, &rva));
+    CHECK(!cache.Find("other", "build1", 10, 0, &rva));
+}
+
+TEST_CASE(UpdatedModuleDropsItsEntries)
+{
+    ScanCache cache;
+    uint64_t rva = 1;
+
+    cache.Store("exe", "build1", 10, 0, 0x1234);
+    cache.Store("exe", "build1", 11, 0, 0);
+    cache.Store("dll", "build1", 12, 0, 0x500);
+
+    std::stringstream saved;
+    cache.Save(saved);
+    CHECK(!cache.Dirty());
+
+    // Pattern which was missing in the old build must be scanned again
+    CHECK(!cache.Find("exe", "build2", 11, 0, &rva));
+    CHECK_EQ(cache.Evicted(), 2u);
+    CHECK(cache.Dirty());
+    CHECK(!cache.Find("exe", "build1", 10, 0, &rva));
+
+    // Other modules are untouched
+    CHECK(cache.Find("dll", "build1", 12, 0, &rva));
+    CHECK_EQ(rva, 0x500u);
+    CHECK_EQ(cache.Size(), 1u);
+}
+
+TEST_CASE(StoreForNewBuildReplacesOldEntries)
+{
+    ScanCache cache;
+    uint64_t rva = 0;
+
+    cache.Store("exe", "build1", 10, 0, 0x1234);
+    cache.Store("exe", "build1", 11, 0, 0x2000);
+    cache.Store("exe", "build2", 10, 0, 0x1300);
+
+    CHECK_EQ(cache.Size(), 1u);
+    CHECK_EQ(cache.Evicted(), 2u);
+    CHECK(cache.Find("exe", "build2", 10, 0, &rva));
+    CHECK_EQ(rva, 0x1300u);
+}
+
+TEST_CASE(StoringSameResultIsNotDirty)
+{
+    ScanCache cache;
+    cache.Store("exe", "build1", 10, 0, 0x1234);
+
+    std::stringstream saved;
+    cache.Save(saved);
+
+    cache.Store("exe", "build1", 10, 0, 0x1234);
+    CHECK(!cache.Dirty());
+
+    cache.Store("exe", "build1", 10, 0, 0x1240);
+    CHECK(cache.Dirty());
+}
+
+TEST_CASE(SaveLoadRoundTrip)
+{
+    ScanCache cache;
+    cache.Store("00AB", "5F3A", 0xDEADBEEF, 0x10, 0x1234);
+    cache.Store("00AB", "5F3A", 0xFEED, 0, 0);
+    cache.Store("00CD", "77", 1, 2, 3);
+
+    std::stringstream saved;
+    cache.Save(saved);
+
+    ScanCache loaded;
+    loaded.Load(saved);
+
+    uint64_t rva = 1;
+    CHECK_EQ(loaded.Size(), 3u);
+    CHECK(!loaded.Dirty());
+    CHECK(loaded.Find("00AB", "5F3A", 0xDEADBEEF, 0x10, &rva));
+    CHECK_EQ(rva, 0x1234u);
+    CHECK(loaded.Find("00AB", "5F3A", 0xFEED, 0, &rva));
+    CHECK_EQ(rva, 0u);
+    CHECK(loaded.Find("00CD", "77", 1, 2, &rva));
+    CHECK_EQ(rva, 3u);
+}
+
+TEST_CASE(LoadSkipsOldFormatAndBrokenLines)
+{
+    std::stringstream file;
+    file << "5F3A0000 DEADBEEF 10 1234\n";   // old four field format
+    file << "00AB 5F3A DEADBEEF 10 1234\n";  // valid
+    file << "00AB 5F3A FEED\n";              // truncated by a crash
+    file << "00AB 5F3A 1 2 3 4\n";           // too many fields
+    file << "00AB 5F3A zz 2 3\n";            // not hex
+
+    ScanCache cache;
+    cache.Load(file);
+
+    uint64_t rva = 0;
+    CHECK_EQ(cache.Size(), 1u);
+    CHECK(cache.Find("00AB", "5F3A", 0xDEADBEEF, 0x10, &rva));
+    CHECK_EQ(rva, 0x1234u);
+}
+
+TEST_CASE(LoadKeepsLastBuildOfModule)
+{
+    std::stringstream file;
+    file << "00AB 1 A 0 10\n";
+    file << "00AB 2 B 0 20\n";
+
+    ScanCache cache;
+    cache.Load(file);
+
+    uint64_t rva = 0;
+    CHECK_EQ(cache.Size(), 1u);
+    CHECK(cache.Find("00AB", "2", 0xB, 0, &rva));
+    CHECK(!cache.Find("00AB", "1", 0xA, 0, &rva));
+}
+
+TEST_MAIN()
@@ -0,0 +1,113 @@
+#include "TestCheck.h"
+
+#include <misc/SeqLock.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Same shape as a swapchain description, a few words plus a flag and padding
+struct Desc
+{
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t format = 0;
+    uint32_t bufferCount = 0;
+    void* window = nullptr;
+    uint32_t flags[5] {};
+    bool valid = false;
+};
+
+static Desc Make(uint32_t n)
+{
+    Desc desc;
+    desc.width = n;
+    desc.height = n;
+    desc.format = n;
+    desc.bufferCount = n;
+    desc.window = (void*) (uintptr_t) n;
+
+    for (auto& flag : desc.flags)
+        flag = n;
+
+    desc.valid = true;
+    return desc;
+}
+
+static bool IsConsistent(const Desc& desc)
+{
+    auto n = desc.width;
+    bool same = desc.height == n && desc.format == n && desc.bufferCount == n && desc.window == (void*) (uintptr_t) n;
+
+    for (auto flag : desc.flags)
+        same = same && flag == n;
+
+    return same && desc.valid == (n != 0);
+}
+
+TEST_CASE(StartsWithDefaultValue)
+{
+    SeqLock<Desc> lock;
+    auto desc = lock.Load();
+
+    CHECK_EQ(desc.width, 0u);
+    CHECK(!desc.valid);
+    CHECK(IsConsistent(desc));
+}
+
+TEST_CASE(LoadReturnsLastStore)
+{
+    SeqLock<Desc> lock(Make(3));
+    CHECK_EQ(lock.Load().width, 3u);
+
+    lock.Store(Make(1920));
+    auto desc = lock.Load();
+    CHECK_EQ(desc.width, 1920u);
+    CHECK(IsConsistent(desc));
+
+    lock.Store({});
+    CHECK(!lock.Load().valid);
+}
+
+TEST_CASE(ReadersNeverSeeTornValues)
+{
+    SeqLock<Desc> lock(Make(1));
+    std::atomic<bool> stop = false;
+    std::atomic<int> torn = 0;
+    std::vector<std::thread> readers;
+
+    for (int t = 0; t < 4; t++)
+    {
+        readers.emplace_back(
+            [&]()
+            {
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    if (!IsConsistent(lock.Load()))
+                        torn++;
+                }
+            });
+    }
+
+    // Resizes from two threads like ResizeBuffers and SetFullscreenState
+    std::thread otherWriter(
+        [&]()
+        {
+            for (uint32_t n = 0; n < 20000; n++)
+                lock.Store(Make(1));
+        });
+
+    for (uint32_t n = 2; n < 200000; n++)
+        lock.Store(Make(n));
+
+    otherWriter.join();
+    stop = true;
+
+    for (auto& reader : readers)
+        reader.join();
+
+    CHECK_EQ(torn.load(), 0);
+    CHECK(IsConsistent(lock.Load()));
+}
+
+TEST_MAIN()
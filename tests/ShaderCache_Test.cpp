@@ -0,0 +1,149 @@
+#include "TestCheck.h"
+
+#include <misc/ShaderCache.h>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+const char ShaderCode[] = "[numthreads(8, 8, 1)] void CSMain(uint3 id : SV_DispatchThreadID) {}";
+
+const ShaderCache::Identity Adapter { 0x10DE, 0x2684, 0x0020001000150000ull };
+
+std::vector<uint8_t> FakeBlob(uint8_t seed, size_t size)
+{
+    std::vector<uint8_t> blob(size);
+
+    for (size_t i = 0; i < size; i++)
+        blob[i] = (uint8_t) (seed + i * 7);
+
+    return blob;
+}
+} // namespace
+
+TEST_CASE(BytecodeKeyDependsOnCompilerVersion)
+{
+    constexpr uint64_t systemDll = 0x000A000047000000ull;
+    constexpr uint64_t shippedDll = 0x000A000047010000ull;
+
+    auto system = ShaderCache::BytecodeKey(systemDll, ShaderCode, sizeof(ShaderCode), "CSMain", "cs_5_0");
+    auto shipped = ShaderCache::BytecodeKey(shippedDll, ShaderCode, sizeof(ShaderCode), "CSMain", "cs_5_0");
+
+    CHECK(system != shipped);
+    CHECK_EQ(system, ShaderCache::BytecodeKey(systemDll, ShaderCode, sizeof(ShaderCode), "CSMain", "cs_5_0"));
+    CHECK(system != ShaderCache::BytecodeKey(systemDll, ShaderCode, sizeof(ShaderCode), "CSMain", "cs_6_0"));
+}
+
+TEST_CASE(PipelineKeyDependsOnRootSignature)
+{
+    auto bytecode = FakeBlob(1, 512);
+    auto rootA = FakeBlob(2, 64);
+    auto rootB = FakeBlob(3, 64);
+
+    auto hashA = ShaderCache::Hash(rootA.data(), rootA.size());
+    auto hashB = ShaderCache::Hash(rootB.data(), rootB.size());
+
+    auto keyA = ShaderCache::PipelineKey(bytecode.data(), bytecode.size(), 0, hashA);
+    auto keyB = ShaderCache::PipelineKey(bytecode.data(), bytecode.size(), 0, hashB);
+
+    CHECK(keyA != keyB);
+    CHECK(keyA != ShaderCache::PipelineKey(bytecode.data(), bytecode.size(), 1, hashA));
+
+    ShaderCache cache;
+    auto pso = FakeBlob(4, 2048);
+    cache.Store(ShaderCache::Kind::Pipeline, keyA, Adapter, pso.data(), pso.size());
+
+    // Same shader with another root signature must not get the blob
+    CHECK(cache.Find(ShaderCache::Kind::Pipeline, keyB, Adapter) == nullptr);
+    CHECK(*cache.Find(ShaderCache::Kind::Pipeline, keyA, Adapter) == pso);
+}
+
+TEST_CASE(PipelinesBelongToAdapterAndDriver)
+{
+    ShaderCache cache;
+    auto pso = FakeBlob(5, 256);
+    auto newDriver = Adapter;
+    newDriver.driverVersion++;
+    auto otherGpu = Adapter;
+    otherGpu.deviceId++;
+
+    cache.Store(ShaderCache::Kind::Pipeline, 1, Adapter, pso.data(), pso.size());
+    cache.Store(ShaderCache::Kind::Pipeline, 1, otherGpu, pso.data(), pso.size());
+
+    CHECK(cache.Find(ShaderCache::Kind::Pipeline, 1, newDriver) == nullptr);
+    CHECK(cache.Find(ShaderCache::Kind::Pipeline, 1, otherGpu) != nullptr);
+
+    // Storing for the new driver drops the pipelines of the old one
+    cache.Store(ShaderCache::Kind::Pipeline, 2, newDriver, pso.data(), pso.size());
+    CHECK(cache.Find(ShaderCache::Kind::Pipeline, 1, Adapter) == nullptr);
+    CHECK(cache.Find(ShaderCache::Kind::Pipeline, 1, otherGpu) != nullptr);
+    CHECK_EQ(cache.Count(), 2u);
+
+    // Bytecode is shared
+    cache.Store(ShaderCache::Kind::Bytecode, 3, Adapter, pso.data(), pso.size());
+    CHECK(cache.Find(ShaderCache::Kind::Bytecode, 3, otherGpu) != nullptr);
+}
+
+TEST_CASE(FileRoundTrip)
+{
+    ShaderCache cache;
+    auto bytecode = FakeBlob(6, 700);
+    auto pso = FakeBlob(7, 3000);
+
+    cache.Store(ShaderCache::Kind::Bytecode, 10, {}, bytecode.data(), bytecode.size());
+    cache.Store(ShaderCache::Kind::Pipeline, 11, Adapter, pso.data(), pso.size());
+
+    ShaderCache loaded;
+    CHECK(loaded.Deserialize(cache.Serialize()));
+    CHECK(!loaded.IsDirty());
+    CHECK_EQ(loaded.Count(), 2u);
+    CHECK(*loaded.Find(ShaderCache::Kind::Bytecode, 10, {}) == bytecode);
+    CHECK(*loaded.Find(ShaderCache::Kind::Pipeline, 11, Adapter) == pso);
+}
+
+TEST_CASE(BrokenRecordDropsTheTail)
+{
+    ShaderCache cache;
+
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        auto blob = FakeBlob(i, 100);
+        cache.Store(ShaderCache::Kind::Bytecode, i, {}, blob.data(), blob.size());
+    }
+
+    auto file = cache.Serialize();
+
+    // Header 16 bytes, record header 40 bytes, flip a byte in the data of the third record
+    file[16 + 2 * (40 + 100) + 40 + 5] ^= 0xFF;
+
+    ShaderCache loaded;
+    CHECK(loaded.Deserialize(file));
+    CHECK_EQ(loaded.Count(), 2u);
+    CHECK(loaded.IsDirty());
+
+    // Truncated file keeps the complete records
+    file = cache.Serialize();
+    file.resize(file.size() - 10);
+    CHECK(loaded.Deserialize(file));
+    CHECK_EQ(loaded.Count(), 3u);
+}
+
+TEST_CASE(OtherFormatVersionIsRejected)
+{
+    ShaderCache cache;
+    auto blob = FakeBlob(8, 64);
+    cache.Store(ShaderCache::Kind::Bytecode, 1, {}, blob.data(), blob.size());
+
+    auto file = cache.Serialize();
+    file[4] = (uint8_t) (ShaderCache::Version - 1);
+
+    ShaderCache loaded;
+    CHECK(!loaded.Deserialize(file));
+    CHECK_EQ(loaded.Count(), 0u);
+
+    file[0] ^= 1;
+    CHECK(!loaded.Deserialize(file));
+}
+
+TEST_MAIN()
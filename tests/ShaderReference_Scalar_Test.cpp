@@ -0,0 +1,3 @@
+// Golden images of ShaderReference_Test with the plain float version of Float4
+#define REFERENCE_SCALAR
+#include "ShaderReference_Test.cpp"
@@ -0,0 +1,151 @@
+#include "TestCheck.h"
+#include "ReferenceInputs.h"
+
+#include <cinttypes>
+#include <vector>
+
+// Golden images of the CPU versions of the shaders, stored as hashes of the outputs.
+//
+// Colors are rounded to 1/65536 before hashing, a change of the math shows up while differences in
+// the last bit of a libm function don't. Built twice, with SIMD and with REFERENCE_SCALAR, both
+// must give the same images. When a shader change is intended, run the test and copy the printed
+// hashes here.
+
+using namespace Reference;
+
+namespace
+{
+constexpr int Width = 64;
+constexpr int Height = 48;
+
+uint64_t Hash(const void* data, size_t size, uint64_t hash = 0xCBF29CE484222325ull)
+{
+    auto bytes = (const uint8_t*) data;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ull;
+    }
+
+    return hash;
+}
+
+uint64_t HashImage(const Image& image)
+{
+    int64_t size[2] = { image.Width(), image.Height() };
+    auto hash = Hash(size, sizeof(size));
+
+    for (int y = 0; y < image.Height(); y++)
+    {
+        for (int x = 0; x < image.Width(); x++)
+        {
+            auto color = image.Load(x, y);
+            int64_t rounded[4] = { std::llround((double) color.r * 65536.0), std::llround((double) color.g * 65536.0),
+                                   std::llround((double) color.b * 65536.0), std::llround((double) color.a * 65536.0) };
+            hash = Hash(rounded, sizeof(rounded), hash);
+        }
+    }
+
+    return hash;
+}
+
+uint64_t HashPacked(const std::vector<uint32_t>& texels) { return Hash(texels.data(), texels.size() * 4); }
+
+void CheckGolden(const char* name, uint64_t actual, uint64_t expected)
+{
+    if (actual == expected)
+        return;
+
+    std::fprintf(stderr, "Golden image of %s changed: 0x%016" PRIX64 "ull\n", name, actual);
+    TestFailures()++;
+}
+
+const Image Source = ReferenceInputs::Color(Width, Height);
+const Image Motion = ReferenceInputs::Motion(Width, Height);
+const Image Depth = ReferenceInputs::Depth(Width, Height);
+} // namespace
+
+TEST_CASE(Bias)
+{
+    CheckGolden("Bias", HashImage(BiasImage(Source, 0.5f)), 0x7C29F6C26082F459ull);
+}
+
+TEST_CASE(DepthScale)
+{
+    DSConstants constants {};
+    constants.DepthScale = 0.8f;
+    CheckGolden("DepthScale", HashImage(DepthScaleImage(Depth, constants)), 0x979138CA5916F2D5ull);
+}
+
+TEST_CASE(DepthTransfer)
+{
+    CheckGolden("DepthTransfer", HashImage(DepthTransferImage(Depth)), 0xF84DD33096F65AD5ull);
+}
+
+TEST_CASE(FormatTransfer)
+{
+    CheckGolden("FT R10G10B10A2", HashPacked(FormatTransferImage(Source, PackR10G10B10A2)), 0x15B8BC17CEC371FCull);
+    CheckGolden("FT R8G8B8A8", HashPacked(FormatTransferImage(Source, PackR8G8B8A8)), 0x7FCDFEF7130818FEull);
+    CheckGolden("FT B8G8R8A8", HashPacked(FormatTransferImage(Source, PackB8G8R8A8)), 0x29C09959438FBD6Eull);
+    CheckGolden("FT B8G8R8A8 swizzle", HashPacked(FormatTransferImage(Source, PackFtB8G8R8A8)), 0xD21C2FD592D39A58ull);
+}
+
+TEST_CASE(HudlessCompare)
+{
+    auto backCopy = ReferenceInputs::Color(Width, Height, 2);
+    CompareParams params;
+    params.InvOutputSize[0] = 1.0f / Width;
+    params.InvOutputSize[1] = 1.0f / Height;
+
+    auto output = HudlessCompareImage(Source, backCopy, params, Width, Height);
+    CheckGolden("HudlessCompare", HashImage(output), 0x49601D11BB9569D0ull);
+}
+
+TEST_CASE(OutputScaling)
+{
+    auto small = ReferenceInputs::Color(48, 36);
+    Constants upscale { 48, 36, Width, Height };
+    Constants downscale { Width, Height, 40, 30 };
+
+    auto upscaled = ScaleImage(ScaleKernel::BicubicUpsample, upscale, small);
+    CheckGolden("OS BicubicUpsample", HashImage(upscaled), 0xB405961598B8C701ull);
+    CheckGolden("OS Bicubic", HashImage(ScaleImage(ScaleKernel::Bicubic, downscale, Source)), 0x2084BCA0CB5F792Bull);
+    CheckGolden("OS Lanczos", HashImage(ScaleImage(ScaleKernel::Lanczos, downscale, Source)), 0x3103CD6B1046B00Cull);
+    CheckGolden("OS Catmull", HashImage(ScaleImage(ScaleKernel::Catmull, downscale, Source)), 0xFC76E06BAD4CC86Cull);
+    CheckGolden("OS Magc", HashImage(ScaleImage(ScaleKernel::Magc, downscale, Source)), 0x6D374331535C3EADull);
+}
+
+TEST_CASE(Rcas)
+{
+    auto fixed = RcasImage(Source, Motion, ReferenceInputs::Rcas(false));
+    auto dynamic = RcasImage(Source, Motion, ReferenceInputs::Rcas(true));
+
+    CheckGolden("RCAS", HashImage(fixed), 0x751CA94AD04DFBDFull);
+    CheckGolden("RCAS dynamic", HashImage(dynamic), 0x5B9014EF59C1B1D5ull);
+}
+
+TEST_CASE(ResourceFlip)
+{
+    RFConstants color { Width, 40, 4, 0 };
+    RFConstants velocity { Width, 40, 4, 1 };
+
+    CheckGolden("RF color", HashImage(ResourceFlipImage(Source, color)), 0x811D1F789DF36539ull);
+    CheckGolden("RF velocity", HashImage(ResourceFlipImage(Motion, velocity)), 0xFE4B7F7049E00035ull);
+}
+
+TEST_CASE(PostFused)
+{
+    FusedParams params;
+    params.Kernel = ScaleKernel::Lanczos;
+    params.Scale = { Width, Height, 40, 30 };
+    params.Rcas = ReferenceInputs::Rcas(true);
+    params.Format = OutputFormat::R10G10B10A2;
+
+    auto fused = FusedImage(Source, Motion, params);
+
+    CheckGolden("PF Lanczos", HashImage(fused), 0xB097889A37EB01DCull);
+    CheckGolden("PF Lanczos R10G10B10A2", HashPacked(PackImage(params.Format, fused)), 0xE4CDF9DC5D96380Cull);
+}
+
+TEST_MAIN()
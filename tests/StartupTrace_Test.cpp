@@ -0,0 +1,342 @@
+#include "TestCheck.h"
+
+#include <misc/StartupTrace.h>
+
+#include <cctype>
+#include <memory>
+#include <set>
+#include <thread>
+#include <unistd.h>
+
+// Recorder is 40 KB, tests keep theirs on the heap
+static std::unique_ptr<SpanRecorder> NewRecorder() { return std::make_unique<SpanRecorder>(); }
+
+// Well formed JSON check, enough to tell chrome://tracing won't reject the export
+struct JsonChecker
+{
+    const std::string& text;
+    size_t pos = 0;
+
+    void Skip()
+    {
+        while (pos < text.size() && std::isspace((unsigned char) text[pos]))
+            pos++;
+    }
+
+    bool Eat(char c)
+    {
+        Skip();
+
+        if (pos < text.size() && text[pos] == c)
+        {
+            pos++;
+            return true;
+        }
+
+        return false;
+    }
+
+    bool String()
+    {
+        if (!Eat('"'))
+            return false;
+
+        while (pos < text.size() && text[pos] != '"')
+        {
+            if ((unsigned char) text[pos] < 0x20)
+                return false;
+
+            if (text[pos] == '\\')
+                pos++;
+
+            pos++;
+        }
+
+        return Eat('"');
+    }
+
+    bool Number()
+    {
+        Skip();
+        auto start = pos;
+
+        while (pos < text.size() && (std::isdigit((unsigned char) text[pos]) || text[pos] == '.' || text[pos] == '-'))
+            pos++;
+
+        return pos > start;
+    }
+
+    bool Value()
+    {
+        Skip();
+
+        if (pos >= text.size())
+            return false;
+
+        if (text[pos] == '"')
+            return String();
+
+        if (text[pos] == '{')
+        {
+            pos++;
+
+            if (Eat('}'))
+                return true;
+
+            do
+            {
+                if (!String() || !Eat(':') || !Value())
+                    return false;
+            } while (Eat(','));
+
+            return Eat('}');
+        }
+
+        if (text[pos] == '[')
+        {
+            pos++;
+
+            if (Eat(']'))
+                return true;
+
+            do
+            {
+                if (!Value())
+                    return false;
+            } while (Eat(','));
+
+            return Eat(']');
+        }
+
+        return Number();
+    }
+
+    bool Document()
+    {
+        if (!Value())
+            return false;
+
+        Skip();
+        return pos == text.size();
+    }
+};
+
+static bool IsValidJson(const std::string& text) { return JsonChecker { text }.Document(); }
+
+static size_t Count(const std::string& text, const std::string& pattern)
+{
+    size_t count = 0;
+
+    for (auto pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1))
+        count++;
+
+    return count;
+}
+
+TEST_CASE(NestedScopesEndInnerFirst)
+{
+    auto recorder = NewRecorder();
+
+    {
+        SpanRecorder::Scope outer(*recorder, "Outer");
+
+        {
+            SpanRecorder::Scope inner(*recorder, "Inner");
+        }
+
+        SpanRecorder::Scope sibling(*recorder, "Sibling");
+    }
+
+    auto spans = recorder->Spans();
+    CHECK_EQ(spans.size(), 3u);
+
+    if (spans.size() != 3)
+        return;
+
+    CHECK_EQ(std::string(spans[0].name), "Inner");
+    CHECK_EQ(std::string(spans[1].name), "Sibling");
+    CHECK_EQ(std::string(spans[2].name), "Outer");
+
+    // Children lie inside their parent on the same thread, the flame graph relies on it
+    for (size_t i = 0; i < 2; i++)
+    {
+        CHECK(spans[2].start <= spans[i].start);
+        CHECK(spans[i].start <= spans[i].end);
+        CHECK(spans[i].end <= spans[2].end);
+        CHECK_EQ(spans[i].thread, spans[2].thread);
+    }
+
+    CHECK(spans[0].end <= spans[1].start);
+    CHECK_EQ(spans[0].thread, SpanRecorder::ThreadId());
+}
+
+TEST_CASE(BeginEndAcrossCalls)
+{
+    auto recorder = NewRecorder();
+
+    auto token = recorder->Begin("LoadOriginalDll");
+    recorder->End(token);
+
+    // A token which was never begun records nothing
+    recorder->End({});
+
+    auto spans = recorder->Spans();
+    CHECK_EQ(spans.size(), 1u);
+    CHECK(spans.size() == 1 && spans[0].start <= spans[0].end);
+    CHECK_EQ(recorder->Dropped(), 0u);
+}
+
+TEST_CASE(ThreadsRecordWithOwnIds)
+{
+    auto recorder = NewRecorder();
+    constexpr uint32_t Threads = 8;
+    constexpr uint32_t SpansPerThread = 50;
+    std::vector<std::thread> workers;
+    std::vector<uint32_t> ids(Threads);
+
+    for (uint32_t t = 0; t < Threads; t++)
+    {
+        workers.emplace_back(
+            [&, t]()
+            {
+                ids[t] = SpanRecorder::ThreadId();
+
+                for (uint32_t i = 0; i < SpansPerThread / 2; i++)
+                {
+                    SpanRecorder::Scope outer(*recorder, "Hook");
+                    SpanRecorder::Scope inner(*recorder, "Original");
+                }
+            });
+    }
+
+    for (auto& worker : workers)
+        worker.join();
+
+    auto spans = recorder->Spans();
+    CHECK_EQ(spans.size(), (size_t) Threads * SpansPerThread);
+    CHECK_EQ(recorder->Dropped(), 0u);
+
+    std::set<uint32_t> distinct(ids.begin(), ids.end());
+    CHECK_EQ(distinct.size(), (size_t) Threads);
+    CHECK(distinct.count(SpanRecorder::ThreadId()) == 0);
+
+    for (auto id : ids)
+    {
+        size_t count = 0;
+
+        for (const auto& span : spans)
+        {
+            if (span.thread == id)
+                count++;
+        }
+
+        CHECK_EQ(count, (size_t) SpansPerThread);
+    }
+}
+
+TEST_CASE(SpansPastCapacityAreDropped)
+{
+    auto recorder = NewRecorder();
+
+    for (uint32_t i = 0; i < SpanRecorder::Capacity + 10; i++)
+        recorder->Record("Span", i, i + 1, 1);
+
+    auto spans = recorder->Spans();
+    CHECK_EQ(spans.size(), (size_t) SpanRecorder::Capacity);
+    CHECK_EQ(recorder->Dropped(), 10u);
+
+    // The first Capacity spans are kept, not the last ones
+    CHECK(!spans.empty() && spans.back().start == SpanRecorder::Capacity - 1);
+
+    auto json = recorder->ExportChromeTrace(1);
+    CHECK(IsValidJson(json));
+    CHECK_EQ(Count(json, "\"ph\":\"X\""), (size_t) SpanRecorder::Capacity);
+}
+
+TEST_CASE(DroppingFromThreadsKeepsCapacity)
+{
+    auto recorder = NewRecorder();
+    std::vector<std::thread> workers;
+
+    for (int t = 0; t < 4; t++)
+    {
+        workers.emplace_back(
+            [&]()
+            {
+                for (uint32_t i = 0; i < SpanRecorder::Capacity; i++)
+                    recorder->Record("Span", 0, 1, SpanRecorder::ThreadId());
+            });
+    }
+
+    for (auto& worker : workers)
+        worker.join();
+
+    CHECK_EQ(recorder->Spans().size(), (size_t) SpanRecorder::Capacity);
+    CHECK_EQ(recorder->Dropped(), 3u * SpanRecorder::Capacity);
+}
+
+TEST_CASE(ExportWritesCompleteEvents)
+{
+    auto recorder = NewRecorder();
+
+    recorder->Record("CheckWorkingMode", 5000, 1'254'321, 1);
+    recorder->Record("EarlyHooks", 1000, 3500, 2);
+
+    auto json = recorder->ExportChromeTrace(4242);
+    CHECK(IsValidJson(json));
+
+    CHECK_EQ(json.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0), 0u);
+    CHECK(json.find("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":4242,\"tid\":1,"
+                    "\"args\":{\"name\":\"OptiScaler\"}}") != std::string::npos);
+
+    // Microseconds since the earliest start with three decimals
+    CHECK(json.find("{\"name\":\"CheckWorkingMode\",\"cat\":\"startup\",\"ph\":\"X\",\"ts\":4.000,"
+                    "\"dur\":1249.321,\"pid\":4242,\"tid\":1}") != std::string::npos);
+    CHECK(json.find("{\"name\":\"EarlyHooks\",\"cat\":\"startup\",\"ph\":\"X\",\"ts\":0.000,"
+                    "\"dur\":2.500,\"pid\":4242,\"tid\":2}") != std::string::npos);
+}
+
+TEST_CASE(ExportEscapesNames)
+{
+    auto recorder = NewRecorder();
+
+    recorder->Record("Quote \" backslash \\ tab \t", 0, 1, 1);
+
+    auto json = recorder->ExportChromeTrace(1);
+    CHECK(IsValidJson(json));
+    CHECK(json.find("\"Quote \\\" backslash \\\\ tab \\u0009\"") != std::string::npos);
+}
+
+TEST_CASE(EmptyExportIsValid)
+{
+    auto recorder = NewRecorder();
+    auto json = recorder->ExportChromeTrace(1);
+
+    CHECK(IsValidJson(json));
+    CHECK_EQ(Count(json, "\"ph\":\"X\""), 0u);
+}
+
+TEST_CASE(SaveWritesExport)
+{
+    auto recorder = NewRecorder();
+    recorder->Record("DllMain", 0, 1000, 1);
+
+    auto path = std::filesystem::temp_directory_path() /
+                ("optiscaler_startuptrace_test_" + std::to_string(getpid()) + ".json");
+
+    CHECK(recorder->SaveChromeTrace(path, 7));
+
+    std::ifstream stream(path, std::ios::binary);
+    std::string saved((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    stream.close();
+
+    CHECK_EQ(saved, recorder->ExportChromeTrace(7));
+
+    auto tempPath = path;
+    tempPath += ".tmp";
+    CHECK(!std::filesystem::exists(tempPath));
+
+    std::filesystem::remove(path);
+}
+
+TEST_MAIN()
@@ -0,0 +1,92 @@
+#include "TestCheck.h"
+
+#include <upscalers/SubmitRing.h>
+
+#include <vector>
+
+TEST_CASE(UnusedSlotsNeedNoWait)
+{
+    SubmitRing<2> ring;
+
+    CHECK_EQ(ring.Current(), 0u);
+    CHECK_EQ(ring.RequiredFence(), 0u);
+    CHECK_EQ(ring.LastFence(), 0u);
+
+    ring.Submit(1);
+
+    CHECK_EQ(ring.Current(), 1u);
+    CHECK_EQ(ring.RequiredFence(), 0u);
+    CHECK_EQ(ring.LastFence(), 1u);
+}
+
+TEST_CASE(SlotWaitsForItsOwnSubmit)
+{
+    SubmitRing<3> ring;
+
+    for (uint64_t fence = 1; fence <= 10; fence++)
+    {
+        // Slot was last submitted Count frames ago
+        CHECK_EQ(ring.RequiredFence(), fence > 3 ? fence - 3 : 0u);
+        CHECK_EQ(ring.Current(), (uint32_t) ((fence - 1) % 3));
+
+        ring.Submit(fence);
+        CHECK_EQ(ring.LastFence(), fence);
+    }
+}
+
+TEST_CASE(CpuStaysAtMostCountMinusOneAhead)
+{
+    // Fake queue, a submit completes when the CPU waits for it
+    SubmitRing<2> ring;
+    uint64_t completed = 0;
+    uint64_t fence = 0;
+    std::vector<uint64_t> waits;
+
+    for (int frame = 0; frame < 6; frame++)
+    {
+        auto required = ring.RequiredFence();
+
+        if (required > completed)
+        {
+            waits.push_back(required);
+            completed = required;
+        }
+
+        ring.Submit(++fence);
+
+        // Every submit which isn't completed yet is in flight
+        CHECK(fence - completed <= 2);
+    }
+
+    CHECK_EQ(waits.size(), 4u);
+    CHECK_EQ(waits.front(), 1u);
+    CHECK_EQ(waits.back(), 4u);
+}
+
+TEST_CASE(ResetForgetsSubmits)
+{
+    SubmitRing<2> ring;
+
+    ring.Submit(5);
+    ring.Submit(6);
+    ring.Submit(7);
+    ring.Reset();
+
+    CHECK_EQ(ring.Current(), 0u);
+    CHECK_EQ(ring.RequiredFence(), 0u);
+    CHECK_EQ(ring.LastFence(), 0u);
+}
+
+TEST_CASE(SingleSlotWaitsEveryFrame)
+{
+    SubmitRing<1> ring;
+
+    ring.Submit(1);
+    CHECK_EQ(ring.Current(), 0u);
+    CHECK_EQ(ring.RequiredFence(), 1u);
+
+    ring.Submit(2);
+    CHECK_EQ(ring.RequiredFence(), 2u);
+}
+
+TEST_MAIN()
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+// Minimal test registry, every test file is its own executable and returns the number of failures
+
+struct TestCase
+{
+    const char* name;
+    void (*func)();
+};
+
+inline std::vector<TestCase>& TestCases()
+{
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+inline int& TestFailures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+struct TestRegistrar
+{
+    TestRegistrar(const char* name, void (*func)()) { TestCases().push_back({ name, func }); }
+};
+
+#define TEST_CASE(name)                                                                                                \
+    static void name();                                                                                                \
+    static TestRegistrar name##_registrar(#name, name);                                                                \
+    static void name()
+
+#define CHECK(expr)                                                                                                    \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!(expr))                                                                                                   \
+        {                                                                                                              \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #expr);                             \
+            TestFailures()++;                                                                                          \
+        }                                                                                                              \
+    } while (0)
+
+#define CHECK_EQ(a, b)                                                                                                 \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        if (!((a) == (b)))                                                                                             \
+        {                                                                                                              \
+            std::fprintf(stderr, "%s:%d: CHECK_EQ(%s, %s) failed\n", __FILE__, __LINE__, #a, #b);                     \
+            TestFailures()++;                                                                                          \
+        }                                                                                                              \
+    } while (0)
+
+inline int RunTests()
+{
+    for (auto& test : TestCases())
+    {
+        auto before = TestFailures();
+        test.func();
+        std::printf("%s %s\n", TestFailures() == before ? "[ OK ]" : "[FAIL]", test.name);
+    }
+
+    std::printf("%zu tests, %d failed checks\n", TestCases().size(), TestFailures());
+    return TestFailures() == 0 ? 0 : 1;
+}
+
+#define TEST_MAIN()                                                                                                    \
+    int main() { return RunTests(); }
@@ -0,0 +1,39 @@
+#include "TestCheck.h"
+
+#include <misc/ThreadFlag.h>
+
+#include <thread>
+
+struct SpoofTag;
+struct HeapTag;
+
+static ThreadFlag<SpoofTag> skipSpoofing;
+static ThreadFlag<HeapTag> skipHeapCapture;
+
+TEST_CASE(StartsCleared)
+{
+    CHECK(!skipSpoofing);
+    CHECK(!skipHeapCapture);
+}
+
+TEST_CASE(TagsAreSeparate)
+{
+    skipSpoofing = true;
+    CHECK(!skipHeapCapture);
+    skipSpoofing = false;
+}
+
+TEST_CASE(ValueFollowsTheThread)
+{
+    skipHeapCapture = true;
+
+    bool seenOnWorker = true;
+    std::thread([&] { seenOnWorker = skipHeapCapture; }).join();
+
+    CHECK(!seenOnWorker);
+    CHECK(skipHeapCapture);
+
+    skipHeapCapture = false;
+}
+
+TEST_MAIN()
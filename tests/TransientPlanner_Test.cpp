@@ -0,0 +1,158 @@
+#include "TestCheck.h"
+
+#include <misc/TransientPlanner.h>
+
+using Lifetime = TransientPlanner::Lifetime;
+
+TEST_CASE(PlacesFirstFitWithAlignment)
+{
+    TransientPlanner planner(1024);
+
+    auto a = planner.Allocate(100, 1);
+    auto b = planner.Allocate(100, 256);
+
+    CHECK(a.has_value() && b.has_value());
+    CHECK_EQ(a->offset, 0u);
+    CHECK_EQ(b->offset, 256u);
+    CHECK(!a->aliased && !b->aliased);
+    CHECK_EQ(planner.Used(), 200u);
+    CHECK_EQ(planner.Footprint(), 356u);
+
+    // Gap between a and b is used before the end
+    auto c = planner.Allocate(100, 4);
+    CHECK_EQ(c->offset, 100u);
+
+    CHECK(!planner.Allocate(1024, 1).has_value());
+    CHECK(!planner.Allocate(0, 1).has_value());
+    CHECK(!planner.Allocate(16, 3).has_value());
+}
+
+TEST_CASE(FreedRangeWaitsForItsRetireValue)
+{
+    TransientPlanner planner(256);
+
+    auto a = planner.Allocate(256, 1);
+    planner.Free(*a, 5);
+
+    CHECK_EQ(planner.Used(), 0u);
+    CHECK_EQ(planner.RetiringBytes(), 256u);
+    CHECK(!planner.Allocate(64, 1).has_value());
+
+    CHECK_EQ(planner.Reclaim(4), 0u);
+    CHECK(!planner.Allocate(64, 1).has_value());
+
+    CHECK_EQ(planner.Reclaim(5), 1u);
+    CHECK(planner.IsEmpty());
+
+    // Memory was used before, texture needs an aliasing barrier
+    auto b = planner.Allocate(64, 1);
+    CHECK_EQ(b->offset, 0u);
+    CHECK(b->aliased);
+    CHECK_EQ(planner.Peak(), 256u);
+}
+
+TEST_CASE(DisjointLifetimesShareMemory)
+{
+    TransientPlanner planner(1024);
+
+    auto a = planner.Allocate(512, 1, { 0, 1 });
+    auto b = planner.Allocate(512, 1, { 2, 3 });
+    auto c = planner.Allocate(256, 1, { 4, 4 });
+
+    CHECK_EQ(a->offset, 0u);
+    CHECK_EQ(b->offset, 0u);
+    CHECK_EQ(c->offset, 0u);
+    CHECK(b->aliased && c->aliased);
+
+    CHECK(planner.SharesMemory(*a));
+    CHECK(planner.SharesMemory(*c));
+    CHECK_EQ(planner.Used(), 1280u);
+    CHECK_EQ(planner.Footprint(), 512u);
+}
+
+TEST_CASE(OverlappingLifetimesGetOwnRanges)
+{
+    TransientPlanner planner(1024);
+
+    auto a = planner.Allocate(256, 1, { 0, 1 });
+    auto b = planner.Allocate(256, 1, { 1, 2 });
+    auto c = planner.Allocate(256, 1, { 2, 3 });
+
+    CHECK_EQ(a->offset, 0u);
+    CHECK_EQ(b->offset, 256u);
+
+    // Overlaps b only, goes over a
+    CHECK_EQ(c->offset, 0u);
+
+    CHECK(!planner.SharesMemory(*b));
+    CHECK(planner.SharesMemory(*a));
+
+    // Whole frame lifetime conflicts with everything
+    auto d = planner.Allocate(256, 1);
+    CHECK_EQ(d->offset, 512u);
+    CHECK(!planner.SharesMemory(*d));
+}
+
+TEST_CASE(PartialOverlapPicksLowestFreeOffset)
+{
+    TransientPlanner planner(1024);
+
+    auto a = planner.Allocate(128, 1, { 0, 0 });
+    auto b = planner.Allocate(128, 1, { 1, 1 });
+    auto c = planner.Allocate(256, 1, { 1, 1 });
+
+    CHECK_EQ(a->offset, 0u);
+    CHECK_EQ(b->offset, 0u);
+
+    // Conflicts with b only, can't use [0, 128)
+    CHECK_EQ(c->offset, 128u);
+    CHECK(!c->aliased);
+    CHECK(!planner.SharesMemory(*c));
+}
+
+TEST_CASE(RetiringRangeIsNotAliasedInFrame)
+{
+    TransientPlanner planner(512);
+
+    auto a = planner.Allocate(256, 1, { 0, 0 });
+    planner.Free(*a, 3);
+
+    // GPU might still read it, even a disjoint lifetime has to go around
+    auto b = planner.Allocate(256, 1, { 1, 1 });
+    CHECK_EQ(b->offset, 256u);
+
+    planner.Reclaim(3);
+
+    auto c = planner.Allocate(256, 1, { 0, 0 });
+    CHECK_EQ(c->offset, 0u);
+}
+
+TEST_CASE(FreeMatchesTheRightAllocation)
+{
+    TransientPlanner planner(512);
+
+    // Same range with different lifetimes
+    auto a = planner.Allocate(256, 1, { 0, 0 });
+    auto b = planner.Allocate(256, 1, { 1, 1 });
+
+    planner.Free(*b, 0);
+    planner.Reclaim(0);
+
+    CHECK(!planner.IsEmpty());
+    CHECK_EQ(planner.Used(), 256u);
+    CHECK(!planner.SharesMemory(*a));
+
+    // Overlaps a now, goes after it
+    auto c = planner.Allocate(256, 1, { 0, 1 });
+    CHECK_EQ(c->offset, 256u);
+}
+
+TEST_CASE(InvalidLifetimeIsRejected)
+{
+    TransientPlanner planner(512);
+
+    CHECK(!planner.Allocate(64, 1, { 3, 2 }).has_value());
+    CHECK(planner.IsEmpty());
+}
+
+TEST_MAIN()
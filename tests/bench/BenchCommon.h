@@ -0,0 +1,36 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+// Benchmarks print one line per case, --quick (used by ctest) runs a few iterations only
+
+inline bool BenchQuick(int argc, char** argv)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--quick") == 0)
+            return true;
+    }
+
+    return false;
+}
+
+// Keeps the compiler from dropping the measured work
+template <typename T> inline void BenchKeep(const T& value) { asm volatile("" : : "r,m"(value) : "memory"); }
+
+// Runs func iterations times and prints the average cost of one call
+template <typename F> double BenchRun(const char* name, size_t iterations, F&& func)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < iterations; i++)
+        func(i);
+
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    auto perCall = iterations > 0 ? elapsed / (double) iterations : 0.0;
+
+    std::printf("%-48s %12.2f ns/op  (%zu ops)\n", name, perCall, iterations);
+    return perCall;
+}
@@ -0,0 +1,137 @@
+#include "BenchCommon.h"
+
+#include <misc/ContextRegistry.h>
+
+#include <map>
+#include <vector>
+
+// Per call context lookup of the input translators. Compares what hk_xessD3D12Execute did before,
+// six std::map lookups keyed by the context, with one lookup in the registry. Contexts created by
+// OptiScaler use decoded handles, contexts of the game (FSR2/3 context memory) use the hash index.
+// Lookups go round robin over all live contexts so bigger counts leave the cache.
+
+struct Record
+{
+    void* nvParams = nullptr;
+    void* handle = nullptr;
+    float motionScale[2] {};
+    float jitterScale[2] {};
+    uint64_t initParams[8] {};
+};
+
+struct OldMaps
+{
+    std::map<void*, void*> nvParams;
+    std::map<void*, void*> contexts;
+    std::map<void*, float> motionScales;
+    std::map<void*, float> jitterScales;
+    std::map<void*, uint64_t> d3d12InitParams;
+    std::map<void*, uint64_t> vkInitParams;
+
+    void Add(void* key)
+    {
+        nvParams[key] = key;
+        contexts[key] = key;
+        motionScales[key] = 1.0f;
+        jitterScales[key] = 1.0f;
+        d3d12InitParams[key] = 1;
+        vkInitParams[key] = 1;
+    }
+
+    uintptr_t Execute(void* key)
+    {
+        uintptr_t sum = 0;
+
+        if (auto it = nvParams.find(key); it != nvParams.end())
+            sum += (uintptr_t) it->second;
+
+        if (auto it = contexts.find(key); it != contexts.end())
+            sum += (uintptr_t) it->second;
+
+        if (auto it = motionScales.find(key); it != motionScales.end())
+            sum += (uintptr_t) it->second;
+
+        if (auto it = jitterScales.find(key); it != jitterScales.end())
+            sum += (uintptr_t) it->second;
+
+        if (auto it = d3d12InitParams.find(key); it != d3d12InitParams.end())
+            sum += it->second;
+
+        if (auto it = vkInitParams.find(key); it != vkInitParams.end())
+            sum += it->second;
+
+        return sum;
+    }
+};
+
+using Registry = ContextRegistry<void*, Record>;
+
+static uintptr_t Execute(Registry& registry, void* key)
+{
+    auto record = registry.Find(key);
+
+    if (record == nullptr)
+        return 0;
+
+    return (uintptr_t) record->nvParams + (uintptr_t) record->handle + (uintptr_t) record->motionScale[0] +
+           (uintptr_t) record->jitterScale[0] + record->initParams[0];
+}
+
+// Fake context memory of the game, spread over the heap like real allocations
+static void* GameContext(size_t i) { return (void*) (0x10000000 + i * 0x2A40); }
+
+int main(int argc, char** argv)
+{
+    bool quick = BenchQuick(argc, argv);
+    size_t iterations = quick ? 10000 : 10000000;
+    char name[96];
+
+    for (size_t count : { 1, 4, 64, 1024, 16384 })
+    {
+        OldMaps old;
+        Registry created;
+        Registry game;
+        std::vector<void*> gameKeys;
+        std::vector<void*> handles;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            gameKeys.push_back(GameContext(i));
+            old.Add(gameKeys.back());
+            game.Add(gameKeys.back()).handle = gameKeys.back();
+
+            void* handle = nullptr;
+            created.Create(handle).handle = handle;
+            handles.push_back(handle);
+        }
+
+        std::snprintf(name, sizeof(name), "6x std::map, %zu contexts", count);
+        BenchRun(name, iterations, [&](size_t i) { BenchKeep(old.Execute(gameKeys[i % count])); });
+
+        std::snprintf(name, sizeof(name), "Registry game key, %zu contexts", count);
+        BenchRun(name, iterations, [&](size_t i) { BenchKeep(Execute(game, gameKeys[i % count])); });
+
+        std::snprintf(name, sizeof(name), "Registry handle, %zu contexts", count);
+        BenchRun(name, iterations, [&](size_t i) { BenchKeep(Execute(created, handles[i % count])); });
+    }
+
+    // Games recreate contexts on resolution changes, destroy and create one per op with 64 alive
+    {
+        Registry registry;
+        std::vector<void*> handles(64, nullptr);
+
+        for (auto& handle : handles)
+            registry.Create(handle);
+
+        BenchRun("Registry remove + create, 64 contexts", iterations / 10,
+                 [&](size_t i)
+                 {
+                     auto& handle = handles[i % handles.size()];
+                     registry.Remove(handle);
+                     registry.Create(handle);
+                     BenchKeep(handle);
+                 });
+    }
+
+    return 0;
+}
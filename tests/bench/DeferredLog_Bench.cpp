@@ -0,0 +1,112 @@
+#include "BenchCommon.h"
+
+#include <misc/DeferredLog.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+// Per frame debug logs on the present path. Compares the cost on the calling thread of a disabled
+// level check, a deferred record which is formatted on the DeferredLog thread and formatting it
+// right away (what spdlog does on the caller, even with its async logger).
+//
+// <format> isn't required here, records are decoded with snprintf.
+
+static std::atomic<int> logLevel = 2;
+static std::atomic<uint64_t> sunk = 0;
+
+static void Sink(int, DeferredLog::Clock::time_point, std::string_view message)
+{
+    sunk.fetch_add(1, std::memory_order_relaxed);
+    BenchKeep(message.size());
+}
+
+static void Format(std::string& out, const char* format, uint64_t frame, uint32_t flags, double frameTime)
+{
+    char buffer[256];
+    auto size = std::snprintf(buffer, sizeof(buffer), format, (unsigned long long) frame, flags, frameTime);
+    out.assign(buffer, size > 0 ? (size_t) size : 0);
+}
+
+static void Decode(const char* format, const std::byte* args, std::string& out)
+{
+    uint64_t frame;
+    uint32_t flags;
+    double frameTime;
+
+    std::memcpy(&frame, args, sizeof(frame));
+    std::memcpy(&flags, args + sizeof(frame), sizeof(flags));
+    std::memcpy(&frameTime, args + sizeof(frame) + sizeof(flags), sizeof(frameTime));
+
+    Format(out, format, frame, flags, frameTime);
+}
+
+static constexpr DeferredLog::Site PresentSite { 1, "Present _frameCounter: %llu, flags: %X, Frametime: %f" };
+
+static void Sync(uint64_t frame, uint32_t flags, double frameTime)
+{
+    static thread_local std::string message;
+    auto time = DeferredLog::Clock::now();
+
+    Format(message, PresentSite.format, frame, flags, frameTime);
+    Sink(PresentSite.level, time, message);
+}
+
+int main(int argc, char** argv)
+{
+    size_t iterations = BenchQuick(argc, argv) ? 10000 : 1000000;
+    size_t fallbacks = 0;
+
+    BenchRun("disabled level", iterations,
+             [&](size_t i)
+             {
+                 if (logLevel.load(std::memory_order_relaxed) <= PresentSite.level)
+                     Sync(i, 0x10, 16.6);
+             });
+
+    BenchRun("sync, formatted on caller", iterations, [&](size_t i) { Sync(i, 0x10, 16.6); });
+
+    DeferredLog::Start(Sink);
+    sunk = 0;
+
+    // Frames log a few records each, the thread drains the ring between bursts. Only the calls are
+    // timed, a tight loop on one core would just measure the ring being full.
+    constexpr size_t Burst = 256;
+    double elapsed = 0.0;
+
+    for (size_t start = 0; start < iterations; start += Burst)
+    {
+        auto count = std::min(Burst, iterations - start);
+        auto begin = std::chrono::steady_clock::now();
+
+        for (size_t i = start; i < start + count; i++)
+        {
+            if (!DeferredLog::Queue(&PresentSite, &Decode, (uint64_t) i, (uint32_t) 0x10, 16.6))
+            {
+                fallbacks++;
+                Sync(i, 0x10, 16.6);
+            }
+        }
+
+        elapsed += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+
+        while (sunk.load(std::memory_order_relaxed) < start + count)
+            std::this_thread::yield();
+    }
+
+    std::printf("%-48s %12.2f ns/op  (%zu ops)\n", "deferred", elapsed / (double) iterations, iterations);
+
+    DeferredLog::Stop();
+
+    std::printf("deferred calls which fell back to sync: %zu\n", fallbacks);
+
+    if (sunk.load() != iterations)
+    {
+        std::printf("Lost records, %llu of %zu\n", (unsigned long long) sunk.load(), iterations);
+        return 1;
+    }
+
+    return 0;
+}
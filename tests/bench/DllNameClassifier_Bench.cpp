@@ -0,0 +1,129 @@
+#include "BenchCommon.h"
+
+#include <DllNameClassifier.h>
+
+#include <string>
+#include <vector>
+
+// Every LoadLibrary hook classifies the loaded name. Compares the suffix trie with what the hooks
+// did before, CheckDllName against every list, on names a game loads during startup.
+
+struct NameList
+{
+    uint32_t category;
+    const std::vector<std::string>* names;
+    const std::vector<std::wstring>* namesW;
+};
+
+static const NameList Lists[] = {
+    { DllCategory::Dx11, &dx11Names, &dx11NamesW },
+    { DllCategory::Dx12, &dx12Names, &dx12NamesW },
+    { DllCategory::Dxgi, &dxgiNames, &dxgiNamesW },
+    { DllCategory::Vulkan, &vkNames, &vkNamesW },
+    { DllCategory::Nvngx, &nvngxNames, &nvngxNamesW },
+    { DllCategory::NvngxDlss, &nvngxDlssNames, &nvngxDlssNamesW },
+    { DllCategory::Nvapi, &nvapiNames, &nvapiNamesW },
+    { DllCategory::SlInterposer, &slInterposerNames, &slInterposerNamesW },
+    { DllCategory::SlDlss, &slDlssNames, &slDlssNamesW },
+    { DllCategory::SlDlssg, &slDlssgNames, &slDlssgNamesW },
+    { DllCategory::SlReflex, &slReflexNames, &slReflexNamesW },
+    { DllCategory::SlCommon, &slCommonNames, &slCommonNamesW },
+    { DllCategory::Xess, &xessNames, &xessNamesW },
+    { DllCategory::XessDx11, &xessDx11Names, &xessDx11NamesW },
+    { DllCategory::Fsr2, &fsr2Names, &fsr2NamesW },
+    { DllCategory::Fsr2BE, &fsr2BENames, &fsr2BENamesW },
+    { DllCategory::Fsr3, &fsr3Names, &fsr3NamesW },
+    { DllCategory::Fsr3BE, &fsr3BENames, &fsr3BENamesW },
+    { DllCategory::FfxDx12, &ffxDx12Names, &ffxDx12NamesW },
+    { DllCategory::FfxVk, &ffxVkNames, &ffxVkNamesW },
+    { DllCategory::Overlay, &overlayNames, &overlayNamesW },
+    { DllCategory::BlockOverlay, &blockOverlayNames, &blockOverlayNamesW },
+};
+
+static const char* LoadedNames[] = {
+    "kernel32.dll",
+    "c:\\windows\\system32\\user32.dll",
+    "advapi32.dll",
+    "ws2_32.dll",
+    "xinput1_3.dll",
+    "c:\\windows\\system32\\d3d12.dll",
+    "d3d12core.dll",
+    "dxgi.dll",
+    "d3d11",
+    "vulkan-1.dll",
+    "nvapi64.dll",
+    "c:\\games\\game\\bin\\nvngx_dlss.dll",
+    "_nvngx.dll",
+    "sl.interposer.dll",
+    "sl.dlss_g.dll",
+    "libxess.dll",
+    "ffx_fsr2_api_x64.dll",
+    "amd_fidelityfx_dx12.dll",
+    "c:\\program files (x86)\\steam\\gameoverlayrenderer64.dll",
+    "discordoverlay64.dll",
+    "bink2w64.dll",
+    "c:\\games\\game\\bin\\physx3_x64.dll",
+    "gfsdk_aftermath_lib.x64.dll",
+    "mydxgi.dll",
+};
+
+static uint32_t ClassifyByLists(const std::string& name)
+{
+    uint32_t result = DllCategory::None;
+
+    for (auto& list : Lists)
+    {
+        if (CheckDllName(&name, list.names))
+            result |= list.category;
+    }
+
+    return result;
+}
+
+static uint32_t ClassifyByListsW(const std::wstring& name)
+{
+    uint32_t result = DllCategory::None;
+
+    for (auto& list : Lists)
+    {
+        if (CheckDllNameW(&name, list.namesW))
+            result |= list.category;
+    }
+
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    size_t iterations = BenchQuick(argc, argv) ? 10000 : 5000000;
+    constexpr size_t count = std::size(LoadedNames);
+
+    std::vector<std::string> names;
+    std::vector<std::wstring> namesW;
+
+    for (auto name : LoadedNames)
+    {
+        names.emplace_back(name);
+        namesW.emplace_back(names.back().begin(), names.back().end());
+    }
+
+    // Trie has to give the same answer as the lists for every name
+    for (size_t i = 0; i < count; i++)
+    {
+        if (ClassifyDllName(std::string_view(names[i])) != ClassifyByLists(names[i]) ||
+            ClassifyDllName(std::wstring_view(namesW[i])) != ClassifyByListsW(namesW[i]))
+        {
+            std::printf("Mismatch for %s\n", names[i].c_str());
+            return 1;
+        }
+    }
+
+    BenchRun("trie, char", iterations,
+             [&](size_t i) { BenchKeep(ClassifyDllName(std::string_view(names[i % count]))); });
+    BenchRun("lists, char", iterations, [&](size_t i) { BenchKeep(ClassifyByLists(names[i % count])); });
+    BenchRun("trie, wchar_t", iterations,
+             [&](size_t i) { BenchKeep(ClassifyDllName(std::wstring_view(namesW[i % count]))); });
+    BenchRun("lists, wchar_t", iterations, [&](size_t i) { BenchKeep(ClassifyByListsW(namesW[i % count])); });
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include "BenchCommon.h"
+
+#include <misc/FileIndex.h>
+
+#include <unistd.h>
+
+// Util::FindFilePath on a synthetic game folder. The old lookup walked the folder once per name
+// and stopped at the first match, the index walks it once (with and without helper threads) and
+// a warm start only loads the cache and checks the directory times. 100k files in 1k directories,
+// the dlls looked up are in the last directory and nvngx_dlssg.dll doesn't exist.
+
+namespace fs = std::filesystem;
+
+static const char* Names[] = { "nvngx_dlss.dll", "nvngx_dlssd.dll", "nvngx_dlssg.dll" };
+
+static void CreateTree(const fs::path& root, size_t directories, size_t filesPerDirectory)
+{
+    for (size_t d = 0; d < directories; d++)
+    {
+        // Two levels like Content/Paks, Engine/Binaries/ThirdParty
+        auto directory = root / ("Group" + std::to_string(d / 32)) / ("Folder" + std::to_string(d));
+        fs::create_directories(directory);
+
+        for (size_t f = 0; f < filesPerDirectory; f++)
+        {
+            auto extension = f % 10 == 0 ? ".dll" : ".pak";
+            std::ofstream(directory / ("file" + std::to_string(f) + extension));
+        }
+    }
+
+    auto lastIndex = directories - 1;
+    auto last = root / ("Group" + std::to_string(lastIndex / 32)) / ("Folder" + std::to_string(lastIndex));
+    std::ofstream(last / Names[0]);
+    std::ofstream(last / Names[1]);
+}
+
+static std::optional<fs::path> Walk(const fs::path& startDir, const fs::path& fileName)
+{
+    for (auto& entry : fs::recursive_directory_iterator(startDir, fs::directory_options::skip_permission_denied))
+    {
+        if (!entry.is_directory() && entry.path().filename() == fileName)
+            return entry.path();
+    }
+
+    return std::nullopt;
+}
+
+int main(int argc, char** argv)
+{
+    bool quick = BenchQuick(argc, argv);
+    size_t directories = quick ? 20 : 1000;
+    size_t filesPerDirectory = quick ? 10 : 100;
+    size_t iterations = quick ? 1 : 5;
+
+    auto root = fs::temp_directory_path() / ("optiscaler_fileindex_bench_" + std::to_string(getpid()));
+    auto cachePath = fs::temp_directory_path() / ("optiscaler_fileindex_bench_" + std::to_string(getpid()) + ".bin");
+    fs::remove_all(root);
+
+    auto start = std::chrono::steady_clock::now();
+    CreateTree(root, directories, filesPerDirectory);
+    auto created = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::printf("%zu files in %zu directories created, %.0f ms\n", directories * filesPerDirectory, directories,
+                created);
+
+    BenchRun("Walk per name, 3 names", iterations,
+             [&](size_t)
+             {
+                 for (auto name : Names)
+                     BenchKeep(Walk(root, name).has_value());
+             });
+
+    auto helpers = std::clamp(std::thread::hardware_concurrency(), 1u, 8u) - 1;
+
+    BenchRun("Index build, no helpers", iterations,
+             [&](size_t) { BenchKeep(FileIndex::Build(root, { ".dll" }, 0).FileCount()); });
+
+    // Same helper count as Util, nothing to compare on a single core
+    if (helpers > 0)
+    {
+        char name[64];
+        std::snprintf(name, sizeof(name), "Index build, %u helpers", helpers);
+        BenchRun(name, iterations,
+                 [&](size_t) { BenchKeep(FileIndex::Build(root, { ".dll" }, helpers).FileCount()); });
+    }
+
+    auto index = FileIndex::Build(root, { ".dll" }, helpers);
+    index.SaveFile(cachePath);
+    std::printf("Index has %zu dlls, cache %ju bytes\n", index.FileCount(), (uintmax_t) fs::file_size(cachePath));
+
+    BenchRun("Warm start, load cache + IsCurrent", iterations,
+             [&](size_t)
+             {
+                 FileIndex cached;
+                 BenchKeep(cached.LoadFile(cachePath) && cached.IsCurrent());
+             });
+
+    BenchRun("Index lookup, 3 names", quick ? 1000 : 100000,
+             [&](size_t)
+             {
+                 for (auto name : Names)
+                     BenchKeep(index.FindFirst(root, name).has_value());
+             });
+
+    fs::remove_all(root);
+    fs::remove(cachePath);
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include "BenchCommon.h"
+
+#include <misc/FrameTimeRing.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+// Push runs for every present and upscale, GetSummary only while the menu or the timings window
+// is open. Measures both, and the same rank statistics from a full sort as reference. Upscaler
+// times are pushed from the present hooks and the GPU timer, last case pushes from three threads.
+
+static float Noise(size_t i)
+{
+    // Frame times around 16.6 ms with a spike every 97 frames
+    auto value = 16.6f + (float) ((i * 2654435761u) % 1000) / 400.0f;
+    return i % 97 == 0 ? value * 3.0f : value;
+}
+
+int main(int argc, char** argv)
+{
+    bool quick = BenchQuick(argc, argv);
+    size_t iterations = quick ? 10000 : 10000000;
+    size_t summaries = quick ? 1000 : 200000;
+
+    static FrameTimeRing<300> ring;
+
+    for (size_t i = 0; i < 1000; i++)
+        ring.Push(Noise(i));
+
+    // Check against a sort of the visible samples
+    std::vector<float> sorted;
+
+    for (size_t i = 0; i < 300; i++)
+        sorted.push_back(ring.At(i));
+
+    std::sort(sorted.begin(), sorted.end());
+
+    auto summary = ring.GetSummary();
+    auto low = (double) sorted[297] + sorted[298] + sorted[299];
+
+    if (summary.p50 != sorted[149] || summary.p99 != sorted[296] || summary.min != sorted[0] ||
+        summary.max != sorted[299] || std::fabs(summary.low1Fps - (float) (3000.0 / low)) > 0.001f)
+    {
+        std::printf("Summary mismatch, p50 %f/%f p99 %f/%f\n", summary.p50, sorted[149], summary.p99, sorted[296]);
+        return 1;
+    }
+
+    BenchRun("Push", iterations, [&](size_t i) { ring.Push(Noise(i)); });
+
+    BenchRun("Push + GetSummary", summaries,
+             [&](size_t i)
+             {
+                 ring.Push(Noise(i));
+                 BenchKeep(ring.GetSummary());
+             });
+
+    BenchRun("GetSummary", iterations, [&](size_t) { BenchKeep(ring.GetSummary()); });
+
+    BenchRun("Push + full sort of 300 samples", summaries,
+             [&](size_t i)
+             {
+                 ring.Push(Noise(i));
+
+                 for (size_t i = 0; i < 300; i++)
+                     sorted[i] = ring.At(i);
+
+                 std::sort(sorted.begin(), sorted.end());
+                 BenchKeep(sorted[149]);
+             });
+
+    // Producers of upscaleTimes, a reader checks that every summary is the one of a sorted window
+    static FrameTimeRing<300> shared;
+    std::vector<std::thread> producers;
+    std::atomic<size_t> running = 3;
+    bool consistent = true;
+    auto perProducer = iterations / 3;
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t t = 0; t < 3; t++)
+    {
+        producers.emplace_back(
+            [&, t]()
+            {
+                for (size_t i = 0; i < perProducer; i++)
+                    shared.Push(Noise(i * 3 + t));
+
+                running--;
+            });
+    }
+
+    while (running > 0)
+    {
+        auto summary = shared.GetSummary();
+
+        if (summary.count > 0 &&
+            !(summary.min <= summary.p50 && summary.p50 <= summary.p99 && summary.p99 <= summary.max))
+        {
+            consistent = false;
+        }
+    }
+
+    for (auto& producer : producers)
+        producer.join();
+
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    std::printf("%-48s %12.2f ns/op  (%zu ops)\n", "Push, 3 producers + reader", elapsed / (perProducer * 3),
+                perProducer * 3);
+
+    if (!consistent || shared.Count() != 300)
+    {
+        std::printf("Summary of 3 producers is not consistent\n");
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,114 @@
+#include "BenchCommon.h"
+
+#include <resource_tracking/HeapIndex.h>
+
+#include <random>
+#include <thread>
+#include <vector>
+
+// Replays handle streams shaped like a game frame: most lookups hit a few big shader visible
+// heaps, the rest are spread over many small cpu only heaps. Heaps are recreated at the same
+// addresses now and then to exercise retirement.
+
+struct FakeHeap
+{
+    size_t cpuStart = 0;
+    size_t cpuEnd = 0;
+    size_t gpuStart = 0;
+    size_t gpuEnd = 0;
+};
+
+static constexpr size_t Increment = 32;
+
+static std::unique_ptr<FakeHeap> MakeHeap(size_t cpu, size_t gpu, size_t descriptors)
+{
+    auto size = descriptors * Increment;
+    return std::make_unique<FakeHeap>(FakeHeap { cpu, cpu + size, gpu, gpu == 0 ? 0 : gpu + size });
+}
+
+int main(int argc, char** argv)
+{
+    auto quick = BenchQuick(argc, argv);
+    size_t heapCount = quick ? 64 : 2048;
+    size_t lookups = quick ? 10000 : 20000000;
+
+    HeapIndex<FakeHeap> index;
+    std::vector<size_t> cpuBases;
+    std::vector<size_t> gpuBases;
+
+    for (size_t i = 0; i < heapCount; i++)
+    {
+        auto big = i < 4;
+        auto descriptors = big ? 500000 : 256;
+        auto cpu = 0x10000000ull + i * 0x1000000ull;
+        auto gpu = big ? 0x800000000ull + i * 0x10000000ull : 0;
+
+        index.Add(MakeHeap(cpu, gpu, descriptors), 0);
+        cpuBases.push_back(cpu);
+
+        if (big)
+            gpuBases.push_back(gpu);
+    }
+
+    std::mt19937_64 rng(42);
+    std::vector<size_t> cpuStream(lookups);
+    std::vector<size_t> gpuStream(lookups);
+
+    for (size_t i = 0; i < lookups; i++)
+    {
+        // Handles come in short runs from the same heap like descriptor tables do
+        auto heap = (rng() % 10) < 8 ? rng() % 4 : rng() % heapCount;
+        auto slots = heap < 4 ? 500000 : 256;
+        cpuStream[i] = cpuBases[heap] + (rng() % slots) * Increment;
+        gpuStream[i] = gpuBases[rng() % gpuBases.size()] + (rng() % 500000) * Increment;
+    }
+
+    BenchRun("cpu handle stream", lookups, [&](size_t i) { BenchKeep(index.FindByCpuHandle(cpuStream[i])); });
+    BenchRun("gpu handle stream", lookups, [&](size_t i) { BenchKeep(index.FindByGpuHandle(gpuStream[i])); });
+
+    BenchRun("cpu handle stream, same heap runs", lookups,
+             [&](size_t i) { BenchKeep(index.FindByCpuHandle(cpuBases[0] + (i % 64) * Increment)); });
+
+    // Recreate small heaps every "frame" while lookups continue
+    size_t frames = quick ? 16 : 2000;
+    size_t perFrame = lookups / frames;
+    uint64_t epoch = 0;
+
+    BenchRun("frame with heap churn", frames,
+             [&](size_t frame)
+             {
+                 auto heap = 4 + frame % (heapCount - 4);
+                 index.Add(MakeHeap(cpuBases[heap], 0, 256), epoch);
+
+                 for (size_t i = 0; i < perFrame; i++)
+                     BenchKeep(index.FindByCpuHandle(cpuStream[(frame * perFrame + i) % lookups]));
+
+                 index.Collect(++epoch);
+             });
+
+    std::printf("retired heaps waiting after churn: %zu\n", index.RetiredCount());
+
+    auto threads = quick ? 2u : std::max(2u, std::thread::hardware_concurrency());
+    std::vector<std::thread> workers;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (unsigned t = 0; t < threads; t++)
+    {
+        workers.emplace_back(
+            [&, t]
+            {
+                for (size_t i = 0; i < lookups; i++)
+                    BenchKeep(index.FindByCpuHandle(cpuStream[(i + t * 7919) % lookups]));
+            });
+    }
+
+    for (auto& worker : workers)
+        worker.join();
+
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    std::printf("%-48s %12.2f ns/op  (%u threads)\n", "cpu handle stream, parallel", elapsed / (double) lookups,
+                threads);
+
+    return 0;
+}
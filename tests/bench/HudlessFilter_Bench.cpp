@@ -0,0 +1,271 @@
+#include "BenchCommon.h"
+
+#include <hudfix/HudlessFilter.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Replays a recorded frame of hudless candidates through the old and the new Hudfix_Dx12 checks.
+//
+// Stream is what the draw/dispatch/RTV hooks of a deferred renderer hand to CheckForHudless in one
+// frame at 1440p with 1080p render resolution: gbuffer and lighting targets at render size, shadow
+// cascades, bloom and SSAO mips, depth, a few full size post targets and the hudless one.
+//
+// Old check took callerName by value, created a CapturedHudlesses entry with operator[] for every
+// candidate under _checkMutex and asked the swapchain for its description. New one rejects with the
+// packed filter and only looks at CapturedHudlesses for candidates which pass it.
+
+struct Candidate
+{
+    void* buffer;
+    uint32_t width;
+    uint32_t height;
+    uint32_t format;
+    uint32_t flags;
+};
+
+struct CapturedInfo
+{
+    bool enabled = true;
+    uint64_t usageCount = 0;
+};
+
+// DXGI values
+constexpr uint32_t R8G8B8A8_UNORM = 28;
+constexpr uint32_t R10G10B10A2_UNORM = 24;
+constexpr uint32_t R16G16B16A16_FLOAT = 10;
+constexpr uint32_t R11G11B10_FLOAT = 26;
+constexpr uint32_t R16G16_FLOAT = 34;
+constexpr uint32_t D32_FLOAT = 40;
+constexpr uint32_t R8_UNORM = 61;
+
+// D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL, D3D12_RESOURCE_FLAG_DENY_SHADER_RESOURCE
+constexpr uint32_t DepthFlags = 0x2 | 0x8;
+constexpr uint32_t RejectFlags = 0x2 | 0x8 | 0x10 | 0x20 | 0x40;
+
+constexpr uint32_t DisplayWidth = 2560;
+constexpr uint32_t DisplayHeight = 1440;
+
+struct FakeSwapchainDesc
+{
+    uint32_t width = DisplayWidth;
+    uint32_t height = DisplayHeight;
+    uint32_t refreshNumerator = 60;
+    uint32_t refreshDenominator = 1;
+    uint32_t format = R10G10B10A2_UNORM;
+    uint32_t bufferCount = 3;
+    uint32_t flags = 0;
+    void* window = nullptr;
+};
+
+struct FakeSwapchain
+{
+    FakeSwapchainDesc desc;
+    std::mutex mutex;
+
+    // DXGI copies the description under its own lock
+    virtual int GetDesc(FakeSwapchainDesc* pDesc)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        *pDesc = desc;
+        return 0;
+    }
+
+    virtual ~FakeSwapchain() = default;
+};
+
+static bool IsConvertible(uint32_t format)
+{
+    return format == R8G8B8A8_UNORM || format == R10G10B10A2_UNORM || format == R16G16B16A16_FLOAT ||
+           format == R11G11B10_FLOAT;
+}
+
+static std::vector<Candidate> RecordFrame()
+{
+    std::vector<Candidate> frame;
+    uintptr_t next = 0x10000;
+
+    auto add = [&](uint32_t width, uint32_t height, uint32_t format, uint32_t flags, int uses)
+    {
+        auto buffer = (void*) next;
+        next += 0x100;
+
+        for (int i = 0; i < uses; i++)
+            frame.push_back({ buffer, width, height, format, flags });
+    };
+
+    // Shadow cascades and depth
+    for (int i = 0; i < 4; i++)
+        add(2048, 2048, D32_FLOAT, DepthFlags, 40);
+
+    add(1920, 1080, D32_FLOAT, DepthFlags, 120);
+
+    // Gbuffer, motion vectors, lighting at render size
+    for (auto format : { R8G8B8A8_UNORM, R10G10B10A2_UNORM, R16G16B16A16_FLOAT, R16G16_FLOAT })
+        add(1920, 1080, format, 0, 300);
+
+    add(1920, 1080, R11G11B10_FLOAT, 0, 200);
+
+    // SSAO and bloom chains
+    for (uint32_t w = 960, h = 540; w >= 15; w /= 2, h /= 2)
+    {
+        add(w, h, R8_UNORM, 0, 6);
+        add(w, h, R11G11B10_FLOAT, 0, 8);
+    }
+
+    // Upscaled color, post process at display size and the hudless target
+    add(DisplayWidth, DisplayHeight, R16G16B16A16_FLOAT, 0, 12);
+    add(DisplayWidth, DisplayHeight, R11G11B10_FLOAT, 0, 8);
+    add(DisplayWidth, DisplayHeight, R10G10B10A2_UNORM, 0, 4);
+
+    // Dynamic resolution target a little off the display size
+    add(DisplayWidth - 16, DisplayHeight - 8, R10G10B10A2_UNORM, 0, 2);
+
+    return frame;
+}
+
+struct OldHudfix
+{
+    FakeSwapchain* swapchain = nullptr;
+    bool relaxedResolution = true;
+    bool extended = true;
+
+    std::mutex checkMutex;
+    std::unordered_map<void*, CapturedInfo> captured;
+
+    bool CheckForHudless(std::string callerName, const Candidate& resource)
+    {
+        std::lock_guard<std::mutex> lock(checkMutex);
+
+        if (!captured[resource.buffer].enabled)
+            return false;
+
+        FakeSwapchainDesc desc;
+        if (swapchain->GetDesc(&desc) != 0)
+            return false;
+
+        if (resource.height != desc.height || resource.width != desc.width)
+        {
+            if (!(relaxedResolution && (int64_t) resource.height >= (int64_t) desc.height - 32 &&
+                  resource.height <= desc.height + 32 && (int64_t) resource.width >= (int64_t) desc.width - 32 &&
+                  resource.width <= desc.width + 32))
+            {
+                return false;
+            }
+        }
+
+        if ((resource.flags & RejectFlags) > 0)
+            return false;
+
+        if (resource.format == desc.format)
+            return true;
+
+        return extended && IsConvertible(desc.format) && IsConvertible(resource.format) && callerName.size() > 0;
+    }
+};
+
+struct NewHudfix
+{
+    std::atomic<uint64_t> candidateFilter = 0;
+
+    std::mutex capturedMutex;
+    std::mutex checkMutex;
+    std::unordered_map<void*, CapturedInfo> captured;
+
+    bool CheckResource(const Candidate& resource)
+    {
+        auto filter = HudlessFilter::Unpack(candidateFilter.load(std::memory_order_acquire));
+
+        if (!filter.valid || resource.width == 0 || resource.height == 0)
+            return false;
+
+        bool sizeExtended = false;
+        if (!filter.MatchesSize(resource.width, resource.height, &sizeExtended))
+            return false;
+
+        if ((resource.flags & RejectFlags) > 0)
+            return false;
+
+        return filter.MatchesFormat(resource.format, IsConvertible(resource.format));
+    }
+
+    bool CheckForHudless(std::string_view callerName, const Candidate& resource)
+    {
+        if (!CheckResource(resource))
+            return false;
+
+        bool capturedDisabled = false;
+        {
+            std::lock_guard<std::mutex> lock(capturedMutex);
+
+            if (auto it = captured.find(resource.buffer); it != captured.end())
+                capturedDisabled = !it->second.enabled;
+        }
+
+        if (capturedDisabled)
+            return false;
+
+        std::lock_guard<std::mutex> lock(checkMutex);
+        return callerName.size() > 0;
+    }
+};
+
+int main(int argc, char** argv)
+{
+    bool quick = BenchQuick(argc, argv);
+    size_t frames = quick ? 20 : 20000;
+
+    auto frame = RecordFrame();
+
+    FakeSwapchain swapchain;
+
+    OldHudfix oldHudfix;
+    oldHudfix.swapchain = &swapchain;
+
+    NewHudfix newHudfix;
+    HudlessFilter filter {};
+    filter.width = swapchain.desc.width;
+    filter.height = swapchain.desc.height;
+    filter.format = swapchain.desc.format;
+    filter.relaxedResolution = true;
+    filter.extended = true;
+    filter.convertibleTarget = IsConvertible(swapchain.desc.format);
+    filter.valid = true;
+    newHudfix.candidateFilter = HudlessFilter::Pack(filter);
+
+    size_t oldAccepted = 0;
+    size_t newAccepted = 0;
+    auto iterations = frames * frame.size();
+
+    std::printf("%zu candidates per frame\n", frame.size());
+
+    BenchRun("Replay, operator[] + _checkMutex + GetDesc", iterations,
+             [&](size_t i)
+             {
+                 auto accepted = oldHudfix.CheckForHudless("ExecuteCommandLists", frame[i % frame.size()]);
+                 oldAccepted += accepted ? 1 : 0;
+             });
+
+    BenchRun("Replay, packed filter", iterations,
+             [&](size_t i)
+             {
+                 auto accepted = newHudfix.CheckForHudless("ExecuteCommandLists", frame[i % frame.size()]);
+                 newAccepted += accepted ? 1 : 0;
+             });
+
+    std::printf("old list: %zu entries, new list: %zu entries\n", oldHudfix.captured.size(),
+                newHudfix.captured.size());
+
+    // Both have to pick the same candidates
+    if (oldAccepted != newAccepted)
+    {
+        std::printf("accepted differ: %zu / %zu\n", oldAccepted, newAccepted);
+        return 1;
+    }
+
+    return 0;
+}
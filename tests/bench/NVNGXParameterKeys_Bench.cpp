@@ -0,0 +1,220 @@
+#include "BenchCommon.h"
+
+#include <NVNGX_ParameterKeys.h>
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Cost of a parameter Set/Get pair the way NVNGX_Parameters stores them: well known keys go to
+// a fixed slot found through the compile time table, the string keyed map is what every key used
+// before (and what unknown keys still use). Values are a plain tagged union like Parameter.
+
+struct Value
+{
+    union
+    {
+        float f;
+        unsigned long long ull;
+        void* vp;
+    } values {};
+
+    uint8_t type = 0;
+};
+
+struct SlotStore
+{
+    std::array<Value, NVNGXParameterKeys::Count> known {};
+    std::unordered_map<std::string, Value> values;
+    std::mutex mutex;
+
+    void Set(const char* key, float value)
+    {
+        auto slot = NVNGXParameterKeys::Find(key);
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto& target = slot >= 0 ? known[slot] : values[key];
+        target.values.f = value;
+        target.type = 1;
+    }
+
+    // What the translators use, slot comes from the template argument
+    template <NVNGXParameterKeys::Slot S> void Set(float value)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        known[S.index].values.f = value;
+        known[S.index].type = 1;
+    }
+
+    bool Get(const char* key, float* value)
+    {
+        auto slot = NVNGXParameterKeys::Find(key);
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (slot >= 0)
+        {
+            *value = known[slot].values.f;
+            return known[slot].type != 0;
+        }
+
+        auto it = values.find(key);
+
+        if (it == values.end())
+            return false;
+
+        *value = it->second.values.f;
+        return true;
+    }
+};
+
+struct MapStore
+{
+    std::unordered_map<std::string, Value> values;
+    std::mutex mutex;
+
+    void Set(const char* key, float value)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto& target = values[key];
+        target.values.f = value;
+        target.type = 1;
+    }
+
+    bool Get(const char* key, float* value)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = values.find(key);
+
+        if (it == values.end())
+            return false;
+
+        *value = it->second.values.f;
+        return true;
+    }
+};
+
+// Keys an evaluate call sets and a backend reads back every frame
+static const char* FrameKeys[] = {
+    NVSDK_NGX_Parameter_Width,
+    NVSDK_NGX_Parameter_Height,
+    NVSDK_NGX_Parameter_OutWidth,
+    NVSDK_NGX_Parameter_OutHeight,
+    NVSDK_NGX_Parameter_Sharpness,
+    NVSDK_NGX_Parameter_Color,
+    NVSDK_NGX_Parameter_Output,
+    NVSDK_NGX_Parameter_Depth,
+    NVSDK_NGX_Parameter_MotionVectors,
+    NVSDK_NGX_Parameter_Jitter_Offset_X,
+    NVSDK_NGX_Parameter_Jitter_Offset_Y,
+    NVSDK_NGX_Parameter_Reset,
+    NVSDK_NGX_Parameter_MV_Scale_X,
+    NVSDK_NGX_Parameter_MV_Scale_Y,
+    NVSDK_NGX_Parameter_DLSS_Pre_Exposure,
+    NVSDK_NGX_Parameter_DLSS_Exposure_Scale,
+    NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width,
+    NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height,
+    NVSDK_NGX_Parameter_FrameTimeDeltaInMsec,
+    "OptiScaler.Unknown.Key",
+};
+
+static constexpr size_t KeyCount = std::size(FrameKeys);
+
+template <typename Store> static void Run(const char* name, Store& store, size_t iterations)
+{
+    for (auto key : FrameKeys)
+        store.Set(key, 1.0f);
+
+    std::string setName = std::string(name) + " Set";
+    std::string getName = std::string(name) + " Get";
+
+    BenchRun(setName.c_str(), iterations, [&](size_t i) { store.Set(FrameKeys[i % KeyCount], (float) i); });
+
+    BenchRun(getName.c_str(), iterations,
+             [&](size_t i)
+             {
+                 float value = 0.0f;
+                 BenchKeep(store.Get(FrameKeys[i % KeyCount], &value));
+                 BenchKeep(value);
+             });
+}
+
+// One dispatch of an input translator, known keys only
+static void SetFrameByName(SlotStore& store, float value)
+{
+    for (size_t i = 0; i < KeyCount - 1; i++)
+        store.Set(FrameKeys[i], value);
+}
+
+static void SetFrameBySlot(SlotStore& store, float value)
+{
+    store.Set<NVSDK_NGX_Parameter_Width>(value);
+    store.Set<NVSDK_NGX_Parameter_Height>(value);
+    store.Set<NVSDK_NGX_Parameter_OutWidth>(value);
+    store.Set<NVSDK_NGX_Parameter_OutHeight>(value);
+    store.Set<NVSDK_NGX_Parameter_Sharpness>(value);
+    store.Set<NVSDK_NGX_Parameter_Color>(value);
+    store.Set<NVSDK_NGX_Parameter_Output>(value);
+    store.Set<NVSDK_NGX_Parameter_Depth>(value);
+    store.Set<NVSDK_NGX_Parameter_MotionVectors>(value);
+    store.Set<NVSDK_NGX_Parameter_Jitter_Offset_X>(value);
+    store.Set<NVSDK_NGX_Parameter_Jitter_Offset_Y>(value);
+    store.Set<NVSDK_NGX_Parameter_Reset>(value);
+    store.Set<NVSDK_NGX_Parameter_MV_Scale_X>(value);
+    store.Set<NVSDK_NGX_Parameter_MV_Scale_Y>(value);
+    store.Set<NVSDK_NGX_Parameter_DLSS_Pre_Exposure>(value);
+    store.Set<NVSDK_NGX_Parameter_DLSS_Exposure_Scale>(value);
+    store.Set<NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Width>(value);
+    store.Set<NVSDK_NGX_Parameter_DLSS_Render_Subrect_Dimensions_Height>(value);
+    store.Set<NVSDK_NGX_Parameter_FrameTimeDeltaInMsec>(value);
+}
+
+static_assert(NVNGXParameterKeys::Slot(NVSDK_NGX_Parameter_Width).index ==
+                  NVNGXParameterKeys::Find(NVSDK_NGX_Parameter_Width),
+              "Compile time slot differs from runtime lookup");
+
+int main(int argc, char** argv)
+{
+    size_t iterations = BenchQuick(argc, argv) ? 10000 : 20000000;
+
+    BenchRun("Find known key", iterations, [&](size_t i) { BenchKeep(NVNGXParameterKeys::Find(FrameKeys[i % 19])); });
+    BenchRun("Find unknown key", iterations, [&](size_t) { BenchKeep(NVNGXParameterKeys::Find(FrameKeys[19])); });
+
+    SlotStore slots;
+    MapStore map;
+
+    Run("slots", slots, iterations);
+    Run("string map", map, iterations);
+
+    BenchRun("Dispatch, 19 keys by name", iterations / 19, [&](size_t i) { SetFrameByName(slots, (float) i); });
+    BenchRun("Dispatch, 19 keys by slot", iterations / 19, [&](size_t i) { SetFrameBySlot(slots, (float) i); });
+
+    // Both dispatches have to write the same slots
+    SetFrameByName(slots, 1.0f);
+    SetFrameBySlot(slots, 2.0f);
+
+    for (size_t i = 0; i < KeyCount - 1; i++)
+    {
+        float value = 0.0f;
+
+        if (!slots.Get(FrameKeys[i], &value) || value != 2.0f)
+        {
+            std::printf("Slot of %s differs\n", FrameKeys[i]);
+            return 1;
+        }
+    }
+
+    // Slot path must agree with the map for every known key
+    for (size_t i = 0; i < NVNGXParameterKeys::Count; i++)
+    {
+        if (NVNGXParameterKeys::Find(NVNGXParameterKeys::Known[i]) < 0)
+        {
+            std::printf("Known key %s has no slot\n", NVNGXParameterKeys::Known[i]);
+            return 1;
+        }
+    }
+
+    return 0;
+}
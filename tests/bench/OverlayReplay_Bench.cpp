@@ -0,0 +1,154 @@
+#include "BenchCommon.h"
+
+#include <menu/OverlayReplay.h>
+
+#include <imgui/imgui.h>
+
+#include <cmath>
+#include <cstdio>
+
+// Per present cpu cost of the fps overlay when only the overlay is shown, with Dear ImGui from include/imgui
+// and no renderer backend.
+//
+// Rebuild is what MenuCommon::RenderMenu did on every present before: NewFrame, the overlay window of
+// FpsOverlayType 5 (three text lines and two graphs) and Render. Replay is the check which lets a present
+// render the kept draw data again. Mixed runs both at 144 fps with the default 10 Hz refresh rate.
+
+constexpr int HistorySize = 300;
+
+static float frameTimes[HistorySize];
+static float upscaleTimes[HistorySize];
+
+static OverlayLayout Layout()
+{
+    OverlayLayout layout;
+    layout.type = 5;
+    layout.alpha = 0.4f;
+    layout.scale = 1.0f;
+    layout.width = 2560.0f;
+    layout.height = 1440.0f;
+    return layout;
+}
+
+static void BuildOverlay(double now)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.DeltaTime = 1.0f / 144.0f;
+
+    ImGui::NewFrame();
+
+    ImGui::SetNextWindowPos({ 0.0f, 0.0f }, ImGuiCond_Always);
+    ImGui::SetNextWindowBgAlpha(0.4f);
+    ImGui::SetNextWindowSize({ 0.0f, 0.0f });
+
+    if (ImGui::Begin("Performance Overlay", nullptr,
+                     ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoDecoration |
+                         ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing |
+                         ImGuiWindowFlags_NoNav))
+    {
+        char firstLine[128];
+        char secondLine[128];
+        char thirdLine[128];
+
+        auto frameTime = frameTimes[(size_t) now % HistorySize];
+
+        std::snprintf(firstLine, sizeof(firstLine), "D3D12 | FPS: %5.1f, Avg: %5.1f | DLSS -> FSR 3.1.4",
+                      1000.0f / frameTime, 144.0f);
+        std::snprintf(secondLine, sizeof(secondLine), "Frame Time: %6.2f ms, Avg: %6.2f ms", frameTime, 6.94f);
+        std::snprintf(thirdLine, sizeof(thirdLine), "Upscaler Time: %6.2f ms, Avg: %6.2f ms", 0.81f, 0.80f);
+
+        auto textWidth = ImGui::CalcTextSize(firstLine).x;
+        ImVec2 plotSize = { textWidth < 300.0f ? 300.0f : textWidth, 30.0f };
+
+        ImGui::Text("%s", firstLine);
+        ImGui::Spacing();
+        ImGui::Text("%s", secondLine);
+        ImGui::PlotLines("##FrameTimeGraph", frameTimes, HistorySize, 0, nullptr, 0.0f, 66.6f, plotSize);
+        ImGui::Spacing();
+        ImGui::Text("%s", thirdLine);
+        ImGui::PlotLines("##UpscalerFrameTimeGraph", upscaleTimes, HistorySize, 0, nullptr, 0.0f, 20.0f, plotSize);
+    }
+
+    ImGui::End();
+    ImGui::Render();
+}
+
+static bool TexturesAlive()
+{
+    for (auto texture : ImGui::GetPlatformIO().Textures)
+    {
+        if (texture->Status == ImTextureStatus_Destroyed)
+            return false;
+    }
+
+    return true;
+}
+
+struct Overlay
+{
+    OverlayReplay replay;
+    size_t rebuilds = 0;
+
+    // What RenderMenu does with only the overlay shown, returns the draw data the backend would render
+    ImDrawData* Present(double now, int refreshRate)
+    {
+        if (replay.CanReplay(Layout(), now, refreshRate) && ImGui::GetDrawData() != nullptr && TexturesAlive())
+            return ImGui::GetDrawData();
+
+        BuildOverlay(now);
+        replay.Built(Layout(), now, true);
+        rebuilds++;
+
+        return ImGui::GetDrawData();
+    }
+};
+
+int main(int argc, char** argv)
+{
+    bool quick = BenchQuick(argc, argv);
+    size_t iterations = quick ? 200 : 200000;
+
+    for (int i = 0; i < HistorySize; i++)
+    {
+        frameTimes[i] = 6.94f + std::sin(i * 0.1f);
+        upscaleTimes[i] = 0.8f + 0.1f * std::cos(i * 0.3f);
+    }
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = { 2560.0f, 1440.0f };
+    io.IniFilename = nullptr;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+
+    constexpr double PresentInterval = 1000.0 / 144.0;
+
+    Overlay rebuild;
+    BenchRun("Present, rebuild every frame", iterations,
+             [&](size_t i) { BenchKeep(rebuild.Present(i * PresentInterval, 0)); });
+
+    // Same draw data is valid for 100 ms
+    Overlay replay;
+    replay.Present(0.0, 10);
+    BenchRun("Present, replay", iterations, [&](size_t) { BenchKeep(replay.Present(1.0, 10)); });
+
+    Overlay mixed;
+    BenchRun("Present, 10 Hz refresh at 144 fps", iterations,
+             [&](size_t i) { BenchKeep(mixed.Present(i * PresentInterval, 10)); });
+
+    auto vertices = ImGui::GetDrawData()->TotalVtxCount;
+    ImGui::DestroyContext();
+
+    std::printf("rebuilds: %zu of %zu presents, %d vertices\n", mixed.rebuilds, iterations, vertices);
+
+    // Kept draw data covers the presents of the next 100 ms
+    auto presentsPerRebuild = (size_t) std::ceil(100.0 / PresentInterval);
+    auto expected = (iterations + presentsPerRebuild - 1) / presentsPerRebuild;
+    if (replay.rebuilds != 1 || mixed.rebuilds != expected || vertices == 0)
+    {
+        std::printf("unexpected rebuilds: replay %zu, mixed %zu, expected %zu\n", replay.rebuilds, mixed.rebuilds,
+                    expected);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,195 @@
+#include "BenchCommon.h"
+
+#include <resource_tracking/ResourceIndex.h>
+
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+// View creation and resource release from many threads, like a streaming game creating SRVs on its
+// loading threads while the render thread releases old resources. Compares the sharded reverse index
+// with what ResTrack did before, one mutex around a map of resource -> vector of slots. Each thread
+// writes views into its own range of slots, resources come from a shared pool and one op in 16
+// releases one. At the end every slot has to point to the resource it's linked to.
+
+struct FakeResource
+{
+    char padding[64];
+};
+
+struct Info
+{
+    FakeResource* buffer = nullptr;
+    uint64_t lastUsedFrame = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+
+using Index = ResourceIndex<FakeResource, Info>;
+
+static constexpr size_t SlotsPerThread = 4096;
+static constexpr size_t ResourceCount = 8192;
+
+struct Sharded
+{
+    Index index;
+    std::vector<Info> infos;
+    std::vector<Index::Node> nodes;
+
+    explicit Sharded(size_t slots) : infos(slots), nodes(slots)
+    {
+        for (size_t i = 0; i < slots; i++)
+            nodes[i].info = &infos[i];
+    }
+
+    void Set(size_t slot, FakeResource* resource)
+    {
+        Info info { resource, 1, 1920, 1080 };
+        index.Link(&nodes[slot], resource, [&] { infos[slot] = info; });
+    }
+
+    void Release(FakeResource* resource)
+    {
+        index.Release(resource,
+                      [resource](Info* info)
+                      {
+                          if (info->buffer == resource)
+                          {
+                              info->buffer = nullptr;
+                              info->lastUsedFrame = 0;
+                          }
+                      });
+    }
+
+    bool Check() const
+    {
+        for (size_t i = 0; i < infos.size(); i++)
+        {
+            if (infos[i].buffer != nodes[i].owner.load())
+                return false;
+        }
+
+        return true;
+    }
+};
+
+// ResTrack before the reverse index
+struct Locked
+{
+    std::mutex mutex;
+    std::unordered_map<FakeResource*, std::vector<Info*>> tracked;
+    std::vector<Info> infos;
+
+    explicit Locked(size_t slots) : infos(slots) {}
+
+    void Set(size_t slot, FakeResource* resource)
+    {
+        auto& info = infos[slot];
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // ClearByCpuHandle before the new view
+        if (info.buffer != nullptr)
+        {
+            if (auto it = tracked.find(info.buffer); it != tracked.end())
+            {
+                auto& vector = it->second;
+
+                for (size_t i = 0; i < vector.size(); i++)
+                {
+                    if (vector[i] == &info)
+                    {
+                        vector.erase(vector.begin() + i);
+                        break;
+                    }
+                }
+            }
+        }
+
+        info = { resource, 1, 1920, 1080 };
+        tracked[resource].push_back(&info);
+    }
+
+    void Release(FakeResource* resource)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto it = tracked.find(resource);
+
+        if (it == tracked.end())
+            return;
+
+        for (auto info : it->second)
+        {
+            if (info->buffer == resource)
+            {
+                info->buffer = nullptr;
+                info->lastUsedFrame = 0;
+            }
+        }
+
+        tracked.erase(it);
+    }
+
+    bool Check() const { return true; }
+};
+
+template <typename Target>
+static bool RunThreads(const char* name, Target& target, std::vector<FakeResource>& resources, size_t threads,
+                       size_t calls)
+{
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t t = 0; t < threads; t++)
+    {
+        workers.emplace_back(
+            [&, t]()
+            {
+                std::mt19937 random((uint32_t) t + 1);
+
+                for (size_t i = 0; i < calls; i++)
+                {
+                    auto resource = &resources[random() % resources.size()];
+
+                    if ((i & 15) == 15)
+                        target.Release(resource);
+                    else
+                        target.Set(t * SlotsPerThread + random() % SlotsPerThread, resource);
+                }
+            });
+    }
+
+    for (auto& worker : workers)
+        worker.join();
+
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    char label[64];
+    std::snprintf(label, sizeof(label), "%s, %zu threads", name, threads);
+    std::printf("%-48s %12.2f ns/op  (%zu ops)\n", label, elapsed / (double) (threads * calls), threads * calls);
+
+    return target.Check();
+}
+
+int main(int argc, char** argv)
+{
+    size_t calls = BenchQuick(argc, argv) ? 5000 : 2000000;
+    std::vector<FakeResource> resources(ResourceCount);
+
+    for (size_t threads : { 1, 2, 4, 8, 16 })
+    {
+        Sharded sharded(threads * SlotsPerThread);
+        Locked locked(threads * SlotsPerThread);
+
+        if (!RunThreads("sharded index", sharded, resources, threads, calls))
+        {
+            std::printf("Slot doesn't match its linked resource\n");
+            return 1;
+        }
+
+        RunThreads("mutex + map of vectors", locked, resources, threads, calls);
+    }
+
+    return 0;
+}
@@ -0,0 +1,112 @@
+#include "BenchCommon.h"
+
+#include <misc/RootSignatureTracker.h>
+
+#include <chrono>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// SetComputeRootSignature/SetGraphicsRootSignature hooks run on every recording thread of the
+// game. Compares the tracker with what the hooks did before, an exclusive lock and a map insert
+// per call, for 1 to 16 recording threads. Each thread records a few command lists and switches
+// list every 32 calls like a draw stream does.
+
+using Tracker = RootSignatureTracker<>;
+
+static constexpr size_t ListsPerThread = 4;
+static constexpr size_t CallsPerList = 32;
+
+struct LockedMaps
+{
+    std::unordered_map<const void*, void*> compute;
+    std::unordered_map<const void*, void*> graphic;
+    std::shared_mutex computeMutex;
+    std::shared_mutex graphicMutex;
+
+    void Set(const void* commandList, Tracker::Kind kind, void* signature)
+    {
+        if (kind == Tracker::Kind::Compute)
+        {
+            std::unique_lock<std::shared_mutex> lock(computeMutex);
+            compute.insert_or_assign(commandList, signature);
+        }
+        else
+        {
+            std::unique_lock<std::shared_mutex> lock(graphicMutex);
+            graphic.insert_or_assign(commandList, signature);
+        }
+    }
+};
+
+// Fake command list addresses, 64 byte apart like real allocations
+static const void* ListOf(size_t thread, size_t list) { return (const void*) (0x10000000 + (thread * 64 + list) * 64); }
+
+static void* SignatureOf(size_t call) { return (void*) (0x20000000 + (call % 8) * 16); }
+
+template <typename Target> static double RunThreads(const char* name, Target& target, size_t threads, size_t calls)
+{
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t t = 0; t < threads; t++)
+    {
+        workers.emplace_back(
+            [&target, t, calls]()
+            {
+                for (size_t i = 0; i < calls; i++)
+                {
+                    auto list = ListOf(t, (i / CallsPerList) % ListsPerThread);
+                    auto kind = (i & 1) ? Tracker::Kind::Graphic : Tracker::Kind::Compute;
+                    target.Set(list, kind, SignatureOf(i));
+                }
+            });
+    }
+
+    for (auto& worker : workers)
+        worker.join();
+
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    auto perCall = elapsed / (double) (threads * calls);
+
+    char label[64];
+    std::snprintf(label, sizeof(label), "%s, %zu threads", name, threads);
+    std::printf("%-48s %12.2f ns/op  (%zu ops)\n", label, perCall, threads * calls);
+
+    return perCall;
+}
+
+int main(int argc, char** argv)
+{
+    size_t calls = BenchQuick(argc, argv) ? 2000 : 2000000;
+    size_t threadCounts[] = { 1, 2, 4, 8, 16 };
+
+    for (auto threads : threadCounts)
+    {
+        static Tracker tracker;
+        LockedMaps maps;
+
+        RunThreads("tracker", tracker, threads, calls);
+        RunThreads("shared_mutex + map", maps, threads, calls);
+
+        // Last call of every list has to be visible to Evaluate
+        for (size_t t = 0; t < threads; t++)
+        {
+            auto lastCall = calls - 1;
+            auto list = ListOf(t, (lastCall / CallsPerList) % ListsPerThread);
+            auto kind = (lastCall & 1) ? Tracker::Kind::Graphic : Tracker::Kind::Compute;
+
+            if (tracker.Get(list, kind) != SignatureOf(lastCall))
+            {
+                std::printf("Wrong signature for thread %zu\n", t);
+                return 1;
+            }
+        }
+
+        tracker.NextFrame();
+    }
+
+    return 0;
+}
@@ -0,0 +1,171 @@
+#include "BenchCommon.h"
+
+#include <scanner/ScanCache.h>
+#include <scanner/pattern.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+// Scans a synthetic image laid out like a PE: a header page followed by a large code section with
+// the byte frequencies of x64 code. The FSR2/FSR3 exe patterns are planted near the end, where a
+// real game's statically linked FidelityFX code usually ends up, so every scan walks most of it.
+
+static const char* Patterns[] = {
+    // FSR3 exe
+    "48 ? ? ? ? 57 48 83 EC 20 48 8B DA 41 B8 ? ? ? ? 33 D2 48 8B F9 E8 ? ? ? ? 48 85 FF 74 ? 48 85 DB",
+    "40 ? ? ? ? 20 48 8B D9 48 85 C9 75 ? B8 ? ? ? ? 48 83 C4 20 5B C3 44 8B 81 ? ? ? ? 48 8D 91 ? ? ? ? 48 ? "
+    "? ? ? 48 83 C1 18 48 ? ? ? ? 48 ? ? ? ? E8 ? ? ? ? 44 8B 83",
+    "48 85 C9 74 36 48 85 D2 74 31 8B 41 04 39 82 ? ? ? ? 77 20 8B 41 08 39 82 ? ? ? ? 77 15 48 83 B9 ? ? ? ? ? 75 "
+    "06 B8 ? ? ? ? C3",
+    "85 C9 74 3C 83 E9 01 74 2E 83 E9 01 74 20 83 E9 01 74 12 83 F9 01 74 04 0F 57 C0 C3",
+    // FSR2 exe
+    "40 55 57 41 54 41 56 48 8D AC 24 ? ? ? ? 48 81 EC ? ? ? ? 48 8B 05 ? ? ? ? 48 33 C4 48 89 85 ? ? ? ? 4C 8B F2 "
+    "41 B8 ? ? ? ? 33 D2 48 8B F9 E8",
+    "40 55 53 57 48 8D AC 24 ? ? ? ? B8 ? ? ? ? E8 ? ? ? ? 48 2B E0 80 B9 ? ? ? ? 00",
+    // Not present in the image
+    "40 55 56 41 57 48 8D AC 24 ? ? ? ? B8 ? ? ? ? E8 ? ? ? ? 48 2B E0 80 CC CC CC",
+};
+
+static constexpr size_t PatternCount = std::size(Patterns);
+static constexpr size_t PlantedCount = PatternCount - 1;
+static constexpr size_t HeaderSize = 0x1000;
+
+// Rough opcode/operand mix of compiled x64 code
+static uint8_t CodeByte(std::mt19937& rng)
+{
+    static const uint8_t common[] = { 0x48, 0x8B, 0x89, 0x4C, 0x8D, 0x24, 0x83, 0x44, 0x41, 0x0F, 0xE8, 0x85,
+                                      0xC0, 0x74, 0x75, 0x20, 0x01, 0x33, 0xC3, 0x00, 0x00, 0x00, 0xFF, 0xCC };
+    auto roll = rng() % 100;
+
+    if (roll < 55)
+        return common[rng() % std::size(common)];
+
+    return (uint8_t) rng();
+}
+
+int main(int argc, char** argv)
+{
+    auto quick = BenchQuick(argc, argv);
+    size_t codeSize = quick ? (1u << 20) : (96u << 20);
+    size_t repeats = quick ? 1 : 5;
+
+    std::vector<uint8_t> image(HeaderSize + codeSize);
+    std::mt19937 rng(1234);
+
+    image[0] = 'M';
+    image[1] = 'Z';
+
+    for (size_t i = HeaderSize; i < image.size(); i++)
+        image[i] = CodeByte(rng);
+
+    std::vector<scanner::CompiledPattern> compiled(PatternCount);
+    std::vector<size_t> planted(PatternCount, 0);
+
+    for (size_t p = 0; p < PatternCount; p++)
+    {
+        if (!compiled[p].Compile(Patterns[p]))
+        {
+            std::printf("Pattern %zu doesn't compile\n", p);
+            return 1;
+        }
+
+        if (p >= PlantedCount)
+            continue;
+
+        planted[p] = image.size() - (PlantedCount - p) * 4096 - 123;
+
+        for (size_t b = 0; b < compiled[p].Size(); b++)
+            image[planted[p] + b] = compiled[p].fixed[b] ? compiled[p].bytes[b] : (uint8_t) rng();
+    }
+
+    auto begin = image.data() + HeaderSize;
+    auto end = image.data() + image.size();
+    auto mbPerRun = (double) codeSize / (1024.0 * 1024.0);
+    bool valid = true;
+
+    auto verify = [&](const std::vector<scanner::ScanJob>& jobs)
+    {
+        for (size_t p = 0; p < PatternCount; p++)
+        {
+            auto expected = p < PlantedCount ? image.data() + planted[p] : nullptr;
+
+            if (jobs[p].found != expected)
+            {
+                std::printf("Pattern %zu found at wrong place\n", p);
+                valid = false;
+            }
+        }
+    };
+
+    auto batch = BenchRun("all patterns, one pass", repeats,
+                          [&](size_t)
+                          {
+                              std::vector<scanner::ScanJob> jobs(PatternCount);
+
+                              for (size_t p = 0; p < PatternCount; p++)
+                                  jobs[p].pattern = &compiled[p];
+
+                              scanner::ScanRange(begin, end, begin, end, jobs);
+                              verify(jobs);
+                          });
+
+    auto separate = BenchRun("one pass per pattern", repeats,
+                             [&](size_t)
+                             {
+                                 std::vector<scanner::ScanJob> jobs(PatternCount);
+
+                                 for (size_t p = 0; p < PatternCount; p++)
+                                 {
+                                     jobs[p].pattern = &compiled[p];
+                                     scanner::ScanRange(begin, end, begin, end, { &jobs[p], 1 });
+                                 }
+
+                                 verify(jobs);
+                             });
+
+    auto naive = BenchRun("byte by byte compare, per pattern", repeats,
+                          [&](size_t)
+                          {
+                              std::vector<scanner::ScanJob> jobs(PatternCount);
+
+                              for (size_t p = 0; p < PatternCount; p++)
+                              {
+                                  jobs[p].pattern = &compiled[p];
+
+                                  for (auto position = begin; position + compiled[p].Size() <= end; position++)
+                                  {
+                                      if (compiled[p].Matches(position))
+                                      {
+                                          jobs[p].found = position;
+                                          break;
+                                      }
+                                  }
+                              }
+
+                              verify(jobs);
+                          });
+
+    std::printf("throughput: one pass %.0f MB/s, per pattern %.0f MB/s, byte by byte %.0f MB/s\n",
+                mbPerRun / (batch * 1e-9), mbPerRun / (separate * 1e-9), mbPerRun / (naive * 1e-9));
+
+    // Warm start, every pattern comes from the cache and only needs to be verified in place
+    scanner::ScanCache cache;
+
+    for (size_t p = 0; p < PatternCount; p++)
+        cache.Store("exe", "build", scanner::ScanCache::Hash(Patterns[p]), 0, p < PlantedCount ? planted[p] : 0);
+
+    BenchRun("cached lookup and verify, all patterns", quick ? 100 : 100000,
+             [&](size_t)
+             {
+                 for (size_t p = 0; p < PatternCount; p++)
+                 {
+                     uint64_t rva = 0;
+
+                     if (cache.Find("exe", "build", scanner::ScanCache::Hash(Patterns[p]), 0, &rva) && rva != 0)
+                         BenchKeep(compiled[p].Matches(image.data() + rva));
+                 }
+             });
+
+    return valid ? 0 : 1;
+}
@@ -0,0 +1,71 @@
+#include "BenchCommon.h"
+#include "ReferenceInputs.h"
+
+// Throughput of the CPU versions of the shaders, one op is a whole image. Tells how long a golden
+// image check of a frame takes and catches a reference which got slow by accident (a per texel
+// allocation, a SIMD path falling back to scalar).
+
+using namespace Reference;
+
+int main(int argc, char** argv)
+{
+    bool quick = BenchQuick(argc, argv);
+
+    // Render and display size of a 1080p output with the quality preset
+    int renderWidth = quick ? 96 : 1280;
+    int renderHeight = quick ? 54 : 720;
+    int displayWidth = quick ? 144 : 1920;
+    int displayHeight = quick ? 81 : 1080;
+    size_t iterations = quick ? 2 : 5;
+
+    auto render = ReferenceInputs::Color(renderWidth, renderHeight);
+    auto display = ReferenceInputs::Color(displayWidth, displayHeight);
+    auto motion = ReferenceInputs::Motion(displayWidth, displayHeight);
+    auto depth = ReferenceInputs::Depth(renderWidth, renderHeight);
+
+    std::printf("Render %dx%d, display %dx%d, %.2f Mtexel per display image\n", renderWidth, renderHeight,
+                displayWidth, displayHeight, displayWidth * displayHeight / 1e6);
+
+    BenchRun("Bias (render)", iterations, [&](size_t) { BenchKeep(BiasImage(render, 0.5f).Data()); });
+
+    DSConstants ds {};
+    ds.DepthScale = 0.8f;
+    BenchRun("DepthScale (render)", iterations, [&](size_t) { BenchKeep(DepthScaleImage(depth, ds).Data()); });
+
+    BenchRun("FormatTransfer R10G10B10A2 (display)", iterations,
+             [&](size_t) { BenchKeep(FormatTransferImage(display, PackR10G10B10A2).data()); });
+
+    RFConstants rf { (uint32_t) displayWidth, (uint32_t) displayHeight - 1, 0, 1 };
+    BenchRun("ResourceFlip velocity (display)", iterations,
+             [&](size_t) { BenchKeep(ResourceFlipImage(motion, rf).Data()); });
+
+    auto rcas = ReferenceInputs::Rcas(true);
+    BenchRun("RCAS dynamic (display)", iterations,
+             [&](size_t) { BenchKeep(RcasImage(display, motion, rcas).Data()); });
+
+    Constants upscale { renderWidth, renderHeight, displayWidth, displayHeight };
+    BenchRun("OS BicubicUpsample (render -> display)", iterations,
+             [&](size_t) { BenchKeep(ScaleImage(ScaleKernel::BicubicUpsample, upscale, render).Data()); });
+
+    Constants downscale { displayWidth, displayHeight, renderWidth, renderHeight };
+
+    for (auto [name, kernel] : { std::pair { "OS Bicubic (display -> render)", ScaleKernel::Bicubic },
+                                 std::pair { "OS Lanczos (display -> render)", ScaleKernel::Lanczos },
+                                 std::pair { "OS Catmull (display -> render)", ScaleKernel::Catmull } })
+    {
+        BenchRun(name, iterations, [&](size_t) { BenchKeep(ScaleImage(kernel, downscale, display).Data()); });
+    }
+
+    // Fused pass against the two passes it replaces
+    FusedParams fused;
+    fused.Kernel = ScaleKernel::Lanczos;
+    fused.Scale = downscale;
+    fused.Rcas = rcas;
+
+    BenchRun("PF RCAS + Lanczos fused", iterations,
+             [&](size_t) { BenchKeep(FusedImage(display, motion, fused).Data()); });
+    BenchRun("PF RCAS + Lanczos separate", iterations,
+             [&](size_t) { BenchKeep(SeparateImage(display, motion, fused).Data()); });
+
+    return 0;
+}
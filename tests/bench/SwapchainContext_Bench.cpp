@@ -0,0 +1,223 @@
+#include "BenchCommon.h"
+
+#include <misc/SeqLock.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Per present cost of the device identity and swapchain description. Before the swapchain context
+// every present queried the device for ID3D11Device and ID3D12CommandQueue, asked Streamline for
+// the real object, called GetDevice, called GetDesc twice (present hook and hudfix) and released
+// what it got. Now it reads cached pointers and copies the description out of a SeqLock.
+//
+// COM objects are modelled with virtual calls and interlocked reference counts, GetDesc copies
+// under a lock like DXGI does. Real calls also go through the Streamline and driver layers, so the
+// old numbers here are a lower bound.
+
+struct FakeDesc
+{
+    uint32_t width = 1920;
+    uint32_t height = 1080;
+    uint32_t refreshNumerator = 60;
+    uint32_t refreshDenominator = 1;
+    uint32_t format = 28;
+    uint32_t scanlineOrdering = 0;
+    uint32_t scaling = 0;
+    uint32_t sampleCount = 1;
+    uint32_t sampleQuality = 0;
+    uint32_t usage = 0x20;
+    uint32_t bufferCount = 3;
+    void* window = nullptr;
+    int32_t windowed = 1;
+    uint32_t swapEffect = 4;
+    uint32_t flags = 0;
+};
+
+struct FakeUnknown
+{
+    std::atomic<uint32_t> refs { 1 };
+
+    virtual ~FakeUnknown() = default;
+
+    virtual int QueryInterface(int iid, void** object)
+    {
+        if (iid != Iid())
+        {
+            *object = nullptr;
+            return -1;
+        }
+
+        AddRef();
+        *object = this;
+        return 0;
+    }
+
+    virtual int Iid() const = 0;
+    virtual uint32_t AddRef() { return refs.fetch_add(1, std::memory_order_acq_rel) + 1; }
+    virtual uint32_t Release() { return refs.fetch_sub(1, std::memory_order_acq_rel) - 1; }
+};
+
+struct FakeDevice : FakeUnknown
+{
+    int Iid() const override { return 2; }
+};
+
+struct FakeQueue : FakeUnknown
+{
+    FakeDevice* device = nullptr;
+
+    int Iid() const override { return 1; }
+
+    virtual int GetDevice(void** object) { return device->QueryInterface(2, object); }
+};
+
+struct FakeSwapchain : FakeUnknown
+{
+    FakeDesc desc;
+    std::mutex mutex;
+
+    int Iid() const override { return 3; }
+
+    virtual int GetDesc(FakeDesc* pDesc)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        *pDesc = desc;
+        return 0;
+    }
+};
+
+struct Context
+{
+    FakeQueue* queue = nullptr;
+    FakeDevice* device12 = nullptr;
+    SeqLock<FakeDesc> desc;
+};
+
+static uint64_t PresentBefore(FakeSwapchain& swapchain, FakeUnknown& pDevice)
+{
+    void* device11 = nullptr;
+    void* queue = nullptr;
+    void* real = nullptr;
+    void* device12 = nullptr;
+    FakeDesc desc;
+    uint64_t sum = 0;
+
+    pDevice.QueryInterface(0, &device11);
+
+    if (pDevice.QueryInterface(1, &queue) == 0)
+    {
+        // CheckForRealObject
+        ((FakeQueue*) queue)->QueryInterface(4, &real);
+        ((FakeQueue*) queue)->GetDevice(&device12);
+    }
+
+    swapchain.GetDesc(&desc);
+    sum += desc.width + desc.bufferCount;
+
+    // Hudfix_Dx12::CheckForHudless
+    swapchain.GetDesc(&desc);
+    sum += desc.format;
+
+    if (device12 != nullptr)
+        ((FakeDevice*) device12)->Release();
+
+    if (queue != nullptr)
+        ((FakeQueue*) queue)->Release();
+
+    return sum + (uint64_t) device12;
+}
+
+static uint64_t PresentContext(const Context& context)
+{
+    auto desc = context.desc.Load();
+    uint64_t sum = desc.width + desc.bufferCount;
+
+    desc = context.desc.Load();
+    sum += desc.format;
+
+    return sum + (uint64_t) context.device12 + (uint64_t) context.queue;
+}
+
+// Runs read on count threads while measure runs on this one
+template <typename Read, typename Measure> static void WithReaders(size_t count, Read&& read, Measure&& measure)
+{
+    std::atomic<bool> stop = false;
+    std::vector<std::thread> readers;
+
+    for (size_t t = 0; t < count; t++)
+    {
+        readers.emplace_back(
+            [&]()
+            {
+                while (!stop.load(std::memory_order_relaxed))
+                    read();
+            });
+    }
+
+    measure();
+    stop = true;
+
+    for (auto& reader : readers)
+        reader.join();
+}
+
+int main(int argc, char** argv)
+{
+    bool quick = BenchQuick(argc, argv);
+    size_t iterations = quick ? 10000 : 10000000;
+
+    FakeDevice device;
+    FakeQueue queue;
+    queue.device = &device;
+    FakeSwapchain swapchain;
+
+    Context context;
+    context.queue = &queue;
+    context.device12 = &device;
+    context.desc.Store(swapchain.desc);
+
+    BenchRun("Present, COM calls + 2x GetDesc", iterations,
+             [&](size_t) { BenchKeep(PresentBefore(swapchain, queue)); });
+    BenchRun("Present, context", iterations, [&](size_t) { BenchKeep(PresentContext(context)); });
+
+    // ResTrack and hudfix read the description from the game's render threads while it presents
+    for (size_t threads : { 2, 4 })
+    {
+        char name[64];
+
+        std::snprintf(name, sizeof(name), "Present, COM calls, %zu threads", threads);
+        WithReaders(threads - 1, [&]() { BenchKeep(PresentBefore(swapchain, queue)); },
+                    [&]() { BenchRun(name, iterations, [&](size_t) { BenchKeep(PresentBefore(swapchain, queue)); }); });
+
+        std::snprintf(name, sizeof(name), "Present, context, %zu threads", threads);
+        WithReaders(threads - 1, [&]() { BenchKeep(PresentContext(context)); },
+                    [&]() { BenchRun(name, iterations, [&](size_t) { BenchKeep(PresentContext(context)); }); });
+    }
+
+    // Worst case for the readers, a window being dragged between monitors resizes every few microseconds
+    {
+        std::atomic<bool> stop = false;
+        std::thread writer(
+            [&]()
+            {
+                auto desc = swapchain.desc;
+
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    desc.width = desc.width == 1920 ? 2560 : 1920;
+                    context.desc.Store(desc);
+                    std::this_thread::yield();
+                }
+            });
+
+        BenchRun("Present, context, resizing thread", iterations,
+                 [&](size_t) { BenchKeep(PresentContext(context)); });
+
+        stop = true;
+        writer.join();
+    }
+
+    return 0;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+// external/unordered_dense is a submodule which the Linux tests don't check out, the portable
+// headers only use map and set with the std interface. Numbers of benchmarks built with this
+// are for std::unordered_map, the dll is faster.
+
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace ankerl::unordered_dense
+{
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+using map = std::unordered_map<Key, Value, Hash, Equal>;
+
+template <typename Key, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+using set = std::unordered_set<Key, Hash, Equal>;
+} // namespace ankerl::unordered_dense
@@ -0,0 +1,4 @@
+#pragma once
+
+// Sources of the dll include pch.h first because of the precompiled header. Tests build the ones
+// which don't use anything from it, this stands in for the real one.